@@ -130,10 +130,13 @@ const char *fixedOptionsC = " [OPTION]... [FILE]...\n"
                             "    -no-splash          Don't display splash screen\n"
                             "    -log <file>         Log to specified file\n"
                             "    -client             Attempt to connect to already running instance\n"
+                            "    -new-instance       Start a new instance instead of raising an already running one\n"
                             "    -D <key>=<value>    Permanently set a user setting, e.g: -D General/OverrideLanguage=de\n"
                             "    -reset              Reset user settings to factory defaults.\n"
                             "    -config-file <file> Specify alternate factory defaults settings file (used with -reset)\n"
-                            "    -exit-after-config  Exit after manipulating configuration settings\n";
+                            "    -exit-after-config  Exit after manipulating configuration settings\n"
+                            "    -headless           Run without the main window, for relay and logging appliances\n"
+                            "    -plugins <list>     With -headless: comma separated list of plugins to load (plus their dependencies)\n";
 
 const QLatin1String HELP1_OPTION("-h");
 const QLatin1String HELP2_OPTION("-help");
@@ -142,11 +145,18 @@ const QLatin1String HELP4_OPTION("--help");
 const QLatin1String VERSION_OPTION("-version");
 const QLatin1String NO_SPLASH_OPTION("-no-splash");
 const QLatin1String CLIENT_OPTION("-client");
+const QLatin1String NEW_INSTANCE_OPTION("-new-instance");
 const QLatin1String CONFIG_OPTION("-D");
 const QLatin1String RESET_OPTION("-reset");
 const QLatin1String CONFIG_FILE_OPTION("-config-file");
 const QLatin1String EXIT_AFTER_CONFIG_OPTION("-exit-after-config");
 const QLatin1String LOG_FILE_OPTION("-log");
+const QLatin1String HEADLESS_OPTION("-headless");
+const QLatin1String PLUGINS_OPTION("-plugins");
+
+// Plugins loaded by -headless when no explicit -plugins list is given :
+// enough for a field box that logs and re-serves telemetry.
+const char *DEFAULT_HEADLESS_PLUGINS = "UAVObjects,UAVTalk,LoggingGadget,StreamServicePlugin";
 
 // Helpers for displaying messages. Note that there is no console on Windows.
 void displayHelpText(QString t)
@@ -229,6 +239,20 @@ inline QString prepareRemoteArgument(const QString &arg)
     return arg;
 }
 
+// Hand the arguments to an already running instance and have it raise its
+// main window. Quiet variant of sendArguments used by the automatic
+// single instance attach, where a failure means we start normally instead.
+bool attachToRunningInstance(SharedTools::QtSingleApplication &app, const QStringList &arguments)
+{
+    foreach(const QString &arg, arguments) {
+        if (!app.sendMessage(prepareRemoteArgument(arg))) {
+            return false;
+        }
+    }
+    // Special empty argument means: Show and raise (the slot just needs to be triggered)
+    return app.sendMessage(QString());
+}
+
 // Send the arguments to an already running instance of application
 bool sendArguments(SharedTools::QtSingleApplication &app, const QStringList &arguments)
 {
@@ -317,10 +341,13 @@ AppOptions options()
     appOptions.insert(NO_SPLASH_OPTION, false);
     appOptions.insert(LOG_FILE_OPTION, true);
     appOptions.insert(CLIENT_OPTION, false);
+    appOptions.insert(NEW_INSTANCE_OPTION, false);
     appOptions.insert(CONFIG_OPTION, true);
     appOptions.insert(RESET_OPTION, false);
     appOptions.insert(CONFIG_FILE_OPTION, true);
     appOptions.insert(EXIT_AFTER_CONFIG_OPTION, false);
+    appOptions.insert(HEADLESS_OPTION, false);
+    appOptions.insert(PLUGINS_OPTION, true);
     return appOptions;
 }
 
@@ -526,9 +553,48 @@ int main(int argc, char * *argv)
         return 0;
     }
 
+    // single instance : an accidental second launch raises the running GCS
+    // (handing over any file arguments) instead of paying a full plugin
+    // load and fighting over the serial ports. -new-instance restores the
+    // old behavior for operators who really want two. Checked before the
+    // splash screen so the attach costs milliseconds.
+    if (app.isRunning()
+        && !appOptionValues.contains(NEW_INSTANCE_OPTION)
+        && !appOptionValues.contains(HEADLESS_OPTION)
+        && !appOptionValues.contains(VERSION_OPTION)
+        && !appOptionValues.contains(HELP1_OPTION) && !appOptionValues.contains(HELP2_OPTION)
+        && !appOptionValues.contains(HELP3_OPTION) && !appOptionValues.contains(HELP4_OPTION)) {
+        qDebug() << "main - already running instance detected, raising it";
+        if (attachToRunningInstance(app, pluginManager.arguments())) {
+            qDebug() << "main - attach took" << timer.elapsed() << "ms";
+            return 0;
+        }
+        // the running instance is not responding (hung, or a stale lock was
+        // left behind), fall through to a normal full startup
+        qWarning() << "main - running instance is not responding, starting normally";
+    }
+
+    // headless appliance mode : load only the service plugins (plus their
+    // dependencies) and never show the main window, so a logging relay
+    // starts fast and in a fraction of the memory
+    if (appOptionValues.contains(HEADLESS_OPTION)) {
+        QString profile = appOptionValues.value(PLUGINS_OPTION);
+        if (profile.isEmpty()) {
+            profile = QLatin1String(DEFAULT_HEADLESS_PLUGINS);
+        }
+        QStringList pluginNames = profile.split(QLatin1Char(','), QString::SkipEmptyParts);
+        if (!pluginNames.contains(CORE_PLUGIN_NAME)) {
+            // the plugin system cannot run without its kernel
+            pluginNames.append(CORE_PLUGIN_NAME);
+        }
+        qDebug() << "main - headless mode, loading plugins" << pluginNames;
+        pluginManager.setHeadless(true);
+        pluginManager.setPluginWhitelist(pluginNames);
+    }
+
     // open the splash screen
     GCSSplashScreen *splash = 0;
-    if (!appOptionValues.contains(NO_SPLASH_OPTION)) {
+    if (!appOptionValues.contains(NO_SPLASH_OPTION) && !appOptionValues.contains(HEADLESS_OPTION)) {
         splash = new GCSSplashScreen();
         // show splash
         splash->showProgressMessage(QObject::tr("Application starting..."));
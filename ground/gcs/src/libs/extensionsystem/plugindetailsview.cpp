@@ -86,4 +86,8 @@ void PluginDetailsView::update(PluginSpec *spec)
         depStrings << QString("%1 (%2)").arg(dep.name).arg(dep.version);
     }
     m_ui->dependencies->addItems(depStrings);
+    m_ui->startupTimings->setText(tr("load %1 ms, initialize %2 ms, extensions %3 ms")
+                                  .arg(spec->loadElapsed())
+                                  .arg(spec->initializeElapsed())
+                                  .arg(spec->extensionsInitializedElapsed()));
 }
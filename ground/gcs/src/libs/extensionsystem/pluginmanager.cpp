@@ -35,8 +35,14 @@
 
 #include <QtCore/QMetaProperty>
 #include <QtCore/QDir>
+#include <QtCore/QDateTime>
+#include <QtCore/QDataStream>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QTextStream>
 #include <QtCore/QWriteLocker>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
 #include <QtDebug>
 #ifdef WITH_TESTS
 #include <QTest>
@@ -177,7 +183,7 @@ PluginManager *PluginManager::instance()
     Create a plugin manager. Should be done only once per application.
  */
 PluginManager::PluginManager()
-    : d(new PluginManagerPrivate(this)), m_allPluginsLoaded(false)
+    : d(new PluginManagerPrivate(this)), m_allPluginsLoaded(false), m_isHeadless(false)
 {
     m_instance = this;
 }
@@ -245,6 +251,33 @@ void PluginManager::loadPlugins()
     return d->loadPlugins();
 }
 
+/*!
+    \fn void PluginManager::setPluginWhitelist(const QStringList &names)
+    Restrict loading to the named plugins. Plugins they depend on are pulled
+    in transitively; everything else found in the plugin paths is left
+    unloaded. An empty list (the default) loads all plugins.
+ */
+void PluginManager::setPluginWhitelist(const QStringList &names)
+{
+    d->whitelist = names;
+}
+
+/*!
+    \fn void PluginManager::setHeadless(bool headless)
+    Mark this run as headless. Plugins that own windows are expected to keep
+    them hidden; used together with setPluginWhitelist() for relay and
+    logging appliances.
+ */
+void PluginManager::setHeadless(bool headless)
+{
+    m_isHeadless = headless;
+}
+
+bool PluginManager::isHeadless() const
+{
+    return m_isHeadless;
+}
+
 /*!
     \fn QStringList PluginManager::pluginPaths() const
     The list of paths were the plugin manager searches for plugins.
@@ -574,13 +607,46 @@ void PluginManagerPrivate::removeObject(QObject *obj)
     allObjects.removeAll(obj);
 }
 
+namespace {
+/*
+    Maps a plugin library into the process from a worker thread,
+    see PluginSpecPrivate::preloadLibrary()
+ */
+class LibraryPreloader : public QRunnable {
+public:
+    LibraryPreloader(PluginSpecPrivate *spec) : m_spec(spec)
+    {}
+    void run()
+    {
+        m_spec->preloadLibrary();
+    }
+private:
+    PluginSpecPrivate *m_spec;
+};
+}
+
 /*!
     \fn void PluginManagerPrivate::loadPlugins()
     \internal
  */
 void PluginManagerPrivate::loadPlugins()
 {
+    QElapsedTimer startupTimer;
+
+    startupTimer.start();
     QList<PluginSpec *> queue = loadQueue();
+
+    // Map the plugin libraries into the process in parallel, the dynamic
+    // linker is the expensive part of the Loaded phase and is safe to run
+    // from a pool. Everything that follows creates QObjects and GUI state,
+    // so it stays on this thread in dependency order and simply finds each
+    // library already resident.
+    QThreadPool preloadPool;
+    foreach(PluginSpec * spec, queue) {
+        preloadPool.start(new LibraryPreloader(spec->d));
+    }
+    preloadPool.waitForDone();
+
     foreach(PluginSpec * spec, queue) {
         loadPlugin(spec, PluginSpec::Loaded);
     }
@@ -597,6 +663,8 @@ void PluginManagerPrivate::loadPlugins()
     emit q->pluginsChanged();
     q->m_allPluginsLoaded = true;
     emit q->pluginsLoadEnded();
+
+    writeStartupReport(queue, startupTimer.elapsed());
 }
 
 /*!
@@ -607,6 +675,11 @@ QList<PluginSpec *> PluginManagerPrivate::loadQueue()
 {
     QList<PluginSpec *> queue;
     foreach(PluginSpec * spec, pluginSpecs) {
+        // In whitelist mode only the named plugins seed the queue, their
+        // dependencies join it through the recursive overload below.
+        if (!whitelist.isEmpty() && !whitelist.contains(spec->name())) {
+            continue;
+        }
         QList<PluginSpec *> circularityCheckQueue;
         loadQueue(spec, queue, circularityCheckQueue);
     }
@@ -722,11 +795,16 @@ void PluginManagerPrivate::readPluginPaths()
         foreach(const QFileInfo &subdir, dirs)
         searchPaths << subdir.absoluteFilePath();
     }
-    foreach(const QString &specFile, specFiles) {
-        PluginSpec *spec = new PluginSpec;
-
-        spec->d->read(specFile);
-        pluginSpecs.append(spec);
+    // warm starts restore the parsed specs from the binary metadata cache,
+    // the XML is only parsed when a spec file was added, removed or changed
+    if (!readSpecsFromCache(specFiles)) {
+        foreach(const QString &specFile, specFiles) {
+            PluginSpec *spec = new PluginSpec;
+
+            spec->d->read(specFile);
+            pluginSpecs.append(spec);
+        }
+        writeSpecsToCache(specFiles);
     }
     resolveDependencies();
     // ensure deterministic plugin load order by sorting
@@ -734,6 +812,142 @@ void PluginManagerPrivate::readPluginPaths()
     emit q->pluginsChanged();
 }
 
+static const quint32 pluginSpecCacheMagic   = 0x47435350; // "GCSP"
+static const quint32 pluginSpecCacheVersion = 1;
+
+/*!
+    \fn QString PluginManagerPrivate::specCacheFilePath() const
+    \internal
+ */
+QString PluginManagerPrivate::specCacheFilePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+           + QLatin1String("/pluginspecs.cache");
+}
+
+/*!
+    \fn bool PluginManagerPrivate::readSpecsFromCache(const QStringList &specFiles)
+    \internal
+
+    Populates pluginSpecs from the metadata cache. Returns false and leaves
+    pluginSpecs empty when the cache is missing, stale or damaged, in which
+    case the caller falls back to parsing the spec files.
+ */
+bool PluginManagerPrivate::readSpecsFromCache(const QStringList &specFiles)
+{
+    QFile file(specCacheFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_8);
+    quint32 magic   = 0;
+    quint32 version = 0;
+    qint32 count    = 0;
+    in >> magic >> version >> count;
+    if ((magic != pluginSpecCacheMagic) || (version != pluginSpecCacheVersion)
+        || (count != specFiles.count())) {
+        return false;
+    }
+    QList<PluginSpec *> cachedSpecs;
+    bool ok = true;
+    for (qint32 i = 0; i < count && ok; ++i) {
+        QString filePath;
+        qint64 lastModified = 0;
+        qint64 size = 0;
+        in >> filePath >> lastModified >> size;
+        // any difference in path, mtime or size invalidates the whole cache
+        QFileInfo fileInfo(specFiles.at(i));
+        if ((filePath != fileInfo.absoluteFilePath())
+            || (lastModified != fileInfo.lastModified().toMSecsSinceEpoch())
+            || (size != fileInfo.size())) {
+            ok = false;
+            break;
+        }
+        PluginSpec *spec = new PluginSpec;
+        cachedSpecs.append(spec);
+        ok = spec->d->readFromCache(in, filePath);
+    }
+    if (!ok || (in.status() != QDataStream::Ok)) {
+        qDeleteAll(cachedSpecs);
+        return false;
+    }
+    pluginSpecs += cachedSpecs;
+    return true;
+}
+
+/*!
+    \fn void PluginManagerPrivate::writeSpecsToCache(const QStringList &specFiles)
+    \internal
+
+    Snapshots the freshly parsed specs. Must be called while pluginSpecs is
+    still in specFiles order, i.e. before sorting.
+ */
+void PluginManagerPrivate::writeSpecsToCache(const QStringList &specFiles)
+{
+    foreach(PluginSpec * spec, pluginSpecs) {
+        // only snapshot a fully valid set so errors resurface on restart
+        if (spec->hasError()) {
+            return;
+        }
+    }
+    QFileInfo cacheInfo(specCacheFilePath());
+    QDir().mkpath(cacheInfo.absolutePath());
+    QFile file(cacheInfo.absoluteFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_8);
+    out << pluginSpecCacheMagic << pluginSpecCacheVersion << (qint32)specFiles.count();
+    for (int i = 0; i < specFiles.count(); ++i) {
+        QFileInfo fileInfo(specFiles.at(i));
+        out << fileInfo.absoluteFilePath()
+            << (qint64)fileInfo.lastModified().toMSecsSinceEpoch()
+            << (qint64)fileInfo.size();
+        pluginSpecs.at(i)->d->writeToCache(out);
+    }
+}
+
+/*!
+    \fn void PluginManagerPrivate::writeStartupReport(const QList<PluginSpec *> &queue, qint64 totalElapsed) const
+    \internal
+
+    Persists the per-plugin startup timings of the last run next to the
+    spec cache, slowest plugin first, so cold-start regressions can be
+    spotted by diffing reports between builds.
+ */
+void PluginManagerPrivate::writeStartupReport(const QList<PluginSpec *> &queue, qint64 totalElapsed) const
+{
+    QFileInfo reportInfo(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                         + QLatin1String("/startup-report.txt"));
+
+    QDir().mkpath(reportInfo.absolutePath());
+    QFile file(reportInfo.absoluteFilePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return;
+    }
+    QList<PluginSpec *> sorted = queue;
+    qSort(sorted.begin(), sorted.end(), [](PluginSpec *s1, PluginSpec *s2) {
+        return (s1->loadElapsed() + s1->initializeElapsed() + s1->extensionsInitializedElapsed())
+               > (s2->loadElapsed() + s2->initializeElapsed() + s2->extensionsInitializedElapsed());
+    });
+    QTextStream out(&file);
+    out << "Plugin startup report, " << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n";
+    out << "Total: " << totalElapsed << " ms for " << sorted.count() << " plugins\n\n";
+    out << QString("%1 %2 %3 %4 %5\n")
+        .arg("Plugin", -30).arg("Total", 7).arg("Load", 7).arg("Init", 7).arg("ExtInit", 7);
+    foreach(PluginSpec * spec, sorted) {
+        out << QString("%1 %2 %3 %4 %5\n")
+            .arg(spec->name(), -30)
+            .arg(spec->loadElapsed() + spec->initializeElapsed() + spec->extensionsInitializedElapsed(), 7)
+            .arg(spec->loadElapsed(), 7)
+            .arg(spec->initializeElapsed(), 7)
+            .arg(spec->extensionsInitializedElapsed(), 7);
+    }
+}
+
 void PluginManagerPrivate::resolveDependencies()
 {
     foreach(PluginSpec * spec, pluginSpecs) {
@@ -96,6 +96,12 @@ public:
 
     // Plugin operations
     void loadPlugins();
+    // Restrict loading to the named plugins plus their dependencies. An
+    // empty list (the default) loads everything found in the plugin paths.
+    void setPluginWhitelist(const QStringList &names);
+    // Headless appliance mode : plugins that own windows keep them hidden
+    void setHeadless(bool headless);
+    bool isHeadless() const;
     QStringList pluginPaths() const;
     void setPluginPaths(const QStringList &paths);
     QList<PluginSpec *> plugins() const;
@@ -130,6 +136,7 @@ private:
     static PluginManager *m_instance;
     mutable QReadWriteLock m_lock;
     bool m_allPluginsLoaded;
+    bool m_isHeadless;
 
     friend class Internal::PluginManagerPrivate;
 };
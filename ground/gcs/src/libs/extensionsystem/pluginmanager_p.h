@@ -60,6 +60,8 @@ public:
 
     QList<PluginSpec *> pluginSpecs;
     QList<PluginSpec *> testSpecs;
+    // When non-empty only these plugins (and their dependencies) are loaded
+    QStringList whitelist;
     QStringList pluginPaths;
     QString extension;
     QList<QObject *> allObjects; // ### make this a QList<QPointer<QObject> > > ?
@@ -77,6 +79,10 @@ private:
     PluginManager *q;
 
     void readPluginPaths();
+    QString specCacheFilePath() const;
+    bool readSpecsFromCache(const QStringList &specFiles);
+    void writeSpecsToCache(const QStringList &specFiles);
+    void writeStartupReport(const QList<PluginSpec *> &queue, qint64 totalElapsed) const;
     bool loadQueue(PluginSpec *spec,
                    QList<PluginSpec *> &queue,
                    QList<PluginSpec *> &circularityCheckQueue);
@@ -33,6 +33,7 @@
 #include "iplugin_p.h"
 #include "pluginmanager.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QXmlStreamReader>
@@ -321,6 +322,35 @@ QString PluginSpec::errorString() const
     return d->errorString;
 }
 
+/*!
+    \fn qint64 PluginSpec::loadElapsed() const
+    Time spent loading the plugin library and creating the root component,
+    in milliseconds. Valid once the PluginSpec::Loaded transition has been
+    attempted, 0 before that.
+ */
+qint64 PluginSpec::loadElapsed() const
+{
+    return d->loadElapsed;
+}
+
+/*!
+    \fn qint64 PluginSpec::initializeElapsed() const
+    Time spent in the plugin's initialize() method, in milliseconds.
+ */
+qint64 PluginSpec::initializeElapsed() const
+{
+    return d->initializeElapsed;
+}
+
+/*!
+    \fn qint64 PluginSpec::extensionsInitializedElapsed() const
+    Time spent in the plugin's extensionsInitialized() method, in milliseconds.
+ */
+qint64 PluginSpec::extensionsInitializedElapsed() const
+{
+    return d->extensionsInitializedElapsed;
+}
+
 /*!
     \fn bool PluginSpec::provides(const QString &pluginName, const QString &version) const
     Returns if this plugin can be used to fill in a dependency of the given
@@ -384,6 +414,9 @@ PluginSpecPrivate::PluginSpecPrivate(PluginSpec *spec)
     : plugin(0),
     state(PluginSpec::Invalid),
     hasError(false),
+    loadElapsed(0),
+    initializeElapsed(0),
+    extensionsInitializedElapsed(0),
     q(spec)
 {}
 
@@ -439,6 +472,63 @@ bool PluginSpecPrivate::read(const QString &fileName)
     return true;
 }
 
+/*!
+    \fn bool PluginSpecPrivate::readFromCache(QDataStream &in, const QString &fileName)
+    \internal
+
+    Restores the result of a previous read() of \a fileName from the binary
+    metadata cache, skipping the XML parsing. The caller is responsible for
+    checking that the cache entry is still valid for the file.
+ */
+bool PluginSpecPrivate::readFromCache(QDataStream &in, const QString &fileName)
+{
+    in >> name >> version >> compatVersion >> vendor >> copyright >> license
+    >> description >> url;
+    qint32 count = 0;
+    in >> count;
+    dependencies.clear();
+    for (qint32 i = 0; i < count; ++i) {
+        PluginDependency dep;
+        in >> dep.name >> dep.version;
+        dependencies.append(dep);
+    }
+    in >> count;
+    argumentDescriptions.clear();
+    for (qint32 i = 0; i < count; ++i) {
+        PluginArgumentDescription arg;
+        in >> arg.name >> arg.parameter >> arg.description;
+        argumentDescriptions.append(arg);
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+    QFileInfo fileInfo(fileName);
+    location    = fileInfo.absolutePath();
+    filePath    = fileInfo.absoluteFilePath();
+    hasError    = false;
+    errorString = "";
+    state       = PluginSpec::Read;
+    return true;
+}
+
+/*!
+    \fn void PluginSpecPrivate::writeToCache(QDataStream &out) const
+    \internal
+ */
+void PluginSpecPrivate::writeToCache(QDataStream &out) const
+{
+    out << name << version << compatVersion << vendor << copyright << license
+        << description << url;
+    out << (qint32)dependencies.count();
+    foreach(const PluginDependency &dep, dependencies) {
+        out << dep.name << dep.version;
+    }
+    out << (qint32)argumentDescriptions.count();
+    foreach(const PluginArgumentDescription &arg, argumentDescriptions) {
+        out << arg.name << arg.parameter << arg.description;
+    }
+}
+
 /*!
     \fn bool PluginSpecPrivate::reportError(const QString &err)
     \internal
@@ -770,44 +860,78 @@ bool PluginSpecPrivate::resolveDependencies(const QList<PluginSpec *> &specs)
 }
 
 /*!
-    \fn bool PluginSpecPrivate::loadLibrary()
+    \fn QString PluginSpecPrivate::libraryName() const
     \internal
  */
-bool PluginSpecPrivate::loadLibrary()
+QString PluginSpecPrivate::libraryName() const
 {
-    if (hasError) {
-        return false;
-    }
-    if (state != PluginSpec::Resolved) {
-        if (state == PluginSpec::Loaded) {
-            return true;
-        }
-        errorString = QCoreApplication::translate("PluginSpec", "Loading the library failed because state != Resolved");
-        hasError    = true;
-        return false;
-    }
 #ifdef QT_NO_DEBUG
 
 #ifdef Q_OS_WIN
-    QString libName = QString("%1/%2.dll").arg(location).arg(name);
+    return QString("%1/%2.dll").arg(location).arg(name);
+
 #elif defined(Q_OS_MAC)
-    QString libName = QString("%1/lib%2.dylib").arg(location).arg(name);
+    return QString("%1/lib%2.dylib").arg(location).arg(name);
+
 #else
-    QString libName = QString("%1/lib%2.so").arg(location).arg(name);
+    return QString("%1/lib%2.so").arg(location).arg(name);
+
 #endif
 
 #else // Q_NO_DEBUG
 
 #ifdef Q_OS_WIN
-    QString libName = QString("%1/%2d.dll").arg(location).arg(name);
+    return QString("%1/%2d.dll").arg(location).arg(name);
+
 #elif defined(Q_OS_MAC)
-    QString libName = QString("%1/lib%2_debug.dylib").arg(location).arg(name);
+    return QString("%1/lib%2_debug.dylib").arg(location).arg(name);
+
 #else
-    QString libName = QString("%1/lib%2.so").arg(location).arg(name);
-#endif
+    return QString("%1/lib%2.so").arg(location).arg(name);
 
 #endif
 
+#endif // ifdef QT_NO_DEBUG
+}
+
+/*!
+    \fn bool PluginSpecPrivate::preloadLibrary()
+    \internal
+
+    Maps the plugin library into the process without creating the root
+    component. Only touches dynamic linker state, so it is safe to call
+    from a worker thread; errors are left for loadLibrary() to report.
+ */
+bool PluginSpecPrivate::preloadLibrary()
+{
+    if (hasError || state != PluginSpec::Resolved) {
+        return false;
+    }
+    PluginLoader loader(libraryName());
+    return loader.load();
+}
+
+/*!
+    \fn bool PluginSpecPrivate::loadLibrary()
+    \internal
+ */
+bool PluginSpecPrivate::loadLibrary()
+{
+    if (hasError) {
+        return false;
+    }
+    if (state != PluginSpec::Resolved) {
+        if (state == PluginSpec::Loaded) {
+            return true;
+        }
+        errorString = QCoreApplication::translate("PluginSpec", "Loading the library failed because state != Resolved");
+        hasError    = true;
+        return false;
+    }
+    QString libName = libraryName();
+
+    QElapsedTimer timer;
+    timer.start();
     PluginLoader loader(libName);
     if (!loader.load()) {
         hasError    = true;
@@ -821,6 +945,7 @@ bool PluginSpecPrivate::loadLibrary()
         loader.unload();
         return false;
     }
+    loadElapsed = timer.elapsed();
     state  = PluginSpec::Loaded;
     plugin = pluginObject;
     plugin->d->pluginSpec = q;
@@ -850,11 +975,14 @@ bool PluginSpecPrivate::initializePlugin()
         return false;
     }
     QString err;
+    QElapsedTimer timer;
+    timer.start();
     if (!plugin->initialize(arguments, &err)) {
         errorString = QCoreApplication::translate("PluginSpec", "Plugin initialization failed: %1").arg(err);
         hasError    = true;
         return false;
     }
+    initializeElapsed = timer.elapsed();
     state = PluginSpec::Initialized;
     return true;
 }
@@ -881,7 +1009,10 @@ bool PluginSpecPrivate::initializeExtensions()
         hasError    = true;
         return false;
     }
+    QElapsedTimer timer;
+    timer.start();
     plugin->extensionsInitialized();
+    extensionsInitializedElapsed = timer.elapsed();
     state = PluginSpec::Running;
     return true;
 }
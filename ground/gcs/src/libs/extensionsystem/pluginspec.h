@@ -99,6 +99,12 @@ public:
     bool hasError() const;
     QString errorString() const;
 
+    // startup timings in milliseconds, valid once the corresponding
+    // state transition has been attempted (0 before that)
+    qint64 loadElapsed() const;
+    qint64 initializeElapsed() const;
+    qint64 extensionsInitializedElapsed() const;
+
 private:
     PluginSpec();
 
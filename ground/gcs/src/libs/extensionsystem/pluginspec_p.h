@@ -33,6 +33,7 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QStringList>
+#include <QtCore/QDataStream>
 #include <QtCore/QXmlStreamReader>
 
 namespace ExtensionSystem {
@@ -47,8 +48,11 @@ public:
     PluginSpecPrivate(PluginSpec *spec);
 
     bool read(const QString &fileName);
+    bool readFromCache(QDataStream &in, const QString &fileName);
+    void writeToCache(QDataStream &out) const;
     bool provides(const QString &pluginName, const QString &version) const;
     bool resolveDependencies(const QList<PluginSpec *> &specs);
+    bool preloadLibrary();
     bool loadLibrary();
     bool initializePlugin();
     bool initializeExtensions();
@@ -77,12 +81,18 @@ public:
     bool hasError;
     QString errorString;
 
+    // per-phase startup timings in milliseconds
+    qint64 loadElapsed;
+    qint64 initializeElapsed;
+    qint64 extensionsInitializedElapsed;
+
     static bool isValidVersion(const QString &version);
     static int versionCompare(const QString &version1, const QString &version2);
 
 private:
     PluginSpec *q;
 
+    QString libraryName() const;
     bool reportError(const QString &err);
     void readPluginSpec(QXmlStreamReader &reader);
     void readDependencies(QXmlStreamReader &reader);
@@ -51,7 +51,8 @@ QString Cache::CacheLocation()
 {
     return cache;
 }
-Cache::Cache()
+Cache::Cache() :
+    geoMemCache(100), placemarkMemCache(100)
 {
     if (cache.isNull() | cache.isEmpty()) {
         cache = Utils::GetStoragePath() + "mapscache" + QDir::separator();
@@ -64,6 +65,9 @@ QString Cache::GetGeocoderFromCache(const QString &urlEnd)
     qDebug() << "Entered GetGeocoderFromCache";
 #endif
     QString ret = QString::null;
+    if (geoMemCache.contains(urlEnd)) {
+        return *geoMemCache.object(urlEnd);
+    }
     QString filename = geoCache + QString(urlEnd) + ".geo";
 #ifdef DEBUG_GetGeocoderFromCache
     qDebug() << "GetGeocoderFromCache: Does file exist?:" << filename;
@@ -77,7 +81,8 @@ QString Cache::GetGeocoderFromCache(const QString &urlEnd)
         if (file.open(QIODevice::ReadOnly)) {
             QTextStream stream(&file);
             stream.setCodec("UTF-8");
-            stream >> ret;
+            ret = stream.readAll();
+            geoMemCache.insert(urlEnd, new QString(ret));
         }
     }
 #ifdef DEBUG_GetGeocoderFromCache
@@ -90,6 +95,8 @@ void Cache::CacheGeocoder(const QString &urlEnd, const QString &content)
     QString ret = QString::null;
     QString filename = geoCache + QString(urlEnd) + ".geo";
 
+    geoMemCache.insert(urlEnd, new QString(content));
+
 #ifdef DEBUG_CACHE
     qDebug() << "CacheGeocoder: Filename:" << filename;
 #endif // DEBUG_CACHE
@@ -128,6 +135,9 @@ QString Cache::GetPlacemarkFromCache(const QString &urlEnd)
     qDebug() << "Entered GetPlacemarkFromCache";
 #endif // DEBUG_CACHE
     QString ret = QString::null;
+    if (placemarkMemCache.contains(urlEnd)) {
+        return *placemarkMemCache.object(urlEnd);
+    }
     QString filename = placemarkCache + QString(urlEnd) + ".plc";
 #ifdef DEBUG_CACHE
     qDebug() << "GetPlacemarkFromCache: Does file exist?:" << filename;
@@ -141,7 +151,8 @@ QString Cache::GetPlacemarkFromCache(const QString &urlEnd)
         if (file.open(QIODevice::ReadOnly)) {
             QTextStream stream(&file);
             stream.setCodec("UTF-8");
-            stream >> ret;
+            ret = stream.readAll();
+            placemarkMemCache.insert(urlEnd, new QString(ret));
         }
     }
 #ifdef DEBUG_CACHE
@@ -154,6 +165,8 @@ void Cache::CachePlacemark(const QString &urlEnd, const QString &content)
     QString ret = QString::null;
     QString filename = placemarkCache + QString(urlEnd) + ".plc";
 
+    placemarkMemCache.insert(urlEnd, new QString(content));
+
 #ifdef DEBUG_CACHE
     qDebug() << "CachePlacemark: Filename:" << filename;
 #endif // DEBUG_CACHE
@@ -29,6 +29,7 @@
 
 #include "pureimagecache.h"
 #include "debugheader.h"
+#include <QCache>
 
 namespace core {
 class Cache {
@@ -58,6 +59,10 @@ private:
     QString routeCache;
     QString geoCache;
     QString placemarkCache;
+    // in-memory LRU front for the file caches, so repeat lookups within a
+    // session do not even touch the disk
+    QCache<QString, QString> geoMemCache;
+    QCache<QString, QString> placemarkMemCache;
 };
 }
 #endif // CACHE_H
@@ -26,13 +26,13 @@
  */
 #include "kibertilecache.h"
 
-// TODO add readwrite lock
-
 namespace core {
 KiberTileCache::KiberTileCache()
 {
     memoryCacheSize = 0;
     _MemoryCacheCapacity = 22;
+    evictions    = 0;
+    evictedBytes = 0;
 }
 
 void KiberTileCache::setMemoryCacheCapacity(const int &value)
@@ -44,22 +44,71 @@ void KiberTileCache::setMemoryCacheCapacity(const int &value)
 int KiberTileCache::MemoryCacheCapacity()
 {
     kiberCacheLock.lockForRead();
-    return _MemoryCacheCapacity;
-
+    int value = _MemoryCacheCapacity;
     kiberCacheLock.unlock();
+    return value;
+}
+
+/**
+ * Look a tile up and mark it as most recently used.
+ */
+QByteArray KiberTileCache::value(const RawTile &tile)
+{
+    QHash<RawTile, QLinkedList<RawTile>::iterator>::iterator pos = lruIndex.find(tile);
+
+    if (pos == lruIndex.end()) {
+        return QByteArray();
+    }
+    // move the tile to the back of the recency list
+    list.erase(pos.value());
+    pos.value() = list.insert(list.end(), tile);
+    return cachequeue.value(tile);
+}
+
+/**
+ * Insert or replace a tile, then evict the oldest tiles until the cache fits
+ * its byte budget again.
+ */
+void KiberTileCache::insert(const RawTile &tile, const QByteArray &pic)
+{
+    QHash<RawTile, QLinkedList<RawTile>::iterator>::iterator pos = lruIndex.find(tile);
+
+    if (pos != lruIndex.end()) {
+        // replace, the old payload no longer counts against the budget
+        memoryCacheSize -= cachequeue.value(tile).size();
+        list.erase(pos.value());
+        pos.value() = list.insert(list.end(), tile);
+    } else {
+        lruIndex.insert(tile, list.insert(list.end(), tile));
+    }
+    cachequeue.insert(tile, pic);
+    memoryCacheSize += pic.size();
+#ifdef DEBUG_MEMORY_CACHE
+    qDebug() << "Current memory=" << memoryCacheSize << " in " << cachequeue.count() << " tiles";
+#endif
+    RemoveMemoryOverload();
+}
+
+void KiberTileCache::evictOldest()
+{
+    RawTile oldest  = list.front();
+    int oldestBytes = cachequeue.value(oldest).size();
+
+    list.pop_front();
+    lruIndex.remove(oldest);
+    cachequeue.remove(oldest);
+    memoryCacheSize -= oldestBytes;
+    evictions++;
+    evictedBytes    += oldestBytes;
 }
 
 void KiberTileCache::RemoveMemoryOverload()
 {
-    while (MemoryCacheSize() > MemoryCacheCapacity()) {
-        if (cachequeue.count() > 0 && list.count() > 0) {
 #ifdef DEBUG_MEMORY_CACHE
-            qDebug() << "Cleaning Memory cache=" << " started with " << cachequeue.count() << " tile " << "ocupying " << memoryCacheSize << " bytes";
+    qDebug() << "Cleaning Memory cache=" << " started with " << cachequeue.count() << " tile " << "ocupying " << memoryCacheSize << " bytes";
 #endif
-            RawTile first = list.dequeue();
-            memoryCacheSize -= cachequeue.value(first).size();
-            cachequeue.remove(first);
-        }
+    while ((MemoryCacheSize() > _MemoryCacheCapacity) && !list.isEmpty()) {
+        evictOldest();
     }
 #ifdef DEBUG_MEMORY_CACHE
     qDebug() << "Cleaning Memory cache=" << " ended with " << cachequeue.count() << " tile " << "ocupying " << memoryCacheSize << " bytes";
@@ -30,10 +30,21 @@
 #include "rawtile.h"
 #include <QMutex>
 #include <QReadWriteLock>
-#include <QQueue>
+#include <QHash>
+#include <QLinkedList>
 #include <QDebug>
 #include "debugheader.h"
 namespace core {
+/**
+ * Byte budgeted LRU cache for decoded tiles.
+ *
+ * Tiles are kept in a hash for O(1) lookup and in a recency list (front is
+ * the oldest entry); every hit moves the tile to the back of the list and
+ * every insert evicts from the front until the cache fits its byte budget
+ * again, so memory stays bounded without bulk cleanup passes.
+ * MemoryCache keeps several of these as hash shards; each instance is one
+ * shard and the caller locks its kiberCacheLock around value()/insert().
+ */
 class KiberTileCache {
 public:
     KiberTileCache();
@@ -44,13 +55,34 @@ public:
     {
         return memoryCacheSize / 1048576.0;
     }
+    QByteArray value(const RawTile &tile);
+    void insert(const RawTile &tile, const QByteArray &pic);
     void RemoveMemoryOverload();
+
+    // eviction statistics
+    quint64 Evictions()
+    {
+        return evictions;
+    }
+    double EvictedMB()
+    {
+        return evictedBytes / 1048576.0;
+    }
+    int TileCount()
+    {
+        return cachequeue.count();
+    }
     QReadWriteLock kiberCacheLock;
-    QHash <RawTile, QByteArray> cachequeue;
-    QQueue <RawTile> list;
     long memoryCacheSize;
 private:
+    void evictOldest();
+
+    QHash<RawTile, QByteArray> cachequeue;
+    QHash<RawTile, QLinkedList<RawTile>::iterator> lruIndex;
+    QLinkedList<RawTile> list;
     int _MemoryCacheCapacity;
+    quint64 evictions;
+    quint64 evictedBytes;
 };
 }
 #endif // KIBERTILECACHE_H
@@ -68,7 +68,9 @@ public:
         GoogleLabelsKorea    = 4003,
         GoogleHybridKorea    = 4005,
 
-        Statkart_Topo2       = 5500
+        Statkart_Topo2       = 5500,
+
+        MBTiles = 6000
     };
     static QString StrByType(Types const & value)
     {
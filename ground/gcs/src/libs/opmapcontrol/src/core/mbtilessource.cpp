@@ -0,0 +1,144 @@
+/**
+ ******************************************************************************
+ *
+ * @file       mbtilessource.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @brief      Offline tile source reading MBTiles files
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "mbtilessource.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QVariant>
+#include <QFileInfo>
+#include <QDebug>
+
+namespace core {
+static const QString mbtilesConnectionName = QLatin1String("MBTilesConn");
+// map the tile file into memory so reads bypass the SQLite page cache copy
+static const qint64 MBTILES_MMAP_SIZE     = 256 * 1024 * 1024;
+
+MBTilesSource::MBTilesSource() : opened(false)
+{}
+
+MBTilesSource::~MBTilesSource()
+{
+    Close();
+}
+
+quint64 MBTilesSource::tileKey(const int &zoom, const int &x, const int &y)
+{
+    return ((quint64)zoom << 58) | ((quint64)x << 29) | (quint64)y;
+}
+
+/**
+ * Open an MBTiles file and load its tile index into memory.
+ */
+bool MBTilesSource::Open(const QString &file)
+{
+    QMutexLocker locker(&mutex);
+
+    if (opened) {
+        QSqlDatabase::database(mbtilesConnectionName).close();
+        QSqlDatabase::removeDatabase(mbtilesConnectionName);
+        tileIndex.clear();
+        opened = false;
+    }
+    if (file.isEmpty() || !QFileInfo(file).exists()) {
+        return false;
+    }
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", mbtilesConnectionName);
+    db.setDatabaseName(file);
+    if (!db.open()) {
+        qWarning() << "MBTilesSource: could not open" << file;
+        QSqlDatabase::removeDatabase(mbtilesConnectionName);
+        return false;
+    }
+    QSqlQuery query(db);
+    query.exec(QString("PRAGMA mmap_size=%1").arg(MBTILES_MMAP_SIZE));
+    if (!query.exec("SELECT zoom_level, tile_column, tile_row FROM tiles")) {
+        qWarning() << "MBTilesSource:" << file << "has no tiles table";
+        db.close();
+        QSqlDatabase::removeDatabase(mbtilesConnectionName);
+        return false;
+    }
+    while (query.next()) {
+        tileIndex.insert(tileKey(query.value(0).toInt(), query.value(1).toInt(), query.value(2).toInt()));
+    }
+    mbtilesFile = file;
+    opened      = true;
+    return true;
+}
+
+void MBTilesSource::Close()
+{
+    QMutexLocker locker(&mutex);
+
+    if (opened) {
+        QSqlDatabase::database(mbtilesConnectionName).close();
+        QSqlDatabase::removeDatabase(mbtilesConnectionName);
+        tileIndex.clear();
+        mbtilesFile.clear();
+        opened = false;
+    }
+}
+
+bool MBTilesSource::IsOpen()
+{
+    QMutexLocker locker(&mutex);
+
+    return opened;
+}
+
+QString MBTilesSource::FileName()
+{
+    QMutexLocker locker(&mutex);
+
+    return mbtilesFile;
+}
+
+/**
+ * Return the tile at the given position, or an empty array when the file
+ * does not contain it. The in-memory index answers misses without a query,
+ * MBTiles stores rows in TMS order so the y axis is flipped here.
+ */
+QByteArray MBTilesSource::GetImageFrom(const core::Point &pos, const int &zoom)
+{
+    QByteArray ret;
+    int tmsY = ((1 << zoom) - 1) - pos.Y();
+
+    QMutexLocker locker(&mutex);
+
+    if (!opened || !tileIndex.contains(tileKey(zoom, pos.X(), tmsY))) {
+        return ret;
+    }
+    QSqlQuery query(QSqlDatabase::database(mbtilesConnectionName));
+    query.prepare("SELECT tile_data FROM tiles WHERE zoom_level = ? AND tile_column = ? AND tile_row = ?");
+    query.addBindValue(zoom);
+    query.addBindValue(pos.X());
+    query.addBindValue(tmsY);
+    if (query.exec() && query.next()) {
+        ret = query.value(0).toByteArray();
+    }
+    return ret;
+}
+}
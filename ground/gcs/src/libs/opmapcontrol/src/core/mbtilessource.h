@@ -0,0 +1,63 @@
+/**
+ ******************************************************************************
+ *
+ * @file       mbtilessource.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @brief      Offline tile source reading MBTiles files
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef MBTILESSOURCE_H
+#define MBTILESSOURCE_H
+
+#include "point.h"
+#include <QString>
+#include <QByteArray>
+#include <QSet>
+#include <QMutex>
+
+namespace core {
+/**
+ * @brief Read-only tile source backed by an MBTiles file.
+ *
+ * Lets survey crews preload maps with standard tooling instead of ripping
+ * into the opaque disk cache. The full (zoom, column, row) index is loaded
+ * into a QSet when the file is opened, so a tile that is not in the file is
+ * answered from RAM without touching the database, and the connection maps
+ * the file into memory so tile reads come straight from the page cache.
+ */
+class MBTilesSource {
+public:
+    MBTilesSource();
+    ~MBTilesSource();
+    bool Open(const QString &file);
+    void Close();
+    bool IsOpen();
+    QString FileName();
+    QByteArray GetImageFrom(const core::Point &pos, const int &zoom);
+private:
+    static quint64 tileKey(const int &zoom, const int &x, const int &y);
+    QString mbtilesFile;
+    QSet<quint64> tileIndex;
+    QMutex mutex;
+    bool opened;
+};
+}
+#endif // MBTILESSOURCE_H
@@ -25,33 +25,76 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include "memorycache.h"
-// TODO add readwrite lock
 
 namespace core {
 MemoryCache::MemoryCache()
-{}
+{
+    // split the historical 22MB default budget between the shards
+    setMemoryCacheCapacity(22);
+}
 
+KiberTileCache & MemoryCache::shardFor(const RawTile &tile)
+{
+    return shards[qHash(tile) % ShardCount];
+}
 
 QByteArray MemoryCache::GetTileFromMemoryCache(const RawTile &tile)
 {
-    kiberCacheLock.lockForRead();
-    QByteArray pic;
-    pic = TilesInMemory.cachequeue.value(tile);
-    // TilesInMemory.find(key,&pic);
-    kiberCacheLock.unlock();
+    KiberTileCache & shard = shardFor(tile);
+
+    // a hit touches the shard's LRU list, so this needs the write lock
+    shard.kiberCacheLock.lockForWrite();
+    QByteArray pic = shard.value(tile);
+    shard.kiberCacheLock.unlock();
     return pic;
 }
 void MemoryCache::AddTileToMemoryCache(const RawTile &tile, const QByteArray &pic)
 {
-    kiberCacheLock.lockForWrite();
-    // QPixmapCache::Key key=TilesInMemory.insert(pic);
-    TilesInMemory.memoryCacheSize += pic.size();
-#ifdef DEBUG_MEMORY_CACHE
-    qDebug() << "Current memory=" << TilesInMemory.memoryCacheSize << " in " << TilesInMemory.cachequeue.count() << " tiles";
-#endif
-    TilesInMemory.cachequeue.insert(tile, pic);
-    TilesInMemory.list.enqueue(tile);
+    KiberTileCache & shard = shardFor(tile);
 
-    kiberCacheLock.unlock();
+    shard.kiberCacheLock.lockForWrite();
+    shard.insert(tile, pic);
+    shard.kiberCacheLock.unlock();
+}
+
+void MemoryCache::setMemoryCacheCapacity(const int &value)
+{
+    Mcapacity.lock();
+    _MemoryCacheCapacity = value;
+    Mcapacity.unlock();
+    int perShard = qMax(1, value / ShardCount);
+    for (int i = 0; i < ShardCount; ++i) {
+        shards[i].setMemoryCacheCapacity(perShard);
+    }
+}
+int MemoryCache::MemoryCacheCapacity()
+{
+    Mcapacity.lock();
+    int value = _MemoryCacheCapacity;
+    Mcapacity.unlock();
+    return value;
+}
+double MemoryCache::MemoryCacheSize()
+{
+    return MemoryCacheBytes() / 1048576.0;
+}
+quint64 MemoryCache::MemoryCacheBytes()
+{
+    quint64 bytes = 0;
+
+    for (int i = 0; i < ShardCount; ++i) {
+        shards[i].kiberCacheLock.lockForRead();
+        bytes += shards[i].memoryCacheSize;
+        shards[i].kiberCacheLock.unlock();
+    }
+    return bytes;
+}
+void MemoryCache::RemoveMemoryOverload()
+{
+    for (int i = 0; i < ShardCount; ++i) {
+        shards[i].kiberCacheLock.lockForWrite();
+        shards[i].RemoveMemoryOverload();
+        shards[i].kiberCacheLock.unlock();
+    }
 }
 }
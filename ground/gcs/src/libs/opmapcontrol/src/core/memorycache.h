@@ -35,14 +35,37 @@
 #include <QDebug>
 #include "debugheader.h"
 namespace core {
+/**
+ * In-memory tile cache, sharded by tile key hash.
+ *
+ * Every lookup touches the LRU list of its shard and so needs that shard's
+ * write lock; with a single cache the paint path and the fetch workers would
+ * all serialize on one lock. Spreading the tiles over independently locked
+ * KiberTileCache shards keeps that contention down to tiles that actually
+ * hash to the same shard. The byte budget is split evenly, which is a fair
+ * approximation because the hash spreads tiles uniformly.
+ */
 class MemoryCache {
 public:
     MemoryCache();
 
-    KiberTileCache TilesInMemory;
     QByteArray GetTileFromMemoryCache(const RawTile &tile);
     void AddTileToMemoryCache(const RawTile &tile, const QByteArray &pic);
-    QReadWriteLock kiberCacheLock;
+
+    // total budget in MB, divided between the shards
+    void setMemoryCacheCapacity(const int &value);
+    int MemoryCacheCapacity();
+    // MB respectively bytes currently held, summed over all shards
+    double MemoryCacheSize();
+    quint64 MemoryCacheBytes();
+    void RemoveMemoryOverload();
+
+    enum { ShardCount = 8 };
+private:
+    KiberTileCache & shardFor(const RawTile &tile);
+    KiberTileCache shards[ShardCount];
+    int _MemoryCacheCapacity;
+    QMutex Mcapacity;
 };
 }
 #endif // MEMORYCACHE_H
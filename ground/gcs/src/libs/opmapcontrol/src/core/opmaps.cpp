@@ -26,6 +26,12 @@
  */
 #include "opmaps.h"
 
+#include "utils/tracer.h"
+
+#include <QEventLoop>
+#include <QImageReader>
+#include <QThreadStorage>
+#include <QTimer>
 
 namespace core {
 OPMaps *OPMaps::m_pInstance = 0;
@@ -42,9 +48,57 @@ OPMaps::OPMaps() : RetryLoadTile(2), useMemoryCache(true)
 {
     accessmode  = AccessMode::ServerAndCache;
     LanguageStr = QLocale().bcp47Name();
+    healthClock.start();
     Cache::Instance();
 }
 
+// after this many consecutive failures the provider is considered down
+// and requests to it fail immediately
+static const int PROVIDER_FAIL_LIMIT = 3;
+// first probe after this long, doubling per further failure up to the cap
+static const qint64 PROVIDER_RETRY_BASE_MS = 2 * 1000;
+static const qint64 PROVIDER_RETRY_MAX_MS  = 60 * 1000;
+
+/**
+ * Whether a network request to this provider is currently worth making.
+ * While the provider is down one thread per cooldown period is let through
+ * as a recovery probe; a successful probe closes the circuit again.
+ */
+bool OPMaps::providerIsHealthy(const MapType::Types &type)
+{
+    QMutexLocker locker(&MproviderHealth);
+    ProviderHealth &health = providerHealth[(int)type];
+
+    if (health.failStreak < PROVIDER_FAIL_LIMIT) {
+        return true;
+    }
+    qint64 now = healthClock.elapsed();
+    if (now >= health.retryAtMsecs) {
+        // let this caller probe, and keep the others out meanwhile
+        qint64 backoff = PROVIDER_RETRY_BASE_MS << qMin(health.failStreak - PROVIDER_FAIL_LIMIT, 5);
+        health.retryAtMsecs = now + qMin(backoff, PROVIDER_RETRY_MAX_MS);
+        return true;
+    }
+    return false;
+}
+
+void OPMaps::reportProviderResult(const MapType::Types &type, bool success)
+{
+    QMutexLocker locker(&MproviderHealth);
+    ProviderHealth &health = providerHealth[(int)type];
+
+    if (success) {
+        health.failStreak   = 0;
+        health.retryAtMsecs = 0;
+    } else {
+        ++health.failStreak;
+        if (health.failStreak >= PROVIDER_FAIL_LIMIT) {
+            qint64 backoff = PROVIDER_RETRY_BASE_MS << qMin(health.failStreak - PROVIDER_FAIL_LIMIT, 5);
+            health.retryAtMsecs = healthClock.elapsed() + qMin(backoff, PROVIDER_RETRY_MAX_MS);
+        }
+    }
+}
+
 OPMaps::~OPMaps()
 {
     TileDBcacheQueue.wait();
@@ -53,6 +107,8 @@ OPMaps::~OPMaps()
 
 QByteArray OPMaps::GetImageFrom(const MapType::Types &type, const Point &pos, const int &zoom)
 {
+    GCS_TRACE_SCOPE("OPMaps::GetImageFrom");
+
 #ifdef DEBUG_TIMINGS
     QTime time;
     time.restart();
@@ -64,7 +120,7 @@ QByteArray OPMaps::GetImageFrom(const MapType::Types &type, const Point &pos, co
 
     if (useMemoryCache) {
 #ifdef DEBUG_GMAPS
-        qDebug() << "Try Tile from memory:Size=" << TilesInMemory.MemoryCacheSize();
+        qDebug() << "Try Tile from memory:Size=" << MemoryCacheSize();
 #endif // DEBUG_GMAPS
         ret = GetTileFromMemoryCache(RawTile(type, pos, zoom));
         if (!ret.isEmpty()) {
@@ -73,6 +129,19 @@ QByteArray OPMaps::GetImageFrom(const MapType::Types &type, const Point &pos, co
             errorvars.unlock();
         }
     }
+    if (ret.isEmpty() && (type == MapType::MBTiles)) {
+        // offline file source, never goes to the disk cache or the network
+        ret = mbtilesSource.GetImageFrom(pos, zoom);
+        if (!ret.isEmpty()) {
+            errorvars.lock();
+            ++diag.tilesFromDB;
+            errorvars.unlock();
+            if (useMemoryCache) {
+                AddTileToMemoryCache(RawTile(type, pos, zoom), ret);
+            }
+        }
+        return ret;
+    }
     if (ret.isEmpty()) {
 #ifdef DEBUG_GMAPS
         qDebug() << "Tile not in memory";
@@ -99,147 +168,232 @@ QByteArray OPMaps::GetImageFrom(const MapType::Types &type, const Point &pos, co
             }
         }
         if (accessmode != AccessMode::CacheOnly) {
-            QNetworkReply *reply;
-            QNetworkRequest qheader;
-            QNetworkAccessManager network;
-            // This SSL Hack is half assed... technically bad *security* joojoo.
-            // Required due to a QT5 bug on linux and Mac
-            //
-            QSslConfiguration conf = qheader.sslConfiguration();
-            conf.setPeerVerifyMode(QSslSocket::VerifyNone);
-            qheader.setSslConfiguration(conf);
-            network.setProxy(Proxy);
+            RawTile tileKey(type, pos, zoom);
+            // only one worker fetches a given tile : late arrivals wait for
+            // the fetch in flight and pick the result up from the memory
+            // cache instead of hitting the provider again
+            Minflight.lock();
+            bool fetchedElsewhere = false;
+            while (inflightTiles.contains(tileKey)) {
+                inflightWait.wait(&Minflight);
+                fetchedElsewhere = true;
+            }
+            if (!fetchedElsewhere) {
+                inflightTiles.insert(tileKey);
+            }
+            Minflight.unlock();
+            if (fetchedElsewhere) {
+                if (useMemoryCache) {
+                    ret = GetTileFromMemoryCache(tileKey);
+                }
+                return ret;
+            }
+            ret = GetImageFromServer(type, pos, zoom);
+            Minflight.lock();
+            inflightTiles.remove(tileKey);
+            inflightWait.wakeAll();
+            Minflight.unlock();
+        }
+    }
+#ifdef DEBUG_GMAPS
+    qDebug() << "Entered GetImageFrom";
+#endif // DEBUG_GMAPS
+    return ret;
+}
+
+/**
+ * Accept header for tile requests. Servers that can negotiate content
+ * (notably self hosted ones) then serve WebP tiles at roughly half the
+ * bytes of PNG/JPEG; everything downstream (memory cache, disk cache,
+ * decode) handles the raw bytes format agnostically, so the smaller
+ * tiles are stored and rendered as is. WebP is only advertised when
+ * this Qt build ships a decoder for it.
+ */
+static QByteArray tileAcceptHeader()
+{
+    static const QByteArray accept =
+        QImageReader::supportedImageFormats().contains("webp")
+        ? QByteArray("image/webp,image/*;q=0.8,*/*;q=0.5")
+        : QByteArray("*/*");
+
+    return accept;
+}
+
+/**
+ * Fetch a tile from the provider over the network.
+ *
+ * Runs on the tile loader pool threads; each thread keeps a persistent
+ * QNetworkAccessManager so requests reuse keep-alive connections to the
+ * provider instead of opening a new one per tile.
+ */
+QByteArray OPMaps::GetImageFromServer(const MapType::Types &type, const Point &pos, const int &zoom)
+{
+    GCS_TRACE_SCOPE("OPMaps::GetImageFromServer");
+
+    QByteArray ret;
+
+    if (!providerIsHealthy(type)) {
+        // circuit is open: the provider has been failing, degrade in
+        // milliseconds instead of waiting out another network timeout
+        errorvars.lock();
+        ++diag.networkerrors;
+        errorvars.unlock();
+        return ret;
+    }
+
+    QNetworkReply *reply;
+    QNetworkRequest qheader;
+    static QThreadStorage<QNetworkAccessManager *> networkManagers;
+
+    if (!networkManagers.hasLocalData()) {
+        networkManagers.setLocalData(new QNetworkAccessManager());
+    }
+    QNetworkAccessManager & network = *networkManagers.localData();
+    // This SSL Hack is half assed... technically bad *security* joojoo.
+    // Required due to a QT5 bug on linux and Mac
+    //
+    QSslConfiguration conf = qheader.sslConfiguration();
+    conf.setPeerVerifyMode(QSslSocket::VerifyNone);
+    qheader.setSslConfiguration(conf);
+    network.setProxy(Proxy);
 #ifdef DEBUG_GMAPS
-            qDebug() << "Try Tile from the Internet";
+    qDebug() << "Try Tile from the Internet";
 #endif // DEBUG_GMAPS
 #ifdef DEBUG_TIMINGS
-            qDebug() << "opmaps before make image url" << time.elapsed();
+    qDebug() << "opmaps before make image url" << time.elapsed();
 #endif
-            QString url = MakeImageUrl(type, pos, zoom, LanguageStr);
+    QString url = MakeImageUrl(type, pos, zoom, LanguageStr);
 #ifdef DEBUG_TIMINGS
-            qDebug() << "opmaps after make image url" << time.elapsed();
+    qDebug() << "opmaps after make image url" << time.elapsed();
 #endif // url can be hard coded for debugging purposes
-            qheader.setUrl(QUrl(url));
-            qheader.setRawHeader("User-Agent", UserAgent);
-            qheader.setRawHeader("Accept", "*/*");
-            switch (type) {
-            case MapType::GoogleMap:
-            case MapType::GoogleSatellite:
-            case MapType::GoogleLabels:
-            case MapType::GoogleTerrain:
-            case MapType::GoogleHybrid:
-            {
-                qheader.setRawHeader("Referrer", "http://maps.google.com/");
-            }
-            break;
-
-            case MapType::GoogleMapChina:
-            case MapType::GoogleSatelliteChina:
-            case MapType::GoogleLabelsChina:
-            case MapType::GoogleTerrainChina:
-            case MapType::GoogleHybridChina:
-            {
-                qheader.setRawHeader("Referrer", "http://ditu.google.cn/");
-            }
-            break;
+    qheader.setUrl(QUrl(url));
+    qheader.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+    qheader.setRawHeader("User-Agent", UserAgent);
+    qheader.setRawHeader("Accept", tileAcceptHeader());
+    switch (type) {
+    case MapType::GoogleMap:
+    case MapType::GoogleSatellite:
+    case MapType::GoogleLabels:
+    case MapType::GoogleTerrain:
+    case MapType::GoogleHybrid:
+    {
+        qheader.setRawHeader("Referrer", "http://maps.google.com/");
+    }
+    break;
 
-            case MapType::GoogleMapKorea:
-            case MapType::GoogleSatelliteKorea:
-            case MapType::GoogleLabelsKorea:
-            {
-                qheader.setRawHeader("Referrer", "http://maps.google.co.kr/");
-            }
-            break;
+    case MapType::GoogleMapChina:
+    case MapType::GoogleSatelliteChina:
+    case MapType::GoogleLabelsChina:
+    case MapType::GoogleTerrainChina:
+    case MapType::GoogleHybridChina:
+    {
+        qheader.setRawHeader("Referrer", "http://ditu.google.cn/");
+    }
+    break;
 
-            case MapType::BingHybrid:
-            case MapType::BingMap:
-            case MapType::BingSatellite:
-            {
-                qheader.setRawHeader("Referrer", "http://www.bing.com/maps/");
-            }
-            break;
+    case MapType::GoogleMapKorea:
+    case MapType::GoogleSatelliteKorea:
+    case MapType::GoogleLabelsKorea:
+    {
+        qheader.setRawHeader("Referrer", "http://maps.google.co.kr/");
+    }
+    break;
 
-            case MapType::OpenStreetMapSurfer:
-            case MapType::OpenStreetMapSurferTerrain:
-            {
-                qheader.setRawHeader("Referrer", "http://www.mapsurfer.net/");
-            }
-            break;
+    case MapType::BingHybrid:
+    case MapType::BingMap:
+    case MapType::BingSatellite:
+    {
+        qheader.setRawHeader("Referrer", "http://www.bing.com/maps/");
+    }
+    break;
 
-            case MapType::OpenStreetMap:
-            case MapType::OpenStreetOsm:
-            {
-                qheader.setRawHeader("Referrer", "http://www.openstreetmap.org/");
-            }
-            break;
-            case MapType::Statkart_Topo2:
-            {
-                qheader.setRawHeader("Referrer", "http://www.norgeskart.no/");
-            }
-            break;
+    case MapType::OpenStreetMapSurfer:
+    case MapType::OpenStreetMapSurferTerrain:
+    {
+        qheader.setRawHeader("Referrer", "http://www.mapsurfer.net/");
+    }
+    break;
 
-            default:
-                break;
-            }
+    case MapType::OpenStreetMap:
+    case MapType::OpenStreetOsm:
+    {
+        qheader.setRawHeader("Referrer", "http://www.openstreetmap.org/");
+    }
+    break;
+    case MapType::Statkart_Topo2:
+    {
+        qheader.setRawHeader("Referrer", "http://www.norgeskart.no/");
+    }
+    break;
+
+    default:
+        break;
+    }
 #ifdef DEBUG_GMAPS
-            qDebug() << "Timeout is " << Timeout;
-            qDebug() << "Get " << qheader.url();
+    qDebug() << "Timeout is " << Timeout;
+    qDebug() << "Get " << qheader.url();
 #endif // DEBUG_GMAPS
-            reply = network.get(qheader);
+    reply = network.get(qheader);
 #ifdef DEBUG_GMAPS
-            qDebug() << "reply " << reply;
+    qDebug() << "reply " << reply;
 #endif // DEBUG_GMAPS
 
-            QTime time;
-            while ((!(reply->isFinished()) || (time.elapsed() > (6 * Timeout)))) {
-                QCoreApplication::processEvents(QEventLoop::AllEvents);
-            }
+    // wait on an event loop instead of spinning on processEvents()
+    QEventLoop waitLoop;
+    QTimer timeoutTimer;
+    timeoutTimer.setSingleShot(true);
+    QObject::connect(reply, SIGNAL(finished()), &waitLoop, SLOT(quit()));
+    QObject::connect(&timeoutTimer, SIGNAL(timeout()), &waitLoop, SLOT(quit()));
+    timeoutTimer.start(6 * Timeout);
+    waitLoop.exec();
+    bool timedOut = !reply->isFinished();
+    if (timedOut) {
+        reply->abort();
+    }
 
 #ifdef DEBUG_GMAPS
-            qDebug() << "Finished?" << reply->error() << " abort?" << (time.elapsed() > Timeout * 6);
+    qDebug() << "Finished?" << reply->error() << " abort?" << timedOut;
 #endif // DEBUG_GMAPS
-            // If you are seeing Error 6 here you are dealing with a QT SSL Bug!!!
-            if ((reply->error() != QNetworkReply::NoError) | (time.elapsed() > Timeout * 6)) {
-                qWarning() << "Reply error: " << reply->errorString() << qheader.url();
-                return ret;
-            }
-            ret = reply->readAll();
-            // qDebug() << "ret " << ret;
-            reply->deleteLater(); // TODO can't this be global??
+    // If you are seeing Error 6 here you are dealing with a QT SSL Bug!!!
+    if ((reply->error() != QNetworkReply::NoError) | timedOut) {
+        qWarning() << "Reply error: " << reply->errorString() << qheader.url();
+        reportProviderResult(type, false);
+        reply->deleteLater();
+        return ret;
+    }
+    reportProviderResult(type, true);
+    ret = reply->readAll();
+    // qDebug() << "ret " << ret;
+    reply->deleteLater(); // TODO can't this be global??
 
-            if (ret.isEmpty()) {
-#ifdef DEBUG_GMAPS
-                qDebug() << "Invalid Tile";
-#endif // DEBUG_GMAPS
-                errorvars.lock();
-                ++diag.emptytiles;
-                errorvars.unlock();
-                return ret;
-            }
+    if (ret.isEmpty()) {
 #ifdef DEBUG_GMAPS
-            qDebug() << "Received Tile from the Internet";
+        qDebug() << "Invalid Tile";
 #endif // DEBUG_GMAPS
-            errorvars.lock();
-            ++diag.tilesFromNet;
-            errorvars.unlock();
-            if (useMemoryCache) {
+        errorvars.lock();
+        ++diag.emptytiles;
+        errorvars.unlock();
+        return ret;
+    }
 #ifdef DEBUG_GMAPS
-                qDebug() << "Add Tile to memory cache";
+    qDebug() << "Received Tile from the Internet";
 #endif // DEBUG_GMAPS
-                AddTileToMemoryCache(RawTile(type, pos, zoom), ret);
-            }
-            if (accessmode != AccessMode::ServerOnly) {
+    errorvars.lock();
+    ++diag.tilesFromNet;
+    errorvars.unlock();
+    if (useMemoryCache) {
 #ifdef DEBUG_GMAPS
-                qDebug() << "Add tile to DataBase";
+        qDebug() << "Add Tile to memory cache";
 #endif // DEBUG_GMAPS
-                CacheItemQueue *item = new CacheItemQueue(type, pos, ret, zoom);
-                TileDBcacheQueue.EnqueueCacheTask(item);
-            }
-        }
+        AddTileToMemoryCache(RawTile(type, pos, zoom), ret);
     }
+    if (accessmode != AccessMode::ServerOnly) {
 #ifdef DEBUG_GMAPS
-    qDebug() << "Entered GetImageFrom";
+        qDebug() << "Add tile to DataBase";
 #endif // DEBUG_GMAPS
+        CacheItemQueue *item = new CacheItemQueue(type, pos, ret, zoom);
+        TileDBcacheQueue.EnqueueCacheTask(item);
+    }
     return ret;
 }
 
@@ -249,7 +403,10 @@ bool OPMaps::ExportToGMDB(const QString &file)
 }
 bool OPMaps::ImportFromGMDB(const QString &file)
 {
-    return Cache::Instance()->ImageCache.ExportMapDataToDB(file, Cache::Instance()->ImageCache.GtileCache() + QDir::separator() + "Data.qmdb");
+    bool ret = Cache::Instance()->ImageCache.ExportMapDataToDB(file, Cache::Instance()->ImageCache.GtileCache() + QDir::separator() + "Data.qmdb");
+
+    Cache::Instance()->ImageCache.InvalidatePresenceIndex();
+    return ret;
 }
 
 diagnostics OPMaps::GetDiagnostics()
@@ -40,6 +40,11 @@
 #include "alllayersoftype.h"
 #include "urlfactory.h"
 #include "diagnostics.h"
+#include "mbtilessource.h"
+#include <QSet>
+#include <QHash>
+#include <QWaitCondition>
+#include <QElapsedTimer>
 
 // #include "point.h"
 
@@ -83,13 +88,47 @@ public: ~OPMaps();
     }
     int RetryLoadTile;
     diagnostics GetDiagnostics();
+    // offline MBTiles file backing the MapType::MBTiles provider
+    bool OpenMBTiles(const QString &file)
+    {
+        return mbtilesSource.Open(file);
+    }
+    void CloseMBTiles()
+    {
+        mbtilesSource.Close();
+    }
+    QString MBTilesFile()
+    {
+        return mbtilesSource.FileName();
+    }
 
 private:
+    QByteArray GetImageFromServer(const MapType::Types &type, const core::Point &pos, const int &zoom);
+
+    // per-provider circuit breaker, so a dead tile server fails requests
+    // immediately instead of costing every tile a full network timeout
+    struct ProviderHealth {
+        int    failStreak;
+        qint64 retryAtMsecs;
+        ProviderHealth() : failStreak(0), retryAtMsecs(0) {}
+    };
+    bool providerIsHealthy(const MapType::Types &type);
+    void reportProviderResult(const MapType::Types &type, bool success);
+    QHash<int, ProviderHealth> providerHealth;
+    QMutex MproviderHealth;
+    QElapsedTimer healthClock;
+
     bool useMemoryCache;
     LanguageType::Types Language;
     AccessMode::Types accessmode;
+    // tile keys currently being fetched from the network, used to dedupe
+    // concurrent requests for the same tile across loader threads
+    QSet<RawTile> inflightTiles;
+    QMutex Minflight;
+    QWaitCondition inflightWait;
     // PureImageCache ImageCacheLocal;//TODO Criar acesso Get Set
     TileCacheQueue TileDBcacheQueue;
+    MBTilesSource mbtilesSource;
     OPMaps();
     OPMaps(OPMaps const &) {}
     OPMaps & operator=(OPMaps const &)
@@ -35,6 +35,17 @@ QPixmap PureImageProxy::FromStream(const QByteArray &array)
 {
     return QPixmap::fromImage(QImage::fromData(array));
 }
+
+/**
+ * Decodes a tile image and converts it to the premultiplied format the
+ * raster paint engine blends natively, so painting it later never triggers
+ * an implicit per-frame format conversion. Safe to call from any thread,
+ * which is what makes decoding on the tile loader pool possible.
+ */
+QImage PureImageProxy::DecodeToRenderFormat(const QByteArray &array)
+{
+    return QImage::fromData(array).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
 bool PureImageProxy::Save(const QByteArray &array, QPixmap &pic)
 {
     pic = QPixmap::fromImage(QImage::fromData(array));
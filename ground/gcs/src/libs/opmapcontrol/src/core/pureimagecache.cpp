@@ -31,12 +31,67 @@
 namespace core {
 qlonglong PureImageCache::ConnCounter = 0;
 
-PureImageCache::PureImageCache()
+PureImageCache::PureImageCache() : presenceIndexLoaded(false)
 {}
 
+quint64 PureImageCache::presenceKey(const MapType::Types &type, const Point &pos, const int &zoom)
+{
+    return ((quint64)(int)type << 51) | ((quint64)zoom << 46) | ((quint64)pos.X() << 23) | (quint64)pos.Y();
+}
+
+/**
+ * Load the (type, zoom, x, y) key of every cached tile into the presence
+ * index. Runs once per cache location, on the first lookup; panning over
+ * unripped areas afterwards never reaches the database.
+ */
+void PureImageCache::loadPresenceIndex()
+{
+    presenceIndex.clear();
+    presenceIndexLoaded = false;
+    QString db = gtilecache + "Data.qmdb";
+    Mcounter.lock();
+    qlonglong id = ++ConnCounter;
+    Mcounter.unlock();
+    {
+        QSqlDatabase cn = QSqlDatabase::addDatabase("QSQLITE", QString::number(id));
+        cn.setDatabaseName(db);
+        cn.setConnectOptions("QSQLITE_ENABLE_SHARED_CACHE");
+        if (cn.open()) {
+            QSqlQuery query(cn);
+            if (query.exec("SELECT Type, Zoom, X, Y FROM Tiles")) {
+                while (query.next()) {
+                    presenceIndex.insert(presenceKey((MapType::Types)query.value(0).toInt(),
+                                                     Point(query.value(2).toInt(), query.value(3).toInt()),
+                                                     query.value(1).toInt()));
+                }
+                presenceIndexLoaded = true;
+            }
+            cn.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(QString::number(id));
+}
+
+/**
+ * Drop the presence index so it is rebuilt on the next lookup. Must be
+ * called after tiles are added or removed behind PutImageToCache's back,
+ * e.g. a GMDB import.
+ */
+void PureImageCache::InvalidatePresenceIndex()
+{
+    Mpresence.lock();
+    presenceIndex.clear();
+    presenceIndexLoaded = false;
+    Mpresence.unlock();
+}
+
 void PureImageCache::setGtileCache(const QString &value)
 {
     lock.lockForWrite();
+    Mpresence.lock();
+    presenceIndex.clear();
+    presenceIndexLoaded = false;
+    Mpresence.unlock();
     gtilecache = value;
     QDir d;
     if (!d.exists(gtilecache)) {
@@ -158,6 +213,62 @@ bool PureImageCache::CreateEmptyDB(const QString &file)
     QSqlDatabase::removeDatabase(QLatin1String("CreateConn"));
     return true;
 }
+/**
+ * Return the persistent write connection, (re)opening it when needed.
+ *
+ * Tile writes all happen on the TileCacheQueue thread, so a single named
+ * connection with WAL journaling can be kept open instead of creating and
+ * tearing down a connection per tile. WAL also lets the fetch path keep
+ * reading while a write batch is in flight.
+ */
+QSqlDatabase PureImageCache::writerConnection()
+{
+    QString db = gtilecache + "Data.qmdb";
+    QSqlDatabase cn = QSqlDatabase::database(QLatin1String("TileWriterConn"), false);
+
+    if (cn.isValid() && cn.isOpen() && (cn.databaseName() == db)) {
+        return cn;
+    }
+    if (cn.isValid()) {
+        // the cache location changed, reopen against the new database
+        cn.close();
+        QSqlDatabase::removeDatabase(QLatin1String("TileWriterConn"));
+    }
+    cn = QSqlDatabase::addDatabase("QSQLITE", QLatin1String("TileWriterConn"));
+    cn.setDatabaseName(db);
+    cn.setConnectOptions("QSQLITE_ENABLE_SHARED_CACHE");
+    if (cn.open()) {
+        QSqlQuery query(cn);
+        query.exec("PRAGMA journal_mode=WAL");
+        query.exec("PRAGMA synchronous=NORMAL");
+    }
+    return cn;
+}
+
+/**
+ * Start a write batch : all PutImageToCache() calls until EndWriteBatch()
+ * commit as one transaction.
+ */
+void PureImageCache::BeginWriteBatch()
+{
+    if (gtilecache.isEmpty() | gtilecache.isNull()) {
+        return;
+    }
+    lock.lockForRead();
+    writerConnection().transaction();
+    lock.unlock();
+}
+
+void PureImageCache::EndWriteBatch()
+{
+    if (gtilecache.isEmpty() | gtilecache.isNull()) {
+        return;
+    }
+    lock.lockForRead();
+    writerConnection().commit();
+    lock.unlock();
+}
+
 bool PureImageCache::PutImageToCache(const QByteArray &tile, const MapType::Types &type, const Point &pos, const int &zoom)
 {
     if (gtilecache.isEmpty() | gtilecache.isNull()) {
@@ -167,47 +278,54 @@ bool PureImageCache::PutImageToCache(const QByteArray &tile, const MapType::Type
 #ifdef DEBUG_PUREIMAGECACHE
     qDebug() << "PutImageToCache Start:"; // <<pos;
 #endif // DEBUG_PUREIMAGECACHE
-    Mcounter.lock();
-    qlonglong id = ++ConnCounter;
-    Mcounter.unlock();
-    {
-        QSqlDatabase cn;
-        cn = QSqlDatabase::addDatabase("QSQLITE", QString::number(id));
-        QString db = gtilecache + "Data.qmdb";
-        cn.setDatabaseName(db);
-        cn.setConnectOptions("QSQLITE_ENABLE_SHARED_CACHE");
-        if (cn.open()) {
-            {
-                QSqlQuery query(cn);
-                query.prepare("INSERT INTO Tiles(X, Y, Zoom, Type,Date) VALUES(?, ?, ?, ?,?)");
-                query.addBindValue(pos.X());
-                query.addBindValue(pos.Y());
-                query.addBindValue(zoom);
+    QSqlDatabase cn = writerConnection();
+    bool ok = false;
+    if (cn.isOpen()) {
+        {
+            QSqlQuery query(cn);
+            query.prepare("INSERT INTO Tiles(X, Y, Zoom, Type,Date) VALUES(?, ?, ?, ?,?)");
+            query.addBindValue(pos.X());
+            query.addBindValue(pos.Y());
+            query.addBindValue(zoom);
 
-                query.addBindValue((int)type);
-                query.addBindValue(QDateTime::currentDateTime().toString());
-                query.exec();
-            }
-            {
-                QSqlQuery query(cn);
-                query.prepare("INSERT INTO TilesData(id, Tile) VALUES((SELECT last_insert_rowid()), ?)");
-                query.addBindValue(tile);
-                query.exec();
-            }
-            cn.close();
+            query.addBindValue((int)type);
+            query.addBindValue(QDateTime::currentDateTime().toString());
+            query.exec();
+        }
+        {
+            QSqlQuery query(cn);
+            query.prepare("INSERT INTO TilesData(id, Tile) VALUES((SELECT last_insert_rowid()), ?)");
+            query.addBindValue(tile);
+            ok = query.exec();
         }
     }
-    QSqlDatabase::removeDatabase(QString::number(id));
+    if (ok) {
+        Mpresence.lock();
+        presenceIndex.insert(presenceKey(type, pos, zoom));
+        Mpresence.unlock();
+    }
     lock.unlock();
-    return true;
+    return ok;
 }
 QByteArray PureImageCache::GetImageFromCache(MapType::Types type, Point pos, int zoom)
 {
-    lock.lockForRead();
     QByteArray ar;
+
     if (gtilecache.isEmpty() | gtilecache.isNull()) {
         return ar;
     }
+    lock.lockForRead();
+    // answer guaranteed misses from the in-memory index
+    Mpresence.lock();
+    if (!presenceIndexLoaded) {
+        loadPresenceIndex();
+    }
+    bool mayExist = !presenceIndexLoaded || presenceIndex.contains(presenceKey(type, pos, zoom));
+    Mpresence.unlock();
+    if (!mayExist) {
+        lock.unlock();
+        return ar;
+    }
     QString dir  = gtilecache;
     Mcounter.lock();
     qlonglong id = ++ConnCounter;
@@ -278,6 +396,11 @@ void PureImageCache::deleteOlderTiles(int const & days)
                 cn.close();
             }
             QSqlDatabase::removeDatabase(QString::number(id));
+            // tiles went away, rebuild the presence index on next lookup
+            Mpresence.lock();
+            presenceIndex.clear();
+            presenceIndexLoaded = false;
+            Mpresence.unlock();
         }
     }
 }
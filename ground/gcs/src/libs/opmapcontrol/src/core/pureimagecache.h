@@ -42,21 +42,34 @@
 #include <QList>
 #include <QMutex>
 #include <QReadWriteLock>
+#include <QSet>
 namespace core {
 class PureImageCache {
 public:
     PureImageCache();
     static bool CreateEmptyDB(const QString &file);
     bool PutImageToCache(const QByteArray &tile, const MapType::Types &type, const core::Point &pos, const int &zoom);
+    void BeginWriteBatch();
+    void EndWriteBatch();
     QByteArray GetImageFromCache(MapType::Types type, core::Point pos, int zoom);
     QString GtileCache();
     void setGtileCache(const QString &value);
     static bool ExportMapDataToDB(QString sourceFile, QString destFile);
     void deleteOlderTiles(int const & days);
+    void InvalidatePresenceIndex();
 private:
+    QSqlDatabase writerConnection();
+    void loadPresenceIndex();
+    static quint64 presenceKey(const MapType::Types &type, const core::Point &pos, const int &zoom);
+
     QString gtilecache;
     QMutex Mcounter;
     QReadWriteLock lock;
+    // keys of every tile in the database, so misses are answered from RAM
+    // instead of probing SQLite; loaded lazily, maintained on insert
+    QSet<quint64> presenceIndex;
+    bool presenceIndexLoaded;
+    QMutex Mpresence;
     static qlonglong ConnCounter;
 };
 }
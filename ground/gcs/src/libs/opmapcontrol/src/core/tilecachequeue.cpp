@@ -30,6 +30,9 @@
 // #define DEBUG_TILECACHEQUEUE
 
 namespace core {
+// number of queued tiles committed per transaction by the writer thread
+static const int WRITE_BATCH_SIZE = 32;
+
 TileCacheQueue::TileCacheQueue()
 {}
 TileCacheQueue::~TileCacheQueue()
@@ -76,15 +79,23 @@ void TileCacheQueue::run()
         qDebug() << "Cache";
 #endif // DEBUG_TILECACHEQUEUE
         if (tileCacheQueue.count() > 0) {
+            // drain a batch and persist it inside a single transaction
+            QQueue<CacheItemQueue *> batch;
             mutex.lock();
-            task = tileCacheQueue.dequeue();
+            while (!tileCacheQueue.isEmpty() && (batch.count() < WRITE_BATCH_SIZE)) {
+                batch.enqueue(tileCacheQueue.dequeue());
+            }
             mutex.unlock();
+            Cache::Instance()->ImageCache.BeginWriteBatch();
+            while (!batch.isEmpty()) {
+                task = batch.dequeue();
 #ifdef DEBUG_TILECACHEQUEUE
-            qDebug() << "Cache engine Put:" << task->GetPosition().X() << "," << task->GetPosition().Y();
+                qDebug() << "Cache engine Put:" << task->GetPosition().X() << "," << task->GetPosition().Y();
 #endif // DEBUG_TILECACHEQUEUE
-            Cache::Instance()->ImageCache.PutImageToCache(task->GetImg(), task->GetMapType(), task->GetPosition(), task->GetZoom());
-            usleep(44);
-            delete task;
+                Cache::Instance()->ImageCache.PutImageToCache(task->GetImg(), task->GetMapType(), task->GetPosition(), task->GetZoom());
+                delete task;
+            }
+            Cache::Instance()->ImageCache.EndWriteBatch();
         } else {
 #ifdef DEBUG_TILECACHEQUEUE
             qDebug() << "Cache engine BEGIN WAIT";
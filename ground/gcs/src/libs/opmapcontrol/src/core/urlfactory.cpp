@@ -499,16 +499,14 @@ internals::PointLatLng UrlFactory::GetLatLngFromGeodecoder(const QString &keywor
     return GetLatLngFromGeocoderUrl(MakeGeocoderUrl(keywords), UseGeocoderCache, status);
 }
 
-QString latxml;
-QString lonxml;
-// QString status;
-
 internals::PointLatLng UrlFactory::GetLatLngFromGeocoderUrl(const QString &url, const bool &useCache, QString &status)
 {
 #ifdef DEBUG_URLFACTORY
     qDebug() << "Entered GetLatLngFromGeocoderUrl:";
 #endif // DEBUG_URLFACTORY
     status = "ZERO_RESULTS";
+    QString latxml;
+    QString lonxml;
     internals::PointLatLng ret(0, 0);
     QString urlEnd = url.mid(url.indexOf("geo?q=") + 6);
     urlEnd.replace(QRegExp(
@@ -522,8 +520,9 @@ internals::PointLatLng UrlFactory::GetLatLngFromGeocoderUrl(const QString &url,
                        "]"), "_");
 
     QString geo = useCache ? Cache::Instance()->GetGeocoderFromCache(urlEnd) : "";
+    bool fromCache = !(geo.isNull() | geo.isEmpty());
 
-    if (geo.isNull() | geo.isEmpty()) {
+    if (!fromCache) {
 #ifdef DEBUG_URLFACTORY
         qDebug() << "GetLatLngFromGeocoderUrl:Not in cache going internet";
 #endif // DEBUG_URLFACTORY
@@ -555,91 +554,92 @@ internals::PointLatLng UrlFactory::GetLatLngFromGeocoderUrl(const QString &url,
 #endif // DEBUG_URLFACTORY
             return internals::PointLatLng(0, 0);
         }
-        {
-            geo = reply->readAll();
+        geo = reply->readAll();
 #ifdef DEBUG_URLFACTORY
-            qDebug() << "GetLatLngFromGeocoderUrl:Reply ok";
-            qDebug() << geo; // This is the response from the geocode request (no longer in CSV)
+        qDebug() << "GetLatLngFromGeocoderUrl:Reply ok";
+        qDebug() << geo; // This is the response from the geocode request (no longer in CSV)
 #endif // DEBUG_URLFACTORY
+        reply->deleteLater();
+    }
 
-            // This is SOOOO horribly hackish, code duplication needs to go. Needed a quick fix.
-            QXmlStreamReader reader(geo);
-            while (!reader.atEnd()) {
-                reader.readNext();
-
-                if (reader.isStartElement()) {
-                    if (reader.name() == "lat") {
-                        reader.readNext();
-                        if (reader.atEnd()) {
-                            break;
-                        }
+    {
+        // This is SOOOO horribly hackish, code duplication needs to go. Needed a quick fix.
+        QXmlStreamReader reader(geo);
+        while (!reader.atEnd()) {
+            reader.readNext();
+
+            if (reader.isStartElement()) {
+                if (reader.name() == "lat") {
+                    reader.readNext();
+                    if (reader.atEnd()) {
+                        break;
+                    }
 
-                        if (reader.isCharacters()) {
-                            QString text = reader.text().toString();
+                    if (reader.isCharacters()) {
+                        QString text = reader.text().toString();
 #ifdef DEBUG_URLFACTORY
-                            qDebug() << text;
+                        qDebug() << text;
 #endif
-                            latxml = text;
-                            break;
-                        }
+                        latxml = text;
+                        break;
                     }
                 }
             }
+        }
 
-            while (!reader.atEnd()) {
-                reader.readNext();
+        while (!reader.atEnd()) {
+            reader.readNext();
 
-                if (reader.isStartElement()) {
-                    if (reader.name() == "lng") {
-                        reader.readNext();
-                        if (reader.atEnd()) {
-                            break;
-                        }
+            if (reader.isStartElement()) {
+                if (reader.name() == "lng") {
+                    reader.readNext();
+                    if (reader.atEnd()) {
+                        break;
+                    }
 
-                        if (reader.isCharacters()) {
-                            QString text = reader.text().toString();
+                    if (reader.isCharacters()) {
+                        QString text = reader.text().toString();
 #ifdef DEBUG_URLFACTORY
-                            qDebug() << text;
+                        qDebug() << text;
 #endif
-                            lonxml = text;
-                            break;
-                        }
+                        lonxml = text;
+                        break;
                     }
                 }
             }
+        }
 
-            QXmlStreamReader reader2(geo);
-            while (!reader2.atEnd()) {
-                reader2.readNext();
+        QXmlStreamReader reader2(geo);
+        while (!reader2.atEnd()) {
+            reader2.readNext();
 
-                if (reader2.isStartElement()) {
-                    if (reader2.name() == "status") {
-                        reader2.readNext();
-                        if (reader2.atEnd()) {
-                            break;
-                        }
+            if (reader2.isStartElement()) {
+                if (reader2.name() == "status") {
+                    reader2.readNext();
+                    if (reader2.atEnd()) {
+                        break;
+                    }
 
-                        if (reader2.isCharacters()) {
-                            QString text = reader2.text().toString();
+                    if (reader2.isCharacters()) {
+                        QString text = reader2.text().toString();
 #ifdef DEBUG_URLFACTORY
-                            qDebug() << text;
+                        qDebug() << text;
 #endif
-                            status = text;
-                            break;
-                        }
+                        status = text;
+                        break;
                     }
                 }
             }
+        }
 
-            // cache geocoding
-            if (useCache && geo.startsWith("200")) {
-                Cache::Instance()->CacheGeocoder(urlEnd, geo);
-            }
+        // cache definitive answers only, including the negative ones, so a
+        // known "no such place" never goes back to the network; transient
+        // failures (quota, server errors) are retried on the next lookup
+        if (useCache && !fromCache && (status == "OK" || status == "ZERO_RESULTS")) {
+            Cache::Instance()->CacheGeocoder(urlEnd, geo);
         }
-        reply->deleteLater();
     }
 
-
     {
         if (status == "OK") {
             double lat = QString(latxml).toDouble();
@@ -734,8 +734,12 @@ Placemark UrlFactory::GetPlacemarkFromReverseGeocoderUrl(const QString &url, con
 #ifdef DEBUG_URLFACTORY
             qDebug() << reverse;
 #endif // DEBUG_URLFACTORY
-            // cache geocoding
-            if (useCache && reverse.startsWith("200")) {
+            // cache definitive replies only, negative ones included, so a
+            // location known to have no placemark stays offline-resolvable;
+            // quota and server errors are not cached and will be retried
+            if (useCache && (reverse.startsWith("200")
+                             || reverse.contains("<status>OK</status>")
+                             || reverse.contains("<status>ZERO_RESULTS</status>"))) {
                 Cache::Instance()->CachePlacemark(urlEnd, reverse);
             }
         }
@@ -25,6 +25,7 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include "core.h"
+#include "../core/pureimage.h"
 
 #ifdef DEBUG_CORE
 qlonglong internals::Core::debugcounter = 0;
@@ -67,10 +68,39 @@ void Core::run()
 
     LoadTask task;
 
+    // same lock order as UpdateBounds(): drawing list first, then the queue
+    MtileDrawingList.lock();
     MtileLoadQueue.lock();
     {
+        // drop tasks for tiles that scrolled out of view or belong to
+        // another zoom level, fetching them would be wasted work
+        for (int i = tileLoadQueue.count() - 1; i >= 0; --i) {
+            LoadTask queued = tileLoadQueue.at(i);
+            if (queued.Zoom != Zoom() || !tileDrawingList.contains(queued.Pos)) {
+                tileLoadQueue.removeAt(i);
+                MtileToload.lock();
+                --tilesToload;
+                MtileToload.unlock();
+#ifdef DEBUG_CORE
+                qDebug() << "TileLoadQueue: dropped off-screen task " << queued.ToString() << " ID=" << debug;
+#endif // DEBUG_CORE
+            }
+        }
+        // serve the tile closest to the viewport centre first, so the
+        // visible map completes before the prefetch ring
         if (tileLoadQueue.count() > 0) {
-            task = tileLoadQueue.dequeue();
+            int best = 0;
+            qint64 bestDist = -1;
+            for (int i = 0; i < tileLoadQueue.count(); ++i) {
+                qint64 dx   = tileLoadQueue.at(i).Pos.X() - centerTileXYLocation.X();
+                qint64 dy   = tileLoadQueue.at(i).Pos.Y() - centerTileXYLocation.Y();
+                qint64 dist = dx * dx + dy * dy;
+                if (bestDist < 0 || dist < bestDist) {
+                    bestDist = dist;
+                    best     = i;
+                }
+            }
+            task = tileLoadQueue.takeAt(best);
             {
                 last = (tileLoadQueue.count() == 0);
 #ifdef DEBUG_CORE
@@ -80,6 +110,7 @@ void Core::run()
         }
     }
     MtileLoadQueue.unlock();
+    MtileDrawingList.unlock();
 
     if (task.HasValue()) {
         if (loaderLimit.tryAcquire(1, OPMaps::Instance()->Timeout)) {
@@ -102,7 +133,7 @@ void Core::run()
                         qDebug() << "Fill empty TileMatrix: " + task.ToString() << " ID=" << debug;;
 #endif // DEBUG_CORE
 
-                        Tile *t = new Tile(task.Zoom, task.Pos);
+                        Tile *t = Matrix.AcquireTile(task.Zoom, task.Pos);
                         QVector<MapType::Types> layers = OPMaps::Instance()->GetAllLayersOfType(GetMapType());
 
                         foreach(MapType::Types tl, layers) {
@@ -120,9 +151,13 @@ void Core::run()
 #endif // DEBUG_CORE
 
                                 if (img.length() != 0) {
+                                    // decode and convert on this loader thread,
+                                    // the paint path then only blits
+                                    QImage decoded = PureImageProxy::DecodeToRenderFormat(img);
                                     Moverlays.lock();
                                     {
                                         t->Overlays.append(img);
+                                        t->OverlaysDecoded.append(decoded);
 #ifdef DEBUG_CORE
                                         qDebug() << "Core::run append img:" << img.length() << " to tile:" << t->GetPos().ToString() << " now has " << t->Overlays.count() << " overlays" << " ID=" << debug;
 #endif // DEBUG_CORE
@@ -155,7 +190,7 @@ void Core::run()
                         } else {
                             // emit OnTilesStillToLoad(tilesToload);
 
-                            delete t;
+                            Matrix.ReleaseTile(t);
                             t = 0;
                             emit OnNeedInvalidation();
                         }
@@ -168,9 +203,7 @@ void Core::run()
                 {
                     // last buddy cleans stuff ;}
                     if (last) {
-                        OPMaps::Instance()->kiberCacheLock.lockForWrite();
-                        OPMaps::Instance()->TilesInMemory.RemoveMemoryOverload();
-                        OPMaps::Instance()->kiberCacheLock.unlock();
+                        OPMaps::Instance()->RemoveMemoryOverload();
 
                         MtileDrawingList.lock();
                         {
@@ -585,6 +618,36 @@ void Core::FindTilesAround(QList<Point> &list)
             }
         }
     }
+
+    // predictive prefetch: when the centre keeps crossing tiles in one
+    // direction (manual pan or follow-the-UAV tracking), also request the
+    // viewport one step ahead along that direction, so the leading edge is
+    // already cached by the time it scrolls into view
+    int dx = centerTileXYLocation.X() - prefetchLastCenter.X();
+    int dy = centerTileXYLocation.Y() - prefetchLastCenter.Y();
+    bool panning = prefetchTimer.isValid() && (prefetchTimer.elapsed() < 2000)
+                   && (dx != 0 || dy != 0)
+                   && (qAbs(dx) <= sizeOfMapArea.Width()) && (qAbs(dy) <= sizeOfMapArea.Height());
+
+    if (panning) {
+        int offsetX = (dx == 0) ? 0 : ((dx > 0 ? 1 : -1) * (sizeOfMapArea.Width() * 2 + 1));
+        int offsetY = (dy == 0) ? 0 : ((dy > 0 ? 1 : -1) * (sizeOfMapArea.Height() * 2 + 1));
+        for (int i = -sizeOfMapArea.Width(); i <= sizeOfMapArea.Width(); i++) {
+            for (int j = -sizeOfMapArea.Height(); j <= sizeOfMapArea.Height(); j++) {
+                Point p = centerTileXYLocation;
+                p.SetX(p.X() + i + offsetX);
+                p.SetY(p.Y() + j + offsetY);
+
+                if (p.X() >= minOfTiles.Width() && p.Y() >= minOfTiles.Height() && p.X() <= maxOfTiles.Width() && p.Y() <= maxOfTiles.Height()) {
+                    if (!list.contains(p)) {
+                        list.append(p);
+                    }
+                }
+            }
+        }
+    }
+    prefetchLastCenter = centerTileXYLocation;
+    prefetchTimer.restart();
 }
 void Core::UpdateGroundResolution()
 {
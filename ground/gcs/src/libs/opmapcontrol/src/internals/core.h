@@ -52,6 +52,7 @@
 #include <QSemaphore>
 #include <QThread>
 #include <QDateTime>
+#include <QElapsedTimer>
 
 #include <QObject>
 
@@ -256,6 +257,15 @@ public:
     }
     void SetMapType(MapType::Types const & value);
 
+    int TileFetchConcurrency()
+    {
+        return ProcessLoadTaskCallback.maxThreadCount();
+    }
+    void SetTileFetchConcurrency(int const & value)
+    {
+        ProcessLoadTaskCallback.setMaxThreadCount(qBound(1, value, 32));
+    }
+
     void StartSystem();
 
     void UpdateCenterTileXYLocation();
@@ -322,6 +332,9 @@ private:
     core::Point renderOffset;
     core::Point centerTileXYLocation;
     core::Point centerTileXYLocationLast;
+    // pan direction tracking for the predictive tile prefetcher
+    core::Point prefetchLastCenter;
+    QElapsedTimer prefetchTimer;
     core::Point dragPoint;
     Rectangle tileRect;
     core::Point mouseDown;
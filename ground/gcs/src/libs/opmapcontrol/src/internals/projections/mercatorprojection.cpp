@@ -51,6 +51,28 @@ Point MercatorProjection::FromLatLngToPixel(double lat, double lng, const int &z
 
     return ret;
 }
+// batch variant of FromLatLngToPixel with the matrix size hoisted out of
+// the loop and no per-point virtual dispatch, the loop body is branch-free
+// so the compiler can vectorize it
+void MercatorProjection::FromLatLngToPixelBatch(const double *lat, const double *lng, qint32 *x, qint32 *y, int const & count, int const & zoom)
+{
+    Size s = GetTileMatrixSizePixel(zoom);
+    double mapSizeX = s.Width();
+    double mapSizeY = s.Height();
+
+    for (int i = 0; i < count; i++) {
+        double la = Clip(lat[i], MinLatitude, MaxLatitude);
+        double lo = Clip(lng[i], MinLongitude, MaxLongitude);
+
+        double px = (lo + 180) / 360;
+        double sinLatitude = sin(la * M_PI / 180);
+        double py = 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+
+        x[i] = (qint32)Clip(px * mapSizeX + 0.5, 0, mapSizeX - 1);
+        y[i] = (qint32)Clip(py * mapSizeY + 0.5, 0, mapSizeY - 1);
+    }
+}
+
 internals::PointLatLng MercatorProjection::FromPixelToLatLng(const int &x, const int &y, const int &zoom)
 {
     internals::PointLatLng ret; // = internals::PointLatLng.Empty;
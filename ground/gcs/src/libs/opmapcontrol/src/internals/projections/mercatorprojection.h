@@ -41,6 +41,7 @@ public:
     virtual double Axis() const;
     virtual double Flattening() const;
     virtual core::Point FromLatLngToPixel(double lat, double lng, int const & zoom);
+    virtual void FromLatLngToPixelBatch(const double *lat, const double *lng, qint32 *x, qint32 *y, int const & count, int const & zoom);
     virtual internals::PointLatLng FromPixelToLatLng(const int &x, const int &y, const int &zoom);
     virtual Size GetTileMatrixMinXY(const int &zoom);
     virtual Size GetTileMatrixMaxXY(const int &zoom);
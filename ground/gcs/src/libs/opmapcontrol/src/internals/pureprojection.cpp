@@ -44,6 +44,43 @@ Point PureProjection::FromLatLngToPixel(const PointLatLng &p, const int &zoom)
 }
 
 
+/**
+ * Project a batch of positions given as parallel lat/lng arrays.
+ *
+ * Generic fallback looping over the scalar conversion; projections whose
+ * per-point math is branch-free (see MercatorProjection) override this so
+ * the compiler can vectorize the loop and a 50k point trail does not pay
+ * a virtual call per point.
+ */
+void PureProjection::FromLatLngToPixelBatch(const double *lat, const double *lng, qint32 *x, qint32 *y, int const & count, int const & zoom)
+{
+    for (int i = 0; i < count; i++) {
+        Point p = FromLatLngToPixel(lat[i], lng[i], zoom);
+        x[i] = p.X();
+        y[i] = p.Y();
+    }
+}
+
+QVector<Point> PureProjection::FromLatLngToPixel(const QVector<PointLatLng> &points, const int &zoom)
+{
+    int count = points.count();
+    QVector<double> lat(count);
+    QVector<double> lng(count);
+    QVector<qint32> x(count);
+    QVector<qint32> y(count);
+
+    for (int i = 0; i < count; i++) {
+        lat[i] = points[i].Lat();
+        lng[i] = points[i].Lng();
+    }
+    FromLatLngToPixelBatch(lat.constData(), lng.constData(), x.data(), y.data(), count, zoom);
+    QVector<Point> ret(count);
+    for (int i = 0; i < count; i++) {
+        ret[i] = Point(x[i], y[i]);
+    }
+    return ret;
+}
+
 PointLatLng PureProjection::FromPixelToLatLng(const Point &p, const int &zoom)
 {
     return FromPixelToLatLng(p.X(), p.Y(), zoom);
@@ -34,6 +34,7 @@
 #include "cmath"
 #include "rectlatlng.h"
 #include <QDebug>
+#include <QVector>
 using namespace core;
 
 namespace internals {
@@ -54,6 +55,10 @@ public:
         return "PureProjection";
     }
     core::Point FromLatLngToPixel(const PointLatLng &p, const int &zoom);
+    // batch conversion over parallel lat/lng arrays, projections with
+    // branch-free per-point math override this with a vectorizable loop
+    virtual void FromLatLngToPixelBatch(const double *lat, const double *lng, qint32 *x, qint32 *y, int const & count, int const & zoom);
+    QVector<core::Point> FromLatLngToPixel(const QVector<PointLatLng> &points, const int &zoom);
 
     PointLatLng FromPixelToLatLng(const Point &p, const int &zoom);
     virtual core::Point FromPixelToTileXY(const core::Point &p);
@@ -40,6 +40,7 @@ void Tile::Clear()
 #endif // DEBUG_TILE
     mutex.lock();
     Overlays.clear();
+    OverlaysDecoded.clear();
     mutex.unlock();
 }
 Tile::Tile() : zoom(0), pos(0, 0)
@@ -67,6 +67,9 @@ public:
         return !(zoom == 0);
     }
     QList<QByteArray> Overlays;
+    // images decoded from Overlays on the loader threads, same order;
+    // already in the render-optimal premultiplied format
+    QList<QImage> OverlaysDecoded;
 protected:
 
     QMutex mutex;
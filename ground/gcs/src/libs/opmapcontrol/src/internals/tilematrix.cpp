@@ -30,12 +30,21 @@
 namespace internals {
 TileMatrix::TileMatrix()
 {}
+TileMatrix::~TileMatrix()
+{
+    Clear();
+    poolMutex.lock();
+    foreach(Tile * t, pool) {
+        delete t;
+    }
+    pool.clear();
+    poolMutex.unlock();
+}
 void TileMatrix::Clear()
 {
     mutex.lock();
     foreach(Tile * t, matrix.values()) {
-        delete t;
-        t = 0;
+        ReleaseTile(t);
     }
     matrix.clear();
     mutex.unlock();
@@ -110,8 +119,7 @@ void TileMatrix::ClearPointsNotIn(QList<Point>list)
 
         if (t != 0) {
             mutex.lock();
-            delete t;
-            t = 0;
+            ReleaseTile(t);
             matrix.remove(p);
             mutex.unlock();
         }
@@ -134,9 +142,49 @@ void TileMatrix::SetTileAt(const Point &p, Tile *tile)
     mutex.lock();
     Tile *t = matrix.value(p, 0);
     if (t != 0) {
-        delete t;
+        ReleaseTile(t);
     }
     matrix.insert(p, tile);
     mutex.unlock();
 }
+
+/**
+ * Hands out a tile for the given position, recycling a retired one when
+ * available so interactive zooming allocates nothing in steady state.
+ */
+Tile *TileMatrix::AcquireTile(int zoom, const Point &pos)
+{
+    Tile *t = 0;
+
+    poolMutex.lock();
+    if (!pool.isEmpty()) {
+        t = pool.takeLast();
+    }
+    poolMutex.unlock();
+    if (t != 0) {
+        t->SetZoom(zoom);
+        t->SetPos(pos);
+        return t;
+    }
+    return new Tile(zoom, pos);
+}
+
+/**
+ * Retires a tile into the pool, dropping its image data first. Tiles above
+ * the pool cap are freed for real.
+ */
+void TileMatrix::ReleaseTile(Tile *tile)
+{
+    if (tile == 0) {
+        return;
+    }
+    tile->Clear();
+    poolMutex.lock();
+    if (pool.count() < MaxPoolSize) {
+        pool.append(tile);
+        tile = 0;
+    }
+    poolMutex.unlock();
+    delete tile;
+}
 }
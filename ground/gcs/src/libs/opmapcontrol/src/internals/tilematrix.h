@@ -37,19 +37,27 @@ namespace internals {
 class TileMatrix {
 public:
     TileMatrix();
+    ~TileMatrix();
     void Clear();
     void ClearPointsNotIn(QList<core::Point> list);
     Tile *TileAt(const core::Point &p);
     void SetTileAt(const core::Point &p, Tile *tile);
+    Tile *AcquireTile(int zoom, const core::Point &pos);
+    void ReleaseTile(Tile *tile);
     int count() const
     {
         return matrix.count();
     }
     // void RebuildToUpperZoom();
 protected:
+    // retired tiles kept for reuse, so zoom and region changes do not
+    // hammer the heap with Tile allocations
+    enum { MaxPoolSize = 64 };
     QHash<core::Point, Tile *> matrix;
     QList<core::Point> removals;
+    QList<Tile *> pool;
     QMutex mutex;
+    QMutex poolMutex;
 };
 }
 #endif // TILEMATRIX_H
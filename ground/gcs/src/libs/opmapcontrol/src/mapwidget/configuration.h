@@ -138,7 +138,7 @@ public:
      */
     double TileMemoryUsed() const
     {
-        return core::OPMaps::Instance()->TilesInMemory.MemoryCacheSize();
+        return core::OPMaps::Instance()->MemoryCacheSize();
     }
 
     /**
@@ -149,7 +149,7 @@ public:
      */
     void SetTileMemorySize(int const & value)
     {
-        core::OPMaps::Instance()->TilesInMemory.setMemoryCacheCapacity(value);
+        core::OPMaps::Instance()->setMemoryCacheCapacity(value);
     }
 
     /**
@@ -38,8 +38,7 @@
 #include "uavtrailtype.h"
 #include <QtSvg/QSvgRenderer>
 #include "opmapwidget.h"
-#include "trailitem.h"
-#include "traillineitem.h"
+#include "trailpolylineitem.h"
 namespace mapcontrol {
 class WayPointItem;
 class OPMapWidget;
@@ -242,8 +241,7 @@ private:
     QPixmap pic;
     core::Point localposition;
     OPMapWidget *mapwidget;
-    QGraphicsItemGroup *trail;
-    QGraphicsItemGroup *trailLine;
+    TrailPolylineItem *trail;
     internals::PointLatLng lasttrailline;
     QTime timer;
     bool showtrail;
@@ -29,8 +29,13 @@
 #include "homeitem.h"
 #include "mapgraphicitem.h"
 #include <QGraphicsSceneMouseEvent>
+#include <QPixmapCache>
 
 namespace mapcontrol {
+// budget for decoded tile pixmaps, enough for a couple of 4K screens of
+// 256x256 tiles so panning redraws never have to re-decode
+static const int TILE_PIXMAP_CACHE_KB = 64 * 1024;
+
 MapGraphicItem::MapGraphicItem(internals::Core *core, Configuration *configuration) : core(core), config(configuration), MapRenderTransform(1),
     maxZoom(17), minZoom(2), zoomReal(0), zoomDigi(0), isSelected(false), rotation(0)
 {
@@ -46,6 +51,9 @@ MapGraphicItem::MapGraphicItem(internals::Core *core, Configuration *configurati
     connect(core, SIGNAL(OnMapDrag()), this, SLOT(childPosRefresh()));
     connect(core, SIGNAL(OnMapZoomChanged()), this, SLOT(childPosRefresh()));
     setCacheMode(QGraphicsItem::ItemCoordinateCache);
+    if (QPixmapCache::cacheLimit() < TILE_PIXMAP_CACHE_KB) {
+        QPixmapCache::setCacheLimit(TILE_PIXMAP_CACHE_KB);
+    }
 }
 
 void MapGraphicItem::start()
@@ -317,13 +325,15 @@ void MapGraphicItem::DrawMap2D(QPainter *painter)
                         // render tile
                         // lock(t.Overlays)
                         if (t != 0) {
-                            foreach(QByteArray img, t->Overlays) {
+                            for (int k = 0; k < t->Overlays.count(); ++k) {
+                                QByteArray img = t->Overlays.at(k);
                                 if (img.count() != 0) {
                                     if (!found) {
                                         found = true;
                                     }
                                     {
-                                        painter->drawPixmap(core->tileRect.X(), core->tileRect.Y(), core->tileRect.Width(), core->tileRect.Height(), PureImageProxy::FromStream(img));
+                                        QImage decoded = (k < t->OverlaysDecoded.count()) ? t->OverlaysDecoded.at(k) : QImage();
+                                        painter->drawPixmap(core->tileRect.X(), core->tileRect.Y(), core->tileRect.Width(), core->tileRect.Height(), tilePixmap(img, decoded));
                                     }
                                 }
                             }
@@ -370,6 +380,35 @@ void MapGraphicItem::DrawMap2D(QPainter *painter)
 }
 
 
+/**
+ * Decoded pixmap for a raw tile image, served from QPixmapCache.
+ *
+ * Decoding the tile PNG/JPEG on every repaint is what used to burn a
+ * core while panning; with the cache each tile is decoded once and,
+ * when the view runs on an OpenGL viewport, stays resident on the GPU
+ * as a texture instead of being re-uploaded every frame.
+ *
+ * When the tile loader already decoded the image on its worker thread
+ * (the premultiplied copy it keeps next to the raw bytes), filling the
+ * cache is a plain blit; the raw bytes are only decoded here as a
+ * fallback for tiles that predate the loader change.
+ */
+QPixmap MapGraphicItem::tilePixmap(QByteArray const & img, QImage const & decoded)
+{
+    QString key = QString("opmaptile-%1-%2").arg(qHash(img)).arg(img.count());
+    QPixmap pix;
+
+    if (!QPixmapCache::find(key, &pix)) {
+        if (!decoded.isNull()) {
+            pix = QPixmap::fromImage(decoded);
+        } else {
+            pix = PureImageProxy::FromStream(img);
+        }
+        QPixmapCache::insert(key, pix);
+    }
+    return pix;
+}
+
 core::Point MapGraphicItem::FromLatLngToLocal(internals::PointLatLng const & point)
 {
     core::Point ret = core->FromLatLngToLocal(point);
@@ -144,6 +144,7 @@ private:
     bool showTileGridLines;
     qreal MapRenderTransform;
     void DrawMap2D(QPainter *painter);
+    static QPixmap tilePixmap(QByteArray const & img, QImage const & decoded = QImage());
     /**
      * @brief Maximum possible zoom
      *
@@ -25,8 +25,36 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include "mapripper.h"
+
+#include <QFuture>
+#include <QSettings>
+#include <QtAlgorithms>
+#include <QtConcurrentRun>
+
 namespace mapcontrol {
-MapRipper::MapRipper(internals::Core *core, const internals::RectLatLng & rect) : sleep(100), cancel(false), progressForm(0), core(core), yesToAll(false)
+// number of tiles fetched in parallel, kept small out of politeness to
+// the tile providers
+static const int FETCH_BATCH_SIZE = 8;
+// fetch attempts per tile before it is reported as failed
+static const int FETCH_RETRIES    = 3;
+
+namespace {
+// orders tiles by distance from the centre of the ripped area so the
+// tiles the user is most likely looking at arrive first
+struct CenterDistanceLessThan {
+    core::Point center;
+    CenterDistanceLessThan(core::Point const & c) : center(c) {}
+    bool operator()(core::Point const & a, core::Point const & b) const
+    {
+        qint64 da = (qint64)(a.X() - center.X()) * (a.X() - center.X()) + (qint64)(a.Y() - center.Y()) * (a.Y() - center.Y());
+        qint64 db = (qint64)(b.X() - center.X()) * (b.X() - center.X()) + (qint64)(b.Y() - center.Y()) * (b.Y() - center.Y());
+
+        return da < db;
+    }
+};
+}
+
+MapRipper::MapRipper(internals::Core *core, const internals::RectLatLng & rect) : sleep(100), cancel(false), progressForm(0), core(core), yesToAll(false), startIndex(0)
 {
     if (!rect.IsEmpty()) {
         type    = core->GetMapType();
@@ -35,7 +63,31 @@ MapRipper::MapRipper(internals::Core *core, const internals::RectLatLng & rect)
         area    = rect;
         zoom    = core->Zoom();
         maxzoom = core->MaxZoom();
+
+        // a previous rip of the same area/type that did not finish leaves
+        // a journal behind, offer to pick up where it stopped
+        QSettings settings;
+        settings.beginGroup("MapRipper");
+        if (settings.value("key").toString() == journalKey()) {
+            int savedZoom  = settings.value("zoom").toInt();
+            int savedIndex = settings.value("nextIndex").toInt();
+            if (savedZoom >= zoom && savedZoom <= maxzoom &&
+                QMessageBox::question(new QWidget(), tr("Resume ripping?"),
+                                      tr("An earlier rip of this area stopped at zoom level %1.\nResume from where it left off?").arg(savedZoom),
+                                      QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+                zoom       = savedZoom;
+                startIndex = savedIndex;
+            } else {
+                settings.remove("");
+            }
+        }
+        settings.endGroup();
+
         points  = core->Projection()->GetAreaTileList(area, zoom, 0);
+        sortPointsFromCenter();
+        if (startIndex > points.count()) {
+            startIndex = 0;
+        }
         this->start();
         cancel  = false;
         progressForm->show();
@@ -68,12 +120,16 @@ void MapRipper::finish()
         }
         if (ret == QMessageBox::Yes) {
             points.clear();
-            points = core->Projection()->GetAreaTileList(area, zoom, 0);
+            points     = core->Projection()->GetAreaTileList(area, zoom, 0);
+            sortPointsFromCenter();
+            startIndex = 0;
             this->start();
         } else if (ret == QMessageBox::YesAll) {
-            yesToAll = true;
+            yesToAll   = true;
             points.clear();
-            points   = core->Projection()->GetAreaTileList(area, zoom, 0);
+            points     = core->Projection()->GetAreaTileList(area, zoom, 0);
+            sortPointsFromCenter();
+            startIndex = 0;
             this->start();
         } else {
             progressForm->close();
@@ -91,45 +147,113 @@ void MapRipper::finish()
 
 void MapRipper::run()
 {
-    int countOk   = 0;
-    bool goodtile = false;
+    int countOk = 0;
 
-    // Stuff.Shuffle<Point>(ref list);
-    QVector<core::MapType::Types> types = OPMaps::Instance()->GetAllLayersOfType(type);
+    fetchTypes = OPMaps::Instance()->GetAllLayersOfType(type);
     int all = points.count();
-    for (int i = 0; i < all; i++) {
-        emit numberOfTilesChanged(all, i + 1);
+
+    emit providerChanged(core::MapType::StrByType(type), zoom);
+    for (int i = startIndex; i < all; i += FETCH_BATCH_SIZE) {
         if (cancel) {
             break;
         }
-
-        core::Point p = points[i];
-        {
-            // qDebug()<<"offline fetching:"<<p.ToString();
-            foreach(core::MapType::Types type, types) {
-                emit providerChanged(core::MapType::StrByType(type), zoom);
-                QByteArray img = OPMaps::Instance()->GetImageFrom(type, p, zoom);
-
-                if (img.length() != 0) {
-                    goodtile = true;
-                    img = NULL;
-                } else {
-                    goodtile = false;
-                }
-            }
-            if (goodtile) {
+        int batchEnd = qMin(i + FETCH_BATCH_SIZE, all);
+        // fetch a window of tiles in parallel, OPMaps dedupes in-flight
+        // requests and keeps one connection per worker thread
+        QList<QFuture<bool> > futures;
+        for (int j = i; j < batchEnd; j++) {
+            futures.append(QtConcurrent::run(this, &MapRipper::fetchTile, points[j]));
+        }
+        for (int j = 0; j < futures.count(); j++) {
+            if (futures[j].result()) {
                 countOk++;
-            } else {
-                i--;
-                QThread::msleep(1000);
-                continue;
             }
         }
-        emit percentageChanged((int)((i + 1) * 100 / all)); // , i+1);
-        // worker.ReportProgress((int) ((i+1)*100/all), i+1);
+        emit numberOfTilesChanged(all, batchEnd);
+        emit percentageChanged((int)(batchEnd * 100 / all));
+        saveJournal(batchEnd);
 
         QThread::msleep(sleep);
     }
+    startIndex = 0;
+    if (!cancel) {
+        if (zoom < maxzoom) {
+            // point the journal at the next zoom level so a rip aborted at
+            // the "continue?" prompt can still be resumed later
+            zoom++;
+            saveJournal(0);
+            zoom--;
+        } else {
+            clearJournal();
+        }
+    }
+}
+
+/**
+ * Fetch every layer of one tile, retrying a few times on bad tiles.
+ *
+ * Runs on QtConcurrent pool threads, several tiles at a time.
+ */
+bool MapRipper::fetchTile(core::Point p)
+{
+    foreach(core::MapType::Types layerType, fetchTypes) {
+        bool goodtile = false;
+
+        for (int attempt = 0; attempt < FETCH_RETRIES && !cancel; attempt++) {
+            QByteArray img = OPMaps::Instance()->GetImageFrom(layerType, p, zoom);
+            if (img.length() != 0) {
+                goodtile = true;
+                break;
+            }
+            QThread::msleep(1000);
+        }
+        if (!goodtile) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MapRipper::sortPointsFromCenter()
+{
+    if (points.isEmpty()) {
+        return;
+    }
+    qint64 sumX = 0;
+    qint64 sumY = 0;
+    foreach(core::Point const & p, points) {
+        sumX += p.X();
+        sumY += p.Y();
+    }
+    core::Point center((int)(sumX / points.count()), (int)(sumY / points.count()));
+    qStableSort(points.begin(), points.end(), CenterDistanceLessThan(center));
+}
+
+QString MapRipper::journalKey() const
+{
+    return QString("%1:%2:%3:%4:%5").arg((int)type)
+           .arg(area.Lat(), 0, 'f', 8).arg(area.Lng(), 0, 'f', 8)
+           .arg(area.WidthLng(), 0, 'f', 8).arg(area.HeightLat(), 0, 'f', 8);
+}
+
+void MapRipper::saveJournal(int const & nextIndex)
+{
+    QSettings settings;
+
+    settings.beginGroup("MapRipper");
+    settings.setValue("key", journalKey());
+    settings.setValue("zoom", zoom);
+    settings.setValue("nextIndex", nextIndex);
+    settings.endGroup();
+}
+
+void MapRipper::clearJournal()
+{
+    QSettings settings;
+
+    settings.beginGroup("MapRipper");
+    settings.remove("");
+    settings.endGroup();
 }
 
 void MapRipper::stopFetching()
@@ -39,6 +39,12 @@ public:
     MapRipper(internals::Core *, internals::RectLatLng const &);
     void run();
 private:
+    bool fetchTile(core::Point p);
+    void sortPointsFromCenter();
+    QString journalKey() const;
+    void saveJournal(int const & nextIndex);
+    void clearJournal();
+
     QList<core::Point> points;
     int zoom;
     core::MapType::Types type;
@@ -49,6 +55,8 @@ private:
     int maxzoom;
     internals::Core *core;
     bool yesToAll;
+    int startIndex;
+    QVector<core::MapType::Types> fetchTypes;
     QMutex mutex;
 
 signals:
@@ -10,11 +10,10 @@ SOURCES += mapgraphicitem.cpp \
     waypointitem.cpp \
     uavitem.cpp \
     gpsitem.cpp \
-    trailitem.cpp \
+    trailpolylineitem.cpp \
     homeitem.cpp \
     mapripform.cpp \
     mapripper.cpp \
-    traillineitem.cpp \
     waypointline.cpp \
     waypointcircle.cpp
 
@@ -37,17 +36,17 @@ HEADERS += mapgraphicitem.h \
     gpsitem.h \
     uavmapfollowtype.h \
     uavtrailtype.h \
-    trailitem.h \
+    trailpolylineitem.h \
     homeitem.h \
     mapripform.h \
     mapripper.h \
-    traillineitem.h \
     waypointline.h \
     waypointcircle.h
 QT += opengl
 QT += network
 QT += sql
 QT += svg
+QT += concurrent
 RESOURCES += mapresources.qrc
 
 FORMS += \
@@ -213,8 +213,12 @@ void OPMapWidget::SetUseOpenGL(const bool &value)
     useOpenGL = value;
     if (useOpenGL) {
         setViewport(new QOpenGLWidget()); // QGLFormat(QGL::SampleBuffers)));
+        // partial updates are not supported on a QOpenGLWidget viewport,
+        // the whole scene has to be composited each frame
+        setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
     } else {
         setupViewport(new QWidget());
+        setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
     }
     update();
 }
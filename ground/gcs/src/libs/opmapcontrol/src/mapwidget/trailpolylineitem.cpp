@@ -0,0 +1,181 @@
+/**
+ ******************************************************************************
+ *
+ * @file       trailpolylineitem.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @brief      A single graphicsItem rendering a whole UAV/GPS trail
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "trailpolylineitem.h"
+
+namespace mapcontrol {
+// ring buffer capacity, a multi-hour flight at one fix per second
+static const int MAX_TRAIL_POINTS     = 36000;
+// minimum on-screen distance between two drawn trail points
+static const int LOD_PIXEL_SPACING    = 3;
+static const int LOD_PIXEL_SPACING_SQ = LOD_PIXEL_SPACING * LOD_PIXEL_SPACING;
+
+TrailPolylineItem::TrailPolylineItem(QBrush dotColor, QBrush lineColor, MapGraphicItem *map) : QGraphicsItem(map),
+    head(0), lodZoom(-1), lodDirty(false), dotBrush(dotColor), lineBrush(lineColor), m_map(map), showDots(true), showLine(true)
+{
+    coords.reserve(MAX_TRAIL_POINTS);
+}
+
+void TrailPolylineItem::AddPoint(internals::PointLatLng const & coord)
+{
+    if (coords.count() < MAX_TRAIL_POINTS) {
+        coords.append(coord);
+    } else {
+        // full, overwrite the oldest fix
+        coords[head] = coord;
+        head = (head + 1) % MAX_TRAIL_POINTS;
+    }
+    lodDirty = true;
+    updateShape();
+}
+
+void TrailPolylineItem::Clear()
+{
+    coords.clear();
+    head     = 0;
+    lodDirty = true;
+    updateShape();
+}
+
+int TrailPolylineItem::PointCount() const
+{
+    return coords.count();
+}
+
+void TrailPolylineItem::SetShowDots(bool const & value)
+{
+    showDots = value;
+    this->setVisible(showDots || showLine);
+    update();
+}
+
+void TrailPolylineItem::SetShowLine(bool const & value)
+{
+    showLine = value;
+    this->setVisible(showDots || showLine);
+    update();
+}
+
+/**
+ * Decimate the trail for the current zoom level.
+ *
+ * Projects every fix in one batch call and keeps only those at least
+ * LOD_PIXEL_SPACING pixels along the path from the previously kept one,
+ * so the number of points painted is bounded by what is visually
+ * distinguishable rather than by flight time.
+ */
+void TrailPolylineItem::rebuildLod()
+{
+    lodZoom  = m_map->ZoomStep();
+    lodDirty = false;
+    lodCoords.clear();
+    int count = coords.count();
+    if (count == 0) {
+        return;
+    }
+
+    QVector<double> lat(count);
+    QVector<double> lng(count);
+    QVector<qint32> x(count);
+    QVector<qint32> y(count);
+    for (int i = 0; i < count; i++) {
+        internals::PointLatLng const & p = coords[(head + i) % count];
+        lat[i] = p.Lat();
+        lng[i] = p.Lng();
+    }
+    m_map->Projection()->FromLatLngToPixelBatch(lat.constData(), lng.constData(), x.data(), y.data(), count, lodZoom);
+
+    qint32 lastX = x[0];
+    qint32 lastY = y[0];
+    lodCoords.append(coords[head % count]);
+    for (int i = 1; i < count; i++) {
+        qint32 dx = x[i] - lastX;
+        qint32 dy = y[i] - lastY;
+        if ((dx * dx + dy * dy) >= LOD_PIXEL_SPACING_SQ || i == (count - 1)) {
+            lodCoords.append(coords[(head + i) % count]);
+            lastX = x[i];
+            lastY = y[i];
+        }
+    }
+}
+
+/**
+ * Reproject the decimated trail into map local coordinates.
+ *
+ * Connected to the map refresh signals, pan only pays for the decimated
+ * subset while zoom changes trigger a full redecimation.
+ */
+void TrailPolylineItem::updateShape()
+{
+    if (lodDirty || m_map->ZoomStep() != lodZoom) {
+        rebuildLod();
+    }
+    prepareGeometryChange();
+    poly.clear();
+    poly.reserve(lodCoords.count());
+    foreach(internals::PointLatLng const & c, lodCoords) {
+        core::Point p = m_map->FromLatLngToLocal(c);
+
+        poly.append(QPointF(p.X(), p.Y()));
+    }
+    bounds = poly.boundingRect().adjusted(-2, -2, 2, 2);
+    update();
+}
+
+void TrailPolylineItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (poly.count() < 1) {
+        return;
+    }
+    if (showLine && poly.count() > 1) {
+        QPen pen;
+        pen.setBrush(lineBrush);
+        pen.setWidth(1);
+        painter->setPen(pen);
+        painter->drawPolyline(poly);
+    }
+    if (showDots) {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(dotBrush);
+        foreach(QPointF const & p, poly) {
+            painter->drawEllipse(p, 2, 2);
+        }
+    }
+}
+
+QRectF TrailPolylineItem::boundingRect() const
+{
+    return bounds;
+}
+
+int TrailPolylineItem::type() const
+{
+    return Type;
+}
+}
@@ -0,0 +1,80 @@
+/**
+ ******************************************************************************
+ *
+ * @file       trailpolylineitem.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @brief      A single graphicsItem rendering a whole UAV/GPS trail
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef TRAILPOLYLINEITEM_H
+#define TRAILPOLYLINEITEM_H
+
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QPolygonF>
+#include "../internals/pointlatlng.h"
+#include <QObject>
+#include "mapgraphicitem.h"
+
+namespace mapcontrol {
+/**
+ * @brief Renders a whole trail as one scene item.
+ *
+ * The trail used to be one TrailItem/TrailLineItem per fix, which makes the
+ * scene index grow without bound on long flights. This item keeps the fixes
+ * in a bounded ring buffer and paints them as a single polyline, decimated
+ * to the current zoom so only points that are visually apart get drawn.
+ */
+class TrailPolylineItem : public QObject, public QGraphicsItem {
+    Q_OBJECT Q_INTERFACES(QGraphicsItem)
+public:
+    enum { Type = UserType + 10 };
+    TrailPolylineItem(QBrush dotColor, QBrush lineColor, MapGraphicItem *map);
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+               QWidget *widget);
+    QRectF boundingRect() const;
+    int type() const;
+    void AddPoint(internals::PointLatLng const & coord);
+    void Clear();
+    int PointCount() const;
+    void SetShowDots(bool const & value);
+    void SetShowLine(bool const & value);
+public slots:
+    void updateShape();
+private:
+    void rebuildLod();
+    // trail fixes in insertion order once unrolled from head
+    QVector<internals::PointLatLng> coords;
+    int head;
+    // fixes kept after decimation at lodZoom
+    QVector<internals::PointLatLng> lodCoords;
+    int lodZoom;
+    bool lodDirty;
+    QPolygonF poly;
+    QRectF bounds;
+    QBrush dotBrush;
+    QBrush lineBrush;
+    MapGraphicItem *m_map;
+    bool showDots;
+    bool showLine;
+};
+}
+#endif // TRAILPOLYLINEITEM_H
@@ -254,8 +254,9 @@ void WayPointItem::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
         QString relativeCoord_str = QString::number(relativeCoord.distance) + "m " + QString::number(relativeCoord.bearing * 180 / M_PI) + "deg";
         text->setText(coord_str + "\n" + relativeCoord_str);
         textBG->setRect(text->boundingRect());
+        // only refresh the attached overlays (lines/circles) while dragging,
+        // the model is synced once on mouse release via WPValuesChanged
         emit localPositionChanged(this->pos(), this);
-        emit WPValuesChanged(this);
     }
     QGraphicsItem::mouseMoveEvent(event);
 }
@@ -27,13 +27,19 @@
 
 #include "OSGFileNode.hpp"
 
+#include "utils/pathutils.h"
+
 #include <osgDB/ReadFile>
+#include <osgDB/WriteFile>
 #include <osgUtil/Optimizer>
 
 #include <QUrl>
 #include <QOpenGLContext>
 #include <QThread>
 #include <QElapsedTimer>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDir>
 #include <QDebug>
 
 namespace osgQtQuick {
@@ -43,7 +49,7 @@ class OSGFileLoader : public QThread {
     Q_OBJECT
 
 public:
-    OSGFileLoader(const QUrl &url) : url(url)
+    OSGFileLoader(const QUrl &url, OptimizeMode::Enum optimizeMode) : url(url), optimizeMode(optimizeMode)
     {}
 
     void run()
@@ -59,9 +65,34 @@ public:
         t.start();
         // qDebug() << "OSGFileLoader::load - reading node file" << url.path();
         // qDebug() << "OSGFileLoader - load - currentContext" << QOpenGLContext::currentContext();
+
+        QString cacheFile = cacheFileFor(url);
+        if (!cacheFile.isEmpty() && isCacheValid(cacheFile)) {
+            // warm load : the optimized scene graph was serialized by a previous session
+            osg::Node *node = osgDB::readNodeFile(cacheFile.toStdString());
+            if (node) {
+                // qDebug() << "OSGFileLoader::load - reading cached node" << node << "took" << t.elapsed() << "ms";
+                return node;
+            }
+            qWarning() << "OSGFileLoader::load - failed to load cached node" << cacheFile;
+        }
+
         osg::Node *node = osgDB::readNodeFile(url.path().toStdString());
         if (!node) {
             qWarning() << "OSGFileLoader::load - failed to load" << url.path();
+            return node;
+        }
+        if (optimizeMode != OptimizeMode::None) {
+            // qDebug() << "OSGFileLoader::load - optimize" << node << optimizeMode;
+            osgUtil::Optimizer optimizer;
+            optimizer.optimize(node, osgUtil::Optimizer::DEFAULT_OPTIMIZATIONS);
+        }
+        if (!cacheFile.isEmpty()) {
+            // persist the optimized scene graph so the next session gets a warm load
+            QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+            if (!osgDB::writeNodeFile(*node, cacheFile.toStdString())) {
+                qWarning() << "OSGFileLoader::load - failed to write cached node" << cacheFile;
+            }
         }
         // qDebug() << "OSGFileLoader::load - reading node" << node << "took" << t.elapsed() << "ms";
         return node;
@@ -72,6 +103,28 @@ signals:
 
 private:
     QUrl url;
+    OptimizeMode::Enum optimizeMode;
+
+    // ! Cache location for a source file, empty when the source is not cacheable
+    QString cacheFileFor(const QUrl &url)
+    {
+        // earth files are runtime paged and already covered by the osgEarth filesystem cache
+        if (url.path().endsWith(".earth")) {
+            return QString();
+        }
+        QString key = QString(QCryptographicHash::hash(url.path().toUtf8(), QCryptographicHash::Md5).toHex());
+        return Utils::GetStoragePath() + "osgearth/nodecache/" + key + ".osgb";
+    }
+
+    // ! A cached node is valid as long as it is newer than its source file
+    bool isCacheValid(const QString &cacheFile)
+    {
+        QFileInfo cacheInfo(cacheFile);
+        QFileInfo sourceInfo(url.path());
+
+        return cacheInfo.exists() && sourceInfo.exists()
+               && cacheInfo.lastModified() >= sourceInfo.lastModified();
+    }
 };
 
 struct OSGFileNode::Hidden : public QObject {
@@ -109,14 +162,14 @@ public:
 private:
     osg::Node *syncLoad(const QUrl &url)
     {
-        OSGFileLoader loader(url);
+        OSGFileLoader loader(url, optimizeMode);
 
         return loader.load();
     }
 
     void asyncLoad(const QUrl &url)
     {
-        OSGFileLoader *loader = new OSGFileLoader(url);
+        OSGFileLoader *loader = new OSGFileLoader(url, optimizeMode);
 
         connect(loader, &OSGFileLoader::loaded, this, &Hidden::onLoaded);
         connect(loader, &OSGFileLoader::finished, loader, &OSGFileLoader::deleteLater);
@@ -126,11 +179,7 @@ private:
     void setNode(osg::Node *node)
     {
         // qDebug() << "OSGFileNode::setNode" << node;
-        if (node && optimizeMode != OptimizeMode::None) {
-            // qDebug() << "OSGFileNode::acceptNode - optimize" << node << optimizeMode;
-            osgUtil::Optimizer optimizer;
-            optimizer.optimize(node, osgUtil::Optimizer::DEFAULT_OPTIMIZATIONS);
-        }
+        // optimization happens in the loader so the cached node is the optimized one
         self->setNode(node);
     }
 
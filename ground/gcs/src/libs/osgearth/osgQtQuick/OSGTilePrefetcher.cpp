@@ -0,0 +1,335 @@
+/**
+ ******************************************************************************
+ *
+ * @file       OSGTilePrefetcher.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @addtogroup
+ * @{
+ * @addtogroup
+ * @{
+ * @brief
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "OSGTilePrefetcher.hpp"
+
+#include "OSGNode.hpp"
+
+#include <osgEarth/Map>
+#include <osgEarth/MapNode>
+#include <osgEarth/Profile>
+#include <osgEarth/TileKey>
+#include <osgEarth/ImageLayer>
+#include <osgEarth/ElevationLayer>
+
+#include <QThread>
+#include <QVector3D>
+#include <QDebug>
+
+#include <set>
+
+namespace osgQtQuick {
+// Fetches the computed tile set through the map layers on a worker thread.
+// With the registry cache policy set to read/write (see OsgEarth::initializeCache)
+// every fetched tile ends up in the filesystem cache, so the live view later
+// finds it locally instead of competing with rendering for network I/O.
+class TilePrefetchThread : public QThread {
+    Q_OBJECT
+
+public:
+    osg::ref_ptr<osgEarth::MapNode> mapNode;
+    QList<QVector3D> waypoints;
+    int minLevel;
+    int maxLevel;
+
+    TilePrefetchThread(QObject *parent = 0) : QThread(parent), minLevel(0), maxLevel(0), cancelled(0)
+    {}
+
+    void cancel()
+    {
+        cancelled.fetchAndStoreOrdered(1);
+    }
+
+signals:
+    void progressed(int fetched, int total);
+
+protected:
+    virtual void run()
+    {
+        const osgEarth::Profile *profile = mapNode->getMap()->getProfile();
+
+        std::set<osgEarth::TileKey> keys;
+        for (int level = minLevel; level <= maxLevel; level++) {
+            collectKeys(profile, level, keys);
+        }
+
+        osgEarth::ImageLayerVector imageLayers;
+        mapNode->getMap()->getImageLayers(imageLayers);
+
+        osgEarth::ElevationLayerVector elevationLayers;
+        mapNode->getMap()->getElevationLayers(elevationLayers);
+
+        int total   = keys.size();
+        int fetched = 0;
+        for (std::set<osgEarth::TileKey>::const_iterator it = keys.begin(); it != keys.end(); ++it) {
+            if (cancelled.load()) {
+                break;
+            }
+            for (osgEarth::ImageLayerVector::iterator layer = imageLayers.begin(); layer != imageLayers.end(); ++layer) {
+                (*layer)->createImage(*it);
+            }
+            for (osgEarth::ElevationLayerVector::iterator layer = elevationLayers.begin(); layer != elevationLayers.end(); ++layer) {
+                (*layer)->createHeightField(*it);
+            }
+            emit progressed(++fetched, total);
+        }
+    }
+
+private:
+    QAtomicInt cancelled;
+
+    // walks a route segment and adds the tiles it crosses, plus their direct
+    // neighbors so the corridor is roughly three tiles wide
+    void collectKeys(const osgEarth::Profile *profile, int level, std::set<osgEarth::TileKey> &keys)
+    {
+        double tileWidth, tileHeight;
+
+        profile->getTileDimensions(level, tileWidth, tileHeight);
+
+        for (int i = 1; i < waypoints.size(); i++) {
+            QVector3D from = waypoints.at(i - 1);
+            QVector3D to   = waypoints.at(i);
+
+            double dx    = to.x() - from.x();
+            double dy    = to.y() - from.y();
+            double span  = qMax(qAbs(dx) / tileWidth, qAbs(dy) / tileHeight);
+            // sample at half tile spacing so no crossed tile is skipped
+            int steps    = qMax(1, (int)(span * 2.0) + 1);
+
+            for (int s = 0; s <= steps; s++) {
+                double t   = (double)s / (double)steps;
+                double lon = from.x() + t * dx;
+                double lat = from.y() + t * dy;
+
+                osgEarth::TileKey key = profile->createTileKey(lon, lat, level);
+                if (!key.valid()) {
+                    continue;
+                }
+                for (int nx = -1; nx <= 1; nx++) {
+                    for (int ny = -1; ny <= 1; ny++) {
+                        osgEarth::TileKey neighbor = key.createNeighborKey(nx, ny);
+                        if (neighbor.valid()) {
+                            keys.insert(neighbor);
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+struct OSGTilePrefetcher::Hidden : public QObject {
+    Q_OBJECT
+
+private:
+    OSGTilePrefetcher *const self;
+
+public:
+    OSGNode *sceneNode;
+
+    QVariantList waypoints;
+
+    int   minLevel;
+    int   maxLevel;
+
+    qreal progress;
+
+    TilePrefetchThread *thread;
+
+    Hidden(OSGTilePrefetcher *self) : QObject(self), self(self), sceneNode(NULL),
+        minLevel(8), maxLevel(14), progress(0.0), thread(NULL)
+    {}
+
+    ~Hidden()
+    {
+        abandonThread();
+    }
+
+    bool running() const
+    {
+        return thread != NULL;
+    }
+
+    void start()
+    {
+        if (thread) {
+            qWarning() << "OSGTilePrefetcher::start - already running";
+            return;
+        }
+        if (!sceneNode || !sceneNode->node()) {
+            qWarning() << "OSGTilePrefetcher::start - scene node is not valid";
+            return;
+        }
+        osgEarth::MapNode *mapNode = osgEarth::MapNode::findMapNode(sceneNode->node());
+        if (!mapNode) {
+            qWarning() << "OSGTilePrefetcher::start - scene node does not contain a map node";
+            return;
+        }
+        if (waypoints.size() < 2) {
+            qWarning() << "OSGTilePrefetcher::start - need at least two waypoints";
+            return;
+        }
+
+        thread = new TilePrefetchThread(this);
+        thread->mapNode  = mapNode;
+        foreach(const QVariant &waypoint, waypoints) {
+            thread->waypoints.append(waypoint.value<QVector3D>());
+        }
+        thread->minLevel = minLevel;
+        thread->maxLevel = maxLevel;
+
+        connect(thread, &TilePrefetchThread::progressed, this, &Hidden::onProgressed);
+        connect(thread, &TilePrefetchThread::finished, this, &Hidden::onFinished);
+
+        progress = 0.0;
+        emit self->progressChanged(progress);
+
+        thread->start(QThread::LowPriority);
+        emit self->runningChanged(true);
+    }
+
+    void stop()
+    {
+        if (!thread) {
+            return;
+        }
+        thread->cancel();
+    }
+
+    // detach a still running thread so destruction does not block, the
+    // thread deletes itself once its last tile request returns
+    void abandonThread()
+    {
+        if (!thread) {
+            return;
+        }
+        disconnect(thread);
+        thread->cancel();
+        connect(thread, &TilePrefetchThread::finished, thread, &TilePrefetchThread::deleteLater);
+        thread->setParent(NULL);
+        thread = NULL;
+    }
+
+private slots:
+    void onProgressed(int fetched, int total)
+    {
+        progress = (total > 0) ? (qreal)fetched / (qreal)total : 1.0;
+        emit self->progressChanged(progress);
+    }
+
+    void onFinished()
+    {
+        thread->deleteLater();
+        thread = NULL;
+        emit self->runningChanged(false);
+    }
+};
+
+/* class OSGTilePrefetcher */
+
+OSGTilePrefetcher::OSGTilePrefetcher(QObject *parent) : QObject(parent), h(new Hidden(this))
+{}
+
+OSGTilePrefetcher::~OSGTilePrefetcher()
+{
+    delete h;
+}
+
+OSGNode *OSGTilePrefetcher::sceneNode() const
+{
+    return h->sceneNode;
+}
+
+void OSGTilePrefetcher::setSceneNode(OSGNode *node)
+{
+    if (h->sceneNode != node) {
+        h->sceneNode = node;
+        emit sceneNodeChanged(node);
+    }
+}
+
+QVariantList OSGTilePrefetcher::waypoints() const
+{
+    return h->waypoints;
+}
+
+void OSGTilePrefetcher::setWaypoints(const QVariantList &waypoints)
+{
+    if (h->waypoints != waypoints) {
+        h->waypoints = waypoints;
+        emit waypointsChanged(waypoints);
+    }
+}
+
+int OSGTilePrefetcher::minLevel() const
+{
+    return h->minLevel;
+}
+
+void OSGTilePrefetcher::setMinLevel(int level)
+{
+    if (h->minLevel != level) {
+        h->minLevel = level;
+        emit minLevelChanged(level);
+    }
+}
+
+int OSGTilePrefetcher::maxLevel() const
+{
+    return h->maxLevel;
+}
+
+void OSGTilePrefetcher::setMaxLevel(int level)
+{
+    if (h->maxLevel != level) {
+        h->maxLevel = level;
+        emit maxLevelChanged(level);
+    }
+}
+
+bool OSGTilePrefetcher::running() const
+{
+    return h->running();
+}
+
+qreal OSGTilePrefetcher::progress() const
+{
+    return h->progress;
+}
+
+void OSGTilePrefetcher::start()
+{
+    h->start();
+}
+
+void OSGTilePrefetcher::stop()
+{
+    h->stop();
+}
+} // namespace osgQtQuick
+
+#include "OSGTilePrefetcher.moc"
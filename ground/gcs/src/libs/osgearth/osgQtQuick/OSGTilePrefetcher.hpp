@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ *
+ * @file       OSGTilePrefetcher.hpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @addtogroup
+ * @{
+ * @addtogroup
+ * @{
+ * @brief
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef _H_OSGQTQUICK_OSGTILEPREFETCHER_H_
+#define _H_OSGQTQUICK_OSGTILEPREFETCHER_H_
+
+#include "Export.hpp"
+
+#include <QObject>
+#include <QVariantList>
+
+namespace osgQtQuick {
+class OSGNode;
+
+// Warms the osgEarth tile cache along a planned route so terrain and
+// imagery are on disk before they are needed by the live view.
+// Waypoints are given as a list of vector3d (longitude, latitude, altitude),
+// the same convention used by the other geo nodes.
+class OSGQTQUICK_EXPORT OSGTilePrefetcher : public QObject {
+    Q_OBJECT Q_PROPERTY(osgQtQuick::OSGNode *sceneNode READ sceneNode WRITE setSceneNode NOTIFY sceneNodeChanged)
+    Q_PROPERTY(QVariantList waypoints READ waypoints WRITE setWaypoints NOTIFY waypointsChanged)
+    Q_PROPERTY(int minLevel READ minLevel WRITE setMinLevel NOTIFY minLevelChanged)
+    Q_PROPERTY(int maxLevel READ maxLevel WRITE setMaxLevel NOTIFY maxLevelChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
+
+public:
+    explicit OSGTilePrefetcher(QObject *parent = 0);
+    virtual ~OSGTilePrefetcher();
+
+    OSGNode *sceneNode() const;
+    void setSceneNode(OSGNode *node);
+
+    QVariantList waypoints() const;
+    void setWaypoints(const QVariantList &waypoints);
+
+    int minLevel() const;
+    void setMinLevel(int level);
+
+    int maxLevel() const;
+    void setMaxLevel(int level);
+
+    bool running() const;
+
+    qreal progress() const;
+
+    Q_INVOKABLE void start();
+    Q_INVOKABLE void stop();
+
+signals:
+    void sceneNodeChanged(OSGNode *node);
+    void waypointsChanged(const QVariantList &waypoints);
+    void minLevelChanged(int level);
+    void maxLevelChanged(int level);
+    void runningChanged(bool running);
+    void progressChanged(qreal progress);
+
+private:
+    struct Hidden;
+    Hidden *const h;
+};
+} // namespace osgQtQuick
+
+#endif // _H_OSGQTQUICK_OSGTILEPREFETCHER_H_
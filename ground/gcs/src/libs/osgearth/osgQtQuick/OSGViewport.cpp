@@ -188,6 +188,8 @@ public:
 
     UpdateMode::Enum     updateMode;
 
+    int frameRate;
+
     bool incrementalCompile;
 
     bool busy;
@@ -198,7 +200,7 @@ public:
 
     Hidden(OSGViewport *self) : QObject(self), self(self), window(NULL), frameTimer(-1), frameCount(0),
         sceneNode(NULL), cameraNode(NULL), manipulator(NULL),
-        updateMode(UpdateMode::OnDemand), incrementalCompile(false), busy(false)
+        updateMode(UpdateMode::OnDemand), frameRate(30), incrementalCompile(false), busy(false)
     {
         OsgEarth::initialize();
 
@@ -424,6 +426,10 @@ private:
         viewer = new MyViewer();
         // viewer = new osgViewer::CompositeViewer();
 
+        // Rendering happens inside the Qt Quick render pass with the Qt
+        // supplied gl context bound, so the viewer must not spawn its own
+        // draw threads (DrawThreadPerContext and friends would draw outside
+        // the FBO render pass).
         viewer->setThreadingModel(osgViewer::ViewerBase::SingleThreaded);
 
         // disable the default setting of viewer.done() by pressing Escape.
@@ -533,9 +539,9 @@ private:
 
     void startTimer()
     {
-        if ((frameTimer < 0) && (updateMode != UpdateMode::Continuous)) {
+        if (frameTimer < 0) {
             // qDebug() << "OSGViewport::startTimer - starting timer";
-            frameTimer = QObject::startTimer(33, Qt::PreciseTimer);
+            frameTimer = QObject::startTimer(1000 / frameRate, Qt::PreciseTimer);
         }
     }
 
@@ -548,11 +554,39 @@ private:
         }
     }
 
+public:
+    void restartTimer()
+    {
+        if (frameTimer >= 0) {
+            stopTimer();
+            startTimer();
+        }
+    }
+
+private:
+    // tells if the next timer tick needs to schedule a render pass
+    // in on-demand mode an idle scene schedules nothing and costs nothing
+    bool needsUpdate()
+    {
+        if (updateMode != UpdateMode::OnDemand) {
+            return true;
+        }
+        if (!viewer.valid() || !view.valid()) {
+            return false;
+        }
+        // UI events are queued from the gui thread so peeking here is safe
+        if (!view->getEventQueue()->empty()) {
+            return true;
+        }
+        // covers pager activity, update callbacks and redraw requests
+        return viewer->checkNeedToDoFrame();
+    }
+
 protected:
     void timerEvent(QTimerEvent *event)
     {
         if (event->timerId() == frameTimer) {
-            if (self) {
+            if (self && needsUpdate()) {
                 self->update();
             }
         }
@@ -702,10 +736,8 @@ public:
             needToDoFrame = false;
         }
 
-        if (h->updateMode == UpdateMode::Continuous) {
-            // trigger next update
-            update();
-        }
+        // the frame timer schedules the next update for all update modes,
+        // capping continuous rendering at the configured frame rate
 
         ++(h->frameCount);
         initFrame = false;
@@ -811,6 +843,23 @@ void OSGViewport::setUpdateMode(UpdateMode::Enum mode)
     }
 }
 
+int OSGViewport::frameRate() const
+{
+    return h->frameRate;
+}
+
+void OSGViewport::setFrameRate(int frameRate)
+{
+    if (frameRate < 1) {
+        frameRate = 1;
+    }
+    if (h->frameRate != frameRate) {
+        h->frameRate = frameRate;
+        h->restartTimer();
+        emit frameRateChanged(frameRate);
+    }
+}
+
 bool OSGViewport::incrementalCompile() const
 {
     return h->incrementalCompile;
@@ -55,6 +55,7 @@ class OSGQTQUICK_EXPORT OSGViewport : public QQuickFramebufferObject {
     Q_PROPERTY(osgQtQuick::OSGCamera * camera READ cameraNode WRITE setCameraNode NOTIFY cameraNodeChanged)
     Q_PROPERTY(osgQtQuick::OSGCameraManipulator * manipulator READ manipulator WRITE setManipulator NOTIFY manipulatorChanged)
     Q_PROPERTY(osgQtQuick::UpdateMode::Enum updateMode READ updateMode WRITE setUpdateMode NOTIFY updateModeChanged)
+    Q_PROPERTY(int frameRate READ frameRate WRITE setFrameRate NOTIFY frameRateChanged)
     Q_PROPERTY(bool incrementalCompile READ incrementalCompile WRITE setIncrementalCompile NOTIFY incrementalCompileChanged)
     Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
 
@@ -78,6 +79,9 @@ public:
     UpdateMode::Enum updateMode() const;
     void setUpdateMode(UpdateMode::Enum mode);
 
+    int frameRate() const;
+    void setFrameRate(int frameRate);
+
     bool incrementalCompile() const;
     void setIncrementalCompile(bool busy);
 
@@ -93,6 +97,7 @@ signals:
     void cameraNodeChanged(OSGCamera *);
     void manipulatorChanged(OSGCameraManipulator *);
     void updateModeChanged(UpdateMode::Enum);
+    void frameRateChanged(int frameRate);
     void incrementalCompileChanged(bool);
     void busyChanged(bool busy);
 
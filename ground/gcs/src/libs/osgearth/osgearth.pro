@@ -85,11 +85,13 @@ SOURCES += \
 
 osgearth:HEADERS += \
     osgQtQuick/OSGSkyNode.hpp \
-    osgQtQuick/OSGGeoTransformNode.hpp
+    osgQtQuick/OSGGeoTransformNode.hpp \
+    osgQtQuick/OSGTilePrefetcher.hpp
 
 osgearth:SOURCES += \
     osgQtQuick/OSGSkyNode.cpp \
-    osgQtQuick/OSGGeoTransformNode.cpp
+    osgQtQuick/OSGGeoTransformNode.cpp \
+    osgQtQuick/OSGTilePrefetcher.cpp
 
 osgearth:HEADERS += \
     osgQtQuick/ga/OSGEarthManipulator.hpp \
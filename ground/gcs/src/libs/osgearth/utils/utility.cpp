@@ -65,6 +65,7 @@
 #ifdef USE_OSGEARTH
 #include "osgQtQuick/OSGSkyNode.hpp"
 #include "osgQtQuick/OSGGeoTransformNode.hpp"
+#include "osgQtQuick/OSGTilePrefetcher.hpp"
 
 #include "osgQtQuick/ga/OSGEarthManipulator.hpp"
 #include "osgQtQuick/ga/OSGGeoTransformManipulator.hpp"
@@ -572,6 +573,8 @@ void registerTypes()
     qmlRegisterType<osgQtQuick::OSGSkyNode>("OsgQtQuick", maj, min, "OSGSkyNode");
     qmlRegisterType<osgQtQuick::OSGGeoTransformNode>("OsgQtQuick", maj, min, "OSGGeoTransformNode");
 
+    qmlRegisterType<osgQtQuick::OSGTilePrefetcher>("OsgQtQuick", maj, min, "OSGTilePrefetcher");
+
     qmlRegisterType<osgQtQuick::OSGEarthManipulator>("OsgQtQuick", maj, min, "OSGEarthManipulator");
     qmlRegisterType<osgQtQuick::OSGGeoTransformManipulator>("OsgQtQuick", maj, min, "OSGGeoTransformManipulator");
 #endif // USE_OSGEARTH
@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ *
+ * @file       jobmanager.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @brief      Shared background job system for the GCS
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "jobmanager.h"
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+CancellationToken::CancellationToken() : m_cancelled(new QAtomicInt(0))
+{}
+
+void CancellationToken::cancel()
+{
+    m_cancelled->storeRelease(1);
+}
+
+bool CancellationToken::isCancelled() const
+{
+    return m_cancelled->loadAcquire() != 0;
+}
+
+namespace {
+class JobRunnable : public QRunnable {
+public:
+    JobRunnable(const JobManager::Job &job, const CancellationToken &token)
+        : m_job(job), m_token(token)
+    {}
+
+    void run()
+    {
+        // a job cancelled while still queued is dropped without running
+        if (m_token.isCancelled()) {
+            return;
+        }
+        m_job(m_token);
+    }
+
+private:
+    JobManager::Job m_job;
+    CancellationToken m_token;
+};
+} // anonymous namespace
+
+JobManager *JobManager::instance()
+{
+    static JobManager jobManager;
+
+    return &jobManager;
+}
+
+JobManager::JobManager()
+{
+    // one CPU worker per core keeps compute work from oversubscribing, the
+    // I/O lane gets twice that since its jobs mostly sit in blocking calls
+    int cores = qMax(QThread::idealThreadCount(), 1);
+
+    m_cpuPool.setMaxThreadCount(cores);
+    m_ioPool.setMaxThreadCount(2 * cores);
+    // speculative work (low priority prefetch) should not pin workers alive
+    m_cpuPool.setExpiryTimeout(30 * 1000);
+    m_ioPool.setExpiryTimeout(30 * 1000);
+}
+
+CancellationToken JobManager::run(const Job &job, Lane lane, Priority priority)
+{
+    CancellationToken token;
+    QThreadPool & pool = (lane == IO_LANE) ? m_ioPool : m_cpuPool;
+
+    // QThreadPool keeps one priority ordered queue per lane that every idle
+    // worker pulls from, which is what balances load across submitters
+    pool.start(new JobRunnable(job, token), priority);
+    return token;
+}
+
+bool JobManager::waitForDone(int msecs)
+{
+    bool done = m_cpuPool.waitForDone(msecs);
+
+    done = m_ioPool.waitForDone(msecs) && done;
+    return done;
+}
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
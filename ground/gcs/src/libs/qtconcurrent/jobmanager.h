@@ -0,0 +1,115 @@
+/**
+ ******************************************************************************
+ *
+ * @file       jobmanager.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @brief      Shared background job system for the GCS
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef JOBMANAGER_H
+#define JOBMANAGER_H
+
+#include "qtconcurrent_global.h"
+
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QThreadPool>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+/**
+ * Cooperative cancellation flag shared between the caller and the job.
+ * Copies refer to the same flag; the job polls isCancelled() at convenient
+ * points and bails out, the caller flips it with cancel(). A job that was
+ * still queued when its token got cancelled is never executed at all.
+ */
+class QTCONCURRENT_EXPORT CancellationToken {
+public:
+    CancellationToken();
+
+    void cancel();
+    bool isCancelled() const;
+
+private:
+    QSharedPointer<QAtomicInt> m_cancelled;
+};
+
+/**
+ * Process wide pool for background work, meant to replace the private
+ * QThread instances that plugins used to spin up for map tile decoding,
+ * log export, calibration solvers and the like. All jobs drain through two
+ * shared lanes so the GCS never runs more CPU bound work than there are
+ * cores, no matter how many plugins queue jobs at once:
+ *
+ * - the CPU lane has one worker per core. Idle workers pull the next
+ *   queued job regardless of who submitted it, so load balances across
+ *   submitters without per plugin threads.
+ * - the I/O lane is allowed to oversubscribe, its jobs spend their time
+ *   blocked on disk or network rather than on a core.
+ *
+ * Priorities order the queue within a lane; a high priority job queued
+ * behind a long backlog still runs next.
+ */
+class QTCONCURRENT_EXPORT JobManager : public QObject {
+    Q_OBJECT
+
+public:
+    enum Lane {
+        CPU_LANE, /**< compute bound work, one worker per core */
+        IO_LANE /**< work that mostly blocks on disk or network */
+    };
+
+    enum Priority {
+        PRIORITY_LOW    = -1, /**< prefetch and other speculative work */
+        PRIORITY_NORMAL = 0,
+        PRIORITY_HIGH   = 1 /**< the user is waiting on the result */
+    };
+
+    typedef std::function<void(const CancellationToken &)> Job;
+
+    static JobManager *instance();
+
+    /**
+     * Queue a job on the given lane. The returned token cancels the job:
+     * before it started it is dropped from the queue, after it started the
+     * job is expected to poll the token and stop early.
+     */
+    CancellationToken run(const Job &job, Lane lane = CPU_LANE, Priority priority = PRIORITY_NORMAL);
+
+    /** Block until both lanes are drained, used on shutdown. */
+    bool waitForDone(int msecs = -1);
+
+private:
+    JobManager();
+
+    QThreadPool m_cpuPool;
+    QThreadPool m_ioPool;
+};
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // JOBMANAGER_H
@@ -7,4 +7,8 @@ include(../../library.pri)
 HEADERS += \
     qtconcurrent_global.h \
     multitask.h \
-    runextensions.h
+    runextensions.h \
+    jobmanager.h
+
+SOURCES += \
+    jobmanager.cpp
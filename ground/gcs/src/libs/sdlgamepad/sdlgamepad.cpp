@@ -45,6 +45,10 @@ SDLGamepad::SDLGamepad()
     index   = -1;
     loop    = false;
     tick    = MIN_RATE;
+    latestTimestamp = 0;
+    for (qint8 i = 0; i < MAX_AXES; i++) {
+        latestAxes[i] = 0;
+    }
     priv    = new SDLGamepadPrivate;
 }
 
@@ -83,6 +87,8 @@ bool SDLGamepad::init()
         return false;
     }
 
+    sampleClock.start();
+
     loop = true;
     return true;
 }
@@ -137,6 +143,59 @@ void SDLGamepad::setTickRate(qint16 ms)
     tick = ms;
 }
 
+/**********************************************************************/
+void SDLGamepad::setLowLatencyMode(bool enabled)
+{
+    tick = enabled ? LOW_LATENCY_RATE : MIN_RATE;
+}
+
+/**********************************************************************/
+bool SDLGamepad::getLatestAxes(QListInt16 &values, qint64 &timestamp)
+{
+    if (axes <= 0) {
+        return false;
+    }
+
+    qint16 buffer[MAX_AXES];
+    qint64 stamp;
+    int before, after;
+
+    // retry until a stable even sequence brackets the copy,
+    // an odd value means the capture thread is writing right now
+    do {
+        before = sampleSequence.loadAcquire();
+        if (before & 1) {
+            continue;
+        }
+
+        for (qint8 i = 0; i < axes; i++) {
+            buffer[i] = latestAxes[i];
+        }
+        stamp = latestTimestamp;
+
+        after  = sampleSequence.loadAcquire();
+    } while (before != after);
+
+    if (after == 0) {
+        // no sample captured yet
+        return false;
+    }
+
+    values.clear();
+    for (qint8 i = 0; i < axes; i++) {
+        values.append(buffer[i]);
+    }
+    timestamp = stamp;
+
+    return true;
+}
+
+/**********************************************************************/
+qint64 SDLGamepad::microsNow() const
+{
+    return sampleClock.nsecsElapsed() / 1000;
+}
+
 /**********************************************************************/
 void SDLGamepad::updateAxes()
 {
@@ -154,7 +213,22 @@ void SDLGamepad::updateAxes()
             values.append(value);
         }
 
-        emit axesValues(values);
+        // publish the sample into the latest value slot, the odd
+        // sequence value marks the write in progress for readers
+        int sequence = sampleSequence.load();
+        sampleSequence.storeRelease(sequence + 1);
+        for (qint8 i = 0; i < axes && i < MAX_AXES; i++) {
+            latestAxes[i] = values.at(i);
+        }
+        latestTimestamp = sampleClock.nsecsElapsed() / 1000;
+        sampleSequence.storeRelease(sequence + 2);
+
+        // only signal actual movement, at high capture rates an
+        // unconditional emission would flood queued connections
+        if (values != lastAxesValues) {
+            lastAxesValues = values;
+            emit axesValues(values);
+        }
     }
 }
 
@@ -26,6 +26,8 @@
 #include "sdlgamepad_global.h"
 
 #include <QThread>
+#include <QAtomicInt>
+#include <QElapsedTimer>
 
 /**
  * The Axis range that is treated as null.
@@ -44,7 +46,23 @@
  *
  * @see SDLGamepad::setTickRate()
  */
-#define MIN_RATE   10
+#define MIN_RATE         10
+
+/**
+ * The tick rate used in low latency mode.
+ *
+ * 4 ms gives a 250 Hz capture rate for hand flying over the GCS link.
+ *
+ * @see SDLGamepad::setLowLatencyMode()
+ */
+#define LOW_LATENCY_RATE 4
+
+/**
+ * The maximum number of axes kept in the latest value slot.
+ *
+ * This matches the AxisNumber enumeration below.
+ */
+#define MAX_AXES         10
 
 /**
  * Axis enumeration.
@@ -176,6 +194,30 @@ public:
      */
     qint16 getButtons();
 
+    /**
+     * Read the freshest sample from the latest value slot.
+     *
+     * The capture thread publishes every sample into a fixed slot
+     * guarded by a sequence counter, so the writer never blocks and a
+     * reader never waits on a lock. Consumers that must act on the
+     * freshest stick position (instead of a possibly stale queued
+     * signal payload) should read it from here.
+     *
+     * @param values Filled with the latest value of every axis.
+     * @param timestamp Filled with the capture time of the sample in
+     *                  microseconds, on the same clock as microsNow().
+     * @return False if no sample has been captured yet.
+     */
+    bool getLatestAxes(QListInt16 &values, qint64 &timestamp);
+
+    /**
+     * The current time on the sample clock in microseconds.
+     *
+     * Subtract a timestamp returned by getLatestAxes() from this to
+     * measure input latency.
+     */
+    qint64 microsNow() const;
+
 public slots:
 
     /**
@@ -208,6 +250,19 @@ public slots:
      */
     void setTickRate(qint16 ms);
 
+    /**
+     * Enable or disable low latency capture.
+     *
+     * In low latency mode the capture thread runs at LOW_LATENCY_RATE
+     * (250 Hz). The higher rate is cheap because axesValues is only
+     * emitted when a value actually changed; an idle gamepad causes no
+     * signal traffic at all.
+     *
+     * @param enabled True to capture at LOW_LATENCY_RATE, false to
+     *                fall back to MIN_RATE.
+     */
+    void setLowLatencyMode(bool enabled);
+
     /**
      * Change the active gamepad.
      *
@@ -299,6 +354,40 @@ private:
      */
     QList<qint16> buttonStates;
 
+    /**
+     * The axes values of the previous emission.
+     *
+     * Used to suppress axesValues signals when nothing changed, so a
+     * high capture rate does not flood queued connections.
+     */
+    QList<qint16> lastAxesValues;
+
+    /**
+     * The latest value slot.
+     *
+     * The capture thread writes every sample here, bracketed by
+     * increments of sampleSequence (odd while a write is in progress).
+     * Readers retry until they observe a stable even sequence.
+     *
+     * @see getLatestAxes()
+     */
+    qint16 latestAxes[MAX_AXES];
+
+    /**
+     * Capture time of the slot content in microseconds.
+     */
+    qint64 latestTimestamp;
+
+    /**
+     * Sequence counter guarding the latest value slot.
+     */
+    QAtomicInt sampleSequence;
+
+    /**
+     * Monotonic clock stamping every captured sample.
+     */
+    QElapsedTimer sampleClock;
+
     /**
      * Variable that holds private members.
      */
@@ -339,11 +428,13 @@ signals:
      * A signal that emitts the current values of the gamepad axes.
      *
      * You can connect to this signal to receive the values of the
-     * gamepad axes. Unlike the button signal, this signal is thrown
-     * with every tick. You will get a QListInt16 containing the value
-     * of every present axis in a QList.
+     * gamepad axes. Like the button signal, this signal is only thrown
+     * for ticks where at least one axis value changed. You will get a
+     * QListInt16 containing the value of every present axis in a QList.
+     * The freshest sample is always available through getLatestAxes().
      *
      * @see QListInt16
+     * @see getLatestAxes()
      * @param values A QListInt16 Type containing all axes values.
      */
     void axesValues(QListInt16 values);
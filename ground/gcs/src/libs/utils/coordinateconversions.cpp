@@ -277,4 +277,96 @@ void CoordinateConversions::R2Quaternion(float const Rbe[3][3], float q[4])
     q[2] = y;
     q[3] = z;
 }
+
+/**
+ * Convert a batch of LLA coordinates to ECEF coordinates
+ * @param[in] count number of points
+ * @param[in] lat,lon,alt input coordinate arrays (struct of arrays)
+ * @param[out] x,y,z output ECEF coordinate arrays
+ */
+void CoordinateConversions::LLA2ECEF(int count, const double *lat, const double *lon, const double *alt,
+                                     double *x, double *y, double *z)
+{
+    const double a = 6378137.0; // Equatorial Radius
+    const double e = 8.1819190842622e-2; // Eccentricity
+
+    for (int i = 0; i < count; i++) {
+        double sinLat = sin(DEG2RAD * lat[i]);
+        double sinLon = sin(DEG2RAD * lon[i]);
+        double cosLat = cos(DEG2RAD * lat[i]);
+        double cosLon = cos(DEG2RAD * lon[i]);
+
+        double N = a / sqrt(1.0 - e * e * sinLat * sinLat); // prime vertical radius of curvature
+
+        x[i] = (N + alt[i]) * cosLat * cosLon;
+        y[i] = (N + alt[i]) * cosLat * sinLon;
+        z[i] = ((1 - e * e) * N + alt[i]) * sinLat;
+    }
+}
+
+/**
+ * Convert a batch of LLA coordinates to NED relative to a base location
+ * @param[in] count number of points
+ * @param[in] lat,lon,alt input coordinate arrays (struct of arrays)
+ * @param[in] BaseECEF the ECEF of the base location (in m)
+ * @param[in] Rne rotation matrix for the base location
+ * @param[out] north,east,down output NED coordinate arrays
+ */
+void CoordinateConversions::LLA2Base(int count, const double *lat, const double *lon, const double *alt,
+                                     double BaseECEF[3], float Rne[3][3],
+                                     float *north, float *east, float *down)
+{
+    const double a = 6378137.0; // Equatorial Radius
+    const double e = 8.1819190842622e-2; // Eccentricity
+
+    for (int i = 0; i < count; i++) {
+        double sinLat = sin(DEG2RAD * lat[i]);
+        double sinLon = sin(DEG2RAD * lon[i]);
+        double cosLat = cos(DEG2RAD * lat[i]);
+        double cosLon = cos(DEG2RAD * lon[i]);
+
+        double N     = a / sqrt(1.0 - e * e * sinLat * sinLat);
+
+        float diff0  = (float)((N + alt[i]) * cosLat * cosLon - BaseECEF[0]);
+        float diff1  = (float)((N + alt[i]) * cosLat * sinLon - BaseECEF[1]);
+        float diff2  = (float)(((1 - e * e) * N + alt[i]) * sinLat - BaseECEF[2]);
+
+        north[i] = Rne[0][0] * diff0 + Rne[0][1] * diff1 + Rne[0][2] * diff2;
+        east[i]  = Rne[1][0] * diff0 + Rne[1][1] * diff1 + Rne[1][2] * diff2;
+        down[i]  = Rne[2][0] * diff0 + Rne[2][1] * diff1 + Rne[2][2] * diff2;
+    }
+}
+
+HomeNedConverter::HomeNedConverter() : m_hasOrigin(false)
+{}
+
+/**
+ * Set the home location and precompute the ECEF origin and rotation
+ * matrix used by all subsequent conversions. Call again whenever the
+ * home location changes.
+ * @param[in] homeLLA latitude, longitude and altitude of the home location
+ */
+void HomeNedConverter::setOrigin(double homeLLA[3])
+{
+    m_converter.LLA2ECEF(homeLLA, m_originECEF);
+    m_converter.RneFromLLA(homeLLA, m_Rne);
+    m_hasOrigin = true;
+}
+
+/**
+ * Convert a single LLA position to NED relative to the home location
+ */
+void HomeNedConverter::toNED(double LLA[3], float NED[3])
+{
+    m_converter.LLA2Base(LLA, m_originECEF, m_Rne, NED);
+}
+
+/**
+ * Convert a batch of LLA positions to NED relative to the home location
+ */
+void HomeNedConverter::toNED(int count, const double *lat, const double *lon, const double *alt,
+                             float *north, float *east, float *down)
+{
+    m_converter.LLA2Base(count, lat, lon, alt, m_originECEF, m_Rne, north, east, down);
+}
 }
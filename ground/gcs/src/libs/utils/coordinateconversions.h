@@ -49,6 +49,43 @@ public:
     void RPY2Quaternion(const float rpy[3], float q[4]);
     void Quaternion2R(const float q[4], float Rbe[3][3]);
     void R2Quaternion(float const Rbe[3][3], float q[4]);
+
+    // Batch variants operating on separate coordinate arrays (struct of
+    // arrays), meant for trail points, waypoints and similar bulk updates
+    // where the per point call overhead dominates. The plain loops over
+    // independent elements are vectorizable by the compiler.
+    void LLA2ECEF(int count, const double *lat, const double *lon, const double *alt,
+                  double *x, double *y, double *z);
+    void LLA2Base(int count, const double *lat, const double *lon, const double *alt,
+                  double BaseECEF[3], float Rne[3][3],
+                  float *north, float *east, float *down);
+};
+
+/**
+ * Converts LLA positions to NED relative to a fixed home location.
+ * The ECEF origin and the rotation matrix are computed once in
+ * setOrigin(), so per point conversions reduce to one LLA2ECEF and a
+ * matrix multiply instead of recomputing the rotation every call.
+ */
+class QTCREATOR_UTILS_EXPORT HomeNedConverter {
+public:
+    HomeNedConverter();
+
+    void setOrigin(double homeLLA[3]);
+    bool hasOrigin() const
+    {
+        return m_hasOrigin;
+    }
+
+    void toNED(double LLA[3], float NED[3]);
+    void toNED(int count, const double *lat, const double *lon, const double *alt,
+               float *north, float *east, float *down);
+
+private:
+    CoordinateConversions m_converter;
+    double m_originECEF[3];
+    float m_Rne[3][3];
+    bool m_hasOrigin;
 };
 }
 
@@ -60,6 +60,32 @@ const quint8 crc_table[256] = {
     0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5, 0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3
 };
 
+/*
+ * Derived tables for the sliced bulk implementation below.
+ *
+ * The CRC update is linear over GF(2), so the checksum of an 8 byte block
+ * can be computed as the XOR of 8 independent table lookups, one per byte,
+ * where slice_table[k] advances a byte value through k additional zero
+ * bytes (slice_table[0] is the plain crc_table). This removes the
+ * lookup-to-lookup dependency chain of the byte-at-a-time loop and lets the
+ * CPU issue the lookups in parallel.
+ */
+static struct CrcSliceTables {
+    quint8 t[8][256];
+
+    CrcSliceTables()
+    {
+        for (int i = 0; i < 256; i++) {
+            t[0][i] = crc_table[i];
+        }
+        for (int k = 1; k < 8; k++) {
+            for (int i = 0; i < 256; i++) {
+                t[k][i] = crc_table[t[k - 1][i]];
+            }
+        }
+    }
+} crc_slices;
+
 quint8 Crc::updateCRC(quint8 crc, const quint8 data)
 {
     return crc_table[crc ^ data];
@@ -67,6 +93,20 @@ quint8 Crc::updateCRC(quint8 crc, const quint8 data)
 
 quint8 Crc::updateCRC(quint8 crc, const quint8 *data, qint32 length)
 {
+    // slicing-by-8 : fold the running crc into the first byte of the block
+    // and combine 8 independent lookups
+    while (length >= 8) {
+        crc     = crc_slices.t[7][crc ^ data[0]]
+                  ^ crc_slices.t[6][data[1]]
+                  ^ crc_slices.t[5][data[2]]
+                  ^ crc_slices.t[4][data[3]]
+                  ^ crc_slices.t[3][data[4]]
+                  ^ crc_slices.t[2][data[5]]
+                  ^ crc_slices.t[1][data[6]]
+                  ^ crc_slices.t[0][data[7]];
+        data   += 8;
+        length -= 8;
+    }
     while (length--) {
         crc = crc_table[crc ^ *data++];
     }
@@ -1,13 +1,180 @@
 #include "logfile.h"
+#include "tracer.h"
 #include <QDebug>
 #include <QtGlobal>
 
+// Compressed logs start with an 8 byte header (magic plus version) and
+// hold the frames in zlib deflated blocks:
+// [u32 compressedSize][u32 rawSize][qCompress data]
+// Every block starts at a frame boundary, so the seek index can point at
+// block starts and a seek never lands inside a frame.
+static const quint32 LOG_ZMAGIC = 0x4F504C5A; // "OPLZ"
+static const quint32 LOG_ZVERSION    = 1;
+static const int LOG_ZHEADER_SIZE    = 2 * sizeof(quint32);
+static const int LOG_ZBLOCK_HEADER_SIZE = 2 * sizeof(quint32);
+
+// Indexed logs end with a footer:
+// [count * (u32 timeStamp, s64 offset)][u32 count][u32 magic]
+// Logs without the footer (older GCS versions) replay as before, just
+// without seeking.
+static const quint32 LOG_INDEX_MAGIC  = 0x4F504C49; // "OPLI"
+static const int LOG_INDEX_ENTRY_SIZE = sizeof(quint32) + sizeof(qint64);
+static const int LOG_INDEX_TRAILER_SIZE = 2 * sizeof(quint32);
+
+// Upper bound on the frames queued per replay timer tick, so high
+// replay speeds never starve the rest of the event loop. Frames beyond
+// the cap simply play on the next tick, 10 ms later.
+static const int MAX_REPLAY_FRAMES_PER_TICK = 500;
+
+// Sanity bound for block sizes read back from a compressed log
+static const int MAX_REPLAY_BLOCK_SIZE = 4 * 1024 * 1024;
+
+LogFileFlushThread::LogFileFlushThread(QFile *file, bool compress) :
+    QThread(),
+    m_file(file),
+    m_compress(compress),
+    m_stop(false),
+    m_droppedBytes(0),
+    m_droppedFrames(0),
+    m_acceptedBytes(0),
+    m_fileOffset(compress ? LOG_ZHEADER_SIZE : 0),
+    m_fillFirstTimeStamp(0)
+{}
+
+/**
+ * Queues one complete frame for the flush thread. Called on the
+ * telemetry thread, never touches the file.
+ */
+void LogFileFlushThread::append(const char *data, qint64 dataSize, quint32 timeStamp)
+{
+    QMutexLocker locker(&m_bufferMutex);
+
+    if (m_fillBuffer.size() + dataSize > MAX_BUFFER_SIZE) {
+        // The disk cannot keep up. Dropping the whole frame instead of
+        // blocking keeps the telemetry thread responsive and the log
+        // stream parseable.
+        m_droppedBytes += dataSize;
+        m_droppedFrames++;
+        return;
+    }
+
+    // The index is built from accepted frames only, so the recorded
+    // offsets match the file even when frames get dropped. Compressed
+    // logs get their entries per block in run() instead, as only the
+    // flush thread knows where a block lands in the file.
+    if (!m_compress
+        && (m_indexEntries.isEmpty()
+            || (timeStamp - m_indexEntries.last().timeStamp >= INDEX_PERIOD_MS))) {
+        LogIndexEntry entry;
+        entry.timeStamp = timeStamp;
+        entry.offset    = m_acceptedBytes;
+        m_indexEntries.append(entry);
+    }
+
+    if (m_fillBuffer.isEmpty()) {
+        m_fillFirstTimeStamp = timeStamp;
+    }
+    m_fillBuffer.append(data, (int)dataSize);
+    m_acceptedBytes += dataSize;
+    m_dataAvailable.wakeOne();
+}
+
+void LogFileFlushThread::stop()
+{
+    m_bufferMutex.lock();
+    m_stop = true;
+    m_dataAvailable.wakeOne();
+    m_bufferMutex.unlock();
+
+    wait();
+}
+
+qint64 LogFileFlushThread::bytesBuffered() const
+{
+    QMutexLocker locker(&m_bufferMutex);
+
+    return m_fillBuffer.size();
+}
+
+void LogFileFlushThread::run()
+{
+    forever {
+        m_bufferMutex.lock();
+        while (!m_stop) {
+            if (m_fillBuffer.isEmpty()) {
+                m_dataAvailable.wait(&m_bufferMutex);
+            } else if (m_compress && (m_fillBuffer.size() < MIN_BLOCK_SIZE)) {
+                // give a small block some time to fill up, but flush it
+                // after the timeout so frames never sit in memory for long
+                if (!m_dataAvailable.wait(&m_bufferMutex, BLOCK_FLUSH_TIMEOUT_MS)) {
+                    break;
+                }
+            } else {
+                break;
+            }
+        }
+        // swap the buffers so the writer can keep appending while the
+        // collected segment goes to disk in one sequential write
+        quint32 segmentTimeStamp = m_fillFirstTimeStamp;
+        m_flushBuffer.clear();
+        m_fillBuffer.swap(m_flushBuffer);
+        bool stopping = m_stop;
+        m_bufferMutex.unlock();
+
+        if (!m_flushBuffer.isEmpty()) {
+            if (m_compress) {
+                writeBlock(segmentTimeStamp);
+            } else {
+                m_file->write(m_flushBuffer);
+            }
+        }
+
+        if (stopping) {
+            m_file->flush();
+            return;
+        }
+    }
+}
+
+/**
+ * Deflates the collected segment and writes it as one block. Runs on the
+ * flush thread.
+ */
+void LogFileFlushThread::writeBlock(quint32 segmentTimeStamp)
+{
+    // every block starts a frame, so it can carry a seek sync point
+    if (m_indexEntries.isEmpty()
+        || (segmentTimeStamp - m_indexEntries.last().timeStamp >= INDEX_PERIOD_MS)) {
+        LogIndexEntry entry;
+        entry.timeStamp = segmentTimeStamp;
+        entry.offset    = m_fileOffset;
+        m_indexEntries.append(entry);
+    }
+
+    QByteArray compressed = qCompress(m_flushBuffer);
+    quint32 compressedSize = compressed.size();
+    quint32 rawSize = m_flushBuffer.size();
+
+    m_file->write((char *)&compressedSize, sizeof(compressedSize));
+    m_file->write((char *)&rawSize, sizeof(rawSize));
+    m_file->write(compressed);
+
+    m_fileOffset += LOG_ZBLOCK_HEADER_SIZE + compressed.size();
+}
+
 LogFile::LogFile(QObject *parent) :
     QIODevice(parent),
     m_lastTimeStamp(0),
     m_lastPlayed(0),
     m_timeOffset(0),
     m_playbackSpeed(1.0),
+    m_flushThread(NULL),
+    m_compressionEnabled(true),
+    m_compressedReplay(false),
+    m_mapBase(NULL),
+    m_mapSize(0),
+    m_mapPos(0),
+    m_dataEnd(0),
     m_nextTimeStamp(0),
     m_useProvidedTimeStamp(false)
 {
@@ -44,6 +211,26 @@ bool LogFile::open(OpenMode mode)
     // during a logfile replay. Read nature is checked upon write ops below.
     QIODevice::open(QIODevice::ReadWrite);
 
+    if (m_file.isWritable()) {
+        if (m_compressionEnabled) {
+            quint32 magic   = LOG_ZMAGIC;
+            quint32 version = LOG_ZVERSION;
+            m_file.write((char *)&magic, sizeof(magic));
+            m_file.write((char *)&version, sizeof(version));
+        }
+        // Flush the log on a dedicated thread so a slow disk stalls the
+        // flush thread instead of the telemetry thread.
+        m_flushThread = new LogFileFlushThread(&m_file, m_compressionEnabled);
+        m_flushThread->start();
+    } else {
+        // Map read-only logs into memory: replay and scrubbing then run
+        // over the OS page cache with no read syscalls or QFile buffer
+        // copies, and repeated scans are free after first touch.
+        m_mapBase = m_file.map(0, m_file.size());
+        m_mapSize = m_file.size();
+        m_mapPos  = 0;
+    }
+
     return true;
 }
 
@@ -54,12 +241,46 @@ void LogFile::close()
     if (m_timer.isActive()) {
         m_timer.stop();
     }
+
+    if (m_mapBase) {
+        m_file.unmap(m_mapBase);
+        m_mapBase = NULL;
+        m_mapSize = 0;
+        m_mapPos  = 0;
+    }
+
+    if (m_flushThread) {
+        m_flushThread->stop();
+        if (m_flushThread->droppedFrames() > 0) {
+            qDebug() << "Logging dropped" << m_flushThread->droppedFrames() << "frames ("
+                     << m_flushThread->droppedBytes() << "bytes), disk could not keep up";
+        }
+
+        // Append the seek index footer behind the frame data
+        QList<LogIndexEntry> indexEntries = m_flushThread->indexEntries();
+        if (!indexEntries.isEmpty()) {
+            foreach(const LogIndexEntry &entry, indexEntries) {
+                m_file.write((char *)&entry.timeStamp, sizeof(entry.timeStamp));
+                m_file.write((char *)&entry.offset, sizeof(entry.offset));
+            }
+            quint32 count = indexEntries.size();
+            quint32 magic = LOG_INDEX_MAGIC;
+            m_file.write((char *)&count, sizeof(count));
+            m_file.write((char *)&magic, sizeof(magic));
+        }
+
+        delete m_flushThread;
+        m_flushThread = NULL;
+    }
+
     m_file.close();
     QIODevice::close();
 }
 
 qint64 LogFile::writeData(const char *data, qint64 dataSize)
 {
+    GCS_TRACE_SCOPE("LogFile::writeData");
+
     if (!m_file.isWritable()) {
         return dataSize;
     }
@@ -68,13 +289,20 @@ qint64 LogFile::writeData(const char *data, qint64 dataSize)
     // This is used when saving logs from on-board logging
     quint32 timeStamp = m_useProvidedTimeStamp ? m_nextTimeStamp : m_myTime.elapsed();
 
-    m_file.write((char *)&timeStamp, sizeof(timeStamp));
-    m_file.write((char *)&dataSize, sizeof(dataSize));
+    // Assemble the frame (timestamp header plus data) in memory and hand it
+    // to the flush thread in one piece, so frames are never split by a drop.
+    QByteArray frame;
+    frame.reserve(sizeof(timeStamp) + sizeof(dataSize) + dataSize);
+    frame.append((char *)&timeStamp, sizeof(timeStamp));
+    frame.append((char *)&dataSize, sizeof(dataSize));
+    frame.append(data, (int)dataSize);
 
-    qint64 written = m_file.write(data, dataSize);
-    if (written != -1) {
-        emit bytesWritten(written);
+    if (m_flushThread) {
+        m_flushThread->append(frame.constData(), frame.size(), timeStamp);
+    } else {
+        m_file.write(frame);
     }
+    emit bytesWritten(dataSize);
 
     return dataSize;
 }
@@ -98,67 +326,307 @@ void LogFile::timerFired()
 {
     qint64 dataSize;
 
-    if (m_file.bytesAvailable() > 4) {
-        int time;
-        time = m_myTime.elapsed();
+    if (replayBytesRemaining() <= 4) {
+        stopReplay();
+        return;
+    }
 
-        // TODO: going back in time will be a problem
-        while ((m_lastPlayed + ((time - m_timeOffset) * m_playbackSpeed) > m_lastTimeStamp)) {
-            m_lastPlayed += ((time - m_timeOffset) * m_playbackSpeed);
-            if (m_file.bytesAvailable() < (qint64)sizeof(dataSize)) {
-                stopReplay();
-                return;
-            }
+    // Advance the virtual log clock by the wall time since the last
+    // tick, scaled by the playback speed. All frames the clock passed
+    // are queued in one batch with a single readyRead(), so high speeds
+    // cost one dispatch per tick instead of one per frame.
+    int time = m_myTime.elapsed();
+    m_lastPlayed += (time - m_timeOffset) * m_playbackSpeed;
+    m_timeOffset  = time;
 
-            m_file.read((char *)&dataSize, sizeof(dataSize));
+    int framesQueued = 0;
+    bool endReplay   = false;
 
-            if (dataSize < 1 || dataSize > (1024 * 1024)) {
-                qDebug() << "Error: Logfile corrupted! Unlikely packet size: " << dataSize << "\n";
-                stopReplay();
-                return;
-            }
+    while ((m_lastTimeStamp <= m_lastPlayed) && (framesQueued < MAX_REPLAY_FRAMES_PER_TICK)) {
+        if (replayBytesRemaining() < (qint64)sizeof(dataSize)) {
+            endReplay = true;
+            break;
+        }
 
-            if (m_file.bytesAvailable() < dataSize) {
-                stopReplay();
-                return;
-            }
+        if (!replayRead((char *)&dataSize, sizeof(dataSize))) {
+            endReplay = true;
+            break;
+        }
 
-            m_mutex.lock();
-            m_dataBuffer.append(m_file.read(dataSize));
-            m_mutex.unlock();
+        if (dataSize < 1 || dataSize > (1024 * 1024)) {
+            qDebug() << "Error: Logfile corrupted! Unlikely packet size: " << dataSize << "\n";
+            endReplay = true;
+            break;
+        }
 
-            emit readyRead();
+        if (replayBytesRemaining() < dataSize) {
+            endReplay = true;
+            break;
+        }
 
-            if (m_file.bytesAvailable() < (qint64)sizeof(m_lastTimeStamp)) {
-                stopReplay();
-                return;
-            }
+        QByteArray frameData((int)dataSize, 0);
+        if (!replayRead(frameData.data(), dataSize)) {
+            endReplay = true;
+            break;
+        }
+        m_mutex.lock();
+        m_dataBuffer.append(frameData);
+        m_mutex.unlock();
+        framesQueued++;
 
-            int save = m_lastTimeStamp;
-            m_file.read((char *)&m_lastTimeStamp, sizeof(m_lastTimeStamp));
-            // some validity checks
-            if (m_lastTimeStamp < save // logfile goes back in time
-                || (m_lastTimeStamp - save) > (60 * 60 * 1000)) { // gap of more than 60 minutes)
-                qDebug() << "Error: Logfile corrupted! Unlikely timestamp " << m_lastTimeStamp << " after " << save << "\n";
-                stopReplay();
-                return;
-            }
+        if (replayBytesRemaining() < (qint64)sizeof(m_lastTimeStamp)) {
+            endReplay = true;
+            break;
+        }
 
-            m_timeOffset = time;
-            time = m_myTime.elapsed();
+        int save = m_lastTimeStamp;
+        if (!replayRead((char *)&m_lastTimeStamp, sizeof(m_lastTimeStamp))) {
+            endReplay = true;
+            break;
         }
-    } else {
+        // some validity checks
+        if (m_lastTimeStamp < save // logfile goes back in time
+            || (m_lastTimeStamp - save) > (60 * 60 * 1000)) { // gap of more than 60 minutes)
+            qDebug() << "Error: Logfile corrupted! Unlikely timestamp " << m_lastTimeStamp << " after " << save << "\n";
+            endReplay = true;
+            break;
+        }
+    }
+
+    // deliver the batch before ending the replay, so the last frames of
+    // the log are not lost behind the close
+    if (framesQueued > 0) {
+        emit readyRead();
+    }
+    if (endReplay) {
         stopReplay();
     }
 }
 
+/**
+ * Reads bytes of the log, from the memory mapping when the OS granted
+ * one and through QFile otherwise.
+ */
+bool LogFile::rawRead(char *data, qint64 size)
+{
+    if (m_mapBase) {
+        if (m_mapPos + size > m_mapSize) {
+            return false;
+        }
+        memcpy(data, m_mapBase + m_mapPos, size);
+        m_mapPos += size;
+        return true;
+    }
+    return m_file.read(data, size) == size;
+}
+
+void LogFile::rawSeek(qint64 pos)
+{
+    if (m_mapBase) {
+        m_mapPos = pos;
+    } else {
+        m_file.seek(pos);
+    }
+}
+
+/**
+ * Looks for the index footer at the end of the log and loads it. Without
+ * a footer (logs from older GCS versions) the whole file is frame data
+ * and seeking is unavailable. Also detects the compressed container by
+ * its header and leaves the file positioned on the first frame.
+ */
+void LogFile::loadReplayIndex()
+{
+    m_replayIndex.clear();
+    m_decodeBuffer.clear();
+    m_compressedReplay = false;
+    m_dataEnd = m_file.size();
+
+    if (m_file.size() >= (qint64)LOG_ZHEADER_SIZE) {
+        quint32 zmagic   = 0;
+        quint32 zversion = 0;
+        rawSeek(0);
+        rawRead((char *)&zmagic, sizeof(zmagic));
+        rawRead((char *)&zversion, sizeof(zversion));
+        m_compressedReplay = (zmagic == LOG_ZMAGIC) && (zversion == LOG_ZVERSION);
+    }
+    qint64 dataStart = m_compressedReplay ? LOG_ZHEADER_SIZE : 0;
+
+    if (m_file.size() < (qint64)LOG_INDEX_TRAILER_SIZE) {
+        rawSeek(dataStart);
+        return;
+    }
+
+    quint32 count = 0;
+    quint32 magic = 0;
+    rawSeek(m_file.size() - LOG_INDEX_TRAILER_SIZE);
+    rawRead((char *)&count, sizeof(count));
+    rawRead((char *)&magic, sizeof(magic));
+
+    qint64 indexStart = m_file.size() - LOG_INDEX_TRAILER_SIZE - (qint64)count * LOG_INDEX_ENTRY_SIZE;
+    if ((magic != LOG_INDEX_MAGIC) || (count == 0) || (indexStart < dataStart)) {
+        rawSeek(dataStart);
+        return;
+    }
+
+    rawSeek(indexStart);
+    for (quint32 i = 0; i < count; i++) {
+        LogIndexEntry entry;
+        rawRead((char *)&entry.timeStamp, sizeof(entry.timeStamp));
+        rawRead((char *)&entry.offset, sizeof(entry.offset));
+        m_replayIndex.append(entry);
+    }
+    m_dataEnd = indexStart;
+    rawSeek(dataStart);
+}
+
+/**
+ * Inflates the next block of a compressed log into the decode buffer.
+ */
+bool LogFile::decodeNextBlock()
+{
+    quint32 compressedSize = 0;
+    quint32 rawSize = 0;
+
+    if (m_dataEnd - rawPos() < (qint64)LOG_ZBLOCK_HEADER_SIZE) {
+        return false;
+    }
+    rawRead((char *)&compressedSize, sizeof(compressedSize));
+    rawRead((char *)&rawSize, sizeof(rawSize));
+
+    if ((compressedSize < 1) || (compressedSize > (quint32)(2 * MAX_REPLAY_BLOCK_SIZE))
+        || (rawSize < 1) || (rawSize > (quint32)MAX_REPLAY_BLOCK_SIZE)
+        || (m_dataEnd - rawPos() < compressedSize)) {
+        qDebug() << "Error: Logfile corrupted! Unlikely block size: " << compressedSize << "\n";
+        return false;
+    }
+
+    // inflate straight out of the mapping when there is one
+    QByteArray compressedData;
+    if (m_mapBase) {
+        compressedData = QByteArray::fromRawData((const char *)(m_mapBase + m_mapPos), compressedSize);
+        m_mapPos += compressedSize;
+    } else {
+        compressedData = m_file.read(compressedSize);
+    }
+    QByteArray raw = qUncompress(compressedData);
+    if (raw.size() != (int)rawSize) {
+        qDebug() << "Error: Logfile corrupted! Block does not inflate to " << rawSize << "\n";
+        return false;
+    }
+
+    m_decodeBuffer.append(raw);
+    return true;
+}
+
+/**
+ * Reads from the replay frame stream: straight from the file for a raw
+ * log, through the block decoder for a compressed one.
+ */
+bool LogFile::replayRead(char *data, qint64 size)
+{
+    if (!m_compressedReplay) {
+        return rawRead(data, size);
+    }
+
+    while (m_decodeBuffer.size() < size) {
+        if (!decodeNextBlock()) {
+            return false;
+        }
+    }
+    memcpy(data, m_decodeBuffer.constData(), size);
+    m_decodeBuffer.remove(0, (int)size);
+    return true;
+}
+
+/**
+ * Seeks the replay to the last sync point at or before the given log
+ * timestamp. O(log n) in the number of sync points, so scrubbing a
+ * multi-hour log in either direction stays cheap.
+ */
+bool LogFile::seekReplay(quint32 timeStampMs)
+{
+    if (m_replayIndex.isEmpty() || !m_file.isOpen()) {
+        return false;
+    }
+
+    // binary search for the last entry with timeStamp <= timeStampMs
+    int lo = 0;
+    int hi = m_replayIndex.size() - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (m_replayIndex.at(mid).timeStamp <= timeStampMs) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_dataBuffer.clear();
+    m_decodeBuffer.clear();
+
+    // sync points sit on block starts, so the decoder picks up cleanly
+    rawSeek(m_replayIndex.at(lo).offset);
+    if (!replayRead((char *)&m_lastTimeStamp, sizeof(m_lastTimeStamp))) {
+        return false;
+    }
+    m_lastPlayed = m_lastTimeStamp;
+    m_timeOffset = m_myTime.elapsed();
+
+    return true;
+}
+
+/**
+ * Prepares sequential frame reading outside of a timed replay. Detects
+ * the compressed container and skips the index footer like a replay
+ * does, but leaves the timer alone so frames can be pulled in a tight
+ * loop over the memory mapping.
+ */
+bool LogFile::startBulkRead()
+{
+    if (!m_file.isOpen() || m_file.isWritable()) {
+        return false;
+    }
+    m_dataBuffer.clear();
+    m_decodeBuffer.clear();
+    loadReplayIndex();
+    return true;
+}
+
+/**
+ * Reads the next frame of the log. Returns false at the end of the
+ * frame data or when the log is corrupted.
+ */
+bool LogFile::readNextFrame(quint32 &timeStamp, QByteArray &data)
+{
+    qint64 dataSize = 0;
+
+    if (replayBytesRemaining() < (qint64)(sizeof(timeStamp) + sizeof(dataSize))) {
+        return false;
+    }
+    if (!replayRead((char *)&timeStamp, sizeof(timeStamp))) {
+        return false;
+    }
+    if (!replayRead((char *)&dataSize, sizeof(dataSize))) {
+        return false;
+    }
+    if ((dataSize < 1) || (dataSize > (1024 * 1024)) || (replayBytesRemaining() < dataSize)) {
+        qDebug() << "Error: Logfile corrupted! Unlikely packet size: " << dataSize << "\n";
+        return false;
+    }
+    data.resize((int)dataSize);
+    return replayRead(data.data(), dataSize);
+}
+
 bool LogFile::startReplay()
 {
     m_dataBuffer.clear();
     m_myTime.restart();
     m_timeOffset = 0;
     m_lastPlayed = 0;
-    m_file.read((char *)&m_lastTimeStamp, sizeof(m_lastTimeStamp));
+    loadReplayIndex();
+    replayRead((char *)&m_lastTimeStamp, sizeof(m_lastTimeStamp));
     m_timer.setInterval(10);
     m_timer.start();
     emit replayStarted();
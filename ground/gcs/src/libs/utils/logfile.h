@@ -5,11 +5,88 @@
 #include <QTime>
 #include <QTimer>
 #include <QMutexLocker>
+#include <QWaitCondition>
+#include <QThread>
 #include <QDebug>
 #include <QBuffer>
 #include <QFile>
 #include "utils_global.h"
 
+// ! One sync point of the log index: where the frame at this timestamp starts
+struct LogIndexEntry {
+    quint32 timeStamp;
+    qint64  offset;
+};
+
+/**
+ * Writes the log to disk on its own thread so the caller never blocks
+ * on the filesystem.
+ *
+ * The caller appends complete frames to a fill buffer, the thread swaps
+ * it against a flush buffer and writes the whole segment in one go, so
+ * the disk sees large sequential writes instead of three small ones per
+ * frame. If the disk stalls long enough for the fill buffer to hit its
+ * cap, whole frames are dropped and counted, which keeps the stream
+ * parseable on replay.
+ */
+class QTCREATOR_UTILS_EXPORT LogFileFlushThread : public QThread {
+    Q_OBJECT
+public:
+    LogFileFlushThread(QFile *file, bool compress);
+
+    void append(const char *data, qint64 dataSize, quint32 timeStamp);
+    // ! Flushes the remaining data and joins the thread
+    void stop();
+
+    // ! The timestamp/offset index of the accepted frames, valid after stop()
+    QList<LogIndexEntry> indexEntries() const
+    {
+        return m_indexEntries;
+    }
+
+    qint64 bytesBuffered() const;
+    qint64 droppedBytes() const
+    {
+        return m_droppedBytes;
+    }
+    int droppedFrames() const
+    {
+        return m_droppedFrames;
+    }
+
+protected:
+    void run();
+
+private:
+    // Cap on the amount of data waiting for the disk before frames get dropped
+    static const int MAX_BUFFER_SIZE = 1024 * 1024;
+    // Minimum timestamp distance between two index sync points
+    static const quint32 INDEX_PERIOD_MS = 1000;
+    // Preferred amount of frame data per compressed block
+    static const int MIN_BLOCK_SIZE = 64 * 1024;
+    // How long a partial block may sit in memory before it is flushed anyway
+    static const unsigned long BLOCK_FLUSH_TIMEOUT_MS = 1000;
+
+    void writeBlock(quint32 segmentTimeStamp);
+
+    QFile *m_file;
+    bool m_compress;
+    QByteArray m_fillBuffer;
+    QByteArray m_flushBuffer;
+    mutable QMutex m_bufferMutex;
+    QWaitCondition m_dataAvailable;
+    bool m_stop;
+    qint64 m_droppedBytes;
+    int m_droppedFrames;
+
+    QList<LogIndexEntry> m_indexEntries;
+    qint64 m_acceptedBytes;
+    // file offset of the next compressed block and timestamp of the first
+    // frame waiting in the fill buffer
+    qint64 m_fileOffset;
+    quint32 m_fillFirstTimeStamp;
+};
+
 class QTCREATOR_UTILS_EXPORT LogFile : public QIODevice {
     Q_OBJECT
 public:
@@ -17,7 +94,7 @@ public:
     qint64 bytesAvailable() const;
     qint64 bytesToWrite() const
     {
-        return m_file.bytesToWrite();
+        return m_file.bytesToWrite() + (m_flushThread ? m_flushThread->bytesBuffered() : 0);
     };
     bool open(OpenMode mode);
     void setFileName(QString name)
@@ -28,8 +105,39 @@ public:
     qint64 writeData(const char *data, qint64 dataSize);
     qint64 readData(char *data, qint64 maxlen);
 
+    // ! Must be called before open(), compressed logs need a current GCS to replay
+    void setCompressionEnabled(bool enabled)
+    {
+        m_compressionEnabled = enabled;
+    }
+
+    // frames dropped because the disk could not keep up with the telemetry
+    qint64 droppedBytes() const
+    {
+        return m_flushThread ? m_flushThread->droppedBytes() : 0;
+    }
+    int droppedFrames() const
+    {
+        return m_flushThread ? m_flushThread->droppedFrames() : 0;
+    }
+
     bool startReplay();
     bool stopReplay();
+    // ! Bulk sequential frame access for indexers and converters: no replay
+    // ! clock, frames come as fast as they decode. Call after open(ReadOnly).
+    bool startBulkRead();
+    bool readNextFrame(quint32 &timeStamp, QByteArray &data);
+    // ! Jumps to the sync point at or before the given log timestamp, needs an indexed log
+    bool seekReplay(quint32 timeStampMs);
+    bool hasReplayIndex() const
+    {
+        return !m_replayIndex.isEmpty();
+    }
+    // ! Timestamp of the last sync point, an estimate of the log length
+    quint32 replayDuration() const
+    {
+        return m_replayIndex.isEmpty() ? 0 : m_replayIndex.last().timeStamp;
+    }
     void useProvidedTimeStamp(bool useProvidedTimeStamp)
     {
         m_useProvidedTimeStamp = useProvidedTimeStamp;
@@ -71,6 +179,34 @@ protected:
     double m_playbackSpeed;
 
 private:
+    void loadReplayIndex();
+    bool replayRead(char *data, qint64 size);
+    bool decodeNextBlock();
+    // raw log byte access, through the memory mapping when one exists
+    bool rawRead(char *data, qint64 size);
+    void rawSeek(qint64 pos);
+    qint64 rawPos() const
+    {
+        return m_mapBase ? m_mapPos : m_file.pos();
+    }
+    qint64 replayBytesRemaining() const
+    {
+        return (m_dataEnd - rawPos()) + m_decodeBuffer.size();
+    }
+
+    LogFileFlushThread *m_flushThread;
+    bool m_compressionEnabled;
+    // replay side of a compressed log: frames already inflated from blocks
+    bool m_compressedReplay;
+    QByteArray m_decodeBuffer;
+    // memory mapped view of a read-only log, NULL when the mapping failed
+    uchar *m_mapBase;
+    qint64 m_mapSize;
+    qint64 m_mapPos;
+    // timestamp->offset index loaded from the log footer, empty for unindexed logs
+    QList<LogIndexEntry> m_replayIndex;
+    // where the frame data ends and the index footer starts
+    qint64 m_dataEnd;
     quint32 m_nextTimeStamp;
     bool m_useProvidedTimeStamp;
 };
@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ *
+ * @file       qmlcache.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @brief      Persistent compiled QML cache setup
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "qmlcache.h"
+
+#include "pathutils.h"
+
+#include <QDir>
+#include <QDebug>
+
+namespace Utils {
+void InitializeQmlCache()
+{
+    static bool initialized = false;
+
+    if (initialized) {
+        return;
+    }
+    initialized = true;
+
+    QString cachePath = GetStoragePath() + "qmlcache";
+
+    QDir().mkpath(cachePath);
+
+    // Qt compiles QML to bytecode the first time a scene is loaded and
+    // reuses the cached bytecode for every later engine and session.
+    // Keep the cache with the other GCS caches rather than in the
+    // per-user default location (older Qt versions ignore this and
+    // compile from source every time).
+    qputenv("QML_DISK_CACHE_PATH", cachePath.toLatin1());
+
+    qDebug() << "Utils::InitializeQmlCache - using QML disk cache" << cachePath;
+}
+}
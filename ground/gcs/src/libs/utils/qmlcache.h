@@ -1,11 +1,11 @@
 /**
  ******************************************************************************
  *
- * @file       trailitem.cpp
- * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
- * @brief      A graphicsItem representing a trail point
+ * @file       qmlcache.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @brief      Persistent compiled QML cache setup
  * @see        The GNU Public License (GPL) Version 3
- * @defgroup   OPMapWidget
+ * @defgroup
  * @{
  *
  *****************************************************************************/
@@ -24,25 +24,16 @@
  * with this program; if not, write to the Free Software Foundation, Inc.,
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
-#include "traillineitem.h"
 
-namespace mapcontrol {
-TrailLineItem::TrailLineItem(internals::PointLatLng const & coord1, internals::PointLatLng const & coord2, QBrush color, MapGraphicItem *map) : QGraphicsLineItem(map), coord1(coord1), coord2(coord2), m_brush(color), m_map(map)
-{
-    QPen pen;
+#ifndef QMLCACHE_H
+#define QMLCACHE_H
 
-    pen.setBrush(m_brush);
-    pen.setWidth(1);
-    this->setPen(pen);
-}
+#include "utils_global.h"
 
-int TrailLineItem::type() const
-{
-    return Type;
+namespace Utils {
+// ! Point the QML engine disk cache at the GCS storage path so compiled
+// ! scenes are shared by all engines and persist across sessions.
+QTCREATOR_UTILS_EXPORT void InitializeQmlCache();
 }
 
-void TrailLineItem::setLineSlot()
-{
-    setLine(m_map->FromLatLngToLocal(this->coord1).X(), m_map->FromLatLngToLocal(this->coord1).Y(), m_map->FromLatLngToLocal(this->coord2).X(), m_map->FromLatLngToLocal(this->coord2).Y());
-}
-}
+#endif // QMLCACHE_H
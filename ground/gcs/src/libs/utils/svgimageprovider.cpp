@@ -32,6 +32,20 @@
 #include <QUrl>
 #include <QFileInfo>
 #include <QSvgRenderer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+
+// Process wide raster cache shared by all provider instances, so gadgets
+// showing the same assets (dials, PFD) rasterize a given (file, element,
+// parameters, size) combination only once and share the result instead of
+// each keeping their own copy. Image requests can come in from the QML
+// image loader threads of several engines, hence the lock.
+static QMutex s_rasterCacheMutex;
+static QHash<QString, QPair<QImage, QSize> > s_rasterCache;
+// interactive resizes go through many intermediate sizes, keep a lid on it
+static const int maxCachedRasters = 128;
 
 SvgImageProvider::SvgImageProvider(const QString &basePath) :
     QQuickImageProvider(QQuickImageProvider::Image),
@@ -125,6 +139,18 @@ QImage SvgImageProvider::requestImage(const QString &id, QSize *size, const QSiz
         *size = QSize();
     }
 
+    QString cacheKey = QString("%1@%2x%3").arg(id).arg(requestedSize.width()).arg(requestedSize.height());
+    {
+        QMutexLocker locker(&s_rasterCacheMutex);
+        QHash<QString, QPair<QImage, QSize> >::const_iterator it = s_rasterCache.constFind(cacheKey);
+        if (it != s_rasterCache.constEnd()) {
+            if (size) {
+                *size = it.value().second;
+            }
+            return it.value().first;
+        }
+    }
+
     QSvgRenderer *renderer = loadRenderer(svgFile);
     if (!renderer) {
         return QImage();
@@ -188,6 +214,8 @@ QImage SvgImageProvider::requestImage(const QString &id, QSize *size, const QSiz
             *size = QSize(w, h);
         }
 
+        cacheImage(cacheKey, img, QSize(w, h));
+
         // img.save(element+parameters+".png");
         return img;
     } else {
@@ -208,10 +236,23 @@ QImage SvgImageProvider::requestImage(const QString &id, QSize *size, const QSiz
         if (size) {
             *size = QSize(w, h);
         }
+
+        cacheImage(cacheKey, img, QSize(w, h));
+
         return img;
     }
 }
 
+void SvgImageProvider::cacheImage(const QString &cacheKey, const QImage &image, const QSize &size)
+{
+    QMutexLocker locker(&s_rasterCacheMutex);
+
+    if (s_rasterCache.count() >= maxCachedRasters) {
+        s_rasterCache.clear();
+    }
+    s_rasterCache.insert(cacheKey, qMakePair(image, size));
+}
+
 QPixmap SvgImageProvider::requestPixmap(const QString &id, QSize *size, const QSize &requestedSize)
 {
     return QPixmap::fromImage(requestImage(id, size, requestedSize));
@@ -48,6 +48,7 @@ public:
 
 private:
     QSvgRenderer *loadRenderer(const QString &svgFile);
+    static void cacheImage(const QString &cacheKey, const QImage &image, const QSize &size);
 
     QMap<QString, QSvgRenderer *> m_renderers;
     QString m_basePath;
@@ -0,0 +1,165 @@
+/**
+ ******************************************************************************
+ *
+ * @file       tracer.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @brief      Lightweight in-process span tracing with chrome://tracing export
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "tracer.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThreadStorage>
+#include <QtCore/QVector>
+#include <QtCore/QCoreApplication>
+
+namespace Utils {
+QAtomicInt Tracer::enabledFlag;
+
+namespace {
+struct TraceEvent {
+    const char *name;
+    qint64 beginNs;
+    qint64 endNs;
+};
+
+// Each thread appends to its own buffer, so recording takes no lock. The
+// registry of buffers is only locked when a thread records its first span
+// and during clear/export, which happen while tracing is idle.
+struct TraceBuffer {
+    TraceBuffer();
+    ~TraceBuffer();
+
+    // ~3 MB per thread; recording stops when full rather than growing
+    // unboundedly during a long session
+    static const int CAPACITY = 1 << 17;
+
+    int tid;
+    QVector<TraceEvent> events;
+    quint64 dropped;
+};
+
+QMutex registryMutex;
+QList<TraceBuffer *> registry;
+int nextTid = 1;
+
+struct TraceClock {
+    TraceClock()
+    {
+        timer.start();
+    }
+    QElapsedTimer timer;
+};
+TraceClock traceClock;
+
+QThreadStorage<TraceBuffer *> threadBuffer;
+
+TraceBuffer::TraceBuffer() : dropped(0)
+{
+    events.reserve(CAPACITY);
+    QMutexLocker locker(&registryMutex);
+    tid = nextTid++;
+    registry.append(this);
+}
+
+TraceBuffer::~TraceBuffer()
+{
+    QMutexLocker locker(&registryMutex);
+
+    registry.removeAll(this);
+}
+} // anonymous namespace
+
+void Tracer::setEnabled(bool enabled)
+{
+    enabledFlag.store(enabled ? 1 : 0);
+}
+
+void Tracer::clear()
+{
+    QMutexLocker locker(&registryMutex);
+
+    foreach(TraceBuffer * buffer, registry) {
+        buffer->events.clear();
+        buffer->dropped = 0;
+    }
+}
+
+qint64 Tracer::nowNs()
+{
+    return traceClock.timer.nsecsElapsed();
+}
+
+void Tracer::recordSpan(const char *name, qint64 beginNs, qint64 endNs)
+{
+    if (!threadBuffer.hasLocalData()) {
+        threadBuffer.setLocalData(new TraceBuffer());
+    }
+    TraceBuffer *buffer = threadBuffer.localData();
+    if (buffer->events.size() >= TraceBuffer::CAPACITY) {
+        ++buffer->dropped;
+        return;
+    }
+    TraceEvent event;
+    event.name    = name;
+    event.beginNs = beginNs;
+    event.endNs   = endNs;
+    buffer->events.append(event);
+}
+
+/**
+ * Trace Event Format, complete events ("ph":"X") with microsecond
+ * timestamps, one tid per GCS thread. Meant to be called with tracing
+ * already disabled so the buffers are quiescent.
+ */
+bool Tracer::exportTo(const QString &fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QMutexLocker locker(&registryMutex);
+    file.write("{\"traceEvents\":[\n");
+    bool first = true;
+    foreach(TraceBuffer * buffer, registry) {
+        foreach(const TraceEvent &event, buffer->events) {
+            QString line = QString("%1{\"name\":\"%2\",\"ph\":\"X\",\"pid\":1,\"tid\":%3,"
+                                   "\"ts\":%4,\"dur\":%5}")
+                           .arg(first ? "" : ",\n")
+                           .arg(QLatin1String(event.name))
+                           .arg(buffer->tid)
+                           .arg(event.beginNs / 1000)
+                           .arg((event.endNs - event.beginNs) / 1000);
+            file.write(line.toUtf8());
+            first = false;
+        }
+    }
+    file.write("\n]}\n");
+    return true;
+}
+} // namespace Utils
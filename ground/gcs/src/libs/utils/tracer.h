@@ -0,0 +1,89 @@
+/**
+ ******************************************************************************
+ *
+ * @file       tracer.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @brief      Lightweight in-process span tracing with chrome://tracing export
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include "utils_global.h"
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QString>
+
+namespace Utils {
+/**
+ * Scoped span tracing for the GCS hot paths. Spans go to a per-thread
+ * buffer (no lock and no allocation on the hot path once the buffer
+ * exists), so the overhead while disabled is one atomic load per scope.
+ *
+ * Intended use: enable, reproduce the stutter, disable, export. The
+ * export file loads into chrome://tracing (or any Trace Event Format
+ * viewer) as one timeline per thread.
+ *
+ * Span names must be string literals; only the pointer is stored.
+ */
+class QTCREATOR_UTILS_EXPORT Tracer {
+public:
+    static bool isEnabled()
+    {
+        return enabledFlag.load() != 0;
+    }
+    static void setEnabled(bool enabled);
+    static void clear();
+
+    /** Write all recorded spans as chrome://tracing JSON. */
+    static bool exportTo(const QString &fileName);
+
+    static qint64 nowNs();
+    static void recordSpan(const char *name, qint64 beginNs, qint64 endNs);
+
+private:
+    static QAtomicInt enabledFlag;
+};
+
+/** RAII span, see GCS_TRACE_SCOPE. */
+class QTCREATOR_UTILS_EXPORT TraceScope {
+public:
+    TraceScope(const char *name)
+        : m_name(name), m_beginNs(Tracer::isEnabled() ? Tracer::nowNs() : -1)
+    {}
+    ~TraceScope()
+    {
+        if (m_beginNs >= 0) {
+            Tracer::recordSpan(m_name, m_beginNs, Tracer::nowNs());
+        }
+    }
+
+private:
+    const char *m_name;
+    qint64 m_beginNs;
+};
+} // namespace Utils
+
+/** Trace the enclosing scope under the given literal name. */
+#define GCS_TRACE_SCOPE(name) Utils::TraceScope gcsTraceScope_(name)
+
+#endif // TRACER_H
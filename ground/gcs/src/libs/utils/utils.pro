@@ -52,11 +52,13 @@ SOURCES += \
     mytabbedstackwidget.cpp \
     mytabwidget.cpp \
     quickwidgetproxy.cpp \
+    qmlcache.cpp \
     svgimageprovider.cpp \
     hostosinfo.cpp \
     logfile.cpp \
     crc.cpp \
     mustache.cpp \
+    tracer.cpp \
     textbubbleslider.cpp
 
 
@@ -116,11 +118,13 @@ HEADERS += \
     mytabbedstackwidget.h \
     mytabwidget.h \
     quickwidgetproxy.h \
+    qmlcache.h \
     svgimageprovider.h \
     hostosinfo.h \
     logfile.h \
     crc.h \
     mustache.h \
+    tracer.h \
     textbubbleslider.h \
     filelogger.h
 
@@ -148,6 +148,20 @@ const double CoeffFile[91][6] = {
 };
 
 namespace Utils {
+// The model is queried through short lived instances (see HomeLocationUtil),
+// so the caches are kept at file scope to survive between calls. All callers
+// run on the GUI thread.
+static bool s_resultValid = false;
+static double s_resultLLA[3];
+static int s_resultMonth;
+static int s_resultDay;
+static int s_resultYear;
+static double s_resultBe[3];
+
+static bool s_legendreValid = false;
+static double s_legendreSinPhi;
+static WMMtype_LegendreFunction s_legendreCache;
+
 WorldMagModel::WorldMagModel()
 {
     Initialize();
@@ -185,6 +199,20 @@ int WorldMagModel::GetMagVector(double LLA[3], int Month, int Day, int Year, dou
     }
     // ***********
 
+    // Fast path for repeated queries at essentially the same point and date,
+    // which is what the calibration wizard and the home location code do.
+    // The field gradient over ~100m is well below the model accuracy.
+    if (s_resultValid
+        && (Month == s_resultMonth) && (Day == s_resultDay) && (Year == s_resultYear)
+        && (fabs(Lat - s_resultLLA[0]) < 1.0e-3)
+        && (fabs(Lon - s_resultLLA[1]) < 1.0e-3)
+        && (fabs(LLA[2] - s_resultLLA[2]) < 100.0)) {
+        Be[0] = s_resultBe[0];
+        Be[1] = s_resultBe[1];
+        Be[2] = s_resultBe[2];
+        return 0; // OK
+    }
+
     WMMtype_CoordSpherical CoordSpherical;
     WMMtype_CoordGeodetic CoordGeodetic;
     WMMtype_GeoMagneticElements GeoMagneticElements;
@@ -210,6 +238,18 @@ int WorldMagModel::GetMagVector(double LLA[3], int Month, int Day, int Year, dou
     Be[1] = GeoMagneticElements.Y * 1e-2;
     Be[2] = GeoMagneticElements.Z * 1e-2;
 
+    // remember the full result for the fast path above
+    s_resultLLA[0] = Lat;
+    s_resultLLA[1] = Lon;
+    s_resultLLA[2] = LLA[2];
+    s_resultMonth  = Month;
+    s_resultDay    = Day;
+    s_resultYear   = Year;
+    s_resultBe[0]  = Be[0];
+    s_resultBe[1]  = Be[1];
+    s_resultBe[2]  = Be[2];
+    s_resultValid  = true;
+
     // ***********
 
     return 0; // OK
@@ -358,6 +398,14 @@ int WorldMagModel::AssociatedLegendreFunction(WMMtype_CoordSpherical *CoordSpher
 
     double sin_phi = sin(DEG2RAD(CoordSpherical->phig)); // sin  (geocentric latitude)
 
+    // The recurrences only depend on the latitude, so queries in the same
+    // latitude band (different longitude/radius/date) reuse the last values
+    // instead of re-running the recursion with its square root per term.
+    if (s_legendreValid && (fabs(sin_phi - s_legendreSinPhi) < 1.0e-12)) {
+        *LegendreFunction = s_legendreCache;
+        return 0; // OK
+    }
+
     if (nMax <= 16 || (1 - fabs(sin_phi)) < 1.0e-10) { /* If nMax is less tha 16 or at the poles */
         PcupLow(LegendreFunction->Pcup, LegendreFunction->dPcup, sin_phi, nMax);
     } else {
@@ -366,6 +414,10 @@ int WorldMagModel::AssociatedLegendreFunction(WMMtype_CoordSpherical *CoordSpher
         }
     }
 
+    s_legendreCache  = *LegendreFunction;
+    s_legendreSinPhi = sin_phi;
+    s_legendreValid  = true;
+
     return 0; // OK
 }
 
@@ -39,9 +39,16 @@
 #include <QSize>
 #include <QPoint>
 #include <QtCore/QUrl>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFileDevice>
+#include <QtCore/QFile>
 
 #define NUM_PREFIX "arr_"
 
+// binary sidecar next to the XML file, keyed by a hash of the XML content
+static const quint32 cacheMagic   = 0x47435358; // "GCSX"
+static const quint32 cacheVersion = 1;
+
 QString XmlConfig::rootName = "gcs";
 
 const QSettings::Format XmlConfig::XmlSettingsFormat =
@@ -56,7 +63,17 @@ bool XmlConfig::readXmlFile(QIODevice &device, QSettings::SettingsMap &map)
     int errorLine;
     int errorColumn;
 
-    if (!domDoc.setContent(&device, true, &errorStr, &errorLine,
+    QByteArray contents = device.readAll();
+    QString cacheFile   = cacheFileName(device);
+
+    // The binary sidecar snapshots the parsed settings. Warm loads skip the
+    // DOM parse entirely as long as the XML content is unchanged; the XML
+    // file itself remains the authoritative interchange format.
+    if (readCacheFile(cacheFile, contents, map)) {
+        return true;
+    }
+
+    if (!domDoc.setContent(contents, true, &errorStr, &errorLine,
                            &errorColumn)) {
         QString err = QString(tr("GCS config")) +
                       tr("Parse error at line %1, column %2:\n%3")
@@ -69,9 +86,69 @@ bool XmlConfig::readXmlFile(QIODevice &device, QSettings::SettingsMap &map)
     root = domDoc.documentElement();
     handleNode(&root, map);
 
+    writeCacheFile(cacheFile, contents, map);
+    return true;
+}
+
+QString XmlConfig::cacheFileName(QIODevice &device)
+{
+    // QSettings hands us a QFile on read and a QSaveFile on write,
+    // both carry the name of the settings file
+    QFileDevice *file = qobject_cast<QFileDevice *>(&device);
+
+    if (!file || file->fileName().isEmpty()) {
+        return QString();
+    }
+    return file->fileName() + QLatin1String(".cache");
+}
+
+bool XmlConfig::readCacheFile(const QString &fileName, const QByteArray &contents, QSettings::SettingsMap &map)
+{
+    if (fileName.isEmpty()) {
+        return false;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_8);
+    quint32 magic   = 0;
+    quint32 version = 0;
+    QByteArray sourceHash;
+    in >> magic >> version >> sourceHash;
+    // a hand edited (or otherwise changed) XML file invalidates the cache
+    if ((magic != cacheMagic) || (version != cacheVersion)
+        || (sourceHash != QCryptographicHash::hash(contents, QCryptographicHash::Md5))) {
+        return false;
+    }
+    QSettings::SettingsMap cachedMap;
+    in >> cachedMap;
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+    map = cachedMap;
     return true;
 }
 
+void XmlConfig::writeCacheFile(const QString &fileName, const QByteArray &contents, const QSettings::SettingsMap &map)
+{
+    if (fileName.isEmpty()) {
+        return;
+    }
+    QFile file(fileName);
+    // the cache is best effort, a failure here just means the next
+    // load falls back to parsing the XML
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_8);
+    out << cacheMagic << cacheVersion
+        << QCryptographicHash::hash(contents, QCryptographicHash::Md5);
+    out << map;
+}
+
 void XmlConfig::handleNode(QDomElement *node, QSettings::SettingsMap &map, QString path)
 {
     if (!node) {
@@ -148,8 +225,11 @@ bool XmlConfig::writeXmlFile(QIODevice &device, const QSettings::SettingsMap &ma
         }
         node.appendChild(outDocument.createTextNode(variantToString(iter.value())));
     }
-    device.write(outDocument.toByteArray(2).constData());
+    QByteArray contents = outDocument.toByteArray(2);
+    device.write(contents);
 // qDebug() << "Dokument:\n" << outDocument.toByteArray(2).constData();
+    // refresh the sidecar so the next load takes the binary path
+    writeCacheFile(cacheFileName(device), contents, map);
 // qDebug() << "writeXmlFile end";
     return true;
 }
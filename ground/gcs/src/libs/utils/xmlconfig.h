@@ -49,6 +49,9 @@ public:
 private:
     static QString rootName;
 
+    static QString cacheFileName(QIODevice &device);
+    static bool readCacheFile(const QString &fileName, const QByteArray &contents, QSettings::SettingsMap &map);
+    static void writeCacheFile(const QString &fileName, const QByteArray &contents, const QSettings::SettingsMap &map);
     static void handleNode(QDomElement *node, QSettings::SettingsMap &map, QString path = "");
     static QSettings::SettingsMap settingsToMap(QSettings & qs);
     static QString variantToString(const QVariant &v);
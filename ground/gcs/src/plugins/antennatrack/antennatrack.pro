@@ -7,11 +7,10 @@ include(../../plugin.pri)
 include(../../plugins/coreplugin/coreplugin.pri)
 include(antennatrack_dependencies.pri)
 include(../../libs/qwt/qwt.pri)
+include(../gpsdisplay/gpsparsers.pri)
 
 HEADERS += \
     antennatrackplugin.h \
-    gpsparser.h \
-    telemetryparser.h \
     antennatrackgadget.h \
     antennatrackwidget.h \
     antennatrackgadgetfactory.h \
@@ -20,8 +19,6 @@ HEADERS += \
 
 SOURCES += \
     antennatrackplugin.cpp \
-    gpsparser.cpp \
-    telemetryparser.cpp \
     antennatrackgadget.cpp \
     antennatrackgadgetfactory.cpp \
     antennatrackwidget.cpp \
@@ -28,6 +28,7 @@
 #include "antennatrackgadget.h"
 #include "antennatrackwidget.h"
 #include "antennatrackgadgetconfiguration.h"
+#include "nmeaparser.h"
 #include <QtSerialPort/QSerialPortInfo>
 
 AntennaTrackGadget::AntennaTrackGadget(QString classId, AntennaTrackWidget *widget, QWidget *parent) :
@@ -77,8 +78,8 @@ void AntennaTrackGadget::loadConfiguration(IUAVGadgetConfiguration *config)
     foreach(QSerialPortInfo nport, ports) {
         if (nport.portName() == AntennaTrackConfig->port()) {
             qDebug() << "Using Serial port";
-            // parser = new NMEAParser();
-            port = new QSerialPort(nport);
+            parser = new NMEAParser();
+            port   = new QSerialPort(nport);
             m_widget->setPort(port);
             m_widget->connectButton->setEnabled(true);
             m_widget->disconnectButton->setEnabled(false);
@@ -89,8 +90,10 @@ void AntennaTrackGadget::loadConfiguration(IUAVGadgetConfiguration *config)
         }
     }
     m_widget->dataStreamGroupBox->setHidden(false);
-    qDebug() << "Using Telemetry parser";
-    parser = new TelemetryParser();
+    if (!parser) {
+        qDebug() << "Using Telemetry parser";
+        parser = new TelemetryParser();
+    }
 
     connect(parser, SIGNAL(position(double, double, double)), m_widget, SLOT(setPosition(double, double, double)));
     connect(parser, SIGNAL(home(double, double, double)), m_widget, SLOT(setHomePosition(double, double, double)));
@@ -149,11 +152,10 @@ void AntennaTrackGadget::onDataAvailable()
 
 void AntennaTrackGadget::processNewSerialData(QByteArray serialData)
 {
-    int dataLength   = serialData.size();
-    const char *data = serialData.constData();
-
     m_widget->textBrowser->append(QString(serialData));
-    for (int pos = 0; pos < dataLength; pos++) {
-        // parser->processInputStream(data[pos]);
+    if (parser) {
+        // bulk scan, complete sentences are dispatched in one pass and a
+        // trailing partial one is kept for the next read
+        parser->processInputBuffer(serialData.constData(), serialData.size());
     }
 }
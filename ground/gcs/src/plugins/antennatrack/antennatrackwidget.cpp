@@ -34,6 +34,16 @@
 #include <QtGui>
 #include <QDebug>
 
+namespace {
+// Below these deltas the pointing angles cannot move the tracker hardware
+// by a full step (0.9 degree stepper, 0.09 degree servo), so recomputing
+// them would only burn CPU.
+const double MIN_POSITION_DELTA_DEG = 2.0E-6; // ~0.2 m
+const double MIN_ALTITUDE_DELTA_M   = 1.0;
+// large sentinel so the first real update always goes through
+const double UNINITIALIZED = 1.0E9;
+}
+
 /*
  * Initialize the widget
  */
@@ -43,6 +53,17 @@ AntennaTrackWidget::AntennaTrackWidget(QWidget *parent) : QWidget(parent)
 
     azimuth_old   = 0;
     elevation_old = 0;
+
+    calcLat     = UNINITIALIZED;
+    calcLon     = UNINITIALIZED;
+    calcAlt     = UNINITIALIZED;
+    calcHomeLat = UNINITIALIZED;
+    calcHomeLon = UNINITIALIZED;
+    calcHomeAlt = UNINITIALIZED;
+    homeLatRad  = 0;
+    homeLonRad  = 0;
+    homeSinLat  = 0;
+    homeCosLat  = 1;
 }
 
 AntennaTrackWidget::~AntennaTrackWidget()
@@ -68,6 +89,19 @@ void AntennaTrackWidget::setPosition(double lat, double lon, double alt)
 {
     // lat *= 1E-7;
     // lon *= 1E-7;
+    TrackData.Latitude  = lat;
+    TrackData.Longitude = lon;
+    TrackData.Altitude  = alt;
+    if ((fabs(lat - calcLat) < MIN_POSITION_DELTA_DEG)
+        && (fabs(lon - calcLon) < MIN_POSITION_DELTA_DEG)
+        && (fabs(alt - calcAlt) < MIN_ALTITUDE_DELTA_M)) {
+        // the tracker cannot resolve a move this small
+        return;
+    }
+    calcLat = lat;
+    calcLon = lon;
+    calcAlt = alt;
+
     double deg = floor(fabs(lat));
     double min = (fabs(lat) - deg) * 60;
     QString str1;
@@ -92,9 +126,6 @@ void AntennaTrackWidget::setPosition(double lat, double lon, double alt)
     QString str3;
     str3.sprintf("%.2f m", alt);
     coord_value_3->setText(str3);
-    TrackData.Latitude  = lat;
-    TrackData.Longitude = lon;
-    TrackData.Altitude  = alt;
     calcAntennaPosition();
 }
 
@@ -102,6 +133,24 @@ void AntennaTrackWidget::setHomePosition(double lat, double lon, double alt)
 {
     // lat *= 1E-7;
     // lon *= 1E-7;
+    TrackData.HomeLatitude  = lat;
+    TrackData.HomeLongitude = lon;
+    TrackData.HomeAltitude  = alt;
+    if ((fabs(lat - calcHomeLat) < MIN_POSITION_DELTA_DEG)
+        && (fabs(lon - calcHomeLon) < MIN_POSITION_DELTA_DEG)
+        && (fabs(alt - calcHomeAlt) < MIN_ALTITUDE_DELTA_M)) {
+        return;
+    }
+    calcHomeLat = lat;
+    calcHomeLon = lon;
+    calcHomeAlt = alt;
+
+    // precompute the home trigonometry, it is constant until home moves
+    homeLatRad  = lat * (M_PI / 180);
+    homeLonRad  = lon * (M_PI / 180);
+    homeSinLat  = sin(homeLatRad);
+    homeCosLat  = cos(homeLatRad);
+
     double deg = floor(fabs(lat));
     double min = (fabs(lat) - deg) * 60;
     QString str1;
@@ -126,9 +175,6 @@ void AntennaTrackWidget::setHomePosition(double lat, double lon, double alt)
     QString str3;
     str3.sprintf("%.2f m", alt);
     bear_value->setText(str3);
-    TrackData.HomeLatitude  = lat;
-    TrackData.HomeLongitude = lon;
-    TrackData.HomeAltitude  = alt;
     calcAntennaPosition();
 }
 
@@ -141,9 +187,9 @@ void AntennaTrackWidget::calcAntennaPosition(void)
     double uavAlt = TrackData.Altitude; // UAV MSL altitude
     double dAlt   = uavAlt - gcsAlt; // Altitude difference
 
-    // Convert to radians
-    lat1 = TrackData.HomeLatitude * (M_PI / 180); // Home lat
-    lon1 = TrackData.HomeLongitude * (M_PI / 180); // Home lon
+    // Convert to radians, home side is precomputed in setHomePosition()
+    lat1 = homeLatRad; // Home lat
+    lon1 = homeLonRad; // Home lon
     lat2 = TrackData.Latitude * (M_PI / 180); // UAV lat
     lon2 = TrackData.Longitude * (M_PI / 180); // UAV lon
 
@@ -155,8 +201,8 @@ void AntennaTrackWidget::calcAntennaPosition(void)
        var brng = Math.atan2(y, x).toDeg();
      **/
     y    = sin(lon2 - lon1) * cos(lat2);
-    x    = cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(lon2 - lon1);
-    brng = atan2((sin(lon2 - lon1) * cos(lat2)), (cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(lon2 - lon1))) * (180 / M_PI);
+    x    = homeCosLat * sin(lat2) - homeSinLat * cos(lat2) * cos(lon2 - lon1);
+    brng = atan2(y, x) * (180 / M_PI);
     if (brng < 0) {
         brng += 360;
     }
@@ -176,7 +222,7 @@ void AntennaTrackWidget::calcAntennaPosition(void)
        var d = R * c;
      **/
     a = sin((lat2 - lat1) / 2) * sin((lat2 - lat1) / 2) +
-        cos(lat1) * cos(lat2) *
+        homeCosLat * cos(lat2) *
         sin((lon2 - lon1) / 2) * sin((lon2 - lon1) / 2);
     c = 2 * atan2(sqrt(a), sqrt(1 - a));
     d = 6371 * 1000 * c;
@@ -68,5 +68,14 @@ private:
     QPointer<QSerialPort> port;
     double azimuth_old;
     double elevation_old;
+
+    // inputs of the last pointing computation, used to skip recomputes for
+    // deltas too small to move the tracker hardware by a step
+    double calcLat, calcLon, calcAlt;
+    double calcHomeLat, calcHomeLon, calcHomeAlt;
+
+    // home trigonometry, precomputed when the home position changes
+    double homeLatRad, homeLonRad;
+    double homeSinLat, homeCosLat;
 };
 #endif /* ANTENNATRACKWIDGET_H_ */
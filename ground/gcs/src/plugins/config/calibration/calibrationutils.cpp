@@ -53,6 +53,16 @@ bool CalibrationUtils::EllipsoidCalibration(Eigen::VectorXf *samplesX, Eigen::Ve
 
     EllipsoidFit(samplesX, samplesY, samplesZ, &center, &radii, &evecs, fitAlongXYZ);
 
+    EllipsoidCalibrationFromFit(center, radii, evecs, nominalRange, result);
+    return true;
+}
+
+void CalibrationUtils::EllipsoidCalibrationFromFit(const Eigen::Vector3f &center,
+                                                   const Eigen::VectorXf &radii,
+                                                   const Eigen::MatrixXf &evecs,
+                                                   float nominalRange,
+                                                   EllipsoidCalibrationResult *result)
+{
     result->Scale.setZero();
 
     result->Scale << nominalRange / radii.coeff(0),
@@ -67,7 +77,6 @@ bool CalibrationUtils::EllipsoidCalibration(Eigen::VectorXf *samplesX, Eigen::Ve
     result->CalibrationMatrix = evecs * tmp * evecs.transpose();
     result->Bias.setZero();
     result->Bias << center.coeff(0), center.coeff(1), center.coeff(2);
-    return true;
 }
 
 bool CalibrationUtils::PolynomialCalibration(VectorXf *samplesX, Eigen::VectorXf *samplesY, int degree, Eigen::Ref<Eigen::VectorXf> result, const double maxRelativeError)
@@ -320,6 +329,14 @@ void CalibrationUtils::EllipsoidFit(Eigen::VectorXf *samplesX, Eigen::VectorXf *
     Eigen::MatrixXf dt2 = (D.transpose() * ones);
     Eigen::VectorXf v   = dt1.inverse() * dt2;
 
+    EllipsoidFromSolution(v, center, radii, evecs, fitAlongXYZ);
+}
+
+void CalibrationUtils::EllipsoidFromSolution(const Eigen::VectorXf &v,
+                                             Eigen::Vector3f *center,
+                                             Eigen::VectorXf *radii,
+                                             Eigen::MatrixXf *evecs, bool fitAlongXYZ)
+{
     if (!fitAlongXYZ) {
         Eigen::Matrix4f A;
         A << v.coeff(0), v.coeff(3), v.coeff(4), v.coeff(6),
@@ -356,6 +373,57 @@ void CalibrationUtils::EllipsoidFit(Eigen::VectorXf *samplesX, Eigen::VectorXf *
     }
 }
 
+EllipsoidFitAccumulator::EllipsoidFitAccumulator(bool fitAlongXYZ)
+{
+    clear(fitAlongXYZ);
+}
+
+void EllipsoidFitAccumulator::clear(bool fitAlongXYZ)
+{
+    int params = fitAlongXYZ ? 6 : 9;
+
+    m_fitAlongXYZ = fitAlongXYZ;
+    m_sampleCount = 0;
+    m_dtd.setZero(params, params);
+    m_dt1.setZero(params);
+}
+
+void EllipsoidFitAccumulator::addSample(float x, float y, float z)
+{
+    Eigen::VectorXd d(m_dt1.rows());
+
+    // same design rows as EllipsoidFit builds, one at a time
+    if (!m_fitAlongXYZ) {
+        d << (double)x * x, (double)y * y, (double)z * z,
+            2.0 * x * y, 2.0 * x * z, 2.0 * y * z,
+            2.0 * x, 2.0 * y, 2.0 * z;
+    } else {
+        d << (double)x * x, (double)y * y, (double)z * z,
+            2.0 * x, 2.0 * y, 2.0 * z;
+    }
+
+    m_dtd.noalias() += d * d.transpose();
+    m_dt1 += d;
+    m_sampleCount++;
+}
+
+bool EllipsoidFitAccumulator::calibrate(float nominalRange, CalibrationUtils::EllipsoidCalibrationResult *result) const
+{
+    // need at least as many samples as there are ellipsoid parameters
+    if (m_sampleCount < m_dt1.rows()) {
+        return false;
+    }
+
+    Eigen::VectorXf v = (m_dtd.inverse() * m_dt1).cast<float>();
+
+    Eigen::Vector3f center;
+    Eigen::VectorXf radii;
+    Eigen::MatrixXf evecs;
+    CalibrationUtils::EllipsoidFromSolution(v, &center, &radii, &evecs, m_fitAlongXYZ);
+    CalibrationUtils::EllipsoidCalibrationFromFit(center, radii, evecs, nominalRange, result);
+    return true;
+}
+
 int CalibrationUtils::SixPointInConstFieldCal(double ConstMag, double x[6], double y[6], double z[6], double S[3], double b[3])
 {
     int i;
@@ -54,12 +54,52 @@ public:
     static double listMean(QList<double> list);
     static double listVar(QList<double> list);
 private:
+    friend class EllipsoidFitAccumulator;
+
     static void EllipsoidFit(Eigen::VectorXf *samplesX, Eigen::VectorXf *samplesY, Eigen::VectorXf *samplesZ,
                              Eigen::Vector3f *center,
                              Eigen::VectorXf *radii,
                              Eigen::MatrixXf *evecs, bool fitAlongXYZ);
 
+    static void EllipsoidFromSolution(const Eigen::VectorXf &v,
+                                      Eigen::Vector3f *center,
+                                      Eigen::VectorXf *radii,
+                                      Eigen::MatrixXf *evecs, bool fitAlongXYZ);
+
+    static void EllipsoidCalibrationFromFit(const Eigen::Vector3f &center,
+                                            const Eigen::VectorXf &radii,
+                                            const Eigen::MatrixXf &evecs,
+                                            float nominalRange,
+                                            EllipsoidCalibrationResult *result);
+
     static int LinearEquationsSolve(int nDim, double *pfMatr, double *pfVect, double *pfSolution);
 };
+
+/*
+ * Incremental form of the ellipsoid fit. Each sample is folded into the
+ * running normal equations as it arrives, so memory use stays constant no
+ * matter how long the acquisition runs and the final solve only has to
+ * deal with a 9x9 (or 6x6) system instead of one row per sample.
+ */
+class EllipsoidFitAccumulator {
+public:
+    EllipsoidFitAccumulator(bool fitAlongXYZ = true);
+
+    void clear(bool fitAlongXYZ);
+    void addSample(float x, float y, float z);
+    int sampleCount() const
+    {
+        return m_sampleCount;
+    }
+    bool calibrate(float nominalRange, CalibrationUtils::EllipsoidCalibrationResult *result) const;
+
+private:
+    bool m_fitAlongXYZ;
+    int m_sampleCount;
+    // Running normal equations D'D and D'1, accumulated in double to keep
+    // the summation stable over long acquisitions.
+    Eigen::MatrixXd m_dtd;
+    Eigen::VectorXd m_dt1;
+};
 }
 #endif // CALIBRATIONUTILS_H
@@ -81,8 +81,9 @@ void LevelCalibrationModel::savePosition()
 
     savePositionEnabledChanged(false);
 
-    rot_accum_pitch.clear();
-    rot_accum_roll.clear();
+    rot_accum_samples = 0;
+    rot_accum_pitch   = 0;
+    rot_accum_roll    = 0;
 
     collectingData = true;
 
@@ -102,8 +103,9 @@ void LevelCalibrationModel::getSample(UAVObject *obj)
     case AttitudeState::OBJID:
     {
         AttitudeState::DataFields attitudeStateData = attitudeState->getData();
-        rot_accum_roll.append(attitudeStateData.Roll);
-        rot_accum_pitch.append(attitudeStateData.Pitch);
+        rot_accum_roll  += attitudeStateData.Roll;
+        rot_accum_pitch += attitudeStateData.Pitch;
+        rot_accum_samples++;
         break;
     }
     default:
@@ -111,10 +113,10 @@ void LevelCalibrationModel::getSample(UAVObject *obj)
     }
 
     // Work out the progress based on whichever has less
-    double p1 = (double)rot_accum_roll.size() / (double)LEVEL_SAMPLES;
+    double p1 = (double)rot_accum_samples / (double)LEVEL_SAMPLES;
     progressChanged(p1 * 100);
 
-    if (rot_accum_roll.size() >= LEVEL_SAMPLES &&
+    if (rot_accum_samples >= LEVEL_SAMPLES &&
         collectingData == true) {
         collectingData = false;
 
@@ -125,8 +127,8 @@ void LevelCalibrationModel::getSample(UAVObject *obj)
         position++;
         switch (position) {
         case 1:
-            rot_data_pitch = OpenPilot::CalibrationUtils::listMean(rot_accum_pitch);
-            rot_data_roll  = OpenPilot::CalibrationUtils::listMean(rot_accum_roll);
+            rot_data_pitch = rot_accum_pitch / rot_accum_samples;
+            rot_data_roll  = rot_accum_roll / rot_accum_samples;
 
             displayInstructions(tr("Leave horizontally, rotate 180° along yaw axis and press Save Position..."), WizardModel::Prompt);
             displayVisualHelp(CALIBRATION_HELPER_PLANE_PREFIX + CALIBRATION_HELPER_IMAGE_SWD);
@@ -134,9 +136,9 @@ void LevelCalibrationModel::getSample(UAVObject *obj)
             savePositionEnabledChanged(true);
             break;
         case 2:
-            rot_data_pitch += OpenPilot::CalibrationUtils::listMean(rot_accum_pitch);
+            rot_data_pitch += rot_accum_pitch / rot_accum_samples;
             rot_data_pitch /= 2;
-            rot_data_roll  += OpenPilot::CalibrationUtils::listMean(rot_accum_roll);
+            rot_data_roll  += rot_accum_roll / rot_accum_samples;
             rot_data_roll  /= 2;
 
             attitudeState->setMetadata(memento.attitudeStateMdata);
@@ -78,8 +78,10 @@ private:
 
     Memento memento;
 
-    QList<double> rot_accum_roll;
-    QList<double> rot_accum_pitch;
+    // running sums, no need to keep the individual samples around
+    int rot_accum_samples;
+    double rot_accum_roll;
+    double rot_accum_pitch;
     double rot_data_roll;
     double rot_data_pitch;
 
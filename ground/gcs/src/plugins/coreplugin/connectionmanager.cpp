@@ -69,6 +69,9 @@ ConnectionManager::ConnectionManager(Internal::MainWindow *mainWindow) :
 
     QObject::connect(m_connectBtn, SIGNAL(clicked()), this, SLOT(onConnectClicked()));
     QObject::connect(m_availableDevList, SIGNAL(currentIndexChanged(int)), this, SLOT(onDeviceSelectionChanged(int)));
+    // activated() fires on user interaction only, so programmatic list
+    // rebuilds can never trigger a link switch
+    QObject::connect(m_availableDevList, SIGNAL(activated(int)), this, SLOT(onDeviceSelectionActivated(int)));
 
     // setup our reconnect timers
     reconnect = new QTimer(this);
@@ -136,7 +139,68 @@ bool ConnectionManager::connectDevice(DevListItem device)
     emit deviceConnected(io_dev);
 
     m_connectBtn->setText(tr("Disconnect"));
-    m_availableDevList->setEnabled(false);
+
+    return true;
+}
+
+/**
+ *   Hand the running session over to another device (e.g. USB to OPLink
+ *   for the same vehicle). Telemetry is re-bound to the new QIODevice
+ *   instead of being torn down, so the object set is not re-retrieved and
+ *   the swap completes in well under a second.
+ */
+bool ConnectionManager::switchDevice(DevListItem device)
+{
+    if (!m_ioDev) {
+        // nothing to hand over from, fall back to a regular connect
+        return connectDevice(device);
+    }
+    if (device == m_connectionDevice) {
+        return true;
+    }
+
+    QIODevice *io_dev = device.connection->openDevice(device.device.name);
+    if (!io_dev) {
+        return false;
+    }
+
+    io_dev->open(QIODevice::ReadWrite);
+
+    if (!io_dev->isOpen()) {
+        // the current link stays untouched on failure
+        return false;
+    }
+
+    // stop our timers, they belong to the old link
+    if (reconnect->isActive()) {
+        reconnect->stop();
+    }
+    if (reconnectCheck->isActive()) {
+        reconnectCheck->stop();
+    }
+
+    DevListItem oldDevice = m_connectionDevice;
+
+    if (oldDevice.connection) {
+        disconnect(oldDevice.connection, SIGNAL(destroyed(QObject *)), this, SLOT(onConnectionDestroyed(QObject *)));
+    }
+    m_connectionDevice = device;
+    m_ioDev = io_dev;
+    connect(m_connectionDevice.connection, SIGNAL(destroyed(QObject *)), this, SLOT(onConnectionDestroyed(QObject *)), Qt::QueuedConnection);
+
+    // signal interested plugins to re-bind to the new device, then release
+    // the old one
+    emit deviceSwitched(io_dev);
+
+    try {
+        if (oldDevice.connection) {
+            oldDevice.connection->closeDevice(oldDevice.getConName());
+        }
+    } catch(...) { // handle exception
+        qDebug() << "Exception: oldDevice.connection->closeDevice(" << oldDevice.getConName() << ")";
+    }
+
+    qDebug() << "ConnectionManager - switched to" << m_connectionDevice.getConName();
 
     return true;
 }
@@ -247,6 +311,31 @@ void ConnectionManager::onDeviceSelectionChanged(int index)
     }
 }
 
+/**
+ *   Slot called when the user picks a device from the combo box. While
+ *   connected this is a request for a warm handover to the picked device.
+ */
+void ConnectionManager::onDeviceSelectionActivated(int index)
+{
+    if (!m_ioDev || (index < 0)) {
+        return;
+    }
+    QString deviceName = m_availableDevList->itemData(index, Qt::ToolTipRole).toString();
+    DevListItem device = findDevice(deviceName);
+
+    if (!device.connection || (device == m_connectionDevice)) {
+        return;
+    }
+    if (!switchDevice(device)) {
+        // the switch failed, point the selection back at the active device
+        for (int i = 0; i < m_availableDevList->count(); i++) {
+            if (m_connectionDevice.getConName() == m_availableDevList->itemData(i, Qt::ToolTipRole).toString()) {
+                m_availableDevList->setCurrentIndex(i);
+            }
+        }
+    }
+}
+
 /**
  *   Slot called when the user clicks the connect/disconnect button
  */
@@ -102,6 +102,8 @@ public:
     void addWidget(QWidget *widget);
 
     bool connectDevice(DevListItem device);
+    // ! Warm handover to another device without tearing down telemetry
+    bool switchDevice(DevListItem device);
     bool disconnectDevice();
     void suspendPolling();
     void resumePolling();
@@ -113,6 +115,8 @@ protected:
 
 signals:
     void deviceConnected(QIODevice *device);
+    // the session moved to another io device, telemetry stays up
+    void deviceSwitched(QIODevice *device);
     void deviceAboutToDisconnect();
     void deviceDisconnected();
     void availableDevicesChanged(const QLinkedList<Core::DevListItem> devices);
@@ -127,6 +131,7 @@ private slots:
 
     void onConnectClicked();
     void onDeviceSelectionChanged(int index);
+    void onDeviceSelectionActivated(int index);
     void devChanged(IConnection *connection);
 
     void onConnectionDestroyed(QObject *obj);
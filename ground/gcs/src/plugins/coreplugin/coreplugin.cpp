@@ -29,6 +29,9 @@
 #include "coreplugin.h"
 #include "coreimpl.h"
 #include "mainwindow.h"
+#include "performancemonitor.h"
+#include "rendergovernor.h"
+#include "memorydiagnostics.h"
 #include <QtPlugin>
 #include <extensionsystem/pluginmanager.h>
 
@@ -50,7 +53,16 @@ bool CorePlugin::initialize(const QStringList &arguments, QString *errorMessage)
     Q_UNUSED(arguments)
     const bool success = m_mainWindow->init(errorMessage);
     if (success) {
-        // nothing right now
+        // instrumentation service, off until started or GCS_PERF_HUD is set
+        PerformanceMonitor *monitor = new PerformanceMonitor();
+        addAutoReleasedObject(monitor);
+        if (qgetenv("GCS_PERF_HUD") == "1") {
+            monitor->showOverlay(true);
+        }
+        // memory attribution registry, plugins register their sources
+        addAutoReleasedObject(new MemoryDiagnostics());
+        // frame budget scheduler, gadgets register their refresh slots
+        addAutoReleasedObject(new RenderGovernor());
     }
     return success;
 }
@@ -68,6 +68,9 @@ SOURCES += \
     uavgadgetdecorator.cpp \
     workspacesettings.cpp \
     uavconfiginfo.cpp \
+    performancemonitor.cpp \
+    rendergovernor.cpp \
+    memorydiagnostics.cpp \
     aboutdialog.cpp \
 
 HEADERS += \
@@ -129,6 +132,9 @@ HEADERS += \
     workspacesettings.h \
     uavconfiginfo.h \
     iconfigurableplugin.h \
+    performancemonitor.h \
+    rendergovernor.h \
+    memorydiagnostics.h \
     aboutdialog.h
 
 FORMS += \
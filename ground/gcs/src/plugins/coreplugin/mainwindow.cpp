@@ -95,6 +95,12 @@ using namespace Core::Internal;
 
 static const char *uriListMimeFormatC = "text/uri-list";
 
+// background workspace prewarm : let startup settle before the first
+// deferred workspace is built, then space the builds out so the event
+// loop stays responsive in between
+static const int WORKSPACE_PREWARM_DELAY_MS   = 3000;
+static const int WORKSPACE_PREWARM_SPACING_MS = 500;
+
 enum { debugMainWindow = 0 };
 
 MainWindow::MainWindow() :
@@ -281,8 +287,31 @@ void MainWindow::extensionsInitialized()
     updateContext();
 
     emit m_coreImpl->coreAboutToOpen();
-    show();
+    if (!ExtensionSystem::PluginManager::instance()->isHeadless()) {
+        show();
+    }
     emit m_coreImpl->coreOpened();
+
+    // once the visible workspace is up, build the deferred ones in the
+    // background so switching to them later is instant
+    QTimer::singleShot(WORKSPACE_PREWARM_DELAY_MS, this, SLOT(prewarmWorkspaces()));
+}
+
+/**
+ * Builds one deferred workspace layout per pass, then re-arms until all
+ * workspaces are warm. Restoring a workspace blocks the event loop for as
+ * long as its gadgets take to construct, so they are built one at a time
+ * with the event loop serviced in between instead of all at once.
+ */
+void MainWindow::prewarmWorkspaces()
+{
+    foreach(UAVGadgetManager * manager, m_uavGadgetManagers) {
+        if (manager->restorePending()) {
+            manager->prewarm();
+            QTimer::singleShot(WORKSPACE_PREWARM_SPACING_MS, this, SLOT(prewarmWorkspaces()));
+            return;
+        }
+    }
 }
 
 QString MainWindow::loadStyleSheet(QString fileName)
@@ -159,6 +159,7 @@ private slots:
     void aboutPlugins();
     void updateFocusWidget(QWidget *old, QWidget *now);
     void modeChanged(Core::IMode *mode);
+    void prewarmWorkspaces();
     void showUavGadgetMenus(bool show, bool hasSplitter);
     void applyTabBarSettings(QTabWidget::TabPosition pos, bool movable);
     void showHelp();
@@ -0,0 +1,123 @@
+/**
+ ******************************************************************************
+ *
+ * @file       memorydiagnostics.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup CorePlugin Core Plugin
+ * @{
+ * @brief The Core GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "memorydiagnostics.h"
+
+#include <QMutexLocker>
+#include <QFile>
+#include <QTextStream>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+namespace Core {
+MemoryDiagnostics::MemoryDiagnostics(QObject *parent) : QObject(parent)
+{}
+
+void MemoryDiagnostics::registerSource(const QString &name, const SourceProvider &provider)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_sources.insert(name, provider);
+}
+
+void MemoryDiagnostics::unregisterSource(const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_sources.remove(name);
+}
+
+QStringList MemoryDiagnostics::sources() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_sources.keys();
+}
+
+quint64 MemoryDiagnostics::sourceBytes(const QString &name) const
+{
+    SourceProvider provider;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_sources.contains(name)) {
+            return 0;
+        }
+        provider = m_sources.value(name);
+    }
+    // polled outside the lock, a provider may take its own locks
+    return provider();
+}
+
+quint64 MemoryDiagnostics::processResidentBytes() const
+{
+#if defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly)) {
+        QTextStream in(&status);
+        QString line;
+        while (!(line = in.readLine()).isNull()) {
+            if (line.startsWith("VmRSS:")) {
+                return line.section(':', 1).trimmed().section(' ', 0, 0).toULongLong() * 1024;
+            }
+        }
+    }
+    return 0;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+QString MemoryDiagnostics::report() const
+{
+    QString text;
+    QTextStream out(&text);
+
+    quint64 accounted = 0;
+    foreach(const QString &name, sources()) {
+        quint64 bytes = sourceBytes(name);
+        accounted += bytes;
+        out << qSetFieldWidth(10) << right << (bytes / 1024) << qSetFieldWidth(0)
+            << " KiB  " << name << endl;
+    }
+    out << qSetFieldWidth(10) << right << (accounted / 1024) << qSetFieldWidth(0)
+        << " KiB  total accounted" << endl;
+    quint64 resident = processResidentBytes();
+    if (resident > 0) {
+        out << qSetFieldWidth(10) << right << (resident / 1024) << qSetFieldWidth(0)
+            << " KiB  process resident" << endl;
+    }
+    return text;
+}
+} // namespace Core
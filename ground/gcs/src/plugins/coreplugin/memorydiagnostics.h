@@ -0,0 +1,78 @@
+/**
+ ******************************************************************************
+ *
+ * @file       memorydiagnostics.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup CorePlugin Core Plugin
+ * @{
+ * @brief The Core GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef MEMORYDIAGNOSTICS_H
+#define MEMORYDIAGNOSTICS_H
+
+#include "core_global.h"
+
+#include <QObject>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+namespace Core {
+/**
+ * Registry that attributes the GCS's memory footprint to the subsystems
+ * holding it. Plugins register a named source reporting their current byte
+ * count (object manager buffers, map tile cache, scope histories, ...);
+ * the report lists every source next to the process resident size, so an
+ * unbounded buffer shows up by name long before it kills a 12 hour
+ * session. Queryable live from the debug gadget.
+ *
+ * Providers are polled on demand from the caller's thread and must be
+ * cheap and thread safe.
+ */
+class CORE_EXPORT MemoryDiagnostics : public QObject {
+    Q_OBJECT
+
+public:
+    typedef std::function<quint64()> SourceProvider;
+
+    MemoryDiagnostics(QObject *parent = 0);
+
+    void registerSource(const QString &name, const SourceProvider &provider);
+    void unregisterSource(const QString &name);
+
+    QStringList sources() const;
+    quint64 sourceBytes(const QString &name) const;
+
+    /** Resident set size of the whole process, 0 where not supported. */
+    quint64 processResidentBytes() const;
+
+    /** Human readable multi line summary of all of the above. */
+    QString report() const;
+
+private:
+    mutable QMutex m_mutex;
+    QMap<QString, SourceProvider> m_sources;
+};
+} // namespace Core
+
+#endif // MEMORYDIAGNOSTICS_H
@@ -0,0 +1,282 @@
+/**
+ ******************************************************************************
+ *
+ * @file       performancemonitor.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup CorePlugin Core Plugin
+ * @{
+ * @brief The Core GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "performancemonitor.h"
+
+#include <QApplication>
+#include <QEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QtAlgorithms>
+
+namespace Core {
+// Shared by the probe thread and the main thread slot so both sides measure
+// the queued delivery delay against the same epoch.
+static QElapsedTimer probeClock;
+
+PerformanceMonitor::PerformanceMonitor(QObject *parent) : QObject(parent),
+    m_running(false),
+    m_lastHeartbeatNs(0),
+    m_latencySumNs(0),
+    m_latencyMaxNs(0),
+    m_latencySamples(0),
+    m_lastEventNs(0),
+    m_currentReceiver(NULL),
+    m_probe(NULL),
+    m_queuedLatencyNs(0),
+    m_overlay(NULL)
+{
+    m_clock.start();
+    probeClock.start();
+    m_heartbeat.setTimerType(Qt::PreciseTimer);
+    m_heartbeat.setInterval(HEARTBEAT_MS);
+    connect(&m_heartbeat, SIGNAL(timeout()), this, SLOT(onHeartbeat()));
+}
+
+PerformanceMonitor::~PerformanceMonitor()
+{
+    stop();
+    if (m_overlay != NULL) {
+        delete m_overlay;
+    }
+}
+
+void PerformanceMonitor::start()
+{
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+
+    m_lastHeartbeatNs = m_clock.nsecsElapsed();
+    m_lastEventNs     = m_lastHeartbeatNs;
+    m_heartbeat.start();
+    qApp->installEventFilter(this);
+
+    m_probe = new Internal::LatencyProbe();
+    m_probe->moveToThread(&m_probeThread);
+    connect(&m_probeThread, SIGNAL(finished()), m_probe, SLOT(deleteLater()));
+    // queued by virtue of the thread difference, which is the point
+    connect(m_probe, SIGNAL(ping(qint64)), this, SLOT(onProbe(qint64)));
+    connect(&m_probeThread, SIGNAL(started()), m_probe, SLOT(startProbing()));
+    m_probeThread.start();
+}
+
+void PerformanceMonitor::stop()
+{
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+
+    qApp->removeEventFilter(this);
+    m_heartbeat.stop();
+    m_probeThread.quit();
+    m_probeThread.wait();
+    m_probe = NULL;
+}
+
+bool PerformanceMonitor::isRunning() const
+{
+    return m_running;
+}
+
+void PerformanceMonitor::showOverlay(bool show)
+{
+    if (show) {
+        if (m_overlay == NULL) {
+            m_overlay = new Internal::PerformanceOverlay(this);
+        }
+        if (!m_running) {
+            start();
+        }
+        m_overlay->show();
+    } else if (m_overlay != NULL) {
+        m_overlay->hide();
+    }
+}
+
+PerformanceMonitor::Snapshot PerformanceMonitor::takeSnapshot()
+{
+    Snapshot snapshot;
+
+    snapshot.loopLatencyAvgMs = (m_latencySamples > 0) ?
+                                (m_latencySumNs / m_latencySamples) / 1e6 : 0.0;
+    snapshot.loopLatencyMaxMs = m_latencyMaxNs / 1e6;
+    snapshot.queuedLatencyMs  = m_queuedLatencyNs / 1e6;
+
+    QList<ReceiverCost> costs;
+    QHashIterator<QString, qint64> it(m_receiverCostNs);
+    while (it.hasNext()) {
+        it.next();
+        ReceiverCost cost;
+        cost.receiver     = it.key();
+        cost.milliseconds = it.value() / 1e6;
+        costs.append(cost);
+    }
+    // biggest consumer first
+    for (int i = 0; i < costs.size(); ++i) {
+        for (int j = i + 1; j < costs.size(); ++j) {
+            if (costs.at(j).milliseconds > costs.at(i).milliseconds) {
+                costs.swap(i, j);
+            }
+        }
+    }
+    snapshot.topReceivers = costs.mid(0, 5);
+
+    m_latencySumNs   = 0;
+    m_latencyMaxNs   = 0;
+    m_latencySamples = 0;
+    m_receiverCostNs.clear();
+    return snapshot;
+}
+
+QVector<double> PerformanceMonitor::latencyHistory() const
+{
+    return m_history;
+}
+
+bool PerformanceMonitor::eventFilter(QObject *watched, QEvent *event)
+{
+    Q_UNUSED(event);
+
+    // Only the main thread is being profiled; events delivered on other
+    // threads also pass a global filter.
+    if (QThread::currentThread() == thread()) {
+        qint64 now = m_clock.nsecsElapsed();
+        // The filter runs just before an event is processed, so the time
+        // since the previous filter call is attributed to the receiver that
+        // was entered then. An approximation, but one that charges paint,
+        // timer and queued slot work to the widget doing it.
+        if (m_currentReceiver != NULL) {
+            m_receiverCostNs[QLatin1String(m_currentReceiver)] += now - m_lastEventNs;
+        }
+        m_lastEventNs     = now;
+        m_currentReceiver = watched->metaObject()->className();
+    }
+    return false;
+}
+
+void PerformanceMonitor::onHeartbeat()
+{
+    qint64 now      = m_clock.nsecsElapsed();
+    // how much later than scheduled the timer fired is how long the event
+    // loop was busy elsewhere
+    qint64 lateNs   = now - m_lastHeartbeatNs - (qint64)HEARTBEAT_MS * 1000000;
+
+    m_lastHeartbeatNs = now;
+    if (lateNs < 0) {
+        lateNs = 0;
+    }
+    m_latencySumNs += lateNs;
+    if (lateNs > m_latencyMaxNs) {
+        m_latencyMaxNs = lateNs;
+    }
+    ++m_latencySamples;
+
+    m_history.append(lateNs / 1e6);
+    while (m_history.size() > HISTORY_SIZE) {
+        m_history.removeFirst();
+    }
+}
+
+void PerformanceMonitor::onProbe(qint64 sentNs)
+{
+    m_queuedLatencyNs = probeClock.nsecsElapsed() - sentNs;
+}
+
+namespace Internal {
+LatencyProbe::LatencyProbe()
+{
+    // parented so the timer follows the probe onto its thread
+    m_timer.setParent(this);
+    m_timer.setInterval(100);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(onTimeout()));
+}
+
+void LatencyProbe::startProbing()
+{
+    m_timer.start();
+}
+
+void LatencyProbe::onTimeout()
+{
+    emit ping(probeClock.nsecsElapsed());
+}
+
+PerformanceOverlay::PerformanceOverlay(PerformanceMonitor *monitor) :
+    QWidget(NULL, Qt::Tool | Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint),
+    m_monitor(monitor)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_ShowWithoutActivating);
+    setWindowOpacity(0.85);
+    resize(260, 110);
+
+    m_refreshTimer.setInterval(500);
+    connect(&m_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+    m_refreshTimer.start();
+}
+
+void PerformanceOverlay::refresh()
+{
+    m_snapshot = m_monitor->takeSnapshot();
+    m_history  = m_monitor->latencyHistory();
+    update();
+}
+
+void PerformanceOverlay::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+
+    painter.fillRect(rect(), QColor(20, 20, 20));
+    painter.setPen(Qt::white);
+
+    // heat strip : one bar per heartbeat sample, green below 5 ms lateness
+    // fading to red at 100 ms and above
+    int barWidth = qMax(width() / PerformanceMonitor::HISTORY_SIZE, 1);
+    for (int i = 0; i < m_history.size(); ++i) {
+        double ms   = m_history.at(i);
+        double heat = qBound(0.0, (ms - 5.0) / 95.0, 1.0);
+        QColor color((int)(255 * heat), (int)(255 * (1.0 - heat)), 0);
+        painter.fillRect(i * barWidth, 0, barWidth, 20, color);
+    }
+
+    painter.drawText(4, 34, QString("loop avg %1 ms  max %2 ms  queue %3 ms")
+                     .arg(m_snapshot.loopLatencyAvgMs, 0, 'f', 1)
+                     .arg(m_snapshot.loopLatencyMaxMs, 0, 'f', 1)
+                     .arg(m_snapshot.queuedLatencyMs, 0, 'f', 1));
+
+    int y = 50;
+    foreach(const PerformanceMonitor::ReceiverCost &cost, m_snapshot.topReceivers) {
+        painter.drawText(4, y, QString("%1  %2 ms")
+                         .arg(cost.receiver).arg(cost.milliseconds, 0, 'f', 1));
+        y += 14;
+    }
+}
+} // namespace Internal
+} // namespace Core
@@ -0,0 +1,178 @@
+/**
+ ******************************************************************************
+ *
+ * @file       performancemonitor.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup CorePlugin Core Plugin
+ * @{
+ * @brief The Core GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef PERFORMANCEMONITOR_H
+#define PERFORMANCEMONITOR_H
+
+#include "core_global.h"
+
+#include <QObject>
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include <QTimer>
+#include <QThread>
+#include <QMutex>
+
+namespace Core {
+namespace Internal {
+class PerformanceOverlay;
+class LatencyProbe;
+}
+
+/**
+ * Live instrumentation of the GCS main thread, for finding the gadget
+ * responsible for stutter in the field without a profiler attached:
+ *
+ * - event loop latency, sampled as the lateness of a periodic heartbeat.
+ * - per receiver cost : while enabled a global event filter timestamps
+ *   every event delivered on the main thread and attributes the time until
+ *   the next one to the receiving widget's class. This includes paint,
+ *   timer and queued signal handlers, which is where gadget time goes.
+ * - queued delivery latency : a probe thread sends a timestamped queued
+ *   signal to the main thread; the delivery delay is the backlog the
+ *   telemetry threads' queued signals experience.
+ *
+ * Off by default, start() installs the instrumentation. The overlay is a
+ * small always-on-top heat display of the same numbers. Both can be
+ * enabled in the field by setting GCS_PERF_HUD=1 in the environment.
+ */
+class CORE_EXPORT PerformanceMonitor : public QObject {
+    Q_OBJECT
+
+public:
+    typedef struct {
+        QString receiver;
+        double milliseconds;
+    } ReceiverCost;
+
+    typedef struct {
+        double loopLatencyAvgMs;
+        double loopLatencyMaxMs;
+        double queuedLatencyMs;
+        QList<ReceiverCost> topReceivers;
+    } Snapshot;
+
+    // Number of heartbeat samples kept for the rolling heat display
+    static const int HISTORY_SIZE = 120;
+
+    PerformanceMonitor(QObject *parent = 0);
+    ~PerformanceMonitor();
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    void showOverlay(bool show);
+
+    /** Numbers accumulated since the previous snapshot() call. */
+    Snapshot takeSnapshot();
+    /** Rolling heartbeat lateness history, most recent sample last. */
+    QVector<double> latencyHistory() const;
+
+    virtual bool eventFilter(QObject *watched, QEvent *event);
+
+private slots:
+    void onHeartbeat();
+    void onProbe(qint64 sentNs);
+
+private:
+    static const int HEARTBEAT_MS = 50;
+
+    bool m_running;
+
+    QTimer m_heartbeat;
+    QElapsedTimer m_clock;
+    qint64 m_lastHeartbeatNs;
+    qint64 m_latencySumNs;
+    qint64 m_latencyMaxNs;
+    int m_latencySamples;
+    QVector<double> m_history;
+
+    // event filter state, only touched on the main thread
+    qint64 m_lastEventNs;
+    const char *m_currentReceiver;
+    QHash<QString, qint64> m_receiverCostNs;
+
+    QThread m_probeThread;
+    Internal::LatencyProbe *m_probe;
+    qint64 m_queuedLatencyNs;
+
+    Internal::PerformanceOverlay *m_overlay;
+};
+
+namespace Internal {
+/**
+ * Lives on the probe thread and periodically sends a timestamped queued
+ * signal towards the main thread.
+ */
+class LatencyProbe : public QObject {
+    Q_OBJECT
+
+public:
+    LatencyProbe();
+
+signals:
+    void ping(qint64 sentNs);
+
+public slots:
+    // invoked once the probe thread runs, so the timer lives there
+    void startProbing();
+
+private slots:
+    void onTimeout();
+
+private:
+    QTimer m_timer;
+};
+
+/**
+ * Frameless always-on-top strip drawing the rolling heartbeat lateness as
+ * a heat bar plus the current numbers and the most expensive receivers.
+ */
+class PerformanceOverlay : public QWidget {
+    Q_OBJECT
+
+public:
+    PerformanceOverlay(PerformanceMonitor *monitor);
+
+protected:
+    virtual void paintEvent(QPaintEvent *event);
+
+private slots:
+    void refresh();
+
+private:
+    PerformanceMonitor *m_monitor;
+    PerformanceMonitor::Snapshot m_snapshot;
+    QVector<double> m_history;
+    QTimer m_refreshTimer;
+};
+} // namespace Internal
+} // namespace Core
+
+#endif // PERFORMANCEMONITOR_H
@@ -0,0 +1,182 @@
+/**
+ ******************************************************************************
+ *
+ * @file       rendergovernor.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup CorePlugin Core Plugin
+ * @{
+ * @brief The Core GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "rendergovernor.h"
+
+#include <QMetaObject>
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <algorithm>
+
+// ~30 frames per second, in line with the fastest gadget refresh timers
+#define FRAME_INTERVAL_MS   33
+// portion of a frame handed out to refresh slots, the rest is left for
+// event delivery, layout and the scene graph
+#define FRAME_BUDGET_MS     10
+// weight of the latest measurement in the running cost average
+#define COST_EWMA_WEIGHT    0.2
+
+namespace Core {
+RenderGovernor::RenderGovernor(QObject *parent) : QObject(parent),
+    m_nextClientId(0), m_frameBudgetMs(FRAME_BUDGET_MS)
+{
+    m_frameTimer.setInterval(FRAME_INTERVAL_MS);
+    connect(&m_frameTimer, SIGNAL(timeout()), this, SLOT(frameTick()));
+}
+
+RenderGovernor::~RenderGovernor()
+{}
+
+int RenderGovernor::registerClient(QObject *receiver, const char *member, Priority priority, int costHintMs)
+{
+    Client client;
+
+    client.receiver     = receiver;
+    client.member       = QByteArray(member);
+    client.priority     = priority;
+    client.costMs       = qMax(costHintMs, 0);
+    client.pending      = false;
+    client.waitedFrames = 0;
+
+    int clientId = ++m_nextClientId;
+    m_clients.insert(clientId, client);
+    return clientId;
+}
+
+void RenderGovernor::unregisterClient(int clientId)
+{
+    m_clients.remove(clientId);
+    if (m_clients.isEmpty()) {
+        m_frameTimer.stop();
+    }
+}
+
+void RenderGovernor::requestRefresh(int clientId)
+{
+    QHash<int, Client>::iterator it = m_clients.find(clientId);
+
+    if (it == m_clients.end()) {
+        return;
+    }
+    it.value().pending = true;
+    if (!m_frameTimer.isActive()) {
+        m_frameTimer.start();
+    }
+}
+
+void RenderGovernor::setFrameBudget(int ms)
+{
+    m_frameBudgetMs = qMax(ms, 1);
+}
+
+int RenderGovernor::frameBudget() const
+{
+    return m_frameBudgetMs;
+}
+
+namespace {
+struct ScheduleEntry {
+    int id;
+    int priority;
+    int waitedFrames;
+
+    bool operator<(const ScheduleEntry &other) const
+    {
+        if (priority != other.priority) {
+            return priority < other.priority;
+        }
+        // within a priority the longest waiting client goes first
+        return waitedFrames > other.waitedFrames;
+    }
+};
+}
+
+void RenderGovernor::frameTick()
+{
+    // order pending clients : highest priority, then longest waiting
+    QList<ScheduleEntry> schedule;
+
+    for (QHash<int, Client>::iterator it = m_clients.begin(); it != m_clients.end();) {
+        if (it.value().receiver.isNull()) {
+            // receiver deleted without unregistering
+            it = m_clients.erase(it);
+            continue;
+        }
+        if (it.value().pending) {
+            ScheduleEntry entry;
+            entry.id           = it.key();
+            entry.priority     = it.value().priority;
+            entry.waitedFrames = it.value().waitedFrames;
+            schedule.append(entry);
+        }
+        ++it;
+    }
+    if (schedule.isEmpty()) {
+        // nothing to do until the next requestRefresh()
+        m_frameTimer.stop();
+        return;
+    }
+    std::sort(schedule.begin(), schedule.end());
+
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+
+    bool ranOne = false;
+    foreach(const ScheduleEntry &entry, schedule) {
+        QHash<int, Client>::iterator it = m_clients.find(entry.id);
+        if (it == m_clients.end() || it.value().receiver.isNull()) {
+            // unregistered or deleted by an earlier slot this frame
+            continue;
+        }
+        double spentMs = frameTimer.nsecsElapsed() / 1e6;
+
+        // run at least one client per frame, otherwise stop handing out
+        // work once the expected cost no longer fits the budget
+        if (ranOne && (spentMs + it.value().costMs > m_frameBudgetMs)) {
+            it.value().waitedFrames++;
+            continue;
+        }
+        it.value().pending      = false;
+        it.value().waitedFrames = 0;
+        ranOne = true;
+
+        QObject *receiver = it.value().receiver.data();
+        QByteArray member = it.value().member;
+
+        qint64 startNs    = frameTimer.nsecsElapsed();
+        QMetaObject::invokeMethod(receiver, member.constData(), Qt::DirectConnection);
+        double costMs     = (frameTimer.nsecsElapsed() - startNs) / 1e6;
+
+        // the slot may have changed the client table, look the entry up again
+        it = m_clients.find(entry.id);
+        if (it != m_clients.end()) {
+            // measured cost replaces the registration hint over time
+            it.value().costMs = (1.0 - COST_EWMA_WEIGHT) * it.value().costMs + COST_EWMA_WEIGHT * costMs;
+        }
+    }
+}
+} // namespace Core
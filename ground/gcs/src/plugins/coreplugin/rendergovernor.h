@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ *
+ * @file       rendergovernor.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup CorePlugin Core Plugin
+ * @{
+ * @brief The Core GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef RENDERGOVERNOR_H
+#define RENDERGOVERNOR_H
+
+#include "core_global.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QTimer>
+
+namespace Core {
+/**
+ * Frame budget scheduler for gadget refresh work.
+ *
+ * Without it every gadget runs its own refresh timer and under full
+ * telemetry load they all fire in the same event loop window, which shows
+ * up as frame spikes. Gadgets instead register a refresh slot once with a
+ * priority and a cost estimate, and call requestRefresh() whenever they
+ * have something to redraw. The governor runs pending refreshes from a
+ * single frame timer, highest priority and longest waiting first, and
+ * stops handing out work once the per frame time budget is spent - what
+ * is left simply stays pending for the next frame.
+ *
+ * The cost estimate only seeds the schedule : each invocation is measured
+ * and the running average replaces the hint, so misdeclared clients do not
+ * blow the budget for long. One pending client is always run per frame,
+ * even over budget, so an expensive client cannot starve itself.
+ *
+ * A refresh slot is run once per grant; clients with ongoing work (for
+ * example needle animations) re-request from within the slot.
+ */
+class CORE_EXPORT RenderGovernor : public QObject {
+    Q_OBJECT
+
+public:
+    enum Priority { PriorityHigh = 0, PriorityNormal = 1, PriorityLow = 2 };
+
+    RenderGovernor(QObject *parent = 0);
+    ~RenderGovernor();
+
+    // ! Register a refresh slot (method name, no parameters). Returns the
+    // ! client id used by requestRefresh(), costHintMs seeds the cost average.
+    int registerClient(QObject *receiver, const char *member, Priority priority = PriorityNormal, int costHintMs = 1);
+    void unregisterClient(int clientId);
+
+    // ! Mark the client as needing a refresh, its slot will be invoked
+    // ! within a coming frame budget. Safe to call repeatedly.
+    void requestRefresh(int clientId);
+
+    // ! Per frame time budget [ms] handed out to refresh slots
+    void setFrameBudget(int ms);
+    int frameBudget() const;
+
+private slots:
+    void frameTick();
+
+private:
+    struct Client {
+        QPointer<QObject> receiver;
+        QByteArray member;
+        Priority   priority;
+        double     costMs; // measured running average, seeded from the hint
+        bool       pending;
+        int        waitedFrames;
+    };
+
+    QHash<int, Client> m_clients;
+    int    m_nextClientId;
+    int    m_frameBudgetMs;
+    QTimer m_frameTimer;
+};
+} // namespace Core
+
+#endif // RENDERGOVERNOR_H
@@ -75,6 +75,7 @@ enum { debugUAVGadgetManager = 0 };
 
 UAVGadgetManager::UAVGadgetManager(ICore *core, QString name, QIcon icon, int priority, QString uniqueName, QWidget *parent) :
     m_showToolbars(true),
+    m_restoreDeferred(false),
     m_splitterOrView(0),
     m_currentGadget(0),
     m_core(core),
@@ -136,6 +137,11 @@ void UAVGadgetManager::modeChanged(Core::IMode *mode)
         return;
     }
 
+    // build the workspace the first time the operator actually opens it
+    if (m_restoreDeferred) {
+        restoreDeferredState();
+    }
+
     m_currentGadget->widget()->setFocus();
     showToolbars(toolbarsShown());
 }
@@ -328,6 +334,16 @@ bool UAVGadgetManager::restoreState(QSettings *qSettings)
 
 void UAVGadgetManager::saveSettings(QSettings *qs)
 {
+    if (m_restoreDeferred) {
+        // This workspace still shows its startup placeholder, the real
+        // layout is the one already stored in the persistent settings.
+        if (qs == m_core->settings()) {
+            return;
+        }
+        // Saving to another store (settings export), so the gadgets have
+        // to be built after all in order to serialize them.
+        restoreDeferredState();
+    }
     qs->beginGroup("UAVGadgetManager");
     qs->beginGroup(this->uniqueModeName());
 
@@ -354,6 +370,45 @@ void UAVGadgetManager::readSettings(QSettings *qs)
         qs->endGroup();
         return;
     }
+
+    // Gadgets are expensive to construct, so workspaces that are not on
+    // screen keep their lightweight placeholder and are only built when
+    // first activated. This can only be done for the persistent settings,
+    // which stay around to be replayed later; imported settings are
+    // restored right away.
+    if ((qs == m_core->settings()) && (m_core->modeManager()->currentMode() != this)) {
+        m_restoreDeferred = true;
+        qs->endGroup();
+        return;
+    }
+    m_restoreDeferred = false;
+
+    qs->beginGroup(uniqueModeName());
+
+    restoreState(qs);
+
+    showToolbars(m_showToolbars);
+
+    qs->endGroup();
+    qs->endGroup();
+}
+
+// Called from the background prewarm pass : builds the layout while the
+// workspace is off screen, so switching to it mid flight does not stall.
+void UAVGadgetManager::prewarm()
+{
+    if (m_restoreDeferred) {
+        restoreDeferredState();
+    }
+}
+
+void UAVGadgetManager::restoreDeferredState()
+{
+    m_restoreDeferred = false;
+
+    QSettings *qs = m_core->settings();
+
+    qs->beginGroup("UAVGadgetManager");
     qs->beginGroup(uniqueModeName());
 
     restoreState(qs);
@@ -105,6 +105,14 @@ public:
         return m_showToolbars;
     }
 
+    // ! True while the workspace still shows its startup placeholder
+    bool restorePending() const
+    {
+        return m_restoreDeferred;
+    }
+    // ! Build the deferred layout now, so a later activation is instant
+    void prewarm();
+
 signals:
     void currentGadgetChanged(IUAVGadget *gadget);
     void showUavGadgetMenus(bool show, bool hasSplitter);
@@ -133,7 +141,10 @@ private:
     void emptyView(Core::Internal::UAVGadgetView *view);
     Core::Internal::SplitterOrView *currentSplitterOrView() const;
 
+    void restoreDeferredState();
+
     bool m_showToolbars;
+    bool m_restoreDeferred;
     Core::Internal::SplitterOrView *m_splitterOrView;
     Core::IUAVGadget *m_currentGadget;
     Core::ICore *m_core;
@@ -1,9 +1,10 @@
 #include "debugengine.h"
 
-debugengine::debugengine()
-{
-    mut_lock = new QMutex(QMutex::Recursive);
-}
+#include <QTime>
+
+debugengine::debugengine() : m_head(0), m_tail(0), m_dropped(0),
+    m_minSeverity(severityRank(QtDebugMsg)), m_flushTimer(NULL)
+{}
 
 debugengine *debugengine::getInstance()
 {
@@ -13,32 +14,124 @@ debugengine *debugengine::getInstance()
 }
 
 debugengine::~debugengine()
+{}
+
+/*
+ * Order severities by importance rather than by enum value,
+ * QtInfoMsg was appended to QtMsgType after QtFatalMsg.
+ */
+int debugengine::severityRank(QtMsgType type)
 {
-    delete mut_lock;
-    mut_lock = NULL;
+    switch (type) {
+    case QtDebugMsg:
+        return 0;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 5, 0))
+    case QtInfoMsg:
+        return 1;
+
+#endif
+    case QtWarningMsg:
+        return 2;
+
+    case QtCriticalMsg:
+        return 3;
+
+    case QtFatalMsg:
+        return 4;
+    }
+    return 0;
 }
 
-void debugengine::setTextEdit(QTextBrowser *textEdit)
+void debugengine::setMinSeverity(QtMsgType type)
 {
-    QMutexLocker lock(mut_lock);
+    m_minSeverity.store(severityRank(type));
+}
 
+void debugengine::setTextEdit(QTextBrowser *textEdit)
+{
     _textEdit = textEdit;
+    if (_textEdit) {
+        // bound the widget itself, the ring only bounds what is in flight
+        _textEdit->document()->setMaximumBlockCount(RING_SIZE);
+    }
+    if (!m_flushTimer) {
+        // lazily created here so the timer lives in the GUI thread
+        m_flushTimer = new QTimer(this);
+        connect(m_flushTimer, SIGNAL(timeout()), this, SLOT(flush()));
+        m_flushTimer->start(FLUSH_INTERVAL_MS);
+    }
 }
 
-void debugengine::writeMessage(const QString &message)
+void debugengine::writeMessage(QtMsgType type, const QString &message)
 {
-    QMutexLocker lock(mut_lock);
+    if (severityRank(type) < m_minSeverity.load()) {
+        return;
+    }
+    // claim a slot, or drop the line when the ring is full
+    int head;
+    do {
+        head = m_head.load();
+        if ((head - m_tail.load()) >= RING_SIZE) {
+            m_dropped.fetchAndAddOrdered(1);
+            return;
+        }
+    } while (!m_head.testAndSetOrdered(head, head + 1));
 
-    if (_textEdit) {
-        _textEdit->append(message);
+    Line & line = m_ring[head & RING_MASK];
+    QString color;
+    switch (type) {
+    case QtWarningMsg:
+    case QtCriticalMsg:
+    case QtFatalMsg:
+        color = "red";
+        break;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 5, 0))
+    case QtInfoMsg:
+        color = "blue";
+        break;
+
+#endif
+    default:
+        color = "black";
+        break;
     }
+    line.text = QString("<font color=\"%1\">%2 %3</font>")
+                .arg(color)
+                .arg(QTime::currentTime().toString())
+                .arg(message.toHtmlEscaped());
+    // publish, the flush side pairs this with loadAcquire()
+    line.ready.storeRelease(1);
 }
 
-void debugengine::setColor(const QColor &c)
+/*
+ * Drains the ring into the widget in one append per tick. Runs on the
+ * GUI thread; slots are only recycled after their text has been taken,
+ * so a producer that claimed but not yet published a slot simply delays
+ * everything behind it until the next tick.
+ */
+void debugengine::flush()
 {
-    QMutexLocker lock(mut_lock);
-
-    if (_textEdit) {
-        _textEdit->setTextColor(c);
+    if (!_textEdit) {
+        return;
+    }
+    QStringList batch;
+    int tail = m_tail.load();
+    while ((batch.count() < MAX_LINES_PER_FLUSH) && m_ring[tail & RING_MASK].ready.loadAcquire()) {
+        Line & line = m_ring[tail & RING_MASK];
+        batch << line.text;
+        line.text.clear();
+        line.ready.storeRelease(0);
+        ++tail;
+    }
+    if (batch.isEmpty()) {
+        return;
+    }
+    m_tail.store(tail);
+    int dropped = m_dropped.fetchAndStoreOrdered(0);
+    if (dropped > 0) {
+        batch << QString("<font color=\"red\">... %1 messages dropped</font>").arg(dropped);
     }
+    _textEdit->append(batch.join("<br>"));
 }
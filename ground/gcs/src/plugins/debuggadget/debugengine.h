@@ -2,20 +2,50 @@
 #define DEBUGENGINE_H
 #include <QTextBrowser>
 #include <QPointer>
-#include <QMutex>
+#include <QAtomicInt>
+#include <QTimer>
+
+/*
+ * Collects debug output on a fixed-size lock-free ring of preformatted
+ * lines. Producers (the message handler, any thread) claim a slot with a
+ * compare-and-swap and drop the line when the ring is full, so a chatty
+ * plugin can never block or grow memory. The GUI thread drains the ring
+ * in batches on a timer, which caps the widget update rate.
+ */
+class debugengine : public QObject {
+    Q_OBJECT
 
-class debugengine {
-// Add all missing constructor etc... to have singleton
     debugengine();
     ~debugengine();
 public:
     static debugengine *getInstance();
     void setTextEdit(QTextBrowser *textEdit);
-    void writeMessage(const QString &message);
-    void setColor(const QColor &c);
-    QMutex *mut_lock;
+    // producer side, safe to call from any thread
+    void writeMessage(QtMsgType type, const QString &message);
+    // messages below this severity are discarded before formatting
+    void setMinSeverity(QtMsgType type);
+
+private slots:
+    void flush();
+
 private:
+    enum { RING_SIZE = 4096, RING_MASK = RING_SIZE - 1 }; // power of two
+    enum { FLUSH_INTERVAL_MS = 200, MAX_LINES_PER_FLUSH = 256 };
+
+    struct Line {
+        QAtomicInt ready;
+        QString    text;
+    };
+
+    static int severityRank(QtMsgType type);
+
+    Line m_ring[RING_SIZE];
+    QAtomicInt m_head; // next slot to claim, producers
+    QAtomicInt m_tail; // next slot to drain, GUI thread only
+    QAtomicInt m_dropped;
+    QAtomicInt m_minSeverity;
     QPointer<QTextBrowser> _textEdit;
+    QTimer *m_flushTimer;
 };
 
 #endif // DEBUGENGINE_H
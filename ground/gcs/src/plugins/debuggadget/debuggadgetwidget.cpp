@@ -33,47 +33,42 @@
 #include <QVBoxLayout>
 #include <QPushButton>
 #include "debugengine.h"
+#include <coreplugin/memorydiagnostics.h>
+#include <extensionsystem/pluginmanager.h>
+#include <utils/tracer.h>
 #include <QFile>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QScrollBar>
 #include <QTime>
 
-QPointer<QTextBrowser> m_textedit;
-
 void DebugGadgetWidget::customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
     Q_UNUSED(context);
     QString txt;
-    QColor color = Qt::black;
 
     switch (type) {
     case QtDebugMsg:
-        txt   = QString("Debug: %1").arg(msg);
-        color = Qt::black;
+        txt = QString("Debug: %1").arg(msg);
         break;
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 5, 0))
     case QtInfoMsg:
-        txt   = QString("Info: %1").arg(msg);
-        color = Qt::blue;
+        txt = QString("Info: %1").arg(msg);
         break;
 #endif
     case QtWarningMsg:
-        txt   = QString("Warning: %1").arg(msg);
-        color = Qt::red;
+        txt = QString("Warning: %1").arg(msg);
         break;
     case QtCriticalMsg:
-        txt   = QString("Critical: %1").arg(msg);
-        color = Qt::red;
+        txt = QString("Critical: %1").arg(msg);
         break;
     case QtFatalMsg:
-        txt   = QString("Fatal: %1").arg(msg);
+        txt = QString("Fatal: %1").arg(msg);
         abort();
     }
 
-    debugengine::getInstance()->setTextEdit(m_textedit);
-    debugengine::getInstance()->setColor(color);
-    debugengine::getInstance()->writeMessage(txt);
+    // lock-free, safe from whatever thread the message originates on
+    debugengine::getInstance()->writeMessage(type, txt);
 }
 
 DebugGadgetWidget::DebugGadgetWidget(QWidget *parent) : QLabel(parent)
@@ -81,13 +76,16 @@ DebugGadgetWidget::DebugGadgetWidget(QWidget *parent) : QLabel(parent)
     m_config = new Ui_Form();
     m_config->setupUi(this);
 
-    // m_textedit = m_config->plainTextEdit;
-    // MyplainTextEdit=m_config->plainTextEdit;
-    // debugengine *de = new debugengine();
+    // must be called from the GUI thread, the engine's flush timer lives here
+    debugengine::getInstance()->setTextEdit(m_config->plainTextEdit);
+
     // qInstallMessageHandler(customMessageHandler);
     // connect(de, SIGNAL(dbgMsg(QString, QList<QVariant>)), this, SLOT(dbgMsg(QString, QList<QVariant>)));
     // connect(de, SIGNAL(dbgMsgError(QString, QList<QVariant>)), this, SLOT(dbgMsgError(QString, QList<QVariant>)));
     connect(m_config->pushButton, SIGNAL(clicked()), this, SLOT(saveLog()));
+    connect(m_config->pushButtonMemory, SIGNAL(clicked()), this, SLOT(memoryReport()));
+    connect(m_config->pushButtonTrace, SIGNAL(toggled(bool)), this, SLOT(traceToggled(bool)));
+    connect(m_config->pushButtonTraceSave, SIGNAL(clicked()), this, SLOT(saveTrace()));
 }
 
 DebugGadgetWidget::~DebugGadgetWidget()
@@ -115,6 +113,49 @@ void DebugGadgetWidget::dbgMsgError(const QString &level, const QList<QVariant>
     QScrollBar *sb = m_config->plainTextEdit->verticalScrollBar();
     sb->setValue(sb->maximum());
 }
+void DebugGadgetWidget::memoryReport()
+{
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    Core::MemoryDiagnostics *memoryDiagnostics = pm->getObject<Core::MemoryDiagnostics>();
+
+    if (memoryDiagnostics == NULL) {
+        return;
+    }
+    m_config->plainTextEdit->setTextColor(Qt::darkBlue);
+    m_config->plainTextEdit->append(QString("%1 memory report\n%2")
+                                    .arg(QTime::currentTime().toString())
+                                    .arg(memoryDiagnostics->report()));
+
+    QScrollBar *sb = m_config->plainTextEdit->verticalScrollBar();
+    sb->setValue(sb->maximum());
+}
+
+void DebugGadgetWidget::traceToggled(bool checked)
+{
+    if (checked) {
+        // a fresh capture per run keeps the export readable
+        Utils::Tracer::clear();
+    }
+    Utils::Tracer::setEnabled(checked);
+}
+
+void DebugGadgetWidget::saveTrace()
+{
+    // stop the capture before walking the buffers
+    m_config->pushButtonTrace->setChecked(false);
+
+    QString fileName = QFileDialog::getSaveFileName(0, tr("Save trace As"), "gcs-trace.json");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (!Utils::Tracer::exportTo(fileName)) {
+        QMessageBox::critical(0,
+                              tr("Trace Save"),
+                              tr("Unable to save trace: ") + fileName,
+                              QMessageBox::Ok);
+    }
+}
+
 void DebugGadgetWidget::saveLog()
 {
     QString fileName = QFileDialog::getSaveFileName(0, tr("Save log File As"), "");
@@ -42,6 +42,9 @@ private:
     Ui_Form *m_config;
 private slots:
     void saveLog();
+    void memoryReport();
+    void traceToggled(bool checked);
+    void saveTrace();
     void dbgMsgError(const QString & level, const QList<QVariant> & msgs);
     void dbgMsg(const QString & level, const QList<QVariant> & msgs);
 };
@@ -60,13 +60,23 @@ DialGadgetWidget::DialGadgetWidget(QWidget *parent) : QGraphicsView(parent)
 // beSmooth = true;
     beSmooth = false;
 
-    // This timer mechanism makes needles rotate smoothly
-    connect(&dialTimer, SIGNAL(timeout()), this, SLOT(rotateNeedles()));
+    // Needle rotation is scheduled by the core render governor so all
+    // dials share one frame budget instead of each running a timer
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    m_governor = pm->getObject<Core::RenderGovernor>();
+    if (m_governor) {
+        m_governorClient = m_governor->registerClient(this, "rotateNeedles", Core::RenderGovernor::PriorityNormal, 2);
+    } else {
+        // This timer mechanism makes needles rotate smoothly
+        connect(&dialTimer, SIGNAL(timeout()), this, SLOT(rotateNeedles()));
+    }
 }
 
 DialGadgetWidget::~DialGadgetWidget()
 {
-    // Do nothing
+    if (m_governor) {
+        m_governor->unregisterClient(m_governorClient);
+    }
 }
 
 /*!
@@ -311,6 +321,19 @@ void DialGadgetWidget::setDialFile(QString dfn, QString bg, QString fg, QString
             fgenabled = true;
         }
 
+        // Cache the layers as rendered pixmaps. The background and foreground
+        // only change with the view transform and are kept in device
+        // coordinate caches, while each needle is rendered once into an item
+        // coordinate cache that its per frame rotation and translation are
+        // applied to. This stops the full SVG from being re-composited at
+        // telemetry rate; the needle pixmap is scaled with the view, which
+        // is not noticeable on a moving element.
+        m_background->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        m_foreground->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        m_needle1->setCacheMode(QGraphicsItem::ItemCoordinateCache);
+        m_needle2->setCacheMode(QGraphicsItem::ItemCoordinateCache);
+        m_needle3->setCacheMode(QGraphicsItem::ItemCoordinateCache);
+
         rotateN1 = false;
         horizN1  = false;
         vertN1   = false;
@@ -421,9 +444,7 @@ void DialGadgetWidget::setDialFile(QString dfn, QString bg, QString fg, QString
         needle1Value = 0;
         needle2Value = 0;
         needle3Value = 0;
-        if (!dialTimer.isActive()) {
-            dialTimer.start();
-        }
+        scheduleRotation();
         dialError = false;
     } else {
         qDebug() << "no file: display default background.";
@@ -490,9 +511,7 @@ void DialGadgetWidget::setNeedle1(double value)
     if (vertN1) {
         needle1Target = (value * n1Factor) / (n1MaxValue - n1MinValue);
     }
-    if (!dialTimer.isActive()) {
-        dialTimer.start();
-    }
+    scheduleRotation();
     if (m_text1) {
         QString s;
         s.sprintf("%.2f", value * n1Factor);
@@ -511,9 +530,7 @@ void DialGadgetWidget::setNeedle2(double value)
     if (vertN2) {
         needle2Target = (value * n2Factor) / (n2MaxValue - n2MinValue);
     }
-    if (!dialTimer.isActive()) {
-        dialTimer.start();
-    }
+    scheduleRotation();
     if (m_text2) {
         QString s;
         s.sprintf("%.2f", value * n2Factor);
@@ -532,9 +549,7 @@ void DialGadgetWidget::setNeedle3(double value)
     if (vertN3) {
         needle3Target = (value * n3Factor) / (n3MaxValue - n3MinValue);
     }
-    if (!dialTimer.isActive()) {
-        dialTimer.start();
-    }
+    scheduleRotation();
     if (m_text3) {
         QString s;
         s.sprintf("%.2f", value * n3Factor);
@@ -644,5 +659,19 @@ void DialGadgetWidget::rotateNeedles()
     // just stop the timer since all needles have finished moving
     if (!dialRun) {
         dialTimer.stop();
+    } else if (m_governor) {
+        // still converging on the targets, ask for another frame grant
+        m_governor->requestRefresh(m_governorClient);
+    }
+}
+
+// Request a rotation step from the render governor, or fall back to the
+// local timer when the service is not available
+void DialGadgetWidget::scheduleRotation()
+{
+    if (m_governor) {
+        m_governor->requestRefresh(m_governorClient);
+    } else if (!dialTimer.isActive()) {
+        dialTimer.start();
     }
 }
@@ -31,6 +31,7 @@
 
 #include "dialgadgetconfiguration.h"
 #include "extensionsystem/pluginmanager.h"
+#include "coreplugin/rendergovernor.h"
 #include "uavobjectmanager.h"
 #include "uavobject.h"
 #include <QGraphicsView>
@@ -174,9 +175,16 @@ private:
     QString subfield3;
     bool haveSubField3;
 
-    // Rotation timer
+    // ! Ask for a needle rotation step, governed when the service is there
+    void scheduleRotation();
+
+    // Rotation timer, fallback when no render governor is available
     QTimer dialTimer;
 
+    // frame budget scheduler, replaces the per gadget timer
+    Core::RenderGovernor *m_governor;
+    int m_governorClient;
+
     bool beSmooth;
 };
 #endif /* DIALGADGETWIDGET_H_ */
@@ -1,7 +1,7 @@
 TEMPLATE = lib 
 TARGET = FlightLog
 
-QT += widgets qml quick
+QT += widgets qml quick concurrent
 
 include(../../plugin.pri)
 include(../../plugins/coreplugin/coreplugin.pri)
@@ -33,6 +33,7 @@
 #include <QXmlStreamReader>
 #include <QMessageBox>
 #include <QDebug>
+#include <QtConcurrentMap>
 
 #include "debuglogcontrol.h"
 #include "uavobjecthelper.h"
@@ -207,11 +208,7 @@ void FlightLogManager::retrieveLogs(int flightToRetrieve)
         bool gotLast = false;
         int slot     = 0;
         while (!gotLast) {
-            // Send request for loading flight entry on flight side and wait for ack/nack
-            m_flightLogControl->setEntry(slot);
-
-            if (updateHelper.doObjectAndWait(m_flightLogControl, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS &&
-                requestHelper.doObjectAndWait(m_flightLogEntry, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS) {
+            if (retrieveLogEntry(flight, slot, updateHelper, requestHelper)) {
                 if (m_flightLogEntry->getType() != DebugLogEntry::TYPE_EMPTY) {
                     // Ok, we retrieved the entry, and it was the correct one. clone it and add it to the list
                     ExtendedDebugLogEntry *logEntry = new ExtendedDebugLogEntry();
@@ -275,6 +272,32 @@ void FlightLogManager::retrieveLogs(int flightToRetrieve)
     setDisableControls(false);
 }
 
+/**
+ * Fetches one log slot into m_flightLogEntry.
+ *
+ * The fast path fires the control update without blocking on its ack
+ * (the telemetry layer keeps retrying it on its own) and only waits for
+ * the entry object, so fetching a slot costs one link round trip
+ * instead of two. The returned entry is checked against the requested
+ * flight and slot; on a mismatch or timeout the old fully synchronous
+ * handshake is used, which also covers boards answering empty slots
+ * with unset ids.
+ */
+bool FlightLogManager::retrieveLogEntry(int flight, int slot,
+                                        UAVObjectUpdaterHelper &updateHelper, UAVObjectRequestHelper &requestHelper)
+{
+    m_flightLogControl->setEntry(slot);
+
+    m_flightLogControl->updated();
+    if (requestHelper.doObjectAndWait(m_flightLogEntry, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS
+        && (m_flightLogEntry->getFlight() == (quint16)flight) && (m_flightLogEntry->getEntry() == (quint16)slot)) {
+        return true;
+    }
+
+    return updateHelper.doObjectAndWait(m_flightLogControl, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS &&
+           requestHelper.doObjectAndWait(m_flightLogEntry, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS;
+}
+
 void FlightLogManager::exportToOPL(QString fileName)
 {
     // Fix the file name
@@ -343,6 +366,86 @@ void FlightLogManager::exportToCSV(QString fileName)
     }
 }
 
+// ! All entries of one object type, destined for one columnar file
+struct ColumnarExportJob {
+    QString fileName;
+    QList<ExtendedDebugLogEntry *> entries;
+    QMap<quint16, quint32> baseTimes;
+};
+
+/**
+ * Writes the entries of one object type as a columnar CSV file: one
+ * column per field element, taken from the generated object metadata,
+ * one row per logged update. Runs on a worker thread, the entries and
+ * their cloned objects are not shared with any other job.
+ */
+static void writeColumnarCSV(ColumnarExportJob &job)
+{
+    QFile csvFile(job.fileName);
+
+    if (!csvFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        return;
+    }
+    QTextStream csvStream(&csvFile);
+
+    UAVDataObject *object = job.entries.first()->uavObject();
+    csvStream << "Flight" << '\t' << "Flight Time";
+    foreach(UAVObjectField * field, object->getFields()) {
+        if (field->getNumElements() > 1) {
+            foreach(QString elementName, field->getElementNames()) {
+                csvStream << '\t' << field->getName() << '-' << elementName;
+            }
+        } else {
+            csvStream << '\t' << field->getName();
+        }
+    }
+    csvStream << '\n';
+
+    foreach(ExtendedDebugLogEntry * entry, job.entries) {
+        entry->toColumnarCSV(&csvStream, job.baseTimes.value(entry->getFlight(), 0));
+    }
+
+    csvStream.flush();
+    csvFile.flush();
+    csvFile.close();
+}
+
+/**
+ * Columnar export for analysis tools: one CSV file per object type with
+ * a column per field element, so the result loads straight into a data
+ * frame without replaying or scraping the row oriented export. The
+ * object types are converted in parallel, each job owns its file.
+ */
+void FlightLogManager::exportToColumnarCSV(QString fileName)
+{
+    // one output file per object type
+    fileName.replace(QString(".csv"), QString("_%1.csv"));
+
+    QMap<QString, ColumnarExportJob> jobsByObject;
+    QMap<quint16, quint32> baseTimes;
+
+    foreach(ExtendedDebugLogEntry * entry, m_logEntries) {
+        if (m_adjustExportedTimestamps && !baseTimes.contains(entry->getFlight())) {
+            baseTimes[entry->getFlight()] = entry->getFlightTime();
+        }
+        if (entry->getType() == DebugLogEntry::TYPE_UAVOBJECT || entry->getType() == DebugLogEntry::TYPE_MULTIPLEUAVOBJECTS) {
+            jobsByObject[entry->uavObject()->getName()].entries << entry;
+        }
+    }
+
+    QList<ColumnarExportJob> jobs;
+    QMapIterator<QString, ColumnarExportJob> iter(jobsByObject);
+    while (iter.hasNext()) {
+        iter.next();
+        ColumnarExportJob job = iter.value();
+        job.fileName  = fileName.arg(iter.key());
+        job.baseTimes = baseTimes;
+        jobs << job;
+    }
+
+    QtConcurrent::blockingMap(jobs, writeColumnarCSV);
+}
+
 void FlightLogManager::exportToXML(QString fileName)
 {
     QFile xmlFile(fileName);
@@ -383,12 +486,13 @@ void FlightLogManager::exportLogs()
 
     QString oplFilter = tr("OpenPilot Log file %1").arg("(*.opl)");
     QString csvFilter = tr("Text file %1").arg("(*.csv)");
+    QString columnarCsvFilter = tr("Columnar text files, one per object %1").arg("(*.csv)");
     QString xmlFilter = tr("XML file %1").arg("(*.xml)");
 
     QString selectedFilter = csvFilter;
 
     QString fileName = QFileDialog::getSaveFileName(NULL, tr("Save Log Entries"), QDir::homePath(),
-                                                    QString("%1;;%2;;%3").arg(oplFilter, csvFilter, xmlFilter), &selectedFilter);
+                                                    QString("%1;;%2;;%3;;%4").arg(oplFilter, csvFilter, columnarCsvFilter, xmlFilter), &selectedFilter);
     if (!fileName.isEmpty()) {
         if (selectedFilter == oplFilter) {
             if (!fileName.endsWith(".opl")) {
@@ -400,6 +504,11 @@ void FlightLogManager::exportLogs()
                 fileName.append(".csv");
             }
             exportToCSV(fileName);
+        } else if (selectedFilter == columnarCsvFilter) {
+            if (!fileName.endsWith(".csv")) {
+                fileName.append(".csv");
+            }
+            exportToColumnarCSV(fileName);
         } else if (selectedFilter == xmlFilter) {
             if (!fileName.endsWith(".xml")) {
                 fileName.append(".xml");
@@ -676,6 +785,17 @@ void ExtendedDebugLogEntry::toCSV(QTextStream *csvStream, quint32 baseTime)
     *csvStream << QString::number(getFlight() + 1) << '\t' << QString::number(getFlightTime() - baseTime) << '\t' << QString::number(getEntry()) << '\t' << data << '\n';
 }
 
+void ExtendedDebugLogEntry::toColumnarCSV(QTextStream *csvStream, quint32 baseTime)
+{
+    *csvStream << QString::number(getFlight() + 1) << '\t' << QString::number(getFlightTime() - baseTime);
+    foreach(UAVObjectField * field, m_object->getFields()) {
+        for (quint32 i = 0; i < field->getNumElements(); i++) {
+            *csvStream << '\t' << field->getValue(i).toString();
+        }
+    }
+    *csvStream << '\n';
+}
+
 void ExtendedDebugLogEntry::setData(const DebugLogEntry::DataFields &data, UAVObjectManager *objectManager)
 {
     DebugLogEntry::setData(data);
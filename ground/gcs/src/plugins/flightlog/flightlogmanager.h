@@ -45,6 +45,9 @@
 #include "objectpersistence.h"
 #include "uavtalk/telemetrymanager.h"
 
+class UAVObjectUpdaterHelper;
+class UAVObjectRequestHelper;
+
 class UAVOLogSettingsWrapper : public QObject {
     Q_OBJECT Q_PROPERTY(UAVDataObject *object READ object NOTIFY objectChanged)
     Q_PROPERTY(QString name READ name NOTIFY nameChanged)
@@ -147,6 +150,7 @@ public:
     QString getLogString();
     void toXML(QXmlStreamWriter *xmlWriter, quint32 baseTime);
     void toCSV(QTextStream *csvStream, quint32 baseTime);
+    void toColumnarCSV(QTextStream *csvStream, quint32 baseTime);
     UAVDataObject *uavObject()
     {
         return m_object;
@@ -340,8 +344,12 @@ private:
 
     void exportToOPL(QString fileName);
     void exportToCSV(QString fileName);
+    void exportToColumnarCSV(QString fileName);
     void exportToXML(QString fileName);
 
+    bool retrieveLogEntry(int flight, int slot,
+                          UAVObjectUpdaterHelper &updateHelper, UAVObjectRequestHelper &requestHelper);
+
     static const int UAVTALK_TIMEOUT = 4000;
     static const int LOG_SETTINGS_FILE_VERSION = 1;
     bool m_disableControls;
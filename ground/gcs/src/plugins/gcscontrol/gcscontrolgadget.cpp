@@ -32,7 +32,16 @@
 #include "uavobject.h"
 #include <QDebug>
 
-#define JOYSTICK_UPDATE_RATE 50
+// how often the measured input-to-transmit latency is reported
+#define LATENCY_REPORT_INTERVAL 5000
+
+// keepalive period while the sticks are moving
+#define FULL_RATE_PERIOD        100
+// keepalive period once the sticks have been idle for IDLE_TIMEOUT,
+// stick changes are still sent immediately
+#define KEEPALIVE_PERIOD        1000
+// how long without a stick change before decaying to KEEPALIVE_PERIOD
+#define IDLE_TIMEOUT            1000
 
 GCSControlGadget::GCSControlGadget(QString classId, GCSControlGadgetWidget *widget, QWidget *parent, QObject *plugin) :
     IUAVGadget(classId, parent),
@@ -50,13 +59,23 @@ GCSControlGadget::GCSControlGadget(QString classId, GCSControlGadgetWidget *widg
 
     joystickTime.start();
     GCSControlPlugin *pl = dynamic_cast<GCSControlPlugin *>(plugin);
-    connect(pl->sdlGamepad, SIGNAL(gamepads(quint8)), this, SLOT(gamepads(quint8)));
-    connect(pl->sdlGamepad, SIGNAL(buttonState(ButtonNumber, bool)), this, SLOT(buttonState(ButtonNumber, bool)));
-    connect(pl->sdlGamepad, SIGNAL(axesValues(QListInt16)), this, SLOT(axesValues(QListInt16)));
+    sdlGamepad = pl->sdlGamepad;
+    connect(sdlGamepad, SIGNAL(gamepads(quint8)), this, SLOT(gamepads(quint8)));
+    connect(sdlGamepad, SIGNAL(buttonState(ButtonNumber, bool)), this, SLOT(buttonState(ButtonNumber, bool)));
+    connect(sdlGamepad, SIGNAL(axesValues(QListInt16)), this, SLOT(axesValues(QListInt16)));
+    // capture stick input at 250 Hz while a control gadget is open
+    sdlGamepad->setLowLatencyMode(true);
+
+    // changes are sent edge triggered, the timer only refreshes the last
+    // values so the flight side keeps seeing the GCS while sticks are idle
+    activityTime.start();
+    connect(&keepaliveTimer, SIGNAL(timeout()), this, SLOT(keepaliveTimeout()));
+    keepaliveTimer.start(FULL_RATE_PERIOD);
 }
 
 GCSControlGadget::~GCSControlGadget()
 {
+    sdlGamepad->setLowLatencyMode(false);
     delete m_widget;
 }
 
@@ -235,7 +254,31 @@ void GCSControlGadget::sticksChangedLocally(double leftX, double leftY, double r
         }
         manualControlCommand->getField("Connected")->setValue("True");
         manualControlCommand->updated();
+        activityTime.restart();
+    }
+}
+
+/**
+   Periodic refresh of the last sent values. Stick changes go out edge
+   triggered the moment they happen; this timer only keeps the flight side
+   connection watchdog fed, at full rate while flying actively and at a
+   decayed rate once the sticks have been idle for a while.
+ */
+void GCSControlGadget::keepaliveTimeout()
+{
+    int period = (activityTime.elapsed() > IDLE_TIMEOUT) ? KEEPALIVE_PERIOD : FULL_RATE_PERIOD;
+
+    if (keepaliveTimer.interval() != period) {
+        keepaliveTimer.setInterval(period);
+    }
+
+    if (((GCSControlGadgetWidget *)m_widget)->getGCSControl() == false) {
+        return;
     }
+
+    ManualControlCommand *manualControlCommand = getManualControlCommand();
+    manualControlCommand->getField("Connected")->setValue("True");
+    manualControlCommand->updated();
 }
 
 void GCSControlGadget::gamepads(quint8 count)
@@ -319,6 +362,7 @@ void GCSControlGadget::readUDPCommand()
             if (update) {
                 manualControlCommand->getField("Connected")->setValue("True");
                 manualControlCommand->updated();
+                activityTime.restart();
             }
         }
     }
@@ -414,6 +458,7 @@ void GCSControlGadget::buttonState(ButtonNumber number, bool pressed)
 
         manualControlCommand->getField("Connected")->setValue("True");
         manualControlCommand->updated();
+        activityTime.restart();
     }
     // buttonSettings[number].ActionID NIDT
     // buttonSettings[number].FunctionID -RPYTAC
@@ -422,6 +467,13 @@ void GCSControlGadget::buttonState(ButtonNumber number, bool pressed)
 
 void GCSControlGadget::axesValues(QListInt16 values)
 {
+    // the queued signal payload may be stale by the time it is delivered,
+    // use it as a wake-up and read the freshest sample from the wait-free
+    // latest value slot instead
+    qint64 sampleTime = 0;
+
+    sdlGamepad->getLatestAxes(values, sampleTime);
+
     int chMax = values.length();
 
     if (rollChannel >= chMax || pitchChannel >= chMax ||
@@ -458,27 +510,31 @@ void GCSControlGadget::axesValues(QListInt16 values)
     }
 
 
-    if (joystickTime.elapsed() > JOYSTICK_UPDATE_RATE) {
+    // the signal only fires when a value changed, so every delivery may be
+    // transmitted right away without an extra rate gate
+    // Remap RPYT to left X/Y and right X/Y depending on mode
+    // Mode 1: LeftX = Yaw, LeftY = Pitch, RightX = Roll, RightY = Throttle
+    // Mode 2: LeftX = Yaw, LeftY = THrottle, RightX = Roll, RightY = Pitch
+    // Mode 3: LeftX = Roll, LeftY = Pitch, RightX = Yaw, RightY = Throttle
+    // Mode 4: LeftX = Roll, LeftY = Throttle, RightX = Yaw, RightY = Pitch;
+    switch (controlsMode) {
+    case 1:
+        sticksChangedLocally(yValue / max, -pValue / max, rValue / max, -tValue / max);
+        break;
+    case 2:
+        sticksChangedLocally(yValue / max, -tValue / max, rValue / max, -pValue / max);
+        break;
+    case 3:
+        sticksChangedLocally(rValue / max, -pValue / max, yValue / max, -tValue / max);
+        break;
+    case 4:
+        sticksChangedLocally(rValue / max, -tValue / max, yValue / max, -pValue / max);
+        break;
+    }
+
+    if ((sampleTime > 0) && (joystickTime.elapsed() > LATENCY_REPORT_INTERVAL)) {
         joystickTime.restart();
-        // Remap RPYT to left X/Y and right X/Y depending on mode
-        // Mode 1: LeftX = Yaw, LeftY = Pitch, RightX = Roll, RightY = Throttle
-        // Mode 2: LeftX = Yaw, LeftY = THrottle, RightX = Roll, RightY = Pitch
-        // Mode 3: LeftX = Roll, LeftY = Pitch, RightX = Yaw, RightY = Throttle
-        // Mode 4: LeftX = Roll, LeftY = Throttle, RightX = Yaw, RightY = Pitch;
-        switch (controlsMode) {
-        case 1:
-            sticksChangedLocally(yValue / max, -pValue / max, rValue / max, -tValue / max);
-            break;
-        case 2:
-            sticksChangedLocally(yValue / max, -tValue / max, rValue / max, -pValue / max);
-            break;
-        case 3:
-            sticksChangedLocally(rValue / max, -pValue / max, yValue / max, -tValue / max);
-            break;
-        case 4:
-            sticksChangedLocally(rValue / max, -tValue / max, yValue / max, -pValue / max);
-            break;
-        }
+        qDebug() << "GCSControl: input-to-transmit latency" << (sdlGamepad->microsNow() - sampleTime) << "us";
     }
 }
 
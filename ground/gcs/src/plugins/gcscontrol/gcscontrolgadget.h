@@ -36,6 +36,7 @@
 #include "gcscontrolplugin.h"
 #include <QUdpSocket>
 #include <QHostAddress>
+#include <QTimer>
 
 
 namespace Core {
@@ -72,6 +73,10 @@ private:
     ManualControlCommand *getManualControlCommand();
     double constrain(double value);
     QTime joystickTime;
+    // time of the last edge triggered send, drives the keepalive decay
+    QTime activityTime;
+    QTimer keepaliveTimer;
+    SDLGamepad *sdlGamepad;
     QWidget *m_widget;
     QList<int> m_context;
     UAVObject::Metadata mccInitialData;
@@ -94,6 +99,7 @@ protected slots:
     void manualControlCommandUpdated(UAVObject *);
     void sticksChangedLocally(double leftX, double leftY, double rightX, double rightY);
     void readUDPCommand();
+    void keepaliveTimeout();
 
     // signals from joystick
     void gamepads(quint8 count);
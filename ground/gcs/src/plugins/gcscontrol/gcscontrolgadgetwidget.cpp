@@ -132,8 +132,9 @@ void GCSControlGadgetWidget::toggleControl(int state)
         UAVObject::SetFlightAccess(mdata, UAVObject::ACCESS_READONLY);
         UAVObject::SetFlightTelemetryUpdateMode(mdata, UAVObject::UPDATEMODE_MANUAL);
         UAVObject::SetGcsTelemetryAcked(mdata, false);
-        UAVObject::SetGcsTelemetryUpdateMode(mdata, UAVObject::UPDATEMODE_PERIODIC);
-        mdata.gcsTelemetryUpdatePeriod = 100;
+        // manual mode : stick changes are sent immediately by the gadget,
+        // which also runs its own keepalive when the sticks are idle
+        UAVObject::SetGcsTelemetryUpdateMode(mdata, UAVObject::UPDATEMODE_MANUAL);
         m_gcscontrol->checkBoxUDPControl->setEnabled(true);
     } else {
         mdata = mccInitialData;
@@ -64,12 +64,18 @@ GpsConstellationWidget::GpsConstellationWidget(QWidget *parent) : QGraphicsView(
 
     QFontDatabase::addApplicationFont(":/gpsgadget/font/digital-7.ttf");
 
+    // Coalesce satellite updates into one scene pass per interval
+    refreshTimer.setSingleShot(true);
+    refreshTimer.setInterval(REFRESH_INTERVAL_MS);
+    connect(&refreshTimer, SIGNAL(timeout()), this, SLOT(refreshSats()));
+
     // Now create 'maxSatellites' satellite icons which we will move around on the map:
     for (int i = 0; i < MAX_SATTELITES; i++) {
         satellites[i][0] = 0;
         satellites[i][1] = 0;
         satellites[i][2] = 0;
         satellites[i][3] = 0;
+        satDirty[i]      = false;
 
         satIcons[i] = new QGraphicsSvgItem(world);
         satIcons[i]->setSharedRenderer(renderer);
@@ -117,11 +123,44 @@ void GpsConstellationWidget::updateSat(int index, int prn, int elevation, int az
         return;
     }
 
+    if ((satellites[index][0] == prn) && (satellites[index][1] == elevation)
+        && (satellites[index][2] == azimuth) && (satellites[index][3] == snr)) {
+        // receivers repeat unchanged satellites every cycle, nothing to redraw
+        return;
+    }
+
     // TODO: add range checking
     satellites[index][0] = prn;
     satellites[index][1] = elevation;
     satellites[index][2] = azimuth;
     satellites[index][3] = snr;
+    satDirty[index]      = true;
+
+    if (!refreshTimer.isActive()) {
+        refreshTimer.start();
+    }
+}
+
+/**
+ * Applies the pending satellite changes to the scene; only the items of
+ * dirty satellites are touched, so the view just repaints their regions.
+ */
+void GpsConstellationWidget::refreshSats()
+{
+    for (int index = 0; index < MAX_SATTELITES; index++) {
+        if (satDirty[index]) {
+            satDirty[index] = false;
+            applySat(index);
+        }
+    }
+}
+
+void GpsConstellationWidget::applySat(int index)
+{
+    const int prn       = satellites[index][0];
+    const int elevation = satellites[index][1];
+    const int azimuth   = satellites[index][2];
+    const int snr       = satellites[index][3];
 
     if (prn && elevation >= 0) {
         QPointF opd = polarToCoord(elevation, azimuth);
@@ -29,6 +29,7 @@
 #define GPSCONSTELLATIONWIDGET_H_
 
 #include <QGraphicsView>
+#include <QTimer>
 #include <QtSvg/QSvgRenderer>
 #include <QtSvg/QGraphicsSvgItem>
 
@@ -45,16 +46,22 @@ public slots:
 
 
 private slots:
+    void refreshSats();
 
 private:
     static const int MAX_SATTELITES = 16;
+    // scene refresh rate cap, satellite updates arrive per sentence
+    static const int REFRESH_INTERVAL_MS = 100;
     int satellites[MAX_SATTELITES][4];
+    bool satDirty[MAX_SATTELITES];
+    QTimer refreshTimer;
     QGraphicsScene *scene;
     QSvgRenderer *renderer;
     QGraphicsSvgItem *world;
     QGraphicsSvgItem *satIcons[MAX_SATTELITES];
     QGraphicsSimpleTextItem *satTexts[MAX_SATTELITES];
 
+    void applySat(int index);
     QPointF polarToCoord(int elevation, int azimuth);
 
 protected:
@@ -7,15 +7,12 @@ include(../../plugin.pri)
 include(../../plugins/coreplugin/coreplugin.pri)
 include(gpsdisplay_dependencies.pri)
 include(../../libs/qwt/qwt.pri)
+include(gpsparsers.pri)
 
 HEADERS += \
     gpsdisplayplugin.h \
     gpsconstellationwidget.h \
-    gpsparser.h \
-    telemetryparser.h \
     gpssnrwidget.h \
-    buffer.h \
-    nmeaparser.h \
     gpsdisplaygadget.h \
     gpsdisplaywidget.h \
     gpsdisplaygadgetfactory.h \
@@ -25,11 +22,7 @@ HEADERS += \
 SOURCES += \
     gpsdisplayplugin.cpp \
     gpsconstellationwidget.cpp \
-    gpsparser.cpp \
-    telemetryparser.cpp \
     gpssnrwidget.cpp \
-    buffer.cpp \
-    nmeaparser.cpp \
     gpsdisplaygadget.cpp \
     gpsdisplaygadgetfactory.cpp \
     gpsdisplaywidget.cpp \
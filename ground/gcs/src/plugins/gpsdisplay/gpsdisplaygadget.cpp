@@ -78,9 +78,14 @@ void GpsDisplayGadget::loadConfiguration(IUAVGadgetConfiguration *config)
         QList<QSerialPortInfo> ports = QSerialPortInfo::availablePorts();
         foreach(QSerialPortInfo nport, ports) {
             if (nport.portName() == gpsDisplayConfig->port()) {
-                qDebug() << "Using Serial parser";
-                parser = new NMEAParser();
-                port   = new QSerialPort(nport);
+                if (gpsDisplayConfig->dataProtocol() == "UBX") {
+                    qDebug() << "Using UBX parser";
+                    parser = new UBXParser();
+                } else {
+                    qDebug() << "Using NMEA parser";
+                    parser = new NMEAParser();
+                }
+                port = new QSerialPort(nport);
                 m_widget->connectButton->setEnabled(true);
                 m_widget->disconnectButton->setEnabled(false);
                 m_widget->connectButton->setHidden(false);
@@ -166,10 +171,6 @@ void GpsDisplayGadget::onDataAvailable()
 
 void GpsDisplayGadget::processNewSerialData(QByteArray serialData)
 {
-    int dataLength   = serialData.size();
-    const char *data = serialData.constData();
-
-    for (int pos = 0; pos < dataLength; pos++) {
-        parser->processInputStream(data[pos]);
-    }
+    // hand the parser the whole chunk, it scans for sentences in bulk
+    parser->processInputBuffer(serialData.constData(), serialData.size());
 }
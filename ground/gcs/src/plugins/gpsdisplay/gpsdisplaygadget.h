@@ -33,6 +33,7 @@
 #include <coreplugin/iuavgadget.h>
 #include "gpsdisplaywidget.h"
 #include "nmeaparser.h"
+#include "ubxparser.h"
 #include "telemetryparser.h"
 
 class IUAVGadget;
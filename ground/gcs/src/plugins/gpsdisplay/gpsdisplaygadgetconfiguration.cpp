@@ -36,6 +36,7 @@
 GpsDisplayGadgetConfiguration::GpsDisplayGadgetConfiguration(QString classId, QSettings *qSettings, QObject *parent) :
     IUAVGadgetConfiguration(classId, parent),
     m_connectionMode("Serial"),
+    m_dataProtocol("NMEA"),
     m_defaultPort("Unknown"),
     m_defaultSpeed(QSerialPort::UnknownBaud),
     m_defaultDataBits(QSerialPort::UnknownDataBits),
@@ -57,8 +58,9 @@ GpsDisplayGadgetConfiguration::GpsDisplayGadgetConfiguration(QString classId, QS
         int iflow       = qSettings->value("defaultFlow").toInt();
         int iparity     = qSettings->value("defaultParity").toInt();
         int istopbits   = qSettings->value("defaultStopBits").toInt();
-        QString port    = qSettings->value("defaultPort").toString();
-        QString conMode = qSettings->value("connectionMode").toString();
+        QString port     = qSettings->value("defaultPort").toString();
+        QString conMode  = qSettings->value("connectionMode").toString();
+        QString protocol = qSettings->value("dataProtocol", "NMEA").toString();
 
         databits = (QSerialPort::DataBits)idatabits;
         flow     = (QSerialPort::FlowControl)iflow;
@@ -72,6 +74,7 @@ GpsDisplayGadgetConfiguration::GpsDisplayGadgetConfiguration(QString classId, QS
         m_defaultParity   = parity;
         m_defaultStopBits = stopbits;
         m_connectionMode  = conMode;
+        m_dataProtocol    = protocol;
     }
 }
 
@@ -90,6 +93,7 @@ IUAVGadgetConfiguration *GpsDisplayGadgetConfiguration::clone()
     m->m_defaultStopBits = m_defaultStopBits;
     m->m_defaultPort     = m_defaultPort;
     m->m_connectionMode  = m_connectionMode;
+    m->m_dataProtocol    = m_dataProtocol;
     return m;
 }
 
@@ -106,4 +110,5 @@ void GpsDisplayGadgetConfiguration::saveConfig(QSettings *settings) const
     settings->setValue("defaultStopBits", m_defaultStopBits);
     settings->setValue("defaultPort", m_defaultPort);
     settings->setValue("connectionMode", m_connectionMode);
+    settings->setValue("dataProtocol", m_dataProtocol);
 }
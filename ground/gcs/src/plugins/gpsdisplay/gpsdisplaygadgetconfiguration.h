@@ -60,6 +60,15 @@ public:
         return m_connectionMode;
     }
 
+    void setDataProtocol(QString protocol)
+    {
+        m_dataProtocol = protocol;
+    }
+    QString dataProtocol()
+    {
+        return m_dataProtocol;
+    }
+
     // set port configuration functions
     void setSpeed(QSerialPort::BaudRate speed)
     {
@@ -125,6 +134,7 @@ public:
 
 private:
     QString m_connectionMode;
+    QString m_dataProtocol;
     QString m_defaultPort;
     QSerialPort::BaudRate m_defaultSpeed;
     QSerialPort::DataBits m_defaultDataBits;
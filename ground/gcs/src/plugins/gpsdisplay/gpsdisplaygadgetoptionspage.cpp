@@ -133,6 +133,15 @@ QWidget *GpsDisplayGadgetOptionsPage::createPage(QWidget *parent)
     // TIMEOUT
     options_page->timeoutSpinBox->setValue(m_config->timeOut());
 
+    // PROTOCOL
+    QStringList dataProtocols;
+    dataProtocols << "NMEA" << "UBX";
+    options_page->protocolComboBox->addItems(dataProtocols);
+    int protocolIndex = options_page->protocolComboBox->findText(m_config->dataProtocol());
+    if (protocolIndex != -1) {
+        options_page->protocolComboBox->setCurrentIndex(protocolIndex);
+    }
+
     QStringList connectionModes;
     connectionModes << "Serial" << "Network" << "Telemetry";
     options_page->connectionMode->addItems(connectionModes);
@@ -165,6 +174,7 @@ void GpsDisplayGadgetOptionsPage::apply()
     m_config->setParity((QSerialPort::Parity)options_page->parityComboBox->itemData(options_page->parityComboBox->currentIndex()).toInt());
     m_config->setTimeOut(options_page->timeoutSpinBox->value());
     m_config->setConnectionMode(options_page->connectionMode->currentText());
+    m_config->setDataProtocol(options_page->protocolComboBox->currentText());
 }
 
 void GpsDisplayGadgetOptionsPage::finish()
@@ -36,6 +36,8 @@ class GPSParser : public QObject {
     Q_OBJECT
 public: ~GPSParser();
     virtual void processInputStream(char c);
+    // ! Default implementation feeds the stream one byte at a time
+    virtual void processInputBuffer(const char *data, int length);
 
 protected:
     GPSParser(QObject *parent = 0);
@@ -43,6 +45,7 @@ protected:
 signals:
     void sv(int); // Satellites in view
     void position(double, double, double); // Lat, Lon, Alt
+    void home(double, double, double); // Lat, Lon, Alt
     void datetime(double, double); // Date then time
     void speedheading(double, double);
     void packet(QString); // Raw NMEA Packet (or just info)
@@ -0,0 +1,20 @@
+# GPS parser infrastructure shared with other gadgets (antennatrack).
+# The parsers are compiled into each consuming plugin, there is no
+# separate library to link against.
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/scanringbuffer.h \
+    $$PWD/gpsparser.h \
+    $$PWD/gpstelemetryhub.h \
+    $$PWD/telemetryparser.h \
+    $$PWD/nmeaparser.h \
+    $$PWD/ubxparser.h
+
+SOURCES += \
+    $$PWD/scanringbuffer.cpp \
+    $$PWD/gpsparser.cpp \
+    $$PWD/gpstelemetryhub.cpp \
+    $$PWD/telemetryparser.cpp \
+    $$PWD/nmeaparser.cpp \
+    $$PWD/ubxparser.cpp
@@ -6,12 +6,18 @@ GpsSnrWidget::GpsSnrWidget(QWidget *parent) :
     scene = new QGraphicsScene(this);
     setScene(scene);
 
+    // Coalesce satellite updates into one scene pass per interval
+    refreshTimer.setSingleShot(true);
+    refreshTimer.setInterval(REFRESH_INTERVAL_MS);
+    connect(&refreshTimer, SIGNAL(timeout()), this, SLOT(refreshSats()));
+
     // Now create 'maxSatellites' satellite icons which we will move around on the map:
     for (int i = 0; i < MAX_SATTELITES; i++) {
         satellites[i][0] = 0;
         satellites[i][1] = 0;
         satellites[i][2] = 0;
         satellites[i][3] = 0;
+        satDirty[i]      = false;
 
         boxes[i] = new QGraphicsRectItem();
         boxes[i]->setBrush(QColor("Green"));
@@ -59,13 +65,36 @@ void GpsSnrWidget::updateSat(int index, int prn, int elevation, int azimuth, int
         return;
     }
 
+    if ((satellites[index][0] == prn) && (satellites[index][1] == elevation)
+        && (satellites[index][2] == azimuth) && (satellites[index][3] == snr)) {
+        // receivers repeat unchanged satellites every cycle, nothing to redraw
+        return;
+    }
+
     // TODO: add range checking
     satellites[index][0] = prn;
     satellites[index][1] = elevation;
     satellites[index][2] = azimuth;
     satellites[index][3] = snr;
+    satDirty[index]      = true;
 
-    drawSat(index);
+    if (!refreshTimer.isActive()) {
+        refreshTimer.start();
+    }
+}
+
+/**
+ * Draws the pending satellite changes; only the items of dirty satellites
+ * are touched, so the view just repaints their regions.
+ */
+void GpsSnrWidget::refreshSats()
+{
+    for (int index = 0; index < MAX_SATTELITES; index++) {
+        if (satDirty[index]) {
+            satDirty[index] = false;
+            drawSat(index);
+        }
+    }
 }
 
 void GpsSnrWidget::drawSat(int index)
@@ -3,6 +3,7 @@
 
 #include <QGraphicsView>
 #include <QGraphicsRectItem>
+#include <QTimer>
 
 class GpsSnrWidget : public QGraphicsView {
     Q_OBJECT
@@ -15,9 +16,16 @@ signals:
 public slots:
     void updateSat(int index, int prn, int elevation, int azimuth, int snr);
 
+private slots:
+    void refreshSats();
+
 private:
     static const int MAX_SATTELITES = 16;
+    // scene refresh rate cap, satellite updates arrive per sentence
+    static const int REFRESH_INTERVAL_MS = 100;
     int satellites[MAX_SATTELITES][4];
+    bool satDirty[MAX_SATTELITES];
+    QTimer refreshTimer;
     QGraphicsScene *scene;
     QGraphicsRectItem *boxes[MAX_SATTELITES];
     QGraphicsSimpleTextItem *satTexts[MAX_SATTELITES];
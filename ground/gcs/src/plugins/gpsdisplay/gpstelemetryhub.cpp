@@ -0,0 +1,239 @@
+/**
+ ******************************************************************************
+ *
+ * @file       gpstelemetryhub.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GPSGadgetPlugin GPS Gadget Plugin
+ * @{
+ * @brief A gadget that displays GPS status and enables basic configuration
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "gpstelemetryhub.h"
+#include "extensionsystem/pluginmanager.h"
+#include "uavobjectmanager.h"
+#include <QDebug>
+
+/**
+ * Returns the process wide hub, creating and registering it on first use.
+ *
+ * The hub is looked up through the plugin manager rather than a plain
+ * static so the copies of this code compiled into different plugins all
+ * resolve to the same instance.
+ */
+GPSTelemetryHub *GPSTelemetryHub::instance()
+{
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    GPSTelemetryHub *hub = pm->getObject<GPSTelemetryHub>();
+
+    if (!hub) {
+        hub = new GPSTelemetryHub();
+        pm->addObject(hub);
+    }
+    return hub;
+}
+
+/**
+ * Subscribe to the GPS objects, this is done once per process
+ */
+GPSTelemetryHub::GPSTelemetryHub(QObject *parent) : QObject(parent),
+    m_hasFix(false), m_hasHome(false), m_hasTime(false),
+    m_sv(0),
+    m_latitude(0), m_longitude(0), m_altitude(0),
+    m_groundspeed(0), m_heading(0),
+    m_hdop(0), m_vdop(0), m_pdop(0),
+    m_homeLatitude(0), m_homeLongitude(0), m_homeAltitude(0),
+    m_date(0), m_time(0)
+{
+    for (int i = 0; i < GPS_HUB_MAX_SATELLITES; i++) {
+        m_satellites[i].prn       = -1;
+        m_satellites[i].elevation = 0;
+        m_satellites[i].azimuth   = 0;
+        m_satellites[i].snr       = 0;
+    }
+
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+    UAVDataObject *gpsObj = dynamic_cast<UAVDataObject *>(objManager->getObject("GPSPositionSensor"));
+
+    if (gpsObj != NULL) {
+        connect(gpsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateGPS(UAVObject *)));
+    } else {
+        qDebug() << "Error: Object is unknown (GPSPositionSensor).";
+    }
+
+    gpsObj = dynamic_cast<UAVDataObject *>(objManager->getObject("HomeLocation"));
+    if (gpsObj != NULL) {
+        connect(gpsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateHome(UAVObject *)));
+    } else {
+        qDebug() << "Error: Object is unknown (HomeLocation).";
+    }
+
+    gpsObj = dynamic_cast<UAVDataObject *>(objManager->getObject("GPSTime"));
+    if (gpsObj != NULL) {
+        connect(gpsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateTime(UAVObject *)));
+    } else {
+        qDebug() << "Error: Object is unknown (GPSTime).";
+    }
+
+    gpsObj = dynamic_cast<UAVDataObject *>(objManager->getObject("GPSSatellites"));
+    if (gpsObj != NULL) {
+        connect(gpsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateSats(UAVObject *)));
+    }
+}
+
+void GPSTelemetryHub::replay()
+{
+    if (m_hasFix) {
+        emit svChanged(m_sv);
+        emit positionChanged(m_latitude, m_longitude, m_altitude);
+        emit speedheadingChanged(m_groundspeed, m_heading);
+        emit fixtypeChanged(m_fixType);
+        emit dopChanged(m_hdop, m_vdop, m_pdop);
+    }
+    if (m_hasHome) {
+        emit homeChanged(m_homeLatitude, m_homeLongitude, m_homeAltitude);
+    }
+    if (m_hasTime) {
+        emit datetimeChanged(m_date, m_time);
+    }
+    for (int i = 0; i < GPS_HUB_MAX_SATELLITES; i++) {
+        if (m_satellites[i].prn >= 0) {
+            emit satelliteChanged(i, m_satellites[i].prn, m_satellites[i].elevation,
+                                  m_satellites[i].azimuth, m_satellites[i].snr);
+        }
+    }
+}
+
+void GPSTelemetryHub::updateGPS(UAVObject *object1)
+{
+    int sv     = object1->getField(QString("Satellites"))->getValue().toInt();
+
+    double lat = object1->getField(QString("Latitude"))->getDouble() * 1E-7;
+    double lon = object1->getField(QString("Longitude"))->getDouble() * 1E-7;
+    double alt = object1->getField(QString("Altitude"))->getDouble();
+
+    double hdg = object1->getField(QString("Heading"))->getDouble();
+    double spd = object1->getField(QString("Groundspeed"))->getDouble();
+
+    QString fix = object1->getField(QString("Status"))->getValue().toString();
+
+    double hdop = object1->getField(QString("HDOP"))->getDouble();
+    double vdop = object1->getField(QString("VDOP"))->getDouble();
+    double pdop = object1->getField(QString("PDOP"))->getDouble();
+
+    // the source fields are integers or enums, so values that did not
+    // change convert to bit identical doubles and compare exactly
+    bool first = !m_hasFix;
+    m_hasFix = true;
+
+    if (first || (sv != m_sv)) {
+        m_sv = sv;
+        emit svChanged(sv);
+    }
+    if (first || (lat != m_latitude) || (lon != m_longitude) || (alt != m_altitude)) {
+        m_latitude  = lat;
+        m_longitude = lon;
+        m_altitude  = alt;
+        emit positionChanged(lat, lon, alt);
+    }
+    if (first || (spd != m_groundspeed) || (hdg != m_heading)) {
+        m_groundspeed = spd;
+        m_heading     = hdg;
+        emit speedheadingChanged(spd, hdg);
+    }
+    if (first || (fix != m_fixType)) {
+        m_fixType = fix;
+        emit fixtypeChanged(fix);
+    }
+    if (first || (hdop != m_hdop) || (vdop != m_vdop) || (pdop != m_pdop)) {
+        m_hdop = hdop;
+        m_vdop = vdop;
+        m_pdop = pdop;
+        emit dopChanged(hdop, vdop, pdop);
+    }
+}
+
+void GPSTelemetryHub::updateHome(UAVObject *object1)
+{
+    double lat = object1->getField(QString("Latitude"))->getDouble() * 1E-7;
+    double lon = object1->getField(QString("Longitude"))->getDouble() * 1E-7;
+    double alt = object1->getField(QString("Altitude"))->getDouble();
+
+    if (!m_hasHome || (lat != m_homeLatitude) || (lon != m_homeLongitude) || (alt != m_homeAltitude)) {
+        m_hasHome = true;
+        m_homeLatitude  = lat;
+        m_homeLongitude = lon;
+        m_homeAltitude  = alt;
+        emit homeChanged(lat, lon, alt);
+    }
+}
+
+void GPSTelemetryHub::updateTime(UAVObject *object1)
+{
+    double hour   = object1->getField(QString("Hour"))->getDouble();
+    double minute = object1->getField(QString("Minute"))->getDouble();
+    double second = object1->getField(QString("Second"))->getDouble();
+    double time   = second + minute * 100 + hour * 10000;
+    double year   = object1->getField(QString("Year"))->getDouble();
+    double month  = object1->getField(QString("Month"))->getDouble();
+    double day    = object1->getField(QString("Day"))->getDouble();
+    double date   = day + month * 100 + year * 10000;
+
+    if (!m_hasTime || (date != m_date) || (time != m_time)) {
+        m_hasTime = true;
+        m_date    = date;
+        m_time    = time;
+        emit datetimeChanged(date, time);
+    }
+}
+
+/**
+ * Updates the satellite constellation.
+ *
+ * Only the channels whose data actually changed are emitted, so a
+ * steady constellation costs the consumers nothing per update.
+ */
+void GPSTelemetryHub::updateSats(UAVObject *object1)
+{
+    UAVObjectField *prn       = object1->getField(QString("PRN"));
+    UAVObjectField *elevation = object1->getField(QString("Elevation"));
+    UAVObjectField *azimuth   = object1->getField(QString("Azimuth"));
+    UAVObjectField *snr       = object1->getField(QString("SNR"));
+
+    int channels = prn->getNumElements();
+
+    if (channels > GPS_HUB_MAX_SATELLITES) {
+        channels = GPS_HUB_MAX_SATELLITES;
+    }
+
+    for (int i = 0; i < channels; i++) {
+        Satellite sat;
+        sat.prn       = prn->getValue(i).toInt();
+        sat.elevation = elevation->getValue(i).toInt();
+        sat.azimuth   = azimuth->getValue(i).toInt();
+        sat.snr       = snr->getValue(i).toInt();
+
+        if ((sat.prn != m_satellites[i].prn) || (sat.elevation != m_satellites[i].elevation)
+            || (sat.azimuth != m_satellites[i].azimuth) || (sat.snr != m_satellites[i].snr)) {
+            m_satellites[i] = sat;
+            emit satelliteChanged(i, sat.prn, sat.elevation, sat.azimuth, sat.snr);
+        }
+    }
+}
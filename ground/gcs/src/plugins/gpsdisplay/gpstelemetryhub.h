@@ -0,0 +1,107 @@
+/**
+ ******************************************************************************
+ *
+ * @file       gpstelemetryhub.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GPSGadgetPlugin GPS Gadget Plugin
+ * @{
+ * @brief A gadget that displays GPS status and enables basic configuration
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef GPSTELEMETRYHUB_H
+#define GPSTELEMETRYHUB_H
+
+#include <QObject>
+#include <QtCore>
+#include "uavobject.h"
+
+// GPSSatellites carries this many channels
+#define GPS_HUB_MAX_SATELLITES 16
+
+/**
+ * Converts the GPS UAVObjects (GPSPositionSensor, HomeLocation, GPSTime,
+ * GPSSatellites) into display-ready values exactly once per telemetry
+ * update and fans the result out to every interested gadget.
+ *
+ * Each consumer used to subscribe to the objects itself and redo the
+ * field lookups and QVariant conversions, so N open gadgets cost N
+ * conversions per update. The hub does the conversion once, keeps the
+ * last converted state and only emits the signals whose values actually
+ * changed, so unchanged satellites or a steady fix type cause no redraws
+ * at all.
+ *
+ * The hub is registered with the plugin manager on first use so all the
+ * plugins this file is compiled into (gpsdisplay, antennatrack) share a
+ * single instance.
+ */
+class GPSTelemetryHub : public QObject {
+    Q_OBJECT
+
+public:
+    static GPSTelemetryHub *instance();
+
+public slots:
+    // ! Re-emits the cached state so a consumer connected after the last
+    // ! telemetry update still gets the current picture. Cheap enough that
+    // ! the other consumers repainting once does not matter.
+    void replay();
+
+signals:
+    void svChanged(int);
+    void positionChanged(double, double, double); // Lat, Lon, Alt
+    void homeChanged(double, double, double); // Lat, Lon, Alt
+    void datetimeChanged(double, double); // Date then time
+    void speedheadingChanged(double, double);
+    void fixtypeChanged(QString);
+    void dopChanged(double, double, double); // HDOP, VDOP, PDOP
+    void satelliteChanged(int, int, int, int, int); // Index, PRN, Elevation, Azimuth, SNR
+
+private slots:
+    void updateGPS(UAVObject *object1);
+    void updateHome(UAVObject *object1);
+    void updateTime(UAVObject *object1);
+    void updateSats(UAVObject *object1);
+
+private:
+    GPSTelemetryHub(QObject *parent = 0);
+
+    // ! One converted GPSSatellites channel
+    struct Satellite {
+        int prn;
+        int elevation;
+        int azimuth;
+        int snr;
+    };
+
+    // last converted state, used to mask out unchanged notifications
+    bool m_hasFix;
+    bool m_hasHome;
+    bool m_hasTime;
+    int  m_sv;
+    double m_latitude, m_longitude, m_altitude;
+    double m_groundspeed, m_heading;
+    double m_hdop, m_vdop, m_pdop;
+    QString m_fixType;
+    double m_homeLatitude, m_homeLongitude, m_homeAltitude;
+    double m_date, m_time;
+    Satellite m_satellites[GPS_HUB_MAX_SATELLITES];
+};
+
+#endif // GPSTELEMETRYHUB_H
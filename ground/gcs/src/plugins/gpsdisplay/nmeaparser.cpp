@@ -29,11 +29,9 @@
 #include "nmeaparser.h"
 #include <iostream>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <QDebug>
-#include <QStringList>
-#include <QWidget>
-#include <QVBoxLayout>
-#include <QPushButton>
 
 // Message Codes
 #define NMEA_NODATA    0       // No data. Packet not available, bad, or not decoded
@@ -65,53 +63,95 @@
 /**
  * Initialize the parser
  */
-NMEAParser::NMEAParser(QObject *parent) : GPSParser(parent)
+NMEAParser::NMEAParser(QObject *parent) : GPSParser(parent), m_scanBuffer(2 * NMEA_BUFFERSIZE)
 {
-    bufferInit(&gpsRxBuffer, (unsigned char *)gpsRxData, 512);
+    numUpdates    = 0;
+    numErrors     = 0;
     gpsRxOverflow = 0;
+    m_fieldCount  = 0;
 }
 
 NMEAParser::~NMEAParser()
 {}
 
 /**
- * Called each time there are data in the input buffer
+ * Called for a single input byte, kept for sources that cannot deliver chunks
  */
 void NMEAParser::processInputStream(char c)
 {
-    if (!bufferAddToEnd(&gpsRxBuffer, c)) {
-        // no space in buffer
-        // count overflow
+    processInputBuffer(&c, 1);
+}
+
+/**
+ * Called with each chunk read from the input device.
+ *
+ * Scans the accumulated bytes for complete sentences in one pass instead of
+ * shifting a circular buffer per character; everything before an unterminated
+ * sentence is consumed, so the scan buffer stays small.
+ */
+void NMEAParser::processInputBuffer(const char *data, int length)
+{
+    // the ring bounds the unscanned backlog; a stream without terminators
+    // cannot fit forever and is dropped like a buffer overflow, keeping
+    // the newest bytes to resynchronize on
+    if (m_scanBuffer.write(data, length) < length) {
         gpsRxOverflow++;
-        return;
+        m_scanBuffer.clear();
+        int keep = (length < m_scanBuffer.capacity()) ? length : m_scanBuffer.capacity();
+        m_scanBuffer.write(data + (length - keep), keep);
     }
-    nmeaProcess(&gpsRxBuffer);
-}
 
+    int avail;
+    const char *view = m_scanBuffer.peek(avail);
+    int scanned      = 0;
+    while (scanned < avail) {
+        // look for a start of NMEA sentence
+        int start = m_scanBuffer.indexOf('$', scanned);
+        if (start < 0) {
+            // nothing but garbage left
+            scanned = avail;
+            break;
+        }
+        // look for the end of the sentence <CR><LF>
+        int end = m_scanBuffer.indexOf('\r', '\n', start + 1);
+        if (end < 0) {
+            // sentence not completely received yet, keep it for the next chunk
+            scanned = start;
+            break;
+        }
+        // dispatch the sentence body between '$' and <CR>
+        nmeaDispatch(view + start + 1, end - (start + 1));
+        scanned = end + 2;
+    }
+    m_scanBuffer.consume(scanned);
+}
 
 /**
- * Prosesses NMEA sentence checksum
- * \param[in] Buffer for parsed nmea sentence
+ * Prosesses NMEA sentence checksum, XOR over the sentence span
+ * \param[in] sentence body between '$' and the line end
+ * \param[in] length of the body
  * \return 0 checksum not valid
  * \return 1 checksum valid
  */
-char NMEAParser::nmeaChecksum(char *gps_buffer)
+char NMEAParser::nmeaChecksum(const char *sentence, int length)
 {
     char checksum = 0;
     char checksum_received = 0;
+    int x;
 
-    for (int x = 0; x < NMEA_BUFFERSIZE; x++) {
-        if (gps_buffer[x] == '*') {
+    for (x = 0; x < length; x++) {
+        if (sentence[x] == '*') {
             // Parsing received checksum...
-            checksum_received = strtol(&gps_buffer[x + 1], NULL, 16);
+            // the span is followed by <CR> in the scan buffer, which stops strtol
+            checksum_received = strtol(&sentence[x + 1], NULL, 16);
 
             break;
         } else {
             // XOR the received data...
-            checksum ^= gps_buffer[x];
+            checksum ^= sentence[x];
         }
     }
-    if (checksum == checksum_received) {
+    if ((x < length) && (checksum == checksum_received)) {
         ++numUpdates;
         return 1;
     } else {
@@ -120,163 +160,137 @@ char NMEAParser::nmeaChecksum(char *gps_buffer)
     }
 }
 
-void NMEAParser::nmeaTerminateAtChecksum(char *gps_buffer)
+/**
+ * Splits the sentence into comma separated fields.
+ *
+ * The fields stay where they are in the scan buffer, only their spans are
+ * recorded; the accessors below convert the values in place.
+ * \return number of fields found, field 0 is the sentence type
+ */
+int NMEAParser::nmeaScanFields(const char *sentence, int length)
 {
-    for (int x = 0; x < NMEA_BUFFERSIZE; x++) {
-        if (gps_buffer[x] == '*') {
-            gps_buffer[x] = 0;
-            break;
+    int fieldStart = 0;
+
+    m_fieldCount = 0;
+    for (int pos = 0; pos <= length; pos++) {
+        if ((pos == length) || (sentence[pos] == ',') || (sentence[pos] == '*')) {
+            if (m_fieldCount < NMEA_MAX_FIELDS) {
+                m_fields[m_fieldCount].data   = &sentence[fieldStart];
+                m_fields[m_fieldCount].length = pos - fieldStart;
+                m_fieldCount++;
+            }
+            if ((pos == length) || (sentence[pos] == '*')) {
+                // the checksum is not a field
+                break;
+            }
+            fieldStart = pos + 1;
         }
     }
+    return m_fieldCount;
+}
+
+bool NMEAParser::fieldEmpty(int index) const
+{
+    return (index >= m_fieldCount) || (m_fields[index].length == 0);
+}
+
+char NMEAParser::fieldChar(int index) const
+{
+    return fieldEmpty(index) ? 0 : m_fields[index].data[0];
+}
+
+int NMEAParser::fieldInt(int index) const
+{
+    // the delimiter following the span stops the conversion
+    return fieldEmpty(index) ? 0 : (int)strtol(m_fields[index].data, NULL, 10);
+}
+
+double NMEAParser::fieldDouble(int index) const
+{
+    return fieldEmpty(index) ? 0.0 : strtod(m_fields[index].data, NULL);
 }
 
 /**
- * Prosesses NMEA sentences
- * \param[in] cBuffer for prosessed nmea sentences
+ * Prosesses one complete NMEA sentence
+ * \param[in] sentence body between '$' and the line end
+ * \param[in] length of the body
  * \return Message code for found packet
- * \return 0xFF NO packet found
+ * \return 0xFF packet received but not known
  */
-uint8_t NMEAParser::nmeaProcess(cBuffer *rxBuffer)
+uint8_t NMEAParser::nmeaDispatch(const char *sentence, int length)
 {
-    uint8_t foundpacket = NMEA_NODATA;
-    uint8_t startFlag   = false;
-    // u08 data;
-    uint16_t i, j;
-
-    // process the receive buffer
-    // go through buffer looking for packets
-    while (rxBuffer->datalength) {
-        // look for a start of NMEA packet
-        if (bufferGetAtIndex(rxBuffer, 0) == '$') {
-            // found start
-            startFlag = true;
-            // when start is found, we leave it intact in the receive buffer
-            // in case the full NMEA string is not completely received.  The
-            // start will be detected in the next nmeaProcess iteration.
-
-            // done looking for start
-            break;
-        } else {
-            bufferGetFromFront(rxBuffer);
-        }
-    }
+    uint8_t foundpacket = NMEA_UNKNOWN;
 
-    // if we detected a start, look for end of packet
-    if (startFlag) {
-        for (i = 1; i < (rxBuffer->datalength) - 1; i++) {
-            // check for end of NMEA packet <CR><LF>
-            if ((bufferGetAtIndex(rxBuffer, i) == '\r') && (bufferGetAtIndex(rxBuffer, i + 1) == '\n')) {
-                // have a packet end
-                // dump initial '$'
-                bufferGetFromFront(rxBuffer);
-                // copy packet to NmeaPacket
-                for (j = 0; j < (i - 1); j++) {
-                    // although NMEA strings should be 80 characters or less,
-                    // receive buffer errors can generate erroneous packets.
-                    // Protect against packet buffer overflow
-                    if (j < (NMEA_BUFFERSIZE - 1)) {
-                        NmeaPacket[j] = bufferGetFromFront(rxBuffer);
-                    } else {
-                        bufferGetFromFront(rxBuffer);
-                    }
-                }
-                // null terminate it
-                if (j < (NMEA_BUFFERSIZE - 1)) {
-                    NmeaPacket[j] = 0;
-                } else {
-                    NmeaPacket[NMEA_BUFFERSIZE - 1] = 0;
-                }
-                // dump <CR><LF> from rxBuffer
-                bufferGetFromFront(rxBuffer);
-                bufferGetFromFront(rxBuffer);
-                // DEBUG
-                                #ifdef NMEA_DEBUG_PKT
-                qDebug() << NmeaPacket;
-                                #endif
-                emit packet(QString(NmeaPacket));
-                // found a packet
-                // done with this processing session
-                foundpacket = NMEA_UNKNOWN;
-                break;
-            }
-        }
+    // DEBUG
+#ifdef NMEA_DEBUG_PKT
+    qDebug() << QString::fromLatin1(sentence, length);
+#endif
+    emit packet(QString::fromLatin1(sentence, length));
+
+    // attempt to reject empty packets right away
+    if ((length > 7) && (sentence[6] == ',') && (sentence[7] == ',')) {
+        return foundpacket;
     }
 
-    if (foundpacket) {
-        // check message type and process appropriately
-        if (!strncmp(NmeaPacket, "GPGGA", 5)) {
-            // process packet of this type
-            nmeaProcessGPGGA(NmeaPacket);
-            // report packet type
-            foundpacket = NMEA_GPGGA;
-        } else if (!strncmp(NmeaPacket, "GPVTG", 5)) {
-            // process packet of this type
-            nmeaProcessGPVTG(NmeaPacket);
-            // report packet type
-            foundpacket = NMEA_GPVTG;
-        } else if (!strncmp(NmeaPacket, "GPGSA", 5)) {
-            // process packet of this type
-            nmeaProcessGPGSA(NmeaPacket);
-            // report packet type
-            foundpacket = NMEA_GPGSA;
-        } else if (!strncmp(NmeaPacket, "GPRMC", 5)) {
-            // process packet of this type
-            nmeaProcessGPRMC(NmeaPacket);
-            // report packet type
-            foundpacket = NMEA_GPRMC;
-        } else if (!strncmp(NmeaPacket, "GPGSV", 5)) {
-            // Process packet of this type
-            nmeaProcessGPGSV(NmeaPacket);
-            // rerpot packet type
-            foundpacket = NMEA_GPGSV;
-        } else if (!strncmp(NmeaPacket, "GPZDA", 5)) {
-            // Process packet of this type
-            nmeaProcessGPZDA(NmeaPacket);
-            // rerpot packet type
-            foundpacket = NMEA_GPZDA;
-        }
-    } else if (rxBuffer->datalength >= rxBuffer->size) {
-        // if we found no packet, and the buffer is full
-        // we're logjammed, flush entire buffer
-        bufferFlush(rxBuffer);
+    if (!nmeaChecksum(sentence, length)) {
+        // checksum not valid
+        return foundpacket;
+    }
+    nmeaScanFields(sentence, length);
+
+    // check message type and process appropriately
+    if (!strncmp(sentence, "GPGGA", 5)) {
+        // process packet of this type
+        nmeaProcessGPGGA();
+        // report packet type
+        foundpacket = NMEA_GPGGA;
+    } else if (!strncmp(sentence, "GPVTG", 5)) {
+        // process packet of this type
+        nmeaProcessGPVTG();
+        // report packet type
+        foundpacket = NMEA_GPVTG;
+    } else if (!strncmp(sentence, "GPGSA", 5)) {
+        // process packet of this type
+        nmeaProcessGPGSA();
+        // report packet type
+        foundpacket = NMEA_GPGSA;
+    } else if (!strncmp(sentence, "GPRMC", 5)) {
+        // process packet of this type
+        nmeaProcessGPRMC();
+        // report packet type
+        foundpacket = NMEA_GPRMC;
+    } else if (!strncmp(sentence, "GPGSV", 5)) {
+        // Process packet of this type
+        nmeaProcessGPGSV();
+        // rerpot packet type
+        foundpacket = NMEA_GPGSV;
+    } else if (!strncmp(sentence, "GPZDA", 5)) {
+        // Process packet of this type
+        nmeaProcessGPZDA();
+        // rerpot packet type
+        foundpacket = NMEA_GPZDA;
     }
     return foundpacket;
 }
 
 /**
  * Processes NMEA GSV sentences (satellites in view)
- * \param[in] Buffer for parsed nmea GSV sentence
  */
-void NMEAParser::nmeaProcessGPGSV(char *packet)
+void NMEAParser::nmeaProcessGPGSV()
 {
-    // start parsing just after "GPGSV,"
-    // attempt to reject empty packets right away
-    if (packet[6] == ',' && packet[7] == ',') {
-        return;
-    }
-
-    if (!nmeaChecksum(packet)) {
-        // checksum not valid
-        return;
-    }
-    nmeaTerminateAtChecksum(packet);
-
-    QString nmeaString(packet);
-    QStringList tokenslist = nmeaString.split(",");
-
-
     // Officially there should be a max of three sentences (12 sats), some gps receivers do more..
 
-    const int sentence_total = tokenslist.at(1).toInt(); // Number of sentences for full data
-    const int sentence_index = tokenslist.at(2).toInt(); // sentence x of y
+    const int sentence_total = fieldInt(1); // Number of sentences for full data
+    const int sentence_index = fieldInt(2); // sentence x of y
+
+    int sats = (m_fieldCount - 4) / 4;
 
-    int sats = (tokenslist.size() - 4) / 4;
     for (int sat = 0; sat < sats; sat++) {
         int base          = 4 + sat * 4;
-        const int id      = tokenslist.at(base + 0).toInt(); // Satellite PRN number
-        const int elv     = tokenslist.at(base + 1).toInt(); // Elevation, degrees
-        const int azimuth = tokenslist.at(base + 2).toInt(); // Azimuth, degrees
-        const int sig     = tokenslist.at(base + 3).toInt(); // SNR - higher is better
+        const int id      = fieldInt(base + 0); // Satellite PRN number
+        const int elv     = fieldInt(base + 1); // Elevation, degrees
+        const int azimuth = fieldInt(base + 2); // Azimuth, degrees
+        const int sig     = fieldInt(base + 3); // SNR - higher is better
         const int index   = (sentence_index - 1) * 4 + sat;
         emit satellite(index, id, elv, azimuth, sig);
     }
@@ -293,49 +307,34 @@ void NMEAParser::nmeaProcessGPGSV(char *packet)
 
 /**
  * Prosesses NMEA GPGGA sentences
- * \param[in] Buffer for parsed nmea GPGGA sentence
  */
-void NMEAParser::nmeaProcessGPGGA(char *packet)
+void NMEAParser::nmeaProcessGPGGA()
 {
-    // start parsing just after "GPGGA,"
-    // attempt to reject empty packets right away
-    if (packet[6] == ',' && packet[7] == ',') {
-        return;
-    }
-
-    if (!nmeaChecksum(packet)) {
-        // checksum not valid
-        return;
-    }
-    nmeaTerminateAtChecksum(packet);
-
-    QString nmeaString(packet);
-    QStringList tokenslist = nmeaString.split(",");
-    GpsData.GPStime  = tokenslist.at(1).toDouble();
-    GpsData.Latitude = tokenslist.at(2).toDouble();
+    GpsData.GPStime  = fieldDouble(1);
+    GpsData.Latitude = fieldDouble(2);
     int deg    = (int)GpsData.Latitude / 100;
     double min = ((GpsData.Latitude) - (deg * 100)) / 60.0;
     GpsData.Latitude = deg + min;
     // next field: N/S indicator
     // correct latitute for N/S
-    if (tokenslist.at(3).contains("S")) {
+    if (fieldChar(3) == 'S') {
         GpsData.Latitude = -GpsData.Latitude;
     }
 
-    GpsData.Longitude = tokenslist.at(4).toDouble();
+    GpsData.Longitude = fieldDouble(4);
     deg = (int)GpsData.Longitude / 100;
     min = ((GpsData.Longitude) - (deg * 100)) / 60.0;
     GpsData.Longitude = deg + min;
     // next field: E/W indicator
     // correct latitute for E/W
-    if (tokenslist.at(5).contains("W")) {
+    if (fieldChar(5) == 'W') {
         GpsData.Longitude = -GpsData.Longitude;
     }
 
-    GpsData.SV = tokenslist.at(7).toInt();
+    GpsData.SV = fieldInt(7);
 
-    GpsData.Altitude = tokenslist.at(9).toDouble();
-    GpsData.GeoidSeparation = tokenslist.at(11).toDouble();
+    GpsData.Altitude = fieldDouble(9);
+    GpsData.GeoidSeparation = fieldDouble(11);
     emit position(GpsData.Latitude, GpsData.Longitude, GpsData.Altitude);
     emit sv(GpsData.SV);
     emit datetime(GpsData.GPSdate, GpsData.GPStime);
@@ -343,29 +342,14 @@ void NMEAParser::nmeaProcessGPGGA(char *packet)
 
 /**
  * Prosesses NMEA GPRMC sentences
- * \param[in] Buffer for parsed nmea GPRMC sentence
  */
-void NMEAParser::nmeaProcessGPRMC(char *packet)
+void NMEAParser::nmeaProcessGPRMC()
 {
-    // start parsing just after "GPRMC,"
-    // attempt to reject empty packets right away
-    if (packet[6] == ',' && packet[7] == ',') {
-        return;
-    }
-
-    if (!nmeaChecksum(packet)) {
-        // checksum not valid
-        return;
-    }
-    nmeaTerminateAtChecksum(packet);
-
-    QString nmeaString(packet);
-    QStringList tokenslist = nmeaString.split(",");
-    GpsData.GPStime     = tokenslist.at(1).toDouble();
-    GpsData.Groundspeed = tokenslist.at(7).toDouble();
+    GpsData.GPStime     = fieldDouble(1);
+    GpsData.Groundspeed = fieldDouble(7);
     GpsData.Groundspeed = GpsData.Groundspeed * 0.51444;
-    GpsData.Heading     = tokenslist.at(8).toDouble();
-    GpsData.GPSdate     = tokenslist.at(9).toDouble();
+    GpsData.Heading     = fieldDouble(8);
+    GpsData.GPSdate     = fieldDouble(9);
     emit datetime(GpsData.GPSdate, GpsData.GPStime);
     emit speedheading(GpsData.Groundspeed, GpsData.Heading);
 }
@@ -373,63 +357,32 @@ void NMEAParser::nmeaProcessGPRMC(char *packet)
 
 /**
  * Prosesses NMEA GPVTG sentences
- * \param[in] Buffer for parsed nmea GPVTG sentence
  */
-void NMEAParser::nmeaProcessGPVTG(char *packet)
+void NMEAParser::nmeaProcessGPVTG()
 {
-    // start parsing just after "GPVTG,"
-    // attempt to reject empty packets right away
-    if (packet[6] == ',' && packet[7] == ',') {
-        return;
-    }
-
-    if (!nmeaChecksum(packet)) {
-        // checksum not valid
-        return;
-    }
-    nmeaTerminateAtChecksum(packet);
-
-    QString nmeaString(packet);
-    QStringList tokenslist = nmeaString.split(",");
-
-    GpsData.Heading     = tokenslist.at(1).toDouble();
-    GpsData.Groundspeed = tokenslist.at(7).toDouble();
+    GpsData.Heading     = fieldDouble(1);
+    GpsData.Groundspeed = fieldDouble(7);
     GpsData.Groundspeed = GpsData.Groundspeed / 3.6;
     emit speedheading(GpsData.Groundspeed, GpsData.Heading);
 }
 
 /**
  * Prosesses NMEA GPGSA sentences
- * \param[in] Buffer for parsed nmea GPGSA sentence
  */
-void NMEAParser::nmeaProcessGPGSA(char *packet)
+void NMEAParser::nmeaProcessGPGSA()
 {
-    // start parsing just after "GPGSA,"
-    // attempt to reject empty packets right away
-    if (packet[6] == ',' && packet[7] == ',') {
-        return;
-    }
-
-    if (!nmeaChecksum(packet)) {
-        // checksum not valid
-        return;
-    }
-    nmeaTerminateAtChecksum(packet);
-
-    QString nmeaString(packet);
-    QStringList tokenslist = nmeaString.split(",");
-
     // M=Manual, forced to operate in 2D or 3D
     // A=Automatic, 3D/2D
-    QString fixmodeValue = tokenslist.at(1);
-    if (fixmodeValue == "A") {
+    char fixmodeValue = fieldChar(1);
+
+    if (fixmodeValue == 'A') {
         emit fixmode(QString("Auto"));
-    } else if (fixmodeValue == "B") {
+    } else if (fixmodeValue == 'B') {
         emit fixmode(QString("Manual"));
     }
 
     // Mode: 1=Fix not available, 2=2D, 3=3D
-    int fixtypeValue = tokenslist.at(2).toInt();
+    int fixtypeValue = fieldInt(2);
     if (fixtypeValue == 1) {
         emit fixtype(QString("NoFix"));
     } else if (fixtypeValue == 2) {
@@ -441,9 +394,8 @@ void NMEAParser::nmeaProcessGPGSA(char *packet)
     // 3-14 = IDs of SVs used in position fix (null for unused fields)
     QList<int> svList;
     for (int pos = 0; pos < 12; pos++) {
-        QString sv = tokenslist.at(3 + pos);
-        if (!sv.isEmpty()) {
-            svList.append(sv.toInt());
+        if (!fieldEmpty(3 + pos)) {
+            svList.append(fieldInt(3 + pos));
         }
     }
     emit fixSVs(svList);
@@ -451,37 +403,21 @@ void NMEAParser::nmeaProcessGPGSA(char *packet)
     // 15   = PDOP
     // 16   = HDOP
     // 17   = VDOP
-    GpsData.PDOP = tokenslist.at(15).toDouble();
-    GpsData.HDOP = tokenslist.at(16).toDouble();
-    GpsData.VDOP = tokenslist.at(17).toDouble();
+    GpsData.PDOP = fieldDouble(15);
+    GpsData.HDOP = fieldDouble(16);
+    GpsData.VDOP = fieldDouble(17);
     emit dop(GpsData.HDOP, GpsData.VDOP, GpsData.PDOP);
 }
 
 /**
  * Prosesses NMEA GPZDA sentences
- * \param[in] Buffer for parsed nmea GPZDA sentence
  */
-void NMEAParser::nmeaProcessGPZDA(char *packet)
+void NMEAParser::nmeaProcessGPZDA()
 {
-    // start parsing just after "GPZDA,"
-    // attempt to reject empty packets right away
-    if (packet[6] == ',' && packet[7] == ',') {
-        return;
-    }
-
-    if (!nmeaChecksum(packet)) {
-        // checksum not valid
-        return;
-    }
-    nmeaTerminateAtChecksum(packet);
-
-    QString nmeaString(packet);
-    QStringList tokenslist = nmeaString.split(",");
-
-    GpsData.GPStime = tokenslist.at(1).toDouble();
-    int day   = tokenslist.at(2).toInt();
-    int month = tokenslist.at(3).toInt();
-    int year  = tokenslist.at(4).toInt();
+    GpsData.GPStime = fieldDouble(1);
+    int day   = fieldInt(2);
+    int month = fieldInt(3);
+    int year  = fieldInt(4);
     GpsData.GPSdate = day * 10000 + month * 100 + (year - 2000);
     emit datetime(GpsData.GPSdate, GpsData.GPStime);
 }
@@ -31,11 +31,12 @@
 #include <QObject>
 #include <QtCore>
 #include <stdint.h>
-#include "buffer.h"
 #include "gpsparser.h"
+#include "scanringbuffer.h"
 
 // constants/macros/typdefs
 #define NMEA_BUFFERSIZE 128
+#define NMEA_MAX_FIELDS 32
 
 typedef struct struct_GpsData {
     double Latitude;
@@ -60,23 +61,40 @@ public:
     NMEAParser(QObject *parent = 0);
     ~NMEAParser();
     void processInputStream(char c);
-    char *nmeaGetPacketBuffer(void);
-    char nmeaChecksum(char *gps_buffer);
-    void nmeaTerminateAtChecksum(char *gps_buffer);
-    uint8_t nmeaProcess(cBuffer *rxBuffer);
-    void nmeaProcessGPGGA(char *packet);
-    void nmeaProcessGPRMC(char *packet);
-    void nmeaProcessGPVTG(char *packet);
-    void nmeaProcessGPGSA(char *packet);
-    void nmeaProcessGPGSV(char *packet);
-    void nmeaProcessGPZDA(char *packet);
+    void processInputBuffer(const char *data, int length);
     GpsData_t GpsData;
-    cBuffer gpsRxBuffer;
-    char gpsRxData[512];
-    char NmeaPacket[NMEA_BUFFERSIZE];
     uint32_t numUpdates;
     uint32_t numErrors;
     int32_t gpsRxOverflow;
+
+private:
+    // ! One comma separated field of the current sentence, a span into the scan buffer
+    struct NmeaField {
+        const char *data;
+        int length;
+    };
+
+    uint8_t nmeaDispatch(const char *sentence, int length);
+    char nmeaChecksum(const char *sentence, int length);
+    int nmeaScanFields(const char *sentence, int length);
+
+    // field accessors, parse in place so no string object is built per token
+    bool fieldEmpty(int index) const;
+    char fieldChar(int index) const;
+    int fieldInt(int index) const;
+    double fieldDouble(int index) const;
+
+    void nmeaProcessGPGGA();
+    void nmeaProcessGPRMC();
+    void nmeaProcessGPVTG();
+    void nmeaProcessGPGSA();
+    void nmeaProcessGPGSV();
+    void nmeaProcessGPZDA();
+
+    // received bytes not yet consumed, at most one partial sentence after a scan
+    ScanRingBuffer m_scanBuffer;
+    NmeaField m_fields[NMEA_MAX_FIELDS];
+    int m_fieldCount;
 };
 
 #endif // NMEAPARSER_H
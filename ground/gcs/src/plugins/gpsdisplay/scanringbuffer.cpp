@@ -0,0 +1,125 @@
+/**
+ ******************************************************************************
+ *
+ * @file       scanringbuffer.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GPSGadgetPlugin GPS Gadget Plugin
+ * @{
+ * @brief A gadget that displays GPS status and enables basic configuration
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "scanringbuffer.h"
+
+#include <string.h>
+#include <algorithm>
+
+ScanRingBuffer::ScanRingBuffer(int capacity)
+{
+    // round up to the next power of two so wrapping is a mask
+    m_capacity = 1;
+    while (m_capacity < capacity) {
+        m_capacity <<= 1;
+    }
+    m_data = new char[m_capacity];
+    m_mask = m_capacity - 1;
+    m_head = 0;
+    m_tail = 0;
+}
+
+ScanRingBuffer::~ScanRingBuffer()
+{
+    delete[] m_data;
+}
+
+int ScanRingBuffer::write(const char *data, int length)
+{
+    int free = m_capacity - size();
+
+    if (length > free) {
+        length = free;
+    }
+    int pos   = m_head & m_mask;
+    // at most two segments when the write wraps
+    int first = std::min(length, m_capacity - pos);
+
+    memcpy(m_data + pos, data, first);
+    if (length > first) {
+        memcpy(m_data, data + first, length - first);
+    }
+    m_head += length;
+    return length;
+}
+
+const char *ScanRingBuffer::peek(int &length)
+{
+    length = size();
+    int pos = m_tail & m_mask;
+
+    if ((pos + length) > m_capacity) {
+        // content wraps : rotate the storage in place so it is contiguous
+        // from the start. This is rare - the scanners consume almost
+        // everything on every pass - and allocates nothing.
+        std::rotate(m_data, m_data + pos, m_data + m_capacity);
+        m_tail = 0;
+        m_head = length;
+        pos    = 0;
+    }
+    return m_data + pos;
+}
+
+int ScanRingBuffer::indexOf(char c, int from)
+{
+    int length;
+    const char *data  = peek(length);
+
+    if (from >= length) {
+        return -1;
+    }
+    const char *found = (const char *)memchr(data + from, c, length - from);
+    return found ? (int)(found - data) : -1;
+}
+
+int ScanRingBuffer::indexOf(char first, char second, int from)
+{
+    int pos = indexOf(first, from);
+
+    while (pos >= 0) {
+        int length;
+        const char *data = peek(length);
+        if ((pos + 1) < length && (data[pos + 1] == second)) {
+            return pos;
+        }
+        pos = indexOf(first, pos + 1);
+    }
+    return -1;
+}
+
+void ScanRingBuffer::consume(int count)
+{
+    if (count > size()) {
+        count = size();
+    }
+    m_tail += count;
+}
+
+void ScanRingBuffer::clear()
+{
+    m_tail = m_head;
+}
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ *
+ * @file       scanringbuffer.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GPSGadgetPlugin GPS Gadget Plugin
+ * @{
+ * @brief A gadget that displays GPS status and enables basic configuration
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef SCANRINGBUFFER_H
+#define SCANRINGBUFFER_H
+
+/**
+ * Fixed size power-of-two ring for the serial scanners.
+ *
+ * The storage is allocated once at construction; writing, peeking and
+ * consuming allocate nothing, so the steady state serial path is free of
+ * heap traffic. The scanners work on a contiguous view of the whole
+ * content : peek() straightens the ring in place on the rare wrap, so
+ * frame and field spans are plain pointers into the storage, valid until
+ * the next write.
+ */
+class ScanRingBuffer {
+public:
+    // ! capacity is rounded up to the next power of two
+    ScanRingBuffer(int capacity);
+    ~ScanRingBuffer();
+
+    // ! Append bytes, returns how many fitted (the rest is dropped)
+    int write(const char *data, int length);
+
+    // ! Contiguous view of everything not yet consumed
+    const char *peek(int &length);
+
+    // ! Sentence boundary scan on the unconsumed content : position of a
+    // ! byte at or after from, -1 when absent
+    int indexOf(char c, int from);
+    // ! Position of a two byte sequence (e.g. <CR><LF>), -1 when absent
+    int indexOf(char first, char second, int from);
+
+    // ! Bulk consume : drop count bytes from the front
+    void consume(int count);
+    void clear();
+
+    int size() const
+    {
+        return (int)(m_head - m_tail);
+    }
+    int capacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    char *m_data;
+    int m_capacity;
+    unsigned int m_mask;
+    // free running, masked on access; size stays correct across wrap
+    unsigned int m_head;
+    unsigned int m_tail;
+};
+
+#endif // SCANRINGBUFFER_H
@@ -27,98 +27,31 @@
 
 
 #include "telemetryparser.h"
-#include <math.h>
-#include <QDebug>
-#include <QStringList>
+#include "gpstelemetryhub.h"
 
 
 /**
- * Initialize the parser
+ * Forward the hub notifications as the usual parser signals.
+ *
+ * The gadget connects our signals after constructing us, so the replay of
+ * the hub's cached state has to wait until the connects are in place; a
+ * queued invoke runs it on the next event loop pass.
  */
 TelemetryParser::TelemetryParser(QObject *parent) : GPSParser(parent)
 {
-    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
-    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
-    UAVDataObject *gpsObj = dynamic_cast<UAVDataObject *>(objManager->getObject("GPSPositionSensor"));
-
-    if (gpsObj != NULL) {
-        connect(gpsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateGPS(UAVObject *)));
-    } else {
-        qDebug() << "Error: Object is unknown (GPSPositionSensor).";
-    }
-
-    gpsObj = dynamic_cast<UAVDataObject *>(objManager->getObject("GPSTime"));
-    if (gpsObj != NULL) {
-        connect(gpsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateTime(UAVObject *)));
-    } else {
-        qDebug() << "Error: Object is unknown (GPSTime).";
-    }
-
-    gpsObj = dynamic_cast<UAVDataObject *>(objManager->getObject("GPSSatellites"));
-    if (gpsObj != NULL) {
-        connect(gpsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateSats(UAVObject *)));
-    }
+    GPSTelemetryHub *hub = GPSTelemetryHub::instance();
+
+    connect(hub, SIGNAL(svChanged(int)), this, SIGNAL(sv(int)));
+    connect(hub, SIGNAL(positionChanged(double, double, double)), this, SIGNAL(position(double, double, double)));
+    connect(hub, SIGNAL(homeChanged(double, double, double)), this, SIGNAL(home(double, double, double)));
+    connect(hub, SIGNAL(datetimeChanged(double, double)), this, SIGNAL(datetime(double, double)));
+    connect(hub, SIGNAL(speedheadingChanged(double, double)), this, SIGNAL(speedheading(double, double)));
+    connect(hub, SIGNAL(fixtypeChanged(QString)), this, SIGNAL(fixtype(QString)));
+    connect(hub, SIGNAL(dopChanged(double, double, double)), this, SIGNAL(dop(double, double, double)));
+    connect(hub, SIGNAL(satelliteChanged(int, int, int, int, int)), this, SIGNAL(satellite(int, int, int, int, int)));
+
+    QMetaObject::invokeMethod(hub, "replay", Qt::QueuedConnection);
 }
 
 TelemetryParser::~TelemetryParser()
 {}
-
-
-void TelemetryParser::updateGPS(UAVObject *object1)
-{
-    UAVObjectField *field = object1->getField(QString("Satellites"));
-    emit sv(field->getValue().toInt());
-
-    double lat = object1->getField(QString("Latitude"))->getDouble();
-    double lon = object1->getField(QString("Longitude"))->getDouble();
-    double alt = object1->getField(QString("Altitude"))->getDouble();
-
-    lat *= 1E-7;
-    lon *= 1E-7;
-    emit position(lat, lon, alt);
-
-    double hdg  = object1->getField(QString("Heading"))->getDouble();
-    double spd  = object1->getField(QString("Groundspeed"))->getDouble();
-    emit speedheading(spd, hdg);
-
-    QString fix = object1->getField(QString("Status"))->getValue().toString();
-    emit fixtype(fix);
-
-    double hdop = object1->getField(QString("HDOP"))->getDouble();
-    double vdop = object1->getField(QString("VDOP"))->getDouble();
-    double pdop = object1->getField(QString("PDOP"))->getDouble();
-    emit dop(hdop, vdop, pdop);
-}
-
-void TelemetryParser::updateTime(UAVObject *object1)
-{
-    double hour   = object1->getField(QString("Hour"))->getDouble();
-    double minute = object1->getField(QString("Minute"))->getDouble();
-    double second = object1->getField(QString("Second"))->getDouble();
-    double time   = second + minute * 100 + hour * 10000;
-    double year   = object1->getField(QString("Year"))->getDouble();
-    double month  = object1->getField(QString("Month"))->getDouble();
-    double day    = object1->getField(QString("Day"))->getDouble();
-    double date   = day + month * 100 + year * 10000;
-    emit datetime(date, time);
-}
-
-/**
-   Updates the satellite constellation.
-
-   Not really optimized for now, we should only send updates for the stas
-   which have changed instead of updating everything... That said, Qt is supposed
-   to be able to optimize redraws anyway.
- */
-void TelemetryParser::updateSats(UAVObject *object1)
-{
-    UAVObjectField *prn       = object1->getField(QString("PRN"));
-    UAVObjectField *elevation = object1->getField(QString("Elevation"));
-    UAVObjectField *azimuth   = object1->getField(QString("Azimuth"));
-    UAVObjectField *snr       = object1->getField(QString("SNR"));
-
-    for (unsigned int i = 0; i < prn->getNumElements(); i++) {
-        emit satellite(i, prn->getValue(i).toInt(), elevation->getValue(i).toInt(),
-                       azimuth->getValue(i).toInt(), snr->getValue(i).toInt());
-    }
-}
@@ -1,7 +1,7 @@
 /**
  ******************************************************************************
  *
- * @file       nmeaparser.h
+ * @file       telemetryparser.h
  * @author     Edouard Lafargue & the OpenPilot team Copyright (C) 2010.
  * @addtogroup GCSPlugins GCS Plugins
  * @{
@@ -30,23 +30,21 @@
 
 #include <QObject>
 #include <QtCore>
-#include "extensionsystem/pluginmanager.h"
-#include "uavobjectmanager.h"
-#include "uavobject.h"
 #include "gpsparser.h"
 
 
+/**
+ * Thin adapter that exposes the shared GPSTelemetryHub through the
+ * GPSParser signal interface the gadgets already consume. The UAVObject
+ * conversion itself happens once per update in the hub, no matter how
+ * many of these are alive.
+ */
 class TelemetryParser : public GPSParser {
     Q_OBJECT
 
 public:
     TelemetryParser(QObject *parent = 0);
     ~TelemetryParser();
-
-public slots:
-    void updateGPS(UAVObject *object1);
-    void updateTime(UAVObject *object1);
-    void updateSats(UAVObject *object1);
 };
 
 #endif // TELEMETRYPARSER_H
@@ -0,0 +1,242 @@
+/**
+ ******************************************************************************
+ *
+ * @file       ubxparser.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GPSGadgetPlugin GPS Gadget Plugin
+ * @{
+ * @brief A gadget that displays GPS status and enables basic configuration
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "ubxparser.h"
+#include <QDebug>
+
+/**
+ * Initialize the parser
+ */
+UBXParser::UBXParser(QObject *parent) : GPSParser(parent),
+    m_scanBuffer(2 * (UBX_HEADER_SIZE + UBX_MAX_PAYLOAD + UBX_CHECKSUM_SIZE))
+{
+    numUpdates    = 0;
+    numErrors     = 0;
+    gpsRxOverflow = 0;
+}
+
+UBXParser::~UBXParser()
+{}
+
+/**
+ * Called for a single input byte, kept for sources that cannot deliver chunks
+ */
+void UBXParser::processInputStream(char c)
+{
+    processInputBuffer(&c, 1);
+}
+
+/**
+ * Called with each chunk read from the input device.
+ *
+ * Scans the accumulated bytes for complete UBX frames; a frame that fails
+ * its checksum only consumes one byte so the scanner resynchronizes on the
+ * next sync pattern.
+ */
+void UBXParser::processInputBuffer(const char *data, int length)
+{
+    // the ring bounds the unscanned backlog; a stream that looks like a
+    // frame start but never completes is dropped like a buffer overflow,
+    // keeping the newest bytes to resynchronize on
+    if (m_scanBuffer.write(data, length) < length) {
+        gpsRxOverflow++;
+        m_scanBuffer.clear();
+        int keep = (length < m_scanBuffer.capacity()) ? length : m_scanBuffer.capacity();
+        m_scanBuffer.write(data + (length - keep), keep);
+    }
+
+    int avail;
+    const char *view = m_scanBuffer.peek(avail);
+    int scanned      = 0;
+    while ((avail - scanned) >= (UBX_HEADER_SIZE + UBX_CHECKSUM_SIZE)) {
+        const uint8_t *frame = (const uint8_t *)view + scanned;
+        // look for the sync pattern
+        if ((frame[0] != UBX_SYNC1) || (frame[1] != UBX_SYNC2)) {
+            scanned++;
+            continue;
+        }
+        uint16_t payloadLength = frame[4] | (frame[5] << 8);
+        if (payloadLength > UBX_MAX_PAYLOAD) {
+            // not a real frame, skip the sync byte and resynchronize
+            scanned++;
+            continue;
+        }
+        int frameSize = UBX_HEADER_SIZE + payloadLength + UBX_CHECKSUM_SIZE;
+        if ((avail - scanned) < frameSize) {
+            // frame not completely received yet, keep it for the next chunk
+            break;
+        }
+        if (ubxChecksum(frame, frameSize)) {
+            ++numUpdates;
+            ubxDispatch(frame, payloadLength);
+            scanned += frameSize;
+        } else {
+            ++numErrors;
+            scanned++;
+        }
+    }
+    m_scanBuffer.consume(scanned);
+}
+
+/**
+ * Fletcher checksum over class, id, length and payload
+ * \return true when the frame checksum matches
+ */
+bool UBXParser::ubxChecksum(const uint8_t *frame, int frameSize)
+{
+    uint8_t ckA = 0;
+    uint8_t ckB = 0;
+
+    for (int pos = 2; pos < (frameSize - UBX_CHECKSUM_SIZE); pos++) {
+        ckA += frame[pos];
+        ckB += ckA;
+    }
+    return (ckA == frame[frameSize - 2]) && (ckB == frame[frameSize - 1]);
+}
+
+/**
+ * Decodes one checksummed frame by overlaying the fixed payload layout
+ * \param[in] frame points at the first sync byte
+ * \param[in] payloadLength from the frame header
+ */
+void UBXParser::ubxDispatch(const uint8_t *frame, uint16_t payloadLength)
+{
+    uint8_t msgClass    = frame[2];
+    uint8_t msgId       = frame[3];
+    const void *payload = frame + UBX_HEADER_SIZE;
+
+    if (msgClass != UBX_CLASS_NAV) {
+        return;
+    }
+
+    switch (msgId) {
+    case UBX_ID_POSLLH:
+        if (payloadLength >= sizeof(UbxNavPosLLH)) {
+            ubxProcessNavPosLLH((const UbxNavPosLLH *)payload);
+        }
+        break;
+    case UBX_ID_DOP:
+        if (payloadLength >= sizeof(UbxNavDOP)) {
+            ubxProcessNavDOP((const UbxNavDOP *)payload);
+        }
+        break;
+    case UBX_ID_SOL:
+        if (payloadLength >= sizeof(UbxNavSol)) {
+            ubxProcessNavSol((const UbxNavSol *)payload);
+        }
+        break;
+    case UBX_ID_VELNED:
+        if (payloadLength >= sizeof(UbxNavVelNED)) {
+            ubxProcessNavVelNED((const UbxNavVelNED *)payload);
+        }
+        break;
+    case UBX_ID_TIMEUTC:
+        if (payloadLength >= sizeof(UbxNavTimeUTC)) {
+            ubxProcessNavTimeUTC((const UbxNavTimeUTC *)payload);
+        }
+        break;
+    case UBX_ID_SVINFO:
+        if (payloadLength >= sizeof(UbxNavSVInfoHeader)) {
+            ubxProcessNavSVInfo((const UbxNavSVInfoHeader *)payload, payloadLength);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void UBXParser::ubxProcessNavPosLLH(const UbxNavPosLLH *posllh)
+{
+    emit packet(QString("UBX NAV-POSLLH"));
+    emit position(posllh->lat * 1.0e-7, posllh->lon * 1.0e-7, posllh->hMSL * 1.0e-3);
+}
+
+void UBXParser::ubxProcessNavDOP(const UbxNavDOP *dop)
+{
+    emit packet(QString("UBX NAV-DOP"));
+    emit dop(dop->hDOP * 0.01, dop->vDOP * 0.01, dop->pDOP * 0.01);
+}
+
+void UBXParser::ubxProcessNavSol(const UbxNavSol *sol)
+{
+    emit packet(QString("UBX NAV-SOL"));
+    emit sv(sol->numSV);
+
+    switch (sol->gpsFix) {
+    case 2:
+        emit fixtype(QString("Fix2D"));
+        break;
+    case 3:
+    case 4:
+        emit fixtype(QString("Fix3D"));
+        break;
+    default:
+        emit fixtype(QString("NoFix"));
+        break;
+    }
+}
+
+void UBXParser::ubxProcessNavVelNED(const UbxNavVelNED *velned)
+{
+    emit packet(QString("UBX NAV-VELNED"));
+    // cm/s ground speed to m/s, 1e-5 deg heading to deg
+    emit speedheading(velned->gSpeed * 0.01, velned->heading * 1.0e-5);
+}
+
+void UBXParser::ubxProcessNavTimeUTC(const UbxNavTimeUTC *timeutc)
+{
+    emit packet(QString("UBX NAV-TIMEUTC"));
+    // same packed formats the NMEA sentences deliver
+    double date = timeutc->day * 10000 + timeutc->month * 100 + (timeutc->year - 2000);
+    double time = timeutc->hour * 10000 + timeutc->min * 100 + timeutc->sec;
+    emit datetime(date, time);
+}
+
+void UBXParser::ubxProcessNavSVInfo(const UbxNavSVInfoHeader *svinfo, uint16_t payloadLength)
+{
+    const UbxNavSVInfoChannel *channel = (const UbxNavSVInfoChannel *)(svinfo + 1);
+    int channels = (payloadLength - sizeof(UbxNavSVInfoHeader)) / sizeof(UbxNavSVInfoChannel);
+
+    if (channels > svinfo->numCh) {
+        channels = svinfo->numCh;
+    }
+
+    emit packet(QString("UBX NAV-SVINFO %1 channels").arg(channels));
+
+    int index = 0;
+    for (int chn = 0; chn < channels; chn++) {
+        if (index >= 16) {
+            break;
+        }
+        emit satellite(index, channel[chn].svid, channel[chn].elev, channel[chn].azim, channel[chn].cno);
+        index++;
+    }
+    for (; index < 16; index++) {
+        // Wipe the rest.
+        emit satellite(index, 0, 0, 0, 0);
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ ******************************************************************************
+ *
+ * @file       ubxparser.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GPSGadgetPlugin GPS Gadget Plugin
+ * @{
+ * @brief A gadget that displays GPS status and enables basic configuration
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef UBXPARSER_H
+#define UBXPARSER_H
+
+#include <QObject>
+#include <QtCore>
+#include <stdint.h>
+#include "gpsparser.h"
+#include "scanringbuffer.h"
+
+// UBX protocol framing
+#define UBX_SYNC1         0xB5
+#define UBX_SYNC2         0x62
+#define UBX_HEADER_SIZE   6
+#define UBX_CHECKSUM_SIZE 2
+// sanity limit, NAV payloads are a few hundred bytes at most
+#define UBX_MAX_PAYLOAD   512
+
+#define UBX_CLASS_NAV     0x01
+
+#define UBX_ID_POSLLH     0x02
+#define UBX_ID_DOP        0x04
+#define UBX_ID_SOL        0x06
+#define UBX_ID_VELNED     0x12
+#define UBX_ID_TIMEUTC    0x21
+#define UBX_ID_SVINFO     0x30
+
+// Payload layouts straight from the u-blox protocol specification, all
+// fields little endian. The structs are overlaid on the receive buffer,
+// so they must stay packed.
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t iTOW; // ms GPS time of week
+    int32_t  lon; // 1e-7 deg
+    int32_t  lat; // 1e-7 deg
+    int32_t  height; // mm above ellipsoid
+    int32_t  hMSL; // mm above mean sea level
+    uint32_t hAcc; // mm horizontal accuracy estimate
+    uint32_t vAcc; // mm vertical accuracy estimate
+} UbxNavPosLLH;
+
+typedef struct {
+    uint32_t iTOW;
+    uint16_t gDOP; // all DOPs scaled by 0.01
+    uint16_t pDOP;
+    uint16_t tDOP;
+    uint16_t vDOP;
+    uint16_t hDOP;
+    uint16_t nDOP;
+    uint16_t eDOP;
+} UbxNavDOP;
+
+typedef struct {
+    uint32_t iTOW;
+    int32_t  fTOW;
+    int16_t  week;
+    uint8_t  gpsFix; // 0=no fix, 1=DR, 2=2D, 3=3D, 4=GPS+DR, 5=time only
+    uint8_t  flags;
+    int32_t  ecefX;
+    int32_t  ecefY;
+    int32_t  ecefZ;
+    uint32_t pAcc;
+    int32_t  ecefVX;
+    int32_t  ecefVY;
+    int32_t  ecefVZ;
+    uint32_t sAcc;
+    uint16_t pDOP;
+    uint8_t  reserved1;
+    uint8_t  numSV; // number of SVs used in the solution
+    uint32_t reserved2;
+} UbxNavSol;
+
+typedef struct {
+    uint32_t iTOW;
+    int32_t  velN; // cm/s
+    int32_t  velE; // cm/s
+    int32_t  velD; // cm/s
+    uint32_t speed; // cm/s 3D speed
+    uint32_t gSpeed; // cm/s ground speed
+    int32_t  heading; // 1e-5 deg heading of motion
+    uint32_t sAcc;
+    uint32_t cAcc;
+} UbxNavVelNED;
+
+typedef struct {
+    uint32_t iTOW;
+    uint32_t tAcc;
+    int32_t  nano;
+    uint16_t year;
+    uint8_t  month;
+    uint8_t  day;
+    uint8_t  hour;
+    uint8_t  min;
+    uint8_t  sec;
+    uint8_t  valid;
+} UbxNavTimeUTC;
+
+typedef struct {
+    uint32_t iTOW;
+    uint8_t  numCh; // number of channel blocks following
+    uint8_t  globalFlags;
+    uint16_t reserved2;
+} UbxNavSVInfoHeader;
+
+typedef struct {
+    uint8_t chn;
+    uint8_t svid; // satellite PRN number
+    uint8_t flags;
+    uint8_t quality;
+    uint8_t cno; // dBHz, SNR
+    int8_t  elev; // deg
+    int16_t azim; // deg
+    int32_t prRes;
+} UbxNavSVInfoChannel;
+
+#pragma pack(pop)
+
+class UBXParser : public GPSParser {
+    Q_OBJECT
+
+public:
+    UBXParser(QObject *parent = 0);
+    ~UBXParser();
+    void processInputStream(char c);
+    void processInputBuffer(const char *data, int length);
+    uint32_t numUpdates;
+    uint32_t numErrors;
+    int32_t gpsRxOverflow;
+
+private:
+    bool ubxChecksum(const uint8_t *frame, int frameSize);
+    void ubxDispatch(const uint8_t *frame, uint16_t payloadLength);
+
+    void ubxProcessNavPosLLH(const UbxNavPosLLH *posllh);
+    void ubxProcessNavDOP(const UbxNavDOP *dop);
+    void ubxProcessNavSol(const UbxNavSol *sol);
+    void ubxProcessNavVelNED(const UbxNavVelNED *velned);
+    void ubxProcessNavTimeUTC(const UbxNavTimeUTC *timeutc);
+    void ubxProcessNavSVInfo(const UbxNavSVInfoHeader *svinfo, uint16_t payloadLength);
+
+    // received bytes not yet consumed, at most one partial frame after a scan
+    ScanRingBuffer m_scanBuffer;
+};
+
+#endif // UBXPARSER_H
@@ -125,7 +125,7 @@ void AeroSimRCSimulator::transmitUpdate()
     stream << armed << mode; // flight status
     stream << udpCounterASrecv; // packet counter
 
-    if (outSocket->writeDatagram(data, QHostAddress(settings.remoteAddress), settings.outPort) == -1) {
+    if (transmitData(data) == -1) {
         qDebug() << "write failed: " << outSocket->errorString();
     }
 
@@ -257,7 +257,9 @@ void AeroSimRCSimulator::processUpdate(const QByteArray &data)
     out.current     = curr;
     out.consumption = cons * 1000.0;
 
-    updateUAVOs(out);
+    // Packets arrive at the sim's native rate; park the decoded state in
+    // the latest-value mailbox and let the HITL tick apply it
+    postStateUpdate(out);
 
 #ifdef DBG_TIMERS
     static int cntRX = 0;
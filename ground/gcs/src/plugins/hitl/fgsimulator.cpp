@@ -31,6 +31,8 @@
 #include "coreplugin/icore.h"
 #include "coreplugin/threadmanager.h"
 
+#include <QDataStream>
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -189,19 +191,19 @@ void FGSimulator::transmitUpdate()
     if ((udpCounterGCSsend < allowableDifference) || (udpCounterFGrecv == 0)) { // FG udp queue is not delayed
         udpCounterGCSsend++;
 
-        // Send update to FlightGear
-        QString cmd;
-        cmd = QString("%1,%2,%3,%4,%5\n")
-              .arg(ailerons) // ailerons
-              .arg(elevator) // elevator
-              .arg(rudder) // rudder
-              .arg(throttle) // throttle
-              .arg(udpCounterGCSsend); // UDP packet counter delay
-
-        QByteArray data = cmd.toLatin1();
-
-        if (outSocket->writeDatagram(data, QHostAddress(settings.remoteAddress), settings.outPort) == -1) {
-            emit processOutput("Error sending UDP packet to FG: " + outSocket->errorString() + "\n");
+        // Send update to FlightGear, fixed layout binary packet from
+        // opfgprotocol.xml in network byte order
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        stream << ailerons // ailerons
+               << elevator // elevator
+               << rudder // rudder
+               << throttle // throttle
+               << qint32(udpCounterGCSsend); // UDP packet counter delay
+
+        if (transmitData(data) == -1) {
+            emit processOutput("Error sending packet to FG: " + outSocket->errorString() + "\n");
         }
     } else {
         // don't send new packet. Flightgear cannot process UDP fast enough.
@@ -224,61 +226,74 @@ void FGSimulator::transmitUpdate()
 void FGSimulator::processUpdate(const QByteArray & inp)
 {
     // TODO: this does not use the FLIGHT_PARAM structure, it should!
-    // Split
-    QString data(inp);
-    QStringList fields = data.split(",");
+    // Fixed layout binary packet from opfgprotocol.xml: 24 floats in
+    // network byte order followed by the UDP packet counter
+    const int expectedSize = 24 * 4 + 4;
+
+    if (inp.size() < expectedSize) {
+        qDebug() << "FG: incorrect length of UDP packet:" << inp.size();
+        return;
+    }
+
+    float fields[24];
+    qint32 n = 0;
+    QDataStream stream(inp);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    for (int i = 0; i < 24; i++) {
+        stream >> fields[i];
+    }
+    stream >> n;
+
     // Get xRate (deg/s)
-    // float xRate = fields[0].toFloat() * 180.0/M_PI;
+    // float xRate = fields[0] * 180.0/M_PI;
     // Get yRate (deg/s)
-    // float yRate = fields[1].toFloat() * 180.0/M_PI;
+    // float yRate = fields[1] * 180.0/M_PI;
     // Get zRate (deg/s)
-    // float zRate = fields[2].toFloat() * 180.0/M_PI;
+    // float zRate = fields[2] * 180.0/M_PI;
     // Get xAccel (m/s^2)
-    float xAccel    = fields[3].toFloat() * FT2M;
+    float xAccel    = fields[3] * FT2M;
     // Get yAccel (m/s^2)
-    float yAccel    = fields[4].toFloat() * FT2M;
+    float yAccel    = fields[4] * FT2M;
     // Get xAccel (m/s^2)
-    float zAccel    = fields[5].toFloat() * FT2M;
+    float zAccel    = fields[5] * FT2M;
     // Get pitch (deg)
-    float pitch     = fields[6].toFloat();
+    float pitch     = fields[6];
     // Get pitchRate (deg/s)
-    float pitchRate = fields[7].toFloat();
+    float pitchRate = fields[7];
     // Get roll (deg)
-    float roll     = fields[8].toFloat();
+    float roll     = fields[8];
     // Get rollRate (deg/s)
-    float rollRate = fields[9].toFloat();
+    float rollRate = fields[9];
     // Get yaw (deg)
-    float yaw       = fields[10].toFloat();
+    float yaw       = fields[10];
     // Get yawRate (deg/s)
-    float yawRate   = fields[11].toFloat();
+    float yawRate   = fields[11];
     // Get latitude (deg)
-    float latitude  = fields[12].toFloat();
+    float latitude  = fields[12];
     // Get longitude (deg)
-    float longitude = fields[13].toFloat();
+    float longitude = fields[13];
     // Get heading (deg)
-    // float heading      = fields[14].toFloat();
+    // float heading      = fields[14];
     // Get altitude (m)
-    float altitude_msl = fields[15].toFloat() * FT2M;
+    float altitude_msl = fields[15] * FT2M;
     // Get altitudeAGL (m)
-    float altitude_agl = fields[16].toFloat() * FT2M;
+    float altitude_agl = fields[16] * FT2M;
     // Get groundspeed (m/s)
-    float groundspeed  = fields[17].toFloat() * KT2MPS;
+    float groundspeed  = fields[17] * KT2MPS;
     // Get airspeed (m/s)
-    float airspeed     = fields[18].toFloat() * KT2MPS;
+    float airspeed     = fields[18] * KT2MPS;
     // Get temperature (degC)
-    float temperature  = fields[19].toFloat();
+    float temperature  = fields[19];
     // Get pressure (kpa)
-    float pressure     = fields[20].toFloat() * INHG2KPA;
+    float pressure     = fields[20] * INHG2KPA;
     // Get VelocityState Down (m/s)
-    float velocityStateDown  = fields[21].toFloat() * FPS2CMPS * 1e-2f;
+    float velocityStateDown  = fields[21] * FPS2CMPS * 1e-2f;
     // Get VelocityState East (m/s)
-    float velocityStateEast  = fields[22].toFloat() * FPS2CMPS * 1e-2f;
+    float velocityStateEast  = fields[22] * FPS2CMPS * 1e-2f;
     // Get VelocityState Down (m/s)
-    float velocityStateNorth = fields[23].toFloat() * FPS2CMPS * 1e-2f;
+    float velocityStateNorth = fields[23] * FPS2CMPS * 1e-2f;
 
     // Get UDP packets received by FG
-    int n = fields[24].toInt();
-
     udpCounterFGrecv = n;
 
     ///////
@@ -27,10 +27,42 @@
 
 #include "hitlnoisegeneration.h"
 
+#include <QDateTime>
+
+// Perturbation amplitudes, roughly representative sensor noise levels
+#define NOISE_ACCEL    0.05f // [m/s^2]
+#define NOISE_GYRO     0.2f  // [deg/s]
+#define NOISE_ATT      0.2f  // [deg]
+#define NOISE_BARO     0.5f  // [m]
+#define NOISE_GPS_POS  20    // [1e-7 deg], Latitude/Longitude are *10^7 integers
+#define NOISE_GPS_ALT  1.0f  // [m]
+#define NOISE_GPS_VEL  0.1f  // [m/s]
+#define NOISE_GPS_HEAD 0.5f  // [deg]
+#define NOISE_AIRSPEED 0.3f  // [m/s]
+
+// Number of perturbed fields filled per tick
+#define NOISE_SAMPLES  19
+
+/**
+ * Counter-based generator (SplitMix style finalizer) : every sample is a
+ * pure function of (seed, counter), so a whole vector can be synthesized
+ * in one pass with no sequential dependency between samples.
+ */
+static inline quint32 noiseMix32(quint32 x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
 
 HitlNoiseGeneration::HitlNoiseGeneration()
 {
     memset(&noise, 0, sizeof(Noise));
+    m_seed    = (quint32)QDateTime::currentMSecsSinceEpoch();
+    m_counter = 0;
 }
 
 
@@ -42,37 +74,48 @@ Noise HitlNoiseGeneration::getNoise()
     return noise;
 }
 
+void HitlNoiseGeneration::fillSamples(float *samples, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        // uniform in [-1, 1)
+        samples[i] = (qint32)noiseMix32(m_seed + m_counter + i) * (1.0f / 2147483648.0f);
+    }
+    m_counter += count;
+}
+
 Noise HitlNoiseGeneration::generateNoise()
 {
-    noise.accelStateData.x       = 0;
-    noise.accelStateData.y       = 0;
-    noise.accelStateData.z       = 0;
+    // One batch of samples per tick, scaled onto all perturbed fields in a
+    // single pass
+    float s[NOISE_SAMPLES];
+
+    fillSamples(s, NOISE_SAMPLES);
 
-    noise.gpsPosData.Latitude    = 0;
-    noise.gpsPosData.Longitude   = 0;
-    noise.gpsPosData.Groundspeed = 0;
-    noise.gpsPosData.Heading     = 0;
-    noise.gpsPosData.Altitude    = 0;
+    noise.accelStateData.x       = s[0] * NOISE_ACCEL;
+    noise.accelStateData.y       = s[1] * NOISE_ACCEL;
+    noise.accelStateData.z       = s[2] * NOISE_ACCEL;
 
-    noise.gpsVelData.North       = 0;
-    noise.gpsVelData.East = 0;
-    noise.gpsVelData.Down = 0;
+    noise.gpsPosData.Latitude    = s[3] * NOISE_GPS_POS;
+    noise.gpsPosData.Longitude   = s[4] * NOISE_GPS_POS;
+    noise.gpsPosData.Groundspeed = s[5] * NOISE_GPS_VEL;
+    noise.gpsPosData.Heading     = s[6] * NOISE_GPS_HEAD;
+    noise.gpsPosData.Altitude    = s[7] * NOISE_GPS_ALT;
 
-    noise.baroAltData.Altitude = 0;
+    noise.gpsVelData.North       = s[8] * NOISE_GPS_VEL;
+    noise.gpsVelData.East = s[9] * NOISE_GPS_VEL;
+    noise.gpsVelData.Down = s[10] * NOISE_GPS_VEL;
 
-    noise.attStateData.Roll    = 0;
-    noise.attStateData.Pitch   = 0;
-    noise.attStateData.Yaw     = 0;
+    noise.baroAltData.Altitude = s[11] * NOISE_BARO;
 
-    noise.gyroStateData.x  = 0;
-    noise.gyroStateData.y  = 0;
-    noise.gyroStateData.z  = 0;
+    noise.attStateData.Roll    = s[12] * NOISE_ATT;
+    noise.attStateData.Pitch   = s[13] * NOISE_ATT;
+    noise.attStateData.Yaw     = s[14] * NOISE_ATT;
 
-    noise.accelStateData.x = 0;
-    noise.accelStateData.y = 0;
-    noise.accelStateData.z = 0;
+    noise.gyroStateData.x = s[15] * NOISE_GYRO;
+    noise.gyroStateData.y = s[16] * NOISE_GYRO;
+    noise.gyroStateData.z = s[17] * NOISE_GYRO;
 
-    noise.airspeedState.CalibratedAirspeed = 0;
+    noise.airspeedState.CalibratedAirspeed = s[18] * NOISE_AIRSPEED;
 
     return noise;
 }
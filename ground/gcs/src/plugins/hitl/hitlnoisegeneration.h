@@ -61,6 +61,11 @@ public:
 private slots:
 
 private:
+    // ! Fill a whole vector of uniform samples in [-1, 1) in one pass
+    void fillSamples(float *samples, int count);
+
     Noise noise;
+    quint32 m_seed;
+    quint32 m_counter;
 };
 #endif // HITLNOISEGENERATION_H
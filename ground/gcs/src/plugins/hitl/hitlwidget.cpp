@@ -78,9 +78,11 @@ void HITLWidget::startButtonClicked()
 
     qDebug() << "Main Thread: " << mainThread;
 
-    // Allow only one instance per simulator
-    if (Simulator::Instances().indexOf(settings.simulatorId) != -1) {
-        widget->textBrowser->append(settings.simulatorId + " alreary started!");
+    // Allow only one instance per simulator and input port; further vehicles
+    // run side by side from their own HITL gadgets on their own ports
+    QString instanceKey = settings.simulatorId + ":" + QString::number(settings.inPort);
+    if (Simulator::Instances().indexOf(instanceKey) != -1) {
+        widget->textBrowser->append(instanceKey + " alreary started!");
         return;
     }
 
@@ -105,7 +107,7 @@ void HITLWidget::startButtonClicked()
 
     // move to thread <--[BCH]
     simulator->setName(creator->Description());
-    simulator->setSimulatorId(creator->ClassId());
+    simulator->setSimulatorId(instanceKey);
 
     connect(simulator, SIGNAL(processOutput(QString)), this, SLOT(onProcessOutput(QString)));
 
@@ -116,7 +118,7 @@ void HITLWidget::startButtonClicked()
     // Start bridge
     bool ret = QMetaObject::invokeMethod(simulator, "setupProcess", Qt::QueuedConnection);
     if (ret) {
-        Simulator::setInstance(settings.simulatorId);
+        Simulator::setInstance(instanceKey);
 
         connect(this, SIGNAL(deleteSimulator()), simulator, SLOT(onDeleteSimulator()), Qt::QueuedConnection);
 
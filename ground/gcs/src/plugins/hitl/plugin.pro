@@ -14,6 +14,7 @@ HEADERS += \
     hitlconfiguration.h \
     hitlgadget.h \
     hitlnoisegeneration.h \
+    shmemtransport.h \
     simulator.h \
     aerosimrcsimulator.h \
     fgsimulator.h \
@@ -29,6 +30,7 @@ SOURCES += \
     hitlconfiguration.cpp \
     hitlgadget.cpp \
     hitlnoisegeneration.cpp \
+    shmemtransport.cpp \
     simulator.cpp \
     aerosimrcsimulator.cpp \
     fgsimulator.cpp \
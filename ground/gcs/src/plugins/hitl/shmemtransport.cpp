@@ -0,0 +1,130 @@
+/**
+ ******************************************************************************
+ *
+ * @file       shmemtransport.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup HITLPlugin HITL Plugin
+ * @{
+ * @brief The Hardware In The Loop plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "shmemtransport.h"
+
+#include <QDebug>
+#include <string.h>
+
+ShmemTransport::ShmemTransport(const QString & key, QObject *parent) :
+    QObject(parent),
+    m_sharedMemory(key),
+    m_segment(NULL),
+    m_lastSequence(0)
+{}
+
+ShmemTransport::~ShmemTransport()
+{
+    close();
+}
+
+bool ShmemTransport::open()
+{
+    if (m_segment) {
+        return true;
+    }
+
+    if (m_sharedMemory.create(sizeof(ShmemSegment))) {
+        // fresh segment, initialize it for both sides
+        m_segment = (ShmemSegment *)m_sharedMemory.data();
+        memset(m_segment, 0, sizeof(ShmemSegment));
+        m_segment->version = SHMEM_VERSION;
+        m_segment->magic   = SHMEM_MAGIC;
+    } else if (m_sharedMemory.error() == QSharedMemory::AlreadyExists && m_sharedMemory.attach()) {
+        // the simulator side bridge created it first
+        m_segment = (ShmemSegment *)m_sharedMemory.data();
+        if ((m_sharedMemory.size() < (int)sizeof(ShmemSegment))
+            || (m_segment->magic != SHMEM_MAGIC) || (m_segment->version != SHMEM_VERSION)) {
+            qDebug() << "ShmemTransport: segment" << m_sharedMemory.key() << "is not ours";
+            close();
+            return false;
+        }
+    } else {
+        qDebug() << "ShmemTransport: cannot open segment" << m_sharedMemory.key()
+                 << ":" << m_sharedMemory.errorString();
+        return false;
+    }
+
+    m_lastSequence = m_segment->fromSimulator.sequence;
+    return true;
+}
+
+void ShmemTransport::close()
+{
+    m_segment = NULL;
+    if (m_sharedMemory.isAttached()) {
+        m_sharedMemory.detach();
+    }
+}
+
+bool ShmemTransport::send(const QByteArray & data)
+{
+    if (!m_segment || (data.size() > SHMEM_MAX_MESSAGE)) {
+        return false;
+    }
+
+    ShmemMailbox *mailbox = &m_segment->toSimulator;
+
+    // odd sequence marks the mailbox as being written
+    mailbox->sequence = mailbox->sequence + 1;
+    memcpy(mailbox->data, data.constData(), data.size());
+    mailbox->dataSize = data.size();
+    mailbox->sequence = mailbox->sequence + 1;
+    return true;
+}
+
+bool ShmemTransport::receive(QByteArray & data)
+{
+    if (!m_segment) {
+        return false;
+    }
+
+    ShmemMailbox *mailbox = &m_segment->fromSimulator;
+
+    for (int retry = 0; retry < 3; retry++) {
+        quint32 sequence = mailbox->sequence;
+        if ((sequence & 1) || (sequence == m_lastSequence)) {
+            // being written right now, or nothing new
+            return false;
+        }
+        quint32 dataSize = mailbox->dataSize;
+        if (dataSize > SHMEM_MAX_MESSAGE) {
+            // never valid, skip the message
+            m_lastSequence = sequence;
+            return false;
+        }
+        data.resize(dataSize);
+        memcpy(data.data(), mailbox->data, dataSize);
+        if (mailbox->sequence == sequence) {
+            // the copy was not raced by the writer
+            m_lastSequence = sequence;
+            return true;
+        }
+        // overwritten while copying, try the newer message
+    }
+    return false;
+}
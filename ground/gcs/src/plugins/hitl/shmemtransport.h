@@ -0,0 +1,97 @@
+/**
+ ******************************************************************************
+ *
+ * @file       shmemtransport.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup HITLPlugin HITL Plugin
+ * @{
+ * @brief The Hardware In The Loop plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef SHMEMTRANSPORT_H
+#define SHMEMTRANSPORT_H
+
+#include <QObject>
+#include <QSharedMemory>
+#include <QByteArray>
+
+// Large enough for any simulator exchange packet
+#define SHMEM_MAX_MESSAGE 4096
+
+/**
+ * One direction of the link: a single writer, single reader mailbox.
+ *
+ * The sequence counter works like a seqlock. The writer bumps it to an odd
+ * value before copying and to the next even value after, so neither side
+ * ever takes a lock; a reader that sees an odd or changing sequence simply
+ * retries. A new message is pending whenever the stable sequence differs
+ * from the last one the reader consumed. Messages overwrite each other,
+ * which is the behaviour we want for state exchange: a slow consumer gets
+ * the freshest state, not a backlog.
+ */
+struct ShmemMailbox {
+    volatile quint32 sequence;
+    quint32 dataSize;
+    char    data[SHMEM_MAX_MESSAGE];
+};
+
+struct ShmemSegment {
+    quint32 magic;
+    quint32 version;
+    ShmemMailbox toSimulator;
+    ShmemMailbox fromSimulator;
+};
+
+/**
+ * Shared memory channel between the GCS and a simulator running on the
+ * same machine. Both sides attach to the same named segment; the GCS
+ * creates and initializes it when it does not exist yet. The GCS writes
+ * to the toSimulator mailbox and reads from the fromSimulator one, a
+ * simulator side bridge does the opposite.
+ */
+class ShmemTransport : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ShmemTransport(const QString & key, QObject *parent = 0);
+    ~ShmemTransport();
+
+    bool open();
+    void close();
+    bool isOpen() const
+    {
+        return m_segment != NULL;
+    }
+
+    // ! Posts a message to the simulator, overwrites an unread one
+    bool send(const QByteArray & data);
+    // ! Copies the pending simulator message, false when there is none
+    bool receive(QByteArray & data);
+
+private:
+    static const quint32 SHMEM_MAGIC   = 0x4F504853; // "OPHS"
+    static const quint32 SHMEM_VERSION = 1;
+
+    QSharedMemory m_sharedMemory;
+    ShmemSegment *m_segment;
+    quint32 m_lastSequence;
+};
+
+#endif // SHMEMTRANSPORT_H
@@ -28,12 +28,13 @@
 
 #include "simulator.h"
 #include "hitlnoisegeneration.h"
+#include "shmemtransport.h"
 
 #include <extensionsystem/pluginmanager.h>
-#include <coreplugin/icore.h>
-#include <coreplugin/threadmanager.h>
 #include <uavtalk/telemetrymanager.h>
 
+#include <QThread>
+
 volatile bool Simulator::isStarted = false;
 
 const float Simulator::GEE      = 9.81;
@@ -51,16 +52,25 @@ Simulator::Simulator(const SimulatorSettings & params) :
     inSocket(NULL),
     outSocket(NULL),
     settings(params),
+    simThread(NULL),
     updatePeriod(50),
     simTimeout(8000),
     autopilotConnectionStatus(false),
     simConnectionStatus(false),
     txTimer(NULL),
     simTimer(NULL),
+    shmemLink(NULL),
+    shmemRxTimer(NULL),
+    pendingStateFresh(false),
     name("")
 {
-    // move to thread
-    moveToThread(Core::ICore::instance()->threadManager()->getRealTimeThread());
+    memset(&pendingState, 0, sizeof(pendingState));
+    // move to its own thread, several vehicles then run in parallel instead
+    // of serializing through the shared realtime thread
+    simThread = new QThread();
+    connect(simThread, SIGNAL(finished()), simThread, SLOT(deleteLater()));
+    simThread->start(QThread::TimeCriticalPriority);
+    moveToThread(simThread);
     connect(this, SIGNAL(myStart()), this, SLOT(onStart()), Qt::QueuedConnection);
     emit myStart();
 
@@ -105,6 +115,16 @@ Simulator::~Simulator()
         delete simTimer;
         simTimer = NULL;
     }
+
+    if (shmemRxTimer) {
+        delete shmemRxTimer;
+        shmemRxTimer = NULL;
+    }
+
+    if (shmemLink) {
+        delete shmemLink;
+        shmemLink = NULL;
+    }
     // NOTE: Does not currently work, may need to send control+c to through the terminal
     if (simProcess != NULL) {
         // connect(simProcess,SIGNAL(finished(int, QProcess::ExitStatus)),this,SLOT(onFinished(int, QProcess::ExitStatus)));
@@ -127,8 +147,15 @@ void Simulator::onDeleteSimulator(void)
     // [2]
     Simulator::Instances().removeOne(simulatorId);
 
+    QThread *thread = simThread;
+
     disconnect(this);
     delete this;
+
+    // stop the per-vehicle thread, deleteLater is wired to finished()
+    if (thread) {
+        thread->quit();
+    }
 }
 
 void Simulator::onStart()
@@ -197,8 +224,30 @@ void Simulator::onStart()
 
     connect(inSocket, SIGNAL(readyRead()), this, SLOT(receiveUpdate()), Qt::DirectConnection);
 
+    if (settings.shmemEnabled) {
+        // Local simulators can exchange packets through a shared memory
+        // segment instead of the UDP sockets, skipping the network stack.
+        // the input port makes the key unique per vehicle
+        QString shmemKey = "hitl-" + settings.simulatorId + "-" + QString::number(settings.inPort);
+        shmemLink = new ShmemTransport(shmemKey);
+        if (shmemLink->open()) {
+            emit processOutput("Shared memory transport: " + shmemKey + "\n");
+            // the mailbox has no notification, poll it from the realtime thread
+            shmemRxTimer = new QTimer();
+            connect(shmemRxTimer, SIGNAL(timeout()), this, SLOT(receiveShmemUpdate()), Qt::DirectConnection);
+            shmemRxTimer->setInterval(1);
+            shmemRxTimer->start();
+        } else {
+            emit processOutput("Shared memory transport unavailable, using UDP\n");
+            delete shmemLink;
+            shmemLink = NULL;
+        }
+    }
+
     // Setup transmit timer
     txTimer = new QTimer();
+    // apply the freshest mailbox state first, then answer the autopilot
+    connect(txTimer, SIGNAL(timeout()), this, SLOT(applyPendingState()), Qt::DirectConnection);
     connect(txTimer, SIGNAL(timeout()), this, SLOT(transmitUpdate()), Qt::DirectConnection);
     txTimer->setInterval(updatePeriod);
     txTimer->start();
@@ -211,8 +260,13 @@ void Simulator::onStart()
     // setup time
     time = new QTime();
     time->start();
-    current.T = 0;
-    current.i = 0;
+    virtualTime = QTime::currentTime();
+    current.T   = 0;
+    current.i   = 0;
+
+    if (settings.lockstep) {
+        emit processOutput("Lockstep mode: simulation advances one update period per exchange\n");
+    }
 }
 
 void Simulator::receiveUpdate()
@@ -239,6 +293,95 @@ void Simulator::receiveUpdate()
         // Process incomming data
         processUpdate(datagram);
     }
+
+    if (settings.lockstep) {
+        lockstepTick();
+    }
+}
+
+void Simulator::receiveShmemUpdate()
+{
+    QByteArray datagram;
+
+    while (shmemLink->receive(datagram)) {
+        // Update connection timer and status
+        simTimer->setInterval(simTimeout);
+        simTimer->stop();
+        simTimer->start();
+        if (!simConnectionStatus) {
+            simConnectionStatus = true;
+            emit simulatorConnected();
+        }
+
+        // Process incomming data
+        processUpdate(datagram);
+    }
+
+    if (settings.lockstep) {
+        lockstepTick();
+    }
+}
+
+/**
+ * Stores the latest decoded state. Decoders running at the simulator's
+ * native packet rate call this instead of updateUAVOs() so only the most
+ * recent state is kept; it is consumed once per tick.
+ */
+void Simulator::postStateUpdate(const Output2Hardware & out)
+{
+    QMutexLocker locker(&lock);
+
+    pendingState      = out;
+    pendingStateFresh = true;
+}
+
+void Simulator::applyPendingState()
+{
+    Output2Hardware out;
+
+    {
+        QMutexLocker locker(&lock);
+        if (!pendingStateFresh) {
+            return;
+        }
+        out = pendingState;
+        pendingStateFresh = false;
+    }
+    updateUAVOs(out);
+}
+
+/**
+ * Answers a simulator state packet with the next command packet right away.
+ * The exchange itself becomes the clock: the pair runs as fast as the
+ * simulator can step and the run is deterministic, while the virtual clock
+ * keeps the UAVO output rates at their configured simulated-time periods.
+ * The free-running txTimer is restarted on every tick, so it only fires
+ * when the exchange stalls and kicks it off again.
+ */
+void Simulator::lockstepTick()
+{
+    txTimer->stop();
+    txTimer->start();
+    virtualTime = virtualTime.addMSecs(updatePeriod);
+    transmitUpdate();
+}
+
+QTime Simulator::currentSimTime() const
+{
+    return settings.lockstep ? virtualTime : QTime::currentTime();
+}
+
+/**
+ * Sends a packet to the simulator over the active transport. Returns -1 on
+ * failure like QUdpSocket::writeDatagram so the callers can keep their
+ * error reporting unchanged.
+ */
+qint64 Simulator::transmitData(const QByteArray & data)
+{
+    if (shmemLink) {
+        return shmemLink->send(data) ? data.size() : -1;
+    }
+    return outSocket->writeDatagram(data, QHostAddress(settings.remoteAddress), settings.outPort);
 }
 
 void Simulator::setupObjects()
@@ -389,7 +532,7 @@ void Simulator::resetInitialHomePosition()
 
 void Simulator::updateUAVOs(Output2Hardware out)
 {
-    QTime currentTime = QTime::currentTime();
+    QTime currentTime = currentSimTime();
 
     Noise noise;
     HitlNoiseGeneration noiseSource;
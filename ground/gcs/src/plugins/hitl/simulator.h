@@ -56,11 +56,14 @@
 
 #include <QObject>
 #include <QUdpSocket>
+#include <QThread>
 #include <QTime>
 #include <QTimer>
 #include <QProcess>
 #include <qmath.h>
 
+class ShmemTransport;
+
 /**
  * just imagine this was a class without methods and all public properties
  */
@@ -122,6 +125,8 @@ typedef struct _CONNECTION {
     int     inPort;
     bool    startSim;
     bool    addNoise;
+    bool    shmemEnabled;
+    bool    lockstep;
     QString latitude;
     QString longitude;
 
@@ -273,6 +278,10 @@ public:
     void resetInitialHomePosition();
     void updateUAVOs(Output2Hardware out);
 
+    // ! Latest-value mailbox : decoders store state here per packet, it is
+    // ! applied to the UAVObjects once per tick by applyPendingState()
+    void postStateUpdate(const Output2Hardware & out);
+
     AirParameters getAirParameters();
     void setAirParameters(AirParameters airParameters);
 
@@ -292,7 +301,9 @@ public slots:
 private slots:
     void onStart();
     // void transmitUpdate();
+    void applyPendingState();
     void receiveUpdate();
+    void receiveShmemUpdate();
     void onAutopilotConnect();
     void onAutopilotDisconnect();
     void onSimulatorConnectionTimeout();
@@ -316,6 +327,9 @@ protected:
     QUdpSocket *inSocket; // (new QUdpSocket());
     QUdpSocket *outSocket;
 
+    // ! Sends to the simulator over shared memory when enabled, UDP otherwise
+    qint64 transmitData(const QByteArray & data);
+
     ActuatorCommand *actCommand;
     ActuatorDesired *actDesired;
     ManualControlCommand *manCtrlCommand;
@@ -348,6 +362,9 @@ private:
     float initE;
     float initD;
 
+    // per-vehicle worker thread the simulator lives in
+    QThread *simThread;
+
     int updatePeriod;
     int simTimeout;
     volatile bool autopilotConnectionStatus;
@@ -355,6 +372,23 @@ private:
     QTimer *txTimer;
     QTimer *simTimer;
 
+    // shared memory channel to a local simulator, NULL when running over UDP
+    ShmemTransport *shmemLink;
+    QTimer *shmemRxTimer;
+
+    // virtual clock for lockstep runs, advances one update period per tick
+    QTime virtualTime;
+
+    // latest decoded simulator state, overwritten per packet and consumed
+    // on the tick - decouples the sim's packet rate from UAVO updates
+    Output2Hardware pendingState;
+    bool pendingStateFresh;
+
+    // ! Wall clock normally, the virtual clock in lockstep mode
+    QTime currentSimTime() const;
+    // ! Advances the virtual clock and answers with the next command packet
+    void lockstepTick();
+
     QTime attRawTime;
     QTime gpsPosTime;
     QTime groundTruthTime;
@@ -61,6 +61,7 @@
 #include <coreplugin/icore.h>
 #include <coreplugin/threadmanager.h>
 #include <math.h>
+#include <string.h>
 
 void TraceBuf10(const char *buf, int len);
 
@@ -144,8 +145,8 @@ void XplaneSimulator10::transmitUpdate()
         buf.append(reinterpret_cast<const char *>(&none), sizeof(none));
 // TraceBuf10(buf.data(),41);
 
-        if (outSocket->writeDatagram(buf, QHostAddress(settings.remoteAddress), settings.outPort) == -1) {
-            emit processOutput("Error sending UDP packet to XPlane: " + outSocket->errorString() + "\n");
+        if (transmitData(buf) == -1) {
+            emit processOutput("Error sending packet to XPlane: " + outSocket->errorString() + "\n");
         }
         // outSocket->write(buf);
 
@@ -165,8 +166,8 @@ void XplaneSimulator10::transmitUpdate()
         buf.append(reinterpret_cast<const char *>(&none), sizeof(none));
         buf.append(reinterpret_cast<const char *>(&none), sizeof(none));
 
-        if (outSocket->writeDatagram(buf, QHostAddress(settings.remoteAddress), settings.outPort) == -1) {
-            emit processOutput("Error sending UDP packet to XPlane: " + outSocket->errorString() + "\n");
+        if (transmitData(buf) == -1) {
+            emit processOutput("Error sending packet to XPlane: " + outSocket->errorString() + "\n");
         }
 
         // outSocket->write(buf);
@@ -212,75 +213,79 @@ void XplaneSimulator10::processUpdate(const QByteArray & dataBuf)
     float pitchRate_rad = 0;
     float yawRate_rad   = 0;
 
-    // QString str;
-    QByteArray & buf    = const_cast<QByteArray &>(dataBuf);
-    QString data(buf);
+    // scan the fixed size records in place, the datagram is never copied
+    if ((dataBuf.size() < 5) || (memcmp(dataBuf.constData(), "DATA", 4) != 0)) { // check type of packet
+        return;
+    }
+    // check correctness of data length, length must be multiple of (id_size+8*float_size)=4+8*4=36
+    if ((dataBuf.size() - 5) % 36) {
+        qDebug() << ("incorrect length of UDP packet: " + QString::number(dataBuf.size()));
+        return; // incorrect length of struct
+    }
+    int channelCounter = (dataBuf.size() - 5) / 36;
+    const char *record = dataBuf.constData() + 5;
 
-    if (data.left(4) == "DATA") { // check type of packet
-        buf.remove(0, 5);
-        if (dataBuf.size() % 36) {
-            qDebug() << ("incorrect length of UDP packet: " + buf);
-            return; // incorrect length of struct
-        }
-        // check correctness of data length, length must be multiple of (id_size+8*float_size)=4+8*4=36
-        int channelCounter = dataBuf.size() / 36;
+    if (channelCounter) {
         do {
-            switch (buf[0]) { // switch by id
+            // eight floats follow the record id
+            float value[8];
+            memcpy(value, record + 4, sizeof(value));
+            switch (record[0]) { // switch by id
             case XplaneSimulator10::LatitudeLongitude:
-                latitude     = *((float *)(buf.data() + 4 * 1));
-                longitude    = *((float *)(buf.data() + 4 * 2));
-                altitude_msl = *((float *)(buf.data() + 4 * 3)) * FT2M;
-                altitude_agl = *((float *)(buf.data() + 4 * 4)) * FT2M;
+                latitude     = value[0];
+                longitude    = value[1];
+                altitude_msl = value[2] * FT2M;
+                altitude_agl = value[3] * FT2M;
                 break;
 
             case XplaneSimulator10::Speed:
-                airspeed_keas    = *((float *)(buf.data() + 4 * 2));
-                groundspeed_ktgs = *((float *)(buf.data() + 4 * 4));
+                airspeed_keas    = value[1];
+                groundspeed_ktgs = value[3];
                 break;
 
             case XplaneSimulator10::PitchRollHeading:
-                pitch   = *((float *)(buf.data() + 4 * 1));
-                roll    = *((float *)(buf.data() + 4 * 2));
-                heading = *((float *)(buf.data() + 4 * 3));
+                pitch   = value[0];
+                roll    = value[1];
+                heading = value[2];
                 break;
 
             /*
                    case XplaneSimulator10::SystemPressures:
-               pressure = *((float*)(buf.data()+4*1));
+               pressure = value[0];
                break;
              */
 
             case XplaneSimulator10::AtmosphereWeather:
-                pressure    = *((float *)(buf.data() + 4 * 1)) * INHG2KPA;
-                temperature = *((float *)(buf.data() + 4 * 2));
+                pressure    = value[0] * INHG2KPA;
+                temperature = value[1];
                 break;
 
             case XplaneSimulator10::LocVelDistTraveled:
-                dstX = *((float *)(buf.data() + 4 * 1));
-                dstY = -*((float *)(buf.data() + 4 * 3));
-                dstZ = *((float *)(buf.data() + 4 * 2));
-                velX = *((float *)(buf.data() + 4 * 4));
-                velY = -*((float *)(buf.data() + 4 * 6));
-                velZ = *((float *)(buf.data() + 4 * 5));
+                dstX = value[0];
+                dstY = -value[2];
+                dstZ = value[1];
+                velX = value[3];
+                velY = -value[5];
+                velZ = value[4];
                 break;
 
             case XplaneSimulator10::AngularVelocities: // In [rad/s]
-                pitchRate_rad = *((float *)(buf.data() + 4 * 1));
-                rollRate_rad  = *((float *)(buf.data() + 4 * 2));
-                yawRate_rad   = *((float *)(buf.data() + 4 * 3));
+                pitchRate_rad = value[0];
+                rollRate_rad  = value[1];
+                yawRate_rad   = value[2];
                 break;
 
             case XplaneSimulator10::Gload:
-                accX = *((float *)(buf.data() + 4 * 6)) * GEE;
-                accY = *((float *)(buf.data() + 4 * 7)) * GEE;
-                accZ = *((float *)(buf.data() + 4 * 5)) * GEE;
+                accX = value[5] * GEE;
+                accY = value[6] * GEE;
+                accZ = value[4] * GEE;
                 break;
 
             default:
                 break;
             }
             channelCounter--;
-            buf.remove(0, 36);
+            record += 36;
         } while (channelCounter);
 
 
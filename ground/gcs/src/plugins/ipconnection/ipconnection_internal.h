@@ -3,6 +3,31 @@
 
 #include "ipconnectionplugin.h"
 
+#include <QtNetwork/QAbstractSocket>
+#include <QtNetwork/QHostInfo>
+#include <QtNetwork/QUdpSocket>
+
+class QEventLoop;
+class QTcpSocket;
+
+// Listen-only udp socket for the multicast telemetry mirror : joins the
+// group on bind and silently swallows writes, so the telemetry stack above
+// needs no special casing for a device with no TX path.
+class MulticastListenSocket : public QUdpSocket {
+    Q_OBJECT
+
+public:
+    explicit MulticastListenSocket(QObject *parent = 0) : QUdpSocket(parent) {}
+
+protected:
+    qint64 writeData(const char *data, qint64 len)
+    {
+        Q_UNUSED(data);
+        // pretend the write succeeded, the stream is receive only
+        return len;
+    }
+};
+
 // Simple class for creating & destroying a socket in the real-time thread
 // Needed because sockets need to be created in the same thread that they're used
 class IPConnection : public QObject {
@@ -15,8 +40,32 @@ public:
 
 public slots:
 
-    void onOpenDevice(QString HostName, int Port, bool UseTCP);
+    void onOpenDevice(QString HostName, int Port, bool UseTCP, bool UseLowLatency, bool UseMulticast);
     void onCloseDevice(QAbstractSocket *ipSocket);
+
+private slots:
+    void onLookupFinished(QHostInfo info);
+    void onAttemptConnected();
+    void onAttemptError(QAbstractSocket::SocketError error);
+
+private:
+    // Overall budget for one openDevice() call, name resolution included
+    static const int OPEN_TIMEOUT_MS  = 5 * 1000;
+    // One round of parallel connection attempts gets this long
+    static const int ROUND_TIMEOUT_MS = 1500;
+    // Pause before retrying after a round where every attempt failed fast
+    static const int FAST_RETRY_MS    = 250;
+
+    QList<QHostAddress> resolve(const QString &hostName, int timeoutMs);
+    QTcpSocket *connectRound(const QList<QHostAddress> &addresses, int port, int timeoutMs);
+
+    // state of the resolution / connection race in progress
+    QEventLoop *m_loop;
+    QHostInfo   m_lookupInfo;
+    QList<QTcpSocket *> m_attempts;
+    QTcpSocket *m_winner;
+    int m_failedAttempts;
+    QString m_lastError;
 };
 
 #endif // IPCONNECTION_INTERNAL_H
@@ -32,7 +32,9 @@ IPconnectionConfiguration::IPconnectionConfiguration(QString classId, QSettings
     IUAVGadgetConfiguration(classId, parent),
     m_HostName("127.0.0.1"),
     m_Port(1000),
-    m_UseTCP(1)
+    m_UseTCP(1),
+    m_UseLowLatency(0),
+    m_UseMulticast(0)
 {
     Q_UNUSED(qSettings);
 
@@ -49,6 +51,8 @@ IUAVGadgetConfiguration *IPconnectionConfiguration::clone()
     m->m_Port     = m_Port;
     m->m_HostName = m_HostName;
     m->m_UseTCP   = m_UseTCP;
+    m->m_UseLowLatency = m_UseLowLatency;
+    m->m_UseMulticast  = m_UseMulticast;
     return m;
 }
 
@@ -61,6 +65,8 @@ void IPconnectionConfiguration::saveConfig(QSettings *qSettings) const
     qSettings->setValue("port", m_Port);
     qSettings->setValue("hostName", m_HostName);
     qSettings->setValue("useTCP", m_UseTCP);
+    qSettings->setValue("useLowLatency", m_UseLowLatency);
+    qSettings->setValue("useMulticast", m_UseMulticast);
 }
 
 void IPconnectionConfiguration::savesettings() const
@@ -72,6 +78,8 @@ void IPconnectionConfiguration::savesettings() const
     settings->setValue(QLatin1String("HostName"), m_HostName);
     settings->setValue(QLatin1String("Port"), m_Port);
     settings->setValue(QLatin1String("UseTCP"), m_UseTCP);
+    settings->setValue(QLatin1String("UseLowLatency"), m_UseLowLatency);
+    settings->setValue(QLatin1String("UseMulticast"), m_UseMulticast);
     settings->endArray();
     settings->endGroup();
 }
@@ -86,6 +94,8 @@ void IPconnectionConfiguration::restoresettings()
     m_HostName = (settings->value(QLatin1String("HostName"), tr("")).toString());
     m_Port     = (settings->value(QLatin1String("Port"), tr("")).toInt());
     m_UseTCP   = (settings->value(QLatin1String("UseTCP"), tr("")).toInt());
+    m_UseLowLatency = (settings->value(QLatin1String("UseLowLatency"), tr("")).toInt());
+    m_UseMulticast  = (settings->value(QLatin1String("UseMulticast"), tr("")).toInt());
     settings->endArray();
     settings->endGroup();
 }
@@ -38,6 +38,8 @@ class IPconnectionConfiguration : public IUAVGadgetConfiguration {
     Q_OBJECT Q_PROPERTY(QString HostName READ HostName WRITE setHostName)
     Q_PROPERTY(int Port READ Port WRITE setPort)
     Q_PROPERTY(int UseTCP READ UseTCP WRITE setUseTCP)
+    Q_PROPERTY(int UseLowLatency READ UseLowLatency WRITE setUseLowLatency)
+    Q_PROPERTY(int UseMulticast READ UseMulticast WRITE setUseMulticast)
 
 public:
     explicit IPconnectionConfiguration(QString classId, QSettings *qSettings = 0, QObject *parent = 0);
@@ -62,6 +64,14 @@ public:
     {
         return m_UseTCP;
     }
+    int UseLowLatency() const
+    {
+        return m_UseLowLatency;
+    }
+    int UseMulticast() const
+    {
+        return m_UseMulticast;
+    }
 
 
 public slots:
@@ -77,11 +87,21 @@ public slots:
     {
         m_UseTCP = UseTCP;
     }
+    void setUseLowLatency(int UseLowLatency)
+    {
+        m_UseLowLatency = UseLowLatency;
+    }
+    void setUseMulticast(int UseMulticast)
+    {
+        m_UseMulticast = UseMulticast;
+    }
 
 private:
     QString m_HostName;
     int m_Port;
     int m_UseTCP;
+    int m_UseLowLatency;
+    int m_UseMulticast;
     QSettings *settings;
 };
 
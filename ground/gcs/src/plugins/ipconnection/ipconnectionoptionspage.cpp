@@ -52,8 +52,10 @@ QWidget *IPconnectionOptionsPage::createPage(QWidget *parent)
 
     m_page->Port->setValue(m_config->Port());
     m_page->HostName->setText(m_config->HostName());
-    m_page->UseTCP->setChecked(m_config->UseTCP() ? true : false);
-    m_page->UseUDP->setChecked(m_config->UseTCP() ? false : true);
+    m_page->UseMulticast->setChecked(m_config->UseMulticast() ? true : false);
+    m_page->UseTCP->setChecked(m_config->UseMulticast() ? false : (m_config->UseTCP() ? true : false));
+    m_page->UseUDP->setChecked(m_config->UseMulticast() ? false : (m_config->UseTCP() ? false : true));
+    m_page->UseLowLatency->setChecked(m_config->UseLowLatency() ? true : false);
 
     return w;
 }
@@ -63,6 +65,8 @@ void IPconnectionOptionsPage::apply()
     m_config->setPort(m_page->Port->value());
     m_config->setHostName(m_page->HostName->text());
     m_config->setUseTCP(m_page->UseTCP->isChecked() ? 1 : 0);
+    m_config->setUseMulticast(m_page->UseMulticast->isChecked() ? 1 : 0);
+    m_config->setUseLowLatency(m_page->UseLowLatency->isChecked() ? 1 : 0);
     m_config->savesettings();
 
     emit availableDevChanged();
@@ -40,8 +40,12 @@
 #include <QtNetwork/QAbstractSocket>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
+#include <QtNetwork/QHostInfo>
 #include <QWaitCondition>
 #include <QMutex>
+#include <QEventLoop>
+#include <QTimer>
+#include <QElapsedTimer>
 #include <coreplugin/threadmanager.h>
 
 #include <QDebug>
@@ -54,12 +58,13 @@ QWaitCondition closeDeviceWait;
 QMutex ipConMutex;
 QAbstractSocket *ret;
 
-IPConnection::IPConnection(IPconnectionConnection *connection) : QObject()
+IPConnection::IPConnection(IPconnectionConnection *connection) : QObject(),
+    m_loop(NULL), m_winner(NULL), m_failedAttempts(0)
 {
     moveToThread(Core::ICore::instance()->threadManager()->getRealTimeThread());
 
-    QObject::connect(connection, SIGNAL(CreateSocket(QString, int, bool)),
-                     this, SLOT(onOpenDevice(QString, int, bool)));
+    QObject::connect(connection, SIGNAL(CreateSocket(QString, int, bool, bool, bool)),
+                     this, SLOT(onOpenDevice(QString, int, bool, bool, bool)));
     QObject::connect(connection, SIGNAL(CloseSocket(QAbstractSocket *)),
                      this, SLOT(onCloseDevice(QAbstractSocket *)));
 }
@@ -69,34 +74,84 @@ IPConnection::IPConnection(IPconnectionConnection *connection) : QObject()
 
    }*/
 
-void IPConnection::onOpenDevice(QString HostName, int Port, bool UseTCP)
+void IPConnection::onOpenDevice(QString HostName, int Port, bool UseTCP, bool UseLowLatency, bool UseMulticast)
 {
-    QAbstractSocket *ipSocket;
-    const int Timeout = 5 * 1000;
+    QAbstractSocket *ipSocket = NULL;
 
     ipConMutex.lock();
-    if (UseTCP) {
-        ipSocket = new QTcpSocket(this);
-    } else {
-        ipSocket = new QUdpSocket(this);
-    }
 
     // do sanity check on hostname and port...
     if ((HostName.length() == 0) || (Port < 1)) {
         errorMsg = "Please configure Host and Port options before opening the connection";
-    } else {
-        // try to connect...
+    } else if (UseMulticast) {
+        // listen-only subscription to a multicast telemetry mirror : join
+        // the group and receive, there is no TX path and no handshake to
+        // wait for, so any number of stations can watch the same stream
+        MulticastListenSocket *listenSocket = new MulticastListenSocket(this);
+        QHostAddress group(HostName);
+        if (!group.isMulticast()) {
+            errorMsg = QString("%1 is not a multicast group address").arg(HostName);
+            delete listenSocket;
+        } else if (!listenSocket->bind(QHostAddress::AnyIPv4, Port,
+                                       QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+            errorMsg = listenSocket->errorString();
+            delete listenSocket;
+        } else if (!listenSocket->joinMulticastGroup(group)) {
+            errorMsg = listenSocket->errorString();
+            delete listenSocket;
+        } else {
+            ipSocket = listenSocket;
+        }
+    } else if (!UseTCP) {
+        // connectionless, nothing to wait for and nothing to race
+        ipSocket = new QUdpSocket(this);
         ipSocket->connectToHost(HostName, Port);
+    } else {
+        QElapsedTimer budget;
+        budget.start();
+        m_lastError = "";
 
-        // in blocking mode so we wait for the connection to succeed
-        if (ipSocket->waitForConnected(Timeout)) {
-            ret = ipSocket;
-            openDeviceWait.wakeAll();
-            ipConMutex.unlock();
-            return;
+        QList<QHostAddress> addresses = resolve(HostName, OPEN_TIMEOUT_MS);
+        if (addresses.isEmpty()) {
+            errorMsg = m_lastError;
+        }
+
+        // Race a connection attempt per resolved address and take the first
+        // one that completes the handshake. A round where every attempt
+        // fails fast (e.g. connection refused while a tracker box boots) is
+        // retried after a short pause for as long as the budget lasts, so
+        // the wait is bounded by actual reachability, not a fixed timeout.
+        while (!addresses.isEmpty() && (budget.elapsed() < OPEN_TIMEOUT_MS)) {
+            qint64 remaining = OPEN_TIMEOUT_MS - budget.elapsed();
+            ipSocket = connectRound(addresses, Port, qMin(remaining, (qint64)ROUND_TIMEOUT_MS));
+            if (ipSocket != NULL) {
+                break;
+            }
+            errorMsg  = m_lastError;
+            remaining = OPEN_TIMEOUT_MS - budget.elapsed();
+            if (remaining > FAST_RETRY_MS) {
+                QEventLoop pause;
+                QTimer::singleShot(FAST_RETRY_MS, &pause, SLOT(quit()));
+                pause.exec();
+            }
         }
-        // tell user something went wrong
-        errorMsg = ipSocket->errorString();
+    }
+
+    if (ipSocket != NULL) {
+        if (UseLowLatency) {
+            // long range links: send telemetry frames immediately instead
+            // of letting Nagle coalesce them, and enlarge the OS buffers
+            // so bursts at high telemetry rates do not overrun the defaults
+            if (UseTCP) {
+                ipSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            }
+            ipSocket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 1024 * 1024);
+            ipSocket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, 256 * 1024);
+        }
+        ret = ipSocket;
+        openDeviceWait.wakeAll();
+        ipConMutex.unlock();
+        return;
     }
     /* BUGBUG TODO - returning null here leads to segfault because some caller still calls disconnect without checking our return value properly
      * someone needs to debug this, I got lost in the calling chain.*/
@@ -105,6 +160,133 @@ void IPConnection::onOpenDevice(QString HostName, int Port, bool UseTCP)
     ipConMutex.unlock();
 }
 
+/**
+ * Resolve the host without blocking the thread's event loop, so the
+ * lookup respects the same deadline as the connection attempts. Literal
+ * addresses skip the resolver. The result interleaves IPv6 and IPv4
+ * addresses so one attempt per address family starts immediately.
+ */
+QList<QHostAddress> IPConnection::resolve(const QString &hostName, int timeoutMs)
+{
+    QHostAddress literal;
+
+    if (literal.setAddress(hostName)) {
+        return QList<QHostAddress>() << literal;
+    }
+
+    m_lookupInfo = QHostInfo();
+
+    QEventLoop loop;
+    m_loop = &loop;
+    QTimer::singleShot(timeoutMs, &loop, SLOT(quit()));
+    int lookupId = QHostInfo::lookupHost(hostName, this, SLOT(onLookupFinished(QHostInfo)));
+    loop.exec();
+    m_loop = NULL;
+
+    if (m_lookupInfo.lookupId() != lookupId) {
+        // the deadline fired before the resolver answered
+        QHostInfo::abortHostLookup(lookupId);
+        m_lastError = QString("Timeout resolving host %1").arg(hostName);
+        return QList<QHostAddress>();
+    }
+    if (m_lookupInfo.error() != QHostInfo::NoError) {
+        m_lastError = m_lookupInfo.errorString();
+        return QList<QHostAddress>();
+    }
+
+    QList<QHostAddress> v6, v4, interleaved;
+    foreach(const QHostAddress &address, m_lookupInfo.addresses()) {
+        if (address.protocol() == QAbstractSocket::IPv6Protocol) {
+            v6.append(address);
+        } else {
+            v4.append(address);
+        }
+    }
+    while (!v6.isEmpty() || !v4.isEmpty()) {
+        if (!v6.isEmpty()) {
+            interleaved.append(v6.takeFirst());
+        }
+        if (!v4.isEmpty()) {
+            interleaved.append(v4.takeFirst());
+        }
+    }
+    return interleaved;
+}
+
+/**
+ * One round of parallel connection attempts, one socket per address.
+ * Returns the first socket whose handshake completes; the losers are
+ * aborted. Returns NULL once every attempt failed or the timeout fired.
+ */
+QTcpSocket *IPConnection::connectRound(const QList<QHostAddress> &addresses, int port, int timeoutMs)
+{
+    m_winner = NULL;
+    m_failedAttempts = 0;
+    m_attempts.clear();
+
+    QEventLoop loop;
+    m_loop = &loop;
+    QTimer::singleShot(timeoutMs, &loop, SLOT(quit()));
+    foreach(const QHostAddress &address, addresses) {
+        QTcpSocket *attempt = new QTcpSocket(this);
+
+        connect(attempt, SIGNAL(connected()), this, SLOT(onAttemptConnected()));
+        connect(attempt, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(onAttemptError(QAbstractSocket::SocketError)));
+        m_attempts.append(attempt);
+        attempt->connectToHost(address, port);
+    }
+    loop.exec();
+    m_loop = NULL;
+
+    if ((m_winner == NULL) && m_lastError.isEmpty()) {
+        m_lastError = "Connection timed out";
+    }
+    foreach(QTcpSocket * attempt, m_attempts) {
+        if (attempt != m_winner) {
+            disconnect(attempt, 0, this, 0);
+            attempt->abort();
+            attempt->deleteLater();
+        }
+    }
+    m_attempts.clear();
+    if (m_winner != NULL) {
+        disconnect(m_winner, 0, this, 0);
+    }
+    return m_winner;
+}
+
+void IPConnection::onLookupFinished(QHostInfo info)
+{
+    m_lookupInfo = info;
+    if (m_loop != NULL) {
+        m_loop->quit();
+    }
+}
+
+void IPConnection::onAttemptConnected()
+{
+    if (m_winner == NULL) {
+        m_winner = qobject_cast<QTcpSocket *>(sender());
+    }
+    if (m_loop != NULL) {
+        m_loop->quit();
+    }
+}
+
+void IPConnection::onAttemptError(QAbstractSocket::SocketError error)
+{
+    Q_UNUSED(error);
+    QTcpSocket *attempt = qobject_cast<QTcpSocket *>(sender());
+
+    if (attempt != NULL) {
+        m_lastError = attempt->errorString();
+    }
+    // only give up once the last outstanding attempt failed
+    if ((++m_failedAttempts >= m_attempts.count()) && (m_loop != NULL)) {
+        m_loop->quit();
+    }
+}
+
 void IPConnection::onCloseDevice(QAbstractSocket *ipSocket)
 {
     ipConMutex.lock();
@@ -177,12 +359,16 @@ QIODevice *IPconnectionConnection::openDevice(const QString &)
     QString HostName;
     int Port;
     bool UseTCP;
+    bool UseLowLatency;
+    bool UseMulticast;
     QMessageBox msgBox;
 
     // get the configuration info
-    HostName = m_config->HostName();
-    Port     = m_config->Port();
-    UseTCP   = m_config->UseTCP();
+    HostName      = m_config->HostName();
+    Port          = m_config->Port();
+    UseTCP        = m_config->UseTCP();
+    UseLowLatency = m_config->UseLowLatency();
+    UseMulticast  = m_config->UseMulticast();
 
     if (ipSocket) {
         // Andrew: close any existing socket... this should never occur
@@ -194,7 +380,7 @@ QIODevice *IPconnectionConnection::openDevice(const QString &)
     }
 
     ipConMutex.lock();
-    emit CreateSocket(HostName, Port, UseTCP);
+    emit CreateSocket(HostName, Port, UseTCP, UseLowLatency, UseMulticast);
     openDeviceWait.wait(&ipConMutex);
     ipConMutex.unlock();
     ipSocket = ret;
@@ -224,7 +410,9 @@ QString IPconnectionConnection::connectionName()
 
 QString IPconnectionConnection::shortName()
 { // updated from serial plugin
-    if (m_config->UseTCP()) {
+    if (m_config->UseMulticast()) {
+        return QString("MCAST");
+    } else if (m_config->UseTCP()) {
         return QString("TCP");
     } else {
         return QString("UDP");
@@ -73,7 +73,7 @@ protected slots:
     void onEnumerationChanged();
 
 signals: // For the benefit of IPConnection
-    void CreateSocket(QString HostName, int Port, bool UseTCP);
+    void CreateSocket(QString HostName, int Port, bool UseTCP, bool UseLowLatency, bool UseMulticast);
     void CloseSocket(QAbstractSocket *socket);
 
 private:
@@ -340,6 +340,27 @@ void LineardialGadgetWidget::setDialFile(QString dfn)
             fgenabled = false;
         }
 
+        // Cache the layers as rendered pixmaps. Everything except the moving
+        // parts only changes with the view transform and is kept in device
+        // coordinate caches, while the index and symbol are rendered into
+        // item coordinate caches that the per frame translation is applied
+        // to, so updates at telemetry rate no longer re-composite the SVG.
+        background->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        if (fgenabled) {
+            foreground->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        }
+        if (red) {
+            red->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+            yellow->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+            green->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        }
+        if (index) {
+            index->setCacheMode(QGraphicsItem::ItemCoordinateCache);
+        }
+        if (fieldSymbol) {
+            fieldSymbol->setCacheMode(QGraphicsItem::ItemCoordinateCache);
+        }
+
         l_scene->setSceneRect(background->boundingRect());
 
         // Reset the current index value:
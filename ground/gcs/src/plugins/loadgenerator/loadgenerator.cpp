@@ -0,0 +1,327 @@
+/**
+ ******************************************************************************
+ *
+ * @file       loadgenerator.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup LoadGeneratorPlugin Plugin
+ * @{
+ * @brief Synthetic UAVTalk telemetry load generator
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "loadgenerator.h"
+
+#include "uavtalk/uavtalk.h"
+#include "uavtalk/telemetrymanager.h"
+#include "uavobjects/uavobjectmanager.h"
+#include "uavobjects/uavdataobject.h"
+#include "uavobjects/uavobjectfield.h"
+#include "uavobjects/uavobjectsinit.h"
+
+#include <QtNetwork/QUdpSocket>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <stdlib.h>
+
+LoopbackDevice::LoopbackDevice(QObject *parent) : QIODevice(parent)
+{}
+
+void LoopbackDevice::feed(const QByteArray &data)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_buffer.append(data);
+    }
+    emit readyRead();
+}
+
+bool LoopbackDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 LoopbackDevice::bytesAvailable() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_buffer.size() + QIODevice::bytesAvailable();
+}
+
+qint64 LoopbackDevice::readData(char *data, qint64 maxSize)
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 size = qMin(maxSize, (qint64)m_buffer.size());
+
+    memcpy(data, m_buffer.constData(), size);
+    m_buffer.remove(0, size);
+    return size;
+}
+
+qint64 LoopbackDevice::writeData(const char *data, qint64 maxSize)
+{
+    // uplink traffic from the telemetry stack goes nowhere
+    Q_UNUSED(data);
+    return maxSize;
+}
+
+LoadGenerator::LoadGenerator(QObject *parent) : QObject(parent),
+    m_instanceCount(1),
+    m_rate(1000),
+    m_errorRate(0.0),
+    m_sourceManager(NULL),
+    m_encoder(NULL),
+    m_sendCursor(0),
+    m_loopbackDevice(NULL),
+    m_sinkManager(NULL),
+    m_session(NULL),
+    m_udpSocket(NULL),
+    m_tickCarry(0.0),
+    m_framesSent(0),
+    m_bytesSent(0),
+    m_framesCorrupted(0)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(TICK_MS);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(onTick()));
+}
+
+LoadGenerator::~LoadGenerator()
+{
+    stop();
+    delete m_encoder;
+    delete m_sourceManager;
+}
+
+void LoadGenerator::setObjectMix(const QStringList &objectNames)
+{
+    m_objectMix = objectNames;
+}
+
+void LoadGenerator::setInstanceCount(quint32 instanceCount)
+{
+    m_instanceCount = qMax(instanceCount, (quint32)1);
+}
+
+void LoadGenerator::setAggregateRate(quint32 framesPerSecond)
+{
+    m_rate = qBound((quint32)1, framesPerSecond, MAX_AGGREGATE_RATE);
+}
+
+void LoadGenerator::setErrorRate(double corruptedFraction)
+{
+    m_errorRate = qBound(0.0, corruptedFraction, 1.0);
+}
+
+bool LoadGenerator::startLoopback()
+{
+    if (isRunning()) {
+        return false;
+    }
+    if (!start()) {
+        return false;
+    }
+
+    // a private telemetry session, fed exactly the way a vehicle link
+    // would feed it. The device is created without a parent so the session
+    // can move it to the telemetry thread.
+    m_loopbackDevice = new LoopbackDevice();
+    m_loopbackDevice->open(QIODevice::ReadWrite);
+    m_sinkManager    = new UAVObjectManager();
+    UAVObjectsInitialize(m_sinkManager);
+    m_session = new TelemetryManager(m_sinkManager);
+    m_session->start(m_loopbackDevice);
+
+    m_timer.start();
+    qDebug() << "LoadGenerator - loopback stream started," << m_rate << "frames/s";
+    return true;
+}
+
+bool LoadGenerator::startUdp(const QString &host, quint16 port)
+{
+    if (isRunning()) {
+        return false;
+    }
+    if (!start()) {
+        return false;
+    }
+
+    m_udpSocket = new QUdpSocket(this);
+    m_udpSocket->connectToHost(host, port);
+
+    m_timer.start();
+    qDebug() << "LoadGenerator - UDP stream to" << host << ":" << port << "started," << m_rate << "frames/s";
+    return true;
+}
+
+void LoadGenerator::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+    m_timer.stop();
+
+    if (m_session != NULL) {
+        m_session->stop();
+        // the telemetry session winds down asynchronously on its thread
+        m_session->deleteLater();
+        m_sinkManager->deleteLater();
+        m_loopbackDevice->deleteLater();
+        m_loopbackDevice = NULL;
+        m_session     = NULL;
+        m_sinkManager = NULL;
+    }
+    if (m_udpSocket != NULL) {
+        delete m_udpSocket;
+        m_udpSocket = NULL;
+    }
+    qDebug() << "LoadGenerator - stopped after" << m_framesSent << "frames,"
+             << m_framesCorrupted << "corrupted";
+}
+
+bool LoadGenerator::isRunning() const
+{
+    return m_timer.isActive();
+}
+
+TelemetryManager *LoadGenerator::loopbackSession() const
+{
+    return m_session;
+}
+
+quint64 LoadGenerator::framesSent() const
+{
+    return m_framesSent;
+}
+
+quint64 LoadGenerator::bytesSent() const
+{
+    return m_bytesSent;
+}
+
+quint64 LoadGenerator::framesCorrupted() const
+{
+    return m_framesCorrupted;
+}
+
+/**
+ * Lazily build the source namespace and encoder, then refresh the send
+ * list from the current configuration.
+ */
+bool LoadGenerator::start()
+{
+    if (m_sourceManager == NULL) {
+        m_sourceManager = new UAVObjectManager();
+        UAVObjectsInitialize(m_sourceManager);
+        m_encodeBuffer.open(QIODevice::WriteOnly);
+        m_encoder = new UAVTalk(&m_encodeBuffer, m_sourceManager);
+    }
+    buildSendList();
+    if (m_sendList.isEmpty()) {
+        qWarning() << "LoadGenerator - object mix matches no data object";
+        return false;
+    }
+    m_sendCursor = 0;
+    m_tickCarry  = 0.0;
+    m_framesSent = 0;
+    m_bytesSent  = 0;
+    m_framesCorrupted = 0;
+    return true;
+}
+
+void LoadGenerator::buildSendList()
+{
+    m_sendList.clear();
+
+    QList< QList<UAVDataObject *> > objects = m_sourceManager->getDataObjects();
+    foreach(const QList<UAVDataObject *> &instances, objects) {
+        UAVDataObject *first = instances.first();
+        if (!m_objectMix.isEmpty() && !m_objectMix.contains(first->getName())) {
+            continue;
+        }
+        if (!first->isSingleInstance()) {
+            // grow the instance count to the configured value
+            for (quint32 instId = instances.size(); instId < m_instanceCount; ++instId) {
+                m_sourceManager->createObjectInstances(first->getObjID(), 1);
+            }
+            foreach(UAVObject * obj, m_sourceManager->getObjectInstances(first->getObjID())) {
+                m_sendList.append(static_cast<UAVDataObject *>(obj));
+            }
+        } else {
+            m_sendList.append(first);
+        }
+    }
+}
+
+void LoadGenerator::onTick()
+{
+    // carry the fractional frames over to the next tick so the aggregate
+    // rate is met exactly instead of being rounded per tick
+    m_tickCarry += (double)m_rate * TICK_MS / 1000.0;
+    int frames = (int)m_tickCarry;
+
+    m_tickCarry -= frames;
+    for (int i = 0; i < frames; ++i) {
+        emitFrame();
+    }
+}
+
+/**
+ * Walk a numeric field so successive frames of the same object differ :
+ * constant payloads would be absorbed by the unchanged payload suppression
+ * downstream and understate the load.
+ */
+void LoadGenerator::perturbObject(UAVDataObject *obj)
+{
+    foreach(UAVObjectField * field, obj->getFields()) {
+        if (field->isNumeric()) {
+            field->setDouble(field->getDouble() + 1.0);
+            break;
+        }
+    }
+}
+
+void LoadGenerator::emitFrame()
+{
+    UAVDataObject *obj = m_sendList.at(m_sendCursor);
+
+    m_sendCursor = (m_sendCursor + 1) % m_sendList.size();
+
+    perturbObject(obj);
+    m_encoder->sendObject(obj, false, false);
+
+    QByteArray frame = m_encodeBuffer.buffer();
+    m_encodeBuffer.buffer().clear();
+    m_encodeBuffer.seek(0);
+
+    if ((m_errorRate > 0.0) && (((double)qrand() / RAND_MAX) < m_errorRate)) {
+        // flip one byte anywhere in the frame : depending on the position
+        // this exercises CRC rejection or resynchronization in the receiver
+        int pos = qrand() % frame.size();
+        frame[pos] = frame.at(pos) ^ 0x55;
+        ++m_framesCorrupted;
+    }
+
+    if (m_udpSocket != NULL) {
+        m_udpSocket->write(frame);
+    } else if (m_loopbackDevice != NULL) {
+        m_loopbackDevice->feed(frame);
+    }
+    ++m_framesSent;
+    m_bytesSent += frame.size();
+}
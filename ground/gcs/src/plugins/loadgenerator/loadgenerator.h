@@ -0,0 +1,155 @@
+/**
+ ******************************************************************************
+ *
+ * @file       loadgenerator.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup LoadGeneratorPlugin Plugin
+ * @{
+ * @brief Synthetic UAVTalk telemetry load generator
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include "loadgenerator_global.h"
+
+#include <QObject>
+#include <QIODevice>
+#include <QByteArray>
+#include <QMutex>
+#include <QStringList>
+#include <QTimer>
+#include <QBuffer>
+
+class UAVObjectManager;
+class UAVDataObject;
+class UAVTalk;
+class TelemetryManager;
+class QUdpSocket;
+
+/**
+ * One way in-process pipe used for the loopback sink : the generator feeds
+ * raw frames in through feed() (thread safe, the consumer lives on the
+ * telemetry thread), the telemetry stack reads them out like any other
+ * link device. Bytes written by the consumer (telemetry uplink traffic)
+ * are accepted and discarded.
+ */
+class LOADGENERATOR_EXPORT LoopbackDevice : public QIODevice {
+    Q_OBJECT
+
+public:
+    LoopbackDevice(QObject *parent = 0);
+
+    void feed(const QByteArray &data);
+
+    virtual bool isSequential() const;
+    virtual qint64 bytesAvailable() const;
+
+protected:
+    virtual qint64 readData(char *data, qint64 maxSize);
+    virtual qint64 writeData(const char *data, qint64 maxSize);
+
+private:
+    mutable QMutex m_mutex;
+    QByteArray m_buffer;
+};
+
+/**
+ * Fabricates UAVTalk telemetry streams so ground station sizing can be done
+ * on the bench without an airframe : a configurable object mix is encoded
+ * through a real UAVTalk instance at up to 10 kHz aggregate and fed either
+ * into the GCS's own telemetry stack over a loopback device, or out of a
+ * UDP socket towards another station. A fraction of the frames can be
+ * corrupted to exercise resynchronization under load.
+ *
+ * Published in the plugin object pool; scripts and gadgets configure and
+ * start it through this interface.
+ */
+class LOADGENERATOR_EXPORT LoadGenerator : public QObject {
+    Q_OBJECT
+
+public:
+    LoadGenerator(QObject *parent = 0);
+    ~LoadGenerator();
+
+    // Configuration, picked up by the next start. An empty mix means every
+    // data object of the generated set.
+    void setObjectMix(const QStringList &objectNames);
+    void setInstanceCount(quint32 instanceCount);
+    void setAggregateRate(quint32 framesPerSecond);
+    void setErrorRate(double corruptedFraction);
+
+    // Feed the GCS's own telemetry stack through a private session, the
+    // way a connected vehicle would.
+    bool startLoopback();
+    // Send the stream to another station over UDP.
+    bool startUdp(const QString &host, quint16 port);
+    void stop();
+    bool isRunning() const;
+
+    // The telemetry session behind the loopback sink, NULL unless running
+    // in loopback mode. Its object manager holds the received objects.
+    TelemetryManager *loopbackSession() const;
+
+    quint64 framesSent() const;
+    quint64 bytesSent() const;
+    quint64 framesCorrupted() const;
+
+private slots:
+    void onTick();
+
+private:
+    // Aggregate rate cap; beyond this the 10 ms tick granularity starts to
+    // produce bursts coarse enough to distort what is being measured.
+    static const quint32 MAX_AGGREGATE_RATE = 10000;
+    static const int TICK_MS = 10;
+
+    bool start();
+    void buildSendList();
+    void perturbObject(UAVDataObject *obj);
+    void emitFrame();
+
+    // configuration
+    QStringList m_objectMix;
+    quint32 m_instanceCount;
+    quint32 m_rate;
+    double m_errorRate;
+
+    // source side : a private object namespace the frames are encoded from
+    UAVObjectManager *m_sourceManager;
+    QBuffer m_encodeBuffer;
+    UAVTalk *m_encoder;
+    QList<UAVDataObject *> m_sendList;
+    int m_sendCursor;
+
+    // sinks
+    LoopbackDevice *m_loopbackDevice;
+    UAVObjectManager *m_sinkManager;
+    TelemetryManager *m_session;
+    QUdpSocket *m_udpSocket;
+
+    QTimer m_timer;
+    double m_tickCarry;
+
+    quint64 m_framesSent;
+    quint64 m_bytesSent;
+    quint64 m_framesCorrupted;
+};
+
+#endif // LOADGENERATOR_H
@@ -0,0 +1,3 @@
+include(loadgenerator_dependencies.pri)
+
+LIBS *= -l$$qtLibraryName(LoadGenerator)
@@ -0,0 +1,20 @@
+TEMPLATE = lib
+TARGET = LoadGenerator
+
+DEFINES += LOADGENERATOR_LIBRARY
+
+QT += network
+
+include(../../plugin.pri)
+include(loadgenerator_dependencies.pri)
+
+HEADERS += \
+    loadgenerator_global.h \
+    loadgenerator.h \
+    loadgeneratorplugin.h
+
+SOURCES += \
+    loadgenerator.cpp \
+    loadgeneratorplugin.cpp
+
+OTHER_FILES += LoadGenerator.pluginspec
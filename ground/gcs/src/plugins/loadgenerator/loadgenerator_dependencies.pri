@@ -0,0 +1,3 @@
+include(../../plugins/uavobjects/uavobjects.pri)
+include(../../plugins/uavtalk/uavtalk.pri)
+include(../../plugins/coreplugin/coreplugin.pri)
@@ -1,13 +1,13 @@
 /**
  ******************************************************************************
  *
- * @file       gpsparser.cpp
- * @author     Sami Korhonen & the OpenPilot team Copyright (C) 2010.
+ * @file       loadgenerator_global.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
  * @addtogroup GCSPlugins GCS Plugins
  * @{
- * @addtogroup AntennaTrackGadgetPlugin Antenna Track Gadget Plugin
+ * @addtogroup LoadGeneratorPlugin Plugin
  * @{
- * @brief A gadget that communicates with antenna tracker and enables basic configuration
+ * @brief Synthetic UAVTalk telemetry load generator
  *****************************************************************************/
 /*
  * This program is free software; you can redistribute it and/or modify
@@ -24,20 +24,15 @@
  * with this program; if not, write to the Free Software Foundation, Inc.,
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
+#ifndef LOADGENERATOR_GLOBAL_H
+#define LOADGENERATOR_GLOBAL_H
 
-#include "gpsparser.h"
+#include <QtCore/qglobal.h>
 
-GPSParser::GPSParser(QObject *parent) : QObject(parent)
-{
-    qRegisterMetaType<QList<int> >("QList<int>");
-}
+#if defined(LOADGENERATOR_LIBRARY)
+#  define LOADGENERATOR_EXPORT Q_DECL_EXPORT
+#else
+#  define LOADGENERATOR_EXPORT Q_DECL_IMPORT
+#endif
 
-GPSParser::~GPSParser()
-{}
-
-void GPSParser::processInputStream(char c)
-{
-    {
-        Q_UNUSED(c)
-    }
-}
+#endif // LOADGENERATOR_GLOBAL_H
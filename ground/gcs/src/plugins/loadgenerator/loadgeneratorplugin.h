@@ -0,0 +1,53 @@
+/**
+ ******************************************************************************
+ *
+ * @file       loadgeneratorplugin.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup LoadGeneratorPlugin Plugin
+ * @{
+ * @brief Synthetic UAVTalk telemetry load generator
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef LOADGENERATORPLUGIN_H
+#define LOADGENERATORPLUGIN_H
+
+#include "loadgenerator_global.h"
+
+#include <extensionsystem/iplugin.h>
+#include <QtPlugin>
+
+class LoadGenerator;
+
+class LOADGENERATOR_EXPORT LoadGeneratorPlugin : public ExtensionSystem::IPlugin {
+    Q_OBJECT
+                     Q_PLUGIN_METADATA(IID "LibrePilot.LoadGenerator")
+
+public:
+    LoadGeneratorPlugin();
+    ~LoadGeneratorPlugin();
+
+    bool initialize(const QStringList &arguments, QString *errorString);
+    void extensionsInitialized();
+    void shutdown();
+
+private:
+    LoadGenerator *generator;
+};
+
+#endif // LOADGENERATORPLUGIN_H
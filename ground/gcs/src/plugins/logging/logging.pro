@@ -10,12 +10,14 @@ include(logging_dependencies.pri)
 
 HEADERS += \
     loggingplugin.h \
+    logsessionindexer.h \
     logginggadgetwidget.h \
     logginggadget.h \
     logginggadgetfactory.h
 
 SOURCES += \
     loggingplugin.cpp \
+    logsessionindexer.cpp \
     logginggadgetwidget.cpp \
     logginggadget.cpp \
     logginggadgetfactory.cpp
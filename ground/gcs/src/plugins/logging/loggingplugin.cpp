@@ -29,6 +29,7 @@
 
 #include "loggingplugin.h"
 #include "logginggadgetfactory.h"
+#include "logsessionindexer.h"
 #include <QDebug>
 #include <QtPlugin>
 #include <QThread>
@@ -42,6 +43,8 @@
 #include <extensionsystem/pluginmanager.h>
 #include <QKeySequence>
 #include "uavobjectmanager.h"
+#include "uavobjects/uavobjectsinit.h"
+#include "systemalarms.h"
 
 
 LoggingConnection::LoggingConnection(LoggingPlugin *loggingPlugin) :
@@ -284,6 +287,202 @@ void LoggingThread::transactionCompleted(UAVObject *obj, bool success)
 }
 
 
+/****************************************************************
+    Black box recorder
+ ********************************/
+
+/**
+ * In-memory device UAVTalk serializes into. Each write carries one
+ * complete frame, which the recorder timestamps and rings.
+ */
+class BlackBoxSink : public QIODevice {
+public:
+    BlackBoxSink(BlackBoxRecorder *recorder) : QIODevice(recorder), m_recorder(recorder)
+    {
+        open(QIODevice::WriteOnly);
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen)
+    {
+        Q_UNUSED(data);
+        Q_UNUSED(maxlen);
+        return -1;
+    }
+    qint64 writeData(const char *data, qint64 dataSize)
+    {
+        m_recorder->appendFrame(data, dataSize);
+        return dataSize;
+    }
+
+private:
+    BlackBoxRecorder *m_recorder;
+};
+
+BlackBoxRecorder::BlackBoxRecorder(QObject *parent) : QObject(parent),
+    m_ringBytes(0),
+    m_historyWindowMs(30 * 1000),
+    m_sink(NULL),
+    m_uavTalk(NULL),
+    m_inAlarm(false)
+{}
+
+BlackBoxRecorder::~BlackBoxRecorder()
+{
+    stop();
+}
+
+/**
+ * Connect every object update into the ring. Delta encoding stays off,
+ * so each captured frame is self contained and aging old frames out
+ * never breaks the decodability of what remains.
+ */
+void BlackBoxRecorder::start()
+{
+    if (isRecording()) {
+        return;
+    }
+
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+
+    m_sink    = new BlackBoxSink(this);
+    m_uavTalk = new UAVTalk(m_sink, objManager);
+    m_clock.start();
+
+    QList< QList<UAVObject *> > list = objManager->getObjects();
+    QList< QList<UAVObject *> >::const_iterator i;
+    QList<UAVObject *>::const_iterator j;
+
+    for (i = list.constBegin(); i != list.constEnd(); ++i) {
+        for (j = (*i).constBegin(); j != (*i).constEnd(); ++j) {
+            connect(*j, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectUpdated(UAVObject *)));
+        }
+    }
+
+    // watch the alarms for the automatic trigger
+    m_inAlarm = false;
+    SystemAlarms *alarms = SystemAlarms::GetInstance(objManager);
+    connect(alarms, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(alarmsUpdated(UAVObject *)));
+
+    qDebug() << "Black box recording started," << m_historyWindowMs / 1000 << "s history window";
+}
+
+void BlackBoxRecorder::stop()
+{
+    if (!isRecording()) {
+        return;
+    }
+
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+
+    QList< QList<UAVObject *> > list = objManager->getObjects();
+    QList< QList<UAVObject *> >::const_iterator i;
+    QList<UAVObject *>::const_iterator j;
+
+    for (i = list.constBegin(); i != list.constEnd(); ++i) {
+        for (j = (*i).constBegin(); j != (*i).constEnd(); ++j) {
+            disconnect(*j, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectUpdated(UAVObject *)));
+        }
+    }
+    disconnect(SystemAlarms::GetInstance(objManager), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(alarmsUpdated(UAVObject *)));
+
+    delete m_uavTalk;
+    m_uavTalk = NULL;
+    delete m_sink;
+    m_sink = NULL;
+    m_ring.clear();
+    m_ringBytes = 0;
+}
+
+void BlackBoxRecorder::objectUpdated(UAVObject *obj)
+{
+    if (m_uavTalk && !m_uavTalk->sendObject(obj, false, false)) {
+        qDebug() << "Black box error recording " << obj->getName();
+    }
+}
+
+void BlackBoxRecorder::appendFrame(const char *data, qint64 dataSize)
+{
+    Frame frame;
+
+    frame.timeStamp = (quint32)m_clock.elapsed();
+    frame.data = QByteArray(data, (int)dataSize);
+    m_ring.enqueue(frame);
+    m_ringBytes += dataSize;
+
+    // age out frames beyond the history window or the byte budget
+    while (!m_ring.isEmpty() &&
+           (((frame.timeStamp - m_ring.head().timeStamp) > m_historyWindowMs) ||
+            (m_ringBytes > MAX_RING_BYTES))) {
+        m_ringBytes -= m_ring.head().data.size();
+        m_ring.dequeue();
+    }
+}
+
+/**
+ * Writes the ring into a regular log file through the async LogFile
+ * writer, rebased so the log starts at the oldest captured frame.
+ * Recording continues, the ring is not consumed.
+ */
+bool BlackBoxRecorder::dumpToFile(QString file)
+{
+    if (m_ring.isEmpty()) {
+        return false;
+    }
+
+    LogFile logFile;
+    logFile.setFileName(file);
+    logFile.useProvidedTimeStamp(true);
+    if (!logFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    quint32 base = m_ring.head().timeStamp;
+    foreach(const Frame &frame, m_ring) {
+        logFile.setNextTimeStamp(frame.timeStamp - base);
+        logFile.write(frame.data);
+    }
+    logFile.close();
+
+    qDebug() << "Black box dumped" << m_ring.count() << "frames to" << file;
+    return true;
+}
+
+/**
+ * The automatic trigger: persist the ring when any alarm goes Critical
+ * or Error. Only the transition into the alarm dumps, so a persisting
+ * alarm does not write a file per SystemAlarms update.
+ */
+void BlackBoxRecorder::alarmsUpdated(UAVObject *obj)
+{
+    SystemAlarms *alarmsObj = qobject_cast<SystemAlarms *>(obj);
+
+    if (!alarmsObj) {
+        return;
+    }
+    SystemAlarms::DataFields alarms = alarmsObj->getData();
+
+    bool inAlarm = false;
+    for (quint32 i = 0; i < SystemAlarms::ALARM_NUMELEM; ++i) {
+        if (alarms.Alarm[i] >= SystemAlarms::ALARM_CRITICAL) {
+            inAlarm = true;
+            break;
+        }
+    }
+    if (inAlarm && !m_inAlarm) {
+        // no dialogs here, this runs on a trigger, not a user action
+        QString file = QDir(QDir::homePath()).filePath(
+            tr("OP-blackbox-%0.opl").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss")));
+        if (dumpToFile(file)) {
+            emit triggered(file);
+        }
+    }
+    m_inAlarm = inAlarm;
+}
+
+
 /****************************************************************
     Logging plugin
  ********************************/
@@ -292,9 +491,17 @@ void LoggingThread::transactionCompleted(UAVObject *obj, bool success)
 LoggingPlugin::LoggingPlugin() :
     state(IDLE),
     loggingThread(NULL),
+    blackBox(NULL),
     logConnection(new LoggingConnection(this)),
     mf(NULL),
-    cmd(NULL)
+    cmd(NULL),
+    blackBoxCmd(NULL),
+    blackBoxDumpCmd(NULL),
+    indexCmd(NULL),
+    replayContextCmd(NULL),
+    logIndexer(NULL),
+    replayObjectMngr(NULL),
+    replayTelemetryMngr(NULL)
 {}
 
 LoggingPlugin::~LoggingPlugin()
@@ -333,6 +540,42 @@ bool LoggingPlugin::initialize(const QStringList & args, QString *errMsg)
 
     connect(cmd->action(), SIGNAL(triggered(bool)), this, SLOT(toggleLogging()));
 
+    // Black box: always-on ring recording, dumped on alarms or on demand
+    blackBox    = new BlackBoxRecorder(this);
+    connect(blackBox, SIGNAL(triggered(QString)), this, SLOT(blackBoxTriggered(QString)));
+
+    blackBoxCmd = am->registerAction(new QAction(this),
+                                     "LoggingPlugin.BlackBox",
+                                     QList<int>() <<
+                                     Core::Constants::C_GLOBAL_ID);
+    blackBoxCmd->action()->setText(tr("Start black box"));
+    ac->addAction(blackBoxCmd, "Logging");
+    connect(blackBoxCmd->action(), SIGNAL(triggered(bool)), this, SLOT(toggleBlackBox()));
+
+    blackBoxDumpCmd = am->registerAction(new QAction(this),
+                                         "LoggingPlugin.BlackBoxDump",
+                                         QList<int>() <<
+                                         Core::Constants::C_GLOBAL_ID);
+    blackBoxDumpCmd->action()->setText(tr("Dump black box..."));
+    blackBoxDumpCmd->action()->setEnabled(false);
+    ac->addAction(blackBoxDumpCmd, "Logging");
+    connect(blackBoxDumpCmd->action(), SIGNAL(triggered(bool)), this, SLOT(dumpBlackBox()));
+
+    indexCmd = am->registerAction(new QAction(this),
+                                  "LoggingPlugin.IndexLogs",
+                                  QList<int>() <<
+                                  Core::Constants::C_GLOBAL_ID);
+    indexCmd->action()->setText(tr("Index flight logs..."));
+    ac->addAction(indexCmd, "Logging");
+    connect(indexCmd->action(), SIGNAL(triggered(bool)), this, SLOT(indexLogs()));
+
+    replayContextCmd = am->registerAction(new QAction(this),
+                                          "LoggingPlugin.ReplayContext",
+                                          QList<int>() <<
+                                          Core::Constants::C_GLOBAL_ID);
+    replayContextCmd->action()->setText(tr("Replay log in separate context..."));
+    ac->addAction(replayContextCmd, "Logging");
+    connect(replayContextCmd->action(), SIGNAL(triggered(bool)), this, SLOT(toggleReplayContext()));
 
     mf = new LoggingGadgetFactory(this);
     addAutoReleasedObject(mf);
@@ -417,6 +660,163 @@ void LoggingPlugin::loggingStopped()
     loggingThread = NULL;
 }
 
+/**
+ * Arm or disarm the black box from the menu
+ */
+void LoggingPlugin::toggleBlackBox()
+{
+    if (!blackBox->isRecording()) {
+        blackBox->start();
+        blackBoxCmd->action()->setText(tr("Stop black box"));
+        blackBoxDumpCmd->action()->setEnabled(true);
+    } else {
+        blackBox->stop();
+        blackBoxCmd->action()->setText(tr("Start black box"));
+        blackBoxDumpCmd->action()->setEnabled(false);
+    }
+}
+
+/**
+ * The manual trigger: ask for a file and persist the ring to it
+ */
+void LoggingPlugin::dumpBlackBox()
+{
+    QString fileName = QFileDialog::getSaveFileName(NULL, tr("Dump Black Box"),
+                                                    tr("OP-blackbox-%0.opl").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss")),
+                                                    tr("OpenPilot Log (*.opl)"));
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (!blackBox->dumpToFile(fileName)) {
+        QErrorMessage err;
+        err.showMessage(tr("Unable to dump the black box, no data captured yet"));
+        err.exec();
+    }
+}
+
+/**
+ * An alarm transition persisted the ring on its own
+ */
+void LoggingPlugin::blackBoxTriggered(QString file)
+{
+    qDebug() << "Black box triggered by an alarm, saved" << file;
+}
+
+/**
+ * Ask for the log directory and index it in the background
+ */
+void LoggingPlugin::indexLogs()
+{
+    if (logIndexer && logIndexer->isRunning()) {
+        return;
+    }
+    QString directory = QFileDialog::getExistingDirectory(NULL, tr("Index Flight Logs"));
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    delete logIndexer;
+    logIndexer = new LogSessionIndexer(directory, this);
+    connect(logIndexer, SIGNAL(indexingFinished(int)), this, SLOT(indexingFinished(int)));
+    logIndexer->start();
+}
+
+void LoggingPlugin::indexingFinished(int sessions)
+{
+    qDebug() << "Indexed" << sessions << "log sessions in" << logIndexer->directory();
+    foreach(const LogSessionSummary &summary, logIndexer->sessions()) {
+        qDebug().nospace() << summary.file << ": " << summary.durationMs / 1000 << "s, "
+                           << (summary.vehicle.isEmpty() ? QString("unknown vehicle") : summary.vehicle)
+                           << ", max altitude " << summary.maxAltitude << "m"
+                           << ", max distance " << summary.maxDistance << "m"
+                           << (summary.alarms.isEmpty() ? QString() : QString(", alarms: ") + summary.alarms.join(", "));
+    }
+}
+
+/**
+ * Start or stop a replay routed into an isolated object namespace.
+ *
+ * Unlike the regular "Logfile replay" connection, which feeds the shared
+ * UAVObjectManager and therefore cannot run next to a live link, the
+ * context replay drives a private object manager through its own telemetry
+ * stack. A live connection keeps the pool manager; gadgets that want to
+ * show the replay resolve their objects through replayContext() once
+ * replayContextStarted() fires.
+ */
+void LoggingPlugin::toggleReplayContext()
+{
+    if (replayTelemetryMngr != NULL) {
+        stopReplayContext();
+        return;
+    }
+
+    QString fileName = QFileDialog::getOpenFileName(NULL, tr("Open file"), QString(""), tr("OpenPilot Log (*.opl)"));
+    if (fileName.isNull()) {
+        return;
+    }
+
+    replayLogFile.setFileName(fileName);
+    if (!replayLogFile.open(QIODevice::ReadOnly)) {
+        QErrorMessage err;
+        err.showMessage(tr("Unable to open the log file for replay"));
+        err.exec();
+        return;
+    }
+
+    // A private object manager populated with the full generated object set,
+    // same recipe as the multi-vehicle sessions : the field descriptions are
+    // shared through the per type prototypes, only the data buffers are per
+    // namespace.
+    replayObjectMngr = new UAVObjectManager();
+    UAVObjectsInitialize(replayObjectMngr);
+
+    replayTelemetryMngr = new TelemetryManager(replayObjectMngr);
+    connect(&replayLogFile, SIGNAL(replayFinished()), this, SLOT(replayContextFinished()));
+
+    qDebug() << "Replaying" << fileName << "into an isolated context";
+    replayLogFile.startReplay();
+    replayTelemetryMngr->start(&replayLogFile);
+
+    replayContextCmd->action()->setText(tr("Stop context replay"));
+    emit replayContextStarted();
+}
+
+/**
+ * The context replay reached the end of the log
+ */
+void LoggingPlugin::replayContextFinished()
+{
+    stopReplayContext();
+}
+
+void LoggingPlugin::stopReplayContext()
+{
+    if (replayTelemetryMngr == NULL) {
+        return;
+    }
+
+    disconnect(&replayLogFile, SIGNAL(replayFinished()), this, SLOT(replayContextFinished()));
+
+    // tell the gadgets first, they must drop their object references before
+    // the namespace goes away
+    UAVObjectManager *objMngr = replayObjectMngr;
+    replayObjectMngr = NULL;
+    emit replayContextStopped();
+
+    replayTelemetryMngr->stop();
+    if (replayLogFile.isOpen()) {
+        replayLogFile.close();
+    }
+    // stop() completes asynchronously on the telemetry thread, defer the
+    // deletions until its queue has drained
+    replayTelemetryMngr->deleteLater();
+    objMngr->deleteLater();
+    replayTelemetryMngr = NULL;
+
+    replayContextCmd->action()->setText(tr("Replay log in separate context..."));
+}
+
 /**
  * Received the replay stopped signal from the LogFile
  */
@@ -443,7 +843,7 @@ void LoggingPlugin::extensionsInitialized()
 
 void LoggingPlugin::shutdown()
 {
-    // Do nothing
+    stopReplayContext();
 }
 /**
  * @}
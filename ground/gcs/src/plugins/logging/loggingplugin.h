@@ -35,14 +35,17 @@
 #include "uavobjectmanager.h"
 #include "gcstelemetrystats.h"
 #include <uavtalk/uavtalk.h>
+#include <uavtalk/telemetrymanager.h>
 #include <utils/logfile.h>
 
 #include <QThread>
 #include <QQueue>
 #include <QReadWriteLock>
+#include <QElapsedTimer>
 
 class LoggingPlugin;
 class LoggingGadgetFactory;
+class LogSessionIndexer;
 
 /**
  *   Define a connection via the IConnection interface
@@ -114,6 +117,65 @@ private:
     void retrieveNextObject();
 };
 
+/**
+ * Always-on black box. Serializes every object update into a bounded
+ * in-memory ring of timestamped UAVTalk frames, so the seconds leading up
+ * to a failure are captured without the logging plugin being armed and
+ * without any disk I/O. A trigger - an alarm going critical, or the user -
+ * dumps the ring, pre-trigger history included, into a normal log file.
+ */
+class BlackBoxRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    BlackBoxRecorder(QObject *parent = 0);
+    ~BlackBoxRecorder();
+
+    bool isRecording() const
+    {
+        return m_uavTalk != NULL;
+    }
+    // ! Seconds of pre-trigger history to keep, within the byte budget
+    void setHistoryWindow(int seconds)
+    {
+        m_historyWindowMs = (quint32)seconds * 1000;
+    }
+
+    void start();
+    void stop();
+    // ! Persist the ring, including the pre-trigger history, to a log file
+    bool dumpToFile(QString file);
+
+    // ! Called by the capture device, one complete UAVTalk frame per call
+    void appendFrame(const char *data, qint64 dataSize);
+
+signals:
+    // ! Emitted after an alarm transition persisted the ring
+    void triggered(QString file);
+
+private slots:
+    void objectUpdated(UAVObject *obj);
+    void alarmsUpdated(UAVObject *obj);
+
+private:
+    // Cap on the ring memory, frames age out beyond it even inside the window
+    static const int MAX_RING_BYTES = 4 * 1024 * 1024;
+
+    // ! One serialized object update, timestamped like a log file frame
+    struct Frame {
+        quint32    timeStamp;
+        QByteArray data;
+    };
+
+    QQueue<Frame> m_ring;
+    qint64  m_ringBytes;
+    quint32 m_historyWindowMs;
+    QElapsedTimer m_clock;
+    QIODevice *m_sink;
+    UAVTalk   *m_uavTalk;
+    bool m_inAlarm;
+};
+
 class LoggingPlugin : public ExtensionSystem::IPlugin {
     Q_OBJECT
                                               Q_PLUGIN_METADATA(IID "OpenPilot.Logging")
@@ -138,16 +200,32 @@ public:
     }
     void setLogMenuTitle(QString str);
 
+    // Isolated replay context : a log replay routed into its own object
+    // manager namespace, so reviewing a recorded flight does not fight a
+    // live connection over the shared UAVObjectManager. Gadgets opt in by
+    // resolving objects through replayContext() instead of the pool manager;
+    // it returns NULL while no context replay is running.
+    UAVObjectManager *replayContext() const
+    {
+        return replayObjectMngr;
+    }
+    bool isReplayContextActive() const
+    {
+        return replayObjectMngr != NULL;
+    }
 
 signals:
     void stopLoggingSignal(void);
     void stopReplaySignal(void);
     void stateChanged(QString);
+    void replayContextStarted();
+    void replayContextStopped();
 
 
 protected:
     enum { IDLE, LOGGING, REPLAY } state;
     LoggingThread *loggingThread;
+    BlackBoxRecorder *blackBox;
 
     // These are used for replay, logging in its own thread
     LoggingConnection *logConnection;
@@ -159,10 +237,30 @@ private slots:
     void loggingStopped();
     void replayStarted();
     void replayStopped();
+    void toggleBlackBox();
+    void dumpBlackBox();
+    void blackBoxTriggered(QString file);
+    void indexLogs();
+    void indexingFinished(int sessions);
+    void toggleReplayContext();
+    void replayContextFinished();
 
 private:
     LoggingGadgetFactory *mf;
     Core::Command *cmd;
+    Core::Command *blackBoxCmd;
+    Core::Command *blackBoxDumpCmd;
+    Core::Command *indexCmd;
+    Core::Command *replayContextCmd;
+    LogSessionIndexer *logIndexer;
+
+    // Replay context state : the log is replayed through a private telemetry
+    // stack feeding a private object manager
+    UAVObjectManager *replayObjectMngr;
+    TelemetryManager *replayTelemetryMngr;
+    LogFile replayLogFile;
+
+    void stopReplayContext();
 };
 #endif /* LoggingPLUGIN_H_ */
 /**
@@ -0,0 +1,244 @@
+/**
+ ******************************************************************************
+ * @file       logsessionindexer.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup loggingplugin
+ * @{
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "logsessionindexer.h"
+
+#include <extensionsystem/pluginmanager.h>
+#include "uavobjectmanager.h"
+#include "systemalarms.h"
+#include "positionstate.h"
+#include "systemsettings.h"
+#include <utils/logfile.h>
+
+#include <QDir>
+#include <QSettings>
+#include <QtEndian>
+#include <QDebug>
+#include <math.h>
+
+const QString LogSessionIndexer::INDEX_FILE_NAME = ".oplindex.ini";
+
+LogSessionIndexer::LogSessionIndexer(QString directory, QObject *parent) : QThread(parent),
+    m_directory(directory)
+{
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+
+    m_alarmsProto   = dynamic_cast<SystemAlarms *>(SystemAlarms::GetInstance(objManager)->clone(0));
+    m_positionProto = dynamic_cast<PositionState *>(PositionState::GetInstance(objManager)->clone(0));
+    m_settingsProto = dynamic_cast<SystemSettings *>(SystemSettings::GetInstance(objManager)->clone(0));
+}
+
+LogSessionIndexer::~LogSessionIndexer()
+{
+    wait();
+    delete m_alarmsProto;
+    delete m_positionProto;
+    delete m_settingsProto;
+}
+
+QList<LogSessionSummary> LogSessionIndexer::sessions() const
+{
+    QMutexLocker locker(&m_sessionsMutex);
+
+    return m_sessions;
+}
+
+/**
+ * Scan the directory. Logs already summarized by a previous run are
+ * recognized by size and modification time and reused from the index,
+ * everything else is parsed and the index file is rewritten.
+ */
+void LogSessionIndexer::run()
+{
+    QDir dir(m_directory);
+    QStringList files = dir.entryList(QStringList() << "*.opl", QDir::Files, QDir::Name);
+
+    // what the previous run already knows, keyed by file name
+    QMap<QString, LogSessionSummary> known;
+    foreach(const LogSessionSummary &summary, loadIndex()) {
+        known.insert(summary.file, summary);
+    }
+
+    QList<LogSessionSummary> sessions;
+    int indexed = 0;
+    foreach(const QString &file, files) {
+        QFileInfo info(dir.filePath(file));
+        LogSessionSummary summary = known.value(file);
+        if ((summary.fileSize != info.size()) || (summary.modified != info.lastModified())) {
+            summary = LogSessionSummary();
+            summary.file     = file;
+            summary.fileSize = info.size();
+            summary.modified = info.lastModified();
+            if (!summarizeLog(info.filePath(), summary)) {
+                continue;
+            }
+        }
+        sessions.append(summary);
+
+        m_sessionsMutex.lock();
+        m_sessions = sessions;
+        m_sessionsMutex.unlock();
+        emit progress(++indexed, files.count());
+    }
+
+    saveIndex(sessions);
+    emit indexingFinished(sessions.count());
+}
+
+/**
+ * Bulk decode one log into its summary. The frames stream out of the
+ * memory mapping without the replay clock, so this runs at disk speed.
+ */
+bool LogSessionIndexer::summarizeLog(const QString &path, LogSessionSummary &summary)
+{
+    LogFile logFile;
+
+    logFile.setFileName(path);
+    if (!logFile.open(QIODevice::ReadOnly) || !logFile.startBulkRead()) {
+        return false;
+    }
+
+    quint32 timeStamp;
+    QByteArray frame;
+    while (logFile.readNextFrame(timeStamp, frame)) {
+        summary.frames++;
+        summary.durationMs = timeStamp;
+        parseFrame(frame, summary);
+    }
+    logFile.close();
+
+    summary.alarms.sort();
+    return summary.frames > 0;
+}
+
+/**
+ * Inspect one UAVTalk frame and fold the objects the summary cares
+ * about into it. Payloads are unpacked into detached clones, never into
+ * the live objects. Delta frames are skipped, they cannot be decoded
+ * without the full receiver state.
+ */
+void LogSessionIndexer::parseFrame(const QByteArray &frame, LogSessionSummary &summary)
+{
+    // header : sync(1), type(1), size(2), object ID(4), instance ID(2)
+    const int HEADER_LENGTH = 10;
+    const quint8 *buf = (const quint8 *)frame.constData();
+
+    if ((frame.size() < HEADER_LENGTH) || (buf[0] != 0x3C)) {
+        return;
+    }
+    quint8 type = buf[1];
+    // TYPE_OBJ / TYPE_OBJ_ACK, the only types carrying a full payload
+    if ((type != 0x20) && (type != 0x22)) {
+        return;
+    }
+    quint32 objId = qFromLittleEndian<quint32>(&buf[4]);
+
+    UAVDataObject *proto = NULL;
+    if (objId == SystemAlarms::OBJID) {
+        proto = m_alarmsProto;
+    } else if (objId == PositionState::OBJID) {
+        proto = m_positionProto;
+    } else if (objId == SystemSettings::OBJID) {
+        proto = m_settingsProto;
+    } else {
+        return;
+    }
+    if (frame.size() < HEADER_LENGTH + (int)proto->getNumBytes()) {
+        return;
+    }
+    proto->unpack(&buf[HEADER_LENGTH]);
+
+    if (proto == m_alarmsProto) {
+        SystemAlarms::DataFields alarms = m_alarmsProto->getData();
+        QStringList names = m_alarmsProto->getField("Alarm")->getElementNames();
+        for (quint32 i = 0; i < SystemAlarms::ALARM_NUMELEM; ++i) {
+            if ((alarms.Alarm[i] >= SystemAlarms::ALARM_CRITICAL) &&
+                !summary.alarms.contains(names.at(i))) {
+                summary.alarms.append(names.at(i));
+            }
+        }
+    } else if (proto == m_positionProto) {
+        PositionState::DataFields position = m_positionProto->getData();
+        summary.maxAltitude = qMax(summary.maxAltitude, (double)-position.Down);
+        summary.maxDistance = qMax(summary.maxDistance,
+                                   sqrt((double)position.North * position.North
+                                        + (double)position.East * position.East));
+    } else {
+        UAVObjectField *field = m_settingsProto->getField("AirframeType");
+        summary.vehicle = field->getValue().toString();
+    }
+}
+
+QList<LogSessionSummary> LogSessionIndexer::loadIndex() const
+{
+    QList<LogSessionSummary> sessions;
+    QSettings index(QDir(m_directory).filePath(INDEX_FILE_NAME), QSettings::IniFormat);
+
+    int count = index.beginReadArray("sessions");
+    for (int i = 0; i < count; ++i) {
+        index.setArrayIndex(i);
+        LogSessionSummary summary;
+        summary.file        = index.value("file").toString();
+        summary.fileSize    = index.value("fileSize").toLongLong();
+        summary.modified    = index.value("modified").toDateTime();
+        summary.durationMs  = index.value("durationMs").toUInt();
+        summary.frames      = index.value("frames").toInt();
+        summary.vehicle     = index.value("vehicle").toString();
+        summary.alarms      = index.value("alarms").toStringList();
+        summary.maxAltitude = index.value("maxAltitude").toDouble();
+        summary.maxDistance = index.value("maxDistance").toDouble();
+        sessions.append(summary);
+    }
+    index.endArray();
+    return sessions;
+}
+
+void LogSessionIndexer::saveIndex(const QList<LogSessionSummary> &sessions) const
+{
+    QSettings index(QDir(m_directory).filePath(INDEX_FILE_NAME), QSettings::IniFormat);
+
+    index.clear();
+    index.beginWriteArray("sessions", sessions.count());
+    for (int i = 0; i < sessions.count(); ++i) {
+        index.setArrayIndex(i);
+        const LogSessionSummary &summary = sessions.at(i);
+        index.setValue("file", summary.file);
+        index.setValue("fileSize", summary.fileSize);
+        index.setValue("modified", summary.modified);
+        index.setValue("durationMs", summary.durationMs);
+        index.setValue("frames", summary.frames);
+        index.setValue("vehicle", summary.vehicle);
+        index.setValue("alarms", summary.alarms);
+        index.setValue("maxAltitude", summary.maxAltitude);
+        index.setValue("maxDistance", summary.maxDistance);
+    }
+    index.endArray();
+}
+/**
+ * @}
+ * @}
+ */
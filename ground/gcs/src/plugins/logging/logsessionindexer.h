@@ -0,0 +1,107 @@
+/**
+ ******************************************************************************
+ * @file       logsessionindexer.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup loggingplugin
+ * @{
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef LOGSESSIONINDEXER_H
+#define LOGSESSIONINDEXER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QDateTime>
+#include <QStringList>
+
+class SystemAlarms;
+class PositionState;
+class SystemSettings;
+
+// ! What the session browser needs to know about a log without opening it
+struct LogSessionSummary {
+    QString     file;
+    qint64      fileSize;
+    QDateTime   modified;
+    quint32     durationMs;
+    int         frames;
+    QString     vehicle; // airframe type, from SystemSettings
+    QStringList alarms; // alarm names that reached Critical or Error
+    double      maxAltitude; // m above the home location
+    double      maxDistance; // m from the home location
+
+    LogSessionSummary() : fileSize(0), durationMs(0), frames(0),
+        maxAltitude(0.0), maxDistance(0.0) {}
+};
+
+/**
+ * Indexes a directory of flight logs in the background. Each log is
+ * bulk decoded once - over the memory mapping LogFile sets up - into a
+ * per-session summary, and the summaries are persisted next to the logs
+ * so later scans only parse files that are new or changed. Browsing
+ * hundreds of logs then costs one index read instead of opening each.
+ */
+class LogSessionIndexer : public QThread {
+    Q_OBJECT
+
+public:
+    explicit LogSessionIndexer(QString directory, QObject *parent = 0);
+    ~LogSessionIndexer();
+
+    QString directory() const
+    {
+        return m_directory;
+    }
+    // ! The summaries indexed so far, sorted by file name
+    QList<LogSessionSummary> sessions() const;
+
+signals:
+    void progress(int indexed, int total);
+    void indexingFinished(int sessions);
+
+protected:
+    void run();
+
+private:
+    // index file kept in the scanned directory
+    static const QString INDEX_FILE_NAME;
+
+    bool summarizeLog(const QString &path, LogSessionSummary &summary);
+    void parseFrame(const QByteArray &frame, LogSessionSummary &summary);
+    QList<LogSessionSummary> loadIndex() const;
+    void saveIndex(const QList<LogSessionSummary> &sessions) const;
+
+    QString m_directory;
+    QList<LogSessionSummary> m_sessions;
+    mutable QMutex m_sessionsMutex;
+
+    // detached object clones the payloads are unpacked into, so indexing
+    // never touches the live objects of the connected vehicle
+    SystemAlarms   *m_alarmsProto;
+    PositionState  *m_positionProto;
+    SystemSettings *m_settingsProto;
+};
+
+#endif // LOGSESSIONINDEXER_H
+/**
+ * @}
+ * @}
+ */
@@ -35,17 +35,41 @@
 #include <QVBoxLayout>
 #include <QPushButton>
 
+#include <math.h>
+
 #include "uavobject.h"
 #include "uavobjectmanager.h"
 #include "manualcontrolcommand.h"
 #include "extensionsystem/pluginmanager.h"
 #include "extensionsystem/pluginmanager.h"
 
+// scene redraw period, ~20 updates per second is plenty for the indicators
+#define REFRESH_PERIOD_MS    50
+// minimum spacing between PathDesired uplink writes while dragging
+#define SEND_PERIOD_MS       100
+// position changes below this [m] are not worth an uplink
+#define SEND_MIN_DELTA       0.1
+
 MagicWaypointGadgetWidget::MagicWaypointGadgetWidget(QWidget *parent) : QLabel(parent)
 {
     m_magicwaypoint = new Ui_MagicWaypoint();
     m_magicwaypoint->setupUi(this);
 
+    m_statePending   = false;
+    m_desiredPending = false;
+    m_refreshTimer   = new QTimer(this);
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(REFRESH_PERIOD_MS);
+    connect(m_refreshTimer, SIGNAL(timeout()), this, SLOT(refreshScene()));
+
+    m_requestedNorth = 0;
+    m_requestedEast  = 0;
+    m_requestPending = false;
+    m_sendTimer      = new QTimer(this);
+    m_sendTimer->setSingleShot(true);
+    m_sendTimer->setInterval(SEND_PERIOD_MS);
+    connect(m_sendTimer, SIGNAL(timeout()), this, SLOT(sendPathDesired()));
+
     // Connect object updated event from UAVObject to also update check boxes
     connect(getPathDesired(), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(positionStateChanged(UAVObject *)));
     connect(getPositionState(), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(positionStateChanged(UAVObject *)));
@@ -104,27 +128,48 @@ void MagicWaypointGadgetWidget::scaleChanged(int scale)
 }
 
 /**
- * Emit a position changed signal when @ref PositionState object is changed
+ * Queue a scene refresh when @ref PositionState object is changed
  */
 void MagicWaypointGadgetWidget::positionStateChanged(UAVObject *)
 {
-    PositionState::DataFields positionState = getPositionState()->getData();
-    double scale = m_magicwaypoint->horizontalSliderScale->value();
-
-    emit positionStateObjectChanged(positionState.North / scale,
-                                    positionState.East / scale);
+    // telemetry can update far faster than the scene is worth redrawing,
+    // queue the refresh and let the timer repaint at display rate
+    m_statePending = true;
+    if (!m_refreshTimer->isActive()) {
+        m_refreshTimer->start();
+    }
 }
 
 /**
- * Emit a position changed signal when @ref PathDesired is changed
+ * Queue a scene refresh when @ref PathDesired is changed
  */
 void MagicWaypointGadgetWidget::pathDesiredChanged(UAVObject *)
 {
-    PathDesired::DataFields pathDesired = getPathDesired()->getData();
+    m_desiredPending = true;
+    if (!m_refreshTimer->isActive()) {
+        m_refreshTimer->start();
+    }
+}
+
+/**
+ * Repaint the queued indicators, at most once per refresh period
+ */
+void MagicWaypointGadgetWidget::refreshScene()
+{
     double scale = m_magicwaypoint->horizontalSliderScale->value();
 
-    emit positionDesiredObjectChanged(pathDesired.End[PathDesired::END_NORTH] / scale,
-                                      pathDesired.End[PathDesired::END_EAST] / scale);
+    if (m_statePending) {
+        m_statePending = false;
+        PositionState::DataFields positionState = getPositionState()->getData();
+        emit positionStateObjectChanged(positionState.North / scale,
+                                        positionState.East / scale);
+    }
+    if (m_desiredPending) {
+        m_desiredPending = false;
+        PathDesired::DataFields pathDesired = getPathDesired()->getData();
+        emit positionDesiredObjectChanged(pathDesired.End[PathDesired::END_NORTH] / scale,
+                                          pathDesired.End[PathDesired::END_EAST] / scale);
+    }
 }
 
 /**
@@ -134,12 +179,44 @@ void MagicWaypointGadgetWidget::positionSelected(double north, double east)
 {
     double scale = m_magicwaypoint->horizontalSliderScale->value();
 
+    m_requestedNorth = north * scale;
+    m_requestedEast  = east * scale;
+    m_requestPending = true;
+
+    // leading edge goes out right away, further moves within the send
+    // period are held and the latest one goes out on the timer
+    if (!m_sendTimer->isActive()) {
+        sendPathDesired();
+    }
+}
+
+/**
+ * Write the held position request to @ref PathDesired, skipping
+ * uplinks that would not meaningfully move the endpoint
+ */
+void MagicWaypointGadgetWidget::sendPathDesired()
+{
+    if (!m_requestPending) {
+        return;
+    }
+    m_requestPending = false;
+
     PathDesired::DataFields pathDesired = getPathDesired()->getData();
 
-    pathDesired.End[PathDesired::END_NORTH] = north * scale;
-    pathDesired.End[PathDesired::END_EAST]  = east * scale;
+    if ((pathDesired.Mode == PathDesired::MODE_GOTOENDPOINT)
+        && (fabs(pathDesired.End[PathDesired::END_NORTH] - m_requestedNorth) < SEND_MIN_DELTA)
+        && (fabs(pathDesired.End[PathDesired::END_EAST] - m_requestedEast) < SEND_MIN_DELTA)) {
+        // nothing meaningful changed, no uplink
+        return;
+    }
+
+    pathDesired.End[PathDesired::END_NORTH] = m_requestedNorth;
+    pathDesired.End[PathDesired::END_EAST]  = m_requestedEast;
     pathDesired.Mode = PathDesired::MODE_GOTOENDPOINT;
     getPathDesired()->setData(pathDesired);
+
+    // space out any follow-up writes
+    m_sendTimer->start();
 }
 
 /**
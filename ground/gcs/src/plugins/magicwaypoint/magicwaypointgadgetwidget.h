@@ -29,6 +29,7 @@
 #define MagicWaypointGADGETWIDGET_H_
 
 #include <QLabel>
+#include <QTimer>
 #include "pathdesired.h"
 #include "positionstate.h"
 
@@ -51,10 +52,26 @@ protected slots:
     void pathDesiredChanged(UAVObject *);
     void positionSelected(double north, double east);
 
+private slots:
+    void refreshScene();
+    void sendPathDesired();
+
 private:
     PathDesired *getPathDesired();
     PositionState *getPositionState();
     Ui_MagicWaypoint *m_magicwaypoint;
+
+    // telemetry redraws are coalesced to display rate
+    bool m_statePending;
+    bool m_desiredPending;
+    QTimer *m_refreshTimer;
+
+    // pending uplink, written at most once per timer period and only on
+    // a meaningful position change
+    double m_requestedNorth;
+    double m_requestedEast;
+    bool m_requestPending;
+    QTimer *m_sendTimer;
 };
 
 #endif /* MagicWaypointGADGETWIDGET_H_ */
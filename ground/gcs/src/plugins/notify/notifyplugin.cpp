@@ -39,24 +39,28 @@
 #include <QDebug>
 #include <QtPlugin>
 #include <QStringList>
+#include <QDateTime>
+#include <QUrl>
 
 static const QString VERSION = "1.0.0";
 
+// how many notification sequences may play at the same time,
+// a critical alert no longer waits behind a chatty low priority rule
+static const int MAX_CONCURRENT_SEQUENCES = 3;
+// minimum delay between two starts of the same rule
+static const qint64 RULE_THROTTLE_MS      = 500;
+
 // #define DEBUG_NOTIFIES
 
 
 SoundNotifyPlugin::SoundNotifyPlugin()
-{
-    phonon.mo = NULL;
-}
+{}
 
 SoundNotifyPlugin::~SoundNotifyPlugin()
 {
     Core::ICore::instance()->saveSettings(this);
 
-    if (phonon.mo != NULL) {
-        delete phonon.mo;
-    }
+    disposeSoundSequences();
 }
 
 bool SoundNotifyPlugin::initialize(const QStringList & args, QString *errMsg)
@@ -181,10 +185,7 @@ void SoundNotifyPlugin::connectNotifications()
             disconnect(obj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(on_arrived_Notification(UAVObject *)));
         }
     }
-    if (phonon.mo != NULL) {
-        delete phonon.mo;
-        phonon.mo = NULL;
-    }
+    disposeSoundSequences();
 
     if (!enableSound) {
         return;
@@ -194,6 +195,7 @@ void SoundNotifyPlugin::connectNotifications()
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
 
     lstNotifiedUAVObjects.clear();
+    _rulesByObjId.clear();
     _pendingNotifications.clear();
     _notificationList.append(_toRemoveNotifications);
     _toRemoveNotifications.clear();
@@ -203,6 +205,16 @@ void SoundNotifyPlugin::connectNotifications()
         notify->_isPlayed    = false;
         notify->isNowPlaying = false;
 
+        UAVDataObject *obj = dynamic_cast<UAVDataObject *>(objManager->getObject(notify->getDataObject()));
+        if (obj == NULL) {
+            qNotifyDebug() << "Error: Object is unknown (" << notify->getDataObject() << ").";
+            continue;
+        }
+
+        // every rule goes into the per object index so the event path only
+        // ever evaluates the rules watching the arrived object
+        _rulesByObjId.insert(obj->getObjID(), notify);
+
         if (notify->mute()) {
             continue;
         }
@@ -212,40 +224,71 @@ void SoundNotifyPlugin::connectNotifications()
             continue;
         }
 
-        UAVDataObject *obj = dynamic_cast<UAVDataObject *>(objManager->getObject(notify->getDataObject()));
-        if (obj != NULL) {
-            if (!lstNotifiedUAVObjects.contains(obj)) {
-                lstNotifiedUAVObjects.append(obj);
+        if (!lstNotifiedUAVObjects.contains(obj)) {
+            lstNotifiedUAVObjects.append(obj);
 
-                connect(obj, SIGNAL(objectUpdated(UAVObject *)),
-                        this, SLOT(on_arrived_Notification(UAVObject *)),
-                        Qt::QueuedConnection);
-            }
-        } else {
-            qNotifyDebug() << "Error: Object is unknown (" << notify->getDataObject() << ").";
+            connect(obj, SIGNAL(objectUpdated(UAVObject *)),
+                    this, SLOT(on_arrived_Notification(UAVObject *)),
+                    Qt::QueuedConnection);
         }
     }
 
     if (_notificationList.isEmpty()) {
         return;
     }
-    // set notification message to current event
-    phonon.mo = new QMediaPlayer;
-    phonon.firstPlay = true;
-    connect(phonon.mo, SIGNAL(stateChanged(QMediaPlayer::State)),
-            this, SLOT(stateChanged(QMediaPlayer::State)));
+    // pre-decode the sound sequence of every rule once, instead of decoding
+    // the wav files again each time the rule fires
+    foreach(NotificationItem * notify, _notificationList) {
+        if (notify->mute() || notify->toSoundList().isEmpty()) {
+            continue;
+        }
+        QList<QSoundEffect *> sequence;
+        foreach(QString item, notify->toSoundList()) {
+            QSoundEffect *effect = new QSoundEffect(this);
+
+            effect->setSource(QUrl::fromLocalFile(item));
+            connect(effect, SIGNAL(playingChanged()), this, SLOT(onEffectPlayingChanged()));
+            sequence.append(effect);
+        }
+        _soundSequences.insert(notify, sequence);
+    }
 }
 
-void SoundNotifyPlugin::on_arrived_Notification(UAVObject *object)
+void SoundNotifyPlugin::disposeSoundSequences()
 {
-    foreach(NotificationItem * ntf, _notificationList) {
-        if (object->getName() != ntf->getDataObject()) {
-            continue;
+    foreach(const QList<QSoundEffect *> &sequence, _soundSequences) {
+        qDeleteAll(sequence);
+    }
+    _soundSequences.clear();
+    _activePosition.clear();
+    _lastPlayedMs.clear();
+}
+
+void SoundNotifyPlugin::removeFromRuleIndex(NotificationItem *notification)
+{
+    QMutableHashIterator<quint32, NotificationItem *> it(_rulesByObjId);
+
+    while (it.hasNext()) {
+        it.next();
+        if (it.value() == notification) {
+            it.remove();
+            break;
         }
+    }
+}
 
+void SoundNotifyPlugin::on_arrived_Notification(UAVObject *object)
+{
+    // only the rules watching this objId, not the whole rule list;
+    // QMultiHash::values returns the most recently inserted rule first,
+    // walk backwards to keep the options page rule order
+    QList<NotificationItem *> rules = _rulesByObjId.values(object->getObjID());
+
+    for (int i = rules.size() - 1; i >= 0; --i) {
+        NotificationItem *ntf = rules.at(i);
 
         // skip duplicate notifications
-        if (_nowPlayingNotification == ntf) {
+        if (_activePosition.contains(ntf)) {
             continue;
         }
 
@@ -285,7 +328,7 @@ void SoundNotifyPlugin::on_timerRepeated_Notification()
     // skip duplicate notifications
     // WARNING: generally we shoudn't ever trap here
     // this means, that timer fires to early and notification overlap itself
-    if (_nowPlayingNotification == notification) {
+    if (_activePosition.contains(notification)) {
         qNotifyDebug() << "WARN: on_timerRepeated - notification was skipped!";
         notification->restartTimer();
         return;
@@ -323,34 +366,39 @@ void SoundNotifyPlugin::on_expiredTimer_Notification()
     }
 }
 
-void SoundNotifyPlugin::stateChanged(QMediaPlayer::State newstate)
+void SoundNotifyPlugin::onEffectPlayingChanged()
 {
-    // qNotifyDebug() << "File length (ms): " << phonon.mo->totalTime();
-
-#ifndef Q_OS_WIN
-    // This is a hack to force Linux to wait until the end of the
-    // wav file before moving to the next in the queue.
-    // I wish I did not have to go through a #define, but I did not
-    // manage to make this work on both platforms any other way!
-// if (phonon.mo->totalTime() > 0) {
-// phonon.mo->setTransitionTime(phonon.mo->totalTime());
-// }
-#endif
-    if ((newstate == QMediaPlayer::PausedState) ||
-        (newstate == QMediaPlayer::StoppedState)) {
-        qNotifyDebug() << "New State: " << QVariant(newstate).toString();
-
-        // assignment to NULL needed to detect that palying is finished
-        // it's useful in repeat timer handler, where we can detect
-        // that notification has not overlap with itself
-        _nowPlayingNotification = NULL;
-
-        if (!_pendingNotifications.isEmpty()) {
-            NotificationItem *notification = _pendingNotifications.takeFirst();
-            qNotifyDebug_if(notification) << "play audioFree - " << notification->toString();
-            playNotification(notification);
-            qNotifyDebug() << "end playNotification";
+    QSoundEffect *effect = qobject_cast<QSoundEffect *>(sender());
+
+    if (!effect || effect->isPlaying()) {
+        return;
+    }
+
+    // find the active sequence whose current effect just finished
+    // and either advance it or complete it
+    QMutableHashIterator<NotificationItem *, int> it(_activePosition);
+    while (it.hasNext()) {
+        it.next();
+        const QList<QSoundEffect *> &sequence = _soundSequences.value(it.key());
+        if (it.value() >= sequence.size() || sequence.at(it.value()) != effect) {
+            continue;
         }
+        if (it.value() + 1 < sequence.size()) {
+            it.setValue(it.value() + 1);
+            sequence.at(it.value())->play();
+            return;
+        }
+        qNotifyDebug() << "sequence done - " << it.key()->toString();
+        it.remove();
+        break;
+    }
+
+    // a mixing slot freed up, service the pending list
+    if (!_pendingNotifications.isEmpty()) {
+        NotificationItem *notification = _pendingNotifications.takeFirst();
+        qNotifyDebug_if(notification) << "play audioFree - " << notification->toString();
+        playNotification(notification);
+        qNotifyDebug() << "end playNotification";
     }
 }
 
@@ -451,10 +499,16 @@ void SoundNotifyPlugin::checkNotificationRule(NotificationItem *notification, UA
     if (notification->retryValue() == NotificationItem::repeatOncePerUpdate && notification->getCurrentUpdatePlayed()) {
         return;
     }
+    // throttle the rule : a condition that flaps with every telemetry update
+    // must not machine-gun its sound
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (_lastPlayedMs.contains(notification) && (now - _lastPlayedMs.value(notification)) < RULE_THROTTLE_MS) {
+        return;
+    }
 
     if (!playNotification(notification)) {
         if (!_pendingNotifications.contains(notification)
-            && (_nowPlayingNotification != notification)) {
+            && !_activePosition.contains(notification)) {
             notification->stopTimer();
 
             qNotifyDebug() << "add to pending list - " << notification->toString();
@@ -471,66 +525,57 @@ void SoundNotifyPlugin::checkNotificationRule(NotificationItem *notification, UA
 
 bool SoundNotifyPlugin::playNotification(NotificationItem *notification)
 {
-    playlist = new QMediaPlaylist;
     if (!notification) {
         return false;
     }
 
-    // Check: race condition, if phonon.mo got deleted don't go further
-    if (phonon.mo == NULL) {
+    // Check: race condition, if the sequences got disposed don't go further
+    const QList<QSoundEffect *> &sequence = _soundSequences.value(notification);
+    if (sequence.isEmpty()) {
+        return false;
+    }
+
+    // already playing, or all mixing slots busy
+    if (_activePosition.contains(notification)
+        || (_activePosition.size() >= MAX_CONCURRENT_SEQUENCES)) {
         return false;
     }
 
-    // qNotifyDebug() << "Phonon State: " << phonon.mo->state();
-
-    if ((phonon.mo->state() == QMediaPlayer::PausedState)
-        || (phonon.mo->state() == QMediaPlayer::StoppedState)
-        || phonon.firstPlay) {
-        _nowPlayingNotification = notification;
-        notification->stopExpireTimer();
-
-        if (notification->retryValue() == NotificationItem::repeatOnce) {
-            _toRemoveNotifications.append(_notificationList.takeAt(_notificationList.indexOf(notification)));
-        } else if (notification->retryValue() == NotificationItem::repeatOncePerUpdate) {
-            notification->setCurrentUpdatePlayed(true);
-        } else {
-            if (notification->retryValue() != NotificationItem::repeatInstantly) {
-                QRegExp rxlen("(\\d+)");
-                QString value;
-                int timer_value = 0;
-                int pos = rxlen.indexIn(NotificationItem::retryValues.at(notification->retryValue()));
-                if (pos > -1) {
-                    value = rxlen.cap(1); // "189"
-
-                    // needs to correct repeat timer value,
-                    // acording to message play duration,
-                    // we don't measure duration of each message,
-                    // simply take average duration
-                    enum { eAverageDurationSec = 8 };
-
-                    enum { eSecToMsec = 1000 };
-
-                    timer_value = (value.toInt() + eAverageDurationSec) * eSecToMsec;
-                }
-
-                notification->startTimer(timer_value);
-                connect(notification->getTimer(), SIGNAL(timeout()),
-                        this, SLOT(on_timerRepeated_Notification()), Qt::UniqueConnection);
+    notification->stopExpireTimer();
+
+    if (notification->retryValue() == NotificationItem::repeatOnce) {
+        _toRemoveNotifications.append(_notificationList.takeAt(_notificationList.indexOf(notification)));
+        removeFromRuleIndex(notification);
+    } else if (notification->retryValue() == NotificationItem::repeatOncePerUpdate) {
+        notification->setCurrentUpdatePlayed(true);
+    } else {
+        if (notification->retryValue() != NotificationItem::repeatInstantly) {
+            QRegExp rxlen("(\\d+)");
+            QString value;
+            int timer_value = 0;
+            int pos = rxlen.indexIn(NotificationItem::retryValues.at(notification->retryValue()));
+            if (pos > -1) {
+                value = rxlen.cap(1); // "189"
+
+                // needs to correct repeat timer value,
+                // acording to message play duration,
+                // we don't measure duration of each message,
+                // simply take average duration
+                enum { eAverageDurationSec = 8 };
+
+                enum { eSecToMsec = 1000 };
+
+                timer_value = (value.toInt() + eAverageDurationSec) * eSecToMsec;
             }
+
+            notification->startTimer(timer_value);
+            connect(notification->getTimer(), SIGNAL(timeout()),
+                    this, SLOT(on_timerRepeated_Notification()), Qt::UniqueConnection);
         }
-        phonon.mo->stop();
-        qNotifyDebug() << "play: " << notification->toString();
-        foreach(QString item, notification->toSoundList()) {
-            playlist->addMedia(QUrl::fromLocalFile(item));
-        }
-        qNotifyDebug() << "begin play";
-        phonon.mo->setPlaylist(playlist);
-        phonon.mo->play();
-        qNotifyDebug() << "end play";
-        phonon.firstPlay = false; // On Linux, you sometimes have to nudge Phonon to play 1 time before
-                                  // the state is not "Loading" anymore.
-        return true;
     }
-
-    return false;
+    qNotifyDebug() << "play: " << notification->toString();
+    _activePosition.insert(notification, 0);
+    _lastPlayedMs.insert(notification, QDateTime::currentMSecsSinceEpoch());
+    sequence.first()->play();
+    return true;
 }
@@ -34,18 +34,11 @@
 #include "notificationitem.h"
 
 #include <QSettings>
-#include <QMediaPlaylist>
-#include <QMediaPlayer>
+#include <QSoundEffect>
+#include <QHash>
 
 class NotifyPluginOptionsPage;
 
-typedef struct {
-    QMediaPlayer *mo;
-    NotificationItem *notify;
-    bool firstPlay;
-} PhononObject, *pPhononObject;
-
-
 class SoundNotifyPlugin : public Core::IConfigurablePlugin {
     Q_OBJECT
                                        Q_PLUGIN_METADATA(IID "Openpilot.SoundNotify")
@@ -95,22 +88,33 @@ private slots:
     void on_arrived_Notification(UAVObject *object);
     void on_timerRepeated_Notification(void);
     void on_expiredTimer_Notification(void);
-    void stateChanged(QMediaPlayer::State newstate);
+    void onEffectPlayingChanged(void);
 
 private:
     bool enableSound;
 
     QList<UAVDataObject *> lstNotifiedUAVObjects;
     QList<NotificationItem *> _notificationList;
+    // rules indexed by the objId they watch, rebuilt with the connections;
+    // the event path probes this instead of scanning the whole rule list
+    QMultiHash<quint32, NotificationItem *> _rulesByObjId;
     QList<NotificationItem *> _pendingNotifications;
     QList<NotificationItem *> _toRemoveNotifications;
 
     NotificationItem currentNotification;
-    NotificationItem *_nowPlayingNotification;
 
-    PhononObject phonon;
+    // pre-decoded playback sequence of each notification rule,
+    // built when the rules are (re)connected
+    QHash<NotificationItem *, QList<QSoundEffect *> > _soundSequences;
+    // rules currently playing and the position they reached in their sequence
+    QHash<NotificationItem *, int> _activePosition;
+    // time each rule last started playing, used for per rule throttling
+    QHash<NotificationItem *, qint64> _lastPlayedMs;
+
+    void disposeSoundSequences();
+    void removeFromRuleIndex(NotificationItem *notification);
+
     NotifyPluginOptionsPage *mop;
-    QMediaPlaylist *playlist;
 };
 
 #endif // SOUNDNOTIFYPLUGIN_H
@@ -48,6 +48,8 @@ public:
 
     int open(int max, int vid, int pid, int usage_page, int usage);
 
+    int openBySerial(int vid, int pid, const QString &serialNumber);
+
     int receive(int, void *buf, int len, int timeout);
 
     void close(int num);
@@ -181,6 +181,8 @@ private:
     void addDevice(USBPortInfo info);
     void removeDevice(IOHIDDeviceRef dev);
     IOHIDManagerRef hid_manager;
+    // run loop of the monitor thread, stopped from the destructor
+    CFRunLoopRef m_runLoop;
 #elif defined(Q_OS_UNIX)
     struct udev *context;
     struct udev_monitor *monitor;
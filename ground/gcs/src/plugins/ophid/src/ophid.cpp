@@ -166,6 +166,8 @@ void RawHIDReadThread::run()
         // configure this
         char buffer[READ_SIZE] = { 0 };
 
+        // block in the driver until a report arrives, the timeout lets the
+        // thread check for shutdown without busy polling
         int ret = hiddev->receive(hidno, buffer, READ_SIZE, READ_TIMEOUT);
 
         if (ret > 0) { // read some data
@@ -174,10 +176,16 @@ void RawHIDReadThread::run()
             // First byte is report ID, second byte is the number of valid bytes
             m_readBuffer.append(&buffer[2], buffer[1]);
 
+            // drain the reports already queued in the driver so a telemetry
+            // burst is buffered in one pass and wakes the readers only once
+            while ((ret = hiddev->receive(hidno, buffer, READ_SIZE, 0)) > 0) {
+                m_readBuffer.append(&buffer[2], buffer[1]);
+            }
+
             emit m_hid->readyRead();
-        } else if (ret == 0) { // nothing read
-        } else { // < 0 => error
-                 // TODO! make proper error handling, this only quick hack for unplug freeze
+        }
+        if (ret < 0) { // < 0 => error
+            // TODO! make proper error handling, this only quick hack for unplug freeze
             m_running = false;
         }
     }
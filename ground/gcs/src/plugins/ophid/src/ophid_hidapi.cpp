@@ -216,23 +216,58 @@ int opHID_hidapi::open(int max, int vid, int pid, int usage_page, int usage)
 }
 
 
+/**
+ * \brief Open one specific HID device, identified by its serial number
+ *
+ * \note Unlike open() this never falls back to "whatever opens first", so
+ *      several opHID_hidapi instances can each hold a different board of
+ *      the same vid/pid at the same time.
+ *
+ * \param[in] vid USB vendor id of the device to open.
+ * \param[in] pid USB product id of the device to open.
+ * \param[in] serialNumber Serial number string of the device to open.
+ * \return Number of opened device.
+ * \retval 0 or 1.
+ */
+int opHID_hidapi::openBySerial(int vid, int pid, const QString &serialNumber)
+{
+    OPHID_TRACE("IN");
+
+    OPHID_DEBUG("vid: 0x%X, pid: 0x%X, serial: %s.", vid, pid, serialNumber.toLatin1().constData());
+
+    if (handle) {
+        OPHID_WARNING("HID device seems already open.");
+    }
+
+    std::wstring serial = serialNumber.toStdWString();
+    handle = hid_open(vid, pid, serial.empty() ? NULL : serial.c_str());
+
+    if (!handle) {
+        OPHID_ERROR("Unable to open device.");
+    }
+
+    OPHID_TRACE("OUT");
+
+    return handle ? 1 : 0;
+}
+
+
 /**
  * \brief Read an Input report from a HID device.
  *
- * \note This function does \b not block for now.
- *      Tests show that it does not need to.
+ * \note This function blocks in the driver until a report arrives
+ *      or the timeout expires, so callers do not need to poll.
  *
  * \param[in] num Id of the device to receive packet (NOT supported).
  * \param[in] buf Pointer to the bufer to write the received packet to.
  * \param[in] len Size of the buffer.
- * \param[in] timeout Not supported.
+ * \param[in] timeout Time to wait for a report in ms, 0 to return immediately.
  * \return Number of bytes received, or -1 on error.
  * \retval -1 for error or bytes received.
  */
 int opHID_hidapi::receive(int num, void *buf, int len, int timeout)
 {
     Q_UNUSED(num);
-    Q_UNUSED(timeout);
 
     int bytes_read = 0;
 
@@ -252,7 +287,7 @@ int opHID_hidapi::receive(int num, void *buf, int len, int timeout)
     }
 
     hid_read_Mtx.lock();
-    bytes_read = hid_read(handle, (unsigned char *)buf, len);
+    bytes_read = hid_read_timeout(handle, (unsigned char *)buf, len, timeout);
     hid_read_Mtx.unlock();
 
     // hidapi lib does not expose the libusb errors.
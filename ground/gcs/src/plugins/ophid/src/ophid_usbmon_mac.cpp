@@ -47,6 +47,7 @@ USBMonitor::USBMonitor(QObject *parent) : QThread(parent), m_terminate(1)
 {
     m_instance  = this;
     hid_manager = NULL;
+    m_runLoop   = NULL;
     listMutex   = new QMutex();
     knowndevices.clear();
     qRegisterMetaType<USBPortInfo>("USBPortInfo");
@@ -61,6 +62,10 @@ USBMonitor::USBMonitor(QObject *parent) : QThread(parent), m_terminate(1)
 USBMonitor::~USBMonitor()
 {
     m_terminate.tryAcquire();
+    // wake the monitor thread out of its event wait so it can exit
+    if (m_runLoop) {
+        CFRunLoopStop(m_runLoop);
+    }
     wait();
 }
 
@@ -246,9 +251,16 @@ void USBMonitor::run()
         return;
     }
 
+    // Event driven from here on : the run loop sleeps until IOKit delivers
+    // an attach/detach callback or the destructor stops it. No periodic
+    // wakeups while idle, and attach events are serviced the moment they
+    // arrive instead of up to a tick later.
+    m_runLoop = loop;
     while (m_terminate.available()) {
-        CFRunLoopRunInMode(kCFRunLoopDefaultMode, 1, false);
+        CFRunLoopRun();
     }
+    m_runLoop = NULL;
+
     IOHIDManagerUnscheduleFromRunLoop(hid_manager, loop, kCFRunLoopDefaultMode);
     CFRelease(hid_manager);
 
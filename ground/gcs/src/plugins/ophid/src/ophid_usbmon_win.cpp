@@ -164,8 +164,10 @@ void USBMonitor::setUpNotifications()
     if (::RegisterDeviceNotification((HWND)notificationWidget->winId(), &dbh, DEVICE_NOTIFY_WINDOW_HANDLE) == NULL) {
         qWarning() << "RegisterDeviceNotification failed:" << GetLastError();
     }
-    // discover the devices curently connected
-    foreach(USBPortInfo port, availableDevices())
+    // seed the list with the devices connected before GCS started; from
+    // here on the WM_DEVICECHANGE notifications keep it current
+    enumerateDevicesWin(guid_hid);
+    foreach(USBPortInfo port, knowndevices)
     emit deviceDiscovered(port);
 #else
     qWarning("GUI not enabled - can't register for device notifications.");
@@ -271,17 +273,23 @@ bool USBMonitor::matchAndDispatchChangedDevice(const QString & deviceID, const G
                         OPHID_ERROR("Not found");
                         break;
                     }
-                    if (knowndevices.length()) {
-                        foreach(USBPortInfo m_info, knowndevices) {
-                            if (m_info.serialNumber == info.serialNumber &&
-                                m_info.productID == info.productID &&
-                                m_info.bcdDevice == info.bcdDevice &&
-                                m_info.devicePath == info.devicePath) {
-                                OPHID_ERROR("Already present");
-                                break;
-                            }
+                    // a physical plug raises several WM_DEVICECHANGE events
+                    // (one per interface alias), debounce them so a board is
+                    // discovered - and signalled - exactly once
+                    bool alreadyKnown = false;
+                    foreach(USBPortInfo m_info, knowndevices) {
+                        if (m_info.serialNumber == info.serialNumber &&
+                            m_info.productID == info.productID &&
+                            m_info.bcdDevice == info.bcdDevice &&
+                            m_info.devicePath == info.devicePath) {
+                            alreadyKnown = true;
+                            break;
                         }
                     }
+                    if (alreadyKnown) {
+                        OPHID_DEBUG("Already present, event debounced");
+                        break;
+                    }
                     if (info.bcdDevice == 0 || info.product.isEmpty()) {
                         OPHID_ERROR("Missing parameters");
                         break;
@@ -291,12 +299,15 @@ bool USBMonitor::matchAndDispatchChangedDevice(const QString & deviceID, const G
                     emit deviceDiscovered(info);
                     break;
                 } else if (wParam == DBT_DEVICEREMOVECOMPLETE) {
+                    // drop only the departed device, not the whole list
                     for (int x = 0; x < knowndevices.count(); ++x) {
-                        USBPortInfo temp = knowndevices.at(x);
-                        knowndevices.removeAt(x);
-                        OPHID_DEBUG("[SIGNAL] Device removed on device: %s %d", qPrintable(temp.product), temp.bcdDevice);
+                        if (knowndevices.at(x).devicePath == deviceID) {
+                            USBPortInfo temp = knowndevices.takeAt(x);
+                            OPHID_DEBUG("[SIGNAL] Device removed on device: %s %d", qPrintable(temp.product), temp.bcdDevice);
+                            emit deviceRemoved(temp);
+                            break;
+                        }
                     }
-                    emit deviceRemoved(info);
                     break;
                 }
                 break;
@@ -317,7 +328,9 @@ bool USBMonitor::matchAndDispatchChangedDevice(const QString & deviceID, const G
  */
 QList<USBPortInfo> USBMonitor::availableDevices()
 {
-    enumerateDevicesWin(guid_hid);
+    // knowndevices is kept current by the WM_DEVICECHANGE notifications set
+    // up in setUpNotifications(); enumerating the bus again here would run
+    // a full SetupDi pass - including opening every HID handle - per call
     return knowndevices;
 }
 
@@ -339,6 +352,9 @@ void USBMonitor::enumerateDevicesWin(const GUID & guid)
 
     OPHID_TRACE("IN");
 
+    // full rebuild, never append to the previous snapshot
+    knowndevices.clear();
+
     devInfo = SetupDiGetClassDevs(&guid, NULL, NULL, DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
 
     if (devInfo != INVALID_HANDLE_VALUE) {
@@ -429,6 +429,23 @@ bool flightDataModel::removeRows(int row, int count, const QModelIndex & /*paren
     return true;
 }
 
+/**
+ * Replace the whole plan in one model reset.
+ *
+ * Takes ownership of the rows. Views get a single reset notification
+ * instead of one insert signal per waypoint, which is what made opening
+ * large plans freeze the planner.
+ */
+void flightDataModel::replaceRows(const QList<pathPlanData *> &rows)
+{
+    beginResetModel();
+    foreach(pathPlanData * row, dataStorage) {
+        delete row;
+    }
+    dataStorage = rows;
+    endResetModel();
+}
+
 bool flightDataModel::writeToFile(QString fileName)
 {
     QFile file(fileName);
@@ -442,10 +459,11 @@ bool flightDataModel::writeToFile(QString fileName)
     QDomElement root = doc.createElement("waypoints");
     doc.appendChild(root);
 
+    int number = 0;
     foreach(pathPlanData * obj, dataStorage) {
         QDomElement waypoint = doc.createElement("waypoint");
 
-        waypoint.setAttribute("number", dataStorage.indexOf(obj));
+        waypoint.setAttribute("number", number++);
         root.appendChild(waypoint);
         QDomElement field = doc.createElement("field");
         field.setAttribute("value", obj->wpDescritption);
@@ -570,7 +588,6 @@ bool flightDataModel::writeToFile(QString fileName)
 void flightDataModel::readFromFile(QString fileName)
 {
     // TODO warning message
-    removeRows(0, rowCount());
     QFile file(fileName);
     file.open(QIODevice::ReadOnly);
     QDomDocument doc("PathPlan");
@@ -597,6 +614,9 @@ void flightDataModel::readFromFile(QString fileName)
         return;
     }
 
+    // collect all rows first, the model is then swapped in one reset
+    QList<pathPlanData *> rows;
+    rows.reserve(root.childNodes().count());
     pathPlanData *data = NULL;
     QDomNode node = root.firstChild();
     while (!node.isNull()) {
@@ -661,12 +681,11 @@ void flightDataModel::readFromFile(QString fileName)
                 }
                 fieldNode = fieldNode.nextSibling();
             }
-            beginInsertRows(QModelIndex(), dataStorage.length(), dataStorage.length());
-            dataStorage.append(data);
-            endInsertRows();
+            rows.append(data);
         }
         node = node.nextSibling();
     }
+    replaceRows(rows);
 }
 
 qreal flightDataModel::defaultWaypointAltitude() const
@@ -68,6 +68,7 @@ public:
     Qt::ItemFlags flags(const QModelIndex & index) const;
     bool insertRows(int row, int count, const QModelIndex & parent = QModelIndex());
     bool removeRows(int row, int count, const QModelIndex & parent = QModelIndex());
+    void replaceRows(const QList<pathPlanData *> &rows);
     bool writeToFile(QString filename);
     void readFromFile(QString fileName);
     qreal defaultWaypointAltitude() const;
@@ -31,6 +31,7 @@ modelMapProxy::modelMapProxy(QObject *parent, OPMapWidget *map, flightDataModel
 {
     connect(model, SIGNAL(rowsInserted(const QModelIndex &, int, int)), this, SLOT(rowsInserted(const QModelIndex &, int, int)));
     connect(model, SIGNAL(rowsRemoved(const QModelIndex &, int, int)), this, SLOT(rowsRemoved(const QModelIndex &, int, int)));
+    connect(model, SIGNAL(modelReset()), this, SLOT(modelReset()));
     connect(selection, SIGNAL(currentRowChanged(QModelIndex, QModelIndex)), this, SLOT(currentRowChanged(QModelIndex, QModelIndex)));
     connect(model, SIGNAL(dataChanged(QModelIndex, QModelIndex)), this, SLOT(dataChanged(QModelIndex, QModelIndex)));
     connect(myMap, SIGNAL(selectedWPChanged(QList<WayPointItem *>)), this, SLOT(selectedWPChanged(QList<WayPointItem *>)));
@@ -294,36 +295,115 @@ void modelMapProxy::rowsInserted(const QModelIndex &parent, int first, int last)
     Q_UNUSED(parent);
 
     for (int x = first; x < last + 1; x++) {
-        QModelIndex index;
-        internals::PointLatLng latlng;
-        distBearingAltitude distBearing;
-        double altitude;
-        bool relative;
-        index    = model->index(x, flightDataModel::WPDESCRITPTION);
-        QString desc = index.data(Qt::DisplayRole).toString();
-        index    = model->index(x, flightDataModel::LATPOSITION);
-        latlng.SetLat(index.data(Qt::DisplayRole).toDouble());
-        index    = model->index(x, flightDataModel::LNGPOSITION);
-        latlng.SetLng(index.data(Qt::DisplayRole).toDouble());
-        index    = model->index(x, flightDataModel::DISRELATIVE);
+        insertRowItem(x);
+    }
+
+    refreshOverlays();
+}
+
+/**
+ * Creates the map item for model row x.
+ */
+void modelMapProxy::insertRowItem(int x)
+{
+    QModelIndex index;
+    internals::PointLatLng latlng;
+    distBearingAltitude distBearing;
+    double altitude;
+    bool relative;
+
+    index    = model->index(x, flightDataModel::WPDESCRITPTION);
+    QString desc = index.data(Qt::DisplayRole).toString();
+    index    = model->index(x, flightDataModel::LATPOSITION);
+    latlng.SetLat(index.data(Qt::DisplayRole).toDouble());
+    index    = model->index(x, flightDataModel::LNGPOSITION);
+    latlng.SetLng(index.data(Qt::DisplayRole).toDouble());
+    index    = model->index(x, flightDataModel::DISRELATIVE);
+    distBearing.distance = index.data(Qt::DisplayRole).toDouble();
+    index    = model->index(x, flightDataModel::BEARELATIVE);
+    distBearing.setBearingFromDegrees(index.data(Qt::DisplayRole).toDouble());
+    index    = model->index(x, flightDataModel::ALTITUDERELATIVE);
+    distBearing.altitudeRelative = index.data(Qt::DisplayRole).toFloat();
+    index    = model->index(x, flightDataModel::ISRELATIVE);
+    relative = index.data(Qt::DisplayRole).toBool();
+    index    = model->index(x, flightDataModel::ALTITUDE);
+    altitude = index.data(Qt::DisplayRole).toDouble();
+    if (relative) {
+        myMap->WPInsert(distBearing, desc, x);
+    } else {
+        myMap->WPInsert(latlng, altitude, desc, x);
+    }
+}
+
+/**
+ * Pushes all values of model row x into an existing map item. The item
+ * setters skip values that did not change, so syncing an untouched row does
+ * not redraw anything.
+ */
+void modelMapProxy::syncRowItem(int x, WayPointItem *item)
+{
+    QModelIndex index;
+    internals::PointLatLng latlng;
+    distBearingAltitude distBearing;
+
+    index = model->index(x, flightDataModel::WPDESCRITPTION);
+    item->SetDescription(index.data(Qt::DisplayRole).toString());
+
+    index = model->index(x, flightDataModel::ISRELATIVE);
+    if (index.data(Qt::DisplayRole).toBool()) {
+        if (item->WPType() != mapcontrol::WayPointItem::relative) {
+            item->setWPType(mapcontrol::WayPointItem::relative);
+        }
+        index = model->index(x, flightDataModel::DISRELATIVE);
         distBearing.distance = index.data(Qt::DisplayRole).toDouble();
-        index    = model->index(x, flightDataModel::BEARELATIVE);
+        index = model->index(x, flightDataModel::BEARELATIVE);
         distBearing.setBearingFromDegrees(index.data(Qt::DisplayRole).toDouble());
-        index    = model->index(x, flightDataModel::ALTITUDERELATIVE);
+        index = model->index(x, flightDataModel::ALTITUDERELATIVE);
         distBearing.altitudeRelative = index.data(Qt::DisplayRole).toFloat();
-        index    = model->index(x, flightDataModel::ISRELATIVE);
-        relative = index.data(Qt::DisplayRole).toBool();
-        index    = model->index(x, flightDataModel::ALTITUDE);
-        altitude = index.data(Qt::DisplayRole).toDouble();
-        if (relative) {
-            myMap->WPInsert(distBearing, desc, x);
+        item->setRelativeCoord(distBearing);
+    } else {
+        if (item->WPType() != mapcontrol::WayPointItem::absolute) {
+            item->setWPType(mapcontrol::WayPointItem::absolute);
+        }
+        index = model->index(x, flightDataModel::LATPOSITION);
+        latlng.SetLat(index.data(Qt::DisplayRole).toDouble());
+        index = model->index(x, flightDataModel::LNGPOSITION);
+        latlng.SetLng(index.data(Qt::DisplayRole).toDouble());
+        item->SetCoord(latlng);
+        index = model->index(x, flightDataModel::ALTITUDE);
+        item->SetAltitude(index.data(Qt::DisplayRole).toDouble());
+    }
+
+    index = model->index(x, flightDataModel::LOCKED);
+    item->setFlag(QGraphicsItem::ItemIsMovable, !index.data(Qt::DisplayRole).toBool());
+}
+
+void modelMapProxy::modelReset()
+{
+    // the whole model was swapped in one go (e.g. a plan loaded from file).
+    // Diff against the items already on the map instead of rebuilding them:
+    // rows that survived the swap are updated in place, only surplus items
+    // are destroyed and only genuinely new rows create items.
+    int rows = model->rowCount();
+
+    while (findWayPointNumber(rows)) {
+        // items above the deleted number shift down, so the next surplus
+        // item takes number 'rows' again
+        myMap->WPDelete(rows);
+    }
+
+    for (int x = 0; x < rows; ++x) {
+        WayPointItem *item = findWayPointNumber(x);
+        if (item) {
+            syncRowItem(x, item);
         } else {
-            myMap->WPInsert(latlng, altitude, desc, x);
+            insertRowItem(x);
         }
     }
 
     refreshOverlays();
 }
+
 void modelMapProxy::deleteWayPoint(int number)
 {
     model->removeRow(number, QModelIndex());
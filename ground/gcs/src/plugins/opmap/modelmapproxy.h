@@ -51,6 +51,7 @@ private slots:
     void dataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight);
     void rowsInserted(const QModelIndex & parent, int first, int last);
     void rowsRemoved(const QModelIndex & parent, int first, int last);
+    void modelReset();
     void WPValuesChanged(WayPointItem *wp);
     void currentRowChanged(QModelIndex, QModelIndex);
     void selectedWPChanged(QList<WayPointItem *>);
@@ -58,6 +59,8 @@ private:
     overlayType overlayTranslate(int type);
     void createOverlay(WayPointItem *from, WayPointItem *to, overlayType type, QColor color, bool dashed = false, int width = -1);
     void createOverlay(WayPointItem *from, HomeItem *to, modelMapProxy::overlayType type, QColor color, bool dashed = false, int width = -1);
+    void insertRowItem(int x);
+    void syncRowItem(int x, WayPointItem *item);
     OPMapWidget *myMap;
     flightDataModel *model;
     void refreshOverlays();
@@ -29,10 +29,13 @@
 #include "uavobjecthelper.h"
 #include "uavobjectmanager.h"
 
+#include <QEventLoop>
 #include <QProgressDialog>
+#include <QTimer>
 #include <math.h>
 
-ModelUavoProxy::ModelUavoProxy(QObject *parent, flightDataModel *model) : QObject(parent), myModel(model)
+ModelUavoProxy::ModelUavoProxy(QObject *parent, flightDataModel *model) : QObject(parent), myModel(model),
+    uploadProgress(NULL), uploadLoop(NULL), uploadStallTimer(NULL), uploadFailed(false)
 {
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
 
@@ -63,29 +66,16 @@ void ModelUavoProxy::sendPathPlan()
     progress.setValue(1);
 
     if (success) {
-        // send Waypoint instances
-        qDebug() << "sending" << waypointCount << "waypoints";
+        // send Waypoint and PathAction instances with several transactions in flight
+        QList<UAVObject *> objects;
         for (int i = 0; i < waypointCount; ++i) {
-            Waypoint *waypoint = Waypoint::GetInstance(objMngr, i);
-            success = (updateHelper.doObjectAndWait(waypoint) == UAVObjectUpdaterHelper::SUCCESS);
-            if (!success) {
-                break;
-            }
-            progress.setValue(progress.value() + 1);
+            objects.append(Waypoint::GetInstance(objMngr, i));
         }
-    }
-
-    if (success) {
-        // send PathAction instances
-        qDebug() << "sending" << actionCount << "path actions";
         for (int i = 0; i < actionCount; ++i) {
-            PathAction *action = PathAction::GetInstance(objMngr, i);
-            success = (updateHelper.doObjectAndWait(action) == UAVObjectUpdaterHelper::SUCCESS);
-            if (!success) {
-                break;
-            }
-            progress.setValue(progress.value() + 1);
+            objects.append(PathAction::GetInstance(objMngr, i));
         }
+        qDebug() << "sending" << waypointCount << "waypoints and" << actionCount << "path actions";
+        success = sendObjectsWindowed(objects, progress);
     }
 
     qDebug() << "ModelUavoProxy::pathPlanSent - completed" << success;
@@ -96,6 +86,93 @@ void ModelUavoProxy::sendPathPlan()
     progress.close();
 }
 
+// Send a batch of objects while keeping several acked transactions in flight.
+//
+// doObjectAndWait() costs a full link round trip per object, which makes large
+// plans take minutes over a low rate link such as OPLink. Telemetry handles
+// concurrent transactions on distinct object instances, so up to
+// UPLOAD_WINDOW_SIZE objects are kept outstanding and every ack pulls the next
+// object into the window. An object whose transaction fails is retransmitted
+// on its own without holding up the rest of the window.
+bool ModelUavoProxy::sendObjectsWindowed(const QList<UAVObject *> &objects, QProgressDialog &progress)
+{
+    if (objects.isEmpty()) {
+        return true;
+    }
+
+    QEventLoop loop;
+    QTimer stallTimer;
+    stallTimer.setSingleShot(true);
+    connect(&stallTimer, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+    uploadPending    = objects;
+    uploadInFlight.clear();
+    uploadRetriesLeft.clear();
+    uploadFailed     = false;
+    uploadProgress   = &progress;
+    uploadLoop       = &loop;
+    uploadStallTimer = &stallTimer;
+
+    fillUploadWindow();
+
+    // the stall timer guards against transactions that never complete
+    // (e.g. an object that could not be sent at all)
+    stallTimer.start(UPLOAD_STALL_TIMEOUT_MS);
+    if (!uploadInFlight.isEmpty()) {
+        loop.exec();
+    }
+    bool stalled = !uploadInFlight.isEmpty() || !uploadPending.isEmpty();
+
+    foreach(UAVObject * obj, uploadInFlight) {
+        disconnect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(uploadTransactionCompleted(UAVObject *, bool)));
+    }
+    uploadPending.clear();
+    uploadInFlight.clear();
+    uploadRetriesLeft.clear();
+    uploadProgress   = NULL;
+    uploadLoop       = NULL;
+    uploadStallTimer = NULL;
+
+    return !uploadFailed && !stalled;
+}
+
+void ModelUavoProxy::fillUploadWindow()
+{
+    while ((uploadInFlight.count() < UPLOAD_WINDOW_SIZE) && !uploadPending.isEmpty()) {
+        UAVObject *obj = uploadPending.takeFirst();
+        uploadInFlight.insert(obj);
+        uploadRetriesLeft[obj] = UPLOAD_RETRIES;
+        connect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(uploadTransactionCompleted(UAVObject *, bool)), Qt::UniqueConnection);
+        obj->updated();
+    }
+}
+
+void ModelUavoProxy::uploadTransactionCompleted(UAVObject *obj, bool success)
+{
+    if (!uploadInFlight.contains(obj)) {
+        // not one of ours (or already handled), e.g. an update requested elsewhere
+        return;
+    }
+    uploadStallTimer->start(UPLOAD_STALL_TIMEOUT_MS);
+    if (success) {
+        uploadInFlight.remove(obj);
+        uploadRetriesLeft.remove(obj);
+        disconnect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(uploadTransactionCompleted(UAVObject *, bool)));
+        uploadProgress->setValue(uploadProgress->value() + 1);
+        fillUploadWindow();
+        if (uploadInFlight.isEmpty() && uploadPending.isEmpty()) {
+            uploadLoop->quit();
+        }
+    } else if (uploadRetriesLeft.value(obj) > 0) {
+        // selective retransmit, only the failed object goes out again
+        --uploadRetriesLeft[obj];
+        obj->updated();
+    } else {
+        uploadFailed = true;
+        uploadLoop->quit();
+    }
+}
+
 void ModelUavoProxy::receivePathPlan()
 {
     QProgressDialog progress(tr("Receiving the path plan from the board... "), "", 0, 0);
@@ -116,10 +193,9 @@ void ModelUavoProxy::receivePathPlan()
     progress.setValue(1);
 
     if (success && (waypointCount > objMngr->getNumInstances(Waypoint::OBJID))) {
-        // allocate needed Waypoint instances
-        Waypoint *waypoint = new Waypoint;
-        waypoint->initialize(waypointCount - 1, waypoint->getMetaObject());
-        success = objMngr->registerObject(waypoint);
+        // allocate needed Waypoint instances in one bulk call
+        objMngr->createObjectInstances(Waypoint::OBJID, waypointCount);
+        success = (objMngr->getNumInstances(Waypoint::OBJID) >= waypointCount);
     }
     if (success) {
         // request Waypoint instances
@@ -135,10 +211,9 @@ void ModelUavoProxy::receivePathPlan()
     }
 
     if (success && (actionCount > objMngr->getNumInstances(PathAction::OBJID))) {
-        // allocate needed PathAction instances
-        PathAction *action = new PathAction;
-        action->initialize(actionCount - 1, action->getMetaObject());
-        success = objMngr->registerObject(action);
+        // allocate needed PathAction instances in one bulk call
+        objMngr->createObjectInstances(PathAction::OBJID, actionCount);
+        success = (objMngr->getNumInstances(PathAction::OBJID) >= actionCount);
     }
     if (success) {
         // request PathAction isntances
@@ -34,6 +34,13 @@
 #include "waypoint.h"
 
 #include <QObject>
+#include <QList>
+#include <QMap>
+#include <QSet>
+
+class QEventLoop;
+class QProgressDialog;
+class QTimer;
 
 class ModelUavoProxy : public QObject {
     Q_OBJECT
@@ -45,10 +52,31 @@ public slots:
     void sendPathPlan();
     void receivePathPlan();
 
+private slots:
+    void uploadTransactionCompleted(UAVObject *obj, bool success);
+
 private:
+    // number of acked transactions kept in flight, must stay below the
+    // Telemetry event queue size
+    static const int UPLOAD_WINDOW_SIZE      = 8;
+    static const int UPLOAD_RETRIES          = 3;
+    static const int UPLOAD_STALL_TIMEOUT_MS = 2000;
+
     UAVObjectManager *objMngr;
     flightDataModel *myModel;
 
+    // windowed upload state, only valid while sendObjectsWindowed() runs
+    QList<UAVObject *> uploadPending;
+    QSet<UAVObject *> uploadInFlight;
+    QMap<UAVObject *, int> uploadRetriesLeft;
+    QProgressDialog *uploadProgress;
+    QEventLoop *uploadLoop;
+    QTimer *uploadStallTimer;
+    bool uploadFailed;
+
+    bool sendObjectsWindowed(const QList<UAVObject *> &objects, QProgressDialog &progress);
+    void fillUploadWindow();
+
     bool modelToObjects();
     bool objectsToModel();
 
@@ -110,6 +110,10 @@ OPMapGadgetWidget::OPMapGadgetWidget(QWidget *parent) : QWidget(parent)
 
     m_telemetry_connected  = false;
 
+    m_poseFrom.valid = false;
+    m_poseTo.valid   = false;
+    m_poseApplied    = true;
+
     m_context_menu_lat_lon = m_mouse_lat_lon = internals::PointLatLng(0, 0);
 
     setMouseTracking(true);
@@ -271,6 +275,14 @@ OPMapGadgetWidget::OPMapGadgetWidget(QWidget *parent) : QWidget(parent)
     connect(m_updateTimer, SIGNAL(timeout()), this, SLOT(updatePosition()));
     m_updateTimer->start();
 
+    // the render timer animates the UAV between the sampled poses at display
+    // refresh, independently of the telemetry sampling rate above
+    m_poseClock.start();
+    m_renderTimer = new QTimer();
+    m_renderTimer->setInterval(33); // ~30 fps
+    connect(m_renderTimer, SIGNAL(timeout()), this, SLOT(renderPose()));
+    m_renderTimer->start();
+
     m_statusUpdateTimer = new QTimer();
     m_statusUpdateTimer->setInterval(200);
     connect(m_statusUpdateTimer, SIGNAL(timeout()), this, SLOT(updateMousePos()));
@@ -642,6 +654,104 @@ void OPMapGadgetWidget::updatePosition()
     // Set the angular rate in the painter module
     m_map->UAV->SetYawRate(psiRate_dps); // Not correct, but I'm being lazy right now.
 
+    // *************
+    // sample the new pose, renderPose() animates the map items towards it
+
+    m_poseFrom = m_poseTo;
+
+    m_poseTo.pos         = uav_pos;
+    m_poseTo.altitude    = uav_altitude;
+    m_poseTo.yaw         = uav_yaw;
+    m_poseTo.gpsPos      = gps_pos;
+    m_poseTo.gpsAltitude = gps_altitude;
+    m_poseTo.gpsHeading  = gps_heading;
+    m_poseTo.time        = m_poseClock.elapsed();
+    m_poseTo.valid       = true;
+
+    m_poseApplied        = false;
+    // *************
+}
+
+/**
+   Interpolates between two headings along the shortest arc, so the UAV icon
+   never spins the long way round through north.
+ */
+static double interpolateAngle(double from, double to, double t)
+{
+    double delta = fmod(to - from, 360.0);
+
+    if (delta > 180.0) {
+        delta -= 360.0;
+    } else if (delta < -180.0) {
+        delta += 360.0;
+    }
+    return from + delta * t;
+}
+
+/**
+   Moves the UAV and GPS icons on the map by interpolating between the last
+   two sampled poses. It runs at display refresh rate (~30fps), one sample
+   period behind updatePosition(), so map motion stays smooth whatever the
+   telemetry update rate is.
+ */
+void OPMapGadgetWidget::renderPose()
+{
+    if (!m_widget || !m_map) {
+        return;
+    }
+
+    QMutexLocker locker(&m_map_mutex);
+
+    if (!m_poseTo.valid) {
+        return;
+    }
+
+    double t = 1.0;
+
+    if (m_poseFrom.valid && m_poseTo.time > m_poseFrom.time) {
+        // render one sample period behind the latest pose so there is always
+        // a segment to interpolate over
+        qint64 period = m_poseTo.time - m_poseFrom.time;
+        t = (double)(m_poseClock.elapsed() - period - m_poseFrom.time) / period;
+        if (t < 0.0) {
+            t = 0.0;
+        } else if (t > 1.0) {
+            t = 1.0;
+        }
+    }
+
+    if (t >= 1.0 && m_poseApplied) {
+        // the latest pose is already on screen and no new sample has
+        // arrived, nothing to redraw
+        return;
+    }
+
+    internals::PointLatLng uav_pos;
+    internals::PointLatLng gps_pos;
+    double uav_altitude, uav_yaw;
+    double gps_altitude, gps_heading;
+
+    if (m_poseFrom.valid && t < 1.0) {
+        uav_pos = internals::PointLatLng(
+            m_poseFrom.pos.Lat() + (m_poseTo.pos.Lat() - m_poseFrom.pos.Lat()) * t,
+            m_poseFrom.pos.Lng() + (m_poseTo.pos.Lng() - m_poseFrom.pos.Lng()) * t);
+        gps_pos = internals::PointLatLng(
+            m_poseFrom.gpsPos.Lat() + (m_poseTo.gpsPos.Lat() - m_poseFrom.gpsPos.Lat()) * t,
+            m_poseFrom.gpsPos.Lng() + (m_poseTo.gpsPos.Lng() - m_poseFrom.gpsPos.Lng()) * t);
+        uav_altitude = m_poseFrom.altitude + (m_poseTo.altitude - m_poseFrom.altitude) * t;
+        gps_altitude = m_poseFrom.gpsAltitude + (m_poseTo.gpsAltitude - m_poseFrom.gpsAltitude) * t;
+        uav_yaw     = interpolateAngle(m_poseFrom.yaw, m_poseTo.yaw, t);
+        gps_heading = interpolateAngle(m_poseFrom.gpsHeading, m_poseTo.gpsHeading, t);
+    } else {
+        uav_pos      = m_poseTo.pos;
+        gps_pos      = m_poseTo.gpsPos;
+        uav_altitude = m_poseTo.altitude;
+        gps_altitude = m_poseTo.gpsAltitude;
+        uav_yaw      = m_poseTo.yaw;
+        gps_heading  = m_poseTo.gpsHeading;
+        m_poseApplied = true;
+    }
+
     // *************
     // display the UAV position
 
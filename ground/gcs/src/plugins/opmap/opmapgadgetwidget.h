@@ -44,6 +44,7 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QPointF>
+#include <QElapsedTimer>
 
 #include "opmapcontrol/opmapcontrol.h"
 
@@ -133,6 +134,7 @@ protected:
 private slots:
     void wpDoubleClickEvent(WayPointItem *wp);
     void updatePosition();
+    void renderPose();
 
     void updateMousePos();
 
@@ -229,7 +231,26 @@ private:
     QStringList findPlaceWordList;
     QCompleter *findPlaceCompleter;
     QTimer *m_updateTimer;
+    QTimer *m_renderTimer;
     QTimer *m_statusUpdateTimer;
+
+    // One telemetry pose sample. updatePosition() fills the buffer at
+    // telemetry sampling rate, renderPose() interpolates between the two
+    // most recent samples at display rate.
+    struct UavPose {
+        internals::PointLatLng pos;
+        double altitude;
+        double yaw;
+        internals::PointLatLng gpsPos;
+        double gpsAltitude;
+        double gpsHeading;
+        qint64 time;
+        bool   valid;
+    };
+    UavPose m_poseFrom;
+    UavPose m_poseTo;
+    QElapsedTimer m_poseClock;
+    bool m_poseApplied;
     Ui::OPMap_Widget *m_widget;
     mapcontrol::OPMapWidget *m_map;
     ExtensionSystem::PluginManager *pm;
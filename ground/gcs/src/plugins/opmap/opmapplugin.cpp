@@ -26,6 +26,8 @@
  */
 #include "opmapplugin.h"
 #include "opmapgadgetfactory.h"
+#include "opmapcontrol/opmapcontrol.h"
+#include <coreplugin/memorydiagnostics.h>
 #include <QtPlugin>
 #include <QStringList>
 #include <extensionsystem/pluginmanager.h>
@@ -48,6 +50,15 @@ bool OPMapPlugin::initialize(const QStringList & args, QString *errMsg)
     mf = new OPMapGadgetFactory(this);
     addAutoReleasedObject(mf);
 
+    // attribute the in-memory tile cache in the memory report
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    Core::MemoryDiagnostics *memoryDiagnostics = pm->getObject<Core::MemoryDiagnostics>();
+    if (memoryDiagnostics != NULL) {
+        memoryDiagnostics->registerSource("Map tile cache", []() {
+            return core::OPMaps::Instance()->MemoryCacheBytes();
+        });
+    }
+
     return true;
 }
 
@@ -292,7 +292,28 @@ void PathCompiler::doUpdateFromUAV(UAVObject *obj)
         return;
     }
 
-    Waypoint *waypointObj = Waypoint::GetInstance(getObjectManager());
+    /* A single waypoint moving only dirties its own entry in the compiled */
+    /* path. Anything else (home moved, list grew, an action changed) falls */
+    /* back to a full recompilation */
+    if (obj && (obj->getObjID() == Waypoint::OBJID)) {
+        if (compileWaypoint(obj->getInstID())) {
+            return;
+        }
+    }
+
+    compileFullPath();
+}
+
+/**
+ * Recompile the whole path from the waypoint UAVOs and inform the
+ * visualization if anything changed
+ */
+void PathCompiler::compileFullPath()
+{
+    UAVObjectManager *objManager = getObjectManager();
+
+    Waypoint *waypointObj = Waypoint::GetInstance(objManager);
+
     Q_ASSERT(waypointObj);
     if (waypointObj == NULL) {
         return;
@@ -300,6 +321,7 @@ void PathCompiler::doUpdateFromUAV(UAVObject *obj)
 
     /* Get all the waypoints from the UAVO and create a representation for the visualization */
     QList <waypoint> waypoints;
+    QList <quint8> actions;
     waypoints.clear();
     int numWaypoints = objManager->getNumInstances(waypointObj->getObjID());
     bool stopped     = false;
@@ -312,9 +334,11 @@ void PathCompiler::doUpdateFromUAV(UAVObject *obj)
 
         Waypoint::DataFields waypointData = waypoint->getData();
         waypoints.append(UavoToInternal(waypointData));
+        actions.append(waypointData.Action);
         stopped = waypointData.Action == Waypoint::ACTION_STOP;
     }
 
+    previousActions = actions;
     if (previousWaypoints != waypoints) {
         /* Because the waypoints have to update periodically (or we miss new ones on the FC */
         /* side - needs telem fix) we want to filter updates to map that are simply periodic */
@@ -325,6 +349,44 @@ void PathCompiler::doUpdateFromUAV(UAVObject *obj)
     }
 }
 
+/**
+ * Recompile a single waypoint in place.  Only legal while the path structure
+ * is unchanged: the index must already be part of the compiled path and its
+ * action must be the same, since toggling ACTION_STOP moves the end of the
+ * path
+ * @param index which waypoint instance changed
+ * @returns true when the cached path could be patched, false when a full
+ * recompilation is needed
+ */
+bool PathCompiler::compileWaypoint(int index)
+{
+    if ((index < 0) || (index >= previousWaypoints.count()) || (index >= previousActions.count())) {
+        return false;
+    }
+
+    Waypoint *waypointObj = Waypoint::GetInstance(getObjectManager(), index);
+    Q_ASSERT(waypointObj);
+    if (waypointObj == NULL) {
+        return false;
+    }
+
+    Waypoint::DataFields waypointData = waypointObj->getData();
+    if (waypointData.Action != previousActions.at(index)) {
+        return false;
+    }
+
+    waypoint updated = UavoToInternal(waypointData);
+    if (updated == previousWaypoints.at(index)) {
+        /* filter periodic updates that did not move the waypoint */
+        return true;
+    }
+    previousWaypoints[index] = updated;
+
+    /* Inform visualization */
+    emit visualizationChanged(previousWaypoints);
+    return true;
+}
+
 /**
  * Convert a UAVO waypoint to the local structure
  * @param uavo The UAVO data representation
@@ -89,7 +89,16 @@ private:
     // ! Convert a UAVO waypoint to the local structure
     Waypoint::DataFields InternalToUavo(waypoint);
 
+    // ! Recompile the whole path from the UAVOs
+    void compileFullPath();
+
+    // ! Patch a single waypoint into the cached path, false if a full recompilation is needed
+    bool compileWaypoint(int index);
+
+    // cached result of the last compilation, patched in place when a single
+    // waypoint moves so dragging does not recompile the whole path
     QList <waypoint> previousWaypoints;
+    QList <quint8> previousActions;
 signals:
     /**
      * Indicates something changed the waypoints and the map should
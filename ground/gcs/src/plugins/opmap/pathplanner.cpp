@@ -53,6 +53,7 @@ void pathPlanner::setModel(flightDataModel *model, QItemSelectionModel *selectio
     ui->tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
     ui->tableView->setItemDelegate(new MapDataDelegate(this));
     connect(model, SIGNAL(rowsInserted(const QModelIndex &, int, int)), this, SLOT(rowsInserted(const QModelIndex &, int, int)));
+    connect(model, SIGNAL(modelReset()), this, SLOT(modelReset()));
     wid = new opmap_edit_waypoint_dialog(NULL, model, selection);
     ui->tableView->resizeColumnsToContents();
 }
@@ -71,6 +72,13 @@ void pathPlanner::rowsInserted(const QModelIndex & parent, int start, int end)
     }
 }
 
+void pathPlanner::modelReset()
+{
+    if (ui->tableView->model()->rowCount() > 0) {
+        rowsInserted(QModelIndex(), 0, ui->tableView->model()->rowCount() - 1);
+    }
+}
+
 void pathPlanner::on_tbAdd_clicked()
 {
     ui->tableView->model()->insertRow(ui->tableView->model()->rowCount());
@@ -46,6 +46,8 @@ public:
 private slots:
     void rowsInserted(const QModelIndex & parent, int start, int end);
 
+    void modelReset();
+
     void on_tbAdd_clicked();
 
     void on_tbDelete_clicked();
@@ -37,6 +37,7 @@
 // #include <QIcon>
 #include <QMessageBox>
 #include <QtCore/QSignalMapper>
+#include <QtCore/QTimer>
 #include <QtCore/QDebug>
 #include "waypoint.h"
 #include "waypointactive.h"
@@ -56,6 +57,13 @@ PathActionEditorTreeModel::PathActionEditorTreeModel(QObject *parent) :
     connect(m_objManager->getObject("PathAction"), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objUpdated(UAVObject *)));
     connect(m_objManager->getObject("Waypoint"), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objUpdated(UAVObject *)));
 
+    // coalesce telemetry driven events into one model refresh per tick
+    m_pendingActiveUpdate = false;
+    m_updateTimer = new QTimer(this);
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(100);
+    connect(m_updateTimer, SIGNAL(timeout()), this, SLOT(updateTick()));
+
     setupModelData();
 }
 
@@ -399,31 +407,118 @@ void PathActionEditorTreeModel::updateHighlight(TreeItem *item)
 void PathActionEditorTreeModel::highlightUpdatedObject(UAVObject *obj)
 {
     Q_ASSERT(obj);
-    if (obj->getName().compare("Waypoint") == 0) {
-        m_waypointsTree->update();
-        // emit dataChanged(index(m_waypointsTree), index(m_waypointsTree));
-    } else if (obj->getName().compare("PathAction") == 0) {
-        m_pathactionsTree->update();
-        // emit dataChanged(index(m_pathactionsTree), index(m_pathactionsTree));
+    // queue the updated instance and refresh it on the next tick together
+    // with every other update received meanwhile
+    m_pendingObjectUpdates.insert(obj);
+    if (!m_updateTimer->isActive()) {
+        m_updateTimer->start();
     }
 }
 
 void PathActionEditorTreeModel::newInstance(UAVObject *obj)
 {
-    if (obj->getName().compare("Waypoint") == 0) {
-        addInstance(obj, m_waypointsTree);
-        m_waypointsTree->update();
-    } else if (obj->getName().compare("PathAction") == 0) {
-        addInstance(obj, m_pathactionsTree);
-        m_pathactionsTree->update();
+    if ((obj->getName().compare("Waypoint") == 0) || (obj->getName().compare("PathAction") == 0)) {
+        m_pendingNewInstances.append(obj);
+        if (!m_updateTimer->isActive()) {
+            m_updateTimer->start();
+        }
     }
-    updateActions();
-    emit layoutChanged();
 }
 
 void PathActionEditorTreeModel::objUpdated(UAVObject *obj)
 {
     Q_UNUSED(obj);
+    m_pendingActiveUpdate = true;
+    if (!m_updateTimer->isActive()) {
+        m_updateTimer->start();
+    }
+}
+
+void PathActionEditorTreeModel::updateTick()
+{
+    addPendingInstances();
+
+    foreach(UAVObject * obj, m_pendingObjectUpdates) {
+        TopTreeItem *tree = NULL;
+
+        if (obj->getName().compare("Waypoint") == 0) {
+            tree = m_waypointsTree;
+        } else if (obj->getName().compare("PathAction") == 0) {
+            tree = m_pathactionsTree;
+        }
+        if (!tree) {
+            continue;
+        }
+        foreach(TreeItem * child, tree->treeChildren()) {
+            ObjectTreeItem *objItem = dynamic_cast<ObjectTreeItem *>(child);
+
+            if (objItem && (objItem->object() == obj)) {
+                // field items only take new data when the value actually
+                // changed, so unchanged rows cost nothing to walk
+                child->update();
+                emitSubtreeChanged(child);
+                break;
+            }
+        }
+    }
+    m_pendingObjectUpdates.clear();
+
+    if (m_pendingActiveUpdate) {
+        m_pendingActiveUpdate = false;
+        updateActiveWaypoint();
+    }
+}
+
+void PathActionEditorTreeModel::addPendingInstances()
+{
+    if (m_pendingNewInstances.isEmpty()) {
+        return;
+    }
+
+    // add all queued instances below each top level item in a single
+    // insertion span instead of touching the view row by row
+    QList<TopTreeItem *> trees;
+    trees << m_waypointsTree << m_pathactionsTree;
+    foreach(TopTreeItem * tree, trees) {
+        QString name = (tree == m_waypointsTree) ? "Waypoint" : "PathAction";
+        QList<UAVObject *> list;
+        foreach(UAVObject * obj, m_pendingNewInstances) {
+            if (obj->getName().compare(name) == 0) {
+                list.append(obj);
+            }
+        }
+        if (list.isEmpty()) {
+            continue;
+        }
+        QModelIndex parentIndex = index(tree);
+        beginInsertRows(parentIndex, tree->childCount(), tree->childCount() + list.count() - 1);
+        foreach(UAVObject * obj, list) {
+            addInstance(obj, tree);
+        }
+        endInsertRows();
+    }
+    m_pendingNewInstances.clear();
+    updateActions();
+}
+
+void PathActionEditorTreeModel::emitSubtreeChanged(TreeItem *item)
+{
+    int rows = item->childCount();
+
+    if (rows == 0) {
+        return;
+    }
+    QModelIndex parentIndex = index(item);
+    emit dataChanged(index(0, 0, parentIndex), index(rows - 1, TreeItem::dataColumn, parentIndex));
+    foreach(TreeItem * child, item->treeChildren()) {
+        if (child->childCount() > 0) {
+            emitSubtreeChanged(child);
+        }
+    }
+}
+
+void PathActionEditorTreeModel::updateActiveWaypoint()
+{
     quint16 index  = m_objManager->getObject("WaypointActive")->getField("Index")->getValue().toInt();
     quint16 action = 0;
 
@@ -31,6 +31,7 @@
 #include "treeitem.h"
 #include <QAbstractItemModel>
 #include <QtCore/QMap>
+#include <QtCore/QSet>
 #include <QColor>
 
 class TopTreeItem;
@@ -79,6 +80,7 @@ public slots:
 private slots:
     void highlightUpdatedObject(UAVObject *obj);
     void updateHighlight(TreeItem *);
+    void updateTick();
 
 private:
     QModelIndex index(TreeItem *item);
@@ -89,10 +91,20 @@ private:
     // QString updateMode(quint8 updateMode);
     void setupModelData();
     void updateActions();
+    void addPendingInstances();
+    void updateActiveWaypoint();
+    void emitSubtreeChanged(TreeItem *item);
 
     UAVObjectManager *m_objManager;
     QStringList *m_actions;
 
+    // telemetry driven events are coalesced : they collect here and the
+    // model is brought up to date once per timer tick
+    QSet<UAVObject *> m_pendingObjectUpdates;
+    QList<UAVObject *> m_pendingNewInstances;
+    bool m_pendingActiveUpdate;
+    QTimer *m_updateTimer;
+
     TreeItem *m_rootItem;
     TopTreeItem *m_pathactionsTree;
     TopTreeItem *m_waypointsTree;
@@ -29,6 +29,7 @@
 #include "pfdqmlplugin.h"
 #include "pfdqmlgadgetfactory.h"
 #include <extensionsystem/pluginmanager.h>
+#include <utils/qmlcache.h>
 
 #ifdef USE_OSG
 #include <osgearth/osgearth.h>
@@ -52,6 +53,8 @@ bool PfdQmlPlugin::initialize(const QStringList & args, QString *errMsg)
     Q_UNUSED(args);
     Q_UNUSED(errMsg);
 
+    Utils::InitializeQmlCache();
+
 #ifdef USE_OSG
     // TODO get rid of this call...
     // this is the only place that references osgearth
@@ -245,3 +245,16 @@ plugin_streamservice.depends = plugin_coreplugin
 plugin_streamservice.depends += plugin_uavobjects
 plugin_streamservice.depends += plugin_uavtalk
 SUBDIRS += plugin_streamservice
+
+# Telemetry Recorder Plugin
+plugin_telemetryrecorder.subdir = telemetryrecorder
+plugin_telemetryrecorder.depends = plugin_coreplugin
+plugin_telemetryrecorder.depends += plugin_uavobjects
+SUBDIRS += plugin_telemetryrecorder
+
+# Load Generator Plugin
+plugin_loadgenerator.subdir = loadgenerator
+plugin_loadgenerator.depends = plugin_coreplugin
+plugin_loadgenerator.depends += plugin_uavobjects
+plugin_loadgenerator.depends += plugin_uavtalk
+SUBDIRS += plugin_loadgenerator
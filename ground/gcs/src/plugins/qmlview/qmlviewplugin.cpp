@@ -31,6 +31,7 @@
 #include <QtPlugin>
 #include <QStringList>
 #include <extensionsystem/pluginmanager.h>
+#include <utils/qmlcache.h>
 
 
 QmlViewPlugin::QmlViewPlugin()
@@ -47,6 +48,9 @@ bool QmlViewPlugin::initialize(const QStringList & args, QString *errMsg)
 {
     Q_UNUSED(args);
     Q_UNUSED(errMsg);
+
+    Utils::InitializeQmlCache();
+
     mf = new QmlViewGadgetFactory(this);
     addAutoReleasedObject(mf);
 
@@ -27,9 +27,218 @@
 
 
 #include "plotdata.h"
+#include "qwt/src/qwt_plot_directpainter.h"
 #include <math.h>
 #include <QDebug>
 
+PlotRingBuffer::PlotRingBuffer() : m_head(0), m_count(0), m_indexedX(false),
+    m_decimationLimit(0), m_decimatedDirty(false),
+    m_appendedSinceDraw(0), m_dirtyBeyondAppend(true)
+{}
+
+void PlotRingBuffer::setIndexedX(bool indexedX)
+{
+    m_indexedX = indexedX;
+}
+
+void PlotRingBuffer::setDecimationLimit(int maxPoints)
+{
+    if (m_decimationLimit != maxPoints) {
+        m_decimationLimit   = maxPoints;
+        m_decimatedDirty    = true;
+        m_dirtyBeyondAppend = true;
+    }
+}
+
+void PlotRingBuffer::append(double x, double y)
+{
+    if (m_count == m_yData.size()) {
+        grow();
+    }
+    int tail = (m_head + m_count) % m_yData.size();
+    if (!m_indexedX) {
+        m_xData[tail] = x;
+    }
+    m_yData[tail] = y;
+    ++m_count;
+    ++m_appendedSinceDraw;
+    if (decimationActive()) {
+        // the bucketed view rebuilds wholly, appends cannot be painted alone
+        m_dirtyBeyondAppend = true;
+    }
+    markChanged();
+}
+
+void PlotRingBuffer::popFront()
+{
+    if (m_count == 0) {
+        return;
+    }
+    m_head = (m_head + 1) % m_yData.size();
+    --m_count;
+    m_dirtyBeyondAppend = true;
+    markChanged();
+}
+
+void PlotRingBuffer::clear()
+{
+    m_head  = 0;
+    m_count = 0;
+    m_appendedSinceDraw = 0;
+    m_dirtyBeyondAppend = true;
+    markChanged();
+}
+
+double PlotRingBuffer::firstX() const
+{
+    return m_indexedX ? 0 : m_xData.at(m_head);
+}
+
+double PlotRingBuffer::lastX() const
+{
+    return m_indexedX ? (m_count - 1) : m_xData.at((m_head + m_count - 1) % m_xData.size());
+}
+
+double PlotRingBuffer::lastY() const
+{
+    return m_yData.at((m_head + m_count - 1) % m_yData.size());
+}
+
+size_t PlotRingBuffer::size() const
+{
+    if (decimationActive()) {
+        if (m_decimatedDirty) {
+            rebuildDecimated();
+        }
+        return m_decimated.count();
+    }
+    return m_count;
+}
+
+QPointF PlotRingBuffer::sample(size_t i) const
+{
+    if (decimationActive()) {
+        if (m_decimatedDirty) {
+            rebuildDecimated();
+        }
+        return m_decimated.at((int)i);
+    }
+    return rawSample((int)i);
+}
+
+QPointF PlotRingBuffer::rawSample(int i) const
+{
+    int j = (m_head + i) % m_yData.size();
+
+    return QPointF(m_indexedX ? (double)i : m_xData.at(j), m_yData.at(j));
+}
+
+QVector<QPointF> PlotRingBuffer::rawSamples() const
+{
+    QVector<QPointF> samples;
+
+    samples.reserve(m_count);
+    for (int i = 0; i < m_count; ++i) {
+        samples.append(rawSample(i));
+    }
+    return samples;
+}
+
+void PlotRingBuffer::rebuildDecimated() const
+{
+    m_decimated.clear();
+
+    // two points per bucket keep both extremes of every bucket visible
+    int buckets    = m_decimationLimit / 2;
+    int bucketSize = (m_count + buckets - 1) / buckets;
+
+    for (int start = 0; start < m_count; start += bucketSize) {
+        int end     = qMin(start + bucketSize, m_count);
+        int minI    = start;
+        int maxI    = start;
+        double minY = m_yData.at((m_head + start) % m_yData.size());
+        double maxY = minY;
+        for (int i = start + 1; i < end; i++) {
+            double y = m_yData.at((m_head + i) % m_yData.size());
+            if (y < minY) {
+                minY = y;
+                minI = i;
+            }
+            if (y > maxY) {
+                maxY = y;
+                maxI = i;
+            }
+        }
+        if (minI == maxI) {
+            m_decimated.append(rawSample(minI));
+        } else if (minI < maxI) {
+            m_decimated.append(rawSample(minI));
+            m_decimated.append(rawSample(maxI));
+        } else {
+            m_decimated.append(rawSample(maxI));
+            m_decimated.append(rawSample(minI));
+        }
+    }
+    m_decimatedDirty = false;
+}
+
+QRectF PlotRingBuffer::boundingRect() const
+{
+    if ((d_boundingRect.width() < 0.0) && (m_count > 0)) {
+        double minX = firstX();
+        double maxX = lastX();
+        double minY = m_yData.at(m_head);
+        double maxY = minY;
+        for (int i = 0; i < m_count; i++) {
+            int j = (m_head + i) % m_yData.size();
+            double y = m_yData.at(j);
+            if (y < minY) {
+                minY = y;
+            } else if (y > maxY) {
+                maxY = y;
+            }
+            if (!m_indexedX) {
+                double x = m_xData.at(j);
+                if (x < minX) {
+                    minX = x;
+                } else if (x > maxX) {
+                    maxX = x;
+                }
+            }
+        }
+        d_boundingRect = QRectF(minX, minY, maxX - minX, maxY - minY);
+    }
+    return d_boundingRect;
+}
+
+void PlotRingBuffer::grow()
+{
+    int newCapacity = m_yData.size() ? 2 * m_yData.size() : INITIAL_CAPACITY;
+
+    // unroll the ring into the front of the bigger buffers
+    QVector<double> yData(newCapacity);
+    QVector<double> xData;
+    if (!m_indexedX) {
+        xData.resize(newCapacity);
+    }
+    for (int i = 0; i < m_count; i++) {
+        int j = (m_head + i) % m_yData.size();
+        yData[i] = m_yData.at(j);
+        if (!m_indexedX) {
+            xData[i] = m_xData.at(j);
+        }
+    }
+    m_yData = yData;
+    m_xData = xData;
+    m_head  = 0;
+}
+
+void PlotRingBuffer::markChanged()
+{
+    d_boundingRect   = QRectF(0.0, 0.0, -1.0, -1.0);
+    m_decimatedDirty = true;
+}
+
 PlotData::PlotData(UAVObject *object, UAVObjectField *field, int element,
                    int scaleOrderFactor, int meanSamples, QString mathFunction,
                    double plotDataSize, QPen pen, bool antialiased) :
@@ -37,9 +246,13 @@ PlotData::PlotData(UAVObject *object, UAVObjectField *field, int element,
     m_meanSum(0.0f), m_mathFunction(mathFunction), m_correctionSum(0.0f),
     m_correctionCount(0), m_plotDataSize(plotDataSize),
     m_object(object), m_field(field), m_element(element),
-    m_plotCurve(NULL), m_isVisible(true), m_pen(pen), m_isEnumPlot(false)
+    m_plotCurve(NULL), m_isVisible(true), m_pen(pen), m_isEnumPlot(false),
+    m_derivLastValue(0.0), m_derivLastTime(0.0), m_derivHasLast(false)
 {
-    if (m_field->getNumElements() > 1) {
+    if (m_mathFunction == "Vector magnitude") {
+        // the derived channel spans every element of the field
+        m_elementName = "magnitude";
+    } else if (m_field->getNumElements() > 1) {
         m_elementName = m_field->getElementNames().at(m_element);
     }
 
@@ -48,10 +261,14 @@ PlotData::PlotData(UAVObject *object, UAVObjectField *field, int element,
         m_plotName.append(QString(".%1").arg(m_elementName));
     }
 
+    QString units = m_field->getUnits();
+    if (m_mathFunction == "Rate of change") {
+        units.append("/s");
+    }
     if (m_scalePower == 0) {
-        m_plotName.append(QString(" (%1)").arg(m_field->getUnits()));
+        m_plotName.append(QString(" (%1)").arg(units));
     } else {
-        m_plotName.append(QString(" (x10^%1 %2)").arg(m_scalePower).arg(m_field->getUnits()));
+        m_plotName.append(QString(" (x10^%1 %2)").arg(m_scalePower).arg(units));
     }
 
     // Create the curve
@@ -62,7 +279,9 @@ PlotData::PlotData(UAVObject *object, UAVObjectField *field, int element,
     }
 
     m_plotCurve->setPen(m_pen);
-    m_plotCurve->setSamples(m_xDataEntries, m_yDataEntries);
+    // the curve takes ownership of the buffer and reads the samples in place
+    m_dataBuffer = new PlotRingBuffer();
+    m_plotCurve->setData(m_dataBuffer);
     m_isEnumPlot = m_field->getType() == UAVObjectField::ENUM;
 }
 
@@ -90,7 +309,54 @@ void PlotData::setVisible(bool visible)
 
 void PlotData::updatePlotData()
 {
-    m_plotCurve->setSamples(m_xDataEntries, m_yDataEntries);
+    // nothing to push to the curve, it reads the ring buffer in place
+    // and the buffer invalidates its bounding rect on every change
+}
+
+void PlotData::setDecimationLimit(int maxPoints)
+{
+    m_dataBuffer->setDecimationLimit(maxPoints);
+}
+
+/**
+ * An append-only draw matches a full replot as long as nothing but new
+ * samples changed and the new samples fit the current y scale; a sample
+ * outside it would make the axis rescale, shifting the whole canvas.
+ */
+bool PlotData::canDrawAppended() const
+{
+    if (m_isEnumPlot || (m_plotCurve->plot() == NULL) || m_dataBuffer->dirtyBeyondAppend()) {
+        return false;
+    }
+    int appended = m_dataBuffer->appendedSinceDraw();
+    if (appended == 0) {
+        return true;
+    }
+    QwtInterval yInterval = m_plotCurve->plot()->axisInterval(QwtPlot::yLeft);
+    for (int i = m_dataBuffer->count() - appended; i < m_dataBuffer->count(); i++) {
+        double y = m_dataBuffer->sample(i).y();
+        if ((y < yInterval.minValue()) || (y > yInterval.maxValue())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PlotData::drawAppended(QwtPlotDirectPainter *painter)
+{
+    int appended = m_dataBuffer->appendedSinceDraw();
+
+    if ((appended > 0) && m_plotCurve->isVisible()) {
+        int count = m_dataBuffer->count();
+        // include the previous sample so the new segment connects to the curve
+        painter->drawSeries(m_plotCurve, qMax(0, count - appended - 1), count - 1);
+    }
+    m_dataBuffer->markDrawn();
+}
+
+void PlotData::markDrawn()
+{
+    m_dataBuffer->markDrawn();
 }
 
 void PlotData::clear()
@@ -98,8 +364,9 @@ void PlotData::clear()
     m_meanSum = 0.0f;
     m_correctionSum   = 0.0f;
     m_correctionCount = 0;
-    m_xDataEntries.clear();
-    m_yDataEntries.clear();
+    m_derivHasLast    = false;
+    m_dataBuffer->clear();
+    m_yDataHistory.clear();
     while (!m_enumMarkerList.isEmpty()) {
         QwtPlotMarker *marker = m_enumMarkerList.takeFirst();
         marker->detach();
@@ -113,7 +380,7 @@ void PlotData::clear()
 bool PlotData::hasData() const
 {
     if (!m_isEnumPlot) {
-        return !m_xDataEntries.isEmpty();
+        return !m_dataBuffer->isEmpty();
     } else {
         return !m_enumMarkerList.isEmpty();
     }
@@ -122,12 +389,17 @@ bool PlotData::hasData() const
 QString PlotData::lastDataAsString()
 {
     if (!m_isEnumPlot) {
-        return QString().sprintf("%3.10g", m_yDataEntries.last());
+        return QString().sprintf("%3.10g", m_dataBuffer->lastY());
     } else {
         return m_enumMarkerList.last()->title().text();
     }
 }
 
+QVector<QPointF> PlotData::rawSamples() const
+{
+    return m_dataBuffer->rawSamples();
+}
+
 void PlotData::attach(QwtPlot *plot)
 {
     m_plotCurve->attach(plot);
@@ -142,7 +414,7 @@ void PlotData::visibilityChanged(QwtPlotItem *item)
     }
 }
 
-void PlotData::calcMathFunction(double currentValue)
+double PlotData::calcMathFunction(double currentValue)
 {
     // Put the new value at the back
     m_yDataHistory.append(currentValue);
@@ -169,10 +441,27 @@ void PlotData::calcMathFunction(double currentValue)
         for (int i = 0; i < m_yDataHistory.size(); i++) {
             stdSum += pow(m_yDataHistory.at(i) - boxcarAvg, 2) / (m_meanSamples - 1);
         }
-        m_yDataEntries.append(sqrt(stdSum));
-    } else {
-        m_yDataEntries.append(boxcarAvg);
+        return sqrt(stdSum);
+    }
+    return boxcarAvg;
+}
+
+/**
+ * Incremental first derivative of the sampled value, in units per second.
+ * Keeping only the previous sample makes the derived channel O(1) per
+ * sample, so it can run in the ingest path instead of a post-flight job.
+ */
+double PlotData::calcRateOfChange(double currentValue, double time)
+{
+    double rate = 0.0;
+
+    if (m_derivHasLast && (time > m_derivLastTime)) {
+        rate = (currentValue - m_derivLastValue) / (time - m_derivLastTime);
     }
+    m_derivLastValue = currentValue;
+    m_derivLastTime  = time;
+    m_derivHasLast   = true;
+    return rate;
 }
 
 QwtPlotMarker *PlotData::createMarker(QString value)
@@ -199,100 +488,111 @@ QwtPlotMarker *PlotData::createMarker(QString value)
     return marker;
 }
 
-bool SequentialPlotData::append(UAVObject *obj)
+bool PlotData::append(UAVObject *obj)
 {
     if (obj == NULL) {
         obj = m_object;
     }
 
     if (m_object == obj && m_field) {
-        if (!m_isEnumPlot) {
-            double currentValue = m_field->getValue(m_element).toDouble() * pow(10, m_scalePower);
-
-            // Perform scope math, if necessary
-            if (m_mathFunction == "Boxcar average" || m_mathFunction == "Standard deviation") {
-                calcMathFunction(currentValue);
-            } else {
-                m_yDataEntries.append(currentValue);
-            }
-
-            if (m_yDataEntries.size() > m_plotDataSize) {
-                // If new data overflows the window, remove old data...
-                m_yDataEntries.pop_front();
-            } else {
-                // ...otherwise, add a new y point at position xData
-                m_xDataEntries.insert(m_xDataEntries.size(), m_xDataEntries.size());
-            }
-            return true;
-        } else {
-            // Enum markers
-            QString value = m_field->getValue(m_element).toString();
-
-            QwtPlotMarker *marker = m_enumMarkerList.isEmpty() ? NULL : m_enumMarkerList.last();
-            if (!marker || marker->title() != value) {
-                marker = createMarker(value);
-                marker->setXValue(m_enumMarkerList.size());
+        // THINK ABOUT REIMPLEMENTING THIS TO SHOW UAVO TIME, NOT SYSTEM TIME
+        QDateTime NOW = QDateTime::currentDateTime();
 
-                if (m_plotCurve->isVisible()) {
-                    marker->attach(m_plotCurve->plot());
-                }
-                m_enumMarkerList.append(marker);
-            }
-        }
+        appendSample(m_field->getValue(m_element), NOW.toTime_t() + NOW.time().msec() / 1000.0);
+        return true;
     }
     return false;
 }
 
-bool ChronoPlotData::append(UAVObject *obj)
+/**
+ * Element-wise derived channels are computed here, from the raw object
+ * snapshot, so a curve can combine several elements of the field even
+ * though only one sample value travels through the staging queue.
+ */
+QVariant PlotData::sampleFromData(const quint8 *data) const
 {
-    if (obj == NULL) {
-        obj = m_object;
+    if (m_mathFunction == "Vector magnitude") {
+        double sumSquares = 0.0;
+        for (quint32 i = 0; i < m_field->getNumElements(); i++) {
+            double v = m_field->getValueFromData(data, i).toDouble();
+            sumSquares += v * v;
+        }
+        return sqrt(sumSquares);
     }
+    return m_field->getValueFromData(data, m_element);
+}
 
-    if (m_object == obj && m_field) {
-        // Get the field of interest
-        // THINK ABOUT REIMPLEMENTING THIS TO SHOW UAVO TIME, NOT SYSTEM TIME
-        QDateTime NOW = QDateTime::currentDateTime();
+void SequentialPlotData::appendSample(const QVariant &value, double time)
+{
+    if (!m_isEnumPlot) {
+        double currentValue = value.toDouble() * pow(10, m_scalePower);
 
-        double xValue = NOW.toTime_t() + NOW.time().msec() / 1000.0;
-        if (!m_isEnumPlot) {
-            double currentValue = m_field->getValue(m_element).toDouble() * pow(10, m_scalePower);
+        // Perform scope math, if necessary
+        if (m_mathFunction == "Boxcar average" || m_mathFunction == "Standard deviation") {
+            currentValue = calcMathFunction(currentValue);
+        } else if (m_mathFunction == "Rate of change") {
+            currentValue = calcRateOfChange(currentValue, time);
+        }
+
+        if (m_dataBuffer->count() >= m_plotDataSize) {
+            // If new data overflows the window, remove old data...
+            m_dataBuffer->popFront();
+        }
+        // x is implicit, the buffer plots y against the sample position
+        m_dataBuffer->append(0, currentValue);
+    } else {
+        // Enum markers
+        QString text = value.toString();
+
+        QwtPlotMarker *marker = m_enumMarkerList.isEmpty() ? NULL : m_enumMarkerList.last();
+        if (!marker || marker->title() != text) {
+            marker = createMarker(text);
+            marker->setXValue(m_enumMarkerList.size());
 
-            // Perform scope math, if necessary
-            if (m_mathFunction == "Boxcar average" || m_mathFunction == "Standard deviation") {
-                calcMathFunction(currentValue);
-            } else {
-                m_yDataEntries.append(currentValue);
+            if (m_plotCurve->isVisible()) {
+                marker->attach(m_plotCurve->plot());
             }
+            m_enumMarkerList.append(marker);
+        }
+    }
+}
 
-            m_xDataEntries.append(xValue);
-        } else {
-            // Enum markers
-            QString value = m_field->getValue(m_element).toString();
+void ChronoPlotData::appendSample(const QVariant &value, double time)
+{
+    if (!m_isEnumPlot) {
+        double currentValue = value.toDouble() * pow(10, m_scalePower);
 
-            QwtPlotMarker *marker = m_enumMarkerList.isEmpty() ? NULL : m_enumMarkerList.last();
-            if (!marker || marker->title() != value) {
-                marker = createMarker(value);
-                marker->setXValue(xValue);
+        // Perform scope math, if necessary
+        if (m_mathFunction == "Boxcar average" || m_mathFunction == "Standard deviation") {
+            currentValue = calcMathFunction(currentValue);
+        } else if (m_mathFunction == "Rate of change") {
+            currentValue = calcRateOfChange(currentValue, time);
+        }
 
-                if (m_plotCurve->isVisible()) {
-                    marker->attach(m_plotCurve->plot());
-                }
-                m_enumMarkerList.append(marker);
+        m_dataBuffer->append(time, currentValue);
+    } else {
+        // Enum markers
+        QString text = value.toString();
+
+        QwtPlotMarker *marker = m_enumMarkerList.isEmpty() ? NULL : m_enumMarkerList.last();
+        if (!marker || marker->title() != text) {
+            marker = createMarker(text);
+            marker->setXValue(time);
+
+            if (m_plotCurve->isVisible()) {
+                marker->attach(m_plotCurve->plot());
             }
+            m_enumMarkerList.append(marker);
         }
-        removeStaleData();
-        return true;
     }
-    return false;
+    removeStaleData();
 }
 
 void ChronoPlotData::removeStaleData()
 {
-    while (!m_xDataEntries.isEmpty() &&
-           (m_xDataEntries.last() - m_xDataEntries.first()) > m_plotDataSize) {
-        m_yDataEntries.pop_front();
-        m_xDataEntries.pop_front();
+    while (!m_dataBuffer->isEmpty() &&
+           (m_dataBuffer->lastX() - m_dataBuffer->firstX()) > m_plotDataSize) {
+        m_dataBuffer->popFront();
     }
     while (!m_enumMarkerList.isEmpty() &&
            (m_enumMarkerList.last()->xValue() - m_enumMarkerList.first()->xValue()) > m_plotDataSize) {
@@ -42,11 +42,115 @@
 #include <QVector>
 #include <uavdataobject.h>
 
+class QwtPlotDirectPainter;
+
 /*!
    \brief Defines the different type of plots.
  */
 enum PlotType { SequentialPlot, ChronoPlot };
 
+/*!
+   \brief Ring buffer holding the samples of one curve.
+
+   Appending and aging out samples are both O(1), unlike a QVector where
+   removing the oldest sample moves the whole window. The buffer implements
+   QwtSeriesData so the curve reads the samples in place and no contiguous
+   copy is needed per replot.
+
+   In indexed mode the x value of a sample is simply its position in the
+   buffer, which matches the fixed x axis of sequential plots; chrono plots
+   store an explicit x (time) value per sample.
+
+   When a decimation limit is set and the buffer holds more raw samples than
+   that, the curve is served a min/max bucketed view instead: each bucket
+   contributes its extreme samples in order, so spikes survive while the
+   rendered point count stays bounded no matter how long the session is.
+ */
+class PlotRingBuffer : public QwtSeriesData<QPointF> {
+public:
+    PlotRingBuffer();
+
+    // ! Must be set before the first sample is appended
+    void setIndexedX(bool indexedX);
+
+    // ! Cap the number of points served to the curve, 0 disables decimation
+    void setDecimationLimit(int maxPoints);
+
+    void append(double x, double y);
+    void popFront();
+    void clear();
+
+    // incremental paint bookkeeping: how many samples were appended since
+    // the last draw, and whether anything else changed the drawn content
+    int appendedSinceDraw() const
+    {
+        return m_appendedSinceDraw;
+    }
+    bool dirtyBeyondAppend() const
+    {
+        return m_dirtyBeyondAppend;
+    }
+    void markDrawn()
+    {
+        m_appendedSinceDraw = 0;
+        m_dirtyBeyondAppend = false;
+    }
+
+    bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+    int count() const
+    {
+        return m_count;
+    }
+    double firstX() const;
+    double lastX() const;
+    double lastY() const;
+
+    quint64 memoryBytes() const
+    {
+        return (quint64)(m_xData.capacity() + m_yData.capacity()) * sizeof(double)
+               + (quint64)m_decimated.capacity() * sizeof(QPointF);
+    }
+
+    // ! Snapshot every sample in order at full resolution, bypassing the
+    // ! decimated view the curve may be served. Used by export.
+    QVector<QPointF> rawSamples() const;
+
+    // QwtSeriesData interface
+    virtual size_t size() const;
+    virtual QPointF sample(size_t i) const;
+    virtual QRectF boundingRect() const;
+
+private:
+    static const int INITIAL_CAPACITY = 64;
+
+    void grow();
+    void markChanged();
+    QPointF rawSample(int i) const;
+    bool decimationActive() const
+    {
+        return (m_decimationLimit > 0) && (m_count > m_decimationLimit);
+    }
+    void rebuildDecimated() const;
+
+    QVector<double> m_xData;
+    QVector<double> m_yData;
+    int m_head;
+    int m_count;
+    bool m_indexedX;
+
+    // min/max bucketed view served to the curve once the raw sample count
+    // exceeds the limit, rebuilt lazily after the data changed
+    int m_decimationLimit;
+    mutable QVector<QPointF> m_decimated;
+    mutable bool m_decimatedDirty;
+
+    int m_appendedSinceDraw;
+    bool m_dirtyBeyondAppend;
+};
+
 /*!
    \brief Base class that keeps the data for each curve in the plot.
  */
@@ -88,16 +192,43 @@ public:
         return m_isEnumPlot;
     }
 
-    virtual bool append(UAVObject *obj) = 0;
-    virtual PlotType plotType() const   = 0;
+    // ! Sample the field now and accumulate it, GUI thread only
+    bool append(UAVObject *obj);
+    // ! Compute this curve's sample from a raw object snapshot, any thread
+    QVariant sampleFromData(const quint8 *data) const;
+    // ! Accumulate one already captured sample, GUI thread only
+    virtual void appendSample(const QVariant &value, double time) = 0;
+    virtual PlotType plotType() const = 0;
     virtual void removeStaleData() = 0;
 
     void updatePlotData();
+    void setDecimationLimit(int maxPoints);
     void clear();
 
+    // ! True when painting just the appended samples would match a full replot
+    bool canDrawAppended() const;
+    // ! Paint the samples appended since the last draw onto the live canvas
+    void drawAppended(QwtPlotDirectPainter *painter);
+    // ! Reset the append bookkeeping after a full replot
+    void markDrawn();
+
     bool hasData() const;
     QString lastDataAsString();
 
+    // ! Full resolution copy of the curve's ring buffer, GUI thread only;
+    // ! the returned vector is safe to hand to a worker for streaming out
+    QVector<QPointF> rawSamples() const;
+
+    quint64 memoryBytes() const
+    {
+        quint64 bytes = (quint64)m_yDataHistory.capacity() * sizeof(double);
+
+        if (m_dataBuffer != NULL) {
+            bytes += m_dataBuffer->memoryBytes();
+        }
+        return bytes;
+    }
+
     void attach(QwtPlot *plot);
 
 public slots:
@@ -113,8 +244,8 @@ protected:
     int m_correctionCount;
     double m_plotDataSize;
 
-    QVector<double> m_xDataEntries;
-    QVector<double> m_yDataEntries;
+    // owned by the curve once passed to QwtPlotCurve::setData()
+    PlotRingBuffer *m_dataBuffer;
     QVector<double> m_yDataHistory;
 
     UAVObject *m_object;
@@ -127,7 +258,12 @@ protected:
     bool m_isVisible;
     QPen m_pen;
     bool m_isEnumPlot;
-    virtual void calcMathFunction(double currentValue);
+    // previous sample feeding the "Rate of change" derived channel
+    double m_derivLastValue;
+    double m_derivLastTime;
+    bool m_derivHasLast;
+    virtual double calcMathFunction(double currentValue);
+    double calcRateOfChange(double currentValue, double time);
     QwtPlotMarker *createMarker(QString value);
 };
 
@@ -142,10 +278,14 @@ public:
                        int scaleFactor, int meanSamples, QString mathFunction,
                        double plotDataSize, QPen pen, bool antialiased)
         : PlotData(object, field, element, scaleFactor, meanSamples,
-                   mathFunction, plotDataSize, pen, antialiased) {}
+                   mathFunction, plotDataSize, pen, antialiased)
+    {
+        // x is the sample position, the axis stays fixed as the window fills
+        m_dataBuffer->setIndexedX(true);
+    }
     ~SequentialPlotData() {}
 
-    bool append(UAVObject *obj);
+    void appendSample(const QVariant &value, double time);
     PlotType plotType() const
     {
         return SequentialPlot;
@@ -167,7 +307,7 @@ public:
     {}
     ~ChronoPlotData() {}
 
-    bool append(UAVObject *obj);
+    void appendSample(const QVariant &value, double time);
     PlotType plotType() const
     {
         return ChronoPlot;
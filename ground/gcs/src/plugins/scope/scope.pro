@@ -1,7 +1,7 @@
 TEMPLATE = lib
 TARGET = ScopeGadget
 
-QT += widgets
+QT += widgets opengl concurrent
 
 DEFINES += SCOPE_LIBRARY
 
@@ -32,7 +32,8 @@ ScopeGadgetConfiguration::ScopeGadgetConfiguration(QString classId, QSettings *q
     m_plotType((int)ChronoPlot),
     m_dataSize(60),
     m_refreshInterval(1000),
-    m_mathFunctionType(0)
+    m_mathFunctionType(0),
+    m_useOpenGLCanvas(false)
 {
     uint currentStreamVersion = 0;
     int plotCurveCount = 0;
@@ -49,6 +50,7 @@ ScopeGadgetConfiguration::ScopeGadgetConfiguration(QString classId, QSettings *q
         m_plotType        = qSettings->value("plotType").toInt();
         m_dataSize        = qSettings->value("dataSize").toInt();
         m_refreshInterval = qSettings->value("refreshInterval").toInt();
+        m_useOpenGLCanvas = qSettings->value("useOpenGLCanvas", false).toBool();
         plotCurveCount    = qSettings->value("plotCurveCount").toInt();
 
         for (int plotDatasLoadIndex = 0; plotDatasLoadIndex < plotCurveCount; plotDatasLoadIndex++) {
@@ -102,6 +104,7 @@ IUAVGadgetConfiguration *ScopeGadgetConfiguration::clone()
     m->setDataSize(m_dataSize);
     m->setMathFunctionType(m_mathFunctionType);
     m->setRefreashInterval(m_refreshInterval);
+    m->setUseOpenGLCanvas(m_useOpenGLCanvas);
 
     plotCurveCount = m_plotCurveConfigs.size();
 
@@ -143,6 +146,7 @@ void ScopeGadgetConfiguration::saveConfig(QSettings *qSettings) const
     qSettings->setValue("plotType", m_plotType);
     qSettings->setValue("dataSize", m_dataSize);
     qSettings->setValue("refreshInterval", m_refreshInterval);
+    qSettings->setValue("useOpenGLCanvas", m_useOpenGLCanvas);
     qSettings->setValue("plotCurveCount", plotCurveCount);
 
     for (plotDatasLoadIndex = 0; plotDatasLoadIndex < plotCurveCount; plotDatasLoadIndex++) {
@@ -102,6 +102,15 @@ public:
     void saveConfig(QSettings *settings) const; // THIS SEEMS TO BE UNUSED
     IUAVGadgetConfiguration *clone();
 
+    bool getUseOpenGLCanvas()
+    {
+        return m_useOpenGLCanvas;
+    }
+    void setUseOpenGLCanvas(bool value)
+    {
+        m_useOpenGLCanvas = value;
+    }
+
     bool getLoggingEnabled()
     {
         return m_loggingEnabled;
@@ -139,6 +148,8 @@ private:
     int m_refreshInterval;
     // The type of math function to be used in the scope analysis
     int m_mathFunctionType;
+    // Render the plot through an OpenGL canvas instead of the raster one
+    bool m_useOpenGLCanvas;
     QList<PlotCurveConfiguration *> m_plotCurveConfigs;
 
     void clearPlotData();
@@ -72,6 +72,9 @@ QWidget *ScopeGadgetOptionsPage::createPage(QWidget *parent)
     options_page->mathFunctionComboBox->addItem("None");
     options_page->mathFunctionComboBox->addItem("Boxcar average");
     options_page->mathFunctionComboBox->addItem("Standard deviation");
+    // derived channels, computed incrementally per sample in the ingest path
+    options_page->mathFunctionComboBox->addItem("Vector magnitude");
+    options_page->mathFunctionComboBox->addItem("Rate of change");
 
     if (options_page->cmbUAVObjects->currentIndex() >= 0) {
         on_cmbUAVObjects_currentIndexChanged(options_page->cmbUAVObjects->currentText());
@@ -100,6 +103,7 @@ QWidget *ScopeGadgetOptionsPage::createPage(QWidget *parent)
     options_page->mathFunctionComboBox->setCurrentIndex(m_config->mathFunctionType());
     options_page->spnDataSize->setValue(m_config->dataSize());
     options_page->spnRefreshInterval->setValue(m_config->refreshInterval());
+    options_page->chkUseOpenGL->setChecked(m_config->getUseOpenGLCanvas());
 
     // add the configured curves
     foreach(PlotCurveConfiguration * plotData, m_config->plotCurveConfigs()) {
@@ -168,11 +172,10 @@ bool ScopeGadgetOptionsPage::eventFilter(QObject *obj, QEvent *evt)
 
 void ScopeGadgetOptionsPage::on_mathFunctionComboBox_currentIndexChanged(int currentIndex)
 {
-    if (currentIndex > 0) {
-        options_page->spnMeanSamples->setEnabled(true);
-    } else {
-        options_page->spnMeanSamples->setEnabled(false);
-    }
+    // only the windowed functions take a sample count
+    QString function = options_page->mathFunctionComboBox->itemText(currentIndex);
+
+    options_page->spnMeanSamples->setEnabled(function == "Boxcar average" || function == "Standard deviation");
 }
 
 void ScopeGadgetOptionsPage::on_btnColor_clicked()
@@ -275,6 +278,7 @@ void ScopeGadgetOptionsPage::apply()
     m_config->setMathFunctionType(options_page->mathFunctionComboBox->currentIndex());
     m_config->setDataSize(options_page->spnDataSize->value());
     m_config->setRefreashInterval(options_page->spnRefreshInterval->value());
+    m_config->setUseOpenGLCanvas(options_page->chkUseOpenGL->isChecked());
 
     QList<PlotCurveConfiguration *> plotCurveConfigs;
     for (int iIndex = 0; iIndex < options_page->lstCurves->count(); iIndex++) {
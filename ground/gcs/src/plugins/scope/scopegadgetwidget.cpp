@@ -27,6 +27,7 @@
 
 #include "scopegadgetwidget.h"
 #include "utils/stylehelper.h"
+#include "utils/tracer.h"
 
 #include "extensionsystem/pluginmanager.h"
 #include "uavobjectmanager.h"
@@ -53,12 +54,22 @@
 #include <QAction>
 #include <QClipboard>
 #include <QApplication>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QTextStream>
+#include <QtConcurrentRun>
 
 #include <qwt/src/qwt_legend_label.h>
 #include <qwt/src/qwt_picker_machine.h>
 #include <qwt/src/qwt_plot_canvas.h>
+#include <qwt/src/qwt_plot_directpainter.h>
+#include <qwt/src/qwt_plot_glcanvas.h>
 #include <qwt/src/qwt_plot_layout.h>
 
+QSet<ScopeGadgetWidget *> ScopeGadgetWidget::widgetRegistry;
+QMutex ScopeGadgetWidget::widgetRegistryMutex;
+
 ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent),
     m_csvLoggingStarted(false), m_csvLoggingEnabled(false),
     m_csvLoggingHeaderSaved(false), m_csvLoggingDataSaved(false),
@@ -80,14 +91,10 @@ ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent),
     axisWidget(QwtPlot::yLeft)->setMargin(2);
     axisWidget(QwtPlot::xBottom)->setMargin(2);
 
-    m_picker = new QwtPlotPicker(QwtPlot::xBottom,
-                                 QwtPlot::yLeft,
-                                 QwtPlotPicker::HLineRubberBand,
-                                 QwtPicker::ActiveOnly,
-                                 canvas());
-    m_picker->setStateMachine(new QwtPickerDragPointMachine());
-    m_picker->setRubberBandPen(QColor(Qt::darkMagenta));
-    m_picker->setTrackerPen(QColor(Qt::green));
+    setupPicker();
+
+    // paints freshly appended curve segments without a full replot
+    m_directPainter = new QwtPlotDirectPainter(this);
 
     // Setup the timer that replots data
     replotTimer = new QTimer(this);
@@ -106,10 +113,20 @@ ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent),
 
     setContextMenuPolicy(Qt::CustomContextMenu);
     connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(popUpMenu(const QPoint &)));
+
+    {
+        QMutexLocker locker(&widgetRegistryMutex);
+        widgetRegistry.insert(this);
+    }
 }
 
 ScopeGadgetWidget::~ScopeGadgetWidget()
 {
+    {
+        QMutexLocker locker(&widgetRegistryMutex);
+        widgetRegistry.remove(this);
+    }
+
     if (m_picker) {
         delete m_picker;
         m_picker = NULL;
@@ -133,6 +150,67 @@ ScopeGadgetWidget::~ScopeGadgetWidget()
     clearCurvePlots();
 }
 
+quint64 ScopeGadgetWidget::totalHistoryBytes()
+{
+    QMutexLocker locker(&widgetRegistryMutex);
+    quint64 total = 0;
+
+    foreach(ScopeGadgetWidget * widget, widgetRegistry) {
+        foreach(PlotData * plotData, widget->m_curvesData) {
+            total += plotData->memoryBytes();
+        }
+    }
+    return total;
+}
+
+/*!
+   \brief Creates the plot picker on the current canvas.
+
+   The picker is a child of the canvas, so it has to be recreated whenever
+   the canvas is replaced.
+ */
+void ScopeGadgetWidget::setupPicker()
+{
+    m_picker = new QwtPlotPicker(QwtPlot::xBottom,
+                                 QwtPlot::yLeft,
+                                 QwtPlotPicker::HLineRubberBand,
+                                 QwtPicker::ActiveOnly,
+                                 canvas());
+    m_picker->setStateMachine(new QwtPickerDragPointMachine());
+    m_picker->setRubberBandPen(QColor(Qt::darkMagenta));
+    m_picker->setTrackerPen(QColor(Qt::green));
+}
+
+/*!
+   \brief Switches between the OpenGL and the default raster plot canvas.
+
+   With the OpenGL canvas the curves are rasterized on the GPU, which takes
+   the replot cost of busy scopes off the CPU.
+ */
+void ScopeGadgetWidget::setUseOpenGLCanvas(bool enable)
+{
+    bool usingOpenGL = (dynamic_cast<QwtPlotGLCanvas *>(canvas()) != NULL);
+
+    if (enable == usingOpenGL) {
+        return;
+    }
+
+    // setCanvas() deletes the previous canvas and the picker with it,
+    // since the picker is a child of the canvas
+    if (enable) {
+        QwtPlotGLCanvas *glCanvas = new QwtPlotGLCanvas();
+        glCanvas->setFrameStyle(QFrame::StyledPanel | QFrame::Sunken);
+        setCanvas(glCanvas);
+    } else {
+        QwtPlotCanvas *plotCanvas = new QwtPlotCanvas();
+        plotCanvas->setFrameStyle(QFrame::StyledPanel | QFrame::Sunken);
+        plotCanvas->setBorderRadius(8);
+        setCanvas(plotCanvas);
+    }
+
+    setupPicker();
+}
+
 void ScopeGadgetWidget::mousePressEvent(QMouseEvent *e)
 {
     QwtPlot::mousePressEvent(e);
@@ -400,12 +478,16 @@ void ScopeGadgetWidget::addCurvePlot(QString objectName, QString fieldPlusSubFie
     plotData->attach(this);
 
     // Keep the curve details for later
+    m_stagingMutex.lock();
     m_curvesData.insert(plotData->plotName(), plotData);
+    m_stagingMutex.unlock();
 
     // Link to the new signal data only if this UAVObject has not been connected yet
+    // The connection is direct on purpose: the slot runs on the telemetry
+    // thread and only captures the sample, so ingest does not touch the GUI
     if (!m_connectedUAVObjects.contains(object->getName())) {
         m_connectedUAVObjects.append(object->getName());
-        connect(object, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(uavObjectReceived(UAVObject *)));
+        connect(object, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(uavObjectReceived(UAVObject *)), Qt::DirectConnection);
     }
 
     m_mutex.lock();
@@ -413,26 +495,85 @@ void ScopeGadgetWidget::addCurvePlot(QString objectName, QString fieldPlusSubFie
     m_mutex.unlock();
 }
 
+/**
+ * Runs on the thread that updated the object, normally telemetry, not on the
+ * GUI thread. The object data is read through the seqlock snapshot because
+ * objectUpdated() is emitted while the writer still holds the object mutex,
+ * so the locking field accessors must not be used here. The captured samples
+ * are queued and the GUI drains them at the replot interval, decoupling the
+ * telemetry rate from the frame rate.
+ */
 void ScopeGadgetWidget::uavObjectReceived(UAVObject *obj)
 {
+    QDateTime NOW = QDateTime::currentDateTime();
+    double time   = NOW.toTime_t() + NOW.time().msec() / 1000.0;
+
+    QByteArray snapshot(obj->getNumBytes(), 0);
+
+    obj->readDataSnapshot((quint8 *)snapshot.data());
+
+    QMutexLocker locker(&m_stagingMutex);
     foreach(PlotData * plotData, m_curvesData.values()) {
-        if (plotData->append(obj)) {
+        if ((plotData->object() == obj) && plotData->field()) {
+            StagedSample sample;
+            sample.plotName = plotData->plotName();
+            sample.value    = plotData->sampleFromData((const quint8 *)snapshot.constData());
+            sample.time     = time;
+            m_stagedSamples.append(sample);
+        }
+    }
+}
+
+/**
+ * Move the samples captured since the last replot into their curves.
+ * Runs on the GUI thread.
+ */
+void ScopeGadgetWidget::processStagedSamples()
+{
+    QVector<StagedSample> samples;
+
+    m_stagingMutex.lock();
+    samples.swap(m_stagedSamples);
+    m_stagingMutex.unlock();
+
+    foreach(const StagedSample &sample, samples) {
+        PlotData *plotData = m_curvesData.value(sample.plotName, NULL);
+        if (plotData) {
+            plotData->appendSample(sample.value, sample.time);
             m_csvLoggingDataUpdated = 1;
         }
     }
-    csvLoggingAddData();
+    if (!samples.isEmpty()) {
+        csvLoggingAddData();
+    }
 }
 
 void ScopeGadgetWidget::replotNewData()
 {
+    GCS_TRACE_SCOPE("ScopeGadgetWidget::replotNewData");
+
     if (!isVisible()) {
         return;
     }
 
     QMutexLocker locker(&m_mutex);
+
+    processStagedSamples();
+
+    // two points per canvas pixel column is all a curve can show, so long
+    // sessions decimate down to that instead of feeding every raw sample
+    int decimationLimit = qMax(1000, 2 * canvas()->width());
+    // chrono plots move their time axis every refresh, which shifts the
+    // whole canvas; only sequential plots with their fixed axes can get
+    // away with painting just the appended segments. The direct painter
+    // draws to the raster canvas, so the OpenGL one always replots fully.
+    bool appendOnly     = (m_plotType == SequentialPlot) &&
+                          (dynamic_cast<QwtPlotCanvas *>(canvas()) != NULL);
     foreach(PlotData * plotData, m_curvesData.values()) {
         plotData->removeStaleData();
+        plotData->setDecimationLimit(decimationLimit);
         plotData->updatePlotData();
+        appendOnly = appendOnly && plotData->canDrawAppended();
     }
 
     QDateTime NOW = QDateTime::currentDateTime();
@@ -444,16 +585,28 @@ void ScopeGadgetWidget::replotNewData()
 
     csvLoggingInsertData();
 
-    replot();
+    if (appendOnly) {
+        foreach(PlotData * plotData, m_curvesData.values()) {
+            plotData->drawAppended(m_directPainter);
+        }
+    } else {
+        replot();
+        foreach(PlotData * plotData, m_curvesData.values()) {
+            plotData->markDrawn();
+        }
+    }
 }
 
 void ScopeGadgetWidget::clearCurvePlots()
 {
+    QMutexLocker locker(&m_stagingMutex);
+
     foreach(PlotData * plotData, m_curvesData.values()) {
         delete plotData;
     }
 
     m_curvesData.clear();
+    m_stagedSamples.clear();
 }
 
 void ScopeGadgetWidget::saveState(QSettings *qSettings)
@@ -659,6 +812,8 @@ void ScopeGadgetWidget::popUpMenu(const QPoint &mousePosition)
     connect(action, &QAction::triggered, this, &ScopeGadgetWidget::clearPlot);
     action = menu.addAction(tr("Copy to Clipboard"));
     connect(action, &QAction::triggered, this, &ScopeGadgetWidget::copyToClipboardAsImage);
+    action = menu.addAction(tr("Export curve data..."));
+    connect(action, &QAction::triggered, this, &ScopeGadgetWidget::exportCurveDataDialog);
     menu.addSeparator();
     action = menu.addAction(tr("Options..."));
     connect(action, &QAction::triggered, this, &ScopeGadgetWidget::showOptionDialog);
@@ -687,6 +842,90 @@ void ScopeGadgetWidget::copyToClipboardAsImage()
     clipboard->setPixmap(pixmap);
 }
 
+// One curve snapshot handed to the export worker : name plus a full
+// resolution, pre-decimation copy of its ring buffer.
+struct ExportedCurve {
+    QString plotName;
+    QVector<QPointF> samples;
+};
+
+// Runs on the QtConcurrent worker pool. Streams the snapshot to disk :
+// CSV when the file name ends in .csv, otherwise a compact binary record
+// (magic, version, curve count, then per curve the name, sample count and
+// the x/y doubles).
+static void writeExportedCurves(const QString fileName, const QList<ExportedCurve> curves)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Scope export: could not open" << fileName << "for writing";
+        return;
+    }
+
+    if (QFileInfo(fileName).suffix().compare("csv", Qt::CaseInsensitive) == 0) {
+        QTextStream csv(&file);
+        csv << "curve,x,y" << '\n';
+        foreach(const ExportedCurve &curve, curves) {
+            foreach(const QPointF &sample, curve.samples) {
+                csv << curve.plotName << ',' << QString::number(sample.x(), 'g', 10)
+                    << ',' << QString::number(sample.y(), 'g', 10) << '\n';
+            }
+        }
+    } else {
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_4_8);
+        out << (quint32)0x53435044; // 'SCPD'
+        out << (quint16)1;
+        out << (quint32)curves.count();
+        foreach(const ExportedCurve &curve, curves) {
+            out << curve.plotName;
+            out << (quint32)curve.samples.count();
+            foreach(const QPointF &sample, curve.samples) {
+                out << sample.x() << sample.y();
+            }
+        }
+    }
+
+    file.close();
+    qDebug() << "Scope export: wrote" << curves.count() << "curve(s) to" << fileName;
+}
+
+void ScopeGadgetWidget::exportCurveData(const QString &fileName)
+{
+    // Snapshot the buffers on the GUI thread, then hand the copies to the
+    // worker pool : plotting never waits on the disk.
+    QList<ExportedCurve> curves;
+
+    m_mutex.lock();
+    foreach(PlotData * plot, m_curvesData.values()) {
+        if (!plot->hasData()) {
+            continue;
+        }
+        ExportedCurve curve;
+        curve.plotName = plot->plotName();
+        curve.samples  = plot->rawSamples();
+        curves.append(curve);
+    }
+    m_mutex.unlock();
+
+    if (curves.isEmpty()) {
+        qDebug() << "Scope export: no curve data to export";
+        return;
+    }
+
+    QtConcurrent::run(writeExportedCurves, fileName, curves);
+}
+
+void ScopeGadgetWidget::exportCurveDataDialog()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export curve data"), QString(),
+                                                    tr("CSV file (*.csv);;Scope data (*.scd)"));
+
+    if (!fileName.isEmpty()) {
+        exportCurveData(fileName);
+    }
+}
+
 void ScopeGadgetWidget::showOptionDialog()
 {
     Core::ICore::instance()->showOptionsDialog("ScopeGadget", objectName());
@@ -38,9 +38,13 @@
 #include "qwt/src/qwt_scale_widget.h"
 #include "qwt/src/qwt_plot_picker.h"
 
+class QwtPlotDirectPainter;
+
 #include <QTimer>
 #include <QTime>
+#include <QVariant>
 #include <QVector>
+#include <QSet>
 #include <QMutex>
 
 class QSettings;
@@ -95,6 +99,12 @@ public:
         return m_refreshInterval;
     }
 
+    void setUseOpenGLCanvas(bool enable);
+
+    // Bytes held in the curve history buffers of every live scope widget,
+    // polled by the memory diagnostics service.
+    static quint64 totalHistoryBytes();
+
 
     void addCurvePlot(QString uavObject, QString uavFieldSubField, int scaleOrderFactor = 0, int meanSamples = 1,
                       QString mathFunction = "None", QPen pen = QPen(Qt::black), bool antialiased = true);
@@ -107,6 +117,11 @@ public:
     int csvLoggingStop();
     void csvLoggingSetName(QString);
 
+    // ! Stream the full resolution curve buffers to fileName (CSV or compact
+    // ! binary by extension) on the worker pool; the snapshot is taken
+    // ! synchronously so plotting continues while the file is written
+    void exportCurveData(const QString &fileName);
+
     void setLoggingEnabled(bool value)
     {
         m_csvLoggingEnabled = value;
@@ -141,19 +156,40 @@ private slots:
     void popUpMenu(const QPoint &mousePosition);
     void clearPlot();
     void copyToClipboardAsImage();
+    void exportCurveDataDialog();
     void showOptionDialog();
 
 private:
     void preparePlot(PlotType plotType);
     void setupExamplePlot();
+    void setupPicker();
+
+    // ! One sample captured on the telemetry thread, waiting to be drained by the GUI
+    struct StagedSample {
+        QString  plotName;
+        QVariant value;
+        double   time;
+    };
 
     PlotType m_plotType;
 
+    // live widget registry backing totalHistoryBytes()
+    static QSet<ScopeGadgetWidget *> widgetRegistry;
+    static QMutex widgetRegistryMutex;
+
     double m_plotDataSize;
     int m_refreshInterval;
     QList<QString> m_connectedUAVObjects;
     QMap<QString, PlotData *> m_curvesData;
 
+    // draws newly appended curve segments in place between full replots
+    QwtPlotDirectPainter *m_directPainter;
+
+    // filled by uavObjectReceived() on the emitting (telemetry) thread,
+    // swapped out by processStagedSamples() at the replot interval
+    QVector<StagedSample> m_stagedSamples;
+    QMutex m_stagingMutex;
+
     QTimer *replotTimer;
 
     bool m_csvLoggingStarted;
@@ -177,6 +213,8 @@ private:
     QwtLegend *m_plotLegend;
     QwtPlotPicker *m_picker;
 
+    void processStagedSamples();
+
     int csvLoggingInsertHeader();
     int csvLoggingAddData();
     int csvLoggingInsertData();
@@ -27,6 +27,8 @@
 
 #include "scopeplugin.h"
 #include "scopegadgetfactory.h"
+#include "scopegadgetwidget.h"
+#include <coreplugin/memorydiagnostics.h>
 #include <QDebug>
 #include <QtPlugin>
 #include <QStringList>
@@ -51,6 +53,15 @@ bool ScopePlugin::initialize(const QStringList & args, QString *errMsg)
     m_scopeFactory = new ScopeGadgetFactory(this);
     addAutoReleasedObject(m_scopeFactory);
 
+    // attribute the curve history buffers in the memory report
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    Core::MemoryDiagnostics *memoryDiagnostics = pm->getObject<Core::MemoryDiagnostics>();
+    if (memoryDiagnostics != NULL) {
+        memoryDiagnostics->registerSource("Scope history buffers", []() {
+            return ScopeGadgetWidget::totalHistoryBytes();
+        });
+    }
+
     return true;
 }
 
@@ -39,12 +39,11 @@ SerialEnumerationThread::SerialEnumerationThread(SerialConnection *serial)
 void SerialEnumerationThread::run()
 {
     m_running = true;
-    QList <Core::IConnection::device> devices = m_serial->availableDevices();
     while (m_running) {
         if (!m_serial->deviceOpened()) {
-            QList <Core::IConnection::device> newDev = m_serial->availableDevices();
-            if (devices != newDev) {
-                devices = newDev;
+            // the scan runs in this thread and only touches the cached list,
+            // the GUI thread reads the cache and never blocks on the OS
+            if (m_serial->refreshDeviceList()) {
                 emit enumerationChanged();
             }
         }
@@ -92,6 +91,9 @@ SerialConnection::SerialConnection() :
     // Other OSes do not send such signals:
     QObject::connect(&m_enumerateThread, SIGNAL(enumerationChanged()),
                      this, SLOT(onEnumerationChanged()));
+    // populate the cache before the first availableDevices() call, later
+    // scans happen in the enumeration thread
+    refreshDeviceList();
     m_enumerateThread.start();
 // #endif
 }
@@ -130,7 +132,7 @@ QList<QSerialPortInfo> SerialConnection::availablePorts()
 }
 
 
-QList <Core::IConnection::device> SerialConnection::availableDevices()
+QList <Core::IConnection::device> SerialConnection::enumerateDevices()
 {
     QList <Core::IConnection::device> list;
 
@@ -151,6 +153,25 @@ QList <Core::IConnection::device> SerialConnection::availableDevices()
     return list;
 }
 
+bool SerialConnection::refreshDeviceList()
+{
+    QList <Core::IConnection::device> list = enumerateDevices();
+
+    QMutexLocker locker(&m_cachedDevicesMutex);
+    if (list == m_cachedDevices) {
+        return false;
+    }
+    m_cachedDevices = list;
+    return true;
+}
+
+QList <Core::IConnection::device> SerialConnection::availableDevices()
+{
+    QMutexLocker locker(&m_cachedDevicesMutex);
+
+    return m_cachedDevices;
+}
+
 QIODevice *SerialConnection::openDevice(const QString &deviceName)
 {
     if (serialHandle) {
@@ -36,6 +36,7 @@
 #include "serialpluginconfiguration.h"
 #include "serialpluginoptionspage.h"
 #include <QThread>
+#include <QMutex>
 
 class IConnection;
 class QSerialPortInfo;
@@ -82,6 +83,11 @@ public:
     virtual QIODevice *openDevice(const QString &deviceName);
     virtual void closeDevice(const QString &deviceName);
 
+    // Scans the ports and updates the cached device list, returns true when
+    // the list changed. Called from the enumeration thread so a slow scan
+    // (e.g. Bluetooth COM ports on Windows) never blocks the GUI thread.
+    bool refreshDeviceList();
+
     virtual QString connectionName();
     virtual QString shortName();
     virtual void suspendPolling();
@@ -108,6 +114,10 @@ private:
     SerialPluginOptionsPage *m_optionspage;
 
     QList<QSerialPortInfo> availablePorts();
+    QList <Core::IConnection::device> enumerateDevices();
+
+    QList <Core::IConnection::device> m_cachedDevices;
+    QMutex m_cachedDevicesMutex;
 
 protected slots:
     void onEnumerationChanged();
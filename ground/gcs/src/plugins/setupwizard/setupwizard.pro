@@ -1,7 +1,7 @@
 TEMPLATE = lib 
 TARGET = SetupWizard 
 
-QT += widgets svg
+QT += widgets svg concurrent
 
 include(../../plugin.pri)
 include(../../plugins/coreplugin/coreplugin.pri)
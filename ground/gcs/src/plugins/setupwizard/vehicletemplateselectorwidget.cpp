@@ -29,13 +29,84 @@
 #include "ui_vehicletemplateselectorwidget.h"
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QDateTime>
 #include <QDir>
 #include <QDebug>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QtConcurrentRun>
 #include "vehicletemplateexportdialog.h"
 #include "utils/pathutils.h"
 
+namespace {
+// Lightweight per file record cached across dialog openings so the template
+// list can be populated without parsing every template file again.
+struct TemplateIndexEntry {
+    QDateTime lastModified;
+    QString   name;
+    QString   uuid;
+    int       type;
+    int       subtype;
+    bool      valid;
+};
+
+QHash<QString, TemplateIndexEntry> templateIndex;
+
+TemplateIndexEntry indexTemplateFile(const QString &fullPathName)
+{
+    TemplateIndexEntry entry;
+
+    entry.valid = false;
+    QFile file(fullPathName);
+    if (file.open(QFile::ReadOnly)) {
+        QJsonParseError error;
+        QJsonDocument templateDoc = QJsonDocument::fromJson(file.readAll(), &error);
+        if (error.error == QJsonParseError::NoError) {
+            QJsonObject json = templateDoc.object();
+            entry.name    = json["name"].toString();
+            entry.uuid    = json["uuid"].toString();
+            entry.type    = json["type"].toInt();
+            entry.subtype = json["subtype"].toInt();
+            entry.valid   = true;
+        } else {
+            qDebug() << "Error parsing json file: "
+                     << fullPathName << ". Error was:" << error.errorString();
+        }
+    }
+    return entry;
+}
+
+QImage decodeTemplatePhoto(QString base64)
+{
+    QImage image;
+
+    image.loadFromData(QByteArray::fromBase64(base64.toLatin1()), "PNG");
+    return image;
+}
+}
+
+VehicleTemplate::~VehicleTemplate()
+{
+    if (m_templateObject) {
+        delete m_templateObject;
+    }
+}
+
+QJsonObject *VehicleTemplate::templateObject()
+{
+    if (!m_templateObject) {
+        QFile file(m_templatePath);
+        if (file.open(QFile::ReadOnly)) {
+            QJsonParseError error;
+            QJsonDocument templateDoc = QJsonDocument::fromJson(file.readAll(), &error);
+            if (error.error == QJsonParseError::NoError) {
+                m_templateObject = new QJsonObject(templateDoc.object());
+            }
+        }
+    }
+    return m_templateObject;
+}
+
 VehicleTemplateSelectorWidget::VehicleTemplateSelectorWidget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::VehicleTemplateSelectorWidget), m_photoItem(NULL)
@@ -45,6 +116,7 @@ VehicleTemplateSelectorWidget::VehicleTemplateSelectorWidget(QWidget *parent) :
     connect(ui->templateList, SIGNAL(itemSelectionChanged()), this, SLOT(templateSelectionChanged()));
     connect(ui->deleteTemplateButton, SIGNAL(clicked()), this, SLOT(deleteSelectedTemplate()));
     connect(ui->addTemplateButton, SIGNAL(clicked()), this, SLOT(addTemplate()));
+    connect(&m_photoWatcher, SIGNAL(finished()), this, SLOT(photoDecoded()));
 }
 
 VehicleTemplateSelectorWidget::~VehicleTemplateSelectorWidget()
@@ -66,28 +138,33 @@ void VehicleTemplateSelectorWidget::setTemplateInfo(int vehicleType, int vehicle
     updateTemplates();
 }
 
-QJsonObject *VehicleTemplateSelectorWidget::selectedTemplate() const
+VehicleTemplate *VehicleTemplateSelectorWidget::selectedVehicleTemplate() const
 {
     if (ui->templateList->currentRow() >= 0) {
-        return ui->templateList->item(ui->templateList->currentRow())->data(Qt::UserRole + 1).value<QJsonObject *>();
+        return ui->templateList->item(ui->templateList->currentRow())->data(Qt::UserRole + 1).value<VehicleTemplate *>();
     }
     return NULL;
 }
 
+QJsonObject *VehicleTemplateSelectorWidget::selectedTemplate() const
+{
+    VehicleTemplate *templ = selectedVehicleTemplate();
+
+    return templ != NULL ? templ->templateObject() : NULL;
+}
+
 bool VehicleTemplateSelectorWidget::selectedTemplateEditable() const
 {
-    if (ui->templateList->currentRow() >= 0) {
-        return ui->templateList->item(ui->templateList->currentRow())->data(Qt::UserRole + 2).value<bool>();
-    }
-    return false;
+    VehicleTemplate *templ = selectedVehicleTemplate();
+
+    return templ != NULL ? templ->editable() : false;
 }
 
 QString VehicleTemplateSelectorWidget::selectedTemplatePath() const
 {
-    if (ui->templateList->currentRow() >= 0) {
-        return ui->templateList->item(ui->templateList->currentRow())->data(Qt::UserRole + 3).value<QString>();
-    }
-    return "";
+    VehicleTemplate *templ = selectedVehicleTemplate();
+
+    return templ != NULL ? templ->templatePath() : "";
 }
 
 void VehicleTemplateSelectorWidget::updateTemplates()
@@ -102,12 +179,13 @@ void VehicleTemplateSelectorWidget::deleteSelectedTemplate()
         if (QMessageBox::question(this, tr("Delete Vehicle Template"),
                                   "Are you sure you want to delete the selected template?",
                                   QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
-            QFile fileToDelete(selectedTemplatePath());
+            QString path = selectedTemplatePath();
+            QFile fileToDelete(path);
             if (fileToDelete.remove()) {
-                QJsonObject *templObj = selectedTemplate();
-                if (templObj) {
-                    VehicleTemplate *templ = m_templates[templObj->value("uuid").toString()];
-                    m_templates.remove(templObj->value("uuid").toString());
+                templateIndex.remove(path);
+                VehicleTemplate *templ = selectedVehicleTemplate();
+                if (templ) {
+                    m_templates.remove(templ->uuid());
                     delete templ;
                 }
                 delete ui->templateList->item(ui->templateList->currentRow());
@@ -154,16 +232,27 @@ void VehicleTemplateSelectorWidget::addTemplate()
 
 void VehicleTemplateSelectorWidget::updatePhoto(QJsonObject *templ)
 {
-    QPixmap photo;
-
-    if (m_photoItem != NULL) {
-        ui->templateImage->scene()->removeItem(m_photoItem);
-    }
     if (templ != NULL && !templ->value("photo").isUndefined()) {
-        QByteArray imageData = QByteArray::fromBase64(templ->value("photo").toString().toLatin1());
-        photo.loadFromData(imageData, "PNG");
+        // The embedded photos can be large, decode off the gui thread. The
+        // watcher only reports the future set last, so a quickly superseded
+        // selection is simply ignored.
+        m_photoWatcher.setFuture(QtConcurrent::run(decodeTemplatePhoto, templ->value("photo").toString()));
     } else {
+        QPixmap photo;
         photo.load(":/core/images/librepilot_logo_500.png");
+        setPhoto(photo);
+    }
+}
+
+void VehicleTemplateSelectorWidget::photoDecoded()
+{
+    setPhoto(QPixmap::fromImage(m_photoWatcher.result()));
+}
+
+void VehicleTemplateSelectorWidget::setPhoto(QPixmap photo)
+{
+    if (m_photoItem != NULL) {
+        ui->templateImage->scene()->removeItem(m_photoItem);
     }
     m_photoItem = ui->templateImage->scene()->addPixmap(photo);
     ui->templateImage->setSceneRect(ui->templateImage->scene()->itemsBoundingRect());
@@ -252,26 +341,25 @@ void VehicleTemplateSelectorWidget::loadFilesInDir(QString templateBasePath, boo
     QStringList files = templateDir.entryList();
     foreach(QString fileName, files) {
         QString fullPathName = QString("%1/%2").arg(templateDir.absolutePath()).arg(fileName);
-        QFile file(fullPathName);
+        QFileInfo fileInfo(fullPathName);
+
+        // Parse a file only the first time it is seen, afterwards the cached
+        // index entry is reused until the file changes on disk.
+        QHash<QString, TemplateIndexEntry>::const_iterator cached = templateIndex.constFind(fullPathName);
+        TemplateIndexEntry entry;
+        if (cached != templateIndex.constEnd() && cached->lastModified == fileInfo.lastModified()) {
+            entry = *cached;
+        } else {
+            entry = indexTemplateFile(fullPathName);
+            entry.lastModified = fileInfo.lastModified();
+            templateIndex.insert(fullPathName, entry);
+        }
 
-        if (file.open(QFile::ReadOnly)) {
-            QByteArray jsonData = file.readAll();
-            QJsonParseError error;
-            QJsonDocument templateDoc = QJsonDocument::fromJson(jsonData, &error);
-            if (error.error == QJsonParseError::NoError) {
-                QJsonObject json = templateDoc.object();
-                if (airframeIsCompatible(json["type"].toInt(), json["subtype"].toInt())) {
-                    QString uuid = json["uuid"].toString();
-                    if (!m_templates.contains(uuid)) {
-                        m_templates[json["uuid"].toString()] = new VehicleTemplate(new QJsonObject(json), local, fullPathName);
-                    }
-                }
-            } else {
-                qDebug() << "Error parsing json file: "
-                         << fileName << ". Error was:" << error.errorString();
+        if (entry.valid && airframeIsCompatible(entry.type, entry.subtype)) {
+            if (!m_templates.contains(entry.uuid)) {
+                m_templates[entry.uuid] = new VehicleTemplate(fullPathName, local, entry.name, entry.uuid);
             }
         }
-        file.close();
     }
 }
 
@@ -294,31 +382,24 @@ void VehicleTemplateSelectorWidget::setupTemplateList()
     foreach(QString templ, m_templates.keys()) {
         VehicleTemplate *vtemplate = m_templates[templ];
 
-        item = new QListWidgetItem(vtemplate->templateObject()->value("name").toString(), ui->templateList);
-        item->setData(Qt::UserRole + 1, QVariant::fromValue(vtemplate->templateObject()));
-        item->setData(Qt::UserRole + 2, QVariant::fromValue(vtemplate->editable()));
+        item = new QListWidgetItem(vtemplate->name(), ui->templateList);
+        item->setData(Qt::UserRole + 1, QVariant::fromValue(vtemplate));
         if (vtemplate->editable()) {
             item->setData(Qt::ForegroundRole, QVariant::fromValue(QColor(Qt::darkGreen)));
             item->setData(Qt::ToolTipRole, QVariant::fromValue(tr("Local template.")));
         } else {
             item->setData(Qt::ToolTipRole, QVariant::fromValue(tr("Built-in template.")));
         }
-        item->setData(Qt::UserRole + 3, QVariant::fromValue(vtemplate->templatePath()));
     }
     ui->templateList->sortItems(Qt::AscendingOrder);
 
     item = new QListWidgetItem(tr("Current Tuning"));
-    item->setData(Qt::UserRole + 1, QVariant::fromValue((QJsonObject *)NULL));
+    item->setData(Qt::UserRole + 1, QVariant::fromValue((VehicleTemplate *)NULL));
     ui->templateList->insertItem(0, item);
     ui->templateList->setCurrentRow(0);
     // TODO Add generics to top under item Current tuning
 }
 
-QString VehicleTemplateSelectorWidget::getTemplateKey(QJsonObject *templ)
-{
-    return QString(templ->value("name").toString());
-}
-
 void VehicleTemplateSelectorWidget::resizeEvent(QResizeEvent *)
 {
     ui->templateImage->setSceneRect(ui->templateImage->scene()->itemsBoundingRect());
@@ -28,7 +28,9 @@
 #ifndef VEHICLETEMPLATESELECTORWIDGET_H
 #define VEHICLETEMPLATESELECTORWIDGET_H
 
+#include <QFutureWatcher>
 #include <QGraphicsItem>
+#include <QImage>
 #include <QJsonObject>
 #include <QWidget>
 
@@ -38,20 +40,14 @@ class VehicleTemplateSelectorWidget;
 
 class VehicleTemplate {
 public:
-    VehicleTemplate(QJsonObject *templateObject, bool editable, QString templatePath) :
-        m_templateObject(templateObject), m_editable(editable), m_templatePath(templatePath) {}
+    VehicleTemplate(QString templatePath, bool editable, QString name, QString uuid) :
+        m_templatePath(templatePath), m_editable(editable), m_name(name), m_uuid(uuid),
+        m_templateObject(NULL) {}
 
-    ~VehicleTemplate()
-    {
-        if (m_templateObject) {
-            delete m_templateObject;
-        }
-    }
+    ~VehicleTemplate();
 
-    QJsonObject *templateObject()
-    {
-        return m_templateObject;
-    }
+    // Parses the template file on first access.
+    QJsonObject *templateObject();
 
     bool editable()
     {
@@ -63,10 +59,22 @@ public:
         return m_templatePath;
     }
 
+    QString name()
+    {
+        return m_name;
+    }
+
+    QString uuid()
+    {
+        return m_uuid;
+    }
+
 private:
-    QJsonObject *m_templateObject;
-    bool m_editable;
     QString m_templatePath;
+    bool m_editable;
+    QString m_name;
+    QString m_uuid;
+    QJsonObject *m_templateObject;
 };
 
 class VehicleTemplateSelectorWidget : public QWidget {
@@ -91,12 +99,14 @@ private:
 
     QMap<QString, VehicleTemplate *> m_templates;
     QGraphicsPixmapItem *m_photoItem;
+    QFutureWatcher<QImage> m_photoWatcher;
 
     void loadValidFiles();
     void loadFilesInDir(QString templateBasePath, bool local);
     void setupTemplateList();
-    QString getTemplateKey(QJsonObject *templ);
+    VehicleTemplate *selectedVehicleTemplate() const;
     void updatePhoto(QJsonObject *templ);
+    void setPhoto(QPixmap photo);
     void updateDescription(QJsonObject *templ);
     bool airframeIsCompatible(int vehicleType, int vehicleSubType);
     QString getTemplatePath();
@@ -107,8 +117,10 @@ private slots:
     void updateTemplates();
     void deleteSelectedTemplate();
     void addTemplate();
+    void photoDecoded();
 };
 
 Q_DECLARE_METATYPE(QJsonObject *)
+Q_DECLARE_METATYPE(VehicleTemplate *)
 
 #endif // VEHICLETEMPLATESELECTORWIDGET_H
@@ -30,6 +30,7 @@
 #include <QJsonDocument>
 #include <QMessageBox>
 #include <QDateTime>
+#include <QDebug>
 #include <QTcpServer>
 #include <QTcpSocket>
 
@@ -37,6 +38,12 @@
 #include "../uavobjects/uavobjectmanager.h"
 #include "../uavobjects/uavdataobject.h"
 
+/* How often queued updates are flushed to the clients */
+static const int FLUSH_INTERVAL_MS = 50;
+/* Stop writing to a client whose kernel buffer backed up beyond this,
+ * its queue keeps coalescing until the buffer drains */
+static const qint64 MAX_CLIENT_BACKLOG = 256 * 1024;
+
 StreamServicePlugin::StreamServicePlugin() :
     port(7891),
     isSubscribed(false) {}
@@ -47,7 +54,7 @@ StreamServicePlugin::~StreamServicePlugin()
         return;
     }
     if (pServer->isListening()) {
-        foreach(QTcpSocket * client, activeClients) {
+        foreach(QTcpSocket * client, activeClients.keys()) {
             /* Disconnect the client discarding pending
              * bytes */
             if (client->isOpen()) {
@@ -72,6 +79,9 @@ bool StreamServicePlugin::initialize(const QStringList &arguments, QString *erro
 
     connect(pServer, &QTcpServer::newConnection, this, &StreamServicePlugin::clientConnected);
 
+    flushTimer.setInterval(FLUSH_INTERVAL_MS);
+    connect(&flushTimer, &QTimer::timeout, this, &StreamServicePlugin::flushClients);
+
     return true;
 }
 
@@ -90,13 +100,17 @@ void StreamServicePlugin::shutdown()
         pServer->pauseAccepting();
     }
 
-    foreach(QTcpSocket * pClient, activeClients) {
+    foreach(QTcpSocket * pClient, activeClients.keys()) {
         pClient->disconnectFromHost();
     }
 }
 
 void StreamServicePlugin::objectUpdated(UAVObject *pObj)
 {
+    if (activeClients.isEmpty()) {
+        return;
+    }
+
     QJsonObject qtjson;
 
     pObj->toJson(qtjson);
@@ -105,14 +119,38 @@ void StreamServicePlugin::objectUpdated(UAVObject *pObj)
     qtjson.insert("gcs_timestamp_ms", QJsonValue(QDateTime::currentMSecsSinceEpoch()));
 
     QJsonDocument jsonDoc(qtjson);
-    QString strJson = QString(jsonDoc.toJson(QJsonDocument::Compact)) + "\n";
+    QByteArray line = jsonDoc.toJson(QJsonDocument::Compact) + "\n";
+
+    quint64 key     = ((quint64)pObj->getObjID() << 32) | pObj->getInstID();
+    for (QHash<QTcpSocket *, ClientStream>::iterator it = activeClients.begin(); it != activeClients.end(); ++it) {
+        ClientStream &stream = it.value();
+        if (stream.pendingUpdates.contains(key)) {
+            /* The queued value was never sent, the latest one replaces it */
+            stream.droppedUpdates++;
+        }
+        stream.pendingUpdates.insert(key, line);
+    }
+}
 
-    foreach(QTcpSocket * pClient, activeClients) {
-        if (pClient->isOpen()) {
-            if (pClient->write(strJson.toUtf8().constData(), strJson.length())) {
-                pClient->flush();
-            }
+void StreamServicePlugin::flushClients()
+{
+    for (QHash<QTcpSocket *, ClientStream>::iterator it = activeClients.begin(); it != activeClients.end(); ++it) {
+        QTcpSocket *pClient  = it.key();
+        ClientStream &stream = it.value();
+
+        if (stream.pendingUpdates.isEmpty() || !pClient->isOpen()) {
+            continue;
+        }
+        if (pClient->bytesToWrite() > MAX_CLIENT_BACKLOG) {
+            /* Slow consumer, keep coalescing in the queue rather than
+             * buffering without bound */
+            continue;
         }
+        foreach(const QByteArray &pending, stream.pendingUpdates) {
+            pClient->write(pending);
+        }
+        stream.pendingUpdates.clear();
+        pClient->flush();
     }
 }
 
@@ -126,13 +164,23 @@ void StreamServicePlugin::clientConnected()
     makeSureIsSubscribed();
 
     connect(pending, &QTcpSocket::disconnected, this, &StreamServicePlugin::clientDisconnected);
-    activeClients.append(pending);
+    activeClients.insert(pending, ClientStream());
+    if (!flushTimer.isActive()) {
+        flushTimer.start();
+    }
 }
 
 void StreamServicePlugin::clientDisconnected()
 {
     disconnect(sender());
-    activeClients.removeAll((QTcpSocket *)sender());
+    ClientStream stream = activeClients.take((QTcpSocket *)sender());
+    if (stream.droppedUpdates > 0) {
+        qDebug() << "StreamService: client disconnected," << stream.droppedUpdates
+                 << "updates were superseded in its queue before transmission";
+    }
+    if (activeClients.isEmpty()) {
+        flushTimer.stop();
+    }
 }
 
 inline void StreamServicePlugin::makeSureIsSubscribed()
@@ -31,6 +31,8 @@
 #include "../uavobjects/uavobject.h"
 
 #include <QtPlugin>
+#include <QHash>
+#include <QTimer>
 
 class QTcpServer;
 class QTcpSocket;
@@ -53,12 +55,22 @@ public slots:
 private slots:
     void clientConnected();
     void clientDisconnected();
+    void flushClients();
 
 private:
+    /* Per client send queue, the latest value wins for each object
+     * instance while the client catches up */
+    struct ClientStream {
+        ClientStream() : droppedUpdates(0) {}
+        QHash<quint64, QByteArray> pendingUpdates;
+        quint32 droppedUpdates;
+    };
+
     quint16 port;
 
     QTcpServer *pServer;
-    QList<QTcpSocket *> activeClients;
+    QHash<QTcpSocket *, ClientStream> activeClients;
+    QTimer flushTimer;
     bool isSubscribed;
 
     inline void makeSureIsSubscribed();
@@ -52,9 +52,15 @@ SystemHealthGadgetWidget::SystemHealthGadgetWidget(QWidget *parent) : QGraphicsV
     nolink     = new QGraphicsSvgItem();
     logreplay  = new QGraphicsSvgItem();
     logreplay2 = new QGraphicsSvgItem();
-    missingElements = new QStringList();
+    missingElements    = new QStringList();
+    pendingAlarmObject = NULL;
     paint();
 
+    // coalesce bursts of alarm updates into one scene pass
+    alarmRefreshTimer = new QTimer(this);
+    alarmRefreshTimer->setSingleShot(true);
+    connect(alarmRefreshTimer, SIGNAL(timeout()), this, SLOT(refreshAlarms()));
+
     // Now connect the widget to the SystemAlarms UAVObject
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
@@ -122,58 +128,90 @@ void SystemHealthGadgetWidget::onAutopilotDisconnect()
 
 void SystemHealthGadgetWidget::updateAlarms(UAVObject *systemAlarm)
 {
-    // This code does not know anything about alarms beforehand, and
-    // I found no efficient way to locate items inside the scene by
-    // name, so it's just as simple to reset the scene:
-    // And add the one with the right name.
-    QGraphicsScene *m_scene = scene();
+    // only remember the latest state here, the scene is touched once per
+    // refresh period however often SystemAlarms updates
+    pendingAlarmObject = systemAlarm;
+    if (!alarmRefreshTimer->isActive()) {
+        alarmRefreshTimer->start(ALARM_REFRESH_PERIOD_MS);
+    }
+}
 
-    foreach(QGraphicsItem * item, background->childItems()) {
-        m_scene->removeItem(item);
-        delete item; // removeItem does _not_ delete the item.
+void SystemHealthGadgetWidget::refreshAlarms()
+{
+    if (pendingAlarmObject) {
+        applyAlarms(pendingAlarmObject);
     }
+}
 
+void SystemHealthGadgetWidget::applyAlarms(UAVObject *systemAlarm)
+{
     QMatrix backgroundMatrix = (m_renderer->matrixForElement(background->elementId())).inverted();
 
-    QString alarm = systemAlarm->getName();
     foreach(UAVObjectField * field, systemAlarm->getFields()) {
         for (uint i = 0; i < field->getNumElements(); ++i) {
             QString element = field->getElementNames()[i];
             QString value   = field->getValue(i).toString();
-            if (!missingElements->contains(element)) {
-                if (m_renderer->elementExists(element)) {
-                    QString element2 = element + "-" + value;
-                    if (!missingElements->contains(element2)) {
-                        if (m_renderer->elementExists(element2)) {
-                            // element2 is in global coordinates
-                            // transform its matrix into the coordinates of background
-                            QMatrix blockMatrix   = backgroundMatrix * m_renderer->matrixForElement(element2);
-                            // use this composed projection to get the position in background coordinates
-                            QRectF rectProjected  = blockMatrix.mapRect(m_renderer->boundsOnElement(element2));
-
-                            QGraphicsSvgItem *ind = new QGraphicsSvgItem();
-                            ind->setSharedRenderer(m_renderer);
-                            ind->setElementId(element2);
-                            ind->setParentItem(background);
-                            QTransform matrix;
-                            matrix.translate(rectProjected.x(), rectProjected.y());
-                            ind->setTransform(matrix, false);
-                        } else {
-                            if (value.compare("Uninitialised") != 0) {
-                                missingElements->append(element2);
-                                qDebug() << "Warning: element " << element2 << " not found in SVG.";
-                            }
-                        }
-                    }
-                } else {
-                    missingElements->append(element);
-                    qDebug() << "Warning: Element " << element << " not found in SVG.";
+            if (alarmValues.value(element) == value) {
+                // indicator already shows this value
+                continue;
+            }
+            if (missingElements->contains(element)) {
+                continue;
+            }
+            if (!m_renderer->elementExists(element)) {
+                missingElements->append(element);
+                qDebug() << "Warning: Element " << element << " not found in SVG.";
+                continue;
+            }
+            QString element2 = element + "-" + value;
+            if (!m_renderer->elementExists(element2)) {
+                if (!missingElements->contains(element2) && (value.compare("Uninitialised") != 0)) {
+                    missingElements->append(element2);
+                    qDebug() << "Warning: element " << element2 << " not found in SVG.";
                 }
+                // keep whatever the indicator showed before
+                continue;
+            }
+            alarmValues.insert(element, value);
+
+            // element2 is in global coordinates
+            // transform its matrix into the coordinates of background
+            QMatrix blockMatrix  = backgroundMatrix * m_renderer->matrixForElement(element2);
+            // use this composed projection to get the position in background coordinates
+            QRectF rectProjected = blockMatrix.mapRect(m_renderer->boundsOnElement(element2));
+
+            QGraphicsSvgItem *ind = alarmItems.value(element);
+            if (!ind) {
+                ind = new QGraphicsSvgItem();
+                ind->setSharedRenderer(m_renderer);
+                ind->setParentItem(background);
+                // each indicator renders to its own cached pixmap, so a
+                // change recomposites only that layer
+                ind->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+                alarmItems.insert(element, ind);
             }
+            // retargeting the element id invalidates just this item
+            ind->setElementId(element2);
+            QTransform matrix;
+            matrix.translate(rectProjected.x(), rectProjected.y());
+            ind->setTransform(matrix, false);
         }
     }
 }
 
+void SystemHealthGadgetWidget::clearAlarms()
+{
+    QGraphicsScene *m_scene = scene();
+
+    foreach(QGraphicsSvgItem * item, alarmItems) {
+        m_scene->removeItem(item);
+        delete item; // removeItem does _not_ delete the item.
+    }
+    alarmItems.clear();
+    alarmValues.clear();
+    pendingAlarmObject = NULL;
+}
+
 SystemHealthGadgetWidget::~SystemHealthGadgetWidget()
 {
     // Do nothing
@@ -184,6 +222,8 @@ void SystemHealthGadgetWidget::setSystemFile(QString dfn)
 {
     // Clear the list of elements not found on svg
     missingElements->clear();
+    // cached indicators refer to elements of the previous file
+    clearAlarms();
     setBackgroundBrush(QBrush(Utils::StyleHelper::baseColor()));
     if (QFile::exists(dfn)) {
         m_renderer->load(dfn);
@@ -225,7 +265,7 @@ void SystemHealthGadgetWidget::setSystemFile(QString dfn)
             if (telMngr->isConnected()) {
                 onAutopilotConnect();
                 SystemAlarms *obj = dynamic_cast<SystemAlarms *>(objManager->getObject(QString("SystemAlarms")));
-                updateAlarms(obj);
+                applyAlarms(obj);
             }
         }
     } else { qDebug() << "SystemHealthGadget: no file"; }
@@ -37,6 +37,7 @@
 #include <QMouseEvent>
 
 #include <QFile>
+#include <QMap>
 #include <QTimer>
 
 class SystemHealthGadgetWidget : public QGraphicsView {
@@ -56,11 +57,16 @@ protected:
 
 private slots:
     void updateAlarms(UAVObject *systemAlarm); // Called by the systemalarms UAVObject
+    void refreshAlarms();
     void onAutopilotConnect();
     void onAutopilotDisconnect();
     void onTelemetryUpdated(double txRate, double rxRate);
 
 private:
+    // SystemAlarms can update continuously; changes arriving within this
+    // window are coalesced into a single scene pass.
+    static const int ALARM_REFRESH_PERIOD_MS = 200;
+
     QSvgRenderer *m_renderer;
     QGraphicsSvgItem *background;
     QGraphicsSvgItem *foreground;
@@ -73,6 +79,15 @@ private:
     bool boardConnected;
     int logreplayDelay;
 
+    // one cached indicator item per alarm element, keyed by element name,
+    // with the value it currently displays
+    QMap<QString, QGraphicsSvgItem *> alarmItems;
+    QMap<QString, QString> alarmValues;
+    UAVObject *pendingAlarmObject;
+    QTimer *alarmRefreshTimer;
+
+    void applyAlarms(UAVObject *systemAlarm);
+    void clearAlarms();
     void showAlarmDescriptionForItemId(const QString itemId, const QPoint & location);
     void showAllAlarmDescriptions(const QPoint &location);
 };
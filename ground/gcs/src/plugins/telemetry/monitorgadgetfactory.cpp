@@ -59,7 +59,9 @@ MonitorWidget *MonitorGadgetFactory::createMonitorWidget(QWidget *parent)
 
     connect(tm, SIGNAL(connected()), widget, SLOT(telemetryConnected()));
     connect(tm, SIGNAL(disconnected()), widget, SLOT(telemetryDisconnected()));
-    connect(tm, SIGNAL(telemetryUpdated(double, double)), widget, SLOT(telemetryUpdated(double, double)));
+    // the widget polls the rates from its refresh timer, no need to route
+    // every stats update through a signal
+    widget->setTelemetryManager(tm);
 
     // and connect widget to connection manager (for retro compatibility)
     Core::ConnectionManager *cm = Core::ICore::instance()->connectionManager();
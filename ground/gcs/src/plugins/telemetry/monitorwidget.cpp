@@ -1,6 +1,7 @@
 #include "monitorwidget.h"
 
 #include <utils/stylehelper.h>
+#include <uavtalk/telemetrymanager.h>
 
 #include <QObject>
 #include <QDebug>
@@ -175,11 +176,30 @@ MonitorWidget::MonitorWidget(QWidget *parent) :
     }
 
     connected = false;
+    telemetryManager = NULL;
+    pendingTxRate    = 0.0;
+    pendingRxRate    = 0.0;
+    dirty            = true;
+    lastTxNodeCount  = -1;
+    lastRxNodeCount  = -1;
+    // sentinels so the first applyRates() pass initializes the text items
+    lastTxText = QString("?");
+    lastRxText = QString("?");
 
     setMin(0.0);
     setMax(1200.0);
 
-    telemetryUpdated(0.0, 0.0);
+    // batch rate updates and touch the scene at a fixed modest rate
+    refreshTimer = new QTimer(this);
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+    refreshTimer->start(REFRESH_PERIOD_MS);
+
+    refresh();
+}
+
+void MonitorWidget::setTelemetryManager(TelemetryManager *telemetryManager)
+{
+    this->telemetryManager = telemetryManager;
 }
 
 MonitorWidget::~MonitorWidget()
@@ -202,10 +222,10 @@ void MonitorWidget::telemetryConnected()
 {
     qDebug() << "telemetry connected";
     if (!connected) {
+        connected = true;
         // flash the lights
         setToolTip(tr("Connected"));
-        telemetryUpdated(maxValue, maxValue);
-        connected = true;
+        applyRates(maxValue, maxValue);
     }
 }
 
@@ -217,62 +237,121 @@ void MonitorWidget::telemetryDisconnected()
 
         setToolTip(tr("Disconnected"));
 
-        // flash the lights???
-        telemetryUpdated(maxValue, maxValue);
-
-        telemetryUpdated(0.0, 0.0);
+        applyRates(0.0, 0.0);
     }
 }
 
 /*!
-   \brief Called by the UAVObject which got updated
+   \brief Records new telemetry rates.
 
-   Updates the numeric value and/or the icon if the dial wants this.
+   Cheap on purpose : the rates are stored and the scene is only touched
+   by the next refresh() tick.
  */
 void MonitorWidget::telemetryUpdated(double txRate, double rxRate)
+{
+    pendingTxRate = txRate;
+    pendingRxRate = rxRate;
+    dirty = true;
+}
+
+/*!
+   \brief Periodically applies the latest rates to the scene.
+ */
+void MonitorWidget::refresh()
+{
+    if (telemetryManager && connected) {
+        // poll the latest rates, no signal traffic involved
+        telemetryUpdated(telemetryManager->txDataRate(), telemetryManager->rxDataRate());
+    }
+    if (!dirty) {
+        return;
+    }
+    dirty = false;
+    applyRates(pendingTxRate, pendingRxRate);
+}
+
+/*!
+   \brief Updates the nodes and numeric values, touching only the
+   elements that actually changed.
+ */
+void MonitorWidget::applyRates(double txRate, double rxRate)
 {
     double txIndex = (txRate - minValue) / (maxValue - minValue) * txNodes.count();
     double rxIndex = (rxRate - minValue) / (maxValue - minValue) * rxNodes.count();
 
+    bool changed   = false;
+
     if (connected) {
         this->setToolTip(QString("Tx: %0 bytes/s, Rx: %1 bytes/s").arg(txRate).arg(rxRate));
     }
 
+    int txNodeCount = 0;
     for (int i = 0; i < txNodes.count(); i++) {
-        QGraphicsItem *node = txNodes.at(i);
-        bool visible = ( /*connected &&*/ (i < txIndex));
-        if (visible != node->isVisible()) {
-            node->setVisible(visible);
-            node->update();
+        if (i < txIndex) {
+            ++txNodeCount;
+        }
+    }
+    if (txNodeCount != lastTxNodeCount) {
+        lastTxNodeCount = txNodeCount;
+        for (int i = 0; i < txNodes.count(); i++) {
+            QGraphicsItem *node = txNodes.at(i);
+            bool visible = (i < txNodeCount);
+            if (visible != node->isVisible()) {
+                node->setVisible(visible);
+                node->update();
+                changed = true;
+            }
         }
     }
 
+    int rxNodeCount = 0;
     for (int i = 0; i < rxNodes.count(); i++) {
-        QGraphicsItem *node = rxNodes.at(i);
-        bool visible = ( /*connected &&*/ (i < rxIndex));
-        if (visible != node->isVisible()) {
-            node->setVisible(visible);
-            node->update();
+        if (i < rxIndex) {
+            ++rxNodeCount;
+        }
+    }
+    if (rxNodeCount != lastRxNodeCount) {
+        lastRxNodeCount = rxNodeCount;
+        for (int i = 0; i < rxNodes.count(); i++) {
+            QGraphicsItem *node = rxNodes.at(i);
+            bool visible = (i < rxNodeCount);
+            if (visible != node->isVisible()) {
+                node->setVisible(visible);
+                node->update();
+                changed = true;
+            }
         }
     }
 
     if (txSpeed) {
-        if (connected) {
-            txSpeed->setPlainText(QString("%0").arg(txRate));
+        QString text = connected ? QString("%0").arg(txRate) : QString();
+        if (text != lastTxText) {
+            lastTxText = text;
+            if (connected) {
+                txSpeed->setPlainText(text);
+            }
+            txSpeed->setVisible(connected);
+            txSpeed->update();
+            changed = true;
         }
-        txSpeed->setVisible(connected);
-        txSpeed->update();
     }
 
     if (rxSpeed) {
-        if (connected) {
-            rxSpeed->setPlainText(QString("%0").arg(rxRate));
+        QString text = connected ? QString("%0").arg(rxRate) : QString();
+        if (text != lastRxText) {
+            lastRxText = text;
+            if (connected) {
+                rxSpeed->setPlainText(text);
+            }
+            rxSpeed->setVisible(connected);
+            rxSpeed->update();
+            changed = true;
         }
-        rxSpeed->setVisible(connected);
-        rxSpeed->update();
     }
 
-    update();
+    if (changed) {
+        update();
+    }
 }
 
 void MonitorWidget::showEvent(QShowEvent *event)
@@ -7,6 +7,9 @@
 #include <QtSvg/QSvgRenderer>
 #include <QtSvg/QGraphicsSvgItem>
 #include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+class TelemetryManager;
 
 class MonitorWidget : public QGraphicsView {
     Q_OBJECT
@@ -14,6 +17,10 @@ public:
     explicit MonitorWidget(QWidget *parent = 0);
     ~MonitorWidget();
 
+    // When set, the widget polls the manager for rates from its refresh
+    // timer instead of being driven by per-update signals.
+    void setTelemetryManager(TelemetryManager *telemetryManager);
+
     void setMin(double min)
     {
         minValue = min;
@@ -43,12 +50,35 @@ protected:
     void showEvent(QShowEvent *event);
     void resizeEvent(QResizeEvent *event);
 
+private slots:
+    void refresh();
+
 private:
+    // The widget is decorative : updating it a couple of times a second is
+    // plenty and keeps it out of the way during high rate telemetry.
+    static const int REFRESH_PERIOD_MS = 500;
+
     bool connected;
 
     double minValue;
     double maxValue;
 
+    TelemetryManager *telemetryManager;
+    QTimer *refreshTimer;
+
+    // latest rates waiting to be applied, see refresh()
+    double pendingTxRate;
+    double pendingRxRate;
+    bool dirty;
+
+    // what the scene currently shows, used to skip untouched elements
+    int lastTxNodeCount;
+    int lastRxNodeCount;
+    QString lastTxText;
+    QString lastRxText;
+
+    void applyRates(double txRate, double rxRate);
+
     QGraphicsSvgItem *graph;
 
     QPointer<QGraphicsTextItem> txSpeed;
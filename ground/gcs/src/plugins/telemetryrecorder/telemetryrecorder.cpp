@@ -0,0 +1,210 @@
+/**
+ ******************************************************************************
+ *
+ * @file       telemetryrecorder.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2017.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup TelemetryRecorderPlugin Plugin
+ * @{
+ * @brief In-memory time-series recorder for telemetry objects
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "telemetryrecorder.h"
+
+#include "uavobjects/uavdataobject.h"
+
+#include <QDateTime>
+#include <QDebug>
+
+TelemetryRecorder::TelemetryRecorder(UAVObjectManager *objMngr) :
+    m_objMngr(objMngr), m_bytesUsed(0), m_skippedInstances(0)
+{
+    // record objects registered later (including instances cloned when a
+    // multi instance object grows)
+    connect(m_objMngr, SIGNAL(newObject(UAVObject *)), this, SLOT(onNewObject(UAVObject *)));
+    connect(m_objMngr, SIGNAL(newInstance(UAVObject *)), this, SLOT(onNewInstance(UAVObject *)));
+
+    // and everything that is already there
+    QList< QList<UAVObject *> > objects = m_objMngr->getObjects();
+    for (int n = 0; n < objects.length(); ++n) {
+        foreach(UAVObject * obj, objects[n]) {
+            subscribe(obj);
+        }
+    }
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    QMutexLocker locker(&m_mutex);
+
+    foreach(InstanceRing * ring, m_rings) {
+        delete ring;
+    }
+    m_rings.clear();
+}
+
+void TelemetryRecorder::onNewObject(UAVObject *obj)
+{
+    subscribe(obj);
+}
+
+void TelemetryRecorder::onNewInstance(UAVObject *obj)
+{
+    subscribe(obj);
+}
+
+/**
+ * Start recording an object. Only data objects are recorded, metaobjects
+ * carry no telemetry. The ring itself is allocated on the first update, so
+ * objects that never arrive cost nothing.
+ */
+void TelemetryRecorder::subscribe(UAVObject *obj)
+{
+    if (!obj->isDataObject()) {
+        return;
+    }
+    connect(obj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(onObjectUpdated(UAVObject *)), Qt::UniqueConnection);
+}
+
+void TelemetryRecorder::onObjectUpdated(UAVObject *obj)
+{
+    QMutexLocker locker(&m_mutex);
+    InstanceRing *ring = ringFor(obj);
+
+    if (ring == NULL) {
+        return;
+    }
+    // This slot can run with the object mutex held (objectUpdated is emitted
+    // from unpack), readDataSnapshot only uses the lock-free data version
+    // counter and never blocks on it.
+    obj->readDataSnapshot((quint8 *)ring->data.data() + (ring->head * ring->numBytes));
+    ring->times[ring->head] = QDateTime::currentMSecsSinceEpoch();
+    ring->head = (ring->head + 1) % ring->capacity;
+    if (ring->count < ring->capacity) {
+        ring->count++;
+    }
+}
+
+/**
+ * Find or lazily create the ring of an object instance. Returns NULL when
+ * the global budget does not cover a new ring. Must be called with the
+ * recorder mutex held.
+ */
+TelemetryRecorder::InstanceRing *TelemetryRecorder::ringFor(UAVObject *obj)
+{
+    quint64 key = ringKey(obj->getObjID(), obj->getInstID());
+    InstanceRing *ring = m_rings.value(key, NULL);
+
+    if (ring != NULL) {
+        return ring;
+    }
+    quint32 numBytes = obj->getNumBytes();
+    int capacity     = qMax((quint32)MIN_SAMPLES, PER_INSTANCE_BUDGET / numBytes);
+    qint64 ringBytes = (qint64)capacity * (numBytes + sizeof(qint64));
+    if (m_bytesUsed + ringBytes > TOTAL_BUDGET) {
+        if (m_skippedInstances == 0) {
+            qWarning() << "TelemetryRecorder - memory budget exhausted, not recording" << obj->toStringBrief();
+        }
+        ++m_skippedInstances;
+        return NULL;
+    }
+    ring = new InstanceRing;
+    ring->data.resize(capacity * numBytes);
+    ring->times.resize(capacity);
+    ring->numBytes = numBytes;
+    ring->capacity = capacity;
+    ring->head     = 0;
+    ring->count    = 0;
+    m_bytesUsed   += ringBytes;
+    m_rings.insert(key, ring);
+    return ring;
+}
+
+QList<TelemetryRecorder::Sample> TelemetryRecorder::querySamples(quint32 objId, quint16 instId, const QString &fieldName,
+                                                                 quint32 elementIndex, qint64 startTime, qint64 endTime)
+{
+    QList<Sample> samples;
+
+    UAVObject *obj = m_objMngr->getObject(objId, instId);
+
+    if (obj == NULL) {
+        return samples;
+    }
+    UAVObjectField *field = obj->getField(fieldName);
+    if (field == NULL) {
+        return samples;
+    }
+    if (endTime <= 0) {
+        endTime = QDateTime::currentMSecsSinceEpoch();
+    }
+
+    QMutexLocker locker(&m_mutex);
+    InstanceRing *ring = m_rings.value(ringKey(objId, instId), NULL);
+    if (ring == NULL) {
+        return samples;
+    }
+    int oldest = (ring->head - ring->count + ring->capacity) % ring->capacity;
+    for (int n = 0; n < ring->count; ++n) {
+        int slot    = (oldest + n) % ring->capacity;
+        qint64 time = ring->times.at(slot);
+        if (time < startTime) {
+            continue;
+        }
+        if (time > endTime) {
+            break;
+        }
+        Sample sample;
+        sample.time  = time;
+        sample.value = field->getValueFromData((const quint8 *)ring->data.constData() + (slot * ring->numBytes),
+                                               elementIndex).toDouble();
+        samples.append(sample);
+    }
+    return samples;
+}
+
+int TelemetryRecorder::sampleCount(quint32 objId, quint16 instId)
+{
+    QMutexLocker locker(&m_mutex);
+    InstanceRing *ring = m_rings.value(ringKey(objId, instId), NULL);
+
+    return (ring != NULL) ? ring->count : 0;
+}
+
+qint64 TelemetryRecorder::oldestSampleTime(quint32 objId, quint16 instId)
+{
+    QMutexLocker locker(&m_mutex);
+    InstanceRing *ring = m_rings.value(ringKey(objId, instId), NULL);
+
+    if ((ring == NULL) || (ring->count == 0)) {
+        return -1;
+    }
+    int oldest = (ring->head - ring->count + ring->capacity) % ring->capacity;
+    return ring->times.at(oldest);
+}
+
+qint64 TelemetryRecorder::memoryUsed()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_bytesUsed;
+}
+
+quint64 TelemetryRecorder::ringKey(quint32 objId, quint16 instId)
+{
+    return (quint64)objId << 32 | instId;
+}
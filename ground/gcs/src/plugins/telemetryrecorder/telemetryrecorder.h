@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ *
+ * @file       telemetryrecorder.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2017.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup TelemetryRecorderPlugin Plugin
+ * @{
+ * @brief In-memory time-series recorder for telemetry objects
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef TELEMETRYRECORDER_H
+#define TELEMETRYRECORDER_H
+
+#include "telemetryrecorder_global.h"
+#include "uavobjects/uavobjectmanager.h"
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+/**
+ * Central recorder keeping the recent history of every telemetry object in
+ * memory. Each object instance gets a circular buffer of packed data
+ * snapshots plus timestamps, allocated lazily on its first update and capped
+ * by a global memory budget. Gadgets query history by object, field and time
+ * range instead of keeping private copies from the moment they were opened.
+ *
+ * Retrieve the service with
+ *     TelemetryRecorder *rec = pm->getObject<TelemetryRecorder>();
+ */
+class TELEMETRYRECORDER_EXPORT TelemetryRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    typedef struct {
+        qint64 time; /** ms since epoch */
+        double value;
+    } Sample;
+
+    TelemetryRecorder(UAVObjectManager *objMngr);
+    ~TelemetryRecorder();
+
+    /**
+     * Return the recorded values of one field element of an object instance
+     * within [startTime, endTime] (ms since epoch, endTime <= 0 means now),
+     * oldest first. Returns an empty list for unknown objects or fields.
+     */
+    QList<Sample> querySamples(quint32 objId, quint16 instId, const QString &fieldName, quint32 elementIndex,
+                               qint64 startTime, qint64 endTime = -1);
+
+    /** Number of snapshots currently held for an object instance */
+    int sampleCount(quint32 objId, quint16 instId);
+
+    /** Timestamp of the oldest held snapshot, or -1 when there is none */
+    qint64 oldestSampleTime(quint32 objId, quint16 instId);
+
+    /** Bytes currently committed to history buffers */
+    qint64 memoryUsed();
+
+private slots:
+    void onNewObject(UAVObject *obj);
+    void onNewInstance(UAVObject *obj);
+    void onObjectUpdated(UAVObject *obj);
+
+private:
+    // Snapshot storage of one object instance : data holds capacity packed
+    // snapshots back to back, times the matching timestamps. head is the
+    // next write slot, the ring holds count valid entries ending before it.
+    typedef struct {
+        QByteArray data;
+        QVector<qint64> times;
+        quint32    numBytes;
+        int        capacity;
+        int        head;
+        int        count;
+    } InstanceRing;
+
+    // Per instance ring size : enough packed snapshots to fill this many
+    // bytes, so slow and fast objects get the same memory share and small
+    // objects keep proportionally more history.
+    static const int PER_INSTANCE_BUDGET = 256 * 1024;
+    static const int MIN_SAMPLES = 64;
+
+    // Global cap across all rings. When it is reached, instances that do not
+    // have a ring yet are not recorded (counted in m_skippedInstances).
+    static const qint64 TOTAL_BUDGET = 32 * 1024 * 1024;
+
+    UAVObjectManager *m_objMngr;
+    QMutex m_mutex;
+    QHash<quint64, InstanceRing *> m_rings;
+    qint64 m_bytesUsed;
+    quint32 m_skippedInstances;
+
+    void subscribe(UAVObject *obj);
+    InstanceRing *ringFor(UAVObject *obj);
+    static quint64 ringKey(quint32 objId, quint16 instId);
+};
+
+#endif // TELEMETRYRECORDER_H
@@ -0,0 +1,3 @@
+include(telemetryrecorder_dependencies.pri)
+
+LIBS *= -l$$qtLibraryName(TelemetryRecorder)
@@ -0,0 +1,18 @@
+TEMPLATE = lib
+TARGET = TelemetryRecorder
+
+DEFINES += TELEMETRYRECORDER_LIBRARY
+
+include(../../plugin.pri)
+include(telemetryrecorder_dependencies.pri)
+
+HEADERS += \
+    telemetryrecorder_global.h \
+    telemetryrecorder.h \
+    telemetryrecorderplugin.h
+
+SOURCES += \
+    telemetryrecorder.cpp \
+    telemetryrecorderplugin.cpp
+
+OTHER_FILES += TelemetryRecorder.pluginspec
@@ -0,0 +1,2 @@
+include(../../plugins/uavobjects/uavobjects.pri)
+include(../../plugins/coreplugin/coreplugin.pri)
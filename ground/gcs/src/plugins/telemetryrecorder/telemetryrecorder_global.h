@@ -1,13 +1,13 @@
 /**
  ******************************************************************************
  *
- * @file       telemetryparser.h
- * @author     Sami Korhonen & the OpenPilot team Copyright (C) 2010.
+ * @file       telemetryrecorder_global.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2017.
  * @addtogroup GCSPlugins GCS Plugins
  * @{
- * @addtogroup AntennaTrackGadgetPlugin Antenna Track Gadget Plugin
+ * @addtogroup TelemetryRecorderPlugin Plugin
  * @{
- * @brief A gadget that communicates with antenna tracker and enables basic configuration
+ * @brief In-memory time-series recorder for telemetry objects
  *****************************************************************************/
 /*
  * This program is free software; you can redistribute it and/or modify
@@ -25,26 +25,15 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 
-#ifndef TELEMETRYPARSER_H
-#define TELEMETRYPARSER_H
+#ifndef TELEMETRYRECORDER_GLOBAL_H
+#define TELEMETRYRECORDER_GLOBAL_H
 
-#include <QObject>
-#include <QtCore>
-#include "extensionsystem/pluginmanager.h"
-#include "uavobjectmanager.h"
-#include "uavobject.h"
-#include "gpsparser.h"
+#include <QtCore/qglobal.h>
 
+#if defined(TELEMETRYRECORDER_LIBRARY)
+#  define TELEMETRYRECORDER_EXPORT Q_DECL_EXPORT
+#else
+#  define TELEMETRYRECORDER_EXPORT Q_DECL_IMPORT
+#endif
 
-class TelemetryParser : public GPSParser {
-    Q_OBJECT
-
-public:
-    TelemetryParser(QObject *parent = 0);
-    ~TelemetryParser();
-public slots:
-    void updateGPS(UAVObject *object1);
-    void updateHome(UAVObject *object1);
-};
-
-#endif // TELEMETRYPARSER_H
+#endif // TELEMETRYRECORDER_GLOBAL_H
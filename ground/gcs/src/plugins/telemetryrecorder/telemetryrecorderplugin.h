@@ -0,0 +1,53 @@
+/**
+ ******************************************************************************
+ *
+ * @file       telemetryrecorderplugin.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2017.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup TelemetryRecorderPlugin Plugin
+ * @{
+ * @brief In-memory time-series recorder for telemetry objects
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef TELEMETRYRECORDERPLUGIN_H
+#define TELEMETRYRECORDERPLUGIN_H
+
+#include "telemetryrecorder_global.h"
+
+#include <extensionsystem/iplugin.h>
+#include <QtPlugin>
+
+class TelemetryRecorder;
+
+class TELEMETRYRECORDER_EXPORT TelemetryRecorderPlugin : public ExtensionSystem::IPlugin {
+    Q_OBJECT
+                     Q_PLUGIN_METADATA(IID "LibrePilot.TelemetryRecorder")
+
+public:
+    TelemetryRecorderPlugin();
+    ~TelemetryRecorderPlugin();
+
+    bool initialize(const QStringList &arguments, QString *errorString);
+    void extensionsInitialized();
+    void shutdown();
+
+private:
+    TelemetryRecorder *recorder;
+};
+
+#endif // TELEMETRYRECORDERPLUGIN_H
@@ -442,7 +442,7 @@ void UAVObjectBrowserWidget::updateDescription()
 
 void UAVObjectBrowserWidget::searchLineChanged(QString searchText)
 {
-    m_modelProxy->setFilterRegExp(QRegExp(searchText, Qt::CaseInsensitive, QRegExp::FixedString));
+    m_modelProxy->setFilterText(searchText);
     if (!searchText.isEmpty()) {
         m_browser->treeView->expandAll();
     } else {
@@ -461,6 +461,26 @@ TreeSortFilterProxyModel::TreeSortFilterProxyModel(QObject *p) :
     Q_ASSERT(p);
 }
 
+/**
+ * @brief TreeSortFilterProxyModel::setFilterText Sets the text to filter on
+ * and drops the cached subtree acceptance of the previous filter.
+ * Plain case insensitive substring match on item names.
+ */
+void TreeSortFilterProxyModel::setFilterText(const QString &text)
+{
+    m_acceptedChildrenCache.clear();
+    m_filterText = text.toLower();
+    invalidateFilter();
+}
+
+void TreeSortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    // the model is rebuilt when view options change, all cached items are stale
+    m_nameIndex.clear();
+    m_acceptedChildrenCache.clear();
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
 /**
  * @brief TreeSortFilterProxyModel::filterAcceptsRow  Taken from
  * http://qt-project.org/forums/viewthread/7782. This proxy model
@@ -474,6 +494,10 @@ TreeSortFilterProxyModel::TreeSortFilterProxyModel(QObject *p) :
  */
 bool TreeSortFilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
 {
+    if (m_filterText.isEmpty()) {
+        return true;
+    }
+
     if (filterAcceptsRowItself(source_row, source_parent)) {
         return true;
     }
@@ -497,7 +521,20 @@ bool TreeSortFilterProxyModel::filterAcceptsRow(int source_row, const QModelInde
 
 bool TreeSortFilterProxyModel::filterAcceptsRowItself(int source_row, const QModelIndex &source_parent) const
 {
-    return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+    QModelIndex sourceIndex = sourceModel()->index(source_row, 0, source_parent);
+
+    if (!sourceIndex.isValid()) {
+        return false;
+    }
+
+    // match against the name index instead of pulling the display data and
+    // running a regexp every time, names don't change once items exist
+    const TreeItem *item = static_cast<const TreeItem *>(sourceIndex.internalPointer());
+    QHash<const TreeItem *, QString>::const_iterator name = m_nameIndex.constFind(item);
+    if (name == m_nameIndex.constEnd()) {
+        name = m_nameIndex.insert(item, item->data(TreeItem::TITLE_COLUMN).toString().toLower());
+    }
+    return name.value().contains(m_filterText);
 }
 
 bool TreeSortFilterProxyModel::hasAcceptedChildren(int source_row, const QModelIndex &source_parent) const
@@ -514,15 +551,22 @@ bool TreeSortFilterProxyModel::hasAcceptedChildren(int source_row, const QModelI
         return false;
     }
 
-    for (int i = 0; i < childCount; ++i) {
-        if (filterAcceptsRowItself(i, item)) {
-            return true;
-        }
+    // The same subtrees are visited over and over while the filter is
+    // evaluated for each row and again for every telemetry driven
+    // dataChanged, so remember the verdict per item for the current filter.
+    const TreeItem *treeItem = static_cast<const TreeItem *>(item.internalPointer());
+    QHash<const TreeItem *, bool>::const_iterator cached = m_acceptedChildrenCache.constFind(treeItem);
+    if (cached != m_acceptedChildrenCache.constEnd()) {
+        return cached.value();
+    }
 
-        if (hasAcceptedChildren(i, item)) {
-            return true;
+    bool accepted = false;
+    for (int i = 0; i < childCount; ++i) {
+        if (filterAcceptsRowItself(i, item) || hasAcceptedChildren(i, item)) {
+            accepted = true;
+            break;
         }
     }
-
-    return false;
+    m_acceptedChildrenCache.insert(treeItem, accepted);
+    return accepted;
 }
@@ -41,6 +41,7 @@
 
 class QPushButton;
 class ObjectTreeItem;
+class TreeItem;
 class Ui_UAVObjectBrowser;
 class Ui_viewoptions;
 
@@ -48,10 +49,24 @@ class TreeSortFilterProxyModel : public QSortFilterProxyModel {
 public:
     TreeSortFilterProxyModel(QObject *parent);
 
+    void setFilterText(const QString &text);
+    void setSourceModel(QAbstractItemModel *sourceModel);
+
 protected:
     bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const;
     bool filterAcceptsRowItself(int source_row, const QModelIndex &source_parent) const;
     bool hasAcceptedChildren(int source_row, const QModelIndex &source_parent) const;
+
+private:
+    // Filter text, lower cased once.
+    QString m_filterText;
+
+    // Lower cased object/field/element names, indexed lazily.
+    // Names don't change once an item has been created.
+    mutable QHash<const TreeItem *, QString> m_nameIndex;
+
+    // Subtree acceptance per item for the current filter text.
+    mutable QHash<const TreeItem *, bool> m_acceptedChildrenCache;
 };
 
 class UAVObjectBrowserWidget : public QWidget {
@@ -53,6 +53,16 @@ UAVObjectTreeModel::UAVObjectTreeModel(QObject *parent, bool categorize, bool us
 
     // Create highlight manager, let it run every 300 ms.
     m_highlightManager = new HighLightManager(300);
+
+    // Telemetry can update objects much faster than the tree needs to be
+    // repainted. Updates are accumulated and applied once per tick so the
+    // cost of an open browser depends on the refresh rate and the number
+    // of affected rows, not on the telemetry rate.
+    m_updateTimer = new QTimer(this);
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(100);
+    connect(m_updateTimer, SIGNAL(timeout()), this, SLOT(updateTick()));
+
     connect(objManager, SIGNAL(newObject(UAVObject *)), this, SLOT(newObject(UAVObject *)));
     connect(objManager, SIGNAL(newInstance(UAVObject *)), this, SLOT(newObject(UAVObject *)));
 
@@ -456,16 +466,53 @@ QVariant UAVObjectTreeModel::headerData(int section, Qt::Orientation orientation
 void UAVObjectTreeModel::highlightUpdatedObject(UAVObject *obj)
 {
     Q_ASSERT(obj);
-    ObjectTreeItem *item = findObjectTreeItem(obj);
-    Q_ASSERT(item);
-    if (!m_onlyHilightChangedValues) {
-        item->setHighlight(true);
+    // Just remember the object, the tree is refreshed on the next tick.
+    m_pendingObjectUpdates.insert(obj);
+    if (!m_updateTimer->isActive()) {
+        m_updateTimer->start();
     }
-    item->update();
-    if (!m_onlyHilightChangedValues) {
-        QModelIndex itemIndex = index(item);
-        Q_ASSERT(itemIndex != QModelIndex());
-        emit dataChanged(itemIndex, itemIndex);
+}
+
+void UAVObjectTreeModel::updateTick()
+{
+    // Refresh every object that reported an update since the last tick.
+    // Fields that really changed mark themselves dirty through
+    // updateHighlight(), as do parents picking up the highlight.
+    foreach(UAVObject * obj, m_pendingObjectUpdates) {
+        ObjectTreeItem *item = findObjectTreeItem(obj);
+
+        Q_ASSERT(item);
+        if (!m_onlyHilightChangedValues) {
+            item->setHighlight(true);
+            m_dirtyItems.insert(item);
+        }
+        item->update();
+    }
+    m_pendingObjectUpdates.clear();
+
+    // Group the dirty items by parent and emit one dataChanged spanning
+    // the affected rows of each parent, so the views repaint each subtree
+    // once instead of once per item.
+    QHash<TreeItem *, QPair<int, int> > dirtyRows;
+    foreach(TreeItem * item, m_dirtyItems) {
+        int row = item->row();
+
+        if (!dirtyRows.contains(item->parent())) {
+            dirtyRows.insert(item->parent(), qMakePair(row, row));
+        } else {
+            QPair<int, int> &rows = dirtyRows[item->parent()];
+            rows.first  = qMin(rows.first, row);
+            rows.second = qMax(rows.second, row);
+        }
+    }
+    m_dirtyItems.clear();
+
+    QHashIterator<TreeItem *, QPair<int, int> > iter(dirtyRows);
+    while (iter.hasNext()) {
+        iter.next();
+        QModelIndex parentIndex = index(iter.key());
+        emit dataChanged(index(iter.value().first, TreeItem::TITLE_COLUMN, parentIndex),
+                         index(iter.value().second, TreeItem::DATA_COLUMN, parentIndex));
     }
 }
 
@@ -501,10 +548,13 @@ MetaObjectTreeItem *UAVObjectTreeModel::findMetaObjectTreeItem(UAVMetaObject *ob
 
 void UAVObjectTreeModel::updateHighlight(TreeItem *item)
 {
-    QModelIndex itemIndex = index(item);
-
-    Q_ASSERT(itemIndex != QModelIndex());
-    emit dataChanged(itemIndex, itemIndex.sibling(itemIndex.row(), TreeItem::DATA_COLUMN));
+    // Coalesced, the views are notified on the next tick. This also covers
+    // the expirations reported by the highlight manager, so a burst of
+    // expiring highlights results in a single repaint as well.
+    m_dirtyItems.insert(item);
+    if (!m_updateTimer->isActive()) {
+        m_updateTimer->start();
+    }
 }
 
 void UAVObjectTreeModel::updateIsKnown(TreeItem *item)
@@ -32,6 +32,7 @@
 #include <QAbstractItemModel>
 #include <QtCore/QMap>
 #include <QtCore/QList>
+#include <QtCore/QSet>
 #include <QColor>
 
 class TopTreeItem;
@@ -96,6 +97,7 @@ private slots:
     void updateIsKnown(TreeItem *item);
     void highlightUpdatedObject(UAVObject *obj);
     void isKnownChanged(UAVObject *object, bool isKnown);
+    void updateTick();
 
 private:
     void setupModelData(UAVObjectManager *objManager);
@@ -126,6 +128,15 @@ private:
 
     // Highlight manager to handle highlighting of tree items.
     HighLightManager *m_highlightManager;
+
+    // Timer coalescing telemetry driven updates into one refresh per tick.
+    QTimer *m_updateTimer;
+
+    // Objects that reported an update since the last tick.
+    QSet<UAVObject *> m_pendingObjectUpdates;
+
+    // Items whose display changed since the last tick.
+    QSet<TreeItem *> m_dirtyItems;
 };
 
 #endif // UAVOBJECTTREEMODEL_H
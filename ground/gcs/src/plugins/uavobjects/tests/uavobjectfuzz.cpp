@@ -0,0 +1,178 @@
+/*
+ * Round-trip fuzz and pack/unpack microbenchmark for the generated
+ * UAVObjects.
+ *
+ * Every object registered by UAVObjectsInitialize() is exercised, so the
+ * harness follows shared/uavobjectdefinition without any per-object code:
+ *
+ *  - fuzz : random payload bytes are unpacked and packed again; the
+ *    serializer must reproduce the input byte for byte.
+ *  - bench : per object pack and unpack cost in ns/op, plus heap
+ *    allocations per op counted by the overridden operator new.
+ *
+ * Run with an optional seed argument to reproduce a failure:
+ *     uavobjectfuzz [seed]
+ */
+
+#include <QtCore/QCoreApplication>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QDateTime>
+
+#include "uavobjectmanager.h"
+#include "uavdataobject.h"
+#include "uavobjectsinit.h"
+
+#include <stdlib.h>
+
+// number of random payloads per object in the fuzz pass
+#define FUZZ_ROUNDS     1000
+// number of iterations per object in the benchmark pass
+#define BENCH_ITERS     10000
+
+/* allocation counter: every operator new in the process bumps it, the
+ * benchmark reads the delta around the pack/unpack loops */
+static qint64 allocCount = 0;
+
+void *operator new(size_t size)
+{
+    ++allocCount;
+    return malloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    ++allocCount;
+    return malloc(size);
+}
+
+void operator delete(void *p) throw()
+{
+    free(p);
+}
+
+void operator delete[](void *p) throw()
+{
+    free(p);
+}
+
+/* small deterministic generator so runs are reproducible from the seed */
+static quint32 rngState;
+
+static quint32 nextRandom()
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static int fuzzObject(UAVDataObject *obj, QTextStream &sout)
+{
+    qint32 numBytes = obj->getNumBytes();
+    quint8 *in      = new quint8[numBytes];
+    quint8 *out     = new quint8[numBytes];
+    int failures    = 0;
+
+    for (int round = 0; round < FUZZ_ROUNDS; ++round) {
+        for (qint32 i = 0; i < numBytes; ++i) {
+            in[i] = nextRandom() & 0xff;
+        }
+        obj->unpack(in);
+        obj->pack(out);
+        for (qint32 i = 0; i < numBytes; ++i) {
+            if (in[i] != out[i]) {
+                sout << QString("FAIL %1 round %2 : byte %3 went in %4 came out %5\n")
+                    .arg(obj->getName()).arg(round).arg(i)
+                    .arg(in[i], 2, 16, QChar('0')).arg(out[i], 2, 16, QChar('0'));
+                ++failures;
+                break;
+            }
+        }
+    }
+
+    delete[] in;
+    delete[] out;
+    return failures;
+}
+
+static void benchObject(UAVDataObject *obj, QTextStream &sout)
+{
+    qint32 numBytes = obj->getNumBytes();
+    quint8 *buf     = new quint8[numBytes];
+    QElapsedTimer timer;
+
+    obj->pack(buf);
+
+    qint64 allocs0 = allocCount;
+    timer.start();
+    for (int i = 0; i < BENCH_ITERS; ++i) {
+        obj->pack(buf);
+    }
+    qint64 packNs     = timer.nsecsElapsed();
+    qint64 packAllocs = allocCount - allocs0;
+
+    allocs0 = allocCount;
+    timer.restart();
+    for (int i = 0; i < BENCH_ITERS; ++i) {
+        obj->unpack(buf);
+    }
+    qint64 unpackNs     = timer.nsecsElapsed();
+    qint64 unpackAllocs = allocCount - allocs0;
+
+    sout << QString("%1 %2 %3 %4 %5 %6\n")
+        .arg(obj->getName(), -32)
+        .arg(numBytes, 5)
+        .arg(packNs / BENCH_ITERS, 8)
+        .arg((double)packAllocs / BENCH_ITERS, 8, 'f', 2)
+        .arg(unpackNs / BENCH_ITERS, 8)
+        .arg((double)unpackAllocs / BENCH_ITERS, 8, 'f', 2);
+
+    delete[] buf;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QTextStream sout(stdout);
+
+    rngState = (argc > 1) ? QString(argv[1]).toUInt()
+               : (quint32)QDateTime::currentMSecsSinceEpoch();
+    if (!rngState) {
+        rngState = 1;
+    }
+    sout << QString("seed %1 (pass as argument to reproduce)\n").arg(rngState);
+
+    UAVObjectManager *objMngr = new UAVObjectManager();
+    UAVObjectsInitialize(objMngr);
+
+    int failures = 0;
+    int objects  = 0;
+
+    foreach(QList<UAVDataObject *> list, objMngr->getDataObjects()) {
+        foreach(UAVDataObject * obj, list) {
+            // fuzz the first instance of each object type only
+            if (obj->getInstID() == 0) {
+                failures += fuzzObject(obj, sout);
+                ++objects;
+            }
+        }
+    }
+    sout << QString("fuzzed %1 objects x %2 rounds, %3 failures\n\n")
+        .arg(objects).arg(FUZZ_ROUNDS).arg(failures);
+
+    sout << QString("%1 %2 %3 %4 %5 %6\n")
+        .arg("object", -32).arg("bytes", 5)
+        .arg("pack", 8).arg("allocs", 8)
+        .arg("unpack", 8).arg("allocs", 8);
+    foreach(QList<UAVDataObject *> list, objMngr->getDataObjects()) {
+        foreach(UAVDataObject * obj, list) {
+            if (obj->getInstID() == 0) {
+                benchObject(obj, sout);
+            }
+        }
+    }
+    sout.flush();
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,44 @@
+# Standalone round-trip fuzz / microbenchmark harness for the generated
+# UAVObjects. The objects are generated from shared/uavobjectdefinition
+# with the same machinery the plugin uses, picked up with a wildcard so
+# the harness stays in sync with the definitions without being edited.
+QT -= gui
+QT += xml qml concurrent
+TARGET = uavobjectfuzz
+CONFIG += console
+CONFIG -= app_bundle
+TEMPLATE = app
+
+DEFINES += UAVOBJECTS_LIBRARY
+
+INCLUDEPATH += ..
+
+ROOT_DIR = ../../../../../..
+
+UAVOBJ_XML_DIR = $${ROOT_DIR}/shared/uavobjectdefinition
+UAVOBJ_ROOT_DIR = $${ROOT_DIR}
+
+win32 {
+    UAVOBJGENERATOR = ../../../../uavobjgenerator/uavobjgenerator.exe
+} else {
+    UAVOBJGENERATOR = ../../../../uavobjgenerator/uavobjgenerator
+}
+
+UAVOBJS = $$files($${UAVOBJ_XML_DIR}/*.xml)
+
+include(../uavobjgenerator.pri)
+
+SOURCES += uavobjectfuzz.cpp \
+    ../uavobjectmanager.cpp \
+    ../uavobject.cpp \
+    ../uavmetaobject.cpp \
+    ../uavdataobject.cpp \
+    ../uavobjectfield.cpp \
+    ../uavobjectbatchsubscription.cpp
+HEADERS += ../uavobjectmanager.h \
+    ../uavobject.h \
+    ../uavmetaobject.h \
+    ../uavdataobject.h \
+    ../uavobjectfield.h \
+    ../uavobjectbatchsubscription.h \
+    ../uavobjectsinit.h
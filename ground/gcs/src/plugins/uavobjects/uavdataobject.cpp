@@ -27,6 +27,20 @@
  */
 #include "uavdataobject.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+// All instances of a multi instance object carry identical field
+// descriptions (names, units, options, parsed limits). The first constructed
+// instance of each object type is recorded here and later instances copy its
+// fields instead of rebuilding them from scratch : the implicitly shared Qt
+// containers then reference one backing store per type and the limits string
+// is parsed only once, which matters when dozens of waypoint or sensor
+// instances are cloned in a burst.
+static QHash<quint32, UAVDataObject *> fieldPrototypes;
+static QMutex fieldPrototypesMutex;
+
 /**
  * Constructor
  */
@@ -37,6 +51,51 @@ UAVDataObject::UAVDataObject(quint32 objID, bool isSingleInst, bool isSettings,
     this->m_isSettings = isSettings;
 }
 
+UAVDataObject::~UAVDataObject()
+{
+    QMutexLocker locker(&fieldPrototypesMutex);
+
+    // The shared containers of the copied fields keep their own reference to
+    // the data, the registry only needs to forget a deleted prototype. The
+    // next constructed instance of the type re-registers.
+    if (fieldPrototypes.value(getObjID(), NULL) == this) {
+        fieldPrototypes.remove(getObjID());
+    }
+}
+
+/**
+ * Fill the field list with copies of the fields of the first constructed
+ * instance of this object type. Returns false for the first instance, which
+ * builds its fields from scratch and registers them with
+ * registerFieldPrototype().
+ */
+bool UAVDataObject::cloneFieldsFromPrototype(QList<UAVObjectField *> &fields)
+{
+    QMutexLocker locker(&fieldPrototypesMutex);
+    UAVDataObject *prototype = fieldPrototypes.value(getObjID(), NULL);
+
+    if (prototype == NULL) {
+        return false;
+    }
+    foreach(UAVObjectField *field, prototype->getFields()) {
+        fields.append(new UAVObjectField(field));
+    }
+    return true;
+}
+
+/**
+ * Record this instance as the field prototype of its object type. A no-op
+ * when the type already has one.
+ */
+void UAVDataObject::registerFieldPrototype()
+{
+    QMutexLocker locker(&fieldPrototypesMutex);
+
+    if (!fieldPrototypes.contains(getObjID())) {
+        fieldPrototypes.insert(getObjID(), this);
+    }
+}
+
 /**
  * Initialize instance ID and assign a metaobject
  */
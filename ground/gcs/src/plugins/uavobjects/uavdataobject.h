@@ -39,6 +39,7 @@ class UAVOBJECTS_EXPORT UAVDataObject : public UAVObject {
 
 public:
     UAVDataObject(quint32 objID, bool isSingleInst, bool isSettingsObject, const QString & name);
+    ~UAVDataObject();
     void initialize(quint32 instID, UAVMetaObject *metaObject);
     void initialize(UAVMetaObject *metaObject);
     void setMetadata(const Metadata & mdata);
@@ -50,6 +51,12 @@ public:
     bool isSettingsObject();
     bool isDataObject();
 
+protected:
+    // Field description sharing between instances of the same object type,
+    // used by the generated constructors (see uavobject.cpp.template)
+    bool cloneFieldsFromPrototype(QList<UAVObjectField *> &fields);
+    void registerFieldPrototype();
+
 private:
     UAVMetaObject *m_metaObject;
     bool m_isSettings;
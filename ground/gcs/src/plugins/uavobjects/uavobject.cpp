@@ -30,6 +30,7 @@
 #include <utils/crc.h>
 
 #include <QtEndian>
+#include <QThread>
 #include <QDebug>
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
@@ -303,34 +304,109 @@ UAVObjectField *UAVObject::getField(const QString & name)
 qint32 UAVObject::pack(quint8 *dataOut)
 {
     QMutexLocker locker(mutex);
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    // The wire format is little endian and the data buffer is the packed
+    // generated DataFields struct, so on little endian hosts the whole
+    // object serializes with a single bulk copy. The generated code carries
+    // a static assert that the struct layout matches the wire size.
+    memcpy(dataOut, data, numBytes);
+#else
     qint32 offset = 0;
 
     for (int n = 0; n < fields.length(); ++n) {
         fields[n]->pack(&dataOut[offset]);
         offset += fields[n]->getNumBytes();
     }
+#endif
     return numBytes;
 }
 
 /**
  * Unpack the object data from a byte array
+ *
+ * A payload that is byte identical to the current data (settings echoes,
+ * unchanged GPS while station keeping, ...) does not trigger the full
+ * update cascade : the write is skipped and objectUnpackedUnchanged() is
+ * emitted instead of objectUnpacked()/objectUpdated().
  * @returns The number of bytes copied
  */
 qint32 UAVObject::unpack(const quint8 *dataIn)
 {
     QMutexLocker locker(mutex);
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    // see pack(), the data buffer matches the wire format on little endian
+    // hosts so redundancy detection is a single compare
+    if (memcmp(data, dataIn, numBytes) == 0) {
+        emit objectUnpackedUnchanged(this);
+        return numBytes;
+    }
+    beginDataWrite();
+    memcpy(data, dataIn, numBytes);
+    endDataWrite();
+#else
+    QByteArray previous((const char *)data, numBytes);
     qint32 offset = 0;
 
+    beginDataWrite();
     for (int n = 0; n < fields.length(); ++n) {
         fields[n]->unpack(&dataIn[offset]);
         offset += fields[n]->getNumBytes();
     }
+    endDataWrite();
+    if (memcmp(previous.constData(), data, numBytes) == 0) {
+        emit objectUnpackedUnchanged(this);
+        return numBytes;
+    }
+#endif
     emit objectUnpacked(this); // trigger object updated event
     emit objectUpdated(this);
 
     return numBytes;
 }
 
+/**
+ * Copy the object data into the supplied buffer without taking the object
+ * mutex. The read is a seqlock : writers bump the data version around their
+ * update, the reader retries when it raced with one. Readers therefore never
+ * block the telemetry thread, and a snapshot costs one memcpy when the data
+ * is quiet.
+ * The buffer must be able to hold getNumBytes() bytes.
+ * @returns The number of bytes copied
+ */
+qint32 UAVObject::readDataSnapshot(quint8 *dataOut)
+{
+    while (true) {
+        int v1 = dataVersion.loadAcquire();
+        if (!(v1 & 1)) {
+            memcpy(dataOut, data, numBytes);
+            int v2 = dataVersion.loadAcquire();
+            if (v1 == v2) {
+                return numBytes;
+            }
+        }
+        // raced with a writer, let it finish
+        QThread::yieldCurrentThread();
+    }
+}
+
+/**
+ * Mark the start of a data update. Writers must hold the object mutex.
+ */
+void UAVObject::beginDataWrite()
+{
+    dataVersion.fetchAndAddOrdered(1);
+}
+
+/**
+ * Mark the end of a data update.
+ */
+void UAVObject::endDataWrite()
+{
+    dataVersion.fetchAndAddOrdered(1);
+}
+
 /**
  * Update a CRC with the object data
  * @returns The updated CRC
@@ -114,6 +114,7 @@ public:
     quint32 getNumBytes();
     qint32 pack(quint8 *dataOut);
     qint32 unpack(const quint8 *dataIn);
+    qint32 readDataSnapshot(quint8 *dataOut);
     quint8 updateCRC(quint8 crc = 0);
     bool save();
     bool save(QFile & file);
@@ -178,12 +179,18 @@ signals:
     void objectUpdatedManual(UAVObject *obj, bool all = false);
     void objectUpdatedPeriodic(UAVObject *obj);
     void objectUnpacked(UAVObject *obj);
+    // Emitted instead of objectUnpacked/objectUpdated when a received payload
+    // is byte identical to the current data. Consumers that care about every
+    // arrival (watchdogs, link monitors) connect to this one as well.
+    void objectUnpackedUnchanged(UAVObject *obj);
     void updateRequested(UAVObject *obj, bool all = false);
     void transactionCompleted(UAVObject *obj, bool success);
     void newInstance(UAVObject *obj);
     void isKnownChanged(UAVObject *obj, bool isKnown);
 
 protected:
+    friend class UAVObjectField;
+
     quint32 objID;
     quint32 instID;
     bool isSingleInst;
@@ -193,8 +200,15 @@ protected:
     quint32 numBytes;
     QMutex *mutex;
     quint8 *data;
+    // Sequence counter for the lock-free snapshot reader, odd while a write
+    // is in progress. All writers hold the object mutex, readers use
+    // readDataSnapshot() and never block them.
+    QAtomicInt dataVersion;
     QList<UAVObjectField *> fields;
 
+    void beginDataWrite();
+    void endDataWrite();
+
     void initializeFields(QList<UAVObjectField *> & fields, quint8 *data, quint32 numBytes);
     void setDescription(const QString & description);
     void setCategory(const QString & category);
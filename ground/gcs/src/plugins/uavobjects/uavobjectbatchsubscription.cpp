@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjectbatchsubscription.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief      The UAVUObjects GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "uavobjectbatchsubscription.h"
+
+UAVObjectBatchSubscription::UAVObjectBatchSubscription(const QList<UAVObject *> &objs, int maxRateHz, QObject *parent) : QObject(parent)
+{
+    // The timer is armed when the first update arrives and stopped again by
+    // flush(), so an idle subscription causes no wakeups at all
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setInterval(1000 / qBound(1, maxRateHz, 1000));
+    connect(timer, SIGNAL(timeout()), this, SLOT(flush()));
+
+    foreach(UAVObject * obj, objs) {
+        addObject(obj);
+    }
+}
+
+/**
+ * Add an object to the subscription
+ */
+void UAVObjectBatchSubscription::addObject(UAVObject *obj)
+{
+    // the connection is queued when the object is updated from another
+    // thread, so marking and flushing always happen on this object's thread
+    connect(obj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectUpdated(UAVObject *)), Qt::UniqueConnection);
+}
+
+/**
+ * Remove an object from the subscription
+ */
+void UAVObjectBatchSubscription::removeObject(UAVObject *obj)
+{
+    disconnect(obj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectUpdated(UAVObject *)));
+    changed.remove(obj);
+}
+
+void UAVObjectBatchSubscription::objectUpdated(UAVObject *obj)
+{
+    changed.insert(obj);
+    if (!timer->isActive()) {
+        timer->start();
+    }
+}
+
+void UAVObjectBatchSubscription::flush()
+{
+    if (changed.isEmpty()) {
+        return;
+    }
+    QList<UAVObject *> list = changed.toList();
+    changed.clear();
+    emit objectsUpdated(list);
+}
@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjectbatchsubscription.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief      The UAVUObjects GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef UAVOBJECTBATCHSUBSCRIPTION_H
+#define UAVOBJECTBATCHSUBSCRIPTION_H
+
+#include "uavobjects_global.h"
+#include "uavobject.h"
+
+#include <QSet>
+#include <QTimer>
+
+/**
+ * Coalesced subscription to a set of UAVObjects.
+ *
+ * Instead of one objectUpdated() delivery per apply, subscribers receive at
+ * most one objectsUpdated() notification per interval, carrying the set of
+ * objects that changed since the previous notification. This decouples GUI
+ * refresh cost from telemetry rate for hot objects like AttitudeState.
+ *
+ * Created through UAVObjectManager::createBatchSubscription(); the caller
+ * owns the subscription and unsubscribes by deleting it.
+ */
+class UAVOBJECTS_EXPORT UAVObjectBatchSubscription : public QObject {
+    Q_OBJECT
+
+public:
+    UAVObjectBatchSubscription(const QList<UAVObject *> &objs, int maxRateHz, QObject *parent = 0);
+
+    void addObject(UAVObject *obj);
+    void removeObject(UAVObject *obj);
+
+signals:
+    /** Emitted at most once per interval with all objects updated since the last notification */
+    void objectsUpdated(const QList<UAVObject *> &changed);
+
+private slots:
+    void objectUpdated(UAVObject *obj);
+    void flush();
+
+private:
+    QTimer *timer;
+    QSet<UAVObject *> changed;
+};
+
+#endif // UAVOBJECTBATCHSUBSCRIPTION_H
@@ -29,11 +29,62 @@
 
 #include <QtEndian>
 #include <QDebug>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
 #include <QJsonObject>
 #include <QJsonArray>
 
+// Global intern pool for field name data. The same names, units and option
+// lists ("Roll", "deg", "None/Warning/Error/Critical", ...) recur across
+// hundreds of object types; storing one copy of each cuts steady-state
+// footprint and makes equal strings share their d-pointer, so comparisons
+// take the pointer-equality fast path. The pool only ever grows, the strings
+// describe the static object set.
+static QHash<QString, QString> internPool;
+static QHash<QString, QStringList> internListPool;
+static QMutex internMutex;
+
+static QString internString(const QString &str)
+{
+    QMutexLocker locker(&internMutex);
+    QHash<QString, QString>::const_iterator it = internPool.constFind(str);
+
+    if (it != internPool.constEnd()) {
+        return it.value();
+    }
+    internPool.insert(str, str);
+    return str;
+}
+
+static QStringList internStringList(const QStringList &list)
+{
+    QMutexLocker locker(&internMutex);
+    // element names cannot contain the separator, they come from the object
+    // definition identifiers
+    QString key = list.join(QChar('\x1f'));
+    QHash<QString, QStringList>::const_iterator it = internListPool.constFind(key);
+
+    if (it != internListPool.constEnd()) {
+        return it.value();
+    }
+    QStringList interned;
+    foreach(const QString &str, list) {
+        QHash<QString, QString>::const_iterator sit = internPool.constFind(str);
+
+        if (sit != internPool.constEnd()) {
+            interned.append(sit.value());
+        } else {
+            internPool.insert(str, str);
+            interned.append(str);
+        }
+    }
+    internListPool.insert(key, interned);
+    return interned;
+}
+
 UAVObjectField::UAVObjectField(const QString & name, const QString & description, const QString & units, FieldType type, quint32 numElements, const QStringList & options, const QString &limits)
 {
     QStringList elementNames;
@@ -51,19 +102,41 @@ UAVObjectField::UAVObjectField(const QString & name, const QString & description
     constructorInitialize(name, description, units, type, elementNames, options, limits);
 }
 
+/**
+ * Construct a field that shares the immutable description of a prototype
+ * field. The implicitly shared strings, option lists and the already parsed
+ * limits reference the prototype's storage instead of being rebuilt, see
+ * UAVDataObject::cloneFieldsFromPrototype().
+ */
+UAVObjectField::UAVObjectField(const UAVObjectField *prototype)
+{
+    this->name = prototype->name;
+    this->description   = prototype->description;
+    this->units         = prototype->units;
+    this->type          = prototype->type;
+    this->elementNames  = prototype->elementNames;
+    this->options       = prototype->options;
+    this->numElements   = prototype->numElements;
+    this->numBytesPerElement = prototype->numBytesPerElement;
+    this->elementLimits = prototype->elementLimits;
+    this->offset        = 0;
+    this->data          = NULL;
+    this->obj           = NULL;
+}
+
 void UAVObjectField::constructorInitialize(const QString & name, const QString & description, const QString & units, FieldType type, const QStringList & elementNames, const QStringList & options, const QString &limits)
 {
-    // Copy params
-    this->name         = name;
-    this->description  = description;
-    this->units        = units;
+    // Copy params, sharing the storage of recurring name data
+    this->name         = internString(name);
+    this->description  = internString(description);
+    this->units        = internString(units);
     this->type         = type;
-    this->options      = options;
+    this->options      = internStringList(options);
     this->numElements  = elementNames.length();
     this->offset       = 0;
     this->data         = NULL;
     this->obj = NULL;
-    this->elementNames = elementNames;
+    this->elementNames = internStringList(elementNames);
     // Set field size
     switch (type) {
     case INT8:
@@ -92,7 +165,7 @@ void UAVObjectField::constructorInitialize(const QString & name, const QString &
         break;
     case BITFIELD:
         numBytesPerElement = sizeof(quint8);
-        this->options = QStringList() << tr("0") << tr("1");
+        this->options = internStringList(QStringList() << tr("0") << tr("1"));
         break;
     case STRING:
         numBytesPerElement = sizeof(quint8);
@@ -957,6 +1030,11 @@ QVariant UAVObjectField::getValue(quint32 index)
 {
     QMutexLocker locker(obj->getMutex());
 
+    return getValueFromData(data, index);
+}
+
+QVariant UAVObjectField::getValueFromData(const quint8 *dataIn, quint32 index)
+{
     // Check that index is not out of bounds
     if (index >= numElements) {
         return QVariant();
@@ -966,7 +1044,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case INT8:
     {
         qint8 tmpint8;
-        memcpy(&tmpint8, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpint8, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         return QVariant(tmpint8);
 
         break;
@@ -974,7 +1052,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case INT16:
     {
         qint16 tmpint16;
-        memcpy(&tmpint16, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpint16, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         return QVariant(tmpint16);
 
         break;
@@ -982,7 +1060,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case INT32:
     {
         qint32 tmpint32;
-        memcpy(&tmpint32, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpint32, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         return QVariant(tmpint32);
 
         break;
@@ -990,7 +1068,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case UINT8:
     {
         quint8 tmpuint8;
-        memcpy(&tmpuint8, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpuint8, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         return QVariant(tmpuint8);
 
         break;
@@ -998,7 +1076,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case UINT16:
     {
         quint16 tmpuint16;
-        memcpy(&tmpuint16, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpuint16, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         return QVariant(tmpuint16);
 
         break;
@@ -1006,7 +1084,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case UINT32:
     {
         quint32 tmpuint32;
-        memcpy(&tmpuint32, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpuint32, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         return QVariant(tmpuint32);
 
         break;
@@ -1014,7 +1092,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case FLOAT32:
     {
         float tmpfloat;
-        memcpy(&tmpfloat, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpfloat, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         return QVariant(tmpfloat);
 
         break;
@@ -1022,7 +1100,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case ENUM:
     {
         quint8 tmpenum;
-        memcpy(&tmpenum, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        memcpy(&tmpenum, &dataIn[offset + numBytesPerElement * index], numBytesPerElement);
         if (tmpenum >= options.length()) {
             qDebug() << "Invalid value for" << name;
             tmpenum = 0;
@@ -1034,7 +1112,7 @@ QVariant UAVObjectField::getValue(quint32 index)
     case BITFIELD:
     {
         quint8 tmpbitfield;
-        memcpy(&tmpbitfield, &data[offset + numBytesPerElement * ((quint32)(index / 8))], numBytesPerElement);
+        memcpy(&tmpbitfield, &dataIn[offset + numBytesPerElement * ((quint32)(index / 8))], numBytesPerElement);
         tmpbitfield = (tmpbitfield >> (index % 8)) & 1;
         return QVariant(tmpbitfield);
 
@@ -1042,9 +1120,9 @@ QVariant UAVObjectField::getValue(quint32 index)
     }
     case STRING:
     {
-        data[offset + numElements - 1] = '\0';
-        QString str((char *)&data[offset]);
-        return QVariant(str);
+        QByteArray str((const char *)&dataIn[offset], numElements);
+        str[(int)numElements - 1] = '\0';
+        return QVariant(QString(str.constData()));
 
         break;
     }
@@ -1106,6 +1184,7 @@ void UAVObjectField::setValue(const QVariant & value, quint32 index)
     UAVObject::Metadata mdata = obj->getMetadata();
     // Update value if the access mode permits
     if (UAVObject::GetGcsAccess(mdata) == UAVObject::ACCESS_READWRITE) {
+        obj->beginDataWrite();
         switch (type) {
         case INT8:
         {
@@ -1179,6 +1258,7 @@ void UAVObjectField::setValue(const QVariant & value, quint32 index)
             break;
         }
         }
+        obj->endDataWrite();
     }
 }
 
@@ -56,6 +56,7 @@ public:
 
     UAVObjectField(const QString & name, const QString & description, const QString & units, FieldType type, quint32 numElements, const QStringList & options, const QString & limits = QString());
     UAVObjectField(const QString & name, const QString & description, const QString & units, FieldType type, const QStringList & elementNames, const QStringList & options, const QString & limits = QString());
+    UAVObjectField(const UAVObjectField *prototype);
     void initialize(quint8 *data, quint32 dataOffset, UAVObject *obj);
     UAVObject *getObject();
     FieldType getType();
@@ -69,10 +70,51 @@ public:
     qint32 pack(quint8 *dataOut);
     qint32 unpack(const quint8 *dataIn);
     QVariant getValue(quint32 index = 0);
+    /**
+     * Decode one element from an external copy of the object data, e.g. a
+     * buffer filled by UAVObject::readDataSnapshot(). Does not take the
+     * object mutex, so it is safe wherever the mutex is already held or
+     * must not be touched.
+     */
+    QVariant getValueFromData(const quint8 *dataIn, quint32 index = 0);
     bool checkValue(const QVariant & data, quint32 index = 0);
     void setValue(const QVariant & data, quint32 index = 0);
     double getDouble(quint32 index = 0);
     void setDouble(double value, quint32 index = 0);
+
+    /**
+     * Read one element straight from the packed data buffer, without QVariant
+     * boxing. T must match the field type (e.g. getValue<float>() on a
+     * FLOAT32 field, getValue<quint8>() on a UINT8, ENUM or BITFIELD field);
+     * on a type mismatch or an out of range index a default value is returned.
+     */
+    template <typename T> T getValue(quint32 index = 0)
+    {
+        T value = T();
+
+        if ((index < numElements) && isCompatible<T>()) {
+            QMutexLocker locker(obj->getMutex());
+            memcpy(&value, &data[offset + numBytesPerElement * index], sizeof(T));
+        }
+        return value;
+    }
+
+    /**
+     * Fill a caller provided buffer with up to count elements starting at
+     * firstIndex, taking the object mutex once for the whole span.
+     * Returns the number of elements copied.
+     */
+    template <typename T> qint32 getValues(T *dest, quint32 count, quint32 firstIndex = 0)
+    {
+        if (!isCompatible<T>() || (firstIndex >= numElements)) {
+            return 0;
+        }
+        quint32 n = qMin(count, numElements - firstIndex);
+        QMutexLocker locker(obj->getMutex());
+        memcpy(dest, &data[offset + numBytesPerElement * firstIndex], n * sizeof(T));
+        return n;
+    }
+
     quint32 getDataOffset();
     quint32 getNumBytes();
     bool isNumeric();
@@ -94,6 +136,48 @@ signals:
     void fieldUpdated(UAVObjectField *field);
 
 protected:
+    // Map the scalar C++ types usable with the typed accessors to field types
+    static FieldType typeOf(qint8)
+    {
+        return INT8;
+    }
+    static FieldType typeOf(qint16)
+    {
+        return INT16;
+    }
+    static FieldType typeOf(qint32)
+    {
+        return INT32;
+    }
+    static FieldType typeOf(quint8)
+    {
+        return UINT8;
+    }
+    static FieldType typeOf(quint16)
+    {
+        return UINT16;
+    }
+    static FieldType typeOf(quint32)
+    {
+        return UINT32;
+    }
+    static FieldType typeOf(float)
+    {
+        return FLOAT32;
+    }
+
+    /** Check that T matches the storage type of this field */
+    template <typename T> bool isCompatible() const
+    {
+        FieldType t = typeOf(T());
+
+        if (t == UINT8) {
+            // enums and bitfields are stored as unsigned bytes
+            return (type == UINT8) || (type == ENUM) || (type == BITFIELD);
+        }
+        return type == t;
+    }
+
     QString name;
     QString description;
     QString units;
@@ -26,9 +26,14 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include "uavobjectmanager.h"
+#include "uavobjectbatchsubscription.h"
 
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QJsonDocument>
+#include <QIODevice>
+#include <QThread>
+#include <QtConcurrentMap>
 
 /**
  * Constructor
@@ -49,14 +54,102 @@ UAVObjectManager::~UAVObjectManager()
  * an existing object. The object will be registered and will be properly initialized so that it can accept
  * updates.
  */
+namespace {
+struct RunObjectCreator {
+    typedef UAVDataObject *result_type;
+    QThread *registrationThread;
+
+    UAVDataObject *operator()(UAVObjectManager::ObjectCreator creator) const
+    {
+        UAVDataObject *obj = creator();
+
+        // constructed on a pool thread, hand it over before registration
+        obj->moveToThread(registrationThread);
+        return obj;
+    }
+};
+}
+
+/**
+ * Construct and register a batch of objects.
+ *
+ * The creators are plain factory functions, so construction is fanned out to
+ * the global thread pool and only the registration itself runs on the calling
+ * thread. This is used by the generated UAVObjectsInitialize() to take object
+ * construction off the GCS cold-start critical path.
+ */
+void UAVObjectManager::registerObjects(const QList<ObjectCreator> &creators)
+{
+    RunObjectCreator runCreator;
+
+    runCreator.registrationThread = QThread::currentThread();
+    QList<UAVDataObject *> objs = QtConcurrent::blockingMapped(creators, runCreator);
+
+    // the batch size is known up front, so the indices never rehash during
+    // registration
+    objects.reserve(objects.size() + objs.size());
+    objectsById.reserve(objectsById.size() + objs.size());
+    objectsByName.reserve(objectsByName.size() + objs.size());
+
+    foreach(UAVDataObject * obj, objs) {
+        registerObject(obj);
+    }
+}
+
+/**
+ * Grow a multi instance object to instanceCount instances in one call.
+ *
+ * All missing instances are cloned from instance 0 and appended while the
+ * manager lock is held once, instead of one registerObject() round trip per
+ * instance. The per instance newInstance() signals are still emitted for
+ * existing listeners (object browser, telemetry), followed by a single
+ * aggregated newInstances() signal carrying the new instances. Returns the
+ * newly created instances; the list is empty if the object is unknown,
+ * single instance or already large enough.
+ */
+QList<UAVObject *> UAVObjectManager::createObjectInstances(quint32 objId, quint32 instanceCount)
+{
+    QMutexLocker locker(mutex);
+
+    QList<UAVObject *> created;
+
+    if (instanceCount > MAX_INSTANCES) {
+        instanceCount = MAX_INSTANCES;
+    }
+    int objidx = objectsById.value(objId, -1);
+    if ((objidx < 0) || objects[objidx].isEmpty()) {
+        return created;
+    }
+    UAVDataObject *refObj = dynamic_cast<UAVDataObject *>(objects[objidx][0]);
+    if ((refObj == NULL) || refObj->isSingleInstance()) {
+        return created;
+    }
+    UAVMetaObject *mobj = refObj->getMetaObject();
+    objects[objidx].reserve(instanceCount);
+    for (quint32 instidx = objects[objidx].length(); instidx < instanceCount; ++instidx) {
+        UAVDataObject *cobj = refObj->clone(instidx);
+        cobj->initialize(mobj);
+        objects[objidx].append(cobj);
+        created.append(cobj);
+    }
+    foreach(UAVObject * cobj, created) {
+        refObj->emitNewInstance(cobj);
+        emit newInstance(cobj);
+    }
+    if (!created.isEmpty()) {
+        emit newInstances(created);
+    }
+    return created;
+}
+
 bool UAVObjectManager::registerObject(UAVDataObject *obj)
 {
     QMutexLocker locker(mutex);
 
     // Check if this object type is already in the list
-    for (int objidx = 0; objidx < objects.length(); ++objidx) {
-        // Check if the object ID is in the list
-        if (objects[objidx].length() > 0 && objects[objidx][0]->getObjID() == obj->getObjID()) {
+    int objidx = objectsById.value(obj->getObjID(), -1);
+    if (objidx >= 0) {
+        if (objects[objidx].length() > 0) {
             // Check if this is a single instance object, if yes we can not add a new instance
             if (obj->isSingleInstance()) {
                 return false;
@@ -123,6 +216,10 @@ void UAVObjectManager::addObject(UAVObject *obj)
     QList<UAVObject *> list;
     list.append(obj);
     objects.append(list);
+    // Keep the flat indices in sync : instances appended later share the
+    // entry created here for their type
+    objectsById.insert(obj->getObjID(), objects.length() - 1);
+    objectsByName.insert(obj->getName(), objects.length() - 1);
     emit newObject(obj);
 }
 
@@ -137,6 +234,43 @@ QList< QList<UAVObject *> > UAVObjectManager::getObjects()
     return objects;
 }
 
+/**
+ * Total bytes held in object data buffers across all types and instances.
+ * Field descriptions are shared between instances and not counted here;
+ * this is the part that grows with instance counts and vehicle sessions.
+ */
+quint64 UAVObjectManager::getMemoryUsed()
+{
+    QMutexLocker locker(mutex);
+    quint64 total = 0;
+
+    foreach(const QList<UAVObject *> &instances, objects) {
+        foreach(UAVObject * obj, instances) {
+            total += obj->getNumBytes();
+        }
+    }
+    return total;
+}
+
+/**
+ * Get the first instance of each registered object type, without copying
+ * the per-type instance lists. Cheaper than getObjects() for callers that
+ * only iterate over object types.
+ */
+QList<UAVObject *> UAVObjectManager::getObjectTypes()
+{
+    QMutexLocker locker(mutex);
+
+    QList<UAVObject *> list;
+    list.reserve(objects.length());
+    for (int objidx = 0; objidx < objects.length(); ++objidx) {
+        if (objects[objidx].length() > 0) {
+            list.append(objects[objidx][0]);
+        }
+    }
+    return list;
+}
+
 /**
  * Same as getObjects() but will only return DataObjects.
  */
@@ -228,17 +362,20 @@ UAVObject *UAVObjectManager::getObject(const QString *name, quint32 objId, quint
 {
     QMutexLocker locker(mutex);
 
-    // Check if this object type is already in the list
-    for (int objidx = 0; objidx < objects.length(); ++objidx) {
-        // Check if the object ID is in the list
-        if (objects[objidx].length() > 0) {
-            if ((name != NULL && objects[objidx][0]->getName().compare(name) == 0) || (name == NULL && objects[objidx][0]->getObjID() == objId)) {
-                // Look for the requested instance ID
-                for (int instidx = 0; instidx < objects[objidx].length(); ++instidx) {
-                    if (objects[objidx][instidx]->getInstID() == instId) {
-                        return objects[objidx][instidx];
-                    }
-                }
+    // Look up the object type in the flat index
+    int objidx = (name != NULL) ? objectsByName.value(*name, -1) : objectsById.value(objId, -1);
+
+    if (objidx >= 0) {
+        const QList<UAVObject *> &instances = objects[objidx];
+        // Instance IDs are assigned consecutively at registration, so the
+        // instance usually sits at its own index
+        if ((instId < (quint32)instances.length()) && (instances[instId]->getInstID() == instId)) {
+            return instances[instId];
+        }
+        // Fall back to a scan in case the list is not in instance ID order
+        for (int instidx = 0; instidx < instances.length(); ++instidx) {
+            if (instances[instidx]->getInstID() == instId) {
+                return instances[instidx];
             }
         }
     }
@@ -270,14 +407,11 @@ QList<UAVObject *> UAVObjectManager::getObjectInstances(const QString *name, qui
 {
     QMutexLocker locker(mutex);
 
-    // Check if this object type is already in the list
-    for (int objidx = 0; objidx < objects.length(); ++objidx) {
-        // Check if the object ID is in the list
-        if (objects[objidx].length() > 0) {
-            if ((name != NULL && objects[objidx][0]->getName().compare(name) == 0) || (name == NULL && objects[objidx][0]->getObjID() == objId)) {
-                return objects[objidx];
-            }
-        }
+    // Look up the object type in the flat index
+    int objidx = (name != NULL) ? objectsByName.value(*name, -1) : objectsById.value(objId, -1);
+
+    if (objidx >= 0) {
+        return objects[objidx];
     }
     // If this point is reached then the requested object could not be found
     return QList<UAVObject *>();
@@ -299,7 +433,20 @@ qint32 UAVObjectManager::getNumInstances(quint32 objId)
     return getNumInstances(NULL, objId);
 }
 
-void UAVObjectManager::toJson(QJsonObject &jsonObject, UAVObjectManager::JSON_EXPORT_OPTION what)
+/**
+ * Create a coalesced subscription to a set of objects.
+ *
+ * Subscribers receive at most maxRateHz batched objectsUpdated()
+ * notifications per second instead of one objectUpdated() per apply, see
+ * UAVObjectBatchSubscription. The caller owns the returned subscription and
+ * unsubscribes by deleting it.
+ */
+UAVObjectBatchSubscription *UAVObjectManager::createBatchSubscription(const QList<UAVObject *> &objs, int maxRateHz, QObject *parent)
+{
+    return new UAVObjectBatchSubscription(objs, maxRateHz, parent);
+}
+
+QList<UAVObject *> UAVObjectManager::getObjectsToExport(UAVObjectManager::JSON_EXPORT_OPTION what)
 {
     QList<UAVObject *> objects;
     QList< QList<UAVObject *> > allObjects = getObjects();
@@ -313,7 +460,12 @@ void UAVObjectManager::toJson(QJsonObject &jsonObject, UAVObjectManager::JSON_EX
             }
         }
     }
-    toJson(jsonObject, objects);
+    return objects;
+}
+
+void UAVObjectManager::toJson(QJsonObject &jsonObject, UAVObjectManager::JSON_EXPORT_OPTION what)
+{
+    toJson(jsonObject, getObjectsToExport(what));
 }
 
 void UAVObjectManager::toJson(QJsonObject &jsonObject, const QList<QString> &objectsToExport)
@@ -341,6 +493,36 @@ void UAVObjectManager::toJson(QJsonObject &jsonObject, const QList<UAVObject *>
     jsonObject["objects"] = jObjects;
 }
 
+/**
+ * Streaming variant of toJson() that writes straight to a device.
+ *
+ * The document is produced one object at a time, so memory use is bounded by
+ * the largest single object instead of the whole export. Use this when
+ * dumping full system state (settings export, streamservice) where building
+ * the complete QJsonDocument in memory stalls the GUI.
+ */
+void UAVObjectManager::toJson(QIODevice &device, UAVObjectManager::JSON_EXPORT_OPTION what)
+{
+    toJson(device, getObjectsToExport(what));
+}
+
+void UAVObjectManager::toJson(QIODevice &device, const QList<UAVObject *> &objectsToExport)
+{
+    device.write("{\"objects\":[");
+    bool first = true;
+    foreach(UAVObject * object, objectsToExport) {
+        QJsonObject jObject;
+
+        object->toJson(jObject);
+        if (!first) {
+            device.write(",");
+        }
+        first = false;
+        device.write(QJsonDocument(jObject).toJson(QJsonDocument::Compact));
+    }
+    device.write("]}");
+}
+
 void UAVObjectManager::fromJson(const QJsonObject &jsonObject, QList<UAVObject *> *updatedObjects)
 {
     QJsonArray jObjects = jsonObject["objects"].toArray();
@@ -364,14 +546,11 @@ qint32 UAVObjectManager::getNumInstances(const QString *name, quint32 objId)
 {
     QMutexLocker locker(mutex);
 
-    // Check if this object type is already in the list
-    for (int objidx = 0; objidx < objects.length(); ++objidx) {
-        // Check if the object ID is in the list
-        if (objects[objidx].length() > 0) {
-            if ((name != NULL && objects[objidx][0]->getName().compare(name) == 0) || (name == NULL && objects[objidx][0]->getObjID() == objId)) {
-                return objects[objidx].length();
-            }
-        }
+    // Look up the object type in the flat index
+    int objidx = (name != NULL) ? objectsByName.value(*name, -1) : objectsById.value(objId, -1);
+
+    if (objidx >= 0) {
+        return objects[objidx].length();
     }
     // If this point is reached then the requested object could not be found
     return -1;
@@ -33,10 +33,13 @@
 #include "uavdataobject.h"
 #include "uavmetaobject.h"
 #include <QList>
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QJsonObject>
 
+class QIODevice;
+
 class UAVOBJECTS_EXPORT UAVObjectManager : public QObject {
     Q_OBJECT
 
@@ -45,8 +48,13 @@ public:
     UAVObjectManager();
     ~UAVObjectManager();
 
+    typedef UAVDataObject *(*ObjectCreator)();
+
     bool registerObject(UAVDataObject *obj);
+    void registerObjects(const QList<ObjectCreator> &creators);
+    QList<UAVObject *> createObjectInstances(quint32 objId, quint32 instanceCount);
     QList< QList<UAVObject *> > getObjects();
+    QList<UAVObject *> getObjectTypes();
     QList< QList<UAVDataObject *> > getDataObjects();
     QList< QList<UAVMetaObject *> > getMetaObjects();
     UAVObject *getObject(const QString & name, quint32 instId = 0);
@@ -55,23 +63,34 @@ public:
     QList<UAVObject *> getObjectInstances(quint32 objId);
     qint32 getNumInstances(const QString & name);
     qint32 getNumInstances(quint32 objId);
+    quint64 getMemoryUsed();
+
+    class UAVObjectBatchSubscription *createBatchSubscription(const QList<UAVObject *> &objs, int maxRateHz, QObject *parent = NULL);
 
     void toJson(QJsonObject &jsonObject, JSON_EXPORT_OPTION what = JSON_EXPORT_ALL);
     void toJson(QJsonObject &jsonObject, const QList<QString> &objectsToExport);
     void toJson(QJsonObject &jsonObject, const QList<UAVObject *> &objectsToExport);
+    void toJson(QIODevice &device, JSON_EXPORT_OPTION what = JSON_EXPORT_ALL);
+    void toJson(QIODevice &device, const QList<UAVObject *> &objectsToExport);
     void fromJson(const QJsonObject &jsonObject, QList<UAVObject *> *updatedObjects = NULL);
 
 signals:
     void newObject(UAVObject *obj);
     void newInstance(UAVObject *obj);
+    void newInstances(QList<UAVObject *> objs);
 
 private:
     static const quint32 MAX_INSTANCES = 1000;
 
     QList< QList<UAVObject *> > objects;
+    // Flat indices into the objects list, maintained at registration so that
+    // the per-frame getObject() lookups are O(1) instead of a linear walk
+    QHash<quint32, int> objectsById;
+    QHash<QString, int> objectsByName;
     QMutex *mutex;
 
     void addObject(UAVObject *obj);
+    QList<UAVObject *> getObjectsToExport(JSON_EXPORT_OPTION what);
     UAVObject *getObject(const QString *name, quint32 objId, quint32 instId);
     QList<UAVObject *> getObjectInstances(const QString *name, quint32 objId);
     qint32 getNumInstances(const QString *name, quint32 objId);
@@ -3,7 +3,7 @@ TARGET = UAVObjects
 
 DEFINES += UAVOBJECTS_LIBRARY
 
-QT += qml
+QT += qml concurrent
 
 include(../../plugin.pri)
 include(uavobjects_dependencies.pri)
@@ -15,6 +15,7 @@ HEADERS += \
     uavobjectmanager.h \
     uavdataobject.h \
     uavobjectfield.h \
+    uavobjectbatchsubscription.h \
     uavobjectsinit.h \
     uavobjectsplugin.h
 
@@ -24,6 +25,7 @@ SOURCES += \
     uavobjectmanager.cpp \
     uavdataobject.cpp \
     uavobjectfield.cpp \
+    uavobjectbatchsubscription.cpp \
     uavobjectsplugin.cpp
 
 OTHER_FILES += UAVObjects.pluginspec
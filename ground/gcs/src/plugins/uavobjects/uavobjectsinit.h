@@ -28,8 +28,10 @@
 #ifndef UAVOBJECTSINIT_H
 #define UAVOBJECTSINIT_H
 
+#include "uavobjects_global.h"
 #include "uavobjectmanager.h"
 
-void UAVObjectsInitialize(UAVObjectManager *objMngr);
+UAVOBJECTS_EXPORT void UAVObjectsInitialize(UAVObjectManager *objMngr);
+UAVOBJECTS_EXPORT UAVObjectManager::ObjectCreator UAVObjectsGetCreator(quint32 objId);
 
 #endif // UAVOBJECTSINIT_H
@@ -29,6 +29,9 @@
 #include "uavobjectsinit.h"
 #include "uavobjectmanager.h"
 
+#include <coreplugin/memorydiagnostics.h>
+#include <extensionsystem/pluginmanager.h>
+
 UAVObjectsPlugin::UAVObjectsPlugin()
 {}
 
@@ -46,6 +49,15 @@ bool UAVObjectsPlugin::initialize(const QStringList & arguments, QString *errorS
     addAutoReleasedObject(objMngr);
     // Initialize UAVObjects
     UAVObjectsInitialize(objMngr);
+
+    // attribute the object data buffers in the memory report
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    Core::MemoryDiagnostics *memoryDiagnostics = pm->getObject<Core::MemoryDiagnostics>();
+    if (memoryDiagnostics != NULL) {
+        memoryDiagnostics->registerSource("UAVObject data buffers", [objMngr]() {
+            return objMngr->getMemoryUsed();
+        });
+    }
     // Done
     Q_UNUSED(arguments);
     Q_UNUSED(errorString);
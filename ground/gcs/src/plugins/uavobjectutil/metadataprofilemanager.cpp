@@ -0,0 +1,224 @@
+/**
+ ******************************************************************************
+ *
+ * @file       metadataprofilemanager.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectUtilPlugin UAVObjectUtil Plugin
+ * @{
+ * @brief      The UAVUObjects GCS utility plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "metadataprofilemanager.h"
+
+#include "extensionsystem/pluginmanager.h"
+#include "uavobjectmanager.h"
+#include "uavdataobject.h"
+#include "uavmetaobject.h"
+#include <coreplugin/icore.h>
+
+#include <QSettings>
+#include <QDebug>
+
+MetadataProfileManager::MetadataProfileManager() :
+    m_applyTotal(0), m_applyDone(0), m_applyFailed(false)
+{
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+
+    objMngr = pm->getObject<UAVObjectManager>();
+    Q_ASSERT(objMngr);
+
+    loadProfiles();
+}
+
+MetadataProfileManager::~MetadataProfileManager()
+{}
+
+QStringList MetadataProfileManager::profileNames() const
+{
+    return m_profiles.keys();
+}
+
+void MetadataProfileManager::saveProfile(const QString &name)
+{
+    m_profiles.insert(name, captureCurrentMetadata());
+    saveProfiles();
+}
+
+void MetadataProfileManager::removeProfile(const QString &name)
+{
+    m_profiles.remove(name);
+    saveProfiles();
+}
+
+/**
+ * Apply a profile. The GCS-side metadata of every covered object changes
+ * immediately - setData() both updates the local copy and queues the meta
+ * object for transmission - and the changed meta objects go out as acked
+ * transactions, MAX_IN_FLIGHT of them concurrently. profileApplied() is
+ * emitted once the last ack (or final timeout) comes back.
+ */
+bool MetadataProfileManager::applyProfile(const QString &name)
+{
+    if (isApplying() || !m_profiles.contains(name)) {
+        return false;
+    }
+    const Profile &profile = m_profiles[name];
+
+    // collect the meta objects whose data actually changes
+    m_pending.clear();
+    foreach(const QList<UAVDataObject *> &instances, objMngr->getDataObjects()) {
+        UAVDataObject *obj = instances.first();
+
+        if (!profile.contains(obj->getName())) {
+            continue;
+        }
+        UAVObject::Metadata mdata   = profile[obj->getName()];
+        UAVObject::Metadata current = obj->getMetadata();
+        if (memcmp(&mdata, &current, sizeof(UAVObject::Metadata)) != 0) {
+            m_pending.append(obj->getMetaObject());
+        }
+    }
+
+    m_applyingProfile = name;
+    m_applyTotal  = m_pending.count();
+    m_applyDone   = 0;
+    m_applyFailed = false;
+    qDebug() << "MetadataProfileManager - applying profile" << name << ":" << m_applyTotal << "objects to update";
+
+    if (m_pending.isEmpty()) {
+        finishApply();
+        return true;
+    }
+    while ((m_inFlight.count() < MAX_IN_FLIGHT) && !m_pending.isEmpty()) {
+        sendNextMeta();
+    }
+    return true;
+}
+
+/**
+ * Push the next pending meta object into the transaction window
+ */
+void MetadataProfileManager::sendNextMeta()
+{
+    UAVMetaObject *meta = m_pending.takeFirst();
+
+    m_inFlight.append(meta);
+    connect(meta, SIGNAL(transactionCompleted(UAVObject *, bool)),
+            this, SLOT(metaTransactionCompleted(UAVObject *, bool)));
+    // applies GCS-side and triggers the acked transaction
+    meta->setData(m_profiles[m_applyingProfile][meta->getParentObject()->getName()]);
+}
+
+void MetadataProfileManager::metaTransactionCompleted(UAVObject *obj, bool success)
+{
+    UAVMetaObject *meta = dynamic_cast<UAVMetaObject *>(obj);
+
+    if (!meta || !m_inFlight.contains(meta)) {
+        return;
+    }
+    disconnect(meta, SIGNAL(transactionCompleted(UAVObject *, bool)),
+               this, SLOT(metaTransactionCompleted(UAVObject *, bool)));
+    m_inFlight.removeOne(meta);
+    m_applyDone++;
+    if (!success) {
+        qWarning() << "MetadataProfileManager - metadata update not acked for" << meta->getParentObject()->getName();
+        m_applyFailed = true;
+    }
+    emit applyProgress(m_applyDone, m_applyTotal);
+
+    if (!m_pending.isEmpty()) {
+        sendNextMeta();
+    } else if (m_inFlight.isEmpty()) {
+        finishApply();
+    }
+}
+
+void MetadataProfileManager::finishApply()
+{
+    QString name = m_applyingProfile;
+
+    m_applyingProfile.clear();
+    emit profileApplied(name, !m_applyFailed);
+}
+
+MetadataProfileManager::Profile MetadataProfileManager::captureCurrentMetadata() const
+{
+    Profile profile;
+
+    foreach(const QList<UAVDataObject *> &instances, objMngr->getDataObjects()) {
+        UAVDataObject *obj = instances.first();
+
+        profile.insert(obj->getName(), obj->getMetadata());
+    }
+    return profile;
+}
+
+void MetadataProfileManager::loadProfiles()
+{
+    QSettings *settings = Core::ICore::instance()->settings();
+
+    settings->beginGroup("MetadataProfiles");
+    foreach(const QString &name, settings->childGroups()) {
+        settings->beginGroup(name);
+        Profile profile;
+        foreach(const QString &objName, settings->childKeys()) {
+            QStringList values = settings->value(objName).toString().split(',');
+
+            if (values.count() != 4) {
+                continue;
+            }
+            UAVObject::Metadata mdata;
+            mdata.flags = values.at(0).toUInt();
+            mdata.flightTelemetryUpdatePeriod = values.at(1).toUInt();
+            mdata.gcsTelemetryUpdatePeriod    = values.at(2).toUInt();
+            mdata.loggingUpdatePeriod = values.at(3).toUInt();
+            profile.insert(objName, mdata);
+        }
+        settings->endGroup();
+        m_profiles.insert(name, profile);
+    }
+    settings->endGroup();
+}
+
+void MetadataProfileManager::saveProfiles() const
+{
+    QSettings *settings = Core::ICore::instance()->settings();
+
+    settings->beginGroup("MetadataProfiles");
+    settings->remove("");
+    QMapIterator<QString, Profile> iter(m_profiles);
+    while (iter.hasNext()) {
+        iter.next();
+        settings->beginGroup(iter.key());
+        QHashIterator<QString, UAVObject::Metadata> objIter(iter.value());
+        while (objIter.hasNext()) {
+            objIter.next();
+            const UAVObject::Metadata &mdata = objIter.value();
+            settings->setValue(objIter.key(), QString("%1,%2,%3,%4")
+                               .arg(mdata.flags)
+                               .arg(mdata.flightTelemetryUpdatePeriod)
+                               .arg(mdata.gcsTelemetryUpdatePeriod)
+                               .arg(mdata.loggingUpdatePeriod));
+        }
+        settings->endGroup();
+    }
+    settings->endGroup();
+}
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ *
+ * @file       metadataprofilemanager.h
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2016.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectUtilPlugin UAVObjectUtil Plugin
+ * @{
+ * @brief      The UAVUObjects GCS utility plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef METADATAPROFILEMANAGER_H
+#define METADATAPROFILEMANAGER_H
+
+#include "uavobjectutil_global.h"
+
+#include "uavobject.h"
+
+#include <QObject>
+#include <QMap>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+
+class UAVObjectManager;
+class UAVMetaObject;
+
+/**
+ * Named metadata profiles ("bench", "flight-test", "endurance", ...) over
+ * the whole object set. A profile maps object names to metadata; applying
+ * one updates the GCS-side metadata of every covered object in one pass
+ * and pipelines the changed meta objects to the flight side as a window
+ * of concurrent acked transactions, instead of one transaction at a time.
+ * Objects whose metadata already matches the profile cause no traffic.
+ *
+ * Profiles persist in the GCS settings under "MetadataProfiles".
+ */
+class UAVOBJECTUTIL_EXPORT MetadataProfileManager : public QObject {
+    Q_OBJECT
+
+public:
+    // ! Object name -> metadata to apply to that object
+    typedef QHash<QString, UAVObject::Metadata> Profile;
+
+    MetadataProfileManager();
+    ~MetadataProfileManager();
+
+    QStringList profileNames() const;
+    // ! Snapshot the current metadata of all data objects under the given name
+    void saveProfile(const QString &name);
+    void removeProfile(const QString &name);
+
+    // ! Start applying the profile, returns false if unknown or already applying
+    bool applyProfile(const QString &name);
+    bool isApplying() const
+    {
+        return !m_applyingProfile.isEmpty();
+    }
+
+signals:
+    void applyProgress(int applied, int total);
+    // ! success is false if any meta object was not acked by the flight side
+    void profileApplied(QString name, bool success);
+
+private slots:
+    void metaTransactionCompleted(UAVObject *obj, bool success);
+
+private:
+    // In-flight transaction window, kept below the telemetry queue size so
+    // an apply never pushes regular telemetry out of the queue
+    static const int MAX_IN_FLIGHT = 8;
+
+    void sendNextMeta();
+    void finishApply();
+    Profile captureCurrentMetadata() const;
+    void loadProfiles();
+    void saveProfiles() const;
+
+    UAVObjectManager *objMngr;
+    QMap<QString, Profile> m_profiles;
+
+    // state of the apply in progress
+    QString m_applyingProfile;
+    QList<UAVMetaObject *> m_pending;
+    QList<UAVMetaObject *> m_inFlight;
+    int  m_applyTotal;
+    int  m_applyDone;
+    bool m_applyFailed;
+};
+
+#endif // METADATAPROFILEMANAGER_H
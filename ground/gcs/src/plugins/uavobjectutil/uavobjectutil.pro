@@ -11,11 +11,13 @@ HEADERS += \
     uavobjectutilmanager.h \
     uavobjectutilplugin.h \
     devicedescriptorstruct.h \
-    uavobjecthelper.h
+    uavobjecthelper.h \
+    metadataprofilemanager.h
 
 SOURCES += \
     uavobjectutilmanager.cpp \
     uavobjectutilplugin.cpp \
-    uavobjecthelper.cpp
+    uavobjecthelper.cpp \
+    metadataprofilemanager.cpp
 
 OTHER_FILES += UAVObjectUtil.pluginspec
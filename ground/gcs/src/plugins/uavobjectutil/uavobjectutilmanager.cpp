@@ -39,14 +39,23 @@
 #include <QDebug>
 #include <QEventLoop>
 #include <QTimer>
+#include <QSet>
 
 // ******************************
 // constructor/destructor
 
+// Save requests are retried a few times before they are given up on, so a
+// transient telemetry drop does not fail a long settings restore.
+static const int maxSaveAttempts = 3;
+
 UAVObjectUtilManager::UAVObjectUtilManager()
 {
-    mutex     = new QMutex(QMutex::Recursive);
-    saveState = IDLE;
+    mutex        = new QMutex(QMutex::Recursive);
+    saveState    = IDLE;
+    saveAttempts = 0;
+    batchTotal   = 0;
+    batchSaved   = 0;
+    batchFailed  = 0;
     failureTimer.stop();
     failureTimer.setSingleShot(true);
     failureTimer.setInterval(1000);
@@ -88,19 +97,112 @@ UAVObjectManager *UAVObjectUtilManager::getObjectManager()
 // SD card saving
 //
 
+/*
+   Add an object to the save queue, dropping duplicates. Saving the same
+   object twice in a row would only write identical data to flash again.
+ */
+void UAVObjectUtilManager::enqueueSave(UAVObject *obj)
+{
+    if (queue.contains(obj)) {
+        return;
+    }
+    queue.enqueue(obj);
+    ++batchTotal;
+}
+
+/*
+   Account for a finished (or given up on) save and report consolidated
+   progress. Once the queue has drained a single summary signal is emitted
+   instead of leaving callers to count individual saveCompleted signals.
+ */
+void UAVObjectUtilManager::saveDone(bool success)
+{
+    if (success) {
+        ++batchSaved;
+    } else {
+        ++batchFailed;
+    }
+    emit saveProgress(batchSaved + batchFailed, batchTotal);
+    if (queue.isEmpty()) {
+        emit saveQueueCompleted(batchSaved, batchFailed);
+        batchTotal  = 0;
+        batchSaved  = 0;
+        batchFailed = 0;
+    }
+}
+
 /*
    Add a new object to save in the queue
  */
 void UAVObjectUtilManager::saveObjectToSD(UAVObject *obj)
 {
-    // Add to queue
-    queue.enqueue(obj);
-    qDebug() << "Enqueue object: " << obj->getName();
+    bool wasIdle = queue.isEmpty();
 
+    enqueueSave(obj);
+    qDebug() << "Enqueue object: " << obj->getName();
 
-    // If queue length is one, then start sending (call sendNextObject)
+    // If the queue was empty, then start sending (call saveNextObject)
     // Otherwise, do nothing, it's sending anyway
-    if (queue.length() == 1) {
+    if (wasIdle) {
+        saveNextObject();
+    }
+}
+
+/*
+   Queue a batch of objects to save. Duplicates are dropped and, when the
+   batch covers every settings object known to the system, the whole batch is
+   collapsed into a single all settings save : one ObjectPersistence
+   transaction instead of one flash commit round trip per object, which makes
+   a full configuration save link-limited instead of round-trip-limited.
+ */
+void UAVObjectUtilManager::saveObjectsToSD(QList<UAVObject *> objs)
+{
+    bool wasIdle = queue.isEmpty();
+
+    // Check whether the batch covers the full settings set
+    QSet<quint32> batchIds;
+    foreach(UAVObject * obj, objs) {
+        UAVDataObject *dobj = dynamic_cast<UAVDataObject *>(obj);
+
+        if (dobj && dobj->isSettingsObject()) {
+            batchIds.insert(dobj->getObjID());
+        }
+    }
+    int settingsCount = 0;
+    foreach(QList<UAVDataObject *> instances, getObjectManager()->getDataObjects()) {
+        if (instances.first()->isSettingsObject()) {
+            ++settingsCount;
+        }
+    }
+
+    if ((batchIds.count() == objs.count()) && (batchIds.count() == settingsCount)) {
+        qDebug() << "Enqueue batch of" << objs.count() << "objects, consolidated into an all settings save";
+        enqueueSave(NULL);
+    } else {
+        qDebug() << "Enqueue batch of" << objs.count() << "objects";
+        foreach(UAVObject * obj, objs) {
+            enqueueSave(obj);
+        }
+    }
+
+    if (wasIdle) {
+        saveNextObject();
+    }
+}
+
+/*
+   Queue a save of all settings objects at once. The board commits them in a
+   single ObjectPersistence transaction instead of one round trip per object.
+ */
+void UAVObjectUtilManager::saveAllSettingsToSD()
+{
+    bool wasIdle = queue.isEmpty();
+
+    // A NULL queue entry stands for the all settings save
+    enqueueSave(NULL);
+    qDebug() << "Enqueue all settings save";
+
+    if (wasIdle) {
         saveNextObject();
     }
 }
@@ -115,21 +217,26 @@ void UAVObjectUtilManager::saveNextObject()
 
     // Get next object from the queue
     UAVObject *obj = queue.head();
-    qDebug() << "Send save object request to board " << obj->getName();
+    qDebug() << "Send save object request to board " << (obj ? obj->getName() : QString("(all settings)"));
 
     ObjectPersistence *objper = dynamic_cast<ObjectPersistence *>(getObjectManager()->getObject(ObjectPersistence::NAME));
     connect(objper, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(objectPersistenceTransactionCompleted(UAVObject *, bool)));
     connect(objper, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectPersistenceUpdated(UAVObject *)));
     saveState = AWAITING_ACK;
+
+    ObjectPersistence::DataFields data;
+    data.Operation = ObjectPersistence::OPERATION_SAVE;
     if (obj != NULL) {
-        ObjectPersistence::DataFields data;
-        data.Operation  = ObjectPersistence::OPERATION_SAVE;
         data.Selection  = ObjectPersistence::SELECTION_SINGLEOBJECT;
         data.ObjectID   = obj->getObjID();
         data.InstanceID = obj->getInstID();
-        objper->setData(data);
-        objper->updated();
+    } else {
+        data.Selection  = ObjectPersistence::SELECTION_ALLSETTINGS;
+        data.ObjectID   = 0;
+        data.InstanceID = 0;
     }
+    objper->setData(data);
+    objper->updated();
     // Now: we are going to get two "objectUpdated" messages (one coming from GCS, one coming from Flight, which
     // will confirm the object was properly received by both sides) and then one "transactionCompleted" indicating
     // that the Flight side did not only receive the object but it did receive it without error. Last we will get
@@ -158,16 +265,12 @@ void UAVObjectUtilManager::objectPersistenceTransactionCompleted(UAVObject *obj,
         // the queue:
         saveState = AWAITING_COMPLETED;
         disconnect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(objectPersistenceTransactionCompleted(UAVObject *, bool)));
-        failureTimer.start(2000); // Create a timeout
+        // writing all settings to flash takes the board considerably longer
+        failureTimer.start(queue.head() ? 2000 : 5000); // Create a timeout
     } else {
-        // Can be caused by timeout errors on sending.  Forget it and send next.
+        // Can be caused by timeout errors on sending.  Retry or give up.
         qDebug() << "objectPersistenceTranscationCompleted (error)";
-        UAVObject *obj = getObjectManager()->getObject(ObjectPersistence::NAME);
-        obj->disconnect(this);
-        queue.dequeue(); // We can now remove the object, it failed anyway.
-        saveState = IDLE;
-        emit saveCompleted(obj->getField("ObjectID")->getValue().toInt(), false);
-        saveNextObject();
+        objectPersistenceSaveFailed();
     }
 }
 
@@ -178,23 +281,36 @@ void UAVObjectUtilManager::objectPersistenceTransactionCompleted(UAVObject *obj,
 void UAVObjectUtilManager::objectPersistenceOperationFailed()
 {
     if (saveState == AWAITING_COMPLETED) {
-        // TODO: some warning that this operation failed somehow
-        // We have to disconnect the object persistence 'updated' signal
-        // and ask to save the next object:
-
-        ObjectPersistence *objectPersistence = ObjectPersistence::GetInstance(getObjectManager());
-        Q_ASSERT(objectPersistence);
+        objectPersistenceSaveFailed();
+    }
+}
 
-        UAVObject *obj = queue.dequeue(); // We can now remove the object, it failed anyway.
-        Q_ASSERT(obj);
+/**
+ * @brief Common handling of a failed save request. The object stays at the
+ * head of the queue and is retried a few times before it is given up on and
+ * reported as failed, so a transient telemetry drop does not lose it.
+ */
+void UAVObjectUtilManager::objectPersistenceSaveFailed()
+{
+    ObjectPersistence *objectPersistence = ObjectPersistence::GetInstance(getObjectManager());
 
-        objectPersistence->disconnect(this);
+    Q_ASSERT(objectPersistence);
+    objectPersistence->disconnect(this);
 
-        saveState = IDLE;
-        emit saveCompleted(obj->getObjID(), false);
+    saveState = IDLE;
 
+    if (++saveAttempts < maxSaveAttempts) {
+        qDebug() << "Retrying save of object";
         saveNextObject();
+        return;
     }
+
+    UAVObject *obj = queue.dequeue(); // We can now remove the object, it failed anyway.
+    saveAttempts = 0;
+    emit saveCompleted(obj ? obj->getObjID() : 0, false);
+    saveDone(false);
+
+    saveNextObject();
 }
 
 
@@ -215,18 +331,20 @@ void UAVObjectUtilManager::objectPersistenceUpdated(UAVObject *obj)
     } else if (saveState == AWAITING_COMPLETED &&
                objectPersistence.Operation == ObjectPersistence::OPERATION_COMPLETED) {
         failureTimer.stop();
-        // Check right object saved
+        // Check right object saved (an all settings save has no object to check)
         UAVObject *savingObj = queue.head();
-        if (objectPersistence.ObjectID != savingObj->getObjID()) {
+        if (savingObj && (objectPersistence.ObjectID != savingObj->getObjID())) {
             objectPersistenceOperationFailed();
             return;
         }
 
         obj->disconnect(this);
         queue.dequeue(); // We can now remove the object, it's done.
-        saveState = IDLE;
+        saveState    = IDLE;
+        saveAttempts = 0;
 
         emit saveCompleted(objectPersistence.ObjectID, true);
+        saveDone(true);
         saveNextObject();
     }
 }
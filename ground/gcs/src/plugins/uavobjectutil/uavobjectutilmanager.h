@@ -68,17 +68,32 @@ public:
     static bool descriptionToStructure(QByteArray desc, deviceDescriptorStruct & struc);
     UAVObjectManager *getObjectManager();
     void saveObjectToSD(UAVObject *obj);
+    void saveObjectsToSD(QList<UAVObject *> objs);
+    void saveAllSettingsToSD();
 protected:
     FirmwareIAPObj::DataFields getFirmwareIap();
 
 signals:
     void saveCompleted(int objectID, bool status);
+    // Consolidated reporting for queued saves : progress after each completed
+    // operation and a single summary when the queue drains
+    void saveProgress(int completed, int total);
+    void saveQueueCompleted(int saved, int failed);
 
 private:
     QMutex *mutex;
+    // a NULL entry stands for an all settings save
     QQueue<UAVObject *> queue;
     enum { IDLE, AWAITING_ACK, AWAITING_COMPLETED } saveState;
+    int saveAttempts;
+    // Consolidated completion accounting over the current queue run
+    int batchTotal;
+    int batchSaved;
+    int batchFailed;
+    void enqueueSave(UAVObject *obj);
+    void saveDone(bool success);
     void saveNextObject();
+    void objectPersistenceSaveFailed();
     QTimer failureTimer;
 
     ExtensionSystem::PluginManager *pm;
@@ -27,6 +27,7 @@
  */
 
 #include "uavobjectutilplugin.h"
+#include "metadataprofilemanager.h"
 
 UAVObjectUtilPlugin::UAVObjectUtilPlugin()
 {}
@@ -46,6 +47,9 @@ bool UAVObjectUtilPlugin::initialize(const QStringList & arguments, QString *err
     UAVObjectUtilManager * objUtilMngr = new UAVObjectUtilManager();
     addAutoReleasedObject(objUtilMngr);
 
+    // Named metadata profiles, exposed the same way
+    addAutoReleasedObject(new MetadataProfileManager());
+
     return true;
 }
 
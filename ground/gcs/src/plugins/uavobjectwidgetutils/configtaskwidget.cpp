@@ -58,6 +58,12 @@ ConfigTaskWidget::ConfigTaskWidget(QWidget *parent) : QWidget(parent), m_current
     connect(telMngr, SIGNAL(disconnected()), this, SIGNAL(autoPilotDisconnected()), Qt::UniqueConnection);
     UAVSettingsImportExportFactory *importexportplugin = m_pluginManager->getObject<UAVSettingsImportExportFactory>();
     connect(importexportplugin, SIGNAL(importAboutToBegin()), this, SLOT(invalidateObjects()));
+
+    // coalesces telemetry driven widget refreshes into one pass per tick
+    m_refreshBatchTimer = new QTimer(this);
+    m_refreshBatchTimer->setSingleShot(true);
+    m_refreshBatchTimer->setInterval(100);
+    connect(m_refreshBatchTimer, SIGNAL(timeout()), this, SLOT(processBatchedRefresh()));
 }
 
 void ConfigTaskWidget::addWidget(QWidget *widget)
@@ -342,16 +348,53 @@ void ConfigTaskWidget::refreshWidgetsValues(UAVObject *obj)
         return;
     }
 
+    if (obj != NULL) {
+        // Telemetry driven update : batch it. The objects that changed are
+        // collected and their bindings refreshed once per tick, masked to
+        // the fields whose values actually changed, so a page binding
+        // dozens of widgets to hot objects stays responsive.
+        m_pendingRefreshObjects.insert(obj);
+        if (!m_refreshBatchTimer->isActive()) {
+            m_refreshBatchTimer->start();
+        }
+        return;
+    }
+
+    // explicit full refresh, touch every widget now
+    m_pendingRefreshObjects.clear();
+    m_refreshBatchTimer->stop();
+    doRefreshWidgetsValues(NULL);
+}
+
+void ConfigTaskWidget::processBatchedRefresh()
+{
+    QSet<UAVObject *> pending = m_pendingRefreshObjects;
+
+    m_pendingRefreshObjects.clear();
+    foreach(UAVObject * obj, pending) {
+        doRefreshWidgetsValues(obj);
+    }
+}
+
+void ConfigTaskWidget::doRefreshWidgetsValues(UAVObject *obj)
+{
     bool dirtyBack = isDirty();
+
     emit refreshWidgetsValuesRequested();
     QList<WidgetBinding *> bindings = obj == NULL ? m_widgetBindingsPerObject.values() : m_widgetBindingsPerObject.values(obj);
     foreach(WidgetBinding * binding, bindings) {
         if (binding->field() != NULL && binding->widget() != NULL) {
+            // change mask : skip widgets whose underlying value did not
+            // change, full refreshes (obj == NULL) bypass the mask
+            if (obj != NULL && !binding->hasFieldValueChanged()) {
+                continue;
+            }
             if (binding->isEnabled()) {
                 setWidgetFromField(binding->widget(), binding->field(), binding);
             } else {
                 binding->updateValueFromObjectField();
             }
+            binding->markRefreshed();
         }
     }
     setDirty(dirtyBack);
@@ -1273,6 +1316,22 @@ void WidgetBinding::updateValueFromObjectField()
     }
 }
 
+bool WidgetBinding::hasFieldValueChanged() const
+{
+    if (m_field == NULL) {
+        return true;
+    }
+    // an invalid (never refreshed) mask always counts as changed
+    return m_field->getValue(m_index) != m_lastRefreshedValue;
+}
+
+void WidgetBinding::markRefreshed()
+{
+    if (m_field != NULL) {
+        m_lastRefreshedValue = m_field->getValue(m_index);
+    }
+}
+
 ShadowWidgetBinding::ShadowWidgetBinding(QWidget *widget, double scale, bool isLimited)
 {
     m_widget    = widget;
@@ -33,6 +33,7 @@
 
 #include <QWidget>
 #include <QList>
+#include <QSet>
 #include <QVariant>
 
 class UAVObject;
@@ -86,6 +87,11 @@ public:
     void updateObjectFieldFromValue();
     void updateValueFromObjectField();
 
+    // change mask for batched refreshes : true while the field value at
+    // this binding's index differs from the one last applied to the widget
+    bool hasFieldValueChanged() const;
+    void markRefreshed();
+
 private:
     UAVObject *m_object;
     UAVObjectField *m_field;
@@ -93,6 +99,7 @@ private:
     bool m_isEnabled;
     QList<ShadowWidgetBinding *> m_shadows;
     QVariant m_value;
+    QVariant m_lastRefreshedValue;
 };
 
 class UAVOBJECTWIDGETUTILS_EXPORT ConfigTaskWidget : public QWidget {
@@ -186,6 +193,7 @@ private slots:
     void objectUpdated(UAVObject *object);
     void defaultButtonClicked();
     void reloadButtonClicked();
+    void processBatchedRefresh();
 
 private:
     struct objectComparator {
@@ -231,6 +239,13 @@ private:
     QString m_outOfLimitsStyle;
     QTimer *m_realtimeUpdateTimer;
 
+    // telemetry driven refreshes are coalesced : objects collect here and
+    // their bindings are refreshed once per timer tick, change masked
+    QSet<UAVObject *> m_pendingRefreshObjects;
+    QTimer *m_refreshBatchTimer;
+
+    void doRefreshWidgetsValues(UAVObject *obj);
+
     bool setWidgetFromField(QWidget *widget, UAVObjectField *field, WidgetBinding *binding);
 
     QVariant getVariantFromWidget(QWidget *widget, WidgetBinding *binding);
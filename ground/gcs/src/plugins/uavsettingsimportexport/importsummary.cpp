@@ -33,7 +33,8 @@
 
 ImportSummaryDialog::ImportSummaryDialog(QWidget *parent) :
     QDialog(parent),
-    ui(new Ui::ImportSummaryDialog)
+    ui(new Ui::ImportSummaryDialog),
+    allSettingsSave(false)
 {
     ui->setupUi(this);
     setWindowTitle(tr("Import Summary"));
@@ -107,11 +108,14 @@ void ImportSummaryDialog::doTheSaving()
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
     UAVObjectUtilManager *utilManager  = pm->getObject<UAVObjectUtilManager>();
 
-    connect(utilManager, SIGNAL(saveCompleted(int, bool)), this, SLOT(updateSaveCompletion()));
+    connect(utilManager, SIGNAL(saveCompleted(int, bool)), this, SLOT(updateSaveCompletion(int, bool)), Qt::UniqueConnection);
 
+    rowsByObjectId.clear();
     for (int i = 0; i < ui->importSummaryList->rowCount(); i++) {
         QCheckBox *box = dynamic_cast<QCheckBox *>(ui->importSummaryList->cellWidget(i, 0));
         if (box->isChecked()) {
+            UAVObject *obj = objManager->getObject(ui->importSummaryList->item(i, 1)->text());
+            rowsByObjectId.insert((int)obj->getObjID(), i);
             ++itemCount;
         }
     }
@@ -120,24 +124,64 @@ void ImportSummaryDialog::doTheSaving()
     }
     ui->progressBar->setMaximum(itemCount + 1);
     ui->progressBar->setValue(1);
+
+    allSettingsSave = (itemCount == ui->importSummaryList->rowCount());
+    if (allSettingsSave) {
+        // Everything is checked, so one all settings transaction commits the
+        // whole restore instead of one acked round trip per object.
+        utilManager->saveAllSettingsToSD();
+    } else {
+        saveCheckedObjects();
+    }
+
+    ui->saveToFlash->setEnabled(false);
+    ui->closeButton->setEnabled(false);
+}
+
+/*
+   Queues an individual save request for every checked UAVObject
+ */
+void ImportSummaryDialog::saveCheckedObjects()
+{
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+    UAVObjectUtilManager *utilManager  = pm->getObject<UAVObjectUtilManager>();
+
     for (int i = 0; i < ui->importSummaryList->rowCount(); i++) {
-        QString uavObjectName = ui->importSummaryList->item(i, 1)->text();
         QCheckBox *box = dynamic_cast<QCheckBox *>(ui->importSummaryList->cellWidget(i, 0));
         if (box->isChecked()) {
-            UAVObject *obj = objManager->getObject(uavObjectName);
+            UAVObject *obj = objManager->getObject(ui->importSummaryList->item(i, 1)->text());
             utilManager->saveObjectToSD(obj);
-            this->repaint();
         }
     }
-
-    ui->saveToFlash->setEnabled(false);
-    ui->closeButton->setEnabled(false);
 }
 
+void ImportSummaryDialog::setRowStatus(int row, QString text)
+{
+    ui->importSummaryList->item(row, 2)->setText(text);
+}
 
-void ImportSummaryDialog::updateSaveCompletion()
+void ImportSummaryDialog::updateSaveCompletion(int objectID, bool status)
 {
-    ui->progressBar->setValue(ui->progressBar->value() + 1);
+    if (allSettingsSave) {
+        allSettingsSave = false;
+        if (status) {
+            foreach(int row, rowsByObjectId.values()) {
+                setRowStatus(row, tr("Saved"));
+            }
+            ui->progressBar->setValue(ui->progressBar->maximum());
+        } else {
+            // The single transaction did not complete, sweep the objects one
+            // by one instead so each row gets an individual verdict.
+            saveCheckedObjects();
+            return;
+        }
+    } else {
+        foreach(int row, rowsByObjectId.values(objectID)) {
+            setRowStatus(row, status ? tr("Saved") : tr("Save failed"));
+        }
+        ui->progressBar->setValue(ui->progressBar->value() + 1);
+    }
     if (ui->progressBar->value() == ui->progressBar->maximum()) {
         ui->saveToFlash->setEnabled(true);
         ui->closeButton->setEnabled(true);
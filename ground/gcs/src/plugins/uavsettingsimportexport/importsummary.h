@@ -34,6 +34,7 @@
 #include "uavobjectutil/uavobjectutilmanager.h"
 
 #include <QDialog>
+#include <QHash>
 
 namespace Ui {
 class ImportSummaryDialog;
@@ -54,8 +55,16 @@ protected:
 private:
     Ui::ImportSummaryDialog *ui;
 
+    // checked rows by object id, filled when the saving starts
+    QMultiHash<int, int> rowsByObjectId;
+    // true while a single all settings transaction is in flight
+    bool allSettingsSave;
+
+    void saveCheckedObjects();
+    void setRowStatus(int row, QString text);
+
 public slots:
-    void updateSaveCompletion();
+    void updateSaveCompletion(int objectID, bool status);
 
 private slots:
     void doTheSaving();
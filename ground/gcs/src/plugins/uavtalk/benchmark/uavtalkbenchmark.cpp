@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavtalkbenchmark.cpp
+ * @author     The LibrePilot Project, http://www.librepilot.org Copyright (C) 2026.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVTalkPlugin UAVTalk Plugin
+ * @{
+ * @brief      UAVTalk frame parse/CRC/dispatch throughput benchmark
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Feeds canned UAVTalk capture files (or a deterministic synthesized stream
+ * when no file is given) through the parser and reports objects/sec, MB/sec
+ * and heap allocations per frame, so changes to uavtalk.cpp and
+ * uavobject.cpp can be compared between commits:
+ *
+ *   uavtalkbenchmark [-n <repeats>] [capture.opl ...]
+ *
+ * Capture files are raw UAVTalk byte streams, e.g. the output of the relay
+ * mode or a logging session with the timestamped log header stripped.
+ */
+
+#include "uavtalk/uavtalk.h"
+#include "uavobjects/uavobjectmanager.h"
+#include "uavobjects/uavobjectsinit.h"
+
+#include <extensionsystem/pluginmanager.h>
+#include <coreplugin/generalsettings.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QBuffer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include <cstdlib>
+#include <new>
+
+// Heap allocation counter : every operator new in the process goes through
+// here, which is what "allocations per frame" is computed from. Counting
+// with a plain volatile is fine, the parse loop is single threaded.
+static volatile quint64 allocationCount = 0;
+
+void *operator new(size_t size)
+{
+    ++allocationCount;
+    void *p = malloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) throw()
+{
+    free(p);
+}
+
+static QByteArray synthesizeStream(UAVObjectManager *objMngr)
+{
+    // Serialize every data object a few times through a scratch UAVTalk
+    // instance. The content only depends on the object set, so runs on the
+    // same commit (and commits that do not touch the wire format) see an
+    // identical stream.
+    QBuffer buffer;
+
+    buffer.open(QIODevice::WriteOnly);
+    UAVTalk encoder(&buffer, objMngr);
+
+    for (int round = 0; round < 8; ++round) {
+        QList< QList<UAVDataObject *> > objects = objMngr->getDataObjects();
+        foreach(const QList<UAVDataObject *> &instances, objects) {
+            foreach(UAVDataObject * obj, instances) {
+                encoder.sendObject(obj, false, false);
+            }
+        }
+    }
+    return buffer.data();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QTextStream out(stdout);
+
+    int repeats = 20;
+    QStringList captureFiles;
+    QStringList arguments = application.arguments();
+    for (int i = 1; i < arguments.size(); ++i) {
+        if (arguments.at(i) == "-n" && (i + 1) < arguments.size()) {
+            repeats = arguments.at(++i).toInt();
+        } else {
+            captureFiles.append(arguments.at(i));
+        }
+    }
+
+    // UAVTalk reads the UDP mirror setting from the plugin object pool, so
+    // give it a plugin manager with default settings
+    ExtensionSystem::PluginManager pluginManager;
+    pluginManager.addObject(new Core::Internal::GeneralSettings());
+
+    UAVObjectManager objMngr;
+    UAVObjectsInitialize(&objMngr);
+
+    QByteArray stream;
+    if (captureFiles.isEmpty()) {
+        stream = synthesizeStream(&objMngr);
+        out << "no capture file given, synthesized " << stream.size() << " byte stream" << endl;
+    } else {
+        foreach(const QString &fileName, captureFiles) {
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) {
+                out << "cannot open " << fileName << endl;
+                return 1;
+            }
+            stream.append(file.readAll());
+        }
+    }
+
+    QBuffer buffer(&stream);
+    buffer.open(QIODevice::ReadOnly);
+    UAVTalk uavTalk(&buffer, &objMngr);
+
+    // warm up : first pass creates object instances and touches every page
+    uavTalk.processInputStream();
+    uavTalk.resetStats();
+
+    quint64 allocationsBefore = allocationCount;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < repeats; ++i) {
+        buffer.seek(0);
+        uavTalk.processInputStream();
+    }
+    qint64 elapsedMs = timer.elapsed();
+    quint64 allocations = allocationCount - allocationsBefore;
+
+    UAVTalk::ComStats stats = uavTalk.getStats();
+    double seconds = elapsedMs / 1000.0;
+    double megabytes = (double)repeats * stream.size() / (1024.0 * 1024.0);
+
+    out << "frames    : " << stats.rxObjects
+        << " (" << stats.rxCrcErrors << " crc errors, " << stats.rxSyncErrors << " sync errors)" << endl;
+    out << "elapsed   : " << elapsedMs << " ms" << endl;
+    out << "objects/s : " << (seconds > 0 ? stats.rxObjects / seconds : 0) << endl;
+    out << "MB/s      : " << (seconds > 0 ? megabytes / seconds : 0) << endl;
+    out << "allocs/frame : "
+        << (stats.rxObjects > 0 ? (double)allocations / stats.rxObjects : 0) << endl;
+
+    return stats.rxErrors > 0 ? 1 : 0;
+}
@@ -0,0 +1,36 @@
+#
+# UAVTalk parse throughput benchmark. Not part of the default build, run
+# qmake on this file to build it:
+#
+#   qmake uavtalkbenchmark.pro && make
+#   ./uavtalkbenchmark [-n <repeats>] [capture.opl ...]
+#
+# The GCS plugin libraries must have been built first.
+#
+include(../../../../gcs.pri)
+
+TEMPLATE = app
+TARGET = uavtalkbenchmark
+CONFIG += console
+CONFIG -= app_bundle
+
+QT += network widgets
+
+DESTDIR = $$GCS_APP_PATH
+
+INCLUDEPATH += $$GCS_SOURCE_TREE/src/plugins
+
+# link the plugin libraries the benchmark exercises
+LIBS += -L$$GCS_PLUGIN_PATH/$$ORG_BIG_NAME
+
+include(../../../libs/utils/utils.pri)
+include(../../../libs/extensionsystem/extensionsystem.pri)
+include(../uavtalk.pri)
+
+linux-* {
+    QMAKE_RPATHDIR  = $$shell_quote(\$$ORIGIN/$$relative_path($$GCS_LIBRARY_PATH, $$GCS_APP_PATH))
+    QMAKE_RPATHDIR += $$shell_quote(\$$ORIGIN/$$relative_path($$GCS_PLUGIN_PATH/$$ORG_BIG_NAME, $$GCS_APP_PATH))
+    include(../../../rpath.pri)
+}
+
+SOURCES += uavtalkbenchmark.cpp
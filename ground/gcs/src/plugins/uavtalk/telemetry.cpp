@@ -27,7 +27,9 @@
 
 #include "telemetry.h"
 #include "oplinksettings.h"
+#include "oplinkstatus.h"
 #include "objectpersistence.h"
+#include <utils/tracer.h>
 #include <QTime>
 #include <QtGlobal>
 #include <stdlib.h>
@@ -64,7 +66,7 @@ Telemetry::Telemetry(UAVTalk *utalk, UAVObjectManager *objMngr) : objMngr(objMng
     gcsStatsObj = GCSTelemetryStats::GetInstance(objMngr);
 
     // Setup and start the periodic timer
-    timeToNextUpdateMs = 0;
+    updateClock.start();
     updateTimer = new QTimer(this);
     connect(updateTimer, SIGNAL(timeout()), this, SLOT(processPeriodicUpdates()));
     updateTimer->start(1000);
@@ -72,6 +74,15 @@ Telemetry::Telemetry(UAVTalk *utalk, UAVObjectManager *objMngr) : objMngr(objMng
     // Setup and start the stats timer
     txErrors  = 0;
     txRetries = 0;
+
+    // Setup and start the rate governor
+    governorLevel    = 0;
+    govHealthyTicks  = 0;
+    govLastTxRetries = 0;
+    oplinkStatusObj  = OPLinkStatus::GetInstance(objMngr);
+    governorTimer    = new QTimer(this);
+    connect(governorTimer, SIGNAL(timeout()), this, SLOT(evaluateGovernor()));
+    governorTimer->start(GOV_EVAL_PERIOD_MS);
 }
 
 Telemetry::~Telemetry()
@@ -113,11 +124,56 @@ void Telemetry::addObject(UAVObject *obj)
     // If this point is reached, then the object type is new, let's add it
     ObjectTimeInfo timeInfo;
     timeInfo.obj = obj;
-    timeInfo.timeToNextUpdateMs = 0;
-    timeInfo.updatePeriodMs     = 0;
+    timeInfo.nextUpdateTime = 0;
+    timeInfo.updatePeriodMs = 0;
+    timeInfo.governorClass  = governorClassOf(obj);
     objList.append(timeInfo);
 }
 
+/**
+ * Classify an object for the rate governor
+ *
+ * The class decides how early the governor starts shedding the object's
+ * periodic rate when the link gets congested. Metaobjects and the System and
+ * Control categories (alarms, telemetry stats, manual control) are never
+ * throttled, State and Sensors only under heavy pressure, everything else
+ * first.
+ */
+Telemetry::GovernorClass Telemetry::governorClassOf(UAVObject *obj)
+{
+    if (dynamic_cast<UAVMetaObject *>(obj) != NULL) {
+        return CLASS_CRITICAL;
+    }
+    QString category = obj->getCategory();
+    if ((category == "System") || (category == "Control")) {
+        return CLASS_CRITICAL;
+    }
+    if ((category == "State") || (category == "Sensors")) {
+        return CLASS_STANDARD;
+    }
+    return CLASS_BULK;
+}
+
+/**
+ * Get the update period to actually schedule with, i.e. the configured period
+ * stretched by the governor according to the object's priority class.
+ *
+ * The governor never touches updatePeriodMs itself : metadata remains the
+ * single source of truth and the full rate is restored simply by the level
+ * dropping back to zero.
+ */
+qint32 Telemetry::effectiveUpdatePeriod(const ObjectTimeInfo &timeInfo)
+{
+    // Interval multipliers per governor level, indexed by priority class
+    static const qint32 scale[3][GOV_MAX_LEVEL + 1] = {
+        { 1, 1, 1, 1 }, // CLASS_CRITICAL
+        { 1, 1, 2, 4 }, // CLASS_STANDARD
+        { 1, 2, 4, 8 } // CLASS_BULK
+    };
+
+    return timeInfo.updatePeriodMs * scale[timeInfo.governorClass][governorLevel];
+}
+
 /**
  * Update the object's timers
  */
@@ -126,8 +182,15 @@ void Telemetry::setUpdatePeriod(UAVObject *obj, qint32 periodMs)
     // Find object type (not instance!) and update its period
     for (int n = 0; n < objList.length(); ++n) {
         if (objList[n].obj->getObjID() == obj->getObjID()) {
-            objList[n].updatePeriodMs     = periodMs;
-            objList[n].timeToNextUpdateMs = quint32((float)periodMs * (float)qrand() / (float)RAND_MAX); // avoid bunching of updates
+            objList[n].updatePeriodMs = periodMs;
+            if (periodMs > 0) {
+                // avoid bunching of updates by spreading the first deadline over one period
+                objList[n].nextUpdateTime = updateClock.elapsed() + qint64((float)periodMs * (float)qrand() / (float)RAND_MAX);
+                updateSchedule.insert(objList[n].nextUpdateTime, n);
+            } else {
+                // a schedule entry left behind is discarded lazily when it comes due
+                objList[n].nextUpdateTime = 0;
+            }
         }
     }
 }
@@ -239,6 +302,8 @@ void Telemetry::updateObject(UAVObject *obj, quint32 eventType)
  */
 void Telemetry::transactionCompleted(UAVObject *obj, bool success)
 {
+    GCS_TRACE_SCOPE("Telemetry::transactionCompleted");
+
     // Lookup the transaction in the transaction map.
     ObjectTransactionInfo *transInfo = findTransaction(obj);
 
@@ -349,20 +414,27 @@ void Telemetry::processObjectUpdates(UAVObject *obj, EventMask event, bool allIn
     objInfo.obj   = obj;
     objInfo.event = event;
     objInfo.allInstances = allInstances;
-    if (priority) {
-        if (objPriorityQueue.length() < MAX_QUEUE_SIZE) {
-            objPriorityQueue.enqueue(objInfo);
-        } else {
-            ++txErrors;
-            qWarning().nospace() << "Telemetry - !!! priority event queue is full, event lost " << obj->toStringBrief();
-            obj->emitTransactionCompleted(false);
+
+    QQueue<ObjectQueueInfo> &queue = priority ? objPriorityQueue : objQueue;
+
+    // Coalesce with an already queued event for the same object.
+    // The object data is packed at transmit time, so when the queue backs up
+    // behind a slow link a second entry would only transmit the same (or by
+    // then stale) sample again. Keeping the earlier queue position preserves
+    // the bounded latency of the first update.
+    bool coalesced = false;
+    for (int n = 0; n < queue.length(); ++n) {
+        if ((queue[n].obj == obj) && (queue[n].event == event) && (queue[n].allInstances == allInstances)) {
+            coalesced = true;
+            break;
         }
-    } else {
-        if (objQueue.length() < MAX_QUEUE_SIZE) {
-            objQueue.enqueue(objInfo);
+    }
+    if (!coalesced) {
+        if (queue.length() < MAX_QUEUE_SIZE) {
+            queue.enqueue(objInfo);
         } else {
             ++txErrors;
-            qWarning().nospace() << "Telemetry - !!! event queue is full, event lost " << obj->toStringBrief();
+            qWarning().nospace() << "Telemetry - !!! " << (priority ? "priority " : "") << "event queue is full, event lost " << obj->toStringBrief();
             obj->emitTransactionCompleted(false);
         }
     }
@@ -376,6 +448,8 @@ void Telemetry::processObjectUpdates(UAVObject *obj, EventMask event, bool allIn
  */
 void Telemetry::processObjectQueue()
 {
+    GCS_TRACE_SCOPE("Telemetry::processObjectQueue");
+
     // Get object information from queue (first the priority and then the regular queue)
     ObjectQueueInfo objInfo;
 
@@ -450,7 +524,9 @@ void Telemetry::processObjectQueue()
 
 /**
  * Check is any objects are pending for periodic updates
- * TODO: Clean-up
+ *
+ * The schedule is ordered by deadline, so each tick only touches the objects
+ * that are actually due instead of scanning the whole object list.
  */
 void Telemetry::processPeriodicUpdates()
 {
@@ -459,49 +535,102 @@ void Telemetry::processPeriodicUpdates()
     // Stop timer
     updateTimer->stop();
 
-    // Iterate through each object and update its timer, if zero then transmit object.
-    // Also calculate smallest delay to next update (will be used for setting timeToNextUpdateMs)
-    qint32 minDelay  = MAX_UPDATE_PERIOD_MS;
-    ObjectTimeInfo *objinfo;
-    qint32 elapsedMs = 0;
-    QTime time;
-    qint32 offset;
-    bool allInstances;
-    for (int n = 0; n < objList.length(); ++n) {
-        objinfo = &objList[n];
-        // If object is configured for periodic updates
-        if (objinfo->updatePeriodMs > 0) {
-            objinfo->timeToNextUpdateMs -= timeToNextUpdateMs;
-            // Check if time for the next update
-            if (objinfo->timeToNextUpdateMs <= 0) {
-                // Reset timer
-                offset = (-objinfo->timeToNextUpdateMs) % objinfo->updatePeriodMs;
-                objinfo->timeToNextUpdateMs = objinfo->updatePeriodMs - offset;
-                // Send object
-                time.start();
-                allInstances = !objinfo->obj->isSingleInstance();
-                processObjectUpdates(objinfo->obj, EV_UPDATED_PERIODIC, allInstances, false);
-                elapsedMs    = time.elapsed();
-                // Update timeToNextUpdateMs with the elapsed delay of sending the object;
-                timeToNextUpdateMs += elapsedMs;
-            }
-            // Update minimum delay
-            if (objinfo->timeToNextUpdateMs < minDelay) {
-                minDelay = objinfo->timeToNextUpdateMs;
-            }
+    // Pop due entries from the front of the schedule and transmit their objects.
+    // Entries whose key no longer matches the deadline stored in objList are
+    // stale (the period was changed or cleared since they were queued) and are
+    // simply dropped.
+    qint64 now = updateClock.elapsed();
+    while (!updateSchedule.isEmpty() && updateSchedule.firstKey() <= now) {
+        QMultiMap<qint64, int>::iterator it = updateSchedule.begin();
+        qint64 deadline = it.key();
+        int index = it.value();
+        updateSchedule.erase(it);
+
+        ObjectTimeInfo *objinfo = &objList[index];
+        if ((objinfo->updatePeriodMs <= 0) || (objinfo->nextUpdateTime != deadline)) {
+            // stale entry
+            continue;
         }
+
+        // Reschedule, skipping any update periods that are already overdue.
+        // The governor stretches the interval of low priority classes here,
+        // at reschedule time, so a level change takes effect within one period
+        // without disturbing the schedule.
+        qint64 periodMs = effectiveUpdatePeriod(*objinfo);
+        qint64 offset   = (now - deadline) % periodMs;
+        objinfo->nextUpdateTime = now + periodMs - offset;
+        updateSchedule.insert(objinfo->nextUpdateTime, index);
+
+        // Send object
+        bool allInstances = !objinfo->obj->isSingleInstance();
+        processObjectUpdates(objinfo->obj, EV_UPDATED_PERIODIC, allInstances, false);
+
+        // Account for the time spent sending the object
+        now = updateClock.elapsed();
     }
 
-    // Check if delay for the next update is too short
+    // Delay to the next deadline, clamped to the min and max update periods
+    qint64 minDelay = MAX_UPDATE_PERIOD_MS;
+    if (!updateSchedule.isEmpty()) {
+        minDelay = updateSchedule.firstKey() - now;
+    }
     if (minDelay < MIN_UPDATE_PERIOD_MS) {
         minDelay = MIN_UPDATE_PERIOD_MS;
+    } else if (minDelay > MAX_UPDATE_PERIOD_MS) {
+        minDelay = MAX_UPDATE_PERIOD_MS;
     }
 
-    // Done
-    timeToNextUpdateMs = minDelay;
-
     // Restart timer
-    updateTimer->start(timeToNextUpdateMs);
+    updateTimer->start(minDelay);
+}
+
+/**
+ * Periodic evaluation of the link health driving the rate governor
+ *
+ * Escalates one throttle level whenever the link shows signs of congestion -
+ * transaction retries, a standing tx backlog on the io device, or OPLink
+ * reporting a degraded link quality - and backs off one level again after the
+ * link has been healthy for a few consecutive evaluations. Critical objects
+ * keep their full rate at every level (see effectiveUpdatePeriod), so under
+ * pressure the governor sheds low-value rate first and restores it
+ * automatically when headroom returns.
+ */
+void Telemetry::evaluateGovernor()
+{
+    QMutexLocker locker(mutex);
+
+    // Retries issued since the last evaluation
+    quint32 retryDelta = txRetries - govLastTxRetries;
+
+    govLastTxRetries = txRetries;
+
+    bool stressed = (retryDelta >= (quint32)GOV_RETRY_THRESHOLD) ||
+                    (utalk->getPendingTxBytes() >= GOV_BACKLOG_BYTES);
+
+    // Only trust the OPLink quality indicator when the modem is actually
+    // reporting (it reads 0 on non OPLink setups)
+    quint16 linkQuality = oplinkStatusObj->getLinkQuality();
+    if ((linkQuality > 0) && (linkQuality < GOV_LINK_QUALITY_MIN)) {
+        stressed = true;
+    }
+
+    if (stressed) {
+        govHealthyTicks = 0;
+        if (governorLevel < GOV_MAX_LEVEL) {
+            ++governorLevel;
+            qWarning().nospace() << "Telemetry - link congested, governor shedding rate (level " << governorLevel << ")";
+        }
+    } else if (governorLevel > 0) {
+        // Require sustained headroom before restoring rate, one level at a
+        // time, to avoid oscillating on a marginal link
+        if (++govHealthyTicks >= GOV_RECOVER_TICKS) {
+            govHealthyTicks = 0;
+            --governorLevel;
+#ifdef VERBOSE_TELEMETRY
+            qDebug().nospace() << "Telemetry - link recovered, governor restoring rate (level " << governorLevel << ")";
+#endif
+        }
+    }
 }
 
 Telemetry::TelemetryStats Telemetry::getStats()
@@ -538,6 +667,7 @@ void Telemetry::resetStats()
     utalk->resetStats();
     txErrors  = 0;
     txRetries = 0;
+    govLastTxRetries = 0;
 }
 
 void Telemetry::objectUpdatedAuto(UAVObject *obj)
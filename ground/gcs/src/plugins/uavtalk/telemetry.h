@@ -34,6 +34,7 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QQueue>
 #include <QMap>
 
@@ -87,6 +88,14 @@ private:
     static const int MIN_UPDATE_PERIOD_MS = 1;
     static const int MAX_QUEUE_SIZE = 20;
 
+    // Rate governor constants
+    static const int GOV_EVAL_PERIOD_MS   = 1000;
+    static const int GOV_MAX_LEVEL        = 3;
+    static const int GOV_RETRY_THRESHOLD  = 2; /** retries per evaluation period that indicate a struggling link */
+    static const int GOV_BACKLOG_BYTES    = 1024; /** unsent bytes on the io device that indicate congestion */
+    static const int GOV_LINK_QUALITY_MIN = 64; /** OPLink LinkQuality (0-128) below which the link is degraded */
+    static const int GOV_RECOVER_TICKS    = 3; /** consecutive healthy evaluations before backing off one level */
+
     // Types
     /**
      * Events generated by objects
@@ -100,10 +109,22 @@ private:
         EV_UPDATE_REQ       = 0x10 /** Request to update object data */
     } EventMask;
 
+    /**
+     * Priority classes used by the rate governor. Critical objects are never
+     * throttled, standard objects only under heavy pressure, bulk objects
+     * first.
+     */
+    typedef enum {
+        CLASS_CRITICAL = 0,
+        CLASS_STANDARD = 1,
+        CLASS_BULK     = 2
+    } GovernorClass;
+
     typedef struct {
         UAVObject *obj;
         qint32    updatePeriodMs; /** Update period in ms or 0 if no periodic updates are needed */
-        qint32    timeToNextUpdateMs; /** Time delay to the next update */
+        qint64    nextUpdateTime; /** Absolute deadline of the next update (updateClock time base) */
+        GovernorClass governorClass; /** Priority class used when shedding periodic rate */
     } ObjectTimeInfo;
 
     typedef struct {
@@ -117,16 +138,27 @@ private:
     UAVTalk *utalk;
     GCSTelemetryStats *gcsStatsObj;
     QList<ObjectTimeInfo> objList;
+    // Periodic update schedule, ordered by deadline (key) and holding indices
+    // into objList. Entries are invalidated lazily : an entry is only valid
+    // if its key still matches the nextUpdateTime of the objList entry.
+    QMultiMap<qint64, int> updateSchedule;
+    QElapsedTimer updateClock;
     QQueue<ObjectQueueInfo> objQueue;
     QQueue<ObjectQueueInfo> objPriorityQueue;
     QMap<quint32, QMap<quint32, ObjectTransactionInfo *> *> transMap;
     QMutex *mutex;
     QTimer *updateTimer;
     QTimer *statsTimer;
-    qint32 timeToNextUpdateMs;
     quint32 txErrors;
     quint32 txRetries;
 
+    // Rate governor state
+    QTimer *governorTimer;
+    int governorLevel; /** 0 = full rate, each level sheds more low-value periodic rate */
+    int govHealthyTicks;
+    quint32 govLastTxRetries;
+    class OPLinkStatus *oplinkStatusObj;
+
     // Methods
     void registerObject(UAVObject *obj);
     void addObject(UAVObject *obj);
@@ -138,6 +170,9 @@ private:
     void processObjectTransaction(ObjectTransactionInfo *transInfo);
     void processObjectQueue();
 
+    GovernorClass governorClassOf(UAVObject *obj);
+    qint32 effectiveUpdatePeriod(const ObjectTimeInfo &timeInfo);
+
     ObjectTransactionInfo *findTransaction(UAVObject *obj);
     void openTransaction(ObjectTransactionInfo *trans);
     void closeTransaction(ObjectTransactionInfo *trans);
@@ -152,6 +187,7 @@ private slots:
     void newObject(UAVObject *obj);
     void newInstance(UAVObject *obj);
     void processPeriodicUpdates();
+    void evaluateGovernor();
     void transactionCompleted(UAVObject *obj, bool success);
 };
 
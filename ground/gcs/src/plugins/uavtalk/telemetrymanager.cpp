@@ -32,21 +32,48 @@
 #include <coreplugin/icore.h>
 #include <coreplugin/threadmanager.h>
 
-TelemetryManager::TelemetryManager() : m_connectionState(TELEMETRY_DISCONNECTED)
+TelemetryManager::TelemetryManager(UAVObjectManager *objMngr) : m_uavTalk(NULL), m_connectionState(TELEMETRY_DISCONNECTED),
+    m_txDataRate(0.0), m_rxDataRate(0.0), m_telemetryReader(NULL)
 {
     moveToThread(Core::ICore::instance()->threadManager()->getRealTimeThread());
-    // Get UAVObjectManager instance
-    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
-    m_uavobjectManager = pm->getObject<UAVObjectManager>();
+    if (objMngr != NULL) {
+        // vehicle scoped namespace provided by the caller
+        m_uavobjectManager = objMngr;
+    } else {
+        // Get the shared UAVObjectManager instance
+        ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+        m_uavobjectManager = pm->getObject<UAVObjectManager>();
+    }
 
     // connect to start stop signals
     connect(this, SIGNAL(myStart()), this, SLOT(onStart()), Qt::QueuedConnection);
     connect(this, SIGNAL(myStop()), this, SLOT(onStop()), Qt::QueuedConnection);
+    connect(this, SIGNAL(mySwitchDevice(QIODevice *)), this, SLOT(onSwitchDevice(QIODevice *)), Qt::QueuedConnection);
+    connect(this, SIGNAL(myAddSecondaryLink(QIODevice *)), this, SLOT(onAddSecondaryLink(QIODevice *)), Qt::QueuedConnection);
+    connect(this, SIGNAL(myRemoveSecondaryLinks()), this, SLOT(onRemoveSecondaryLinks()), Qt::QueuedConnection);
+    connect(this, SIGNAL(myAddRelayOutput(QIODevice *)), this, SLOT(onAddRelayOutput(QIODevice *)), Qt::QueuedConnection);
+    connect(this, SIGNAL(myRemoveRelayOutputs()), this, SLOT(onRemoveRelayOutputs()), Qt::QueuedConnection);
 }
 
+// GCS authored objects worth sending redundantly over every attached link :
+// losing one of them to a fading radio matters, losing bulk telemetry does not
+static const char *CRITICAL_UPLINK_OBJECTS[] = {
+    "ManualControlCommand",
+    "AccessoryDesired",
+};
+
+// Stop writing to a relay output whose transmit backlog backed up beyond
+// this, whole frames are dropped instead so the output stays frame aligned
+static const qint64 RELAY_OUTPUT_BACKLOG = 16 * 1024;
+
 TelemetryManager::~TelemetryManager()
 {}
 
+UAVObjectManager *TelemetryManager::objectManager() const
+{
+    return m_uavobjectManager;
+}
+
 bool TelemetryManager::isConnected() const
 {
     return m_connectionState == TELEMETRY_CONNECTED;
@@ -75,27 +102,33 @@ void TelemetryManager::start(QIODevice *dev)
 void TelemetryManager::onStart()
 {
     m_uavTalk = new UAVTalk(m_telemetryDevice, m_uavobjectManager);
-    if (false) {
-        // UAVTalk must be thread safe and for that:
-        // 1- all public methods must lock a mutex
-        // 2- the reader thread must lock that mutex too
-        // The reader thread locks the mutex once a packet is read and decoded.
-        // It is assumed that the UAVObjectManager is thread safe
+    if (useReaderThread) {
+        // The reader thread only moves bytes from the io device into the
+        // lock-free rx ring of UAVTalk, it never touches the parser state or
+        // the mutex. Parsing and object updates happen on the UAVTalk thread
+        // once the producer signals that data has been queued.
 
         // Create the reader and move it to the reader thread
-        IODeviceReader *reader = new IODeviceReader(m_uavTalk);
-        reader->moveToThread(&m_telemetryReaderThread);
+        m_telemetryReader = new IODeviceReader(m_uavTalk);
+        m_telemetryReader->moveToThread(&m_telemetryReaderThread);
         // The reader will be deleted (later) when the thread finishes
-        connect(&m_telemetryReaderThread, &QThread::finished, reader, &QObject::deleteLater);
+        connect(&m_telemetryReaderThread, &QThread::finished, m_telemetryReader, &QObject::deleteLater);
         // Connect IO device to reader
-        connect(m_telemetryDevice, SIGNAL(readyRead()), reader, SLOT(read()));
-        // start the reader thread
-        m_telemetryReaderThread.start();
+        connect(m_telemetryDevice, SIGNAL(readyRead()), m_telemetryReader, SLOT(read()));
+        // start the reader thread, elevated so heavy GUI work (map rendering,
+        // log export) cannot delay draining the io device
+        m_telemetryReaderThread.start(QThread::HighPriority);
     } else {
         // Connect IO device to reader
         connect(m_telemetryDevice, SIGNAL(readyRead()), m_uavTalk, SLOT(processInputStream()));
     }
 
+    // relay outputs attached before or during a previous session keep
+    // re-serving the stream of the new link
+    if (!m_relayOutputs.isEmpty()) {
+        enableFrameRelay();
+    }
+
     m_telemetry = new Telemetry(m_uavTalk, m_uavobjectManager);
     m_telemetryMonitor = new TelemetryMonitor(m_uavobjectManager, m_telemetry);
 
@@ -110,7 +143,7 @@ void TelemetryManager::stop()
     emit disconnecting();
     emit myStop();
 
-    if (false) {
+    if (useReaderThread) {
         m_telemetryReaderThread.quit();
         m_telemetryReaderThread.wait();
     }
@@ -118,13 +151,197 @@ void TelemetryManager::stop()
 
 void TelemetryManager::onStop()
 {
+    onRemoveSecondaryLinks();
     m_telemetryMonitor->disconnect(this);
     delete m_telemetryMonitor;
     delete m_telemetry;
     delete m_uavTalk;
+    m_uavTalk = NULL;
+    // deleted by the reader thread's finished() handler
+    m_telemetryReader = NULL;
     onDisconnect();
 }
 
+void TelemetryManager::switchDevice(QIODevice *dev)
+{
+    // same ownership handover as in start()
+    dev->moveToThread(thread());
+    emit mySwitchDevice(dev);
+}
+
+/**
+ * Re-bind the running telemetry stack to another io device. UAVTalk, the
+ * Telemetry scheduler and the telemetry monitor all stay alive, so the
+ * object set, metadata and the session state survive the swap and nothing
+ * gets re-retrieved : the handover is a short gap in the byte stream.
+ */
+void TelemetryManager::onSwitchDevice(QIODevice *dev)
+{
+    if (m_uavTalk == NULL) {
+        // not running, this is just a regular start
+        m_telemetryDevice = dev;
+        onStart();
+        return;
+    }
+
+    // detach the old link and bind the new one into the same parser
+    disconnect(m_telemetryDevice, SIGNAL(readyRead()), 0, 0);
+    m_telemetryDevice = dev;
+    m_uavTalk->setIODevice(dev);
+
+    if (useReaderThread) {
+        connect(m_telemetryDevice, SIGNAL(readyRead()), m_telemetryReader, SLOT(read()));
+    } else {
+        connect(m_telemetryDevice, SIGNAL(readyRead()), m_uavTalk, SLOT(processInputStream()));
+    }
+    qDebug() << "TelemetryManager - warm link handover completed";
+}
+
+void TelemetryManager::addSecondaryLink(QIODevice *dev)
+{
+    // same ownership handover as in start()
+    dev->moveToThread(thread());
+    emit myAddSecondaryLink(dev);
+}
+
+void TelemetryManager::removeSecondaryLinks()
+{
+    emit myRemoveSecondaryLinks();
+}
+
+void TelemetryManager::onAddSecondaryLink(QIODevice *dev)
+{
+    SecondaryLink link;
+
+    link.device  = dev;
+    link.uavTalk = new UAVTalk(dev, m_uavobjectManager);
+    // an update that already arrived on another link is dropped instead of
+    // firing every consumer a second time
+    link.uavTalk->setDedupeIdenticalUpdates(true);
+
+    if (useReaderThread) {
+        IODeviceReader *reader = new IODeviceReader(link.uavTalk);
+        reader->moveToThread(&m_telemetryReaderThread);
+        connect(&m_telemetryReaderThread, &QThread::finished, reader, &QObject::deleteLater);
+        connect(dev, SIGNAL(readyRead()), reader, SLOT(read()));
+        if (!m_telemetryReaderThread.isRunning()) {
+            m_telemetryReaderThread.start(QThread::HighPriority);
+        }
+    } else {
+        connect(dev, SIGNAL(readyRead()), link.uavTalk, SLOT(processInputStream()));
+    }
+
+    if (m_secondaryLinks.isEmpty()) {
+        subscribeCriticalObjects();
+    }
+    m_secondaryLinks.append(link);
+    qDebug() << "TelemetryManager - secondary link attached, total links" << (m_secondaryLinks.size() + 1);
+}
+
+void TelemetryManager::onRemoveSecondaryLinks()
+{
+    foreach(const SecondaryLink &link, m_secondaryLinks) {
+        link.device->disconnect();
+        delete link.uavTalk;
+    }
+    m_secondaryLinks.clear();
+}
+
+/**
+ * Subscribe to the GCS authored objects that are worth duplicating over
+ * every link. Only manual updates are forwarded : updates caused by
+ * receiving the object would loop straight back onto the links.
+ */
+void TelemetryManager::subscribeCriticalObjects()
+{
+    for (size_t n = 0; n < sizeof(CRITICAL_UPLINK_OBJECTS) / sizeof(CRITICAL_UPLINK_OBJECTS[0]); ++n) {
+        UAVObject *obj = m_uavobjectManager->getObject(QString(CRITICAL_UPLINK_OBJECTS[n]));
+        if (obj != NULL) {
+            connect(obj, SIGNAL(objectUpdatedManual(UAVObject *, bool)),
+                    this, SLOT(onCriticalObjectUpdated(UAVObject *)), Qt::UniqueConnection);
+        }
+    }
+}
+
+void TelemetryManager::onCriticalObjectUpdated(UAVObject *obj)
+{
+    // the primary link already carries the object through the regular
+    // telemetry path, mirror it unacked on every secondary link
+    foreach(const SecondaryLink &link, m_secondaryLinks) {
+        link.uavTalk->sendObject(obj, false, false);
+    }
+}
+
+void TelemetryManager::addRelayOutput(QIODevice *dev)
+{
+    // same ownership handover as in start()
+    dev->moveToThread(thread());
+    emit myAddRelayOutput(dev);
+}
+
+void TelemetryManager::removeRelayOutputs()
+{
+    emit myRemoveRelayOutputs();
+}
+
+void TelemetryManager::onAddRelayOutput(QIODevice *dev)
+{
+    RelayOutput output;
+
+    output.device = dev;
+    output.droppedFrames = 0;
+    m_relayOutputs.append(output);
+
+    if (m_uavTalk != NULL) {
+        enableFrameRelay();
+    }
+    qDebug() << "TelemetryManager - relay output attached, total outputs" << m_relayOutputs.size();
+}
+
+void TelemetryManager::onRemoveRelayOutputs()
+{
+    foreach(const RelayOutput &output, m_relayOutputs) {
+        if (output.droppedFrames > 0) {
+            qWarning() << "TelemetryManager - relay output dropped" << output.droppedFrames << "frames";
+        }
+        output.device->disconnect(this);
+    }
+    m_relayOutputs.clear();
+
+    if (m_uavTalk != NULL) {
+        m_uavTalk->setFrameRelay(false);
+    }
+}
+
+/**
+ * Turn on the raw frame tap of the primary link. The frames were already
+ * CRC checked by the parser, forwarding is a single write per output with
+ * no object decode or re-encode involved.
+ */
+void TelemetryManager::enableFrameRelay()
+{
+    m_uavTalk->setFrameRelay(true);
+    connect(m_uavTalk, SIGNAL(frameReceived(QByteArray)),
+            this, SLOT(onRelayFrame(QByteArray)), Qt::UniqueConnection);
+}
+
+void TelemetryManager::onRelayFrame(QByteArray frame)
+{
+    for (int i = 0; i < m_relayOutputs.size(); ++i) {
+        RelayOutput &output = m_relayOutputs[i];
+        if (!output.device->isOpen() || !output.device->isWritable()) {
+            continue;
+        }
+        if (output.device->bytesToWrite() < RELAY_OUTPUT_BACKLOG) {
+            output.device->write(frame);
+        } else {
+            // slow consumer : skip the whole frame, resuming mid frame would
+            // desynchronize the downstream parser
+            ++output.droppedFrames;
+        }
+    }
+}
+
 void TelemetryManager::onConnect()
 {
     m_connectionState = TELEMETRY_CONNECTED;
@@ -134,11 +351,15 @@ void TelemetryManager::onConnect()
 void TelemetryManager::onDisconnect()
 {
     m_connectionState = TELEMETRY_DISCONNECTED;
+    m_txDataRate = 0.0;
+    m_rxDataRate = 0.0;
     emit disconnected();
 }
 
 void TelemetryManager::onTelemetryUpdate(double txRate, double rxRate)
 {
+    m_txDataRate = txRate;
+    m_rxDataRate = rxRate;
     emit telemetryUpdated(txRate, rxRate);
 }
 
@@ -147,5 +368,5 @@ IODeviceReader::IODeviceReader(UAVTalk *uavTalk) : m_uavTalk(uavTalk)
 
 void IODeviceReader::read()
 {
-    m_uavTalk->processInputStream();
+    m_uavTalk->produceInputStream();
 }
@@ -48,14 +48,53 @@ public:
         TELEMETRY_CONNECTING
     };
 
-    TelemetryManager();
+    // By default the manager feeds the shared UAVObjectManager from the
+    // plugin object pool. A vehicle scoped session passes its own object
+    // manager so several aircraft can be tracked concurrently without their
+    // objects overwriting each other.
+    TelemetryManager(UAVObjectManager *objMngr = NULL);
     ~TelemetryManager();
 
+    UAVObjectManager *objectManager() const;
+
     void start(QIODevice *dev);
     void stop();
+    // Warm link handover : re-bind the running telemetry stack to another
+    // io device (e.g. USB to OPLink for the same vehicle) without tearing
+    // down UAVTalk, Telemetry or the object manager, so no object
+    // re-retrieval happens and the swap completes in well under a second.
+    void switchDevice(QIODevice *dev);
     bool isConnected() const;
     ConnectionState connectionState() const;
 
+    // Latest telemetry rates in bytes/s, refreshed by the telemetry monitor
+    // stats period. Cheap to poll from UI refresh timers, which avoids a
+    // signal emission per stats update for purely decorative consumers.
+    double txDataRate() const
+    {
+        return m_txDataRate;
+    }
+    double rxDataRate() const
+    {
+        return m_rxDataRate;
+    }
+
+    // Attach an additional telemetry link (e.g. a WiFi bridge next to the
+    // OPLink radio). Bulk traffic stays on the primary link; objects
+    // received on any link update the same object manager with the first
+    // arriving copy winning, and critical uplink objects are transmitted
+    // redundantly over every link.
+    void addSecondaryLink(QIODevice *dev);
+    void removeSecondaryLinks();
+
+    // Attach an output the raw telemetry stream is re-served to (relay
+    // mode). Every frame received on the primary link that passes the CRC
+    // check is forwarded byte for byte, without decoding it into the object
+    // manager and re-encoding it. Outputs survive reconnects of the primary
+    // link; a slow output drops whole frames so it stays frame aligned.
+    void addRelayOutput(QIODevice *dev);
+    void removeRelayOutputs();
+
 signals:
     void connecting();
     void connected();
@@ -64,6 +103,11 @@ signals:
     void telemetryUpdated(double txRate, double rxRate);
     void myStart();
     void myStop();
+    void mySwitchDevice(QIODevice *dev);
+    void myAddSecondaryLink(QIODevice *dev);
+    void myRemoveSecondaryLinks();
+    void myAddRelayOutput(QIODevice *dev);
+    void myRemoveRelayOutputs();
 
 private slots:
     void onConnect();
@@ -71,15 +115,43 @@ private slots:
     void onTelemetryUpdate(double txRate, double rxRate);
     void onStart();
     void onStop();
+    void onSwitchDevice(QIODevice *dev);
+    void onAddSecondaryLink(QIODevice *dev);
+    void onRemoveSecondaryLinks();
+    void onCriticalObjectUpdated(UAVObject *obj);
+    void onAddRelayOutput(QIODevice *dev);
+    void onRemoveRelayOutputs();
+    void onRelayFrame(QByteArray frame);
 
 private:
+    // Use a dedicated thread to drain the io device into the UAVTalk rx ring
+    static const bool useReaderThread = true;
+
+    typedef struct {
+        QIODevice *device;
+        UAVTalk   *uavTalk;
+    } SecondaryLink;
+
+    typedef struct {
+        QIODevice *device;
+        quint32    droppedFrames;
+    } RelayOutput;
+
     UAVObjectManager *m_uavobjectManager;
     UAVTalk *m_uavTalk;
     Telemetry *m_telemetry;
     TelemetryMonitor *m_telemetryMonitor;
     QIODevice *m_telemetryDevice;
     ConnectionState m_connectionState;
+    double m_txDataRate;
+    double m_rxDataRate;
     QThread m_telemetryReaderThread;
+    class IODeviceReader *m_telemetryReader;
+    QList<SecondaryLink> m_secondaryLinks;
+    QList<RelayOutput> m_relayOutputs;
+
+    void subscribeCriticalObjects();
+    void enableFrameRelay();
 };
 
 
@@ -29,6 +29,13 @@
 #include "coreplugin/connectionmanager.h"
 #include "coreplugin/icore.h"
 
+// Session cache shared by all TelemetryMonitor instances of this GCS run.
+// The UAVObjectManager keeps the object data of a closed session, so when we
+// reconnect to the same board running the same firmware the settings objects
+// retrieved last time are still valid and do not need to be downloaded again.
+static QString cachedSessionBoardId;
+static QSet<quint32> cachedSessionObjects;
+
 /**
  * Constructor
  */
@@ -39,12 +46,15 @@ TelemetryMonitor::TelemetryMonitor(UAVObjectManager *objMngr, Telemetry *tel) :
     flightStatsObj(FlightTelemetryStats::GetInstance(objMngr)),
     firmwareIAPObj(FirmwareIAPObj::GetInstance(objMngr)),
     statsTimer(new QTimer(this)),
-    objPending(NULL),
+    awaitingSessionIdent(false),
     mutex(new QMutex(QMutex::Recursive)),
     connectionTimer(new QTime())
 {
-    // Listen for flight stats updates
+    // Listen for flight stats updates. On a quiet link the stats payload can
+    // repeat unchanged, which the object layer reports separately : connect
+    // both so every arrival keeps feeding the connection logic.
     connect(flightStatsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(flightStatsUpdated(UAVObject *)));
+    connect(flightStatsObj, SIGNAL(objectUnpackedUnchanged(UAVObject *)), this, SLOT(flightStatsUpdated(UAVObject *)));
 
     // Start update timer
     connect(statsTimer, SIGNAL(timeout()), this, SLOT(processStatsUpdates()));
@@ -63,12 +73,21 @@ TelemetryMonitor::~TelemetryMonitor()
 
 /**
  * Initiate object retrieval, initialize queue with objects to be retrieved.
+ *
+ * The queue is staged by priority instead of registration order : the live
+ * flight state objects (attitude, position, alarms) are retrieved first so
+ * the primary displays become usable within a few round trips of connecting,
+ * then the metaobjects that shape telemetry behaviour, and only then the bulk
+ * of the settings objects streams in the background.
  */
 void TelemetryMonitor::startRetrievingObjects()
 {
     // Clear object queue
     queue.clear();
     // Get all objects, add metaobjects, settings and data objects with OnChange update mode to the queue
+    QQueue<UAVObject *> stateQueue; // flight-critical state and alarms
+    QQueue<UAVObject *> metaQueue; // metaobjects
+    QQueue<UAVObject *> bulkQueue; // settings and remaining data objects
     QList< QList<UAVObject *> > objs = objMngr->getObjects();
     for (int n = 0; n < objs.length(); ++n) {
         UAVObject *obj = objs[n][0];
@@ -76,21 +95,54 @@ void TelemetryMonitor::startRetrievingObjects()
         UAVDataObject *dobj = dynamic_cast<UAVDataObject *>(obj);
         UAVObject::Metadata mdata = obj->getMetadata();
         if (mobj != NULL) {
-            queue.enqueue(obj);
+            metaQueue.enqueue(obj);
         } else if (dobj != NULL) {
             if (dobj->isSettingsObject()) {
-                queue.enqueue(obj);
+                bulkQueue.enqueue(obj);
             } else {
                 if (UAVObject::GetFlightTelemetryUpdateMode(mdata) == UAVObject::UPDATEMODE_ONCHANGE) {
-                    queue.enqueue(obj);
+                    QString category = obj->getCategory();
+                    if ((category == "State") || (category == "System")) {
+                        stateQueue.enqueue(obj);
+                    } else {
+                        bulkQueue.enqueue(obj);
+                    }
                 }
             }
         }
     }
+    queue << stateQueue << metaQueue << bulkQueue;
+    // Retrieve the board identity first : once it is known we can decide
+    // whether the session cache applies and the bulk of the settings objects
+    // can be skipped.
+    queue.removeAll(firmwareIAPObj);
+    queue.prepend(firmwareIAPObj);
+    awaitingSessionIdent = true;
+    sessionBoardId.clear();
+    retrievedObjects.clear();
+
     // Start retrieving
     qDebug() << tr("Starting to retrieve meta and settings objects from the autopilot (%1 objects)")
         .arg(queue.length());
-    retrieveNextObject();
+    retrieveNextObjects();
+}
+
+/**
+ * Build the identity of the connected board from the firmware IAP object :
+ * CPU serial plus the firmware description (which embeds the firmware hash).
+ */
+QString TelemetryMonitor::sessionIdent() const
+{
+    QString ident;
+
+    for (quint32 n = 0; n < 12; ++n) {
+        ident += QString("%1").arg(firmwareIAPObj->getCPUSerial(n), 2, 16, QChar('0'));
+    }
+    ident += '-';
+    for (quint32 n = 0; n < 100; ++n) {
+        ident += QString::number(firmwareIAPObj->getDescription(n), 16);
+    }
+    return ident;
 }
 
 /**
@@ -100,16 +152,30 @@ void TelemetryMonitor::stopRetrievingObjects()
 {
     qDebug("Object retrieval has been cancelled");
     queue.clear();
+    foreach(UAVObject * obj, pendingObjects) {
+        obj->disconnect(this);
+    }
+    pendingObjects.clear();
 }
 
 /**
- * Retrieve the next object in the queue
+ * Top up the retrieval window from the queue.
+ *
+ * Several requests are kept in flight at once (RETRIEVE_WINDOW_SIZE) so that
+ * on high latency links session establishment is pipelined instead of paying
+ * one full round trip per object.
  */
-void TelemetryMonitor::retrieveNextObject()
+void TelemetryMonitor::retrieveNextObjects()
 {
-    // If queue is empty return
-    if (queue.isEmpty()) {
+    // If everything has been requested and answered we are done
+    if (queue.isEmpty() && pendingObjects.isEmpty()) {
         qDebug("Object retrieval completed");
+        // Remember what this session retrieved so the next connection to the
+        // same board/firmware can skip it
+        if (!sessionBoardId.isEmpty()) {
+            cachedSessionBoardId = sessionBoardId;
+            cachedSessionObjects.unite(retrievedObjects);
+        }
         if (firmwareIAPObj->getBoardType()) {
             emit connected();
         } else {
@@ -118,35 +184,63 @@ void TelemetryMonitor::retrieveNextObject()
         return;
     }
 
-    // Get next object from the queue
-    UAVObject *obj = queue.dequeue();
-    // qDebug( tr("Retrieving object: %1").arg(obj->getName()) );
+    // Fill the window with requests. While the board identity is still being
+    // established keep a single request in flight, so a session cache hit can
+    // prune the queue before the bulk retrieval starts.
+    int window = awaitingSessionIdent ? 1 : RETRIEVE_WINDOW_SIZE;
+    while (!queue.isEmpty() && (pendingObjects.count() < window)) {
+        UAVObject *obj = queue.dequeue();
+        // qDebug( tr("Retrieving object: %1").arg(obj->getName()) );
 
-    // Connect to object
-    connect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(transactionCompleted(UAVObject *, bool)));
+        // Connect to object
+        connect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(transactionCompleted(UAVObject *, bool)));
 
-    // Request update
-    obj->requestUpdate();
-    objPending = obj;
+        // Request update
+        pendingObjects.insert(obj);
+        obj->requestUpdate();
+    }
 }
 
 /**
- * Called by the retrieved object when a transaction is completed.
+ * Called by a retrieved object when its transaction is completed.
  */
 void TelemetryMonitor::transactionCompleted(UAVObject *obj, bool success)
 {
     Q_UNUSED(success);
     QMutexLocker locker(mutex);
 
-    if (obj == objPending) {
+    if (pendingObjects.contains(obj)) {
         // Disconnect from sending object
         obj->disconnect(this);
-        objPending = NULL;
-        // Process next object if telemetry is still available
+        pendingObjects.remove(obj);
+        if (success) {
+            retrievedObjects.insert(obj->getObjID());
+        }
+        if (awaitingSessionIdent && (obj == firmwareIAPObj)) {
+            awaitingSessionIdent = false;
+            if (success) {
+                sessionBoardId = sessionIdent();
+                if (sessionBoardId == cachedSessionBoardId) {
+                    // Same board, same firmware : the objects retrieved by the
+                    // previous session are still held by the object manager,
+                    // drop them from the queue
+                    int skipped = 0;
+                    for (int n = queue.length() - 1; n >= 0; --n) {
+                        if (cachedSessionObjects.contains(queue[n]->getObjID())) {
+                            queue[n]->setIsKnown(true);
+                            queue.removeAt(n);
+                            ++skipped;
+                        }
+                    }
+                    qDebug() << "TelemetryMonitor - session cache hit, skipping" << skipped << "unchanged objects";
+                }
+            }
+        }
+        // Process next objects if telemetry is still available
         GCSTelemetryStats::DataFields gcsStats = gcsStatsObj->getData();
 
         if (gcsStats.Status == GCSTelemetryStats::STATUS_CONNECTED) {
-            retrieveNextObject();
+            retrieveNextObjects();
         } else {
             stopRetrievingObjects();
         }
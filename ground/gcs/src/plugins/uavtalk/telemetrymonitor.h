@@ -30,6 +30,7 @@
 
 #include <QObject>
 #include <QQueue>
+#include <QSet>
 #include <QTimer>
 #include <QTime>
 #include <QMutex>
@@ -63,6 +64,9 @@ private:
     static const int STATS_UPDATE_PERIOD_MS  = 4000;
     static const int STATS_CONNECT_PERIOD_MS = 2000;
     static const int CONNECTION_TIMEOUT_MS   = 8000;
+    // Number of object retrievals kept in flight during session setup, so
+    // connection time is bounded by bandwidth rather than round-trip count
+    static const int RETRIEVE_WINDOW_SIZE    = 4;
 
     UAVObjectManager *objMngr;
     Telemetry *tel;
@@ -71,13 +75,19 @@ private:
     FlightTelemetryStats *flightStatsObj;
     FirmwareIAPObj *firmwareIAPObj;
     QTimer *statsTimer;
-    UAVObject *objPending;
+    QSet<UAVObject *> pendingObjects;
+    // Session cache state : identity of the connected board and the objects
+    // successfully retrieved from it, see startRetrievingObjects()
+    bool awaitingSessionIdent;
+    QString sessionBoardId;
+    QSet<quint32> retrievedObjects;
     QMutex *mutex;
     QTime *connectionTimer;
 
     void startRetrievingObjects();
-    void retrieveNextObject();
+    void retrieveNextObjects();
     void stopRetrievingObjects();
+    QString sessionIdent() const;
 };
 
 #endif // TELEMETRYMONITOR_H
@@ -28,11 +28,14 @@
 #include <extensionsystem/pluginmanager.h>
 #include <coreplugin/generalsettings.h>
 #include <utils/crc.h>
+#include <utils/tracer.h>
 
 #include <QtEndian>
 #include <QDebug>
 #include <QEventLoop>
 
+#include <string.h>
+
 #ifdef VERBOSE_UAVTALK
 // uncomment and adapt the following lines to filter verbose logging to include specific object(s) only
 // #include "flighttelemetrystats.h"
@@ -46,27 +49,41 @@
 
 using namespace Utils;
 
+const char *UAVTalk::MIRROR_GROUP = "239.255.11.13";
+
 /**
  * Constructor
  */
 UAVTalk::UAVTalk(QIODevice *iodev, UAVObjectManager *objMngr) : io(iodev), objMngr(objMngr), mutex(QMutex::Recursive)
 {
     rxState = STATE_SYNC;
-    rxPacketLength = 0;
+    rxPacketLength   = 0;
+    useDeltaEncoding = false;
+    dedupeIdenticalUpdates = false;
+    relayFrames = false;
 
     memset(&stats, 0, sizeof(ComStats));
+    memset(objStats, 0, sizeof(objStats));
+    statsClock.start();
+
+    // The producer side of the rx ring runs in the reader thread, parsing is
+    // done on this object's thread once the producer has queued data.
+    connect(this, SIGNAL(inputQueueReady()), this, SLOT(processInputQueue()), Qt::QueuedConnection);
 
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     Core::Internal::GeneralSettings *settings = pm->getObject<Core::Internal::GeneralSettings>();
-    useUDPMirror = settings->useUDPMirror();
-    qDebug() << "USE UDP:::::::::::." << useUDPMirror;
+    useUDPMirror   = settings->useUDPMirror();
+    mirrorSocket   = NULL;
+    mirrorTimer    = NULL;
+    mirrorWindowMs = MIRROR_WINDOW_MS;
     if (useUDPMirror) {
-        udpSocketTx = new QUdpSocket(this);
-        udpSocketRx = new QUdpSocket(this);
-        udpSocketTx->bind(9000);
-        udpSocketRx->connectToHost(QHostAddress::LocalHost, 9000);
-        connect(udpSocketTx, SIGNAL(readyRead()), this, SLOT(dummyUDPRead()));
-        connect(udpSocketRx, SIGNAL(readyRead()), this, SLOT(dummyUDPRead()));
+        qDebug() << "UAVTalk - mirroring telemetry stream to" << MIRROR_GROUP << ":" << MIRROR_PORT;
+        mirrorSocket = new QUdpSocket(this);
+        // listen-only stations on the local segment, do not leak beyond it
+        mirrorSocket->setSocketOption(QAbstractSocket::MulticastTtlOption, 1);
+        mirrorTimer  = new QTimer(this);
+        mirrorTimer->setSingleShot(true);
+        connect(mirrorTimer, SIGNAL(timeout()), this, SLOT(flushMirror()));
     }
 }
 
@@ -78,6 +95,28 @@ UAVTalk::~UAVTalk()
     closeAllTransactions();
 }
 
+/**
+ * Re-bind the link to another io device. Everything else - parser state,
+ * statistics, open transactions, the rx ring - carries over, so a link swap
+ * looks like a short gap in the byte stream rather than a new session.
+ */
+void UAVTalk::setIODevice(QIODevice *iodev)
+{
+    QMutexLocker locker(&mutex);
+
+    io = iodev;
+}
+
+/**
+ * Get the number of bytes queued on the io device but not yet transmitted
+ */
+qint64 UAVTalk::getPendingTxBytes()
+{
+    QMutexLocker locker(&mutex);
+
+    return io.isNull() ? 0 : io->bytesToWrite();
+}
+
 /**
  * Reset the statistics counters
  */
@@ -86,6 +125,10 @@ void UAVTalk::resetStats()
     QMutexLocker locker(&mutex);
 
     memset(&stats, 0, sizeof(ComStats));
+    memset(objStats, 0, sizeof(objStats));
+    rxQueueDropped.store(0);
+    rxQueueDepthPeak.store(0);
+    rxQueueLatencyPeak.store(0);
 }
 
 /**
@@ -95,18 +138,134 @@ UAVTalk::ComStats UAVTalk::getStats()
 {
     QMutexLocker locker(&mutex);
 
-    return stats;
+    ComStats s = stats;
+    s.rxQueueOverruns      = (quint32)rxQueueDropped.load();
+    s.rxQueueDepthPeak     = (quint32)rxQueueDepthPeak.load();
+    s.rxQueueLatencyPeakMs = (quint32)rxQueueLatencyPeak.load();
+    return s;
 }
 
-void UAVTalk::dummyUDPRead()
+/**
+ * Get the per-object statistics (rates, inter-arrival jitter and transaction
+ * round-trip histograms) collected on the link so far.
+ */
+QList<UAVTalk::ObjectStats> UAVTalk::getObjectStats()
 {
-    QUdpSocket *socket = qobject_cast<QUdpSocket *>(sender());
-    QByteArray junk;
+    QMutexLocker locker(&mutex);
+
+    QList<ObjectStats> list;
+    for (int n = 0; n < OBJECT_STATS_SLOTS; ++n) {
+        if (objStats[n].objId != 0) {
+            list.append(objStats[n]);
+        }
+    }
+    return list;
+}
 
-    while (socket->hasPendingDatagrams()) {
-        junk.resize(socket->pendingDatagramSize());
-        socket->readDatagram(junk.data(), junk.size());
+/**
+ * Find (or claim) the statistics slot for an object ID.
+ * Returns NULL when the table is full, in which case the packet is simply
+ * not accounted - the hot path never allocates.
+ */
+UAVTalk::ObjectStats *UAVTalk::findObjectStats(quint32 objId)
+{
+    if (objId == 0) {
+        return NULL;
+    }
+    // Fibonacci hash, linear probing
+    int index = (int)((objId * 2654435761u) >> 24) & (OBJECT_STATS_SLOTS - 1);
+    for (int probe = 0; probe < OBJECT_STATS_SLOTS; ++probe) {
+        ObjectStats *slot = &objStats[(index + probe) & (OBJECT_STATS_SLOTS - 1)];
+        if (slot->objId == objId) {
+            return slot;
+        }
+        if (slot->objId == 0) {
+            slot->objId = objId;
+            return slot;
+        }
     }
+    return NULL;
+}
+
+/**
+ * Map a duration in ms to a log2 histogram bucket.
+ */
+int UAVTalk::statsBucket(qint64 ms)
+{
+    int bucket = 0;
+
+    while ((ms > 0) && (bucket < OBJECT_STATS_BUCKETS - 1)) {
+        ms >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+/**
+ * Enable or disable delta encoding of outgoing OBJ frames.
+ * The shadow copies are dropped on every change so both directions restart
+ * from full frames.
+ */
+void UAVTalk::setDeltaEncoding(bool enabled)
+{
+    QMutexLocker locker(&mutex);
+
+    useDeltaEncoding = enabled;
+    txShadow.clear();
+    rxShadow.clear();
+}
+
+bool UAVTalk::deltaEncoding() const
+{
+    return useDeltaEncoding;
+}
+
+void UAVTalk::setDedupeIdenticalUpdates(bool enabled)
+{
+    QMutexLocker locker(&mutex);
+
+    dedupeIdenticalUpdates = enabled;
+}
+
+void UAVTalk::setFrameRelay(bool enabled)
+{
+    // relayFrames is only read on the parsing thread, same as rxDataArray
+    relayFrames = enabled;
+}
+
+void UAVTalk::setMirrorAggregationWindow(int windowMs)
+{
+    mirrorWindowMs = windowMs;
+}
+
+/**
+ * Queue a validated frame for multicast publication. A frame never
+ * straddles two datagrams : receivers can start parsing at any datagram
+ * boundary and a lost datagram costs whole frames only. The batch goes
+ * out when the datagram budget is reached or the aggregation window
+ * expires, whichever comes first.
+ */
+void UAVTalk::appendToMirror(const quint8 *data, qint32 length)
+{
+    if (!mirrorBuffer.isEmpty() && (mirrorBuffer.size() + length > MIRROR_MAX_DATAGRAM)) {
+        flushMirror();
+    }
+    mirrorBuffer.append((const char *)data, length);
+    if ((mirrorBuffer.size() >= MIRROR_MAX_DATAGRAM) || (mirrorWindowMs <= 0)) {
+        flushMirror();
+    } else if (!mirrorTimer->isActive()) {
+        mirrorTimer->start(mirrorWindowMs);
+    }
+}
+
+void UAVTalk::flushMirror()
+{
+    if (mirrorBuffer.isEmpty()) {
+        return;
+    }
+    mirrorSocket->writeDatagram(mirrorBuffer, QHostAddress(MIRROR_GROUP), MIRROR_PORT);
+    mirrorBuffer.clear();
+    mirrorTimer->stop();
 }
 
 /**
@@ -137,6 +296,49 @@ bool UAVTalk::sendObject(UAVObject *obj, bool acked, bool allInstances)
     return success;
 }
 
+/**
+ * Send several objects through the telemetry link as a single write burst.
+ *
+ * Each object is packed as a regular unacked OBJ frame, but the frames are
+ * coalesced into one buffer and handed to the io device in a single write.
+ * On slow radio links (OPLink at 9600 baud) and on USB this noticeably cuts
+ * the per-write overhead for small high rate objects. The stream stays wire
+ * compatible : the receiver just sees back to back frames.
+ *
+ * \param[in] objs Objects to send (single instances, unacked)
+ * \return Success (true), Failure (false) if any object failed to pack or send
+ */
+bool UAVTalk::sendObjectsBurst(const QList<UAVObject *> &objs)
+{
+    QMutexLocker locker(&mutex);
+
+    bool ret      = true;
+    qint32 offset = 0;
+    int batched   = 0;
+
+    foreach(UAVObject * obj, objs) {
+        if (!obj) {
+            ret = false;
+            continue;
+        }
+        qint32 frameLength = packSingleObject(TYPE_OBJ, obj->getObjID(), obj->getInstID(), obj, &txBurstBuffer[offset]);
+        if (frameLength < 0) {
+            ret = false;
+            continue;
+        }
+        offset += frameLength;
+        if (++batched == TX_BURST_FRAMES) {
+            ret     = transmitFrameBuffer(txBurstBuffer, offset) && ret;
+            offset  = 0;
+            batched = 0;
+        }
+    }
+    if (offset > 0) {
+        ret = transmitFrameBuffer(txBurstBuffer, offset) && ret;
+    }
+    return ret;
+}
+
 /**
  * Request an update for the specified object, on success the object data would have been
  * updated by the GCS.
@@ -205,36 +407,244 @@ bool UAVTalk::objectTransaction(quint8 type, quint32 objId, quint16 instId, UAVO
 
 /**
  * Called each time there are data in the input buffer
+ *
+ * The device is drained in chunks into a reusable buffer and the receive
+ * state machine is run over the buffered span. This keeps the cost of the
+ * virtual read() call per chunk instead of per byte, which matters at high
+ * baud rates and during faster than realtime log replay.
  */
 void UAVTalk::processInputStream()
 {
-    quint8 tmp;
+    GCS_TRACE_SCOPE("UAVTalk::processInputStream");
 
     if (io && io->isReadable()) {
-        while (io->bytesAvailable() > 0) {
-            int ret = io->read((char *)&tmp, 1);
-            if (ret != -1) {
-                processInputByte(tmp);
-            } else {
-                // TODOD
+        while (true) {
+            qint64 bytesRead = io->read((char *)rxReadBuffer, RX_READ_BUFFER_SIZE);
+            if (bytesRead <= 0) {
+                break;
             }
-            if (rxState == STATE_COMPLETE) {
-                mutex.lock();
-                if (receiveObject(rxType, rxObjId, rxInstId, rxBuffer, rxLength)) {
+            for (qint64 i = 0; i < bytesRead; ++i) {
+                if (rxState == STATE_SYNC) {
+                    i += scanForSync(&rxReadBuffer[i], (qint32)(bytesRead - i));
+                    if (i >= bytesRead) {
+                        break;
+                    }
+                }
+                processInputByte(rxReadBuffer[i]);
+                if (rxState == STATE_COMPLETE) {
+                    processCompletedPacket();
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Bulk sync hunting over a buffered span.
+ *
+ * While the state machine is hunting for a sync byte every non-sync byte is
+ * a single trivial state transition, so instead of paying a call per byte
+ * the garbage run up to the next sync candidate is located with memchr and
+ * accounted for in one step. During rxSyncErrors storms on a noisy link this
+ * turns resynchronization from a per-byte walk into a memory scan; candidate
+ * validation stays with the state machine, which simply falls back to
+ * hunting if the bytes after the candidate do not parse as a header.
+ *
+ * \param[in] data Buffered bytes, the parser must be in STATE_SYNC
+ * \param[in] length Number of bytes available
+ * \return The number of bytes to skip to reach the next sync candidate
+ *         (length if the span holds none)
+ */
+qint32 UAVTalk::scanForSync(const quint8 *data, qint32 length)
+{
+    const quint8 *sync = (const quint8 *)memchr(data, SYNC_VAL, length);
+    qint32 skipped     = (sync != NULL) ? (qint32)(sync - data) : length;
+
+    if (skipped > 0) {
+        stats.rxBytes      += skipped;
+        stats.rxSyncErrors += skipped;
+        rxPacketLength     += skipped;
+        if (useUDPMirror || relayFrames) {
+            rxDataArray.append((const char *)data, skipped);
+        }
+    }
+    return skipped;
+}
+
+/**
+ * Handle a fully received packet (state machine reached STATE_COMPLETE)
+ */
+void UAVTalk::processCompletedPacket()
+{
+    GCS_TRACE_SCOPE("UAVTalk::processCompletedPacket");
+
+    mutex.lock();
+    if (receiveObject(rxType, rxObjId, rxInstId, rxBuffer, rxLength)) {
+        stats.rxObjectBytes += rxLength;
+        stats.rxObjects++;
+
+        // Per-object rate and inter-arrival accounting
+        ObjectStats *objStat = findObjectStats(rxObjId);
+        if (objStat != NULL) {
+            qint64 now = statsClock.elapsed();
+            if (objStat->rxCount > 0) {
+                objStat->interArrivalHist[statsBucket(now - objStat->lastRxTime)]++;
+            }
+            objStat->lastRxTime = now;
+            objStat->rxCount++;
+        }
+    } else {
+        // TODO...
+    }
+    mutex.unlock();
+
+    if (useUDPMirror) {
+        // it is safe to do this outside of the above critical section as the rxDataArray is
+        // accessed from this thread only
+        appendToMirror((const quint8 *)rxDataArray.constData(), rxDataArray.size());
+    }
+    if (relayFrames) {
+        // the frame passed the CRC check, publish the raw bytes for verbatim
+        // forwarding. The QByteArray is implicitly shared, the clear() at the
+        // start of the next frame detaches instead of overwriting it.
+        emit frameReceived(rxDataArray);
+    }
+}
+
+/**
+ * Producer side of the rx ring, called from the reader thread.
+ *
+ * Drains the io device into the lock-free ring without taking the object
+ * mutex, then wakes the parser on this object's thread. When the ring is
+ * full the remaining bytes are dropped and counted as queue overruns : the
+ * parser resynchronizes on the next sync byte, exactly as it does after a
+ * serial error.
+ */
+void UAVTalk::produceInputStream()
+{
+    if (io.isNull() || !io->isReadable()) {
+        return;
+    }
+
+    bool queued = false;
+    while (true) {
+        int head = rxRingHead.load();
+        int tail = rxRingTail.loadAcquire();
+        int used = (head - tail) & (RX_RING_SIZE - 1);
+        int free = RX_RING_SIZE - 1 - used;
+        if (free == 0) {
+            // The consumer is not keeping up, drop what is left in the device
+            qint64 dropped = io->read((char *)rxReadBuffer, RX_READ_BUFFER_SIZE);
+            if (dropped <= 0) {
+                break;
+            }
+            rxQueueDropped.fetchAndAddRelaxed((int)dropped);
+            continue;
+        }
+        // Limit the read to the contiguous span up to the end of the ring
+        int index = head & (RX_RING_SIZE - 1);
+        int chunk = qMin(free, RX_RING_SIZE - index);
+        qint64 bytesRead = io->read((char *)&rxRingBuffer[index], chunk);
+        if (bytesRead <= 0) {
+            break;
+        }
+        rxRingHead.storeRelease(head + (int)bytesRead);
+        if (used + (int)bytesRead > rxQueueDepthPeak.load()) {
+            rxQueueDepthPeak.store(used + (int)bytesRead);
+        }
+        queued = true;
+    }
+    if (queued) {
+        if (rxQueueStampMs.load() == 0) {
+            // stamp the queue time of this batch (forced nonzero, at most
+            // 1 ms of skew) so the consumer can measure how long it waited
+            rxQueueStampMs.store((int)statsClock.elapsed() | 1);
+        }
+        emit inputQueueReady();
+    }
+}
+
+/**
+ * Decode a whole memory buffer of UAVTalk frames in one pass.
+ *
+ * This is the batch entry point used for log replay : it feeds the buffer
+ * straight through the receive state machine and applies decoded objects to
+ * the object manager synchronously, without transmitting acks or per-packet
+ * event round trips through the io device path. Only plain OBJ frames are
+ * applied, which is all a recorded log stream contains; other frame types
+ * are parsed and skipped.
+ *
+ * \param[in] data Buffer holding consecutive UAVTalk frames
+ * \param[in] length Number of bytes in the buffer
+ * \return The number of objects decoded and applied
+ */
+qint32 UAVTalk::decodeBuffer(const quint8 *data, qint32 length)
+{
+    QMutexLocker locker(&mutex);
+
+    qint32 decoded = 0;
+
+    for (qint32 i = 0; i < length; ++i) {
+        if (rxState == STATE_SYNC) {
+            i += scanForSync(&data[i], length - i);
+            if (i >= length) {
+                break;
+            }
+        }
+        processInputByte(data[i]);
+        if (rxState == STATE_COMPLETE) {
+            if ((rxType == TYPE_OBJ) && (rxInstId != ALL_INSTANCES)) {
+                if (updateObject(rxObjId, rxInstId, rxBuffer) != NULL) {
                     stats.rxObjectBytes += rxLength;
                     stats.rxObjects++;
-                } else {
-                    // TODO...
+                    ++decoded;
                 }
-                mutex.unlock();
+            }
+        }
+    }
+    return decoded;
+}
+
+/**
+ * Consumer side of the rx ring, runs the state machine over the queued bytes.
+ */
+void UAVTalk::processInputQueue()
+{
+    // Turn the producer's queue stamp into a service latency sample
+    int stamp = rxQueueStampMs.fetchAndStoreRelaxed(0);
+
+    if (stamp != 0) {
+        int latency = (int)statsClock.elapsed() - stamp;
+        if (latency > rxQueueLatencyPeak.load()) {
+            rxQueueLatencyPeak.store(latency);
+        }
+    }
+
+    int tail = rxRingTail.load();
 
-                if (useUDPMirror) {
-                    // it is safe to do this outside of the above critical section as the rxDataArray is
-                    // accessed from this thread only
-                    udpSocketTx->writeDatagram(rxDataArray, QHostAddress::LocalHost, udpSocketRx->localPort());
+    while (true) {
+        int head = rxRingHead.loadAcquire();
+        if (tail == head) {
+            break;
+        }
+        while (tail != head) {
+            if (rxState == STATE_SYNC) {
+                // scan the contiguous span up to the end of the ring in bulk
+                int index = tail & (RX_RING_SIZE - 1);
+                int span  = qMin((head - tail) & (RX_RING_SIZE - 1), RX_RING_SIZE - index);
+                tail += scanForSync(&rxRingBuffer[index], span);
+                if (tail == head) {
+                    break;
                 }
             }
+            processInputByte(rxRingBuffer[tail & (RX_RING_SIZE - 1)]);
+            ++tail;
+            if (rxState == STATE_COMPLETE) {
+                processCompletedPacket();
+            }
         }
+        // Publish the consumed span before checking for more data
+        rxRingTail.storeRelease(tail);
     }
 }
 
@@ -248,7 +658,7 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
     if (rxState == STATE_COMPLETE || rxState == STATE_ERROR) {
         rxState = STATE_SYNC;
 
-        if (useUDPMirror) {
+        if (useUDPMirror || relayFrames) {
             rxDataArray.clear();
         }
     }
@@ -259,7 +669,7 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
     // update packet byte count
     rxPacketLength++;
 
-    if (useUDPMirror) {
+    if (useUDPMirror || relayFrames) {
         rxDataArray.append(rxbyte);
     }
 
@@ -372,6 +782,10 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
             // Determine data length
             if (rxType == TYPE_OBJ_REQ || rxType == TYPE_ACK || rxType == TYPE_NACK) {
                 rxLength = 0;
+            } else if (rxType == TYPE_OBJ_DELTA) {
+                // delta payloads are variable length, the header size field
+                // is authoritative
+                rxLength = packetSize - rxPacketLength;
             } else {
                 if (rxObj) {
                     rxLength = rxObj->getNumBytes();
@@ -474,8 +888,6 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
  */
 bool UAVTalk::receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *data, qint32 length)
 {
-    Q_UNUSED(length);
-
     UAVObject *obj    = NULL;
     bool error        = false;
     bool allInstances = (instId == ALL_INSTANCES);
@@ -491,6 +903,10 @@ bool UAVTalk::receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *
             VERBOSE_FILTER(objId) qDebug() << "UAVTalk - received object" << objId << instId << (obj != NULL ? obj->toStringBrief() : "<null object>");
 #endif
             if (obj != NULL) {
+                // a full frame (re)synchronizes the delta reference
+                if (useDeltaEncoding) {
+                    rxShadow.insert(shadowKey(objId, instId), QByteArray((const char *)data, length));
+                }
                 // Check if this object acks a pending OBJ_REQ message
                 // any OBJ message can ack a pending OBJ_REQ message
                 // even one that was not sent in response to the OBJ_REQ message
@@ -503,6 +919,39 @@ bool UAVTalk::receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *
         }
         break;
 
+    case TYPE_OBJ_DELTA:
+        // All instances, not allowed for OBJ_DELTA messages
+        if (!allInstances) {
+            // Reconstruct the payload against the last full payload received
+            // for this object, then treat the result like a plain OBJ frame.
+            // Without a reference (e.g. the full frame got lost) the delta is
+            // dropped; the sender inserts full frames periodically to
+            // resynchronize.
+            quint64 key = shadowKey(objId, instId);
+            if (rxShadow.contains(key)) {
+                QByteArray reconstructed = rxShadow.value(key);
+                if (applyDeltaPayload(data, length, (quint8 *)reconstructed.data(), reconstructed.size())) {
+                    rxShadow.insert(key, reconstructed);
+                    obj = updateObject(objId, instId, (quint8 *)reconstructed.data());
+#ifdef VERBOSE_UAVTALK
+                    VERBOSE_FILTER(objId) qDebug() << "UAVTalk - received object (delta)" << objId << instId << (obj != NULL ? obj->toStringBrief() : "<null object>");
+#endif
+                    if (obj != NULL) {
+                        updateAck(TYPE_OBJ, objId, instId, obj);
+                    } else {
+                        error = true;
+                    }
+                } else {
+                    error = true;
+                }
+            } else {
+                error = true;
+            }
+        } else {
+            error = true;
+        }
+        break;
+
     case TYPE_OBJ_ACK:
         // All instances, not allowed for OBJ_ACK messages
         if (!allInstances) {
@@ -512,6 +961,9 @@ bool UAVTalk::receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *
             VERBOSE_FILTER(objId) qDebug() << "UAVTalk - received object (acked)" << objId << instId << (obj != NULL ? obj->toStringBrief() : "<null object>");
 #endif
             if (obj != NULL) {
+                if (useDeltaEncoding) {
+                    rxShadow.insert(shadowKey(objId, instId), QByteArray((const char *)data, length));
+                }
                 // Object updated or created, transmit ACK
                 error = !transmitObject(TYPE_ACK, objId, instId, obj);
             } else {
@@ -626,6 +1078,15 @@ UAVObject *UAVTalk::updateObject(quint32 objId, quint16 instId, quint8 *data)
         instObj->unpack(data);
         return instObj;
     } else {
+        // On bonded secondary links, drop a payload that is byte identical
+        // to the current content : the same update already arrived on
+        // another link and firing the events again would double every
+        // consumer's work
+        if (dedupeIdenticalUpdates
+            && obj->pack(rxCompareBuffer)
+            && (memcmp(rxCompareBuffer, data, obj->getNumBytes()) == 0)) {
+            return obj;
+        }
         // Unpack data into object instance
         obj->unpack(data);
         return obj;
@@ -643,6 +1104,11 @@ void UAVTalk::updateAck(quint8 type, quint32 objId, quint16 instId, UAVObject *o
     }
     Transaction *trans = findTransaction(objId, instId);
     if (trans && trans->respType == type) {
+        // Account the round-trip time of the completed transaction
+        ObjectStats *objStat = findObjectStats(objId);
+        if (objStat != NULL) {
+            objStat->roundTripHist[statsBucket(statsClock.elapsed() - trans->startTime)]++;
+        }
         if (trans->respInstId == ALL_INSTANCES) {
             if (instId == 0) {
                 // last instance received, complete transaction
@@ -741,20 +1207,40 @@ bool UAVTalk::transmitObject(quint8 type, quint32 objId, quint16 instId, UAVObje
  * \return Success (true), Failure (false)
  */
 bool UAVTalk::transmitSingleObject(quint8 type, quint32 objId, quint16 instId, UAVObject *obj)
+{
+    qint32 frameLength = packSingleObject(type, objId, instId, obj, txBuffer);
+
+    if (frameLength < 0) {
+        return false;
+    }
+    return transmitFrameBuffer(txBuffer, frameLength);
+}
+
+/**
+ * Pack a complete frame (header, payload and checksum) into the supplied buffer.
+ * The buffer must be able to hold at least MAX_PACKET_LENGTH bytes.
+ * \param[in] type Transaction type
+ * \param[in] objId Object ID to send
+ * \param[in] instId Instance ID to send
+ * \param[in] obj Object to send (null when type is NACK)
+ * \param[out] buf Destination buffer
+ * \return The frame length in bytes, or -1 on failure
+ */
+qint32 UAVTalk::packSingleObject(quint8 type, quint32 objId, quint16 instId, UAVObject *obj, quint8 *buf)
 {
     qint32 length;
 
     // IMPORTANT : obj can be null (when type is NACK for example)
 
     // Setup sync byte
-    txBuffer[0] = SYNC_VAL;
+    buf[0] = SYNC_VAL;
     // Setup type
-    txBuffer[1] = type;
+    buf[1] = type;
     // next 2 bytes are reserved for data length (inserted here later)
     // Setup object ID
-    qToLittleEndian<quint32>(objId, &txBuffer[4]);
+    qToLittleEndian<quint32>(objId, &buf[4]);
     // Setup instance ID
-    qToLittleEndian<quint16>(instId, &txBuffer[8]);
+    qToLittleEndian<quint16>(instId, &buf[8]);
 
     // Determine data length
     if (type == TYPE_OBJ_REQ || type == TYPE_ACK || type == TYPE_NACK) {
@@ -767,30 +1253,70 @@ bool UAVTalk::transmitSingleObject(quint8 type, quint32 objId, quint16 instId, U
     if (length >= MAX_PAYLOAD_LENGTH) {
         qWarning() << "UAVTalk - error transmitting : object exceeds max payload length" << obj->toStringBrief();
         ++stats.txErrors;
-        return false;
+        return -1;
     }
 
     // Copy data (if any)
     if (length > 0) {
-        if (!obj->pack(&txBuffer[HEADER_LENGTH])) {
+        if (!obj->pack(&buf[HEADER_LENGTH])) {
             qWarning() << "UAVTalk - error transmitting : failed to pack object" << obj->toStringBrief();
             ++stats.txErrors;
-            return false;
+            return -1;
+        }
+    }
+
+    // Try to shrink unacked OBJ payloads into a delta frame against the last
+    // transmitted payload of the same object. Offsets are single bytes, so
+    // only payloads up to 255 bytes qualify (all generated objects do).
+    if (useDeltaEncoding && (type == TYPE_OBJ) && (length > 0) && (length <= 0xFF)) {
+        DeltaShadow &shadow = txShadow[shadowKey(objId, instId)];
+        qint32 deltaLength  = -1;
+        if ((shadow.payload.size() == length) && (shadow.sinceFull < DELTA_FULL_FRAME_INTERVAL)) {
+            deltaLength = packDeltaPayload((const quint8 *)shadow.payload.constData(), &buf[HEADER_LENGTH], length, txDeltaBuffer);
+        }
+        shadow.payload = QByteArray((const char *)&buf[HEADER_LENGTH], length);
+        if (deltaLength >= 0) {
+            shadow.sinceFull++;
+            memcpy(&buf[HEADER_LENGTH], txDeltaBuffer, deltaLength);
+            buf[1] = TYPE_OBJ_DELTA;
+            length = deltaLength;
+        } else {
+            // full frame, resynchronizes the receiver
+            shadow.sinceFull = 0;
         }
     }
 
     // Store the packet length
-    qToLittleEndian<quint16>(HEADER_LENGTH + length, &txBuffer[2]);
+    qToLittleEndian<quint16>(HEADER_LENGTH + length, &buf[2]);
 
     // Calculate checksum
-    txBuffer[HEADER_LENGTH + length] = Crc::updateCRC(0, txBuffer, HEADER_LENGTH + length);
+    buf[HEADER_LENGTH + length] = Crc::updateCRC(0, buf, HEADER_LENGTH + length);
+
+    // Update stats
+    ++stats.txObjects;
+    stats.txObjectBytes += length;
+    ObjectStats *objStat = findObjectStats(objId);
+    if (objStat != NULL) {
+        objStat->txCount++;
+    }
 
+    return HEADER_LENGTH + length + CHECKSUM_LENGTH;
+}
+
+/**
+ * Write one or more packed frames to the io device.
+ * \param[in] buf Buffer holding the packed frame(s)
+ * \param[in] length Total number of bytes to write
+ * \return Success (true), Failure (false)
+ */
+bool UAVTalk::transmitFrameBuffer(const quint8 *buf, qint32 length)
+{
     // Send buffer, check that the transmit backlog does not grow above limit
     if (!io.isNull() && io->isWritable()) {
         if (io->bytesToWrite() < TX_BUFFER_SIZE) {
-            io->write((const char *)txBuffer, HEADER_LENGTH + length + CHECKSUM_LENGTH);
+            io->write((const char *)buf, length);
             if (useUDPMirror) {
-                udpSocketRx->writeDatagram((const char *)txBuffer, HEADER_LENGTH + length + CHECKSUM_LENGTH, QHostAddress::LocalHost, udpSocketTx->localPort());
+                appendToMirror(buf, length);
             }
         } else {
             qWarning() << "UAVTalk - error transmitting : io device full";
@@ -804,14 +1330,91 @@ bool UAVTalk::transmitSingleObject(quint8 type, quint32 objId, quint16 instId, U
     }
 
     // Update stats
-    ++stats.txObjects;
-    stats.txObjectBytes += length;
-    stats.txBytes += HEADER_LENGTH + length + CHECKSUM_LENGTH;
+    stats.txBytes += length;
 
     // Done
     return true;
 }
 
+quint64 UAVTalk::shadowKey(quint32 objId, quint16 instId)
+{
+    return ((quint64)objId << 32) | instId;
+}
+
+/**
+ * Encode the difference between two payloads of equal length as runs of
+ * changed bytes : [offset(1), runLength(1), bytes...] repeated. Unchanged
+ * gaps shorter than the run header are absorbed into the surrounding run.
+ * \param[in] ref The reference (last transmitted) payload
+ * \param[in] cur The payload to transmit
+ * \param[in] length Payload length, at most 255 bytes
+ * \param[out] dest Destination buffer for the encoded runs
+ * \return The encoded length, or -1 when the delta is not smaller than the
+ *         full payload (the caller then sends a full frame)
+ */
+qint32 UAVTalk::packDeltaPayload(const quint8 *ref, const quint8 *cur, qint32 length, quint8 *dest)
+{
+    qint32 out = 0;
+    qint32 i   = 0;
+
+    while (i < length) {
+        if (ref[i] == cur[i]) {
+            ++i;
+            continue;
+        }
+        // extend the run while further changes follow within the two bytes a
+        // separate run header would cost
+        qint32 start = i;
+        qint32 end   = i + 1;
+        while ((end < length) && ((end - start) < 0xFF)) {
+            if ((ref[end] != cur[end])
+                || ((end + 1 < length) && (ref[end + 1] != cur[end + 1]))
+                || ((end + 2 < length) && (ref[end + 2] != cur[end + 2]))) {
+                ++end;
+            } else {
+                break;
+            }
+        }
+        if (out + 2 + (end - start) >= length) {
+            // no gain over a full frame
+            return -1;
+        }
+        dest[out++] = (quint8)start;
+        dest[out++] = (quint8)(end - start);
+        memcpy(&dest[out], &cur[start], end - start);
+        out += end - start;
+        i    = end;
+    }
+    // an empty delta is valid : the payload did not change at all
+    return out;
+}
+
+/**
+ * Apply an encoded delta payload onto a reconstruction buffer holding the
+ * reference payload.
+ * \return False when the encoding is inconsistent with the object size, the
+ *         frame is then dropped and the next full frame resynchronizes.
+ */
+bool UAVTalk::applyDeltaPayload(const quint8 *payload, qint32 payloadLength, quint8 *objData, qint32 objLength)
+{
+    qint32 i = 0;
+
+    while (i < payloadLength) {
+        if (i + 2 > payloadLength) {
+            return false;
+        }
+        qint32 start     = payload[i];
+        qint32 runLength = payload[i + 1];
+        i += 2;
+        if ((runLength == 0) || (start + runLength > objLength) || (i + runLength > payloadLength)) {
+            return false;
+        }
+        memcpy(&objData[start], &payload[i], runLength);
+        i += runLength;
+    }
+    return true;
+}
+
 UAVTalk::Transaction *UAVTalk::findTransaction(quint32 objId, quint16 instId)
 {
     // Lookup the transaction in the transaction map
@@ -834,6 +1437,7 @@ void UAVTalk::openTransaction(quint8 type, quint32 objId, quint16 instId)
     trans->respType   = (type == TYPE_OBJ_REQ) ? TYPE_OBJ : TYPE_ACK;
     trans->respObjId  = objId;
     trans->respInstId = instId;
+    trans->startTime  = statsClock.elapsed();
 
     QMap<quint32, Transaction *> *objTransactions = transMap.value(trans->respObjId, NULL);
     if (objTransactions == NULL) {
@@ -896,6 +1500,11 @@ const char *UAVTalk::typeToString(quint8 type)
     case TYPE_NACK:
         return "nack";
 
+        break;
+
+    case TYPE_OBJ_DELTA:
+        return "object (delta)";
+
         break;
     }
     return "<error>";
@@ -58,24 +58,80 @@ public:
         quint32 rxErrors;
         quint32 rxSyncErrors;
         quint32 rxCrcErrors;
+        quint32 rxQueueOverruns;
+        quint32 rxQueueDepthPeak;     /** highest rx ring occupancy in bytes seen by the producer */
+        quint32 rxQueueLatencyPeakMs; /** longest time queued bytes waited before the parser picked them up */
     } ComStats;
 
+    // Per-object link statistics, kept in a fixed open addressing table on
+    // the hot path (no allocation per packet). The histograms use log2(ms)
+    // buckets : bucket 0 is 0 ms, bucket n covers [2^(n-1), 2^n) ms.
+    static const int OBJECT_STATS_BUCKETS = 16;
+
+    typedef struct {
+        quint32 objId;
+        quint32 rxCount;
+        quint32 txCount;
+        qint64  lastRxTime; /** ms since link creation */
+        quint32 interArrivalHist[OBJECT_STATS_BUCKETS];
+        quint32 roundTripHist[OBJECT_STATS_BUCKETS];
+    } ObjectStats;
+
     UAVTalk(QIODevice *iodev, UAVObjectManager *objMngr);
     ~UAVTalk();
 
     ComStats getStats();
+    QList<ObjectStats> getObjectStats();
     void resetStats();
 
+    // Number of bytes accepted for transmission but not yet handed to the OS,
+    // i.e. the send backlog sitting in the io device. Used by the telemetry
+    // rate governor as a congestion signal.
+    qint64 getPendingTxBytes();
+
+    qint32 decodeBuffer(const quint8 *data, qint32 length);
+
     bool sendObject(UAVObject *obj, bool acked, bool allInstances);
+    bool sendObjectsBurst(const QList<UAVObject *> &objs);
     bool sendObjectRequest(UAVObject *obj, bool allInstances);
     void cancelTransaction(UAVObject *obj);
 
+    // Re-bind the link to another io device, keeping parser state, the
+    // statistics and any open transactions. Used for warm link handover :
+    // the caller must detach the old device's readyRead signal first.
+    void setIODevice(QIODevice *iodev);
+
+    // Enable or disable delta encoding of outgoing OBJ frames. Off by
+    // default : both ends of the link must understand OBJ_DELTA frames, so
+    // the owner of the link enables it only when the peer supports them.
+    void setDeltaEncoding(bool enabled);
+    bool deltaEncoding() const;
+
+    // When enabled, a received payload that is byte identical to the current
+    // object content is acknowledged but not applied, so it fires no update
+    // events. Used on secondary links of a bonded telemetry setup : the copy
+    // that arrives first wins, late duplicates are dropped. Off by default.
+    void setDedupeIdenticalUpdates(bool enabled);
+
+    // When enabled, every frame that passes the CRC check is additionally
+    // published as raw bytes through frameReceived(), so a relay can forward
+    // it verbatim without a decode/re-encode round trip. Off by default.
+    void setFrameRelay(bool enabled);
+
+    // How long validated frames may sit in the multicast mirror buffer
+    // before the batch is published, when the UDP mirror is enabled in the
+    // general settings. 0 publishes every frame in its own datagram.
+    void setMirrorAggregationWindow(int windowMs);
+
 signals:
     void transactionCompleted(UAVObject *obj, bool success);
+    void inputQueueReady();
+    void frameReceived(QByteArray frame);
 
 private slots:
     void processInputStream();
-    void dummyUDPRead();
+    void processInputQueue();
+    void flushMirror();
 
 private:
 
@@ -83,16 +139,24 @@ private:
         quint8  respType;
         quint32 respObjId;
         quint16 respInstId;
+        qint64  startTime; /** statsClock time the transaction was opened, for round-trip stats */
     } Transaction;
 
     // Constants
     static const int TYPE_MASK     = 0xF8;
     static const int TYPE_VER      = 0x20;
-    static const int TYPE_OBJ      = (TYPE_VER | 0x00);
-    static const int TYPE_OBJ_REQ  = (TYPE_VER | 0x01);
-    static const int TYPE_OBJ_ACK  = (TYPE_VER | 0x02);
-    static const int TYPE_ACK      = (TYPE_VER | 0x03);
-    static const int TYPE_NACK     = (TYPE_VER | 0x04);
+    static const int TYPE_OBJ       = (TYPE_VER | 0x00);
+    static const int TYPE_OBJ_REQ   = (TYPE_VER | 0x01);
+    static const int TYPE_OBJ_ACK   = (TYPE_VER | 0x02);
+    static const int TYPE_ACK       = (TYPE_VER | 0x03);
+    static const int TYPE_NACK      = (TYPE_VER | 0x04);
+    // Delta encoded object payload : runs of changed bytes against the last
+    // payload seen for the same object/instance, see packDeltaPayload()
+    static const int TYPE_OBJ_DELTA = (TYPE_VER | 0x05);
+
+    // A full frame is inserted after this many consecutive delta frames of an
+    // object so a receiver that lost a frame resynchronizes quickly
+    static const int DELTA_FULL_FRAME_INTERVAL = 16;
 
     // header : sync(1), type (1), size(2), object ID(4), instance ID(2)
     static const int HEADER_LENGTH = 10;
@@ -105,11 +169,38 @@ private:
 
     static const int TX_BUFFER_SIZE     = 2 * 1024;
 
+    static const int RX_READ_BUFFER_SIZE = 4 * 1024;
+
+    // Maximum number of frames coalesced into a single write by sendObjectsBurst()
+    static const int TX_BURST_FRAMES     = 8;
+
+    // Size of the single-producer/single-consumer rx ring, must be a power of two
+    static const int RX_RING_SIZE = 32 * 1024;
+
+    // Number of slots of the per-object statistics table, must be a power of two
+    static const int OBJECT_STATS_SLOTS = 256;
+
+    // Multicast group and port the telemetry stream mirror publishes to
+    static const char *MIRROR_GROUP;
+    static const quint16 MIRROR_PORT = 9000;
+    // Payload budget per mirror datagram, kept under a typical ethernet MTU
+    static const int MIRROR_MAX_DATAGRAM = 1400;
+    // Default aggregation window before a partial batch is published anyway
+    static const int MIRROR_WINDOW_MS    = 20;
+
     // Types
     typedef enum {
         STATE_SYNC, STATE_TYPE, STATE_SIZE, STATE_OBJID, STATE_INSTID, STATE_DATA, STATE_CS, STATE_COMPLETE, STATE_ERROR
     } RxStateType;
 
+    // Last payload exchanged for an object/instance, reference for delta
+    // encoding and decoding
+    typedef struct DeltaShadow {
+        DeltaShadow() : sinceFull(0) {}
+        QByteArray payload;
+        quint8     sinceFull;
+    } DeltaShadow;
+
     // Variables
     QPointer<QIODevice> io;
 
@@ -117,6 +208,9 @@ private:
 
     ComStats stats;
 
+    ObjectStats objStats[OBJECT_STATS_SLOTS];
+    QElapsedTimer statsClock;
+
     QMutex mutex;
 
     QMap<quint32, QMap<quint32, Transaction *> *> transMap;
@@ -125,6 +219,27 @@ private:
 
     quint8 txBuffer[MAX_PACKET_LENGTH];
 
+    // Reusable buffer used to drain the io device in bulk instead of one byte per read() call
+    quint8 rxReadBuffer[RX_READ_BUFFER_SIZE];
+
+    // Aggregation buffer used to emit several frames as a single write burst
+    quint8 txBurstBuffer[TX_BURST_FRAMES * MAX_PACKET_LENGTH];
+
+    // Lock-free single-producer/single-consumer byte queue between the reader
+    // thread (produceInputStream) and the parser (processInputQueue). The
+    // indices are free running and masked with RX_RING_SIZE - 1 on access.
+    quint8 rxRingBuffer[RX_RING_SIZE];
+    QAtomicInt rxRingHead;     // written by the producer only
+    QAtomicInt rxRingTail;     // written by the consumer only
+    QAtomicInt rxQueueDropped; // bytes dropped because the ring was full, updated by the producer
+    // Service latency instrumentation : the producer stamps the queue time of
+    // the oldest unserviced batch, the consumer turns it into a latency sample
+    // when it starts draining. Peaks prove frames are serviced within a
+    // bounded delay regardless of GUI load.
+    QAtomicInt rxQueueStampMs;     // statsClock time the pending data was queued, 0 if none pending
+    QAtomicInt rxQueueDepthPeak;   // updated by the producer only
+    QAtomicInt rxQueueLatencyPeak; // updated by the consumer only
+
     // Variables used by the receive state machine
     // state machine variables
     qint32 rxCount;
@@ -140,20 +255,57 @@ private:
     quint8 rxCSPacket;
     quint8 rxCS;
 
+    // Multicast mirror of the validated telemetry stream. Frames from both
+    // directions are batched into datagrams no frame ever straddles, so any
+    // number of listen-only stations can parse the one stream and a lost
+    // datagram costs whole frames only.
     bool useUDPMirror;
-    QUdpSocket *udpSocketTx;
-    QUdpSocket *udpSocketRx;
+    QUdpSocket *mirrorSocket;
+    QByteArray mirrorBuffer;
+    QTimer     *mirrorTimer;
+    int mirrorWindowMs;
+    void appendToMirror(const quint8 *data, qint32 length);
+
     QByteArray rxDataArray;
 
+    // See setFrameRelay(). Shares the rxDataArray frame capture with the UDP
+    // mirror, both need the raw bytes of the frame being parsed.
+    bool relayFrames;
+
+    // Delta encoding state : last payload per object/instance on each
+    // direction, keyed by (objId << 32) | instId
+    bool useDeltaEncoding;
+    QHash<quint64, DeltaShadow> txShadow;
+    QHash<quint64, QByteArray> rxShadow;
+    // Scratch buffer the delta payload is encoded into before it replaces
+    // the full payload in the frame buffer
+    quint8 txDeltaBuffer[MAX_PAYLOAD_LENGTH];
+
+    // See setDedupeIdenticalUpdates()
+    bool dedupeIdenticalUpdates;
+    quint8 rxCompareBuffer[MAX_PAYLOAD_LENGTH];
+
     // Methods
+    void produceInputStream();
+    void processCompletedPacket();
     bool objectTransaction(quint8 type, quint32 objId, quint16 instId, UAVObject *obj);
     bool processInputByte(quint8 rxbyte);
+    qint32 scanForSync(const quint8 *data, qint32 length);
     bool receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *data, qint32 length);
     UAVObject *updateObject(quint32 objId, quint16 instId, quint8 *data);
     void updateAck(quint8 type, quint32 objId, quint16 instId, UAVObject *obj);
     void updateNack(quint32 objId, quint16 instId, UAVObject *obj);
     bool transmitObject(quint8 type, quint32 objId, quint16 instId, UAVObject *obj);
     bool transmitSingleObject(quint8 type, quint32 objId, quint16 instId, UAVObject *obj);
+    qint32 packSingleObject(quint8 type, quint32 objId, quint16 instId, UAVObject *obj, quint8 *buf);
+    bool transmitFrameBuffer(const quint8 *buf, qint32 length);
+
+    ObjectStats *findObjectStats(quint32 objId);
+    static int statsBucket(qint64 ms);
+
+    static quint64 shadowKey(quint32 objId, quint16 instId);
+    static qint32 packDeltaPayload(const quint8 *ref, const quint8 *cur, qint32 length, quint8 *dest);
+    static bool applyDeltaPayload(const quint8 *payload, qint32 payloadLength, quint8 *objData, qint32 objLength);
 
     Transaction *findTransaction(quint32 objId, quint16 instId);
     void openTransaction(quint8 type, quint32 objId, quint16 instId);
@@ -26,6 +26,8 @@
  */
 #include "uavtalkplugin.h"
 
+#include "uavobjects/uavobjectsinit.h"
+
 #include <coreplugin/icore.h>
 #include <coreplugin/connectionmanager.h>
 
@@ -59,12 +61,69 @@ bool UAVTalkPlugin::initialize(const QStringList & arguments, QString *errorStri
                      this, SLOT(onDeviceConnect(QIODevice *)));
     QObject::connect(cm, SIGNAL(deviceAboutToDisconnect()),
                      this, SLOT(onDeviceDisconnect()));
+    QObject::connect(cm, SIGNAL(deviceSwitched(QIODevice *)),
+                     this, SLOT(onDeviceSwitch(QIODevice *)));
     return true;
 }
 
 void UAVTalkPlugin::shutdown()
 {}
 
+TelemetryManager *UAVTalkPlugin::createVehicleSession(QIODevice *dev)
+{
+    VehicleSession session;
+
+    // A fresh object manager populated with the full generated object set.
+    // The instances share their field descriptions with the other
+    // namespaces through the per type prototypes, so what is duplicated is
+    // essentially the packed data buffers.
+    session.objectManager    = new UAVObjectManager();
+    UAVObjectsInitialize(session.objectManager);
+
+    session.telemetryManager = new TelemetryManager(session.objectManager);
+    vehicleSessionList.append(session);
+
+    qDebug() << "UAVTalkPlugin - vehicle session created, total sessions" << (vehicleSessionList.size() + 1);
+    session.telemetryManager->start(dev);
+    return session.telemetryManager;
+}
+
+void UAVTalkPlugin::destroyVehicleSession(TelemetryManager *telemetryManager)
+{
+    for (int i = 0; i < vehicleSessionList.size(); ++i) {
+        if (vehicleSessionList.at(i).telemetryManager == telemetryManager) {
+            VehicleSession session = vehicleSessionList.takeAt(i);
+            session.telemetryManager->stop();
+            // stop() completes asynchronously on the telemetry thread, defer
+            // the deletions until its queue has drained
+            session.telemetryManager->deleteLater();
+            session.objectManager->deleteLater();
+            return;
+        }
+    }
+    qWarning() << "UAVTalkPlugin - attempt to destroy an unknown vehicle session";
+}
+
+QList<TelemetryManager *> UAVTalkPlugin::vehicleSessions() const
+{
+    QList<TelemetryManager *> sessions;
+
+    foreach(const VehicleSession &session, vehicleSessionList) {
+        sessions.append(session.telemetryManager);
+    }
+    return sessions;
+}
+
+void UAVTalkPlugin::addRelayOutput(QIODevice *dev)
+{
+    telMngr->addRelayOutput(dev);
+}
+
+void UAVTalkPlugin::removeRelayOutputs()
+{
+    telMngr->removeRelayOutputs();
+}
+
 void UAVTalkPlugin::onDeviceConnect(QIODevice *dev)
 {
     telMngr->start(dev);
@@ -74,3 +133,8 @@ void UAVTalkPlugin::onDeviceDisconnect()
 {
     telMngr->stop();
 }
+
+void UAVTalkPlugin::onDeviceSwitch(QIODevice *dev)
+{
+    telMngr->switchDevice(dev);
+}
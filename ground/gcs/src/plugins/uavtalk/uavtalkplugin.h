@@ -45,12 +45,36 @@ public:
     bool initialize(const QStringList & arguments, QString *errorString);
     void shutdown();
 
+    // Multi-vehicle support : each additional aircraft gets its own
+    // telemetry session with a vehicle scoped object namespace, so objects
+    // of several vehicles never overwrite each other. Field descriptions are
+    // shared between namespaces through the per type prototypes, keeping the
+    // per vehicle overhead to the data buffers. Gadgets resolve a vehicle's
+    // objects through session->objectManager() instead of the pool manager.
+    TelemetryManager *createVehicleSession(QIODevice *dev);
+    void destroyVehicleSession(TelemetryManager *session);
+    QList<TelemetryManager *> vehicleSessions() const;
+
+    // Relay mode : re-serve the telemetry stream to downstream GCS stations.
+    // Frames are CRC validated once by the primary link parser and forwarded
+    // byte for byte to every attached output, without a decode/re-encode
+    // round trip through the object manager.
+    void addRelayOutput(QIODevice *dev);
+    void removeRelayOutputs();
+
 protected slots:
     void onDeviceConnect(QIODevice *dev);
     void onDeviceDisconnect();
+    void onDeviceSwitch(QIODevice *dev);
 
 private:
+    typedef struct {
+        TelemetryManager *telemetryManager;
+        UAVObjectManager *objectManager;
+    } VehicleSession;
+
     TelemetryManager *telMngr;
+    QList<VehicleSession> vehicleSessionList;
 };
 
 #endif // UAVTALKPLUGIN_H
@@ -65,10 +65,17 @@ int16_t port::pfSerialRead(void)
 
 void port::pfSerialWrite(uint8_t c)
 {
-    char cc[1];
+    // collect the bytes of the frame being built, pfSerialFlush hands the
+    // whole frame to the serial port in a single write
+    txBlock.append((char)c);
+}
 
-    cc[0] = c;
-    sport->write(cc, 1);
+void port::pfSerialFlush(void)
+{
+    if (!txBlock.isEmpty()) {
+        sport->write(txBlock);
+        txBlock.clear();
+    }
 }
 
 uint32_t port::pfGetTime(void)
@@ -37,7 +37,8 @@ class port {
 public:
     enum portstatus { open, closed, error };
     virtual int16_t pfSerialRead(void); // function to read a character from the serial input stream
-    virtual void pfSerialWrite(uint8_t); // function to write a byte to be sent out the serial port
+    virtual void pfSerialWrite(uint8_t); // function to queue a byte to be sent out the serial port
+    virtual void pfSerialFlush(void); // function to push the queued bytes out the serial port in one write
     virtual uint32_t pfGetTime(void);
     uint8_t retryCount; // how many times have we tried to transmit the 'send' packet
     uint8_t maxRetryCount; // max. times to try to transmit the 'send' packet
@@ -70,6 +71,7 @@ private:
     portstatus mstatus;
     QTime timer;
     QSerialPort *sport;
+    QByteArray txBlock; // bytes queued by pfSerialWrite until the next pfSerialFlush
 };
 
 #endif // PORT_H
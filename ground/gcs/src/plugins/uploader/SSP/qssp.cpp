@@ -414,6 +414,8 @@ void qssp::sf_SendPacket()
     for (uint8_t x = 0; x < packetLen; x++) {
         sf_write_byte(thisport->txBuf[x]);
     }
+    // the escaped frame is complete, push it out in a single write
+    thisport->pfSerialFlush();
     thisport->retryCount++;
 }
 
@@ -34,7 +34,6 @@ void qsspt::run()
     while (!endthread) {
         receivestatus = this->ssp_ReceiveProcess();
         sendstatus    = this->ssp_SendProcess();
-        msleep(1);
         sendbufmutex.lock();
         if (datapending && receivestatus == SSP_TX_IDLE) {
             this->ssp_SendData(mbuf, msize);
@@ -44,6 +43,14 @@ void qsspt::run()
         if (sendstatus == SSP_TX_ACKED) {
             sendwait.wakeAll();
         }
+        if (sendstatus == SSP_TX_WAITING) {
+            // a packet is in flight, poll closely for the ack, sleeping a full
+            // millisecond here would dominate the round trip on a USB CDC link
+            usleep(100);
+        } else if (receivestatus == SSP_RX_IDLE) {
+            // the link is quiet, back off
+            msleep(1);
+        }
     }
 }
 bool qsspt::sendData(uint8_t *buf, uint16_t size)
@@ -57,9 +64,9 @@ bool qsspt::sendData(uint8_t *buf, uint16_t size)
     msize = size;
     sendbufmutex.unlock();
     msendwait.lock();
-    sendwait.wait(&msendwait, 10000);
+    bool acked = sendwait.wait(&msendwait, 10000);
     msendwait.unlock();
-    return true;
+    return acked;
 }
 
 void qsspt::pfCallBack(uint8_t *buf, uint16_t size)
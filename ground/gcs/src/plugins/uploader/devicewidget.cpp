@@ -27,6 +27,8 @@
  */
 #include "devicewidget.h"
 
+#include <QtConcurrentRun>
+
 DeviceWidget::DeviceWidget(QWidget *parent) :
     QWidget(parent)
 {
@@ -45,6 +47,17 @@ DeviceWidget::DeviceWidget(QWidget *parent) :
     myDevice->statusIcon->setPixmap(QPixmap(":uploader/images/view-refresh.svg"));
 
     myDevice->lblCertified->setText("");
+
+    connect(&crcWatcher, SIGNAL(finished()), this, SLOT(loadedCRCReady()));
+    // emitted from the worker pool, delivery is queued onto the GUI thread
+    connect(this, SIGNAL(loadedCRCProgress(int)), this, SLOT(setProgress(int)));
+}
+
+DeviceWidget::~DeviceWidget()
+{
+    // a CRC computation still running on the worker pool reads the file
+    // mapping, which must not go away under it
+    crcWatcher.waitForFinished();
 }
 
 void DeviceWidget::showEvent(QShowEvent *event)
@@ -294,20 +307,40 @@ void DeviceWidget::loadFirmware(QString fwfilename)
         return;
     }
 
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly)) {
+    // a CRC still computing against the previous mapping must finish
+    // before that mapping is dropped
+    crcWatcher.waitForFinished();
+
+    loadedFW = QByteArray();
+    if (fwFile.isOpen()) {
+        fwFile.close();
+    }
+    fwFile.setFileName(filename);
+    if (!fwFile.open(QIODevice::ReadOnly)) {
         status("Can't open file", STATUSICON_FAIL);
         return;
     }
 
-    loadedFW = file.readAll();
+    // Map the file instead of reading it : only the pages actually touched
+    // fault in, so opening is instant; the CRC pass on the worker pool is
+    // what streams the bulk of the image off the media.
+    uchar *map = fwFile.map(0, fwFile.size());
+    if (map != NULL) {
+        loadedFW = QByteArray::fromRawData((const char *)map, fwFile.size());
+    } else {
+        // mapping can fail on exotic filesystems, fall back to a plain read
+        loadedFW = fwFile.readAll();
+    }
 
     QByteArray desc = loadedFW.right(100);
     QPixmap px;
     if (loadedFW.length() > (int)m_dfu->devices[deviceID].SizeOfCode) {
         myDevice->lblCRCL->setText(tr("Can't calculate, file too big for device"));
     } else {
-        myDevice->lblCRCL->setText(QString::number(DFUObject::CRCFromQBArray(loadedFW, m_dfu->devices[deviceID].SizeOfCode)));
+        myDevice->lblCRCL->setText(tr("Calculating..."));
+        setProgress(0);
+        crcWatcher.setFuture(QtConcurrent::run(this, &DeviceWidget::computeLoadedCRC,
+                                               loadedFW, (quint32)m_dfu->devices[deviceID].SizeOfCode));
     }
 
     // myDevice->lblFirmwareSizeL->setText(QString("Firmware size: ")+QVariant(loadedFW.length()).toString()+ QString(" bytes"));
@@ -315,10 +348,9 @@ void DeviceWidget::loadFirmware(QString fwfilename)
         myDevice->confirmCheckBox->setChecked(true);
         myDevice->verticalGroupBox_loaded->setVisible(true);
         myDevice->groupCustom->setVisible(false);
-        if (myDevice->lblCRC->text() == myDevice->lblCRCL->text()) {
-            myDevice->statusLabel->setText(tr("The board has the same firmware as loaded. No need to update."));
-            px.load(QString(":/uploader/images/warning.svg"));
-        } else if (myDevice->lblDevName->text() != myDevice->lblBrdNameL->text()) {
+        // the "same firmware as loaded" case is detected in loadedCRCReady()
+        // once the CRC lands, it cannot be decided here anymore
+        if (myDevice->lblDevName->text() != myDevice->lblBrdNameL->text()) {
             myDevice->statusLabel->setText(tr("WARNING: the loaded firmware is for different hardware. Do not update!"));
             px.load(QString(":/uploader/images/error.svg"));
         } else if (QDateTime::fromString(onBoardDescription.gitDate) > QDateTime::fromString(LoadedDescription.gitDate)) {
@@ -343,6 +375,62 @@ void DeviceWidget::loadFirmware(QString fwfilename)
     myDevice->statusIcon->setPixmap(px);
 }
 
+/**
+   Computes the verification CRC of the loaded image. Runs on the worker
+   pool : working through the image in slices faults the mapped pages in
+   gradually and lets progress be reported while a large file streams off
+   slow media. Same padding and polynomial as DFUObject::CRCFromQBArray.
+ */
+quint32 DeviceWidget::computeLoadedCRC(QByteArray image, quint32 sizeOfCode)
+{
+    // pad the image up to the full code region, the board CRCs all of it
+    image.append(QByteArray(sizeOfCode - image.length(), (char)255));
+
+    const quint32 chunkWords = 16 * 1024; // 64KiB slices
+    quint32 words = sizeOfCode / 4;
+    QVector<quint32> buffer(chunkWords);
+    quint32 crc    = 0xFFFFFFFF;
+    quint32 done   = 0;
+
+    while (done < words) {
+        quint32 n = qMin(chunkWords, words - done);
+        for (quint32 x = 0; x < n; x++) {
+            const char *p = image.constData() + (done + x) * 4;
+            quint32 aux   = (quint32)(quint8)p[3];
+            aux  = (aux << 8) + (quint32)(quint8)p[2];
+            aux  = (aux << 8) + (quint32)(quint8)p[1];
+            aux  = (aux << 8) + (quint32)(quint8)p[0];
+            buffer[x] = aux;
+        }
+        crc   = DFUObject::CRC32WideFast(crc, n, buffer.data());
+        done += n;
+        emit loadedCRCProgress((int)(done * 100 / words));
+    }
+    return crc;
+}
+
+/**
+   Callback for the worker pool CRC computation
+ */
+void DeviceWidget::loadedCRCReady()
+{
+    // a stale notification from a superseded computation must not make
+    // result() block on the new one
+    if (!crcWatcher.isFinished()) {
+        return;
+    }
+    myDevice->lblCRCL->setText(QString::number(crcWatcher.result()));
+
+    // finish the comparison loadFirmware() could not do while the value
+    // was still computing
+    if (myDevice->verticalGroupBox_loaded->isVisible()
+        && (myDevice->lblDevName->text() == myDevice->lblBrdNameL->text())
+        && (myDevice->lblCRC->text() == myDevice->lblCRCL->text())) {
+        myDevice->statusLabel->setText(tr("The board has the same firmware as loaded. No need to update."));
+        myDevice->statusIcon->setPixmap(QPixmap(":/uploader/images/warning.svg"));
+    }
+}
+
 /**
    Sends a firmware to the device
  */
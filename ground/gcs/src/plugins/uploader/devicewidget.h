@@ -35,6 +35,8 @@
 #include <QFileDialog>
 #include <QErrorMessage>
 #include <QByteArray>
+#include <QFile>
+#include <QFutureWatcher>
 #include <QtSvg/QGraphicsSvgItem>
 #include <QtSvg/QSvgRenderer>
 #include <QCryptographicHash>
@@ -49,6 +51,7 @@ class UPLOADER_EXPORT DeviceWidget : public QWidget {
     Q_OBJECT
 public:
     DeviceWidget(QWidget *parent = 0);
+    ~DeviceWidget();
     void setDeviceID(int devID);
     void setDfu(DFUObject *dfu);
     void populate();
@@ -61,6 +64,10 @@ private:
     deviceDescriptorStruct onBoardDescription;
     deviceDescriptorStruct LoadedDescription;
     QByteArray loadedFW;
+    // keeps the firmware file open so loadedFW can alias its mapping
+    QFile fwFile;
+    // verification CRC of the loaded image, computed on the worker pool
+    QFutureWatcher<quint32> crcWatcher;
     Ui_deviceWidget *myDevice;
     int deviceID;
     DFUObject *m_dfu;
@@ -73,12 +80,15 @@ private:
     bool populateLoadedStructuredDescription(QByteArray arr);
     void updateButtons(bool enabled);
     QString getDevFirmwarePath();
+    quint32 computeLoadedCRC(QByteArray image, quint32 sizeOfCode);
 
 signals:
     void uploadStarted();
     void uploadEnded(bool success);
     void downloadStarted();
     void downloadEnded(bool success);
+    // ! Emitted from the worker pool while the loaded image CRC is computed
+    void loadedCRCProgress(int percent);
 
 public slots:
     void uploadFirmware();
@@ -91,6 +101,9 @@ public slots:
     void dfuStatus(QString);
     void confirmCB(int);
 
+private slots:
+    void loadedCRCReady();
+
 protected:
     void showEvent(QShowEvent *event);
     void resizeEvent(QResizeEvent *event);
@@ -120,6 +120,26 @@ DFUObject::DFUObject(bool _debug, bool _use_serial, QString portname) :
     }
 }
 
+/**
+   Binds the DFU session to one specific bootloader board, identified by
+   its USB serial number. Unlike the discovery constructor this never
+   waits for a lone board to appear on the bus, so several instances can
+   coexist - one per connected board - and flash concurrently, each
+   running its operation on its own thread.
+ */
+DFUObject::DFUObject(bool _debug, const USBPortInfo &deviceInfo) :
+    debug(_debug), use_serial(false), mready(false)
+{
+    info = NULL;
+    numberOfDevices = 0;
+
+    qRegisterMetaType<OP_DFU::Status>("Status");
+
+    if (hidHandle.openBySerial(deviceInfo.vendorID, deviceInfo.productID, deviceInfo.serialNumber) == 1) {
+        mready = true;
+    }
+}
+
 DFUObject::~DFUObject()
 {
     if (use_serial) {
@@ -247,13 +267,17 @@ bool DFUObject::UploadData(qint32 const & numberOfBytes, QByteArray & data)
     int packetsize;
     float percentage;
     int laspercentage = 0;
+    // The packets of a window are streamed back to back, the device state
+    // is only checked once per window. A failed transfer then aborts within
+    // one window instead of flashing the whole image before noticing.
+    const qint32 windowPackets = 32;
     for (qint32 packetcount = 0; packetcount < numberOfPackets; ++packetcount) {
         percentage = (float)(packetcount + 1) / numberOfPackets * 100;
         if (laspercentage != (int)percentage) {
             printProgBar((int)percentage, "UPLOADING");
         }
         laspercentage = (int)percentage;
-        if (packetcount == numberOfPackets) {
+        if (packetcount == numberOfPackets - 1) {
             packetsize = lastPacketCount;
         } else {
             packetsize = 14;
@@ -275,15 +299,21 @@ bool DFUObject::UploadData(qint32 const & numberOfBytes, QByteArray & data)
 
         // }
         // qDebug()<<" Data0="<<(int)data[0]<<" Data0="<<(int)data[1]<<" Data0="<<(int)data[2]<<" Data0="<<(int)data[3]<<" buf6="<<(int)buf[6]<<" buf7="<<(int)buf[7]<<" buf8="<<(int)buf[8]<<" buf9="<<(int)buf[9];
-        // delay::msleep(send_delay);
-
-        // if(StatusRequest()!=OP_DFU::uploading) return false;
         int result = sendData(buf, BUF_LEN);
         // qDebug()<<"sent:"<<result;
         if (result < 1) {
             return false;
         }
 
+        if (((packetcount + 1) % windowPackets == 0) && (packetcount + 1 < numberOfPackets)) {
+            if (StatusRequest() != OP_DFU::uploading) {
+                if (debug) {
+                    qDebug() << "Device left uploading state after packet" << packetcount;
+                }
+                return false;
+            }
+        }
+
         // qDebug() << "UPLOAD:"<<"Data="<<(int)buf[6]<<(int)buf[7]<<(int)buf[8]<<(int)buf[9]<<";"<<result << " bytes sent";
     }
     cout << "\n";
@@ -774,6 +804,17 @@ OP_DFU::Status DFUObject::UploadFirmwareT(const QString &sfile, const bool &veri
         qDebug() << "NEW FIRMWARE CRC=" << crc;
     }
 
+    // The bootloader erases the whole code region before accepting data, so
+    // a partial (per block) update is not possible. What we can do is detect
+    // an unchanged image: the capabilities report carries the CRC of the
+    // installed firmware, computed over the same region with the same
+    // polynomial as CRCFromQBArray. When they match there is nothing to flash.
+    if (!verify && (crc == devices[device].FW_CRC)) {
+        emit operationProgress(QString("Firmware is already up to date, nothing to flash"));
+        cout << "Firmware is already up to date, nothing to flash\n";
+        return OP_DFU::Last_operation_Success;
+    }
+
     if (!StartUpload(arr.length(), OP_DFU::FW, crc)) {
         ret = StatusRequest();
         if (debug) {
@@ -116,6 +116,7 @@ public:
     static quint32 CRCFromQBArray(QByteArray array, quint32 Size);
     // DFUObject(bool debug);
     DFUObject(bool debug, bool use_serial, QString port);
+    DFUObject(bool debug, const USBPortInfo &deviceInfo);
 
     virtual ~DFUObject();
 
@@ -42,6 +42,9 @@ OPLinkWatchdog::OPLinkWatchdog() : QObject(),
     m_opLinkStatus = OPLinkStatus::GetInstance(objManager);
     Q_ASSERT(m_opLinkStatus);
     connect(m_opLinkStatus, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(onOPLinkStatusUpdate()));
+    // an unchanged status payload still feeds the watchdog, only changes
+    // are reported through objectUpdated
+    connect(m_opLinkStatus, SIGNAL(objectUnpackedUnchanged(UAVObject *)), this, SLOT(onOPLinkStatusUpdate()));
     m_watchdog     = new QTimer(this);
     connect(m_watchdog, SIGNAL(timeout()), this, SLOT(onTimeout()));
     onOPLinkStatusUpdate();
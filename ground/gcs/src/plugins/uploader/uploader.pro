@@ -3,7 +3,7 @@ TARGET = Uploader
 
 DEFINES += UPLOADER_LIBRARY
 
-QT += svg serialport
+QT += svg serialport concurrent
 
 include(uploader_dependencies.pri)
 include(../../libs/version_info/version_info.pri)
@@ -885,6 +885,16 @@ void UploaderGadgetWidget::systemRescue()
         delete m_dfu;
         m_dfu = NULL;
     }
+    if (!m_fleetDfus.isEmpty()) {
+        // drop the tabs first, they hold pointers into the fleet connections
+        while (m_config->systemElements->count()) {
+            QWidget *qw = m_config->systemElements->widget(0);
+            m_config->systemElements->removeTab(0);
+            delete qw;
+        }
+        qDeleteAll(m_fleetDfus);
+        m_fleetDfus.clear();
+    }
 
     // Avoid users pressing Rescue twice.
     m_config->rescueButton->setEnabled(false);
@@ -926,6 +936,52 @@ void UploaderGadgetWidget::systemRescue()
         return;
     }
 
+    // Several boards in bootloader mode at once means a fleet flash : give
+    // each board its own DFU connection and tab, so they can be flashed
+    // concurrently - each DFUObject runs its upload on its own thread and
+    // each tab has its own file, update button and progress bar.
+    QList<USBPortInfo> boards = USBMonitor::instance()->availableDevices(0x20a0, -1, -1, USBMonitor::Bootloader);
+    if (boards.length() > 1) {
+        log(QString("Found %1 boards in bootloader mode, entering fleet mode.").arg(boards.length()));
+        foreach(const USBPortInfo &board, boards) {
+            DFUObject *dfu = new DFUObject(DFU_DEBUG, board);
+            if (!dfu->ready()) {
+                log(QString("Could not open board %1, skipping.").arg(board.serialNumber));
+                delete dfu;
+                continue;
+            }
+            dfu->AbortOperation();
+            if (!dfu->enterDFU(0) || !dfu->findDevices() || (dfu->numberOfDevices != 1)) {
+                log(QString("Could not talk to board %1, skipping.").arg(board.serialNumber));
+                delete dfu;
+                continue;
+            }
+            m_fleetDfus.append(dfu);
+
+            DeviceWidget *dw = new DeviceWidget(this);
+            connectSignalSlot(dw);
+            dw->setDeviceID(0);
+            dw->setDfu(dfu);
+            dw->populate();
+            m_config->systemElements->addTab(dw, tr("Board") + " " + board.serialNumber);
+        }
+        if (m_fleetDfus.isEmpty()) {
+            log("Could not talk to any of the boards, aborting!");
+            cm->resumePolling();
+            m_config->rescueButton->setEnabled(true);
+            return;
+        }
+        log(QString("%1 board(s) ready, load and flash each from its tab.").arg(m_fleetDfus.count()));
+        m_config->haltButton->setEnabled(false);
+        m_config->resetButton->setEnabled(false);
+        // the boot buttons drive the single board connection, rescue again
+        // (with one board connected) to boot boards individually
+        bootButtonsSetEnable(false);
+        m_config->rescueButton->setEnabled(true);
+        m_currentIAPStep = IAP_STATE_BOOTLOADER;
+        return;
+    }
+
     log("Detecting first board...");
     m_dfu = new DFUObject(DFU_DEBUG, false, QString());
     m_dfu->AbortOperation();
@@ -985,7 +1041,9 @@ void UploaderGadgetWidget::uploadEnded(bool succeed)
     Q_UNUSED(succeed);
     // device is halted so no halt
     m_config->haltButton->setEnabled(false);
-    bootButtonsSetEnable(true);
+    // in fleet mode the boot buttons stay disabled, other boards may
+    // still be flashing
+    bootButtonsSetEnable(m_fleetDfus.isEmpty());
     // device is halted so no reset
     m_config->resetButton->setEnabled(false);
     m_config->rescueButton->setEnabled(true);
@@ -1150,6 +1208,8 @@ UploaderGadgetWidget::~UploaderGadgetWidget()
         delete qw;
         qw = 0;
     }
+    qDeleteAll(m_fleetDfus);
+    m_fleetDfus.clear();
 }
 
 void UploaderGadgetWidget::openHelp()
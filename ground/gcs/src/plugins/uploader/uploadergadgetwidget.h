@@ -144,6 +144,9 @@ signals:
 private:
     Ui_UploaderWidget *m_config;
     DFUObject *m_dfu;
+    // one DFU connection per board when several bootloader boards are
+    // connected at once (fleet flashing), empty in single board operation
+    QList<DFUObject *> m_fleetDfus;
     IAPStep m_currentIAPStep;
     bool m_resetOnly;
     OPLinkWatchdog m_oplinkwatchdog;
@@ -40,9 +40,76 @@
 #include "version_info/version_info.h"
 #include "coreplugin/icore.h"
 #include <uavtalk/telemetrymanager.h>
+#include <QTimer>
+
+// hard time budget of a single tracking request, the reply is aborted
+// when it is exceeded so a dead field link cannot pin the worker
+static const int REQUEST_TIMEOUT_MS   = 10000;
+// how long shutdown waits for the worker thread before letting go
+static const unsigned long SHUTDOWN_WAIT_MS = 2000;
+
+UsageTrackerWorker::UsageTrackerWorker() :
+    m_networkAccessManager(NULL), m_timeoutTimer(NULL), m_currentReply(NULL)
+{}
+
+void UsageTrackerWorker::submit(QString hash, QString url)
+{
+    m_queue.enqueue(qMakePair(hash, url));
+    if (m_currentReply == NULL) {
+        sendNext();
+    }
+}
+
+void UsageTrackerWorker::sendNext()
+{
+    if (m_queue.isEmpty()) {
+        return;
+    }
+    // created on first use so the session (with its connection and DNS
+    // cache) lives on the worker thread and persists across submissions
+    if (m_networkAccessManager == NULL) {
+        m_networkAccessManager = new QNetworkAccessManager(this);
+        connect(m_networkAccessManager, SIGNAL(finished(QNetworkReply *)), this, SLOT(onFinished(QNetworkReply *)));
+
+        m_timeoutTimer = new QTimer(this);
+        m_timeoutTimer->setSingleShot(true);
+        m_timeoutTimer->setInterval(REQUEST_TIMEOUT_MS);
+        connect(m_timeoutTimer, SIGNAL(timeout()), this, SLOT(onTimeout()));
+    }
+
+    QPair<QString, QString> entry = m_queue.dequeue();
+    m_currentHash  = entry.first;
+
+    qDebug() << "Sending usage tracking as:" << entry.second;
+    m_currentReply = m_networkAccessManager->get(QNetworkRequest(QUrl(entry.second)));
+    m_timeoutTimer->start();
+}
+
+void UsageTrackerWorker::onFinished(QNetworkReply *reply)
+{
+    m_timeoutTimer->stop();
+    if (reply->error() == QNetworkReply::NoError) {
+        emit submitted(m_currentHash);
+    } else {
+        qDebug() << "Usage tracking failed with:" << reply->errorString();
+    }
+    reply->deleteLater();
+    m_currentReply = NULL;
+    sendNext();
+}
+
+void UsageTrackerWorker::onTimeout()
+{
+    if (m_currentReply != NULL) {
+        qDebug() << "Usage tracking timed out, aborting request";
+        // abort() makes the reply finish with OperationCanceledError,
+        // onFinished takes it from there
+        m_currentReply->abort();
+    }
+}
 
 UsageTrackerPlugin::UsageTrackerPlugin() :
-    m_telemetryManager(NULL)
+    m_telemetryManager(NULL), m_worker(NULL)
 {}
 
 UsageTrackerPlugin::~UsageTrackerPlugin()
@@ -62,6 +129,12 @@ void UsageTrackerPlugin::extensionsInitialized()
 
     m_telemetryManager = pm->getObject<TelemetryManager>();
     connect(m_telemetryManager, SIGNAL(connected()), this, SLOT(onAutopilotConnect()));
+
+    m_worker = new UsageTrackerWorker();
+    m_worker->moveToThread(&m_workerThread);
+    connect(&m_workerThread, SIGNAL(finished()), m_worker, SLOT(deleteLater()));
+    connect(this, SIGNAL(queueSubmission(QString, QString)), m_worker, SLOT(submit(QString, QString)));
+    connect(m_worker, SIGNAL(submitted(QString)), this, SLOT(onSubmitted(QString)));
 }
 
 void UsageTrackerPlugin::shutdown()
@@ -69,6 +142,11 @@ void UsageTrackerPlugin::shutdown()
     if (m_telemetryManager != NULL) {
         disconnect(m_telemetryManager, SIGNAL(connected()), this, SLOT(onAutopilotConnect()));
     }
+    if (m_workerThread.isRunning()) {
+        m_workerThread.quit();
+        // bounded wait, an in flight request is not worth delaying exit for
+        m_workerThread.wait(SHUTDOWN_WAIT_MS);
+    }
 }
 
 void UsageTrackerPlugin::onAutopilotConnect()
@@ -141,14 +219,11 @@ void UsageTrackerPlugin::trackUsage()
 
         QUrl url(QString(USAGETRACKER_URL) + "?" + query.toString(QUrl::FullyEncoded));
 
-        QNetworkAccessManager *networkAccessManager = new QNetworkAccessManager();
-
-        // This will delete the network access manager instance when we're done
-        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), this, SLOT(onFinished(QNetworkReply *)));
-        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), networkAccessManager, SLOT(deleteLater()));
-
-        qDebug() << "Sending usage tracking as:" << url.toEncoded(QUrl::FullyEncoded);
-        networkAccessManager->get(QNetworkRequest(QUrl(url.toEncoded(QUrl::FullyEncoded))));
+        // the worker thread is only started once there is something to send
+        if (!m_workerThread.isRunning()) {
+            m_workerThread.start(QThread::LowPriority);
+        }
+        emit queueSubmission(hash, QString(url.toEncoded(QUrl::FullyEncoded)));
     }
 }
 
@@ -246,14 +321,10 @@ void UsageTrackerPlugin::collectUsageParameters(QMap<QString, QString> &paramete
     }
 }
 
-void UsageTrackerPlugin::onFinished(QNetworkReply *reply)
+void UsageTrackerPlugin::onSubmitted(QString hash)
 {
-    if (reply->error() == QNetworkReply::NoError) {
-        getGeneralSettings()->setLastUsageHash(m_lastHash);
-        qDebug() << "Updated last usage hash to:" << m_lastHash;
-    } else {
-        qDebug() << "Usage tracking failed with:" << reply->errorString();
-    }
+    getGeneralSettings()->setLastUsageHash(hash);
+    qDebug() << "Updated last usage hash to:" << hash;
 }
 
 QString UsageTrackerPlugin::getUAVFieldValue(UAVObjectManager *objManager, QString objectName, QString fieldName, int index) const
@@ -284,10 +355,5 @@ Core::Internal::GeneralSettings *UsageTrackerPlugin::getGeneralSettings() const
 
 bool UsageTrackerPlugin::shouldSend(const QString &hash)
 {
-    if (getGeneralSettings()->lastUsageHash() == hash) {
-        return false;
-    } else {
-        m_lastHash = hash;
-        return true;
-    }
+    return getGeneralSettings()->lastUsageHash() != hash;
 }
@@ -31,9 +31,45 @@
 #include <extensionsystem/iplugin.h>
 #include <coreplugin/generalsettings.h>
 
+#include <QThread>
+#include <QQueue>
+#include <QPair>
+
 class TelemetryManager;
 class UAVObjectManager;
+class QNetworkAccessManager;
 class QNetworkReply;
+class QTimer;
+
+// Submits tracking requests from a background thread, one at a time over a
+// persistent network session, so DNS and TLS setup never touches the GUI
+// thread. Requests queued while one is in flight are drained sequentially
+// over the same connection.
+class UsageTrackerWorker : public QObject {
+    Q_OBJECT
+public:
+    UsageTrackerWorker();
+
+public slots:
+    void submit(QString hash, QString url);
+
+signals:
+    void submitted(QString hash);
+
+private slots:
+    void onFinished(QNetworkReply *reply);
+    void onTimeout();
+
+private:
+    void sendNext();
+
+    // created lazily so it lives on the worker thread
+    QNetworkAccessManager *m_networkAccessManager;
+    QTimer *m_timeoutTimer;
+    QQueue<QPair<QString, QString> > m_queue;
+    QNetworkReply *m_currentReply;
+    QString m_currentHash;
+};
 
 class UsageTrackerPlugin : public ExtensionSystem::IPlugin {
     Q_OBJECT
@@ -46,15 +82,19 @@ public:
     bool initialize(const QStringList & arguments, QString *errorString);
     void shutdown();
 
+signals:
+    void queueSubmission(QString hash, QString url);
+
 private slots:
     void onAutopilotConnect();
     void trackUsage();
     void collectUsageParameters(QMap<QString, QString> &parameters);
-    void onFinished(QNetworkReply *reply);
+    void onSubmitted(QString hash);
 
 private:
     TelemetryManager *m_telemetryManager;
-    QString m_lastHash;
+    QThread m_workerThread;
+    UsageTrackerWorker *m_worker;
     QString getUAVFieldValue(UAVObjectManager *objManager, QString objectName, QString fieldName, int index = 0) const;
     QString getQueryHash(QString source) const;
     Core::Internal::GeneralSettings *getGeneralSettings() const;
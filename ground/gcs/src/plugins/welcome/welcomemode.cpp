@@ -41,8 +41,11 @@
 #include <utils/quickwidgetproxy.h>
 
 #include <QDesktopServices>
+#include <QVBoxLayout>
+#include <QShowEvent>
 
 #include <QtCore/QSettings>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtCore/QDebug>
 
@@ -60,26 +63,47 @@ using namespace ExtensionSystem;
 using namespace Utils;
 
 namespace Welcome {
+// version check runs this long after the scene is first shown, well off
+// the startup critical path
+static const int VERSION_CHECK_DELAY_MS = 2000;
+
+/**
+ * Placeholder that sits in the mode stack instead of the QML scene and
+ * asks the mode to build the real thing the first time it is shown. An
+ * operator who starts straight into another mode never pays for the
+ * Welcome scene at all.
+ */
+class WelcomeModeContainer : public QWidget {
+public:
+    WelcomeModeContainer(WelcomeMode *mode) : QWidget(),
+        m_mode(mode), m_loaded(false)
+    {
+        QVBoxLayout *layout = new QVBoxLayout(this);
+
+        layout->setContentsMargins(0, 0, 0, 0);
+    }
+
+protected:
+    void showEvent(QShowEvent *event)
+    {
+        if (!m_loaded) {
+            m_loaded = true;
+            m_mode->buildScene(this);
+        }
+        QWidget::showEvent(event);
+    }
+
+private:
+    WelcomeMode *m_mode;
+    bool m_loaded;
+};
+
 WelcomeMode::WelcomeMode() :
     m_quickWidgetProxy(NULL),
+    m_container(NULL),
     m_priority(Core::Constants::P_MODE_WELCOME),
     m_newVersionText("")
-{
-    QNetworkAccessManager *networkAccessManager = new QNetworkAccessManager;
-
-    // Only attempt to request our version info if the network is accessible
-    if (networkAccessManager->networkAccessible() == QNetworkAccessManager::Accessible) {
-        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), this, SLOT(networkResponseReady(QNetworkReply *)));
-
-        // This will delete the network access manager instance when we're done
-        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), networkAccessManager, SLOT(deleteLater()));
-
-        networkAccessManager->get(QNetworkRequest(QUrl("http://www.librepilot.org/stable-version")));
-    } else {
-        // No network, can delete this now as we don't need it.
-        delete networkAccessManager;
-    }
-}
+{}
 
 WelcomeMode::~WelcomeMode()
 {}
@@ -99,15 +123,32 @@ int WelcomeMode::priority() const
     return m_priority;
 }
 
+/**
+ * The mode manager puts the widget into its stack as soon as the mode is
+ * registered, during startup. Hand it the cheap placeholder so the QML
+ * scene is only built when the mode is first displayed.
+ */
 QWidget *WelcomeMode::widget()
+{
+    if (!m_container) {
+        m_container = new WelcomeModeContainer(this);
+    }
+    return m_container;
+}
+
+void WelcomeMode::buildScene(QWidget *container)
 {
     if (!m_quickWidgetProxy) {
         m_quickWidgetProxy = new QuickWidgetProxy();
         // qWidget->setResizeMode(QQuickWidget::SizeRootObjectToView);
         m_quickWidgetProxy->engine()->rootContext()->setContextProperty("welcomePlugin", this);
         m_quickWidgetProxy->setSource(QUrl("qrc:/welcome/qml/main.qml"));
+        container->layout()->addWidget(m_quickWidgetProxy->widget());
+
+        // the new version banner is part of the scene we just built, so
+        // this is the first moment the check is actually worth running
+        QTimer::singleShot(VERSION_CHECK_DELAY_MS, this, SLOT(startVersionCheck()));
     }
-    return m_quickWidgetProxy->widget();
 }
 
 const char *WelcomeMode::uniqueModeName() const
@@ -138,6 +179,24 @@ void WelcomeMode::triggerAction(const QString &actionId)
     Core::ModeManager::instance()->triggerAction(actionId);
 }
 
+void WelcomeMode::startVersionCheck()
+{
+    QNetworkAccessManager *networkAccessManager = new QNetworkAccessManager;
+
+    // Only attempt to request our version info if the network is accessible
+    if (networkAccessManager->networkAccessible() == QNetworkAccessManager::Accessible) {
+        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), this, SLOT(networkResponseReady(QNetworkReply *)));
+
+        // This will delete the network access manager instance when we're done
+        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), networkAccessManager, SLOT(deleteLater()));
+
+        networkAccessManager->get(QNetworkRequest(QUrl("http://www.librepilot.org/stable-version")));
+    } else {
+        // No network, can delete this now as we don't need it.
+        delete networkAccessManager;
+    }
+}
+
 void WelcomeMode::networkResponseReady(QNetworkReply *reply)
 {
     if (reply != NULL) {
@@ -83,12 +83,18 @@ public slots:
     void openPage(const QString &page);
     void triggerAction(const QString &actionId);
 
+    // ! Builds the QML scene into \a container, called by the placeholder
+    // ! widget the first time the mode actually becomes visible.
+    void buildScene(QWidget *container);
+
 private:
     QuickWidgetProxy *m_quickWidgetProxy;
+    QWidget *m_container;
     int m_priority;
     QString m_newVersionText;
 
 private slots:
+    void startVersionCheck();
     void networkResponseReady(QNetworkReply *reply);
 };
 } // namespace Welcome
@@ -217,51 +217,66 @@ bool UAVObjectGeneratorFlight::process_object(ObjectInfo *info)
     outInclude.replace(QString("$(DATAFIELDINFO)"), enums);
 
     // Replace the $(INITFIELDS) tag
+    // Default values are emitted as one const (flash resident) image of the
+    // data struct and applied with a single copy, instead of a run of
+    // per-field stores compiled into the init code. Fields without a
+    // default stay zero, matching the memset the template does beforehand.
     QString initfields;
+    bool hasDefaults = false;
     for (int n = 0; n < info->fields.length(); ++n) {
         if (!info->fields[n]->defaultValues.isEmpty()) {
+            hasDefaults = true;
+            break;
+        }
+    }
+    if (hasDefaults) {
+        initfields.append(QString("    static const %1Data defaultData = {\n").arg(info->name));
+        for (int n = 0; n < info->fields.length(); ++n) {
+            if (info->fields[n]->defaultValues.isEmpty()) {
+                continue;
+            }
             // For non-array fields
             if (info->fields[n]->numElements == 1) {
                 if (info->fields[n]->type == FIELDTYPE_ENUM) {
-                    initfields.append(QString("    data.%1 = %2;\n")
+                    initfields.append(QString("        .%1 = %2,\n")
                                       .arg(info->fields[n]->name)
                                       .arg(info->fields[n]->options.indexOf(info->fields[n]->defaultValues[0])));
                 } else if (info->fields[n]->type == FIELDTYPE_FLOAT32) {
-                    initfields.append(QString("    data.%1 = %2f;\n")
+                    initfields.append(QString("        .%1 = %2f,\n")
                                       .arg(info->fields[n]->name)
                                       .arg(info->fields[n]->defaultValues[0].toFloat(), 0, 'e', 6));
                 } else {
-                    initfields.append(QString("    data.%1 = %2;\n")
+                    initfields.append(QString("        .%1 = %2,\n")
                                       .arg(info->fields[n]->name)
                                       .arg(info->fields[n]->defaultValues[0].toInt()));
                 }
             } else {
-                // Initialize all fields in the array
+                // Initialize all elements of the array
+                initfields.append(QString("        .%1 = {\n").arg(info->fields[n]->name));
                 for (int idx = 0; idx < info->fields[n]->numElements; ++idx) {
-                    if (info->fields[n]->elementNames[0].compare(QString("0")) == 0) {
-                        initfields.append(QString("    data.%1[%2] = ")
-                                          .arg(info->fields[n]->name)
-                                          .arg(idx));
-                    } else {
-                        initfields.append(QString("    data.%1.%2 = ")
-                                          .arg(info->fields[n]->name)
-                                          .arg(info->fields[n]->elementNames[idx]));
-                    }
-
-
+                    QString value;
                     if (info->fields[n]->type == FIELDTYPE_ENUM) {
-                        initfields.append(QString("%1;\n")
-                                          .arg(info->fields[n]->options.indexOf(info->fields[n]->defaultValues[idx])));
+                        value = QString("%1").arg(info->fields[n]->options.indexOf(info->fields[n]->defaultValues[idx]));
                     } else if (info->fields[n]->type == FIELDTYPE_FLOAT32) {
-                        initfields.append(QString("%1f;\n")
-                                          .arg(info->fields[n]->defaultValues[idx].toFloat(), 0, 'e', 6));
+                        value = QString("%1f").arg(info->fields[n]->defaultValues[idx].toFloat(), 0, 'e', 6);
+                    } else {
+                        value = QString("%1").arg(info->fields[n]->defaultValues[idx].toInt());
+                    }
+                    if (info->fields[n]->elementNames[0].compare(QString("0")) == 0) {
+                        initfields.append(QString("            [%1] = %2,\n")
+                                          .arg(idx)
+                                          .arg(value));
                     } else {
-                        initfields.append(QString("%1;\n")
-                                          .arg(info->fields[n]->defaultValues[idx].toInt()));
+                        initfields.append(QString("            .%1 = %2,\n")
+                                          .arg(info->fields[n]->elementNames[idx])
+                                          .arg(value));
                     }
                 }
+                initfields.append(QString("        },\n"));
             }
         }
+        initfields.append(QString("    };\n\n"));
+        initfields.append(QString("    memcpy(&data, &defaultData, sizeof(%1Data));\n").arg(info->name));
     }
     outCode.replace(QString("$(INITFIELDS)"), initfields);
 
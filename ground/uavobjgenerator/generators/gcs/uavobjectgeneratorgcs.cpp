@@ -27,6 +27,8 @@
 
 #include "uavobjectgeneratorgcs.h"
 
+#include <algorithm>
+
 #define VERBOSE             false
 #define DEPRECATED          true
 
@@ -51,6 +53,11 @@ void info(ObjectInfo *object, QString msg)
     }
 }
 
+bool compareObjectId(ObjectInfo *a, ObjectInfo *b)
+{
+    return a->id < b->id;
+}
+
 struct Context {
     ObjectInfo *object;
     // enums
@@ -82,6 +89,9 @@ struct FieldContext {
     QString   ucPropName;
     QString   propType;
     QString   propRefType;
+    // expression selecting this property's raw value from a DataFields
+    // variable whose name is substituted for %1 (e.g. "%1.Roll" or "%1.Bias[0]")
+    QString   snapshotExpr;
     // deprecation
     bool hasDeprecatedProperty;
     bool hasDeprecatedGetter;
@@ -273,30 +283,31 @@ void generateFieldInfo(Context &ctxt, FieldContext &fieldCtxt)
 
 void generateFieldInit(Context &ctxt, FieldContext &fieldCtxt)
 {
-    ctxt.fieldsInit += generate(ctxt, fieldCtxt, "    // :fieldName\n");
+    ctxt.fieldsInit += generate(ctxt, fieldCtxt, "        // :fieldName\n");
 
     // Setup element names
-    ctxt.fieldsInit += generate(ctxt, fieldCtxt, "    QStringList :fieldNameElemNames;\n");
+    // The lists are function local statics so they are built once per class
+    // and shared (implicitly) by all instances instead of being reallocated
+    // for every constructed object.
     QStringList elemNames = fieldCtxt.field->elementNames;
-    ctxt.fieldsInit += generate(ctxt, fieldCtxt, "    :fieldNameElemNames");
+    ctxt.fieldsInit += generate(ctxt, fieldCtxt, "        static const QStringList :fieldNameElemNames = QStringList()");
     for (int m = 0; m < elemNames.length(); ++m) {
         ctxt.fieldsInit += QString(" << \"%1\"").arg(elemNames[m]);
     }
     ctxt.fieldsInit += ";\n";
 
     if (fieldCtxt.field->type == FIELDTYPE_ENUM) {
-        ctxt.fieldsInit += generate(ctxt, fieldCtxt, "    QStringList :fieldNameEnumOptions;\n");
         QStringList options = fieldCtxt.field->options;
-        ctxt.fieldsInit += generate(ctxt, fieldCtxt, "    :fieldNameEnumOptions");
+        ctxt.fieldsInit += generate(ctxt, fieldCtxt, "        static const QStringList :fieldNameEnumOptions = QStringList()");
         for (int m = 0; m < options.length(); ++m) {
             ctxt.fieldsInit += QString(" << \"%1\"").arg(options[m]);
         }
         ctxt.fieldsInit += ";\n";
         ctxt.fieldsInit += generate(ctxt, fieldCtxt,
-                                    "    fields.append(new UAVObjectField(\":fieldName\", tr(\":fieldDesc\"), \":fieldUnits\", UAVObjectField::ENUM, :fieldNameElemNames, :fieldNameEnumOptions, \":fieldLimitValues\"));\n");
+                                    "        fields.append(new UAVObjectField(\":fieldName\", tr(\":fieldDesc\"), \":fieldUnits\", UAVObjectField::ENUM, :fieldNameElemNames, :fieldNameEnumOptions, \":fieldLimitValues\"));\n");
     } else {
         ctxt.fieldsInit += generate(ctxt, fieldCtxt,
-                                    "    fields.append(new UAVObjectField(\":fieldName\", tr(\":fieldDesc\"), \":fieldUnits\", UAVObjectField::%1, :fieldNameElemNames, QStringList(), \":fieldLimitValues\"));\n")
+                                    "        fields.append(new UAVObjectField(\":fieldName\", tr(\":fieldDesc\"), \":fieldUnits\", UAVObjectField::%1, :fieldNameElemNames, QStringList(), \":fieldLimitValues\"));\n")
                            .arg(fieldTypeStrCPPClass(fieldCtxt.field->type));
     }
 }
@@ -380,7 +391,14 @@ void generateBaseProperty(Context &ctxt, FieldContext &fieldCtxt)
     ctxt.setters           += generate(ctxt, fieldCtxt, "    void set:PropName(const :propRefType value);\n");
 
     ctxt.notifications     += generate(ctxt, fieldCtxt, "    void :propNameChanged(const :propRefType value);\n");
-    ctxt.notificationsImpl += generate(ctxt, fieldCtxt, "    emit :propNameChanged(:propName());\n");
+
+    // emit only when the value differs from the last notified snapshot so a
+    // periodic telemetry update does not re-trigger every QML binding
+    QString snapshotValue   = QString(fieldCtxt.snapshotExpr).arg("snapshot");
+    QString lastValue       = QString(fieldCtxt.snapshotExpr).arg("lastNotified_");
+    ctxt.notificationsImpl += generate(ctxt, fieldCtxt,
+                                       "    if (%1 != %2) {\n"
+                                       "        emit :propNameChanged(static_cast<:propType>(%1));\n").arg(snapshotValue).arg(lastValue);
 
     if (DEPRECATED) {
         // generate deprecated property for retro compatibility
@@ -401,9 +419,11 @@ void generateBaseProperty(Context &ctxt, FieldContext &fieldCtxt)
                                                "    /*DEPRECATED*/ void :fieldNameChanged(:fieldType value);\n");
 
             ctxt.notificationsImpl += generate(ctxt, fieldCtxt,
-                                               "    /*DEPRECATED*/ emit :fieldNameChanged(get:fieldName());\n");
+                                               "        /*DEPRECATED*/ emit :fieldNameChanged(static_cast<:fieldType>(%1));\n").arg(snapshotValue);
         }
     }
+
+    ctxt.notificationsImpl += "    }\n";
 }
 
 void generateSimpleProperty(Context &ctxt, FieldContext &fieldCtxt)
@@ -412,6 +432,8 @@ void generateSimpleProperty(Context &ctxt, FieldContext &fieldCtxt)
         generateEnum(ctxt, fieldCtxt);
     }
 
+    fieldCtxt.snapshotExpr = "%1." + fieldCtxt.fieldName;
+
     generateBaseProperty(ctxt, fieldCtxt);
 
     // getter implementation
@@ -521,6 +543,7 @@ void generateIndexedProperty(Context &ctxt, FieldContext &fieldCtxt)
         elementCtxt.hasDeprecatedSetter       = ((elementCtxt.fieldName != elementCtxt.ucPropName) || (elementCtxt.fieldType != elementCtxt.propType)) && DEPRECATED;
         elementCtxt.hasDeprecatedNotification = ((elementCtxt.fieldName != elementCtxt.propName) || (elementCtxt.fieldType != elementCtxt.propType)) && DEPRECATED;
 
+        elementCtxt.snapshotExpr = "%1." + fieldCtxt.fieldName + QString("[%1]").arg(elementIndex);
 
         generateBaseProperty(ctxt, elementCtxt);
 
@@ -565,7 +588,10 @@ bool UAVObjectGeneratorGCS::generate(UAVObjectParser *parser, QString templatepa
     }
 
     QString objInc;
-    QString gcsObjInit;
+    QString gcsCreatorTable;
+    QString gcsObjQmlTypes;
+
+    QList<ObjectInfo *> sortedObjects;
 
     for (int objidx = 0; objidx < parser->getNumObjects(); ++objidx) {
         ObjectInfo *object = parser->getObjectByIndex(objidx);
@@ -576,13 +602,22 @@ bool UAVObjectGeneratorGCS::generate(UAVObjectParser *parser, QString templatepa
 
         objInc.append(QString("#include \"%1.h\"\n").arg(object->namelc));
 
-        gcsObjInit += ::generate(ctxt, "    objMngr->registerObject( new :ClassName() );\n");
-        gcsObjInit += ::generate(ctxt, "    :ClassName::registerQMLTypes();\n");
+        gcsObjQmlTypes += ::generate(ctxt, "    :ClassName::registerQMLTypes();\n");
+
+        sortedObjects << object;
+    }
+
+    // the creator table is emitted sorted by object id for binary search
+    std::sort(sortedObjects.begin(), sortedObjects.end(), compareObjectId);
+    foreach(ObjectInfo * object, sortedObjects) {
+        gcsCreatorTable += QString("    { 0x%1, objectCreator<%2> },\n")
+                           .arg(QString::number(object->id, 16).toUpper()).arg(object->name);
     }
 
     // Write the gcs object initialization files
     gcsInitTemplate.replace("$(OBJINC)", objInc);
-    gcsInitTemplate.replace("$(OBJINIT)", gcsObjInit);
+    gcsInitTemplate.replace("$(OBJCREATORTABLE)", gcsCreatorTable);
+    gcsInitTemplate.replace("$(OBJQMLTYPES)", gcsObjQmlTypes);
 
     bool res = writeFileIfDifferent(gcsOutputPath.absolutePath() + "/uavobjectsinit.cpp", gcsInitTemplate);
     if (!res) {
@@ -50,6 +50,8 @@ void replaceCommonTags(QString & out, ObjectInfo *info)
 
     // Replace $(XMLFILE) tag
     out.replace(QString("$(XMLFILE)"), info->filename);
+    // Replace $(NUMBYTES) tag
+    out.replace(QString("$(NUMBYTES)"), QString().setNum(info->numBytes));
     // Replace $(NAME) tag
     out.replace(QString("$(NAME)"), info->name);
     // Replace $(NAMELC) tag
@@ -34,7 +34,7 @@
 #include <QDir>
 #include <iostream>
 
-QString readFile(QString name);
+QString readFile(QString name, bool do_warn);
 QString readFile(QString name);
 bool writeFile(QString name, QString & str);
 bool writeFileIfDifferent(QString name, QString & str);
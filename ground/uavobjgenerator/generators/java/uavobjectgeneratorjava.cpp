@@ -36,6 +36,22 @@ bool UAVObjectGeneratorJava::generate(UAVObjectParser *parser, QString templatep
     fieldTypeStrCPPClass << "INT8" << "INT16" << "INT32"
                          << "UINT8" << "UINT16" << "UINT32" << "FLOAT32" << "ENUM";
 
+    // Packed sizes, widened java return types and absolute-index ByteBuffer
+    // get/set code for each field type (unsigned types are widened so the
+    // full value range survives the round trip)
+    fieldSizeStrJava << "1" << "2" << "4"
+                     << "1" << "2" << "4" << "4" << "1";
+    fieldTypeStrJavaRet << "byte" << "short" << "int"
+                        << "short" << "int" << "long" << "float" << "short";
+    fieldGetExprJava << "buf.get(%1)" << "buf.getShort(%1)" << "buf.getInt(%1)"
+                     << "(short) (buf.get(%1) & 0xff)" << "buf.getShort(%1) & 0xffff"
+                     << "buf.getInt(%1) & 0xffffffffL" << "buf.getFloat(%1)"
+                     << "(short) (buf.get(%1) & 0xff)";
+    fieldSetStmtJava << "buf.put(%1, value);" << "buf.putShort(%1, value);" << "buf.putInt(%1, value);"
+                     << "buf.put(%1, (byte) value);" << "buf.putShort(%1, (short) value);"
+                     << "buf.putInt(%1, (int) value);" << "buf.putFloat(%1, value);"
+                     << "buf.put(%1, (byte) value);";
+
     javaCodePath     = QDir(templatepath + QString(JAVA_TEMPLATE_DIR));
     javaOutputPath   = QDir(outputpath);
     javaOutputPath.mkpath(javaOutputPath.absolutePath());
@@ -237,6 +253,37 @@ bool UAVObjectGeneratorJava::process_object(ObjectInfo *info)
 
     outCode.replace(QString("$(INITFIELDS)"), initfields);
 
+    // Replace the $(BYTEBUFFERHELPERS) tag : fixed payload offsets plus
+    // absolute-index ByteBuffer accessors so telemetry clients can parse a
+    // frame in place without per-field allocation or boxing
+    QString helpers;
+    int byteOffset = 0;
+    for (int n = 0; n < info->fields.length(); ++n) {
+        FieldInfo *field = info->fields[n];
+        int fieldSize    = fieldSizeStrJava[field->type].toInt();
+        QString offName  = field->name.toUpper() + "_OFFSET";
+        QString retType  = fieldTypeStrJavaRet[field->type];
+        QString offExpr;
+        QString args;
+        if (field->numElements > 1) {
+            offExpr = QString("base + %1 + index * %2").arg(offName).arg(fieldSize);
+            args    = "ByteBuffer buf, int base, int index";
+        } else {
+            offExpr = QString("base + %1").arg(offName);
+            args    = "ByteBuffer buf, int base";
+        }
+        helpers.append(QString("\tpublic static final int %1 = %2;\n").arg(offName).arg(byteOffset));
+        helpers.append(QString("\tpublic static %1 get%2At(%3) {\n").arg(retType).arg(field->name).arg(args));
+        helpers.append(QString("\t\treturn %1;\n").arg(fieldGetExprJava[field->type].arg(offExpr)));
+        helpers.append(QString("\t}\n"));
+        helpers.append(QString("\tpublic static void set%1At(%2, %3 value) {\n").arg(field->name).arg(args).arg(retType));
+        helpers.append(QString("\t\t%1\n").arg(fieldSetStmtJava[field->type].arg(offExpr)));
+        helpers.append(QString("\t}\n"));
+        byteOffset += fieldSize * field->numElements;
+    }
+    helpers.append(QString("\tpublic static final int PAYLOAD_NUMBYTES = %1;\n").arg(byteOffset));
+    outCode.replace(QString("$(BYTEBUFFERHELPERS)"), helpers);
+
     // Write the java code
     bool res = writeFileIfDifferent(javaOutputPath.absolutePath() + "/" + info->name + ".java", outCode);
     if (!res) {
@@ -41,6 +41,7 @@ private:
 
     QString javaCodeTemplate, javaIncludeTemplate;
     QStringList fieldTypeStrCPP, fieldTypeStrCPPClass;
+    QStringList fieldSizeStrJava, fieldTypeStrJavaRet, fieldGetExprJava, fieldSetStmtJava;
     QDir javaCodePath;
     QDir javaOutputPath;
 };
@@ -153,6 +153,14 @@ bool UAVObjectGeneratorMatlab::process_object(ObjectInfo *info, int numBytes)
                                 ", " + objectName + "FidIdx - 2 + 1)), 'uint16'))';\n");
     }
 
+    // Gather all record payloads in one indexed read; fields are then
+    // typecast from contiguous row slices instead of rebuilding an mcolon
+    // index vector over the raw buffer for every field
+    QString recordsName = objectName + "Records";
+    allocationFields.append("\t" + recordsName + " = " +
+                            "reshape(buffer(mcolon(" + objectName + "FidIdx, " + objectName + "FidIdx + " +
+                            objectTableName.toUpper() + "_NUMBYTES - 1)), " + objectTableName.toUpper() + "_NUMBYTES, []);\n");
+
     for (int n = 0; n < info->fields.length(); ++n) {
         // Determine variabel type
         type = fieldTypeStrMatlab[info->fields[n]->type];
@@ -162,15 +170,16 @@ bool UAVObjectGeneratorMatlab::process_object(ObjectInfo *info, int numBytes)
         // Append field
         if (info->fields[n]->numElements > 1) {
             allocationFields.append("\t" + objectName + "." + info->fields[n]->name + " = " +
-                                    "reshape(double(typecast(buffer(mcolon(" + objectName + "FidIdx + " + QString("%1").arg(currentIdx) +
-                                    ", " + objectName + "FidIdx + " + QString("%1").arg(currentIdx + size.toInt() * info->fields[n]->numElements - 1) + ")), '" + type + "')), " + QString::number(info->fields[n]->numElements, 10) + ", [] );\n");
+                                    "reshape(double(typecast(reshape(" + recordsName + "(" + QString("%1").arg(currentIdx + 1) +
+                                    ":" + QString("%1").arg(currentIdx + size.toInt() * info->fields[n]->numElements) + ", :), [], 1), '" + type + "')), " + QString::number(info->fields[n]->numElements, 10) + ", [] );\n");
         } else {
             allocationFields.append("\t" + objectName + "." + info->fields[n]->name + " = " +
-                                    "double(typecast(buffer(mcolon(" + objectName + "FidIdx + " + QString("%1").arg(currentIdx) +
-                                    ", " + objectName + "FidIdx + " + QString("%1").arg(currentIdx + size.toInt() - 1) + ")), '" + type + "'))';\n");
+                                    "double(typecast(reshape(" + recordsName + "(" + QString("%1").arg(currentIdx + 1) +
+                                    ":" + QString("%1").arg(currentIdx + size.toInt()) + ", :), [], 1), '" + type + "'))';\n");
         }
         currentIdx += size.toInt() * info->fields[n]->numElements;
     }
+    allocationFields.append("\tclear " + recordsName + ";\n");
     matlabAllocationCode.append(allocationFields);
     matlabAllocationCode.append("\n");
 
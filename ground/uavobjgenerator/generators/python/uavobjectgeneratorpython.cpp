@@ -29,6 +29,10 @@ using namespace std;
 
 bool UAVObjectGeneratorPython::generate(UAVObjectParser *parser, QString templatepath, QString outputpath)
 {
+    // NumPy dtype codes for the packed (little endian) field types
+    fieldTypeStrNumpy << "<i1" << "<i2" << "<i4"
+                      << "<u1" << "<u2" << "<u4" << "<f4" << "<u1";
+
     // Load template and setup output directory
     pythonCodePath     = QDir(templatepath + QString("flight/modules/FlightPlan/lib"));
     pythonOutputPath   = QDir(outputpath);
@@ -109,6 +113,38 @@ bool UAVObjectGeneratorPython::process_object(ObjectInfo *info)
     }
     outCode.replace(QString("$(DATAFIELDINIT)"), fields);
 
+    // Append a NumPy structured dtype mirroring the packed payload layout,
+    // plus a bulk-parse helper. Parsing a log column this way is a single
+    // frombuffer call instead of a per-object unpack loop.
+    QString numpyFields;
+    for (int n = 0; n < info->fields.length(); ++n) {
+        QString dtype = fieldTypeStrNumpy[info->fields[n]->type];
+        if (info->fields[n]->numElements > 1) {
+            numpyFields.append(QString("        (\"%1\", \"%2\", (%3,)),\n")
+                               .arg(info->fields[n]->name).arg(dtype).arg(info->fields[n]->numElements));
+        } else {
+            numpyFields.append(QString("        (\"%1\", \"%2\"),\n")
+                               .arg(info->fields[n]->name).arg(dtype));
+        }
+    }
+    QString numpyCode;
+    numpyCode.append(QString("\n# NumPy structured dtype matching the packed %1 payload\n").arg(info->name));
+    numpyCode.append(QString("# (optional helpers - only defined when numpy is importable)\n"));
+    numpyCode.append(QString("try:\n"));
+    numpyCode.append(QString("    import numpy\n\n"));
+    numpyCode.append(QString("    numpy_dtype = numpy.dtype([\n"));
+    numpyCode.append(numpyFields);
+    numpyCode.append(QString("    ])\n\n"));
+    numpyCode.append(QString("    def numpy_parse(data, count=-1):\n"));
+    numpyCode.append(QString("        \"\"\"Bulk-parse consecutive packed %1 payloads from a buffer.\n\n").arg(info->name));
+    numpyCode.append(QString("        Returns a structured array with one record per payload, so an\n"));
+    numpyCode.append(QString("        entire log column loads in one vectorized call.\n"));
+    numpyCode.append(QString("        \"\"\"\n"));
+    numpyCode.append(QString("        return numpy.frombuffer(data, dtype=numpy_dtype, count=count)\n"));
+    numpyCode.append(QString("except ImportError:\n"));
+    numpyCode.append(QString("    numpy = None\n"));
+    outCode.append(numpyCode);
+
     // Write the Python code
     bool res = writeFileIfDifferent(pythonOutputPath.absolutePath() + "/" + info->namelc + ".py", outCode);
     if (!res) {
@@ -37,6 +37,7 @@ private:
     bool process_object(ObjectInfo *info);
 
     QString pythonCodeTemplate;
+    QStringList fieldTypeStrNumpy;
     QDir pythonCodePath;
     QDir pythonOutputPath;
 };
@@ -176,6 +176,11 @@ bool UAVObjectGeneratorWireshark::process_object(ObjectInfo *info, QDir outputpa
             }
             enums.append(QString("\t{ 0, NULL }\r\n"));
             enums.append(QString("};\r\n"));
+            /* Option values are consecutive from 0, so the _ext table gives
+               direct-access lookup instead of a linear value_string scan */
+            enums.append(QString("static value_string_ext uavobjects_%1_%2_ext = VALUE_STRING_EXT_INIT(uavobjects_%1_%2);\r\n")
+                         .arg(info->namelc)
+                         .arg(info->fields[n]->name));
         }
     }
     outCode.replace(QString("$(ENUMFIELDNAMES)"), enums);
@@ -227,7 +232,7 @@ bool UAVObjectGeneratorWireshark::process_object(ObjectInfo *info, QDir outputpa
                                 .arg(info->fields[n]->name)
                                 .arg(fieldTypeStrHf[info->fields[n]->type]));
             if (info->fields[n]->type == FIELDTYPE_ENUM) {
-                headerfields.append(QString("\t     BASE_DEC, VALS(uavobjects_%1_%2), 0x0, NULL, HFILL \r\n")
+                headerfields.append(QString("\t     BASE_DEC | BASE_EXT_STRING, VALS_EXT_PTR(&uavobjects_%1_%2_ext), 0x0, NULL, HFILL \r\n")
                                     .arg(info->namelc)
                                     .arg(info->fields[n]->name));
             } else if (info->fields[n]->type == FIELDTYPE_FLOAT32) {
@@ -262,7 +267,7 @@ bool UAVObjectGeneratorWireshark::process_object(ObjectInfo *info, QDir outputpa
                                     .arg(elemNames[m])
                                     .arg(fieldTypeStrHf[info->fields[n]->type]));
                 if (info->fields[n]->type == FIELDTYPE_ENUM) {
-                    headerfields.append(QString("\t     BASE_DEC, VALS(uavobjects_%1_%2), 0x0, NULL, HFILL \r\n")
+                    headerfields.append(QString("\t     BASE_DEC | BASE_EXT_STRING, VALS_EXT_PTR(&uavobjects_%1_%2_ext), 0x0, NULL, HFILL \r\n")
                                         .arg(info->namelc)
                                         .arg(info->fields[n]->name));
                 } else if (info->fields[n]->type == FIELDTYPE_FLOAT32) {
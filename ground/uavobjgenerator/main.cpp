@@ -25,9 +25,12 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include <QtCore/QCoreApplication>
+#include <QCryptographicHash>
 #include <QFile>
+#include <QFuture>
 #include <QString>
 #include <QStringList>
+#include <QtConcurrentRun>
 #include <iostream>
 
 #include "generators/java/uavobjectgeneratorjava.h"
@@ -37,9 +40,10 @@
 #include "generators/python/uavobjectgeneratorpython.h"
 #include "generators/wireshark/uavobjectgeneratorwireshark.h"
 
-#define RETURN_ERR_USAGE 1
-#define RETURN_ERR_XML   2
-#define RETURN_OK        0
+#define RETURN_ERR_USAGE    1
+#define RETURN_ERR_XML      2
+#define RETURN_ERR_GENERATE 3
+#define RETURN_OK           0
 
 using namespace std;
 
@@ -60,6 +64,7 @@ void usage()
     cout << "Misc: " << endl;
     cout << "\t-h or --help   this help" << endl;
     cout << "\t-v             verbose" << endl;
+    cout << "\t-incremental   skip generation when the XML inputs are unchanged since the last run" << endl;
     cout << "\tinput_path     path to UAVObject definition (.xml) files." << endl;
     cout << "\ttemplate_path  path to the root of the source tree." << endl;
     cout << "\tUAVObjXY       name of a specific UAVObject to be built." << endl;
@@ -103,6 +108,7 @@ int main(int argc, char *argv[])
     }
 
     bool verbose       = (arguments_stringlist.removeAll("-v") > 0);
+    bool incremental   = (arguments_stringlist.removeAll("-incremental") > 0);
     bool do_gcs        = (arguments_stringlist.removeAll("-gcs") > 0);
     bool do_flight     = (arguments_stringlist.removeAll("-flight") > 0);
     bool do_java       = (arguments_stringlist.removeAll("-java") > 0);
@@ -143,7 +149,20 @@ int main(int argc, char *argv[])
     xmlPath.setNameFilters(filters);
     QFileInfoList xmlList   = xmlPath.entryInfoList();
 
-    // Read in each XML file and parse object(s) in them
+    // Read in each XML file, the content hash covers the selected inputs and
+    // the requested language so every backend keeps its own stamp
+
+    QCryptographicHash inputHash(QCryptographicHash::Sha1);
+    QString language = do_flight ? "flight" :
+                       do_gcs ? "gcs" :
+                       do_java ? "java" :
+                       do_python ? "python" :
+                       do_matlab ? "matlab" :
+                       do_wireshark ? "wireshark" : "parse";
+    inputHash.addData(language.toUtf8());
+
+    QStringList xmlFileNames;
+    QStringList xmlFileContents;
 
     for (int n = 0; n < xmlList.length(); ++n) {
         QFileInfo fileinfo = xmlList[n];
@@ -155,28 +174,47 @@ int main(int argc, char *argv[])
                 continue;
             }
         }
-        if (verbose) {
-            cout << "Parsing XML file: " << fileinfo.fileName().toStdString() << endl;
-        }
         QString filename = fileinfo.fileName();
         QString xmlstr   = readFile(fileinfo.absoluteFilePath());
 
-        QString res = parser->parseXML(xmlstr, filename);
+        inputHash.addData(filename.toUtf8());
+        inputHash.addData(xmlstr.toUtf8());
+        xmlFileNames << filename;
+        xmlFileContents << xmlstr;
+    }
+
+    if (objects_stringlist.length() > 0) {
+        cout << "required UAVObject definitions not found! " << objects_stringlist.join(",").toStdString() << endl;
+        return RETURN_ERR_XML;
+    }
+
+    // Compare the input hash against the stamp of the previous run and skip
+    // parsing and generation entirely when nothing changed
+    QString stampFileName = outputpath + QString(".uavobjgenerator-%1.stamp").arg(language);
+    QString stampContent  = QString(inputHash.result().toHex());
+
+    if (incremental && (readFile(stampFileName, false) == stampContent)) {
+        cout << "Done: " << language.toStdString() << " output is up to date, skipping generation." << endl;
+        return RETURN_OK;
+    }
+
+    // Parse object(s) in each XML file
+
+    for (int n = 0; n < xmlFileNames.length(); ++n) {
+        if (verbose) {
+            cout << "Parsing XML file: " << xmlFileNames[n].toStdString() << endl;
+        }
+        QString res = parser->parseXML(xmlFileContents[n], xmlFileNames[n]);
 
         if (!res.isNull()) {
             if (!verbose) {
-                cout << "Error in XML file: " << fileinfo.fileName().toStdString() << endl;
+                cout << "Error in XML file: " << xmlFileNames[n].toStdString() << endl;
             }
             cout << "Error parsing " << res.toStdString() << endl;
             return RETURN_ERR_XML;
         }
     }
 
-    if (objects_stringlist.length() > 0) {
-        cout << "required UAVObject definitions not found! " << objects_stringlist.join(",").toStdString() << endl;
-        return RETURN_ERR_XML;
-    }
-
     // check for duplicate object ID's
     QList<quint32> objIDList;
     int numBytesTotal = 0;
@@ -203,36 +241,65 @@ int main(int argc, char *argv[])
         cout << "used units: " << parser->all_units.join(",").toStdString() << endl;
     }
 
+    // Dispatch the requested backends on the global thread pool. The parsed
+    // object tree is read-only from this point on and every backend writes to
+    // its own output directory, so they can run concurrently and the total
+    // generation time drops to that of the slowest backend.
+    UAVObjectGeneratorFlight flightgen;
+    UAVObjectGeneratorGCS gcsgen;
+    UAVObjectGeneratorJava javagen;
+    UAVObjectGeneratorPython pygen;
+    UAVObjectGeneratorMatlab matlabgen;
+    UAVObjectGeneratorWireshark wiresharkgen;
+
+    QStringList generatorNames;
+    QList<QFuture<bool> > generatorFutures;
+
     if (do_flight) {
-        // generate flight code if wanted
         cout << "generating flight code" << endl;
-        UAVObjectGeneratorFlight flightgen;
-        flightgen.generate(parser, templatepath, outputpath);
-    } else if (do_gcs) {
-        // generate gcs code if wanted
+        generatorNames << "flight";
+        generatorFutures << QtConcurrent::run(&flightgen, &UAVObjectGeneratorFlight::generate, parser, templatepath, outputpath);
+    }
+    if (do_gcs) {
         cout << "generating gcs code" << endl;
-        UAVObjectGeneratorGCS gcsgen;
-        gcsgen.generate(parser, templatepath, outputpath);
-    } else if (do_java) {
-        // generate java code if wanted
+        generatorNames << "gcs";
+        generatorFutures << QtConcurrent::run(&gcsgen, &UAVObjectGeneratorGCS::generate, parser, templatepath, outputpath);
+    }
+    if (do_java) {
         cout << "generating java code" << endl;
-        UAVObjectGeneratorJava javagen;
-        javagen.generate(parser, templatepath, outputpath);
-    } else if (do_python) {
-        // generate python code if wanted
+        generatorNames << "java";
+        generatorFutures << QtConcurrent::run(&javagen, &UAVObjectGeneratorJava::generate, parser, templatepath, outputpath);
+    }
+    if (do_python) {
         cout << "generating python code" << endl;
-        UAVObjectGeneratorPython pygen;
-        pygen.generate(parser, templatepath, outputpath);
-    } else if (do_matlab) {
-        // generate matlab code if wanted
+        generatorNames << "python";
+        generatorFutures << QtConcurrent::run(&pygen, &UAVObjectGeneratorPython::generate, parser, templatepath, outputpath);
+    }
+    if (do_matlab) {
         cout << "generating matlab code" << endl;
-        UAVObjectGeneratorMatlab matlabgen;
-        matlabgen.generate(parser, templatepath, outputpath);
-    } else if (do_wireshark) {
-        // generate wireshark plugin if wanted
+        generatorNames << "matlab";
+        generatorFutures << QtConcurrent::run(&matlabgen, &UAVObjectGeneratorMatlab::generate, parser, templatepath, outputpath);
+    }
+    if (do_wireshark) {
         cout << "generating wireshark code" << endl;
-        UAVObjectGeneratorWireshark wiresharkgen;
-        wiresharkgen.generate(parser, templatepath, outputpath);
+        generatorNames << "wireshark";
+        generatorFutures << QtConcurrent::run(&wiresharkgen, &UAVObjectGeneratorWireshark::generate, parser, templatepath, outputpath);
+    }
+
+    bool generated = true;
+    for (int n = 0; n < generatorFutures.length(); ++n) {
+        if (!generatorFutures[n].result()) {
+            cout << "Error: " << generatorNames[n].toStdString() << " code generation failed" << endl;
+            generated = false;
+        }
+    }
+    if (!generated) {
+        return RETURN_ERR_GENERATE;
+    }
+
+    if (incremental) {
+        // record the input hash so the next unchanged run can skip generation
+        writeFile(stampFileName, stampContent);
     }
 
     return RETURN_OK;
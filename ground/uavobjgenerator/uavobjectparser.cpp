@@ -462,7 +462,7 @@ QString UAVObjectParser::processObjectFields(QDomNode & childNode, ObjectInfo *i
         return QString("Object:field:units attribute is missing");
     }
 
-    field->units = elemAttr.nodeValue();
+    field->units = internString(elemAttr.nodeValue());
     all_units << field->units;
 
     // Get type attribute
@@ -490,7 +490,7 @@ QString UAVObjectParser::processObjectFields(QDomNode & childNode, ObjectInfo *i
             names[n] = names[n].trimmed();
         }
 
-        field->elementNames = names;
+        field->elementNames = internStringList(names);
         field->numElements  = names.length();
         field->defaultElementNames = false;
     } else {
@@ -501,7 +501,7 @@ QString UAVObjectParser::processObjectFields(QDomNode & childNode, ObjectInfo *i
                  !node.isNull(); node = node.nextSiblingElement("elementname")) {
                 QDomNode name = node.firstChild();
                 if (!name.isNull() && name.isText() && !name.nodeValue().isEmpty()) {
-                    field->elementNames.append(name.nodeValue());
+                    field->elementNames.append(internString(name.nodeValue()));
                 }
             }
             field->numElements = field->elementNames.length();
@@ -517,7 +517,7 @@ QString UAVObjectParser::processObjectFields(QDomNode & childNode, ObjectInfo *i
         } else {
             field->numElements = elemAttr.nodeValue().toInt();
             for (int n = 0; n < field->numElements; ++n) {
-                field->elementNames.append(QString("%1").arg(n));
+                field->elementNames.append(internString(QString("%1").arg(n)));
             }
 
             field->defaultElementNames = true;
@@ -532,7 +532,7 @@ QString UAVObjectParser::processObjectFields(QDomNode & childNode, ObjectInfo *i
             for (int n = 0; n < options.length(); ++n) {
                 options[n] = options[n].trimmed();
             }
-            field->options = options;
+            field->options = internStringList(options);
         } else {
             // Look for a list of child 'option' nodes
             QDomNode listNode = childNode.firstChildElement("options");
@@ -541,7 +541,7 @@ QString UAVObjectParser::processObjectFields(QDomNode & childNode, ObjectInfo *i
                      !node.isNull(); node = node.nextSiblingElement("option")) {
                     QDomNode name = node.firstChild();
                     if (!name.isNull() && name.isText() && !name.nodeValue().isEmpty()) {
-                        field->options.append(name.nodeValue());
+                        field->options.append(internString(name.nodeValue()));
                     }
                 }
             }
@@ -576,7 +576,7 @@ QString UAVObjectParser::processObjectFields(QDomNode & childNode, ObjectInfo *i
                 defaults.append(defaults[0]);
             }
         }
-        field->defaultValues = defaults;
+        field->defaultValues = internStringList(defaults);
     }
 
     // Limits attribute
@@ -670,3 +670,27 @@ QString UAVObjectParser::processObjectDescription(QDomNode & childNode, QString
     description->append(childNode.firstChild().nodeValue());
     return QString();
 }
+
+/**
+ * Return a shared copy of the given string.
+ *
+ * Element names, units, enum options and default values repeat heavily
+ * across definitions (Roll/Pitch/Yaw, "deg/s", TRUE/FALSE, ...), so keeping
+ * one pooled QString per distinct value lets all fields share the same
+ * allocation through implicit sharing.
+ */
+QString UAVObjectParser::internString(const QString & str)
+{
+    return *stringPool.insert(str);
+}
+
+QStringList UAVObjectParser::internStringList(const QStringList & list)
+{
+    QStringList interned;
+
+    interned.reserve(list.length());
+    foreach(const QString & str, list) {
+        interned << internString(str);
+    }
+    return interned;
+}
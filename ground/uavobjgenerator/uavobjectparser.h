@@ -31,6 +31,7 @@
 #include <QString>
 #include <QStringList>
 #include <QList>
+#include <QSet>
 #include <QDomNode>
 #include <QByteArray>
 
@@ -134,6 +135,11 @@ private:
     void calculateID(ObjectInfo *info);
     quint32 updateHash(quint32 value, quint32 hash);
     quint32 updateHash(QString & value, quint32 hash);
+
+    QString internString(const QString & str);
+    QStringList internStringList(const QStringList & list);
+
+    QSet<QString> stringPool;
 };
 
 #endif // UAVOBJECTPARSER_H
@@ -3,7 +3,7 @@
 # Copyright (c) 2010-2013, The OpenPilot Team, http://www.openpilot.org
 #
 
-QT += xml
+QT += xml concurrent
 QT -= gui
 macx {
     CONFIG += warn_on